@@ -0,0 +1,471 @@
+/**
+ * \file bench/dataservice/dataservice_alloc_bench.c
+ *
+ * \brief Allocation benchmark for the data service transaction queue.
+ *
+ * Each benchmark case submits, promotes, and drops transactions of a given
+ * certificate size through the data service, and counts the heap allocations
+ * made during each call.  The counts include any allocations that LMDB makes,
+ * so each case also times a bare MDB_RESERVE put and commit of the same size,
+ * which is the least that a write to the queue can cost.  One JSON object is
+ * printed per case, one per line, so that the results can be collected and
+ * compared between builds.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <vpr/disposable.h>
+
+#include "../../src/dataservice/dataservice_internal.h"
+
+/**
+ * \brief The default number of measured calls per case.
+ */
+#define BENCH_DEFAULT_ITERATIONS 1000U
+
+/**
+ * \brief The number of unmeasured calls per case, which let LMDB settle into
+ * reusing its dirty pages.
+ */
+#define BENCH_WARMUP 64U
+
+/**
+ * \brief The first key byte of the bare put case, which keeps its records
+ * apart from the queue.
+ */
+#define BENCH_BARE_KEY_PREFIX 0x7E
+
+/**
+ * \brief Certificate sizes covered by the benchmark: one that fits on a page,
+ * and one that spans overflow pages.
+ */
+static const uint32_t bench_sizes[] = { 256U, 65536U };
+
+/**
+ * \brief The operations timed for each certificate size.
+ */
+typedef enum bench_op
+{
+    BENCH_OP_SUBMIT,
+    BENCH_OP_PROMOTE,
+    BENCH_OP_DROP,
+    BENCH_OP_BARE_PUT,
+} bench_op_t;
+
+/**
+ * \brief The names of the operations, as reported.
+ */
+static const char* bench_op_names[] = {
+    "submit", "promote", "drop", "lmdb_reserve_put" };
+
+/**
+ * \brief Benchmark state shared by every case.
+ */
+typedef struct bench_config
+{
+    dataservice_root_context_t root;
+    dataservice_child_context_t child;
+    uint32_t iterations;
+    uint8_t* cert;
+} bench_config_t;
+
+/* allocation counting. */
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t nmemb, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+static bool bench_counting = false;
+static uint64_t bench_allocations = 0U;
+
+/* forward decls. */
+static uint64_t bench_now(void);
+static void bench_key(uint8_t* key, uint8_t prefix, uint32_t size, uint32_t i);
+static int bench_call(
+    bench_config_t* conf, bench_op_t op, uint32_t size, uint32_t i);
+static int bench_bare_put(bench_config_t* conf, uint32_t size, uint32_t i);
+static int bench_bare_cleanup(bench_config_t* conf, uint32_t size);
+static int bench_run_case(bench_config_t* conf, bench_op_t op, uint32_t size);
+
+/**
+ * \brief Count calls to malloc.
+ */
+void* malloc(size_t size)
+{
+    if (bench_counting)
+    {
+        ++bench_allocations;
+    }
+
+    return __libc_malloc(size);
+}
+
+/**
+ * \brief Count calls to calloc.
+ */
+void* calloc(size_t nmemb, size_t size)
+{
+    if (bench_counting)
+    {
+        ++bench_allocations;
+    }
+
+    return __libc_calloc(nmemb, size);
+}
+
+/**
+ * \brief Count calls to realloc.
+ */
+void* realloc(void* ptr, size_t size)
+{
+    if (bench_counting)
+    {
+        ++bench_allocations;
+    }
+
+    return __libc_realloc(ptr, size);
+}
+
+/**
+ * \brief Main entry point for the data service allocation benchmark.
+ *
+ * \param argc          Number of arguments.
+ * \param argv          List of arguments.  "-n count" sets the number of
+ *                      measured calls for every case.
+ *
+ * \returns 0 on success, and non-zero on failure.
+ */
+int main(int argc, char** argv)
+{
+    int retval = 0;
+    int opt;
+    bench_config_t conf;
+    char datadir[] = "/tmp/agentd-alloc-bench-XXXXXX";
+    char path[sizeof(datadir) + 16];
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    memset(&conf, 0, sizeof(conf));
+    conf.iterations = BENCH_DEFAULT_ITERATIONS;
+
+    /* parse command-line options. */
+    while (-1 != (opt = getopt(argc, argv, "n:")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                conf.iterations = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-n iterations]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    /* create a scratch database directory. */
+    if (NULL == mkdtemp(datadir))
+    {
+        perror("mkdtemp");
+        return 1;
+    }
+
+    /* create the certificate bytes for the largest size. */
+    conf.cert = (uint8_t*)malloc(65536U);
+    if (NULL == conf.cert)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_datadir;
+    }
+
+    memset(conf.cert, 0x5A, 65536U);
+
+    /* open the database. */
+    BITCAP_INIT_FALSE(conf.root.apicaps);
+    BITCAP_SET_TRUE(
+        conf.root.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+    retval = dataservice_root_context_init(&conf.root, datadir);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Could not open the database.\n");
+        goto cleanup_cert;
+    }
+
+    /* create a child context that can use the transaction queue. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    BITCAP_SET_TRUE(reducedcaps, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(
+        reducedcaps, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_PROMOTE);
+    BITCAP_SET_TRUE(reducedcaps, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_DROP);
+    BITCAP_INIT_FALSE(conf.child.childcaps);
+    BITCAP_SET_TRUE(
+        conf.child.childcaps, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+    retval =
+        dataservice_child_context_create(
+            &conf.root, &conf.child, reducedcaps);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Could not create a child context.\n");
+        goto cleanup_root;
+    }
+
+    /* run every operation for each size.  Each operation works on the
+     * transactions left by the one before it. */
+    for (size_t i = 0; i < sizeof(bench_sizes) / sizeof(uint32_t); ++i)
+    {
+        for (int op = BENCH_OP_SUBMIT; op <= BENCH_OP_BARE_PUT; ++op)
+        {
+            retval = bench_run_case(&conf, (bench_op_t)op, bench_sizes[i]);
+            if (AGENTD_STATUS_SUCCESS != retval)
+            {
+                fprintf(
+                    stderr, "Case %s/%u failed (%x).\n", bench_op_names[op],
+                    bench_sizes[i], retval);
+                goto cleanup_child;
+            }
+        }
+    }
+
+    /* success. */
+    retval = 0;
+
+cleanup_child:
+    dataservice_child_context_close(&conf.child);
+
+cleanup_root:
+    dispose((disposable_t*)&conf.root);
+
+cleanup_cert:
+    free(conf.cert);
+
+cleanup_datadir:
+    snprintf(path, sizeof(path), "%s/data.mdb", datadir);
+    unlink(path);
+    snprintf(path, sizeof(path), "%s/lock.mdb", datadir);
+    unlink(path);
+    rmdir(datadir);
+
+    return 0 == retval ? 0 : 1;
+}
+
+/**
+ * \brief Run one benchmark case and report its allocations and time per call.
+ *
+ * \param conf          The benchmark configuration.
+ * \param op            The operation to run.
+ * \param size          The certificate size.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int bench_run_case(bench_config_t* conf, bench_op_t op, uint32_t size)
+{
+    int retval;
+    uint64_t allocations = 0U;
+    uint64_t total = 0U;
+
+    for (uint32_t i = 0; i < BENCH_WARMUP + conf->iterations; ++i)
+    {
+        bool measured = i >= BENCH_WARMUP;
+
+        /* count and time only the call itself. */
+        bench_allocations = 0U;
+        bench_counting = measured;
+        uint64_t start = bench_now();
+        retval = bench_call(conf, op, size, i);
+        uint64_t end = bench_now();
+        bench_counting = false;
+
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        if (measured)
+        {
+            allocations += bench_allocations;
+            total += end - start;
+        }
+    }
+
+    /* the bare puts are removed, so they don't skew the next size. */
+    if (BENCH_OP_BARE_PUT == op)
+    {
+        retval = bench_bare_cleanup(conf, size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    printf(
+        "{\"op\":\"%s\",\"cert_bytes\":%u,\"iterations\":%u,"
+        "\"allocations\":%llu,\"allocs_per_op\":%.3f,\"ns_per_op\":%.1f}\n",
+        bench_op_names[op], size, conf->iterations,
+        (unsigned long long)allocations,
+        (double)allocations / conf->iterations,
+        (double)total / conf->iterations);
+    fflush(stdout);
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Make a single call of the given operation.
+ *
+ * \param conf          The benchmark configuration.
+ * \param op            The operation to call.
+ * \param size          The certificate size.
+ * \param i             The index of this call.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int bench_call(
+    bench_config_t* conf, bench_op_t op, uint32_t size, uint32_t i)
+{
+    uint8_t txn_id[16];
+    uint8_t artifact_id[16];
+
+    bench_key(txn_id, 0x01, size, i);
+    bench_key(artifact_id, 0x02, size, i);
+
+    switch (op)
+    {
+        case BENCH_OP_SUBMIT:
+            return
+                dataservice_transaction_submit(
+                    &conf->child, NULL, txn_id, artifact_id, conf->cert,
+                    size);
+
+        case BENCH_OP_PROMOTE:
+            return
+                dataservice_transaction_promote(&conf->child, NULL, txn_id);
+
+        case BENCH_OP_DROP:
+            return dataservice_transaction_drop(&conf->child, NULL, txn_id);
+
+        case BENCH_OP_BARE_PUT:
+        default:
+            return bench_bare_put(conf, size, i);
+    }
+}
+
+/**
+ * \brief Reserve and fill a queue-sized record with LMDB alone, and commit it.
+ *
+ * \param conf          The benchmark configuration.
+ * \param size          The certificate size.
+ * \param i             The index of this call.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int bench_bare_put(bench_config_t* conf, uint32_t size, uint32_t i)
+{
+    dataservice_database_details_t* details =
+        (dataservice_database_details_t*)conf->root.details;
+    MDB_txn* txn;
+    uint8_t key[16];
+    MDB_val lkey, lval;
+
+    if (0 != mdb_txn_begin(details->env, NULL, 0, &txn))
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE;
+    }
+
+    bench_key(key, BENCH_BARE_KEY_PREFIX, size, i);
+    lkey.mv_size = sizeof(key);
+    lkey.mv_data = key;
+    lval.mv_size = sizeof(data_transaction_node_t) + size;
+    lval.mv_data = NULL;
+    if (0 != mdb_put(txn, details->pq_db, &lkey, &lval, MDB_RESERVE))
+    {
+        mdb_txn_abort(txn);
+        return AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
+    }
+
+    memset(lval.mv_data, 0, sizeof(data_transaction_node_t));
+    memcpy(
+        (uint8_t*)lval.mv_data + sizeof(data_transaction_node_t), conf->cert,
+        size);
+
+    if (0 != mdb_txn_commit(txn))
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_TXN_COMMIT_FAILURE;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Remove the records written by the bare put case.
+ *
+ * \param conf          The benchmark configuration.
+ * \param size          The certificate size.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int bench_bare_cleanup(bench_config_t* conf, uint32_t size)
+{
+    dataservice_database_details_t* details =
+        (dataservice_database_details_t*)conf->root.details;
+    MDB_txn* txn;
+    uint8_t key[16];
+    MDB_val lkey;
+
+    if (0 != mdb_txn_begin(details->env, NULL, 0, &txn))
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE;
+    }
+
+    for (uint32_t i = 0; i < BENCH_WARMUP + conf->iterations; ++i)
+    {
+        bench_key(key, BENCH_BARE_KEY_PREFIX, size, i);
+        lkey.mv_size = sizeof(key);
+        lkey.mv_data = key;
+        if (0 != mdb_del(txn, details->pq_db, &lkey, NULL))
+        {
+            mdb_txn_abort(txn);
+            return AGENTD_ERROR_DATASERVICE_MDB_DEL_FAILURE;
+        }
+    }
+
+    if (0 != mdb_txn_commit(txn))
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_TXN_COMMIT_FAILURE;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Build a distinct key for each call, size, and kind of record.
+ *
+ * \param key           The 16 byte key to build.
+ * \param prefix        The kind of record.
+ * \param size          The certificate size.
+ * \param i             The index of the call.
+ */
+static void bench_key(uint8_t* key, uint8_t prefix, uint32_t size, uint32_t i)
+{
+    memset(key, 0, 16);
+    key[0] = prefix;
+    memcpy(key + 4, &size, sizeof(size));
+    memcpy(key + 8, &i, sizeof(i));
+}
+
+/**
+ * \brief Get the monotonic time in nanoseconds.
+ */
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
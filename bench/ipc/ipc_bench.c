@@ -0,0 +1,853 @@
+/**
+ * \file bench/ipc/ipc_bench.c
+ *
+ * \brief Throughput and latency benchmark for the IPC layer.
+ *
+ * Each benchmark case forks an echo peer on one side of a socketpair and times
+ * round trips of a data packet from the other side.  Both sides use the same
+ * API (plain or authed data packets) and the same mode (blocking or
+ * non-blocking).  One JSON object is printed per case, one per line, so that
+ * the results can be collected and compared between builds.  A final set of
+ * cases times the per-packet short MAC on its own.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+#include <vccrypt/suite.h>
+#include <vpr/allocator/malloc_allocator.h>
+#include <vpr/disposable.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief The number of payload bytes moved in each direction per case, used
+ * to pick the number of round trips for a payload size.
+ */
+#define BENCH_BYTES_PER_CASE (64U * 1024U * 1024U)
+
+/**
+ * \brief Bounds on the number of timed round trips per case.
+ */
+#define BENCH_MIN_ITERATIONS 16U
+#define BENCH_MAX_ITERATIONS 20000U
+
+/**
+ * \brief Errors specific to the benchmark harness.
+ */
+#define BENCH_ERROR_FORK_FAILURE -1
+#define BENCH_ERROR_ECHO_PEER_FAILURE -2
+
+/**
+ * \brief Payload sizes covered by the benchmark, from 16 B to 10 MB.
+ */
+static const uint32_t bench_sizes[] = {
+    16U, 256U, 4096U, 65536U, 1024U * 1024U, 10U * 1024U * 1024U };
+
+/**
+ * \brief Benchmark configuration shared by every case.
+ */
+typedef struct bench_config
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t suite;
+    vccrypt_buffer_t secret;
+    uint32_t iterations;
+} bench_config_t;
+
+/**
+ * \brief A single benchmark case.
+ */
+typedef struct bench_case
+{
+    bench_config_t* conf;
+    bool authed;
+    bool noblock;
+    uint32_t size;
+    uint32_t warmup;
+    uint32_t iterations;
+} bench_case_t;
+
+/**
+ * \brief One side of a non-blocking benchmark case.
+ */
+typedef struct bench_peer
+{
+    const bench_case_t* bcase;
+    ipc_socket_context_t sock;
+    ipc_event_loop_context_t loop;
+    bool echo;
+    const uint8_t* payload;
+    uint32_t sent;
+    uint32_t received;
+    uint64_t send_time;
+    uint64_t* samples;
+    int status;
+} bench_peer_t;
+
+/* forward decls */
+static uint64_t bench_now(void);
+static int bench_write_block(
+    const bench_case_t* bcase, int sock, uint64_t iv, const void* val,
+    uint32_t size);
+static int bench_read_block(
+    const bench_case_t* bcase, int sock, uint64_t iv, void** val,
+    uint32_t* size);
+static int bench_write_noblock(
+    bench_peer_t* peer, uint64_t iv, const void* val, uint32_t size);
+static int bench_read_noblock(
+    bench_peer_t* peer, uint64_t iv, void** val, uint32_t* size);
+static int bench_client_send(bench_peer_t* peer);
+static int bench_echo_block(const bench_case_t* bcase, int sock);
+static int bench_client_block(
+    const bench_case_t* bcase, int sock, const uint8_t* payload,
+    uint64_t* samples);
+static void bench_noblock_read(
+    ipc_socket_context_t* ctx, int event_flags, void* user_context);
+static void bench_noblock_write(
+    ipc_socket_context_t* ctx, int event_flags, void* user_context);
+static int bench_run_noblock(
+    const bench_case_t* bcase, int sock, bool echo, const uint8_t* payload,
+    uint64_t* samples);
+static int bench_run_case(const bench_case_t* bcase);
+static int bench_compare_samples(const void* lhs, const void* rhs);
+static void bench_report(const bench_case_t* bcase, uint64_t* samples);
+static int bench_mac(bench_config_t* conf, uint32_t size);
+
+/**
+ * \brief Main entry point for the IPC benchmark.
+ *
+ * \param argc          Number of arguments.
+ * \param argv          List of arguments.  "-n count" fixes the number of
+ *                      timed round trips for every case.
+ *
+ * \returns 0 on success, and non-zero on failure.
+ */
+int main(int argc, char** argv)
+{
+    int retval = 0;
+    int opt;
+    bench_config_t conf;
+
+    memset(&conf, 0, sizeof(conf));
+
+    /* parse command-line options. */
+    while (-1 != (opt = getopt(argc, argv, "n:")))
+    {
+        switch (opt)
+        {
+            case 'n':
+                conf.iterations = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+
+            default:
+                fprintf(stderr, "Usage: %s [-n iterations]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    /* a peer that goes away should surface as a write error. */
+    signal(SIGPIPE, SIG_IGN);
+
+    /* register the Velo V1 crypto suite. */
+    vccrypt_suite_register_velo_v1();
+
+    /* initialize the allocator. */
+    malloc_allocator_options_init(&conf.alloc_opts);
+
+    /* initialize the crypto suite. */
+    retval =
+        vccrypt_suite_options_init(
+            &conf.suite, &conf.alloc_opts, VCCRYPT_SUITE_VELO_V1);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Could not initialize the crypto suite.\n");
+        goto cleanup_allocator;
+    }
+
+    /* create a fixed key for the authed cases. */
+    retval =
+        vccrypt_buffer_init(
+            &conf.secret, &conf.alloc_opts,
+            conf.suite.stream_cipher_opts.key_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        fprintf(stderr, "Could not create the shared secret.\n");
+        goto cleanup_suite;
+    }
+
+    memset(conf.secret.data, 0x5A, conf.secret.size);
+
+    /* run every combination of API, mode, and payload size. */
+    for (int authed = 0; authed < 2; ++authed)
+    {
+        for (int noblock = 0; noblock < 2; ++noblock)
+        {
+            for (size_t i = 0; i < sizeof(bench_sizes) / sizeof(uint32_t);
+                 ++i)
+            {
+                bench_case_t bcase;
+                bcase.conf = &conf;
+                bcase.authed = authed;
+                bcase.noblock = noblock;
+                bcase.size = bench_sizes[i];
+
+                /* by default, move about the same amount of data per case. */
+                bcase.iterations = conf.iterations;
+                if (0 == bcase.iterations)
+                {
+                    bcase.iterations = BENCH_BYTES_PER_CASE / bcase.size;
+                    if (bcase.iterations < BENCH_MIN_ITERATIONS)
+                        bcase.iterations = BENCH_MIN_ITERATIONS;
+                    if (bcase.iterations > BENCH_MAX_ITERATIONS)
+                        bcase.iterations = BENCH_MAX_ITERATIONS;
+                }
+
+                /* the first round trips aren't timed. */
+                bcase.warmup = bcase.iterations / 10;
+
+                retval = bench_run_case(&bcase);
+                if (AGENTD_STATUS_SUCCESS != retval)
+                {
+                    fprintf(
+                        stderr, "Benchmark case failed: %s %s %u (%x).\n",
+                        authed ? "authed_data" : "data",
+                        noblock ? "noblock" : "block", bcase.size, retval);
+                    goto cleanup_secret;
+                }
+            }
+        }
+    }
+
+    /* time the per-packet MAC setup against the whole per-packet MAC. */
+    for (size_t i = 0; i < sizeof(bench_sizes) / sizeof(uint32_t); ++i)
+    {
+        retval = bench_mac(&conf, bench_sizes[i]);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            fprintf(
+                stderr, "Benchmark case failed: mac_short %u (%x).\n",
+                bench_sizes[i], retval);
+            goto cleanup_secret;
+        }
+    }
+
+    /* success. */
+    retval = 0;
+
+cleanup_secret:
+    dispose((disposable_t*)&conf.secret);
+
+cleanup_suite:
+    dispose((disposable_t*)&conf.suite);
+
+cleanup_allocator:
+    dispose((disposable_t*)&conf.alloc_opts);
+
+    return 0 == retval ? 0 : 1;
+}
+
+/**
+ * \brief Get the current monotonic time in nanoseconds.
+ */
+static uint64_t bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * \brief Write a packet to a blocking socket using the API for this case.
+ */
+static int bench_write_block(
+    const bench_case_t* bcase, int sock, uint64_t iv, const void* val,
+    uint32_t size)
+{
+    if (bcase->authed)
+    {
+        return
+            ipc_write_authed_data_block(
+                sock, iv, val, size, &bcase->conf->suite,
+                &bcase->conf->secret);
+    }
+    else
+    {
+        return ipc_write_data_block(sock, val, size);
+    }
+}
+
+/**
+ * \brief Read a packet from a blocking socket using the API for this case.
+ */
+static int bench_read_block(
+    const bench_case_t* bcase, int sock, uint64_t iv, void** val,
+    uint32_t* size)
+{
+    if (bcase->authed)
+    {
+        return
+            ipc_read_authed_data_block(
+                sock, iv, val, size, &bcase->conf->suite,
+                &bcase->conf->secret);
+    }
+    else
+    {
+        return ipc_read_data_block(sock, val, size);
+    }
+}
+
+/**
+ * \brief Echo packets on a blocking socket until the client hangs up.
+ */
+static int bench_echo_block(const bench_case_t* bcase, int sock)
+{
+    int retval;
+    void* val;
+    uint32_t size;
+
+    for (uint64_t iv = 0; ; iv += 2)
+    {
+        /* a failed read is the client closing its side. */
+        if (AGENTD_STATUS_SUCCESS
+                != bench_read_block(bcase, sock, iv, &val, &size))
+        {
+            return AGENTD_STATUS_SUCCESS;
+        }
+
+        retval = bench_write_block(bcase, sock, iv + 1, val, size);
+        free(val);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+}
+
+/**
+ * \brief Time round trips on a blocking socket.
+ */
+static int bench_client_block(
+    const bench_case_t* bcase, int sock, const uint8_t* payload,
+    uint64_t* samples)
+{
+    int retval;
+    void* val;
+    uint32_t size;
+    uint32_t total = bcase->warmup + bcase->iterations;
+
+    for (uint32_t i = 0; i < total; ++i)
+    {
+        uint64_t iv = 2 * (uint64_t)i;
+        uint64_t start = bench_now();
+
+        retval = bench_write_block(bcase, sock, iv, payload, bcase->size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        retval = bench_read_block(bcase, sock, iv + 1, &val, &size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        free(val);
+
+        if (i >= bcase->warmup)
+        {
+            samples[i - bcase->warmup] = bench_now() - start;
+        }
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write a packet to a non-blocking socket using the API for this case.
+ */
+static int bench_write_noblock(
+    bench_peer_t* peer, uint64_t iv, const void* val, uint32_t size)
+{
+    int retval;
+
+    if (peer->bcase->authed)
+    {
+        retval =
+            ipc_write_authed_data_noblock(
+                &peer->sock, iv, val, size, &peer->bcase->conf->suite,
+                &peer->bcase->conf->secret);
+    }
+    else
+    {
+        retval = ipc_write_data_noblock(&peer->sock, val, size);
+    }
+
+    /* whatever couldn't be written right away goes out on the write event. */
+    if (AGENTD_STATUS_SUCCESS == retval
+     && ipc_socket_writebuffer_size(&peer->sock) > 0)
+    {
+        ipc_set_writecb_noblock(
+            &peer->sock, &bench_noblock_write, &peer->loop);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Read a packet from a non-blocking socket using the API for this case.
+ */
+static int bench_read_noblock(
+    bench_peer_t* peer, uint64_t iv, void** val, uint32_t* size)
+{
+    if (peer->bcase->authed)
+    {
+        return
+            ipc_read_authed_data_noblock(
+                &peer->sock, iv, val, size, &peer->bcase->conf->suite,
+                &peer->bcase->conf->secret);
+    }
+    else
+    {
+        return ipc_read_data_noblock(&peer->sock, val, size);
+    }
+}
+
+/**
+ * \brief Send the next timed packet from the client side.
+ */
+static int bench_client_send(bench_peer_t* peer)
+{
+    peer->send_time = bench_now();
+
+    return
+        bench_write_noblock(
+            peer, 2 * (uint64_t)peer->sent++, peer->payload,
+            peer->bcase->size);
+}
+
+/**
+ * \brief Read callback for both sides of a non-blocking case.
+ */
+static void bench_noblock_read(
+    ipc_socket_context_t* UNUSED(ctx), int UNUSED(event_flags),
+    void* user_context)
+{
+    bench_peer_t* peer = (bench_peer_t*)user_context;
+    const bench_case_t* bcase = peer->bcase;
+    uint32_t total = bcase->warmup + bcase->iterations;
+    void* val;
+    uint32_t size;
+    int retval;
+
+    for (;;)
+    {
+        /* the echo side answers with the next iv. */
+        uint64_t iv = 2 * (uint64_t)peer->received + (peer->echo ? 0 : 1);
+
+        retval = bench_read_noblock(peer, iv, &val, &size);
+        if (AGENTD_ERROR_IPC_WOULD_BLOCK == retval)
+        {
+            return;
+        }
+        else if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            /* the client hanging up is how the echo side finishes. */
+            if (!peer->echo || AGENTD_ERROR_IPC_EVBUFFER_EOF != retval)
+            {
+                peer->status = retval;
+            }
+
+            goto exit_loop;
+        }
+
+        if (peer->echo)
+        {
+            retval = bench_write_noblock(peer, iv + 1, val, size);
+            free(val);
+            ++peer->received;
+        }
+        else
+        {
+            free(val);
+
+            if (peer->received >= bcase->warmup)
+            {
+                peer->samples[peer->received - bcase->warmup] =
+                    bench_now() - peer->send_time;
+            }
+
+            if (++peer->received == total)
+            {
+                goto exit_loop;
+            }
+
+            retval = bench_client_send(peer);
+        }
+
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            peer->status = retval;
+            goto exit_loop;
+        }
+    }
+
+exit_loop:
+    ipc_exit_loop(&peer->loop);
+}
+
+/**
+ * \brief Write callback for both sides of a non-blocking case.
+ */
+static void bench_noblock_write(
+    ipc_socket_context_t* ctx, int UNUSED(event_flags), void* user_context)
+{
+    bench_peer_t* peer = (bench_peer_t*)user_context;
+
+    if (ipc_socket_writebuffer_size(ctx) > 0)
+    {
+        if (ipc_socket_write_from_buffer(ctx) < 0
+         && EAGAIN != errno && EWOULDBLOCK != errno)
+        {
+            peer->status = AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE;
+            ipc_exit_loop(&peer->loop);
+            return;
+        }
+    }
+
+    /* the write event is one-shot, so re-arm it until the buffer drains. */
+    if (ipc_socket_writebuffer_size(ctx) > 0)
+    {
+        ipc_set_writecb_noblock(ctx, &bench_noblock_write, &peer->loop);
+    }
+    else
+    {
+        ipc_set_writecb_noblock(ctx, NULL, &peer->loop);
+    }
+}
+
+/**
+ * \brief Run one side of a non-blocking case.
+ */
+static int bench_run_noblock(
+    const bench_case_t* bcase, int sock, bool echo, const uint8_t* payload,
+    uint64_t* samples)
+{
+    int retval;
+    bench_peer_t peer;
+
+    memset(&peer, 0, sizeof(peer));
+    peer.bcase = bcase;
+    peer.echo = echo;
+    peer.payload = payload;
+    peer.samples = samples;
+    peer.status = AGENTD_STATUS_SUCCESS;
+
+    retval = ipc_make_noblock(sock, &peer.sock, &peer);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    retval = ipc_event_loop_init(&peer.loop);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sock;
+    }
+
+    ipc_set_readcb_noblock(&peer.sock, &bench_noblock_read, &peer.loop);
+
+    retval = ipc_event_loop_add(&peer.loop, &peer.sock);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_loop;
+    }
+
+    /* the client starts the first round trip. */
+    if (!echo)
+    {
+        retval = bench_client_send(&peer);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_loop;
+        }
+    }
+
+    retval = ipc_event_loop_run(&peer.loop);
+    if (AGENTD_STATUS_SUCCESS == retval)
+    {
+        retval = peer.status;
+    }
+
+cleanup_loop:
+    dispose((disposable_t*)&peer.loop);
+
+cleanup_sock:
+    dispose((disposable_t*)&peer.sock);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Run a single benchmark case and report its results.
+ */
+static int bench_run_case(const bench_case_t* bcase)
+{
+    int retval;
+    int lhs, rhs;
+    pid_t pid;
+    int status;
+    uint8_t* payload = NULL;
+    uint64_t* samples = NULL;
+
+    payload = (uint8_t*)malloc(bcase->size);
+    samples = (uint64_t*)malloc(bcase->iterations * sizeof(uint64_t));
+    if (NULL == payload || NULL == samples)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_buffers;
+    }
+
+    for (uint32_t i = 0; i < bcase->size; ++i)
+    {
+        payload[i] = (uint8_t)i;
+    }
+
+    retval = ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs);
+    if (0 != retval)
+    {
+        retval = AGENTD_ERROR_IPC_SOCKETPAIR_FAILURE;
+        goto cleanup_buffers;
+    }
+
+    /* fork the echo peer. */
+    pid = fork();
+    if (pid < 0)
+    {
+        retval = BENCH_ERROR_FORK_FAILURE;
+        goto cleanup_sockets;
+    }
+    else if (0 == pid)
+    {
+        close(lhs);
+
+        if (bcase->noblock)
+        {
+            retval = bench_run_noblock(bcase, rhs, true, NULL, NULL);
+        }
+        else
+        {
+            retval = bench_echo_block(bcase, rhs);
+        }
+
+        close(rhs);
+        _exit(AGENTD_STATUS_SUCCESS == retval ? 0 : 1);
+    }
+
+    close(rhs);
+    rhs = -1;
+
+    /* time the round trips from this side. */
+    if (bcase->noblock)
+    {
+        retval = bench_run_noblock(bcase, lhs, false, payload, samples);
+    }
+    else
+    {
+        retval = bench_client_block(bcase, lhs, payload, samples);
+    }
+
+    /* hang up, which tells the echo peer to exit. */
+    close(lhs);
+    lhs = -1;
+
+    if (0 > waitpid(pid, &status, 0)
+     || !WIFEXITED(status) || 0 != WEXITSTATUS(status))
+    {
+        if (AGENTD_STATUS_SUCCESS == retval)
+        {
+            retval = BENCH_ERROR_ECHO_PEER_FAILURE;
+        }
+    }
+
+    if (AGENTD_STATUS_SUCCESS == retval)
+    {
+        bench_report(bcase, samples);
+    }
+
+cleanup_sockets:
+    if (lhs >= 0)
+        close(lhs);
+    if (rhs >= 0)
+        close(rhs);
+
+cleanup_buffers:
+    free(payload);
+    free(samples);
+
+    return retval;
+}
+
+/**
+ * \brief Order latency samples for qsort.
+ */
+static int bench_compare_samples(const void* lhs, const void* rhs)
+{
+    uint64_t l = *(const uint64_t*)lhs;
+    uint64_t r = *(const uint64_t*)rhs;
+
+    return (l > r) - (l < r);
+}
+
+/**
+ * \brief Print the results of a benchmark case as a line of JSON.
+ *
+ * Rates are computed from the timed round trips only, so the warmup round
+ * trips aren't counted.  bytes_per_sec counts payload bytes in one direction.
+ */
+static void bench_report(const bench_case_t* bcase, uint64_t* samples)
+{
+    uint64_t total = 0;
+
+    for (uint32_t i = 0; i < bcase->iterations; ++i)
+    {
+        total += samples[i];
+    }
+
+    qsort(
+        samples, bcase->iterations, sizeof(uint64_t), &bench_compare_samples);
+
+    double seconds = (double)total / 1e9;
+    uint64_t p50 = samples[bcase->iterations / 2];
+    uint64_t p99 = samples[(uint64_t)bcase->iterations * 99 / 100];
+
+    printf(
+        "{\"api\":\"%s\",\"mode\":\"%s\",\"payload_bytes\":%u,"
+        "\"iterations\":%u,\"total_ns\":%llu,\"msgs_per_sec\":%.1f,"
+        "\"bytes_per_sec\":%.1f,\"p50_ns\":%llu,\"p99_ns\":%llu}\n",
+        bcase->authed ? "authed_data" : "data",
+        bcase->noblock ? "noblock" : "block", bcase->size, bcase->iterations,
+        (unsigned long long)total, (double)bcase->iterations / seconds,
+        (double)bcase->iterations * bcase->size / seconds,
+        (unsigned long long)p50, (unsigned long long)p99);
+    fflush(stdout);
+}
+
+/**
+ * \brief Time the short MAC of an authed packet, and the part of that time
+ * spent setting up the MAC context.
+ *
+ * Authed packets key a fresh short MAC context per packet.  vccrypt has no way
+ * to reset a finalized MAC context or to copy a keyed one, so this case
+ * measures what a cached context could save at most: the init and dispose of
+ * the context, reported as init_ns next to the whole per-packet MAC.
+ */
+static int bench_mac(bench_config_t* conf, uint32_t size)
+{
+    int retval;
+    vccrypt_mac_context_t mac;
+    vccrypt_buffer_t digest;
+    uint8_t* payload;
+
+    /* move about the same amount of data as the round trip cases. */
+    uint32_t iterations = conf->iterations;
+    if (0 == iterations)
+    {
+        iterations = BENCH_BYTES_PER_CASE / size;
+        if (iterations < BENCH_MIN_ITERATIONS)
+            iterations = BENCH_MIN_ITERATIONS;
+        if (iterations > BENCH_MAX_ITERATIONS)
+            iterations = BENCH_MAX_ITERATIONS;
+    }
+
+    payload = (uint8_t*)malloc(size);
+    if (NULL == payload)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    memset(payload, 0xA5, size);
+
+    retval =
+        vccrypt_buffer_init(
+            &digest, &conf->alloc_opts, conf->suite.mac_short_opts.mac_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_payload;
+    }
+
+    /* time the context setup and teardown on their own. */
+    uint64_t start = bench_now();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        retval =
+            vccrypt_suite_mac_short_init(&conf->suite, &mac, &conf->secret);
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_digest;
+        }
+
+        dispose((disposable_t*)&mac);
+    }
+    uint64_t init_total = bench_now() - start;
+
+    /* time the whole MAC, as each authed packet computes it. */
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; ++i)
+    {
+        retval =
+            vccrypt_suite_mac_short_init(&conf->suite, &mac, &conf->secret);
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_digest;
+        }
+
+        retval = vccrypt_mac_digest(&mac, payload, size);
+        if (VCCRYPT_STATUS_SUCCESS == retval)
+        {
+            retval = vccrypt_mac_finalize(&mac, &digest);
+        }
+
+        dispose((disposable_t*)&mac);
+        if (VCCRYPT_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_digest;
+        }
+    }
+    uint64_t packet_total = bench_now() - start;
+
+    printf(
+        "{\"api\":\"mac_short\",\"payload_bytes\":%u,\"iterations\":%u,"
+        "\"packet_ns\":%llu,\"init_ns\":%llu,\"init_share\":%.3f}\n",
+        size, iterations,
+        (unsigned long long)(packet_total / iterations),
+        (unsigned long long)(init_total / iterations),
+        (double)init_total / (double)packet_total);
+    fflush(stdout);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_digest:
+    dispose((disposable_t*)&digest);
+
+cleanup_payload:
+    free(payload);
+
+    return retval;
+}
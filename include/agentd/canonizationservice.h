@@ -11,6 +11,7 @@
 
 #include <agentd/bootstrap_config.h>
 #include <agentd/config.h>
+#include <agentd/ipc.h>
 #include <agentd/protocolservice/api.h>
 #include <vpr/disposable.h>
 
@@ -25,6 +26,10 @@ extern "C" {
  *
  * \param datasock      The data service socket.  The canonization service
  *                      communicates with the dataservice using this socket.
+ * \param ring          Optional shared-memory ring to the data service, or
+ *                      NULL.  When set, dataservice requests travel over this
+ *                      ring, and the data service socket is only watched for
+ *                      hangup.
  * \param randomsock    The random service socket.  The canonization service
  *                      communicates with the random service using this socket.
  * \param logsock       The logging service socket.  The canonization service
@@ -43,7 +48,8 @@ extern "C" {
  *            running the protocol service event loop failed.
  */
 int canonizationservice_event_loop(
-    int datasock, int randomsock, int logsock, int controlsock);
+    int datasock, const ipc_ring_descriptors_t* ring, int randomsock,
+    int logsock, int controlsock);
 
 /**
  * \brief Spawn a canonization service process using the provided config
@@ -58,6 +64,9 @@ int canonizationservice_event_loop(
  *                          logger.
  * \param datasock          Pointer to the socket used to communicate with the
  *                          data service.
+ * \param ring              Optional shared-memory ring to the data service, or
+ *                          NULL.  The caller keeps ownership of these
+ *                          descriptors.
  * \param randomsock        Pointer to the socket used to communicate with the
  *                          random service.
  * \param controlsock       Pointer to the socket used to control the
@@ -92,8 +101,8 @@ int canonizationservice_event_loop(
  */
 int start_canonization_proc(
     const bootstrap_config_t* bconf, const agent_config_t* conf, int* logsock,
-    int* datasock, int* randomsock, int* controlsock, pid_t* canonizationpid,
-    bool runsecure);
+    int* datasock, const ipc_ring_descriptors_t* ring, int* randomsock,
+    int* controlsock, pid_t* canonizationpid, bool runsecure);
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
@@ -140,11 +140,16 @@ typedef struct config_materialized_view
 #define CONFIG_STREAM_TYPE_USERGROUP 0x08
 #define CONFIG_STREAM_TYPE_BLOCK_MAX_MILLISECONDS 0x09
 #define CONFIG_STREAM_TYPE_BLOCK_MAX_TRANSACTIONS 0x0A
+#define CONFIG_STREAM_TYPE_PROTOCOL_WORKERS 0x0B
+#define CONFIG_STREAM_TYPE_IPC_RING_CAPACITY 0x0C
 #define CONFIG_STREAM_TYPE_EOM 0x80
 #define CONFIG_STREAM_TYPE_ERROR 0xFF
 
 #define BLOCK_MILLISECONDS_MAXIMUM 43200000
 #define BLOCK_TRANSACTIONS_MAXIMUM 100000
+#define PROTOCOL_WORKERS_MAXIMUM 64
+#define IPC_RING_CAPACITY_MINIMUM 4096
+#define IPC_RING_CAPACITY_MAXIMUM 1073741824
 /**
  * \brief Root of the agent configuration AST.
  */
@@ -158,6 +163,10 @@ typedef struct agent_config
     int64_t block_max_milliseconds;
     bool block_max_transactions_set;
     int64_t block_max_transactions;
+    bool protocol_workers_set;
+    int64_t protocol_workers;
+    bool ipc_ring_capacity_set;
+    int64_t ipc_ring_capacity;
     const char* secret;
     const char* rootblock;
     const char* datastore;
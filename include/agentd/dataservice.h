@@ -13,6 +13,7 @@
 #include <agentd/bootstrap_config.h>
 #include <agentd/config.h>
 #include <agentd/dataservice/data.h>
+#include <agentd/ipc.h>
 #include <stdbool.h>
 #include <vpr/disposable.h>
 
@@ -310,6 +311,39 @@ enum dataservice_api_method_enum
      */
     DATASERVICE_API_METHOD_APP_BLOCK_ID_BY_HEIGHT_READ,
 
+    /**
+     * \brief Make a block from the attested transactions in the process queue.
+     *
+     * The block certificate is assembled by the data service, and is then
+     * written to the block table as per DATASERVICE_API_METHOD_APP_BLOCK_WRITE.
+     */
+    DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE,
+
+    /**
+     * \brief Subscribe a child context to block commit notifications.
+     *
+     * This requires the DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ
+     * capability.  The subscription lasts until the child context is closed.
+     */
+    DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE,
+
+    /**
+     * \brief Watch a set of artifacts for updates.
+     *
+     * This requires the DATASERVICE_API_CAP_APP_ARTIFACT_READ capability.  The
+     * watches last until the child context is closed.
+     */
+    DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH,
+
+    /**
+     * \brief Read a slice of a block certificate by block ID.
+     *
+     * This requires the DATASERVICE_API_CAP_APP_BLOCK_READ capability.  A
+     * large certificate is read a slice at a time, so that it never has to be
+     * copied out of the database whole.
+     */
+    DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ,
+
     /**
      * \brief The number of methods in this API.
      *
@@ -318,6 +352,29 @@ enum dataservice_api_method_enum
     DATASERVICE_API_METHOD_UPPER_BOUND
 };
 
+/**
+ * \brief Data service notifications.
+ *
+ * Notifications are written by the data service without a request, using the
+ * same packet format as a response.  Their codes are kept well clear of the
+ * API methods so that a client can tell the two apart.
+ */
+enum dataservice_api_notification_enum
+{
+    /**
+     * \brief A new block was committed.  Sent to each child context subscribed
+     * with DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE.
+     */
+    DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT = 0x00010000,
+
+    /**
+     * \brief A watched artifact was updated by a committed block.  Sent to
+     * each child context watching the artifact with
+     * DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH.
+     */
+    DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE = 0x00010001,
+};
+
 /* forward decl for dataservice_transaction_context. */
 struct dataservice_transaction_context;
 
@@ -338,6 +395,18 @@ typedef struct
  *                      requests on this socket and sends responses.
  * \param logsock       The logging service socket.  The data service logs data
  *                      on this socket.
+ * \param ring          Optional shared-memory ring, or NULL.  When set, the
+ *                      data service also serves requests on the right-hand
+ *                      side of this ring, and sends notifications there.
+ * \param blocksubscribe    Optional socket on which another data service
+ *                          signals each block that it commits, or -1.  When
+ *                          set, subscribers are notified as soon as a block
+ *                          is signaled, and the block notification timer is
+ *                          only a fallback.
+ * \param blockpublish_start    The first of blockpublish_count consecutive
+ *                              sockets on which this data service signals
+ *                              each block that it commits.
+ * \param blockpublish_count    The number of block publish sockets.
  *
  * \returns a status code on service exit indicating a normal or abnormal exit.
  *          - AGENTD_STATUS_SUCCESS on normal exit.
@@ -352,7 +421,18 @@ typedef struct
  *          - AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_RUN_FAILURE if running the
  *            dataservice event loop failed.
  */
-int dataservice_event_loop(int datasock, int logsock);
+int dataservice_event_loop(
+    int datasock, int logsock, const ipc_ring_descriptors_t* ring,
+    int blocksubscribe, int blockpublish_start, size_t blockpublish_count);
+
+/**
+ * \brief Count the open descriptors in a run of consecutive descriptors.
+ *
+ * \param start         The first descriptor in the run.
+ *
+ * \returns the number of open descriptors before the first closed descriptor.
+ */
+size_t dataservice_count_sockets(int start);
 
 /**
  * \brief Spawn a data service process using the provided config structure and
@@ -370,6 +450,16 @@ int dataservice_event_loop(int datasock, int logsock);
  *                      logger.
  * \param datasock      Pointer to the data service socket, to be updated on
  *                      successful completion of this function.
+ * \param ring          Optional shared-memory ring to hand to the data service
+ *                      alongside its socket, or NULL.  The caller keeps
+ *                      ownership of these descriptors.
+ * \param blocksubscribe    Optional socket on which the data service is told
+ *                          of blocks committed by another data service, or -1.
+ *                          The caller keeps ownership of this descriptor.
+ * \param blockpublish      Array of sockets on which the data service tells
+ *                          other data services of the blocks that it commits.
+ *                          The caller keeps ownership of these descriptors.
+ * \param blockpublish_count    The number of sockets in blockpublish.
  * \param datapid       Pointer to the data service pid, to be updated on the
  *                      successful completion of this function.
  * \param runsecure     Set to false if we are not being run in secure mode.
@@ -398,7 +488,9 @@ int dataservice_event_loop(int datasock, int logsock);
  */
 int dataservice_proc(
     const bootstrap_config_t* bconf, const agent_config_t* conf, int* logsock,
-    int* datasock, pid_t* datapid, bool runsecure);
+    int* datasock, const ipc_ring_descriptors_t* ring, int blocksubscribe,
+    int* blockpublish, size_t blockpublish_count, pid_t* datapid,
+    bool runsecure);
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
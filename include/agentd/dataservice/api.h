@@ -1286,6 +1286,90 @@ int dataservice_api_sendreq_block_make(
 int dataservice_api_recvresp_block_make(
     ipc_socket_context_t* sock, uint32_t* offset, uint32_t* status);
 
+/**
+ * \brief Make a block from attested transactions in the transaction queue.
+ *
+ * The data service assembles the block certificate from the attested
+ * transactions at the head of the transaction queue, so the transaction
+ * certificates never leave the data service.  If this call is successful, then
+ * this block and those transactions are canonized.
+ *
+ * \param sock              The socket on which this request is made.
+ * \param child             The child index used for this operation.
+ * \param block_id          The block UUID bytes for this block.
+ * \param block_height      The height of this block.
+ * \param max_transactions  The maximum number of transactions in this block.
+ * \param max_block_size    The maximum size of this block, or 0 for no limit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_block_make_from_queue(
+    ipc_socket_context_t* sock, uint32_t child, const uint8_t* block_id,
+    uint64_t block_height, uint32_t max_transactions, uint32_t max_block_size);
+
+/**
+ * \brief Receive a response from the block make from queue operation.
+ *
+ * \param sock              The socket on which this request is made.
+ * \param offset            The child context offset for this response.
+ * \param status            This value is updated with the status code returned
+ *                          from the request.
+ * \param block_id          Pointer to the 16 byte array to receive the block
+ *                          id.
+ * \param transaction_count Pointer to receive the number of transactions in
+ *                          this block.
+ * \param block_hash        Pointer to receive the block hash.
+ * \param block_hash_size   Pointer to receive the block hash size.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  A zero
+ * status indicates success, and a non-zero status indicates failure.  On
+ * success, the block id, transaction count, and block hash are updated to
+ * reflect the block that was made.  The block hash is a dynamically allocated
+ * buffer that must be freed by the caller.
+ *
+ * If the status code is updated with an error from the service, then this error
+ * will be reflected in the status variable, and a AGENTD_STATUS_SUCCESS will be
+ * returned by this function.  Thus, both the return value of this function and
+ * the upstream status code must be checked for correct operation.  Here are a
+ * few possible status codes; it is not possible to list them all.
+ *      - AGENTD_STATUS_SUCCESS if the remote operation completed successfully.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if there were no attested
+ *        transactions in the transaction queue.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this client node is not
+ *        authorized to perform the requested operation.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT if the block height for
+ *        this block was not valid.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_UUID if the block uuid for this
+ *        block was invalid or already exists.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the operation was halted because it
+ *        would block this thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_READ_DATA_FAILURE if reading data from
+ *        the socket failed.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_DATA_PACKET_SIZE if the
+ *        data packet size is unexpected.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        method code was unexpected.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_MALFORMED_PAYLOAD_DATA if the
+ *        payload data was malformed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int dataservice_api_recvresp_block_make_from_queue(
+    ipc_socket_context_t* sock, uint32_t* offset, uint32_t* status,
+    uint8_t* block_id, uint32_t* transaction_count, void** block_hash,
+    size_t* block_hash_size);
+
 /**
  * \brief Get a block from the dataservice by ID.
  *
@@ -1505,6 +1589,81 @@ int dataservice_api_recvresp_latest_block_id_get(
     ipc_socket_context_t* sock, uint32_t* offset, uint32_t* status,
     uint8_t* block_id);
 
+/**
+ * \brief Subscribe a child context to block commit notifications.
+ *
+ * The response carries the latest block id and height at the time of
+ * subscription.  From then on, each block commit is reported with a
+ * DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT packet for this child context,
+ * which can be decoded with \ref dataservice_decode_response_block_notify().
+ *
+ * \param sock          The socket on which this request is made.
+ * \param child         The child index to subscribe.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_block_notify_subscribe(
+    ipc_socket_context_t* sock, uint32_t child);
+
+/**
+ * \brief Watch a set of artifacts for updates.
+ *
+ * Once watched, each update to one of these artifacts in a committed block is
+ * reported with a DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE packet for this
+ * child context, which can be decoded with
+ * \ref dataservice_decode_response_artifact_notify().
+ *
+ * \param sock          The socket on which this request is made.
+ * \param child         The child index watching these artifacts.
+ * \param artifact_ids  The artifact UUIDs to watch, 16 bytes each.
+ * \param count         The number of artifact UUIDs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_artifact_watch(
+    ipc_socket_context_t* sock, uint32_t child, const uint8_t* artifact_ids,
+    size_t count);
+
+/**
+ * \brief Read a slice of a block certificate from the dataservice by block ID.
+ *
+ * The response carries the block node, the size of the whole certificate, and
+ * at most max_size bytes of the certificate starting at cert_offset.  It can
+ * be decoded with \ref dataservice_decode_response_block_cert_read().
+ *
+ * \param sock          The socket on which this request is made.
+ * \param child         The child index used for the query.
+ * \param block_id      The block UUID of the certificate to read.
+ * \param cert_offset   The offset of the slice within the certificate.
+ * \param max_size      The largest slice to return.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_block_cert_read(
+    ipc_socket_context_t* sock, uint32_t child, const uint8_t* block_id,
+    uint64_t cert_offset, uint32_t max_size);
+
 /**
  * \brief Get a canonized transaction from the transaction database by ID.
  *
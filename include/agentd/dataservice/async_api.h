@@ -145,6 +145,18 @@ typedef struct dataservice_response_block_make
     dataservice_response_header_t hdr;
 } dataservice_response_block_make_t;
 
+/**
+ * \brief Block Make From Queue Response.
+ */
+typedef struct dataservice_response_block_make_from_queue
+{
+    dataservice_response_header_t hdr;
+    uint8_t block_id[16];
+    uint32_t transaction_count;
+    const void* block_hash;
+    size_t block_hash_size;
+} dataservice_response_block_make_from_queue_t;
+
 /**
  * \brief Block ID by Height Get Response.
  */
@@ -163,6 +175,53 @@ typedef struct dataservice_response_latest_block_id_get
     uint8_t block_id[16];
 } dataservice_response_latest_block_id_get_t;
 
+/**
+ * \brief Block Notify Response.
+ *
+ * This is used both for the block notification subscribe response and for
+ * block commit notifications.
+ */
+typedef struct dataservice_response_block_notify
+{
+    dataservice_response_header_t hdr;
+    uint8_t block_id[16];
+    uint64_t height;
+} dataservice_response_block_notify_t;
+
+/**
+ * \brief Block Certificate Read Response.
+ *
+ * The node's net_block_cert_size holds the size of the whole certificate, and
+ * data holds the requested slice of it.
+ */
+typedef struct dataservice_response_block_cert_read
+{
+    dataservice_response_header_t hdr;
+    data_block_node_t node;
+    const void* data;
+    size_t data_size;
+} dataservice_response_block_cert_read_t;
+
+/**
+ * \brief Artifact Watch Response.
+ */
+typedef struct dataservice_response_artifact_watch
+{
+    dataservice_response_header_t hdr;
+} dataservice_response_artifact_watch_t;
+
+/**
+ * \brief Artifact Update Notification.
+ */
+typedef struct dataservice_response_artifact_notify
+{
+    dataservice_response_header_t hdr;
+    uint8_t artifact_id[16];
+    uint8_t txn_latest[16];
+    uint64_t height_latest;
+    uint32_t state_latest;
+} dataservice_response_artifact_notify_t;
+
 /**
  * \brief Artifact Get Response.
  */
@@ -436,6 +495,25 @@ int dataservice_decode_response_block_make(
     const void* resp, size_t size,
     dataservice_response_block_make_t* dresp);
 
+/**
+ * \brief Decode a response from the block make from queue operation.
+ *
+ * \param resp          The response payload to parse.
+ * \param size          The size of this response payload.
+ * \param dresp         The decoded response structure into which this response
+ *                      is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the response
+ *        packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ */
+int dataservice_decode_response_block_make_from_queue(
+    const void* resp, size_t size,
+    dataservice_response_block_make_from_queue_t* dresp);
+
 /**
  * \brief Decode a response from the get block id by height query.
  *
@@ -474,6 +552,89 @@ int dataservice_decode_response_latest_block_id_get(
     const void* resp, size_t size,
     dataservice_response_latest_block_id_get_t* dresp);
 
+/**
+ * \brief Decode a block notification subscribe response or a block commit
+ * notification.
+ *
+ * \param resp          The response payload to parse.
+ * \param size          The size of this response payload.
+ * \param dresp         The decoded response structure into which this response
+ *                      is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the response
+ *        packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        packet is neither a subscribe response nor a block notification.
+ */
+int dataservice_decode_response_block_notify(
+    const void* resp, size_t size,
+    dataservice_response_block_notify_t* dresp);
+
+/**
+ * \brief Decode a response from the block certificate read request.
+ *
+ * \param resp          The response payload to parse.
+ * \param size          The size of this response payload.
+ * \param dresp         The decoded response structure into which this response
+ *                      is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the response
+ *        packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        response is not a block certificate read response.
+ */
+int dataservice_decode_response_block_cert_read(
+    const void* resp, size_t size,
+    dataservice_response_block_cert_read_t* dresp);
+
+/**
+ * \brief Decode a response from the artifact watch request.
+ *
+ * \param resp          The response payload to parse.
+ * \param size          The size of this response payload.
+ * \param dresp         The decoded response structure into which this response
+ *                      is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the response
+ *        packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ */
+int dataservice_decode_response_artifact_watch(
+    const void* resp, size_t size,
+    dataservice_response_artifact_watch_t* dresp);
+
+/**
+ * \brief Decode an artifact update notification.
+ *
+ * \param resp          The notification payload to parse.
+ * \param size          The size of this notification payload.
+ * \param dresp         The decoded response structure into which this
+ *                      notification is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the
+ *        notification packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        packet is not an artifact update notification.
+ */
+int dataservice_decode_response_artifact_notify(
+    const void* resp, size_t size,
+    dataservice_response_artifact_notify_t* dresp);
+
 /**
  * \brief Decode a response from the get artifact query.
  *
@@ -263,8 +263,6 @@ int dataservice_global_settings_set(
  *            when reading data from the database.
  *          - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if a failure occurred
  *            when writing data to the database.
- *          - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition
- *            was detected during this operation.
  */
 int dataservice_transaction_submit(
     dataservice_child_context_t* child,
@@ -360,8 +358,6 @@ int dataservice_transaction_get(
  *        authorized to call this function.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -386,8 +382,6 @@ int dataservice_transaction_drop(
  *        authorized to call this function.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -463,12 +457,83 @@ int dataservice_transaction_promote(
  *        missing its state field.
  *      - AGENTD_ERROR_DATASERVICE_INVALID_ARTIFACT_NODE_SIZE if an invalid
  *        artifact node was encountered.
+ *      - AGENTD_ERROR_DATASERVICE_BLOCK_TRANSACTION_OUT_OF_ORDER if a child
+ *        transaction appears in this block before its predecessor.
  */
 int dataservice_block_make(
     dataservice_child_context_t* child,
     dataservice_transaction_context_t* dtxn_ctx, const uint8_t* block_id,
     const uint8_t* block_data, size_t block_size);
 
+/**
+ * \brief Make a block from the attested transactions at the head of the
+ * transaction process queue.
+ *
+ * The data service walks the transaction process queue from its beginning,
+ * collecting attested transactions until either a transaction that has not
+ * been attested is found, the end of the queue is reached, or one of the
+ * provided limits is met.  These transactions are wrapped in a block
+ * certificate which is then canonized as per \ref dataservice_block_make.  All
+ * of this occurs under a single database transaction, so the block is either
+ * made in its entirety or not at all.
+ *
+ * \param child             The child context for this operation.
+ * \param dtxn_ctx          The dataservice transaction context for this
+ *                          operation.
+ * \param block_id          The block ID for this block.
+ * \param block_height      The expected height of this block.
+ * \param max_transactions  The maximum number of transactions to include in
+ *                          this block.  Must be greater than zero.
+ * \param max_block_size    The maximum size of the block certificate, or zero
+ *                          if the size is not limited.  A block always contains
+ *                          at least one transaction, even if that transaction
+ *                          would exceed this limit.
+ * \param block_hash        Buffer to receive the hash of the block certificate.
+ * \param block_hash_size   On input, the size of the block hash buffer.  On
+ *                          success, this is updated to the size of the hash.
+ * \param transaction_count Pointer to receive the number of transactions
+ *                          canonized in this block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if there are no attested
+ *        transactions at the head of the transaction process queue.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
+ *        encountered during this operation.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this child context is not
+ *        authorized to call this function.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT if the block height does
+ *        not follow the latest block in the blockchain.
+ *      - AGENTD_ERROR_DATASERVICE_WOULD_TRUNCATE if the block hash buffer is
+ *        too small to hold the block hash.
+ *      - AGENTD_ERROR_DATASERVICE_VCCRYPT_SUITE_OPTIONS_INIT_FAILURE if this
+ *        function failed to initialize crypto suite options.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_OPTIONS_INIT_FAILURE if this
+ *        function failed to initialize builder options.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_INIT_FAILURE if this function
+ *        failed to initialize a certificate builder.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE if this function
+ *        failed to add a field to or emit the block certificate.
+ *      - AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE if this function failed
+ *        to compute the block hash.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function failed
+ *        to create a database transaction.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_COMMIT_FAILURE if this function
+ *        failed to commit the database transaction.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function could not
+ *        read from the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_BLOCK_NODE if this function
+ *        encountered an invalid block node in the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE if this
+ *        function encountered an invalid transaction node in the database.
+ *      - any error code returned by \ref dataservice_block_make.
+ */
+int dataservice_block_make_from_queue(
+    dataservice_child_context_t* child,
+    dataservice_transaction_context_t* dtxn_ctx, const uint8_t* block_id,
+    uint64_t block_height, size_t max_transactions, size_t max_block_size,
+    uint8_t* block_hash, size_t* block_hash_size, size_t* transaction_count);
+
 /**
  * \brief Query the blockchain for a block by UUID.
  *
@@ -51,6 +51,41 @@ extern "C" {
  */
 #define AGENTD_FD_DATASERVICE_LOG ((int)1)
 
+/**
+ * \brief File descriptor for the shared memory of the optional data service
+ * ring.
+ * Used by the data service private command.
+ */
+#define AGENTD_FD_DATASERVICE_RING_MEM ((int)2)
+
+/**
+ * \brief File descriptor for the left-hand-side doorbell of the optional data
+ * service ring.
+ * Used by the data service private command.
+ */
+#define AGENTD_FD_DATASERVICE_RING_LHS ((int)3)
+
+/**
+ * \brief File descriptor for the right-hand-side doorbell of the optional data
+ * service ring.
+ * Used by the data service private command.
+ */
+#define AGENTD_FD_DATASERVICE_RING_RHS ((int)4)
+
+/**
+ * \brief File descriptor on which the optional block publish socket is
+ * received, signaling that the canonization data service committed a block.
+ * Used by the data service private command.
+ */
+#define AGENTD_FD_DATASERVICE_BLOCK_SUBSCRIBE ((int)5)
+
+/**
+ * \brief File descriptor for the first of the optional block publish sockets,
+ * on which the data service signals each committed block.
+ * Used by the data service private command.
+ */
+#define AGENTD_FD_DATASERVICE_BLOCK_PUBLISH_START ((int)6)
+
 /******************************************************************************/
 /* Listen Service                                                             */
 /******************************************************************************/
@@ -128,6 +163,27 @@ extern "C" {
  */
 #define AGENTD_FD_UNAUTHORIZED_PROTOSVC_RANDOM ((int)3)
 
+/**
+ * \brief File descriptor for the shared memory of the optional data service
+ * ring.
+ * Used by the unauthorized protocol service private command.
+ */
+#define AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_MEM ((int)4)
+
+/**
+ * \brief File descriptor for the left-hand-side doorbell of the optional data
+ * service ring.
+ * Used by the unauthorized protocol service private command.
+ */
+#define AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_LHS ((int)5)
+
+/**
+ * \brief File descriptor for the right-hand-side doorbell of the optional data
+ * service ring.
+ * Used by the unauthorized protocol service private command.
+ */
+#define AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_RHS ((int)6)
+
 /******************************************************************************/
 /* Random Service                                                             */
 /******************************************************************************/
@@ -179,6 +235,27 @@ extern "C" {
  */
 #define AGENTD_FD_CANONIZATION_SVC_CONTROL ((int)3)
 
+/**
+ * \brief File descriptor for the shared memory of the optional data service
+ * ring.
+ * Used by the canonization service private command.
+ */
+#define AGENTD_FD_CANONIZATION_SVC_RING_MEM ((int)4)
+
+/**
+ * \brief File descriptor for the left-hand-side doorbell of the optional data
+ * service ring.
+ * Used by the canonization service private command.
+ */
+#define AGENTD_FD_CANONIZATION_SVC_RING_LHS ((int)5)
+
+/**
+ * \brief File descriptor for the right-hand-side doorbell of the optional data
+ * service ring.
+ * Used by the canonization service private command.
+ */
+#define AGENTD_FD_CANONIZATION_SVC_RING_RHS ((int)6)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
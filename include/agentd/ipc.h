@@ -9,10 +9,12 @@
 #ifndef AGENTD_IPC_HEADER_GUARD
 #define AGENTD_IPC_HEADER_GUARD
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <vccrypt/suite.h>
 #include <vpr/disposable.h>
@@ -34,6 +36,96 @@ extern "C" {
 #define IPC_DATA_TYPE_AUTHED_PACKET 0x30
 #define IPC_DATA_TYPE_EOM 0xFF
 
+/**
+ * \brief The sides of a shared-memory ring.
+ */
+typedef enum ipc_ring_side_enum
+{
+    /**
+     * \brief The left-hand side of the ring.
+     */
+    IPC_RING_SIDE_LHS = 0,
+
+    /**
+     * \brief The right-hand side of the ring.
+     */
+    IPC_RING_SIDE_RHS = 1
+
+} ipc_ring_side_enum_t;
+
+/**
+ * \brief The descriptors making up a shared-memory ring, as created by
+ * \ref ipc_ringpair().  A descriptor that isn't open is -1.
+ */
+typedef struct ipc_ring_descriptors
+{
+    int memfd;
+    int lhs;
+    int rhs;
+} ipc_ring_descriptors_t;
+
+/**
+ * \brief The default capacity of each direction of a shared-memory ring.
+ */
+#define IPC_RING_DEFAULT_CAPACITY (1024U * 1024U)
+
+/**
+ * \brief The default number of bytes that a non-blocking read tries to pull
+ * from a socket at once.
+ */
+#define IPC_SOCKET_DEFAULT_READ_CHUNK (64U * 1024U)
+
+/**
+ * \brief The largest number of socket descriptors passed in a single message
+ * by \ref ipc_sendsockets_noblock().
+ */
+#define IPC_SOCKET_BATCH_MAX 64U
+
+/**
+ * \brief Frame types making up a streamed authenticated message.
+ */
+typedef enum ipc_stream_frame_enum
+{
+    /**
+     * \brief Starts a stream, and carries the total size of its payload.
+     */
+    IPC_STREAM_FRAME_BEGIN = 1,
+
+    /**
+     * \brief Carries the next part of the stream's payload.
+     */
+    IPC_STREAM_FRAME_CHUNK = 2,
+
+    /**
+     * \brief Ends a stream, once its full payload has been sent.
+     */
+    IPC_STREAM_FRAME_END = 3
+
+} ipc_stream_frame_enum_t;
+
+/**
+ * \brief The largest payload carried by a single stream chunk.
+ */
+#define IPC_STREAM_MAX_CHUNK_SIZE (1024U * 1024U)
+
+/**
+ * \brief The largest payload accepted in a single authenticated packet.
+ * Larger payloads must be sent as a stream.
+ */
+#define IPC_AUTHED_PACKET_MAX_SIZE (10U * 1024U * 1024U)
+
+/**
+ * \brief Reader state for a streamed authenticated message.
+ *
+ * This must be zeroed before the first frame is read from a socket.
+ */
+typedef struct ipc_stream_reader
+{
+    bool open;
+    uint64_t total_size;
+    uint64_t received;
+} ipc_stream_reader_t;
+
 /* forward decl for ipc_socket_context. */
 struct ipc_socket_context;
 
@@ -75,6 +167,18 @@ typedef enum ipc_socket_event_flags_enum
 typedef void (*ipc_socket_event_cb_t)(
     struct ipc_socket_context* ctx, int event_flags, void* user_context);
 
+/**
+ * \brief Callback method for an IPC write buffer watermark event.
+ *
+ * \param ctx           The non-blocking socket context whose write buffer
+ *                      crossed a watermark.
+ * \param above         true if the write buffer rose to the high watermark,
+ *                      false if it fell back to the low watermark.
+ * \param user_context  The user context associated with this socket.
+ */
+typedef void (*ipc_socket_watermark_cb_t)(
+    struct ipc_socket_context* ctx, bool above, void* user_context);
+
 /**
  * \brief Callback method for an IPC timer event.
  *
@@ -84,6 +188,14 @@ typedef void (*ipc_socket_event_cb_t)(
 typedef void (*ipc_timer_event_cb_t)(
     ipc_timer_context_t* timer, void* user_context);
 
+/**
+ * \brief Callback method for an IPC signal event.
+ *
+ * \param sig           The signal that was caught.
+ * \param user_context  The user context associated with this signal event.
+ */
+typedef void (*ipc_signal_event_cb_t)(int sig, void* user_context);
+
 /**
  * \brief Socket context used for asynchronous (non-blocking) I/O.  Contains an
  * opaque reference to the underlying async I/O implementation.
@@ -145,6 +257,56 @@ typedef struct ipc_event_loop_context
  */
 int ipc_socketpair(int domain, int type, int protocol, int* lhs, int* rhs);
 
+/**
+ * \brief Create a shared-memory ring pair, as an alternative to a socket pair
+ * for non-blocking I/O between two services.
+ *
+ * The ring consists of a sealed memfd holding one single-producer,
+ * single-consumer ring per direction, and an eventfd doorbell for each side.
+ * On success, memfd is set to the shared memory descriptor, and lhs and rhs
+ * are set to the doorbells for the left-hand and right-hand sides.  Each side
+ * is opened with \ref ipc_make_ring_noblock().
+ *
+ * \param capacity      The capacity of each direction of the ring, in bytes.
+ *                      This must be a power of two no smaller than 4096 and
+ *                      no larger than 1 GB.
+ * \param memfd         Pointer to the integer variable updated to the shared
+ *                      memory descriptor.
+ * \param lhs           Pointer to the integer variable updated to the
+ *                      left-hand-side doorbell.
+ * \param rhs           Pointer to the integer variable updated to the
+ *                      right-hand-side doorbell.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if the capacity is invalid.
+ *      - AGENTD_ERROR_IPC_RING_CREATE_FAILURE if creating the shared memory
+ *        or the doorbells failed.
+ *      - AGENTD_ERROR_IPC_RING_MAP_FAILURE if mapping the shared memory
+ *        failed.
+ */
+int ipc_ringpair(uint32_t capacity, int* memfd, int* lhs, int* rhs);
+
+/**
+ * \brief Check whether every descriptor of a shared-memory ring is open.
+ *
+ * Services use this to find out whether the process that spawned them handed
+ * them a ring alongside their sockets.
+ *
+ * \param ring          The ring descriptors to check.
+ *
+ * \returns true if the memfd and both doorbells are open, and false otherwise.
+ */
+bool ipc_ring_descriptors_valid(const ipc_ring_descriptors_t* ring);
+
+/**
+ * \brief Close any open descriptors of a shared-memory ring, and set them to
+ * -1.
+ *
+ * \param ring          The ring descriptors to close.
+ */
+void ipc_ring_descriptors_close(ipc_ring_descriptors_t* ring);
+
 /**
  * \brief Set a socket for synchronous (blocking) I/O.  Afterward, the
  * ipc_*_block socket I/O methods can be used.
@@ -187,6 +349,43 @@ int ipc_make_block(int sock);
 int ipc_make_noblock(
     int sock, ipc_socket_context_t* ctx, void* user_context);
 
+/**
+ * \brief Open one side of a shared-memory ring for asynchronous (non-blocking)
+ * I/O.  Afterward, the ipc_*_noblock socket I/O methods can be used exactly as
+ * they would be for a socket.
+ *
+ * The doorbell for this side becomes the descriptor of the socket context and
+ * is owned by it.  The shared memory and the peer's doorbell are duplicated
+ * or mapped, so the caller still owns memfd and peer_doorbell and should close
+ * them once both sides have been opened.  The blocking ipc_*_block methods do
+ * not work on a ring.
+ *
+ * \param memfd         The shared memory descriptor from \ref ipc_ringpair().
+ * \param side          The side of the ring being opened.  See
+ *                      \ref ipc_ring_side_enum_t.
+ * \param doorbell      The doorbell for this side.
+ * \param peer_doorbell The doorbell for the other side.
+ * \param ctx           The socket context to initialize using this call.
+ * \param user_context  The user context for this connection.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition
+ *        occurred during this operation.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if the side is invalid.
+ *      - AGENTD_ERROR_IPC_RING_MAP_FAILURE if mapping the shared memory or
+ *        duplicating the peer doorbell failed.
+ *      - AGENTD_ERROR_IPC_RING_INVALID if the shared memory is not a valid
+ *        ring.
+ *      - AGENTD_ERROR_IPC_FCNTL_GETFL_FAILURE if the fcntl flags could not be
+ *        read.
+ *      - AGENTD_ERROR_IPC_FCNTL_SETFL_FAILURE if the fcntl flags could not be
+ *        updated.
+ */
+int ipc_make_ring_noblock(
+    int memfd, int side, int doorbell, int peer_doorbell,
+    ipc_socket_context_t* ctx, void* user_context);
+
 /**
  * \brief Write a raw data packet.
  *
@@ -496,6 +695,8 @@ int ipc_event_loop_init(ipc_event_loop_context_t* loop);
  *        created.
  *      - AGENTD_ERROR_IPC_EVENT_ADD_FAILURE if the event cannot be added to the
  *        event loop.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the write buffer watermark
+ *        callback could not be added.
  */
 int ipc_event_loop_add(
     ipc_event_loop_context_t* loop, ipc_socket_context_t* sock);
@@ -522,6 +723,31 @@ int ipc_event_loop_add(
 int ipc_exit_loop_on_signal(
     ipc_event_loop_context_t* loop, int sig);
 
+/**
+ * \brief Call the given callback when the given signal is caught.
+ *
+ * Unlike \ref ipc_exit_loop_on_signal(), the event loop keeps running after
+ * the callback returns.  The callback is called from the event loop, so it is
+ * free to use any of the loop's sockets and timers.
+ *
+ * \param loop          The event loop context on which the callback is run.
+ * \param sig           The signal that triggers this callback.
+ * \param cb            The callback to call when the signal is caught.
+ * \param user_context  The user context to pass to the callback.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ *      - AGENTD_ERROR_IPC_EVSIGNAL_NEW_FAILURE if a new signal event could not
+ *        be created.
+ *      - AGENTD_ERROR_IPC_EVENT_ADD_FAILURE if the signal event could not be
+ *        added to the event base.
+ */
+int ipc_event_loop_on_signal(
+    ipc_event_loop_context_t* loop, int sig, ipc_signal_event_cb_t cb,
+    void* user_context);
+
 /**
  * \brief Instruct the loop to exit as soon as all events are processed.
  *
@@ -648,11 +874,82 @@ void ipc_set_writecb_noblock(
     ipc_socket_context_t* sock, ipc_socket_event_cb_t cb,
     ipc_event_loop_context_t* loop);
 
+/**
+ * \brief Set whether writes to a non-blocking socket are corked.
+ *
+ * When a socket is corked, ipc_write_data_noblock() and friends only append
+ * to the socket's write buffer.  The event loop then writes each corked socket
+ * with pending data once, at the end of the loop iteration, so several
+ * messages written by one handler go out in a single write.  Corking has no
+ * effect on a socket that has not been added to an event loop.
+ *
+ * \param sock          The socket to set.
+ * \param corked        true if writes should be corked, false otherwise.
+ */
+void ipc_set_cork_noblock(ipc_socket_context_t* sock, bool corked);
+
+/**
+ * \brief Set how much a non-blocking socket reads ahead.
+ *
+ * When a non-blocking read needs more data than is buffered, it reads up to
+ * this many bytes from the socket in one call, or the rest of the packet if
+ * that is larger.  Packets that arrive behind the one being read are then
+ * parsed from the read buffer without another system call.
+ *
+ * \param sock          The socket to set.
+ * \param chunk         The read-ahead size in bytes, which must be no more than
+ *                      INT_MAX, or 0 to use IPC_SOCKET_DEFAULT_READ_CHUNK.
+ */
+void ipc_set_read_chunk_noblock(ipc_socket_context_t* sock, size_t chunk);
+
+/**
+ * \brief Set the write buffer watermarks for a non-blocking socket.
+ *
+ * The callback is called once when the write buffer grows to at least high
+ * bytes, and once more when it then drains to at most low bytes, so a service
+ * can stop and restart the reads that feed this socket.  It is called from
+ * within the write or drain that crossed the watermark, and must not dispose
+ * this socket.  A high watermark of 0 disables the callback.
+ *
+ * \param sock          The socket to set.
+ * \param low           The low watermark, in bytes.
+ * \param high          The high watermark, in bytes.
+ * \param cb            The callback to call when a watermark is crossed.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if low is above high.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the write buffer callback could
+ *        not be added.
+ */
+int ipc_set_watermarks_noblock(
+    ipc_socket_context_t* sock, size_t low, size_t high,
+    ipc_socket_watermark_cb_t cb);
+
+/**
+ * \brief Stop delivering read events for a non-blocking socket.
+ *
+ * While paused, the read callback can still be changed with
+ * \ref ipc_set_readcb_noblock(), but it is not called until the socket is
+ * resumed.
+ *
+ * \param sock          The socket to pause.
+ */
+void ipc_pause_read_noblock(ipc_socket_context_t* sock);
+
+/**
+ * \brief Resume delivering read events for a paused non-blocking socket.
+ *
+ * \param sock          The socket to resume.
+ */
+void ipc_resume_read_noblock(ipc_socket_context_t* sock);
+
 /**
  * \brief Accept a connection from a listen socket.
  *
  * On success, the socket specified by sock contains a connection to a remote
- * peer.  The address parameter contains data about the peer.
+ * peer.  The address parameter contains data about the peer.  The accepted
+ * socket is non-blocking and close-on-exec.
  *
  * \param ctx           The non-blocking socket context from which a connection
  *                      is accepted.
@@ -668,6 +965,8 @@ void ipc_set_writecb_noblock(
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this operation would cause the socket
  *        to block.
+ *      - AGENTD_ERROR_IPC_ACCEPT_SHOULD_RETRY if this connection was lost
+ *        before it could be accepted, and the next one should be tried.
  *      - AGENTD_ERROR_IPC_ACCEPT_NOBLOCK_FAILURE if accepting this socket
  *        failed.
  */
@@ -710,6 +1009,53 @@ int ipc_sendsocket_block(int sock, int sendsock);
  */
 int ipc_receivesocket_noblock(ipc_socket_context_t* ctx, int* recvsock);
 
+/**
+ * \brief Send a batch of socket descriptors to the unix domain peer in a single
+ * message, without blocking.
+ *
+ * Up to IPC_SOCKET_BATCH_MAX descriptors from socks are sent.  On success,
+ * sent is set to the number of descriptors sent, which are the first sent
+ * entries of socks.  The caller maintains the local socket handles, and these
+ * should be closed by the caller once sent.
+ *
+ * \param ctx           The non-blocking unix domain socket through which the
+ *                      descriptors are sent.
+ * \param socks         The socket descriptors to send.
+ * \param count         The number of socket descriptors in socks.
+ * \param sent          Pointer to receive the number of descriptors sent.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if count is 0.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this operation would block, in which
+ *        case nothing was sent.
+ *      - AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE if this operation failed.
+ */
+int ipc_sendsockets_noblock(
+    ipc_socket_context_t* ctx, const int* socks, size_t count, size_t* sent);
+
+/**
+ * \brief Receive a batch of socket descriptors sent by the unix domain peer in
+ * a single message.
+ *
+ * This reads one message sent by \ref ipc_sendsockets_noblock() or
+ * \ref ipc_sendsocket_block().  socks must have room for IPC_SOCKET_BATCH_MAX
+ * descriptors.  The caller owns the received socket handles and must close
+ * them when no longer needed.
+ *
+ * \param ctx           The unix domain socket from which the descriptors are
+ *                      received.
+ * \param socks         Array to receive the socket descriptors.
+ * \param count         Pointer to receive the number of descriptors received.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this operation would block.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if this operation failed.
+ */
+int ipc_receivesockets_noblock(
+    ipc_socket_context_t* ctx, int* socks, size_t* count);
+
 /**
  * \brief Write a raw data packet to a non-blocking socket.
  *
@@ -765,6 +1111,137 @@ int ipc_write_authed_data_noblock(
     ipc_socket_context_t* sock, uint64_t iv, const void* val, uint32_t size,
     vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret);
 
+/**
+ * \brief Write a raw data packet, gathered from several fragments, to a
+ * non-blocking socket.
+ *
+ * The packet is framed directly in the socket's write buffer, so the caller
+ * does not need to assemble the fragments into a single buffer first.  On the
+ * wire, this packet is identical to one written by
+ * \ref ipc_write_data_noblock() with the concatenated fragments.
+ *
+ * \param sock          The socket context to which the value is written.
+ * \param iov           The fragments making up the payload of this packet.
+ * \param iovcnt        The number of fragments.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE if the packet is too
+ *        large to frame.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        payload data to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE if a non-blocking write
+ *        failed.
+ */
+int ipc_write_datav_noblock(
+    ipc_socket_context_t* sock, const struct iovec* iov, size_t iovcnt);
+
+/**
+ * \brief Write an authenticated data packet, gathered from several fragments,
+ * to a non-blocking socket.
+ *
+ * Each fragment is encrypted directly into the socket's write buffer, so the
+ * caller does not need to assemble the fragments into a single buffer first.
+ * On the wire, this packet is identical to one written by
+ * \ref ipc_write_authed_data_noblock() with the concatenated fragments.
+ *
+ * \param sock          The socket context to which the value is written.
+ * \param iv            The 64-bit IV to use for this packet.
+ * \param iov           The fragments making up the payload of this packet.
+ * \param iovcnt        The number of fragments.
+ * \param suite         The crypto suite to use for authenticating this packet.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE if the packet is too
+ *        large to frame.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        payload data to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_datav_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, const struct iovec* iov,
+    size_t iovcnt, vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret);
+
+/**
+ * \brief Begin a streamed authenticated message on a non-blocking socket.
+ *
+ * A stream lets a payload larger than a single authenticated packet be sent
+ * and consumed a piece at a time.  It is a begin frame, any number of chunk
+ * frames, and an end frame, each sent as its own authenticated packet with
+ * its own IV.  The chunk payloads must add up to total_size.
+ *
+ * \param sock          The socket context to which the frame is written.
+ * \param iv            The 64-bit IV to use for this frame.
+ * \param total_size    The total size of the payload that will follow.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        frame to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_stream_begin_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, uint64_t total_size,
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret);
+
+/**
+ * \brief Write the next chunk of a streamed authenticated message to a
+ * non-blocking socket.
+ *
+ * The chunk is encrypted from val into the socket's write buffer, so the
+ * write buffer holds a copy of the chunk until it is flushed.  Callers that
+ * stream a large payload should keep the write buffer bounded, for instance
+ * with \ref ipc_set_watermarks_noblock().
+ *
+ * \param sock          The socket context to which the frame is written.
+ * \param iv            The 64-bit IV to use for this frame.
+ * \param val           The payload of this chunk.
+ * \param size          The size of this chunk, between 1 and
+ *                      IPC_STREAM_MAX_CHUNK_SIZE bytes.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if the chunk size is out of range.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        frame to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_stream_chunk_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, const void* val, uint32_t size,
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret);
+
+/**
+ * \brief End a streamed authenticated message on a non-blocking socket.
+ *
+ * \param sock          The socket context to which the frame is written.
+ * \param iv            The 64-bit IV to use for this frame.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        frame to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_stream_end_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* secret);
+
 /**
  * \brief Write a character string to a non-blocking socket.
  *
@@ -930,6 +1407,147 @@ int ipc_read_authed_data_noblock(
     ipc_socket_context_t* sock, uint64_t iv, void** val, uint32_t* size,
     vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret);
 
+/**
+ * \brief Borrow a raw data packet from a non-blocking socket.
+ *
+ * On success, val is set to point to the payload of this packet in the
+ * socket's read buffer, and size is set to the size of the payload.  No copy
+ * is made.  The payload remains valid until \ref ipc_release_data_noblock() is
+ * called, which must happen before any other read on this socket.
+ *
+ * \param sock          The socket context from which the value is read.
+ * \param val           Pointer to receive the payload pointer.
+ * \param size          Pointer to the variable to receive the size of this
+ *                      packet.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
+ *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if an unexpected data type
+ *        was encountered when attempting to read this value.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if an unexpected data size
+ *        was encountered when attempting to read this value.
+ */
+int ipc_borrow_data_noblock(
+    ipc_socket_context_t* sock, void** val, uint32_t* size);
+
+/**
+ * \brief Borrow an authenticated data packet from a non-blocking socket.
+ *
+ * On success, the payload is decrypted into a buffer owned by the socket, and
+ * val is set to point to this buffer.  The buffer is reused across reads, so
+ * small packets do not require an allocation.  The payload remains valid
+ * until \ref ipc_release_data_noblock() is called, which must happen before
+ * any other read on this socket.
+ *
+ * \param sock          The socket context from which the value is read.
+ * \param iv            The 64-bit IV to expect for this packet.
+ * \param val           Pointer to receive the payload pointer.
+ * \param size          Pointer to the variable to receive the size of this
+ *                      packet.
+ * \param suite         The crypto suite to use for authenticating this packet.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
+ *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_READ_BUFFER_DRAIN_FAILURE if draining the read buffer
+ *        failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ *      - AGENTD_ERROR_IPC_UNAUTHORIZED_PACKET if the packet could not be
+ *        authenticated.
+ */
+int ipc_borrow_authed_data_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, void** val, uint32_t* size,
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret);
+
+/**
+ * \brief Accept a decrypted stream frame into a stream reader.
+ *
+ * This checks the frame against the reader's state, and updates that state,
+ * just as \ref ipc_borrow_authed_stream_noblock() does.  It lets a caller that
+ * reads authenticated packets some other way, such as a blocking client, follow
+ * a stream.
+ *
+ * \param reader        The stream state.
+ * \param payload       The decrypted payload of the frame.
+ * \param payload_size  The size of the decrypted payload.
+ * \param frame         Pointer to receive the frame type.
+ * \param val           Pointer to receive the chunk pointer, which points into
+ *                      payload.  This is NULL for begin and end frames.
+ * \param size          Pointer to receive the chunk size.  This is 0 for begin
+ *                      and end frames.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if the frame was out of
+ *        order or the wrong size.
+ */
+int ipc_stream_reader_accept(
+    ipc_stream_reader_t* reader, const void* payload, uint32_t payload_size,
+    int* frame, const void** val, uint32_t* size);
+
+/**
+ * \brief Borrow the next frame of a streamed authenticated message from a
+ * non-blocking socket.
+ *
+ * The frame type is returned in frame.  For a begin frame, the total size of
+ * the stream is available in reader->total_size.  For a chunk frame, val and
+ * size describe the chunk, which is borrowed as per
+ * \ref ipc_borrow_authed_data_noblock().  For begin and end frames, val is
+ * set to NULL and size to 0.  In every case, \ref ipc_release_data_noblock()
+ * must be called before the next read on this socket.
+ *
+ * Frames that arrive out of order, chunks that overrun the total size, and an
+ * end frame before the full payload has arrived are rejected.
+ *
+ * \param sock          The socket context from which the frame is read.
+ * \param iv            The 64-bit IV to expect for this frame.
+ * \param reader        The stream state for this socket.
+ * \param frame         Pointer to receive the frame type.
+ * \param val           Pointer to receive the chunk pointer.
+ * \param size          Pointer to receive the chunk size.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if the frame was out of
+ *        order or the wrong size.
+ *      - any of the errors returned by
+ *        \ref ipc_borrow_authed_data_noblock().
+ */
+int ipc_borrow_authed_stream_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, ipc_stream_reader_t* reader,
+    int* frame, void** val, uint32_t* size, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* secret);
+
+/**
+ * \brief Release a data packet borrowed from a non-blocking socket.
+ *
+ * The packet is drained from the socket's read buffer, and any decrypted
+ * payload is cleared.  It is safe to call this method when no packet is
+ * borrowed.
+ *
+ * \param sock          The socket context from which the packet was borrowed.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BUFFER_DRAIN_FAILURE if draining the read buffer
+ *        failed.
+ */
+int ipc_release_data_noblock(ipc_socket_context_t* sock);
+
 /**
  * \brief Read a character string from a non-blocking socket.
  *
@@ -970,6 +1588,9 @@ int ipc_read_string_noblock(ipc_socket_context_t* sock, char** val);
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
  *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read was
  *        unexpected.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the data size read was
@@ -993,6 +1614,9 @@ int ipc_read_uint64_noblock(ipc_socket_context_t* sock, uint64_t* val);
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
  *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read was
  *        unexpected.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the data size read was
@@ -1016,6 +1640,9 @@ int ipc_read_int64_noblock(ipc_socket_context_t* sock, int64_t* val);
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
  *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read was
  *        unexpected.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the data size read was
@@ -1039,6 +1666,9 @@ int ipc_read_uint8_noblock(ipc_socket_context_t* sock, uint8_t* val);
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
  *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read was
  *        unexpected.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the data size read was
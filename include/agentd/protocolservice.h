@@ -11,6 +11,7 @@
 
 #include <agentd/bootstrap_config.h>
 #include <agentd/config.h>
+#include <agentd/ipc.h>
 #include <agentd/protocolservice/api.h>
 #include <vpr/disposable.h>
 
@@ -53,6 +54,10 @@ enum protocolservice_api_method_enum
  *                      listens for connections on this socket.
  * \param datasock      The data service socket.  The protocol service
  *                      communicates with the dataservice using this socket.
+ * \param ring          Optional shared-memory ring to the data service, or
+ *                      NULL.  When set, dataservice requests travel over this
+ *                      ring, and the data service socket is only watched for
+ *                      hangup.
  * \param logsock       The logging service socket.  The protocol service logs
  *                      on this socket.
  *
@@ -68,7 +73,8 @@ enum protocolservice_api_method_enum
  *            the protocol service event loop failed.
  */
 int unauthorized_protocol_service_event_loop(
-    int randomsock, int protosock, int datasock, int logsock);
+    int randomsock, int protosock, int datasock,
+    const ipc_ring_descriptors_t* ring, int logsock);
 
 /**
  * \brief Spawn an unauthorized protocol service process using the provided
@@ -86,6 +92,8 @@ int unauthorized_protocol_service_event_loop(
  * \param logsock       Socket used to communicate with the logger.
  * \param acceptsock    Socket used to receive accepted peers.
  * \param datasock      Socket used to communicate with the data service.
+ * \param ring          Optional shared-memory ring to the data service, or
+ *                      NULL.  The caller keeps ownership of these descriptors.
  * \param protopid      Pointer to the protocol service pid, to be updated on
  *                      the successful completion of this function.
  * \param runsecure     Set to false if we are not being run in secure mode.
@@ -115,7 +123,8 @@ int unauthorized_protocol_service_event_loop(
  */
 int unauthorized_protocol_proc(
     const bootstrap_config_t* bconf, const agent_config_t* conf, int randomsock,
-    int logsock, int acceptsock, int datasock, pid_t* protopid, bool runsecure);
+    int logsock, int acceptsock, int datasock,
+    const ipc_ring_descriptors_t* ring, pid_t* protopid, bool runsecure);
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
@@ -40,11 +40,91 @@ typedef enum unauthorized_protocol_request_id
     UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_FIRST_TXN_BY_ID_GET = 0x00000020,
     UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_LAST_TXN_BY_ID_GET = 0x00000021,
 
+    UNAUTH_PROTOCOL_REQ_ID_BLOCK_NOTIFY_SUBSCRIBE = 0x00000030,
+    UNAUTH_PROTOCOL_REQ_ID_BLOCK_NOTIFICATION = 0x00000031,
+    UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_WATCH = 0x00000032,
+    UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_NOTIFICATION = 0x00000033,
+
     UNAUTH_PROTOCOL_REQ_ID_STATUS_GET = 0x0000A000,
 
+    UNAUTH_PROTOCOL_REQ_ID_BATCH = 0x0000B000,
+
+    UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME = 0x0000C000,
+    UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET = 0x0000C001,
+
     UNAUTH_PROTOCOL_REQ_ID_CLOSE = 0x0000FFFF,
 } unauthorized_protocol_request_id_t;
 
+/**
+ * \brief A sub-request to send as part of a batch request.
+ */
+typedef struct protocolservice_api_batch_request
+{
+    uint32_t request_id;
+    uint32_t offset;
+    const void* body;
+    size_t body_size;
+} protocolservice_api_batch_request_t;
+
+/**
+ * \brief Counters reported by the protocol service in a status response.
+ *
+ * The schedule queue depth and in-flight count are the number of client
+ * requests waiting to be dispatched and waiting on the data service when the
+ * status request was answered.  The wait times are measured from when a
+ * request is read to when it is dispatched, over every request dispatched so
+ * far.
+ */
+typedef struct protocolservice_api_status
+{
+    uint64_t response_cache_hits;
+    uint64_t response_cache_misses;
+    uint64_t schedule_queue_depth;
+    uint64_t dataservice_inflight;
+    uint64_t schedule_dispatched;
+    uint64_t schedule_wait_total_usec;
+    uint64_t schedule_wait_max_usec;
+} protocolservice_api_status_t;
+
+/**
+ * \brief The size of the ticket id that starts a session resumption ticket.
+ * The session key for a ticket is derived from its id.
+ */
+#define PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE 16
+
+/**
+ * \brief The size of a session resumption ticket.
+ *
+ * A ticket is opaque to the client.  After the ticket id, it holds the expiry
+ * time, the sealed session key, and a MAC over the ticket, so that any
+ * protocol service worker can redeem it.
+ */
+#define PROTOCOLSERVICE_SESSION_TICKET_SIZE 88
+
+/**
+ * \brief Derive a key from a parent key and some context data.
+ *
+ * The derived key is the short MAC of the data, keyed with the parent key,
+ * truncated to the size of the derived key buffer.  Both the client and the
+ * server use this to turn a session key from a resumption ticket into a fresh
+ * shared secret.
+ *
+ * \param suite             The crypto suite to use for this derivation.
+ * \param key               The parent key.
+ * \param data              The context data for this derivation.
+ * \param size              The size of the context data.
+ * \param derived           The initialized buffer to receive the derived key.
+ *                          It can be no larger than the short MAC size.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the key could
+ *        not be derived.
+ */
+int protocolservice_session_key_derive(
+    vccrypt_suite_options_t* suite, const vccrypt_buffer_t* key,
+    const void* data, size_t size, vccrypt_buffer_t* derived);
+
 /**
  * \brief Send a handshake request to the API.
  *
@@ -196,6 +276,142 @@ int protocolservice_api_recvresp_handshake_ack_block(
     int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
     const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status);
 
+/**
+ * \brief Send a session ticket get request.
+ *
+ * \param sock                      The socket to which this request is written.
+ * \param suite                     The crypto suite to use for this request.
+ * \param client_iv                 Pointer to the client IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this request.
+ *
+ * This function asks the server for a resumption ticket for the current
+ * session.  The ticket can be redeemed once by
+ * \ref protocolservice_api_sendreq_handshake_resume_block() to open a new
+ * connection without a full handshake.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_session_ticket_get(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* client_iv,
+    const vccrypt_buffer_t* shared_secret);
+
+/**
+ * \brief Receive a session ticket get response.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to receive the updated server IV.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset for this response.
+ * \param status                    The status for this response.
+ * \param ticket                    Array to receive the
+ *                                  PROTOCOLSERVICE_SESSION_TICKET_SIZE byte
+ *                                  ticket.
+ * \param session_key               Buffer to receive the session key for this
+ *                                  ticket, which is derived from the shared
+ *                                  secret and the ticket id.  This buffer
+ *                                  must not have been previously
+ *                                  initialized.  On success, this is owned by
+ *                                  the caller and must be disposed.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  A zero
+ * status indicates the request to the remote peer was successful, and a
+ * non-zero status indicates that the request to the remote peer failed.  The
+ * ticket and session key are only set when the status is zero.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_session_ticket_get(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    uint8_t* ticket, vccrypt_buffer_t* session_key);
+
+/**
+ * \brief Send a handshake resume request to the API.
+ *
+ * \param sock              The socket to which this request is written.
+ * \param suite             The crypto suite to use for this request.
+ * \param entity_id         The entity UUID originating this request.
+ * \param ticket            The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte
+ *                          ticket to redeem.
+ * \param session_key       The session key that goes with this ticket.
+ * \param key_nonce         Buffer to receive the client key nonce for this
+ *                          request.  This buffer must not have been previously
+ *                          initialized.  On success, this is owned by the
+ *                          caller and must be disposed.
+ * \param shared_secret     Buffer to receive the shared secret for the
+ *                          resumed session.  This buffer must not have been
+ *                          previously initialized.  On success, this is owned
+ *                          by the caller and must be disposed.
+ *
+ * The shared secret is derived from the session key and a fresh key nonce, and
+ * the request is signed with it so that the server can verify that the client
+ * holds the session key.  Once the response is received with
+ * \ref protocolservice_api_recvresp_handshake_resume_block(), the client IV
+ * starts at 0x0000000000000001 and the server IV at 0x8000000000000001.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_handshake_resume_block(
+    int sock, vccrypt_suite_options_t* suite, const uint8_t* entity_id,
+    const uint8_t* ticket, const vccrypt_buffer_t* session_key,
+    vccrypt_buffer_t* key_nonce, vccrypt_buffer_t* shared_secret);
+
+/**
+ * \brief Receive a handshake resume response from the API.
+ *
+ * \param sock              The socket from which this response is read.
+ * \param suite             The crypto suite to use to verify this response.
+ * \param key_nonce         The client key nonce sent with the request.
+ * \param shared_secret     The shared secret for the resumed session.
+ * \param offset            The offset for this response.
+ * \param status            The status for this response.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  If the
+ * ticket was not accepted, the client should fall back to a full handshake on a
+ * new connection.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed or could not be verified.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_handshake_resume_block(
+    int sock, vccrypt_suite_options_t* suite,
+    const vccrypt_buffer_t* key_nonce, const vccrypt_buffer_t* shared_secret,
+    uint32_t* offset, uint32_t* status);
+
 /**
  * \brief Send a Latest Block ID get request.
  *
@@ -265,6 +481,202 @@ int protocolservice_api_recvresp_latest_block_id_get_block(
     const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
     vccrypt_buffer_t* block_id);
 
+/**
+ * \brief Send a block notification subscribe request.
+ *
+ * \param sock                      The socket to which this request is written.
+ * \param suite                     The crypto suite to use for this request.
+ * \param client_iv                 Pointer to the client IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this request.
+ *
+ * Once subscribed, the server pushes a block notification to this connection
+ * each time a block is committed, which can be read with
+ * \ref protocolservice_api_recvresp_block_notification().  Notifications are
+ * interleaved with the responses to any other requests, so a client that
+ * subscribes must be ready to read either.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_block_notify_subscribe(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* client_iv,
+    const vccrypt_buffer_t* shared_secret);
+
+/**
+ * \brief Receive a block notification subscribe response.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset for this response.
+ * \param status                    The status for this response.
+ * \param block_id                  Array to receive the 16 byte UUID of the
+ *                                  latest block at the time of subscription.
+ * \param height                    Pointer to receive the height of this
+ *                                  block.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  A zero
+ * status indicates the request to the remote peer was successful, and a
+ * non-zero status indicates that the request to the remote peer failed.  The
+ * block id and height are only set when the status is zero.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed.
+ */
+int protocolservice_api_recvresp_block_notify_subscribe(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    uint8_t* block_id, uint64_t* height);
+
+/**
+ * \brief Receive a block notification.
+ *
+ * \param sock                      The socket from which this notification is
+ *                                  read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  notification.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this
+ *                                  notification.
+ * \param offset                    The offset of the subscribe request.
+ * \param block_id                  Array to receive the 16 byte UUID of the
+ *                                  newly committed block.
+ * \param height                    Pointer to receive the height of this
+ *                                  block.
+ *
+ * If several blocks are committed in quick succession, a single notification
+ * may be sent for the latest of them.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the notification
+ *        was malformed.
+ */
+int protocolservice_api_recvresp_block_notification(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset,
+    uint8_t* block_id, uint64_t* height);
+
+/**
+ * \brief Send an artifact watch request.
+ *
+ * \param sock                      The socket to which this request is written.
+ * \param suite                     The crypto suite to use for this request.
+ * \param client_iv                 Pointer to the client IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this request.
+ * \param artifact_ids              The 16 byte UUIDs of the artifacts to
+ *                                  watch, laid end to end.
+ * \param artifact_count            The number of artifact ids to watch.
+ *
+ * Once watched, the server pushes an artifact notification to this connection
+ * each time a committed transaction updates one of these artifacts, which can
+ * be read with \ref protocolservice_api_recvresp_artifact_notification().  A
+ * connection may send several watch requests; the watched sets are combined.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_artifact_watch(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* client_iv,
+    const vccrypt_buffer_t* shared_secret, const uint8_t* artifact_ids,
+    size_t artifact_count);
+
+/**
+ * \brief Receive an artifact watch response.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset for this response.
+ * \param status                    The status for this response.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  A zero
+ * status indicates the request to the remote peer was successful, and a
+ * non-zero status indicates that the request to the remote peer failed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed.
+ */
+int protocolservice_api_recvresp_artifact_watch(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status);
+
+/**
+ * \brief Receive an artifact notification.
+ *
+ * \param sock                      The socket from which this notification is
+ *                                  read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  notification.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this
+ *                                  notification.
+ * \param offset                    The offset of the first watch request.
+ * \param artifact_id               Array to receive the 16 byte UUID of the
+ *                                  updated artifact.
+ * \param txn_latest                Array to receive the 16 byte UUID of the
+ *                                  latest transaction for this artifact.
+ * \param height_latest             Pointer to receive the block height of the
+ *                                  latest transaction.
+ * \param state_latest              Pointer to receive the latest state of the
+ *                                  artifact.
+ *
+ * If an artifact is updated by several transactions in quick succession, a
+ * single notification may be sent for the latest of them.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the notification
+ *        was malformed.
+ */
+int protocolservice_api_recvresp_artifact_notification(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset,
+    uint8_t* artifact_id, uint8_t* txn_latest, uint64_t* height_latest,
+    uint32_t* state_latest);
+
 /**
  * \brief Send a block id by height get request.
  *
@@ -509,8 +921,13 @@ int protocolservice_api_sendreq_block_get(
  * returned by this function.  Thus, both the return value of this function and
  * the upstream status code must be checked for correct operation.
  *
+ * A block too large for a single packet arrives as a stream, which is gathered
+ * here, so the caller sees the same result either way.
+ *
  * Possible upstream status codes:
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the block could not be found.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_RESPONSE_TOO_LARGE_FOR_BATCH if the
+ *        block was requested in a batch and is too large to be streamed.
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
@@ -518,6 +935,8 @@ int protocolservice_api_sendreq_block_get(
  *        failed.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
  *        the socket was unexpected.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if a streamed response
+ *        was malformed.
  *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
  *        out-of-memory error.
  */
@@ -1101,6 +1520,9 @@ int protocolservice_api_sendreq_status_get(
  * \param shared_secret             The shared secret key for this response.
  * \param offset                    The offset for this response.
  * \param status                    The status for this response.
+ * \param stats                     If not NULL, this is populated with the
+ *                                  service counters from a successful
+ *                                  response.
  *
  * On a successful return from this function, the status is updated with the
  * status code from the API request.  This status should be checked.  A zero
@@ -1118,12 +1540,90 @@ int protocolservice_api_sendreq_status_get(
  *        failed.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
  *        the socket was unexpected.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the response is too
+ *        small to hold the requested counters.
  *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
  *        out-of-memory error.
  */
 int protocolservice_api_recvresp_status_get(
     int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
-    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status);
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    protocolservice_api_status_t* stats);
+
+/**
+ * \brief Send a batch request.
+ *
+ * \param sock                      The socket to which this request is written.
+ * \param suite                     The crypto suite to use for this handshake.
+ * \param client_iv                 Pointer to the client IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this request.
+ * \param offset                    The offset for this batch request.
+ * \param requests                  The sub-requests to send in this batch.
+ * \param count                     The number of sub-requests.
+ *
+ * This function sends every sub-request to the server in a single packet.  The
+ * server answers with a single batch response, which is read with \ref
+ * protocolservice_api_recvresp_batch().
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_batch(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* client_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t offset,
+    const protocolservice_api_batch_request_t* requests, size_t count);
+
+/**
+ * \brief Receive a batch response.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset for this response.
+ * \param status                    The status for this response.
+ * \param responses                 Pointer to be populated with the
+ *                                  sub-responses on success.  This buffer is
+ *                                  dynamically allocated and must be freed by
+ *                                  the caller.
+ * \param responses_size            The size of the sub-responses returned.
+ *
+ * The sub-responses are returned as a sequence of packets, each prefixed by
+ * its size as a 32-bit network order value.  Each packet is laid out just as
+ * the response to the same request sent on its own would be, starting with its
+ * request ID, status, and offset.  Sub-responses may be in a different order
+ * than the sub-requests.
+ *
+ * If the status code is updated with an error from the service, then this error
+ * will be reflected in the status variable, and a AGENTD_STATUS_SUCCESS will be
+ * returned by this function.  Thus, both the return value of this function and
+ * the upstream status code must be checked for correct operation.
+ *
+ * Possible upstream status codes:
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_BATCH if the batch was
+ *        malformed, too large, or nested.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_batch(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    uint8_t** responses, size_t* responses_size);
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
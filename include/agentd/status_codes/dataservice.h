@@ -406,6 +406,62 @@ extern "C" {
 #define AGENTD_ERROR_DATASERVICE_PRIVSEP_CLOSE_OTHER_FDS \
     AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x0044U)
 
+/**
+ * \brief Builder options could not be initialized.
+ */
+#define AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_OPTIONS_INIT_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x0045U)
+
+/**
+ * \brief Builder could not be initialized.
+ */
+#define AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_INIT_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x0046U)
+
+/**
+ * \brief Builder failed to add a field or emit a certificate.
+ */
+#define AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x0047U)
+
+/**
+ * \brief A hash could not be computed.
+ */
+#define AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x0048U)
+
+/**
+ * \brief A child context tried to watch too many artifacts.
+ */
+#define AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x0049U)
+
+/**
+ * \brief A transaction in a block appears before its predecessor in that
+ * block.
+ */
+#define AGENTD_ERROR_DATASERVICE_BLOCK_TRANSACTION_OUT_OF_ORDER \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x004AU)
+
+/**
+ * \brief The block notification interval is malformed or out of range.
+ */
+#define AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x004BU)
+
+/**
+ * \brief The artifact watch check could not read every new block, and should
+ * be tried again.
+ */
+#define AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x004CU)
+
+/**
+ * \brief The write buffer watermarks are malformed or out of range.
+ */
+#define AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_DATASERVICE, 0x004DU)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
@@ -184,6 +184,30 @@ extern "C" {
 #define AGENTD_ERROR_IPC_ACCEPT_SHOULD_RETRY \
     AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_IPC, 0x001CU)
 
+/**
+ * \brief Creating the shared memory or doorbells for a ring failed.
+ */
+#define AGENTD_ERROR_IPC_RING_CREATE_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_IPC, 0x001DU)
+
+/**
+ * \brief Mapping the shared memory for a ring failed.
+ */
+#define AGENTD_ERROR_IPC_RING_MAP_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_IPC, 0x001EU)
+
+/**
+ * \brief The shared memory for a ring is not a valid ring.
+ */
+#define AGENTD_ERROR_IPC_RING_INVALID \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_IPC, 0x001FU)
+
+/**
+ * \brief A stream frame arrived out of order or with an unexpected size.
+ */
+#define AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_IPC, 0x0020U)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
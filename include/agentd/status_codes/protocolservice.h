@@ -130,6 +130,48 @@ extern "C" {
 #define AGENTD_ERROR_PROTOCOLSERVICE_PRIVSEP_CLOSE_OTHER_FDS \
     AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0013U)
 
+/**
+ * \brief A batch request was malformed, too large, or nested.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_BATCH \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0014U)
+
+/**
+ * \brief A session ticket was unknown, expired, or already redeemed.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0015U)
+
+/**
+ * \brief A session key could not be derived.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0016U)
+
+/**
+ * \brief The authorized entity table could not be loaded.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0017U)
+
+/**
+ * \brief A newly derived session ticket is already held by the service.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_DUPLICATE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0018U)
+
+/**
+ * \brief A response is too large to be carried in a batch response.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_RESPONSE_TOO_LARGE_FOR_BATCH \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x0019U)
+
+/**
+ * \brief A setting read from the environment is malformed or out of range.
+ */
+#define AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_PROTOCOL, 0x001AU)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
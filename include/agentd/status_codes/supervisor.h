@@ -22,6 +22,12 @@ extern "C" {
 #define AGENTD_ERROR_SUPERVISOR_SIGNAL_INSTALLATION \
     AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_SUPERVISOR, 0x0001U)
 
+/**
+ * \brief The supervisor failed to duplicate a socket descriptor.
+ */
+#define AGENTD_ERROR_SUPERVISOR_DUP_FAILURE \
+    AGENTD_STATUS_ERROR_MACRO(AGENTD_SERVICE_SUPERVISOR, 0x0002U)
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
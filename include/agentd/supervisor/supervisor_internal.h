@@ -15,8 +15,36 @@ extern "C" {
 #endif /*__cplusplus*/
 
 #include <agentd/config.h>
+#include <agentd/ipc.h>
 #include <agentd/process.h>
 
+/**
+ * \brief A protocol service worker, along with the random service and data
+ * service that are dedicated to it.
+ *
+ * The process descriptors refer to the sockets held in this structure, so a
+ * worker must not be moved once it has been created.
+ */
+typedef struct supervisor_protocol_worker
+{
+    disposable_t hdr;
+    process_t* random_service;
+    process_t* data_service;
+    process_t* protocol_service;
+    int random_svc_log_sock;
+    int random_svc_log_dummy_sock;
+    int data_svc_log_sock;
+    int data_svc_log_dummy_sock;
+    int protocol_svc_log_sock;
+    int protocol_svc_log_dummy_sock;
+    int protocol_svc_random_sock;
+    int protocol_svc_accept_sock;
+    int protocol_svc_data_sock;
+    ipc_ring_descriptors_t protocol_svc_data_ring;
+    int data_svc_block_subscribe_sock;
+    int block_publish_sock;
+} supervisor_protocol_worker_t;
+
 /**
  * \brief Create the random service as a process that can be started.
  *
@@ -73,6 +101,14 @@ int supervisor_create_listener_service(
  *                              socket.
  * \param log_socket            Pointer to the descriptor holding the log socket
  *                              for this instance.
+ * \param ring                  Pointer to the ring descriptors to receive a
+ *                              shared-memory ring to the data service, if
+ *                              the configuration enables one.  Otherwise,
+ *                              these are set to -1.  The caller owns these
+ *                              descriptors.
+ * \param block_subscribe_socket    Pointer to the descriptor on which the
+ *                                  data service is signaled of committed
+ *                                  blocks.  The caller owns this descriptor.
  *
  * \returns a status indicating success or failure.
  *          - AGENTD_STATUS_SUCCESS on success.
@@ -80,7 +116,8 @@ int supervisor_create_listener_service(
  */
 int supervisor_create_data_service_for_auth_protocol_service(
     process_t** svc, const bootstrap_config_t* bconf,
-    const agent_config_t* conf, int* data_socket, int* log_socket);
+    const agent_config_t* conf, int* data_socket, int* log_socket,
+    ipc_ring_descriptors_t* ring, int* block_subscribe_socket);
 
 /**
  * \brief Create a data service instance for the canonization service as a
@@ -96,6 +133,17 @@ int supervisor_create_data_service_for_auth_protocol_service(
  *                              socket.
  * \param log_socket            Pointer to the descriptor holding the log socket
  *                              for this instance.
+ * \param ring                  Pointer to the ring descriptors to receive a
+ *                              shared-memory ring to the data service, if
+ *                              the configuration enables one.  Otherwise,
+ *                              these are set to -1.  The caller owns these
+ *                              descriptors.
+ * \param block_publish_sockets     Array of descriptors on which the data
+ *                                  service signals each block that it
+ *                                  commits.  This array must be valid for the
+ *                                  lifetime of the service, and the caller
+ *                                  owns these descriptors.
+ * \param block_publish_count       The number of block publish descriptors.
  *
  * \returns a status indicating success or failure.
  *          - AGENTD_STATUS_SUCCESS on success.
@@ -103,7 +151,9 @@ int supervisor_create_data_service_for_auth_protocol_service(
  */
 int supervisor_create_data_service_for_canonizationservice(
     process_t** svc, const bootstrap_config_t* bconf,
-    const agent_config_t* conf, int* data_socket, int* log_socket);
+    const agent_config_t* conf, int* data_socket, int* log_socket,
+    ipc_ring_descriptors_t* ring, int* block_publish_sockets,
+    size_t block_publish_count);
 
 /**
  * \brief Create the protocol service as a process that can be started.
@@ -117,6 +167,10 @@ int supervisor_create_data_service_for_canonizationservice(
  * \param random_socket         The random socket descriptor.
  * \param accept_socket         The accept socket descriptor.
  * \param data_socket           The data socket descriptor.
+ * \param data_ring             The shared-memory ring to the data service.  If
+ *                              its descriptors are valid, the service uses
+ *                              this ring for dataservice requests.  They are
+ *                              closed once the service has been started.
  * \param log_socket            The log socket descriptor.
  *
  * \returns a status indicating success or failure.
@@ -126,7 +180,34 @@ int supervisor_create_data_service_for_canonizationservice(
 int supervisor_create_protocol_service(
     process_t** svc, const bootstrap_config_t* bconf,
     const agent_config_t* conf, int* random_socket, int* accept_socket,
-    int* data_socket, int* log_socket);
+    int* data_socket, ipc_ring_descriptors_t* data_ring, int* log_socket);
+
+/**
+ * \brief Create a protocol service worker, along with its random service and
+ * data service, as processes that can be started.
+ *
+ * The worker gets its own copy of the accept socket, so that every worker
+ * reads accepted sockets from the same queue.  On success, the worker is
+ * owned by the caller and must be disposed by calling \ref dispose() when no
+ * longer needed.
+ *
+ * \param worker                The worker to create.
+ * \param bconf                 Agentd bootstrap config for this worker.
+ * \param conf                  Agentd configuration to be used to build the
+ *                              worker.  This configuration must be valid for
+ *                              the lifetime of the worker.
+ * \param accept_socket         The protocol side of the accept socket, which
+ *                              is duplicated for this worker.
+ *
+ * \returns a status indicating success or failure.
+ *          - AGENTD_STATUS_SUCCESS on success.
+ *          - AGENTD_ERROR_SUPERVISOR_DUP_FAILURE if the accept socket could not
+ *            be duplicated.
+ *          - a non-zero error code on failure.
+ */
+int supervisor_create_protocol_worker(
+    supervisor_protocol_worker_t* worker, const bootstrap_config_t* bconf,
+    const agent_config_t* conf, int accept_socket);
 
 /**
  * \brief Create the auth service as a process that can be started.
@@ -158,6 +239,10 @@ int supervisor_create_auth_service(
  *                              canonization service.  This configuration must
  *                              be valid for the lifetime of the service.
  * \param data_socket           The data socket descriptor.
+ * \param data_ring             The shared-memory ring to the data service.  If
+ *                              its descriptors are valid, the service uses
+ *                              this ring for dataservice requests.  They are
+ *                              closed once the service has been started.
  * \param random_socket         The random socket descriptor.
  * \param log_socket            The log socket descriptor.
  * \param control_socket        The control socket descriptor.
@@ -168,8 +253,9 @@ int supervisor_create_auth_service(
  */
 int supervisor_create_canonizationservice(
     process_t** svc, const bootstrap_config_t* bconf,
-    const agent_config_t* conf, int* data_socket, int* random_socket,
-    int* log_socket, int* control_socket);
+    const agent_config_t* conf, int* data_socket,
+    ipc_ring_descriptors_t* data_ring, int* random_socket, int* log_socket,
+    int* control_socket);
 
 /**
  * \brief Install the signal handler for the supervisor.
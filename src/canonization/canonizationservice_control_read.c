@@ -40,7 +40,7 @@ void canonizationservice_control_read(
         return;
 
     /* attempt to read a request. */
-    retval = ipc_read_data_noblock(ctx, &req, &size);
+    retval = ipc_borrow_data_noblock(ctx, &req, &size);
     switch (retval)
     {
         /* on success, decode and dispatch. */
@@ -53,9 +53,12 @@ void canonizationservice_control_read(
                 canonizationservice_exit_event_loop(instance);
             }
 
-            /* clear and free the request data. */
-            memset(req, 0, size);
-            free(req);
+            /* release the request data. */
+            retval = ipc_release_data_noblock(ctx);
+            if (AGENTD_STATUS_SUCCESS != retval)
+            {
+                canonizationservice_exit_event_loop(instance);
+            }
             break;
 
         /* wait for more data on the socket. */
@@ -0,0 +1,42 @@
+/**
+ * \file canonization/canonizationservice_data_hangup.c
+ *
+ * \brief Watch the data service socket for hangup while using a ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "canonizationservice_internal.h"
+
+/**
+ * \brief Handle read events on the data socket while dataservice traffic runs
+ * over a ring.
+ *
+ * Once bootstrapped, the data service never writes to its socket when a ring
+ * carries its traffic, so any read event on the socket means that the data
+ * service has gone away.  In this case, the canonization service shuts down.
+ *
+ * \param ctx               The non-blocking socket context.
+ * \param event_flags       The event that triggered this callback.
+ * \param user_context      The user context for this data socket.
+ */
+void canonizationservice_data_hangup(
+    ipc_socket_context_t* UNUSED(ctx), int UNUSED(event_flags),
+    void* user_context)
+{
+    /* get the instance from the user context. */
+    canonizationservice_instance_t* instance =
+        (canonizationservice_instance_t*)user_context;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != instance);
+
+    /* don't go further if we are already shutting down. */
+    if (instance->force_exit)
+        return;
+
+    canonizationservice_exit_event_loop(instance);
+}
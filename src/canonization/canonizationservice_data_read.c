@@ -80,18 +80,6 @@ void canonizationservice_data_read(
                 instance, resp, resp_size);
             break;
 
-        /* handle transaction pq read first. */
-        case DATASERVICE_API_METHOD_APP_PQ_TRANSACTION_FIRST_READ:
-            canonizationservice_dataservice_response_transaction_first_read(
-                instance, resp, resp_size);
-            break;
-
-        /* handle transaction pq read. */
-        case DATASERVICE_API_METHOD_APP_PQ_TRANSACTION_READ:
-            canonizationservice_dataservice_response_transaction_read(
-                instance, resp, resp_size);
-            break;
-
         /* handle latest block id read. */
         case DATASERVICE_API_METHOD_APP_BLOCK_ID_LATEST_READ:
             canonizationservice_dataservice_response_latest_block_id_read(
@@ -104,9 +92,9 @@ void canonizationservice_data_read(
                 instance, resp, resp_size);
             break;
 
-        /* handle block make. */
-        case DATASERVICE_API_METHOD_APP_BLOCK_WRITE:
-            canonizationservice_dataservice_response_block_write(
+        /* handle block make from queue. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE:
+            canonizationservice_dataservice_response_block_make_from_queue(
                 instance, resp, resp_size);
             break;
 
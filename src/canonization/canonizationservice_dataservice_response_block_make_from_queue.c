@@ -0,0 +1,55 @@
+/**
+ * \file canonization/canonizationservice_dataservice_response_block_make_from_queue.c
+ *
+ * \brief Handle the response from the data service block make from queue call.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/api.h>
+#include <agentd/dataservice/async_api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "canonizationservice_internal.h"
+
+/**
+ * \brief Handle the response from the data service block make from queue.
+ *
+ * \param instance      The canonization service instance.
+ * \param resp          The response from the data service.
+ * \param resp_size     The size of the response from the data service.
+ */
+void canonizationservice_dataservice_response_block_make_from_queue(
+    canonizationservice_instance_t* instance, const uint32_t* resp,
+    const size_t resp_size)
+{
+    int retval;
+    dataservice_response_block_make_from_queue_t dresp;
+
+    /* decode the response. */
+    retval =
+        dataservice_decode_response_block_make_from_queue(
+            resp, resp_size, &dresp);
+    if (AGENTD_STATUS_SUCCESS != retval || (AGENTD_STATUS_SUCCESS != dresp.hdr.status && AGENTD_ERROR_DATASERVICE_NOT_FOUND != dresp.hdr.status))
+    {
+        canonizationservice_exit_event_loop(instance);
+        goto done;
+    }
+
+    /* if no attested transactions were found, then no block was made. */
+    if (AGENTD_ERROR_DATASERVICE_NOT_FOUND == dresp.hdr.status)
+    {
+        instance->block_transaction_count = 0;
+    }
+    else
+    {
+        instance->block_transaction_count = dresp.transaction_count;
+    }
+
+    /* close the child context. */
+    canonizationservice_child_context_close(instance);
+
+done:;
+}
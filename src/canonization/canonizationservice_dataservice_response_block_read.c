@@ -40,9 +40,9 @@ void canonizationservice_dataservice_response_block_read(
     /* get the block height. */
     instance->block_height = ntohll(dresp.node.net_block_height) + 1;
 
-    /* get the first transaction in the process queue. */
+    /* make a block from the attested transactions in the process queue. */
     retval =
-        canonizationservice_dataservice_sendreq_transaction_get_first(
+        canonizationservice_dataservice_sendreq_block_make_from_queue(
             instance);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
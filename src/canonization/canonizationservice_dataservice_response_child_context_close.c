@@ -30,7 +30,7 @@ void canonizationservice_dataservice_response_child_context_close(
 {
     /* only sleep if we did not max out transactions. */
     bool should_sleep =
-        instance->transaction_list->elements != instance->block_max_transactions;
+        instance->block_transaction_count != instance->block_max_transactions;
 
     /* reset the canonization service. */
     canonizationservice_reset(instance, should_sleep);
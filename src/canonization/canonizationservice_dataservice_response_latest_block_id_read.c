@@ -49,9 +49,10 @@ void canonizationservice_dataservice_response_latest_block_id_read(
         /* the height of the new block is 1. */
         instance->block_height = 1;
 
-        /* get the first transaction in the process queue. */
+        /* make a block from the attested transactions in the process
+         * queue. */
         retval =
-            canonizationservice_dataservice_sendreq_transaction_get_first(
+            canonizationservice_dataservice_sendreq_block_make_from_queue(
                 instance);
         if (AGENTD_STATUS_SUCCESS != retval)
         {
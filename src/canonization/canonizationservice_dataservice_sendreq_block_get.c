@@ -30,11 +30,12 @@ int canonizationservice_dataservice_sendreq_block_get(
      * latest block id. */
     instance->state = CANONIZATIONSERVICE_STATE_WAITRESP_BLOCK_GET;
 
-    /* send the request to read the previous block. */
+    /* send the request to read the previous block.  Only its height is
+     * needed, so its certificate isn't read. */
     retval =
         dataservice_api_sendreq_block_get(
             instance->data, instance->data_child_context,
-            instance->previous_block_id, true);
+            instance->previous_block_id, false);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         goto done;
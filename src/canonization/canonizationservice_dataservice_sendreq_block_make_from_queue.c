@@ -0,0 +1,56 @@
+/**
+ * \file canonization/canonizationservice_dataservice_sendreq_block_make_from_queue.c
+ *
+ * \brief Send the block make from queue request to the data service from the
+ * canonization service.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "canonizationservice_internal.h"
+
+/**
+ * \brief Send a request to make a block from the attested transactions in the
+ * process queue to the data service.
+ *
+ * \param instance      The canonization service instance.
+ */
+int canonizationservice_dataservice_sendreq_block_make_from_queue(
+    canonizationservice_instance_t* instance)
+{
+    int retval;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != instance);
+
+    /* evolve the state of the canonization service; we now wait for the data
+     * service to make the block. */
+    instance->state = CANONIZATIONSERVICE_STATE_WAITRESP_BLOCK_MAKE;
+
+    /* send the request to make a block from the transaction process queue.
+     * Blocks are streamed to clients a slice at a time, so the block size is
+     * bounded only by the transaction count. */
+    retval =
+        dataservice_api_sendreq_block_make_from_queue(
+            instance->data, instance->data_child_context, instance->block_id,
+            instance->block_height, instance->block_max_transactions, 0U);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* set the write callback for the dataservice socket. */
+    ipc_set_writecb_noblock(
+        instance->data, &canonizationservice_data_write,
+        instance->loop_context);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
@@ -36,10 +36,6 @@ int canonizationservice_dataservice_sendreq_child_context_create(
 
     /* set bitcaps based on the queries that the canonization service makes. */
     BITCAP_INIT_FALSE(dataservice_caps);
-    BITCAP_SET_TRUE(
-        dataservice_caps, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        dataservice_caps, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(
         dataservice_caps, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
     BITCAP_SET_TRUE(
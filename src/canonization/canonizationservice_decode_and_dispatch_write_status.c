@@ -34,8 +34,6 @@
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
- *        encountered in this operation.
  *      - AGENTD_ERROR_CANONIZATIONSERVICE_IPC_WRITE_DATA_FAILURE if data could
  *        not be written to the client socket.
  */
@@ -56,54 +54,23 @@ int canonizationservice_decode_and_dispatch_write_status(
     /* | data                                          | n - 12 bytes | */
     /* | --------------------------------------------- | ------------ | */
 
-    /* compute the size of the response. */
-    size_t respsize =
-        /* the size of the method. */
-        sizeof(uint32_t) +
-        /* the size of the offset. */
-        sizeof(uint32_t) +
-        /* the size of the status. */
-        sizeof(uint32_t);
+    /* encode the response header. */
+    uint32_t header[3] = { htonl(method), htonl(offset), htonl(status) };
 
-    /* add the data size to thsi buffer. */
-    if (NULL != data)
-    {
-        respsize += data_size;
-    }
-
-    /* allocate memory for the response. */
-    uint8_t* resp = (uint8_t*)malloc(respsize);
-    if (NULL == resp)
-    {
-        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-    }
-
-    /* set the values for the response. */
-    uint32_t net_method = htonl(method);
-    uint32_t net_offset = htonl(offset);
-    uint32_t net_status = htonl(status);
-
-    memcpy(resp + 0 * sizeof(uint32_t), &net_method, sizeof(net_method));
-    memcpy(resp + 1 * sizeof(uint32_t), &net_offset, sizeof(net_offset));
-    memcpy(resp + 2 * sizeof(uint32_t), &net_status, sizeof(net_status));
-
-    /* copy the data. */
-    if (NULL != data)
-    {
-        modelsafe_memcpy(resp + 3 * sizeof(uint32_t), data, data_size);
-    }
+    /* gather the header and the payload data. */
+    struct iovec iov[2];
+    iov[0].iov_base = header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = data;
+    iov[1].iov_len = (NULL != data) ? data_size : 0U;
 
     /* write the data packet. */
-    int retval = ipc_write_data_noblock(sock, resp, respsize);
+    int retval = ipc_write_datav_noblock(sock, iov, 2);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         retval = AGENTD_ERROR_CANONIZATIONSERVICE_IPC_WRITE_DATA_FAILURE;
     }
 
-    /* clean up memory. */
-    modelsafe_memset(resp, 0, respsize);
-    free(resp);
-
     /* return the status of the response write to the caller. */
     return retval;
 }
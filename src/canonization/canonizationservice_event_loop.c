@@ -15,6 +15,7 @@
 #include <cbmc/model_assert.h>
 #include <errno.h>
 #include <signal.h>
+#include <unistd.h>
 #include <vpr/parameters.h>
 
 #include "canonizationservice_internal.h"
@@ -25,6 +26,10 @@
  *
  * \param datasock      The data service socket.  The canonization service
  *                      communicates with the dataservice using this socket.
+ * \param ring          Optional shared-memory ring to the data service, or
+ *                      NULL.  When set, dataservice requests travel over this
+ *                      ring, and the data service socket is only watched for
+ *                      hangup.
  * \param randomsock    The random service socket.  The canonization service
  *                      communicates with the random service using this socket.
  * \param logsock       The logging service socket.  The canonization service
@@ -43,11 +48,13 @@
  *            running the protocol service event loop failed.
  */
 int canonizationservice_event_loop(
-    int datasock, int randomsock, int UNUSED(logsock), int controlsock)
+    int datasock, const ipc_ring_descriptors_t* ring, int randomsock,
+    int UNUSED(logsock), int controlsock)
 {
     int retval = AGENTD_STATUS_SUCCESS;
     canonizationservice_instance_t* instance = NULL;
     ipc_socket_context_t data;
+    ipc_socket_context_t ringsock;
     ipc_socket_context_t random;
     ipc_socket_context_t control;
     ipc_event_loop_context_t loop;
@@ -85,12 +92,35 @@ int canonizationservice_event_loop(
     /* save the data socket context for use by instance methods. */
     instance->data = &data;
 
+    /* with a ring, dataservice requests travel over the ring, and the socket
+     * only tells us when the data service has gone away. */
+    if (NULL != ring)
+    {
+        retval =
+            ipc_make_ring_noblock(
+                ring->memfd, IPC_RING_SIDE_LHS, ring->lhs, ring->rhs,
+                &ringsock, instance);
+
+        /* the socket context keeps its own handles to the ring. */
+        close(ring->memfd);
+        close(ring->rhs);
+
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            close(ring->lhs);
+            retval = AGENTD_ERROR_CANONIZATIONSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
+            goto cleanup_data_socket;
+        }
+
+        instance->data = &ringsock;
+    }
+
     /* set the random socket to non-blocking. */
     if (AGENTD_STATUS_SUCCESS !=
         ipc_make_noblock(randomsock, &random, instance))
     {
         retval = AGENTD_ERROR_CANONIZATIONSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
-        goto cleanup_data_socket;
+        goto cleanup_ring_socket;
     }
 
     /* save the random socket context for use by instance methods. */
@@ -108,7 +138,12 @@ int canonizationservice_event_loop(
 
     /* set the read callback on the sockets. */
     ipc_set_readcb_noblock(&control, &canonizationservice_control_read, NULL);
-    ipc_set_readcb_noblock(&data, &canonizationservice_data_read, NULL);
+    ipc_set_readcb_noblock(
+        instance->data, &canonizationservice_data_read, NULL);
+    if (NULL != ring)
+    {
+        ipc_set_readcb_noblock(&data, &canonizationservice_data_hangup, NULL);
+    }
     ipc_set_readcb_noblock(&random, &canonizationservice_random_read, NULL);
 
     /* on these signals, leave the event loop and shut down gracefully. */
@@ -130,6 +165,14 @@ int canonizationservice_event_loop(
         goto cleanup_loop;
     }
 
+    /* add the ring to the event loop. */
+    if (NULL != ring
+     && AGENTD_STATUS_SUCCESS != ipc_event_loop_add(&loop, &ringsock))
+    {
+        retval = AGENTD_ERROR_CANONIZATIONSERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
+        goto cleanup_loop;
+    }
+
     /* add the random socket to the event loop. */
     if (AGENTD_STATUS_SUCCESS != ipc_event_loop_add(&loop, &random))
     {
@@ -153,6 +196,12 @@ cleanup_loop:
 cleanup_random_socket:
     dispose((disposable_t*)&random);
 
+cleanup_ring_socket:
+    if (NULL != ring)
+    {
+        dispose((disposable_t*)&ringsock);
+    }
+
 cleanup_data_socket:
     dispose((disposable_t*)&data);
 
@@ -53,38 +53,9 @@ canonizationservice_instance_t* canonizationservice_instance_create()
         goto cleanup_allocator;
     }
 
-    /* initialize the certificate builder options for this instance. */
-    retval =
-        vccert_builder_options_init(
-            &instance->builder_opts, &instance->alloc_opts,
-            &instance->crypto_suite);
-    if (AGENTD_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_suite;
-    }
-
-    /* initialize linked list options for this instance. */
-    retval =
-        linked_list_options_init_ex(
-            &instance->transaction_list_opts, &instance->alloc_opts, NULL, 0,
-            &canonizationservice_transaction_list_element_dispose);
-    if (AGENTD_STATUS_SUCCESS != retval)
-    {
-        goto cleanup_builder_opts;
-    }
-
-    /* the transaction list only exists while it is being built. */
-    instance->transaction_list = NULL;
-
     /* success. */
     return instance;
 
-cleanup_builder_opts:
-    dispose((disposable_t*)&instance->builder_opts);
-
-cleanup_suite:
-    dispose((disposable_t*)&instance->crypto_suite);
-
 cleanup_allocator:
     dispose((disposable_t*)&instance->alloc_opts);
 
@@ -108,22 +79,6 @@ static void canonizationservice_instance_dispose(void* disposable)
     /* parameter sanity check. */
     MODEL_ASSERT(NULL != instance);
 
-    /* clean up the linked list instance, if allocated. */
-    if (NULL != instance->transaction_list)
-    {
-        dispose((disposable_t*)instance->transaction_list);
-        /* TODO - linked_list_t's dispose method should handle this. */
-        memset(instance->transaction_list, 0, sizeof(linked_list_t));
-        free(instance->transaction_list);
-        instance->transaction_list = NULL;
-    }
-
-    /* clean up the linked list options. */
-    dispose((disposable_t*)&instance->transaction_list_opts);
-
-    /* clean up the builder options. */
-    dispose((disposable_t*)&instance->builder_opts);
-
     /* clean up the crypto suite. */
     dispose((disposable_t*)&instance->crypto_suite);
 
@@ -11,21 +11,14 @@
 
 #include <agentd/dataservice/data.h>
 #include <agentd/ipc.h>
-#include <vccert/builder.h>
 #include <vccrypt/suite.h>
 #include <vpr/allocator.h>
-#include <vpr/linked_list.h>
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 extern "C" {
 #endif  //__cplusplus
 
-/* forward declaration for canonizationservice_transaction_t */
-struct canonizationservice_transaction;
-typedef struct canonizationservice_transaction
-    canonizationservice_transaction_t;
-
 /* forward declaration for canonizationservice_state_t */
 enum canonizationservice_state;
 typedef enum canonizationservice_state canonizationservice_state_t;
@@ -46,22 +39,12 @@ typedef struct canonizationservice_instance
     int state;
     allocator_options_t alloc_opts;
     vccrypt_suite_options_t crypto_suite;
-    vccert_builder_options_t builder_opts;
-    linked_list_options_t transaction_list_opts;
     uint8_t block_id[16];
     uint8_t previous_block_id[16];
     uint64_t block_height;
-    linked_list_t* transaction_list;
+    size_t block_transaction_count;
 } canonizationservice_instance_t;
 
-struct canonizationservice_transaction
-{
-    disposable_t hdr;
-    data_transaction_node_t node;
-    size_t cert_size;
-    uint8_t cert[];
-};
-
 enum canonizationservice_state
 {
     CANONIZATIONSERVICE_STATE_IDLE,
@@ -69,8 +52,6 @@ enum canonizationservice_state
     CANONIZATIONSERVICE_STATE_WAITRESP_CHILD_CONTEXT_CREATE,
     CANONIZATIONSERVICE_STATE_WAITRESP_LATEST_BLOCK_ID_GET,
     CANONIZATIONSERVICE_STATE_WAITRESP_BLOCK_GET,
-    CANONIZATIONSERVICE_STATE_WAITRESP_PQ_TXN_FIRST_GET,
-    CANONIZATIONSERVICE_STATE_WAITRESP_PQ_TXN_GET,
     CANONIZATIONSERVICE_STATE_WAITRESP_BLOCK_MAKE,
     CANONIZATIONSERVICE_STATE_WAITRESP_CHILD_CONTEXT_CLOSE
 };
@@ -83,24 +64,6 @@ enum canonizationservice_state
  */
 canonizationservice_instance_t* canonizationservice_instance_create();
 
-/**
- * \brief Dispose of a canonizationservice_transaction_t instance.
- *
- * \param ptr           Opaque pointer to the transaction instance to be
- *                      disposed.
- */
-void canonizationservice_transaction_dispose(void* ptr);
-
-/**
- * \brief List element disposer for the canonization service transaction linked
- * list.
- *
- * \param alloc_opts    Ignored by this disposer.
- * \param elem          The element to dispose.
- */
-void canonizationservice_transaction_list_element_dispose(
-    allocator_options_t* alloc_opts, void* elem);
-
 /**
  * \brief Timer callback for the canonization service.
  *
@@ -210,8 +173,6 @@ int canonizationservice_decode_and_dispatch_control_command_start(
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
- *        encountered in this operation.
  *      - AGENTD_ERROR_CANONIZATIONSERVICE_IPC_WRITE_DATA_FAILURE if data could
  *        not be written to the client socket
  */
@@ -261,6 +222,17 @@ void canonizationservice_control_write(
 void canonizationservice_data_read(
     ipc_socket_context_t* ctx, int event_flags, void* user_context);
 
+/**
+ * \brief Handle read events on the data socket while dataservice traffic runs
+ * over a ring.
+ *
+ * \param ctx               The non-blocking socket context.
+ * \param event_flags       The event that triggered this callback.
+ * \param user_context      The user context for this data socket.
+ */
+void canonizationservice_data_hangup(
+    ipc_socket_context_t* ctx, int event_flags, void* user_context);
+
 /**
  * \brief Callback for writing data to the data service socket from the
  * canonization service.
@@ -315,28 +287,6 @@ void canonizationservice_dataservice_response_child_context_close(
     canonizationservice_instance_t* instance, const uint32_t* resp,
     const size_t resp_size);
 
-/**
- * \brief Handle the response from the data service transaction first read.
- *
- * \param instance      The canonization service instance.
- * \param resp          The response from the data service.
- * \param resp_size     The size of the response from the data service.
- */
-void canonizationservice_dataservice_response_transaction_first_read(
-    canonizationservice_instance_t* instance, const uint32_t* resp,
-    const size_t resp_size);
-
-/**
- * \brief Handle the response from the data service transaction read.
- *
- * \param instance      The canonization service instance.
- * \param resp          The response from the data service.
- * \param resp_size     The size of the response from the data service.
- */
-void canonizationservice_dataservice_response_transaction_read(
-    canonizationservice_instance_t* instance, const uint32_t* resp,
-    const size_t resp_size);
-
 /**
  * \brief Handle the response from the data service latest block id read.
  *
@@ -360,13 +310,13 @@ void canonizationservice_dataservice_response_block_read(
     const size_t resp_size);
 
 /**
- * \brief Handle the response from the data service block write.
+ * \brief Handle the response from the data service block make from queue.
  *
  * \param instance      The canonization service instance.
  * \param resp          The response from the data service.
  * \param resp_size     The size of the response from the data service.
  */
-void canonizationservice_dataservice_response_block_write(
+void canonizationservice_dataservice_response_block_make_from_queue(
     canonizationservice_instance_t* instance, const uint32_t* resp,
     const size_t resp_size);
 
@@ -378,15 +328,6 @@ void canonizationservice_dataservice_response_block_write(
 int canonizationservice_dataservice_sendreq_child_context_create(
     canonizationservice_instance_t* instance);
 
-/**
- * \brief Send a transaction process queue get first request to the data
- * service.
- *
- * \param instance      The canonization service instance.
- */
-int canonizationservice_dataservice_sendreq_transaction_get_first(
-    canonizationservice_instance_t* instance);
-
 /**
  * \brief Send a request to get the latest block id from the data service.
  *
@@ -404,12 +345,12 @@ int canonizationservice_dataservice_sendreq_block_get(
     canonizationservice_instance_t* instance);
 
 /**
- * \brief Build a new block for the blockchain, using the currently attested
- * transactions.
+ * \brief Send a request to make a block from the attested transactions in the
+ * process queue to the data service.
  *
  * \param instance      The canonization service instance.
  */
-int canonizationservice_block_make(
+int canonizationservice_dataservice_sendreq_block_make_from_queue(
     canonizationservice_instance_t* instance);
 
 /**
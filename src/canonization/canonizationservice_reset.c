@@ -34,11 +34,8 @@ void canonizationservice_reset(
     /* clear the block id. */
     memset(instance->block_id, 0, sizeof(instance->block_id));
 
-    /* dispose the transaction list. */
-    dispose((disposable_t*)instance->transaction_list);
-    memset(instance->transaction_list, 0, sizeof(linked_list_t));
-    free(instance->transaction_list);
-    instance->transaction_list = NULL;
+    /* clear the transaction count. */
+    instance->block_transaction_count = 0;
 
     if (should_sleep)
     {
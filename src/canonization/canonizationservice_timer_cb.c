@@ -41,42 +41,10 @@ void canonizationservice_timer_cb(
     if (instance->force_exit)
         return;
 
-    /* allocate memory for the transaction list. */
-    MODEL_ASSERT(NULL == instance->transaction_list);
-    instance->transaction_list = (linked_list_t*)malloc(sizeof(linked_list_t));
-    if (NULL == instance->transaction_list)
-    {
-        canonizationservice_exit_event_loop(instance);
-        goto done;
-    }
-
-    /* initialize the transaction list. */
-    retval =
-        linked_list_init(
-            &instance->transaction_list_opts, instance->transaction_list);
-    if (AGENTD_STATUS_SUCCESS != retval)
-    {
-        canonizationservice_exit_event_loop(instance);
-        goto free_transaction_list;
-    }
-
     /* send a request to the random service. */
     retval = canonizationservice_write_block_id_request(instance);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         canonizationservice_exit_event_loop(instance);
-        goto dispose_transaction_list;
     }
-
-    /* success. */
-    goto done;
-
-dispose_transaction_list:
-    dispose((disposable_t*)instance->transaction_list);
-
-free_transaction_list:
-    free(instance->transaction_list);
-    instance->transaction_list = NULL;
-
-done:;
 }
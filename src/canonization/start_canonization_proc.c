@@ -33,6 +33,9 @@
  *                          logger.
  * \param datasock          Pointer to the socket used to communicate with the
  *                          data service.
+ * \param ring              Optional shared-memory ring to the data service, or
+ *                          NULL.  The caller keeps ownership of these
+ *                          descriptors.
  * \param randomsock        Pointer to the socket used to communicate with the
  *                          random service.
  * \param controlsock       Pointer to the socket used to control the
@@ -67,10 +70,13 @@
  */
 int start_canonization_proc(
     const bootstrap_config_t* bconf, const agent_config_t* conf, int* logsock,
-    int* datasock, int* randomsock, int* controlsock, pid_t* canonizationpid,
-    bool runsecure)
+    int* datasock, const ipc_ring_descriptors_t* ring, int* randomsock,
+    int* controlsock, pid_t* canonizationpid, bool runsecure)
 {
     int retval = 1;
+    int ringmem = (NULL != ring) ? ring->memfd : -1;
+    int ringlhs = (NULL != ring) ? ring->lhs : -1;
+    int ringrhs = (NULL != ring) ? ring->rhs : -1;
     uid_t uid;
     gid_t gid;
 
@@ -137,9 +143,21 @@ int start_canonization_proc(
         }
 
         /* move the fds out of the way. */
-        if (AGENTD_STATUS_SUCCESS !=
-            privsep_protect_descriptors(
-                logsock, datasock, randomsock, controlsock, NULL))
+        if (NULL != ring)
+        {
+            retval =
+                privsep_protect_descriptors(
+                    logsock, datasock, randomsock, controlsock, &ringmem,
+                    &ringlhs, &ringrhs, NULL);
+        }
+        else
+        {
+            retval =
+                privsep_protect_descriptors(
+                    logsock, datasock, randomsock, controlsock, NULL);
+        }
+
+        if (AGENTD_STATUS_SUCCESS != retval)
         {
             retval = AGENTD_ERROR_CONFIG_PRIVSEP_SETFDS_FAILURE;
             goto done;
@@ -169,9 +187,30 @@ int start_canonization_proc(
             goto done;
         }
 
+        /* hand over the ring, if there is one. */
+        if (NULL != ring)
+        {
+            retval =
+                privsep_setfds(
+                    ringmem, /* ==> */ AGENTD_FD_CANONIZATION_SVC_RING_MEM,
+                    ringlhs, /* ==> */ AGENTD_FD_CANONIZATION_SVC_RING_LHS,
+                    ringrhs, /* ==> */ AGENTD_FD_CANONIZATION_SVC_RING_RHS,
+                    -1);
+            if (0 != retval)
+            {
+                perror("privsep_setfds");
+                retval =
+                    AGENTD_ERROR_CANONIZATIONSERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+        }
+
         /* close any socket above the given value. */
         retval =
-            privsep_close_other_fds(AGENTD_FD_CANONIZATION_SVC_CONTROL);
+            privsep_close_other_fds(
+                (NULL != ring)
+                    ? AGENTD_FD_CANONIZATION_SVC_RING_RHS
+                    : AGENTD_FD_CANONIZATION_SVC_CONTROL);
         if (0 != retval)
         {
             perror("privsep_close_other_fds");
@@ -55,6 +55,8 @@ int command_readconfig(struct bootstrap_config* bconf)
     if (conf.block_max_transactions_set)
         printf("Canonization max transactions: %d\n",
             (int)conf.block_max_transactions);
+    if (conf.protocol_workers_set)
+        printf("Protocol workers: %d\n", (int)conf.protocol_workers);
     if (NULL != conf.secret)
         printf("Secret file: %s\n", conf.secret);
     if (NULL != conf.rootblock)
@@ -9,6 +9,7 @@
 #include <agentd/command.h>
 #include <agentd/canonizationservice.h>
 #include <agentd/fds.h>
+#include <agentd/ipc.h>
 #include <cbmc/model_assert.h>
 #include <vccrypt/suite.h>
 #include <vpr/parameters.h>
@@ -21,10 +22,17 @@ void private_command_canonizationservice(bootstrap_config_t* UNUSED(bconf))
     /* register the Velo V1 crypto suite. */
     vccrypt_suite_register_velo_v1();
 
+    /* the supervisor may have handed us a ring alongside the socket. */
+    ipc_ring_descriptors_t ring = {
+        AGENTD_FD_CANONIZATION_SVC_RING_MEM,
+        AGENTD_FD_CANONIZATION_SVC_RING_LHS,
+        AGENTD_FD_CANONIZATION_SVC_RING_RHS };
+
     /* run the event loop for the canonization service. */
     int retval =
         canonizationservice_event_loop(
             AGENTD_FD_CANONIZATION_SVC_DATA,
+            ipc_ring_descriptors_valid(&ring) ? &ring : NULL,
             AGENTD_FD_CANONIZATION_SVC_RANDOM,
             AGENTD_FD_CANONIZATION_SVC_LOG,
             AGENTD_FD_CANONIZATION_SVC_CONTROL);
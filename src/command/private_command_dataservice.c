@@ -9,6 +9,7 @@
 #include <agentd/command.h>
 #include <agentd/dataservice.h>
 #include <agentd/fds.h>
+#include <agentd/ipc.h>
 #include <cbmc/model_assert.h>
 #include <vccrypt/suite.h>
 #include <vpr/parameters.h>
@@ -21,10 +22,28 @@ void private_command_dataservice(bootstrap_config_t* UNUSED(bconf))
     /* register the Velo V1 crypto suite. */
     vccrypt_suite_register_velo_v1();
 
+    /* the supervisor may have handed us a ring alongside the socket. */
+    ipc_ring_descriptors_t ring = {
+        AGENTD_FD_DATASERVICE_RING_MEM,
+        AGENTD_FD_DATASERVICE_RING_LHS,
+        AGENTD_FD_DATASERVICE_RING_RHS };
+
+    /* the supervisor may have handed us a socket on which blocks committed
+     * elsewhere are signaled, or sockets on which to signal our blocks. */
+    int blocksubscribe =
+        (dataservice_count_sockets(AGENTD_FD_DATASERVICE_BLOCK_SUBSCRIBE) > 0U)
+            ? AGENTD_FD_DATASERVICE_BLOCK_SUBSCRIBE
+            : -1;
+    size_t blockpublish_count =
+        dataservice_count_sockets(AGENTD_FD_DATASERVICE_BLOCK_PUBLISH_START);
+
     /* run the event loop for the data service. */
     int retval =
         dataservice_event_loop(
-            AGENTD_FD_DATASERVICE_SOCK, AGENTD_FD_DATASERVICE_LOG);
+            AGENTD_FD_DATASERVICE_SOCK, AGENTD_FD_DATASERVICE_LOG,
+            ipc_ring_descriptors_valid(&ring) ? &ring : NULL,
+            blocksubscribe, AGENTD_FD_DATASERVICE_BLOCK_PUBLISH_START,
+            blockpublish_count);
 
     /* exit with the return code from the event loop. */
     exit(retval);
@@ -9,6 +9,7 @@
 #include <agentd/command.h>
 #include <agentd/protocolservice.h>
 #include <agentd/fds.h>
+#include <agentd/ipc.h>
 #include <cbmc/model_assert.h>
 #include <vccrypt/suite.h>
 #include <vpr/parameters.h>
@@ -21,12 +22,19 @@ void private_command_protocolservice(bootstrap_config_t* UNUSED(bconf))
     /* register the Velo V1 crypto suite. */
     vccrypt_suite_register_velo_v1();
 
+    /* the supervisor may have handed us a ring alongside the socket. */
+    ipc_ring_descriptors_t ring = {
+        AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_MEM,
+        AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_LHS,
+        AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_RHS };
+
     /* run the event loop for the protocol service. */
     int retval =
         unauthorized_protocol_service_event_loop(
             AGENTD_FD_UNAUTHORIZED_PROTOSVC_RANDOM,
             AGENTD_FD_UNAUTHORIZED_PROTOSVC_ACCEPT,
             AGENTD_FD_UNAUTHORIZED_PROTOSVC_DATA,
+            ipc_ring_descriptors_valid(&ring) ? &ring : NULL,
             AGENTD_FD_UNAUTHORIZED_PROTOSVC_LOG);
 
     /* exit with the return code from the event loop. */
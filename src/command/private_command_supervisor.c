@@ -101,30 +101,24 @@ static int supervisor_run(const bootstrap_config_t* bconf)
 {
     int retval = AGENTD_STATUS_SUCCESS;
     agent_config_t conf;
-    process_t* random_service;
     process_t* random_for_canonizationservice;
     process_t* listener_service;
-    process_t* data_for_auth_protocol_service;
     process_t* data_for_canonizationservice;
-    process_t* protocol_service;
     process_t* canonizationservice;
+    supervisor_protocol_worker_t* protocol_workers = NULL;
+    size_t protocol_worker_count = 0U;
+    int* block_publish_socks = NULL;
+    size_t i;
 
-    int random_svc_log_sock = -1;
-    int random_svc_log_dummy_sock = -1;
     int random_svc_for_canonization_log_sock = -1;
     int random_svc_for_canonization_log_dummy_sock = -1;
     int listen_svc_log_sock = -1;
     int listen_svc_log_dummy_sock = -1;
-    int unauth_protocol_svc_log_sock = -1;
-    int unauth_protocol_svc_log_dummy_sock = -1;
-    int data_for_auth_protocol_svc_log_sock = -1;
-    int data_for_auth_protocol_svc_log_dummy_sock = -1;
     int data_for_canonization_svc_log_sock = -1;
     int data_for_canonization_svc_log_dummy_sock = -1;
-    int unauth_protocol_svc_random_sock = -1;
     int unauth_protocol_svc_accept_sock = -1;
-    int auth_protocol_svc_data_sock = -1;
     int canonization_svc_data_sock = -1;
+    ipc_ring_descriptors_t canonization_svc_data_ring = { -1, -1, -1 };
     int canonization_svc_random_sock = -1;
     int canonization_svc_log_sock = -1;
     int canonization_svc_log_dummy_sock = -1;
@@ -142,11 +136,6 @@ static int supervisor_run(const bootstrap_config_t* bconf)
     TRY_OR_FAIL(config_read_proc(bconf, &conf), done);
 
     /* TODO - replace with log service. */
-    TRY_OR_FAIL(
-        ipc_socketpair(
-            AF_UNIX, SOCK_STREAM, 0,
-            &random_svc_log_sock, &random_svc_log_dummy_sock),
-        cleanup_config);
     TRY_OR_FAIL(
         ipc_socketpair(
             AF_UNIX, SOCK_STREAM, 0,
@@ -158,18 +147,6 @@ static int supervisor_run(const bootstrap_config_t* bconf)
             AF_UNIX, SOCK_STREAM, 0,
             &listen_svc_log_sock, &listen_svc_log_dummy_sock),
         cleanup_config);
-    TRY_OR_FAIL(
-        ipc_socketpair(
-            AF_UNIX, SOCK_STREAM, 0,
-            &unauth_protocol_svc_log_sock,
-            &unauth_protocol_svc_log_dummy_sock),
-        cleanup_config);
-    TRY_OR_FAIL(
-        ipc_socketpair(
-            AF_UNIX, SOCK_STREAM, 0,
-            &data_for_auth_protocol_svc_log_sock,
-            &data_for_auth_protocol_svc_log_dummy_sock),
-        cleanup_config);
     TRY_OR_FAIL(
         ipc_socketpair(
             AF_UNIX, SOCK_STREAM, 0,
@@ -191,20 +168,13 @@ static int supervisor_run(const bootstrap_config_t* bconf)
         cleanup_config);
 #endif /*AUTHSERVICE*/
 
-    /* create random service. */
-    TRY_OR_FAIL(
-        supervisor_create_random_service(
-            &random_service, bconf, &conf, &random_svc_log_sock,
-            &unauth_protocol_svc_random_sock),
-        cleanup_config);
-
     /* create random service for canonization service. */
     TRY_OR_FAIL(
         supervisor_create_random_service(
             &random_for_canonizationservice, bconf, &conf,
             &random_svc_for_canonization_log_sock,
             &canonization_svc_random_sock),
-        cleanup_random_service);
+        cleanup_config);
 
     /* create listener service. */
     TRY_OR_FAIL(
@@ -213,20 +183,46 @@ static int supervisor_run(const bootstrap_config_t* bconf)
             &listen_svc_log_sock),
         cleanup_random_for_canonizationservice);
 
-    /* create data service for protocol service. */
-    TRY_OR_FAIL(
-        supervisor_create_data_service_for_auth_protocol_service(
-            &data_for_auth_protocol_service, bconf, &conf,
-            &auth_protocol_svc_data_sock, &data_for_auth_protocol_svc_log_sock),
-        cleanup_listener_service);
+    /* allocate the protocol service workers. */
+    protocol_workers =
+        (supervisor_protocol_worker_t*)calloc(
+            conf.protocol_workers, sizeof(supervisor_protocol_worker_t));
+    if (NULL == protocol_workers)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_listener_service;
+    }
 
-    /* create protocol service. */
-    TRY_OR_FAIL(
-        supervisor_create_protocol_service(
-            &protocol_service, bconf, &conf, &unauth_protocol_svc_random_sock,
-            &unauth_protocol_svc_accept_sock, &auth_protocol_svc_data_sock,
-            &unauth_protocol_svc_log_sock),
-        cleanup_data_for_auth_protocol_service);
+    /* create each protocol service worker, with its own random and data
+     * services. */
+    for (protocol_worker_count = 0U;
+         protocol_worker_count < (size_t)conf.protocol_workers;
+         ++protocol_worker_count)
+    {
+        TRY_OR_FAIL(
+            supervisor_create_protocol_worker(
+                &protocol_workers[protocol_worker_count], bconf, &conf,
+                unauth_protocol_svc_accept_sock),
+            cleanup_protocol_workers);
+    }
+
+    /* the canonization data service signals committed blocks to the data
+     * service of each worker. */
+    block_publish_socks = (int*)calloc(protocol_worker_count, sizeof(int));
+    if (NULL == block_publish_socks)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_protocol_workers;
+    }
+
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        block_publish_socks[i] = protocol_workers[i].block_publish_sock;
+    }
+
+    /* each worker has its own copy of the accept socket. */
+    close(unauth_protocol_svc_accept_sock);
+    unauth_protocol_svc_accept_sock = -1;
 
 #if AUTHSERVICE
     /* create auth service */
@@ -234,42 +230,55 @@ static int supervisor_run(const bootstrap_config_t* bconf)
         supervisor_create_auth_service(
             &auth_service, bconf, &conf, &auth_svc_sock,
             &auth_svc_log_sock),
-        cleanup_protocol_service);
+        cleanup_protocol_workers);
 
     /* create data service for canonization service. */
     TRY_OR_FAIL(
         supervisor_create_data_service_for_canonizationservice(
             &data_for_canonizationservice, bconf, &conf,
-            &canonization_svc_data_sock, &data_for_canonization_svc_log_sock),
+            &canonization_svc_data_sock, &data_for_canonization_svc_log_sock,
+            &canonization_svc_data_ring, block_publish_socks,
+            protocol_worker_count),
         cleanup_auth_service);
 #else
     /* create data service for canonization service. */
     TRY_OR_FAIL(
         supervisor_create_data_service_for_canonizationservice(
             &data_for_canonizationservice, bconf, &conf,
-            &canonization_svc_data_sock, &data_for_canonization_svc_log_sock),
-        cleanup_protocol_service);
+            &canonization_svc_data_sock, &data_for_canonization_svc_log_sock,
+            &canonization_svc_data_ring, block_publish_socks,
+            protocol_worker_count),
+        cleanup_protocol_workers);
 #endif /*AUTHSERVICE*/
 
     /* create canonization service. */
     TRY_OR_FAIL(
         supervisor_create_canonizationservice(
             &canonizationservice, bconf, &conf, &canonization_svc_data_sock,
-            &canonization_svc_random_sock, &canonization_svc_log_sock,
-            &canonization_svc_control_sock),
+            &canonization_svc_data_ring, &canonization_svc_random_sock,
+            &canonization_svc_log_sock, &canonization_svc_control_sock),
         cleanup_data_service_for_canonizationservice);
 
     /* if we've made it this far, attempt to start each service. */
-    START_PROCESS(random_service, cleanup_canonizationservice);
     START_PROCESS(random_for_canonizationservice, cleanup_canonizationservice);
     START_PROCESS(data_for_canonizationservice, cleanup_canonizationservice);
-    START_PROCESS(data_for_auth_protocol_service, quiesce_data_processes);
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        START_PROCESS(
+            protocol_workers[i].random_service, quiesce_data_processes);
+        START_PROCESS(
+            protocol_workers[i].data_service, quiesce_data_processes);
+    }
     START_PROCESS(listener_service, quiesce_data_processes);
 
 #if AUTHSERVICE
     START_PROCESS(auth_service, quiesce_data_processes);
 #endif /*AUTHSERVICE*/
-    START_PROCESS(protocol_service, quiesce_data_processes);
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        START_PROCESS(
+            protocol_workers[i].protocol_service, quiesce_data_processes);
+    }
     START_PROCESS(canonizationservice, quiesce_data_processes);
 
     /* wait until we get a signal, and then restart / terminate. */
@@ -283,26 +292,38 @@ static int supervisor_run(const bootstrap_config_t* bconf)
     process_stop(auth_service);
 #endif /*AUTHSERVICE*/
     process_stop(listener_service);
-    process_stop(protocol_service);
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        process_stop(protocol_workers[i].protocol_service);
+    }
     process_stop(canonizationservice);
 
     /* wait an additional 2 seconds. */
     sleep(2);
 
     process_stop_ex(random_for_canonizationservice, 0);
-    process_stop_ex(random_service, 0);
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        process_stop_ex(protocol_workers[i].random_service, 0);
+    }
 
     /* kill these processes. */
 #if AUTHSERVICE
     process_kill(auth_service);
 #endif /*AUTHSERVICE*/
     process_kill(listener_service);
-    process_kill(protocol_service);
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        process_kill(protocol_workers[i].protocol_service);
+    }
     process_kill(canonizationservice);
 
 quiesce_data_processes:
     process_stop_ex(data_for_canonizationservice, 0);
-    process_stop_ex(data_for_auth_protocol_service, 0);
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        process_stop_ex(protocol_workers[i].data_service, 0);
+    }
 
 cleanup_canonizationservice:
     CLEANUP_PROCESS(canonizationservice);
@@ -315,11 +336,13 @@ cleanup_auth_service:
     CLEANUP_PROCESS(auth_service);
 #endif /*AUTHSERVICE*/
 
-cleanup_protocol_service:
-    CLEANUP_PROCESS(protocol_service);
-
-cleanup_data_for_auth_protocol_service:
-    CLEANUP_PROCESS(data_for_auth_protocol_service);
+cleanup_protocol_workers:
+    for (i = 0U; i < protocol_worker_count; ++i)
+    {
+        dispose((disposable_t*)&protocol_workers[i]);
+    }
+    free(protocol_workers);
+    free(block_publish_socks);
 
 cleanup_listener_service:
     CLEANUP_PROCESS(listener_service);
@@ -327,29 +350,19 @@ cleanup_listener_service:
 cleanup_random_for_canonizationservice:
     CLEANUP_PROCESS(random_for_canonizationservice);
 
-cleanup_random_service:
-    CLEANUP_PROCESS(random_service);
-
 cleanup_config:
     dispose((disposable_t*)&conf);
 
 done:
-    CLOSE_IF_VALID(random_svc_log_sock);
-    CLOSE_IF_VALID(random_svc_log_dummy_sock);
     CLOSE_IF_VALID(random_svc_for_canonization_log_sock);
     CLOSE_IF_VALID(random_svc_for_canonization_log_dummy_sock);
     CLOSE_IF_VALID(listen_svc_log_sock);
     CLOSE_IF_VALID(listen_svc_log_dummy_sock);
-    CLOSE_IF_VALID(unauth_protocol_svc_log_sock);
-    CLOSE_IF_VALID(unauth_protocol_svc_log_dummy_sock);
-    CLOSE_IF_VALID(data_for_auth_protocol_svc_log_sock);
-    CLOSE_IF_VALID(data_for_auth_protocol_svc_log_dummy_sock);
     CLOSE_IF_VALID(data_for_canonization_svc_log_sock);
     CLOSE_IF_VALID(data_for_canonization_svc_log_dummy_sock);
-    CLOSE_IF_VALID(unauth_protocol_svc_random_sock);
     CLOSE_IF_VALID(unauth_protocol_svc_accept_sock);
-    CLOSE_IF_VALID(auth_protocol_svc_data_sock);
     CLOSE_IF_VALID(canonization_svc_data_sock);
+    ipc_ring_descriptors_close(&canonization_svc_data_ring);
     CLOSE_IF_VALID(canonization_svc_random_sock);
     CLOSE_IF_VALID(canonization_svc_log_sock);
     CLOSE_IF_VALID(canonization_svc_log_dummy_sock);
@@ -38,6 +38,10 @@ static agent_config_t* add_logdir(
     config_context_t*, agent_config_t*, const char*);
 static agent_config_t* add_loglevel(
     config_context_t*, agent_config_t*, int64_t);
+static agent_config_t* add_protocol_workers(
+    config_context_t*, agent_config_t*, int64_t);
+static agent_config_t* add_ipc_ring_capacity(
+    config_context_t*, agent_config_t*, int64_t);
 static agent_config_t* add_secret(
     config_context_t*, agent_config_t*, const char*);
 static agent_config_t* add_rootblock(
@@ -121,6 +125,7 @@ void view_field_dispose(void* disp);
 %token <string> FIELD
 %token <string> IDENTIFIER
 %token <addr> IP
+%token <string> IPC
 %token <string> INVALID
 %token <string> INVALID_IP
 %token <string> LBRACE
@@ -131,7 +136,9 @@ void view_field_dispose(void* disp);
 %token <string> MAX
 %token <number> NUMBER
 %token <string> PATH
+%token <string> PROTOCOL
 %token <string> RBRACE
+%token <string> RING
 %token <string> ROOTBLOCK
 %token <string> MILLISECONDS
 %token <string> SECRET
@@ -143,6 +150,7 @@ void view_field_dispose(void* disp);
 %token <id> UUID
 %token <id> UUID_INVALID
 %token <string> VIEW
+%token <string> WORKERS
 
 /* Types for branch nodes.. */
 %type <config> conf
@@ -150,9 +158,11 @@ void view_field_dispose(void* disp);
 %type <canonization> canonization
 %type <canonization> canonization_block
 %type <string> datastore
+%type <number> ipc_ring
 %type <listenaddr> listen
 %type <string> logdir
 %type <number> loglevel
+%type <number> protocol_workers
 %type <string> rootblock
 %type <string> secret
 %type <usergroup> usergroup
@@ -180,6 +190,12 @@ conf : {
     | conf loglevel {
             /* fold in loglevel. */
             MAYBE_ASSIGN($$, add_loglevel(context, $1, $2)); }
+    | conf protocol_workers {
+            /* fold in the protocol worker count. */
+            MAYBE_ASSIGN($$, add_protocol_workers(context, $1, $2)); }
+    | conf ipc_ring {
+            /* fold in the shared-memory ring capacity. */
+            MAYBE_ASSIGN($$, add_ipc_ring_capacity(context, $1, $2)); }
     | conf secret {
             /* fold in secret. */
             MAYBE_ASSIGN($$, add_secret(context, $1, $2)); }
@@ -221,6 +237,18 @@ loglevel
             $$ = $2; }
     ;
 
+/* Provide the number of protocol service workers. */
+protocol_workers
+    : PROTOCOL WORKERS NUMBER {
+            $$ = $3; }
+    ;
+
+/* Provide the capacity of the shared-memory rings to the data services. */
+ipc_ring
+    : IPC RING NUMBER {
+            $$ = $3; }
+    ;
+
 /* Provide a secret file that is either a simple identifier or a path. */
 secret
     : SECRET PATH {
@@ -449,6 +477,52 @@ static agent_config_t* add_loglevel(
     return cfg;
 }
 
+/**
+ * \brief Add a protocol worker count to the config structure.
+ */
+static agent_config_t* add_protocol_workers(
+    config_context_t* context, agent_config_t* cfg, int64_t workers)
+{
+    if (cfg->protocol_workers_set)
+    {
+        CONFIG_ERROR("Duplicate protocol workers settings.");
+    }
+
+    if (workers < 1 || workers > PROTOCOL_WORKERS_MAXIMUM)
+    {
+        CONFIG_ERROR("Bad protocol workers range.");
+    }
+
+    cfg->protocol_workers_set = true;
+    cfg->protocol_workers = workers;
+
+    return cfg;
+}
+
+/**
+ * \brief Add a shared-memory ring capacity to the config structure.
+ */
+static agent_config_t* add_ipc_ring_capacity(
+    config_context_t* context, agent_config_t* cfg, int64_t capacity)
+{
+    if (cfg->ipc_ring_capacity_set)
+    {
+        CONFIG_ERROR("Duplicate ipc ring settings.");
+    }
+
+    if (capacity < IPC_RING_CAPACITY_MINIMUM
+     || capacity > IPC_RING_CAPACITY_MAXIMUM
+     || 0 != (capacity & (capacity - 1)))
+    {
+        CONFIG_ERROR("Bad ipc ring capacity.");
+    }
+
+    cfg->ipc_ring_capacity_set = true;
+    cfg->ipc_ring_capacity = capacity;
+
+    return cfg;
+}
+
 /**
  * \brief Add a secret to the config structure.
  */
@@ -20,6 +20,8 @@ static int config_read_logdir(int s, agent_config_t* conf);
 static int config_read_loglevel(int s, agent_config_t* conf);
 static int config_read_block_max_milliseconds(int s, agent_config_t* conf);
 static int config_read_block_max_transactions(int s, agent_config_t* conf);
+static int config_read_protocol_workers(int s, agent_config_t* conf);
+static int config_read_ipc_ring_capacity(int s, agent_config_t* conf);
 static int config_read_secret(int s, agent_config_t* conf);
 static int config_read_rootblock(int s, agent_config_t* conf);
 static int config_read_datastore(int s, agent_config_t* conf);
@@ -155,6 +157,22 @@ int config_read_block(int s, agent_config_t* conf)
                     return retval;
                 break;
 
+            /* protocol workers */
+            case CONFIG_STREAM_TYPE_PROTOCOL_WORKERS:
+                /* attempt to read the protocol worker count. */
+                retval = config_read_protocol_workers(s, conf);
+                if (AGENTD_STATUS_SUCCESS != retval)
+                    return retval;
+                break;
+
+            /* shared-memory ring capacity */
+            case CONFIG_STREAM_TYPE_IPC_RING_CAPACITY:
+                /* attempt to read the ring capacity. */
+                retval = config_read_ipc_ring_capacity(s, conf);
+                if (AGENTD_STATUS_SUCCESS != retval)
+                    return retval;
+                break;
+
             /* unknown data */
             default:
                 /* return error. */
@@ -298,6 +316,78 @@ static int config_read_block_max_transactions(int s, agent_config_t* conf)
     return AGENTD_STATUS_SUCCESS;
 }
 
+/**
+ * \brief Read the protocol worker count from the config stream.
+ *
+ * \param s             The socket from which this value is read.
+ * \param conf          The config structure instance to write this value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_CONFIG_IPC_READ_DATA_FAILURE if there was a failure
+ *        reading from the config socket.
+ *      - AGENTD_ERROR_CONFIG_INVALID_STREAM the stream data was corrupted or
+ *        invalid.
+ */
+static int config_read_protocol_workers(int s, agent_config_t* conf)
+{
+    /* it's an error to set the protocol worker count more than once. */
+    if (conf->protocol_workers_set)
+        return AGENTD_ERROR_CONFIG_INVALID_STREAM;
+
+    /* attempt to read the value. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_read_int64_block(s, &conf->protocol_workers))
+        return AGENTD_ERROR_CONFIG_IPC_READ_DATA_FAILURE;
+
+    /* protocol workers must be between 1 and PROTOCOL_WORKERS_MAXIMUM. */
+    if (conf->protocol_workers < 1 || conf->protocol_workers > PROTOCOL_WORKERS_MAXIMUM)
+        return AGENTD_ERROR_CONFIG_INVALID_STREAM;
+
+    /* protocol_workers has been set. */
+    conf->protocol_workers_set = true;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Read the shared-memory ring capacity from the config stream.
+ *
+ * \param s             The socket from which this value is read.
+ * \param conf          The config structure instance to write this value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_CONFIG_IPC_READ_DATA_FAILURE if there was a failure
+ *        reading from the config socket.
+ *      - AGENTD_ERROR_CONFIG_INVALID_STREAM the stream data was corrupted or
+ *        invalid.
+ */
+static int config_read_ipc_ring_capacity(int s, agent_config_t* conf)
+{
+    /* it's an error to set the ring capacity more than once. */
+    if (conf->ipc_ring_capacity_set)
+        return AGENTD_ERROR_CONFIG_INVALID_STREAM;
+
+    /* attempt to read the value. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_read_int64_block(s, &conf->ipc_ring_capacity))
+        return AGENTD_ERROR_CONFIG_IPC_READ_DATA_FAILURE;
+
+    /* the capacity must be a power of two within range. */
+    if (conf->ipc_ring_capacity < IPC_RING_CAPACITY_MINIMUM
+     || conf->ipc_ring_capacity > IPC_RING_CAPACITY_MAXIMUM
+     || 0 != (conf->ipc_ring_capacity & (conf->ipc_ring_capacity - 1)))
+        return AGENTD_ERROR_CONFIG_INVALID_STREAM;
+
+    /* ipc_ring_capacity has been set. */
+    conf->ipc_ring_capacity_set = true;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
 /**
  * \brief Read the secret from the config stream.
  *
@@ -56,6 +56,13 @@ int config_set_defaults(agent_config_t* conf, const bootstrap_config_t* bconf)
         conf->block_max_transactions_set = true;
     }
 
+    /* if protocol_workers is not set, run a single protocol service. */
+    if (!conf->protocol_workers_set || conf->protocol_workers < 1 || conf->protocol_workers > PROTOCOL_WORKERS_MAXIMUM)
+    {
+        conf->protocol_workers = 1;
+        conf->protocol_workers_set = true;
+    }
+
     /* if secret is not set, set it to "root/secret.cert" */
     if (NULL == conf->secret)
     {
@@ -18,6 +18,8 @@ static int config_write_logdir(int s, agent_config_t* conf);
 static int config_write_loglevel(int s, agent_config_t* conf);
 static int config_write_block_max_milliseconds(int s, agent_config_t* conf);
 static int config_write_block_max_transactions(int s, agent_config_t* conf);
+static int config_write_protocol_workers(int s, agent_config_t* conf);
+static int config_write_ipc_ring_capacity(int s, agent_config_t* conf);
 static int config_write_secret(int s, agent_config_t* conf);
 static int config_write_rootblock(int s, agent_config_t* conf);
 static int config_write_datastore(int s, agent_config_t* conf);
@@ -68,6 +70,16 @@ int config_write_block(int s, agent_config_t* conf)
     if (AGENTD_STATUS_SUCCESS != retval)
         return retval;
 
+    /* protocol workers */
+    retval = config_write_protocol_workers(s, conf);
+    if (AGENTD_STATUS_SUCCESS != retval)
+        return retval;
+
+    /* shared-memory ring capacity */
+    retval = config_write_ipc_ring_capacity(s, conf);
+    if (AGENTD_STATUS_SUCCESS != retval)
+        return retval;
+
     /* secret */
     retval = config_write_secret(s, conf);
     if (AGENTD_STATUS_SUCCESS != retval)
@@ -229,6 +241,68 @@ static int config_write_block_max_transactions(int s, agent_config_t* conf)
     return AGENTD_STATUS_SUCCESS;
 }
 
+/**
+ * \brief Write the protocol worker count to the config output stream.
+ *
+ * \param s             The config output stream.
+ * \param conf          The config structure from which this value is obtained.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_CONFIG_IPC_WRITE_DATA_FAILURE if writing data to the
+ *        socket failed.
+ */
+static int config_write_protocol_workers(int s, agent_config_t* conf)
+{
+    /* write the protocol worker count if set. */
+    if (conf->protocol_workers_set)
+    {
+        /* write the protocol workers type to the stream. */
+        uint8_t type = CONFIG_STREAM_TYPE_PROTOCOL_WORKERS;
+        if (AGENTD_STATUS_SUCCESS != ipc_write_uint8_block(s, type))
+            return AGENTD_ERROR_CONFIG_IPC_WRITE_DATA_FAILURE;
+
+        /* write the protocol worker count to the stream. */
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_write_int64_block(s, conf->protocol_workers))
+            return AGENTD_ERROR_CONFIG_IPC_WRITE_DATA_FAILURE;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write the shared-memory ring capacity to the config output stream.
+ *
+ * \param s             The config output stream.
+ * \param conf          The config structure from which this value is obtained.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_CONFIG_IPC_WRITE_DATA_FAILURE if writing data to the
+ *        socket failed.
+ */
+static int config_write_ipc_ring_capacity(int s, agent_config_t* conf)
+{
+    /* write the ring capacity if set. */
+    if (conf->ipc_ring_capacity_set)
+    {
+        /* write the ring capacity type to the stream. */
+        uint8_t type = CONFIG_STREAM_TYPE_IPC_RING_CAPACITY;
+        if (AGENTD_STATUS_SUCCESS != ipc_write_uint8_block(s, type))
+            return AGENTD_ERROR_CONFIG_IPC_WRITE_DATA_FAILURE;
+
+        /* write the ring capacity to the stream. */
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_write_int64_block(s, conf->ipc_ring_capacity))
+            return AGENTD_ERROR_CONFIG_IPC_WRITE_DATA_FAILURE;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
 /**
  * \brief Write the secret to the config output stream.
  *
@@ -0,0 +1,150 @@
+/**
+ * \file dataservice/dataservice_api_recvresp_block_make_from_queue.c
+ *
+ * \brief Read the response from the block make from queue call.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/dataservice/api.h>
+#include <agentd/dataservice/async_api.h>
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Receive a response from the block make from queue operation.
+ *
+ * \param sock              The socket on which this request is made.
+ * \param offset            The child context offset for this response.
+ * \param status            This value is updated with the status code returned
+ *                          from the request.
+ * \param block_id          Pointer to the 16 byte array to receive the block
+ *                          id.
+ * \param transaction_count Pointer to receive the number of transactions in
+ *                          this block.
+ * \param block_hash        Pointer to receive the block hash.
+ * \param block_hash_size   Pointer to receive the block hash size.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  A zero
+ * status indicates success, and a non-zero status indicates failure.  On
+ * success, the block id, transaction count, and block hash are updated to
+ * reflect the block that was made.  The block hash is a dynamically allocated
+ * buffer that must be freed by the caller.
+ *
+ * If the status code is updated with an error from the service, then this error
+ * will be reflected in the status variable, and a AGENTD_STATUS_SUCCESS will be
+ * returned by this function.  Thus, both the return value of this function and
+ * the upstream status code must be checked for correct operation.  Here are a
+ * few possible status codes; it is not possible to list them all.
+ *      - AGENTD_STATUS_SUCCESS if the remote operation completed successfully.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if there were no attested
+ *        transactions in the transaction queue.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this client node is not
+ *        authorized to perform the requested operation.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT if the block height for
+ *        this block was not valid.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_UUID if the block uuid for this
+ *        block was invalid or already exists.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the operation was halted because it
+ *        would block this thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_READ_DATA_FAILURE if reading data from
+ *        the socket failed.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_DATA_PACKET_SIZE if the
+ *        data packet size is unexpected.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        method code was unexpected.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_MALFORMED_PAYLOAD_DATA if the
+ *        payload data was malformed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int dataservice_api_recvresp_block_make_from_queue(
+    ipc_socket_context_t* sock, uint32_t* offset, uint32_t* status,
+    uint8_t* block_id, uint32_t* transaction_count, void** block_hash,
+    size_t* block_hash_size)
+{
+    int retval = 0;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != status);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(NULL != transaction_count);
+    MODEL_ASSERT(NULL != block_hash);
+    MODEL_ASSERT(NULL != block_hash_size);
+
+    /* read a data packet from the socket. */
+    uint32_t* val = NULL;
+    uint32_t size = 0U;
+    retval = ipc_read_data_noblock(sock, (void**)&val, &size);
+    if (AGENTD_ERROR_IPC_WOULD_BLOCK == retval)
+    {
+        goto done;
+    }
+    else if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_IPC_READ_DATA_FAILURE;
+        goto done;
+    }
+
+    /* decode the response. */
+    dataservice_response_block_make_from_queue_t dresp;
+    retval =
+        dataservice_decode_response_block_make_from_queue(val, size, &dresp);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_val;
+    }
+
+    /* get the offset. */
+    *offset = dresp.hdr.offset;
+
+    /* get the status code. */
+    *status = dresp.hdr.status;
+
+    /* if the status code is successful, then the block details will be in
+     * this payload. */
+    if (AGENTD_STATUS_SUCCESS != (int)dresp.hdr.status)
+        goto cleanup_dresp;
+
+    /* allocate memory for the block hash. */
+    *block_hash = malloc(dresp.block_hash_size);
+    if (NULL == *block_hash)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_dresp;
+    }
+
+    /* copy the block hash. */
+    memcpy(*block_hash, dresp.block_hash, dresp.block_hash_size);
+    *block_hash_size = dresp.block_hash_size;
+
+    /* copy the block id. */
+    memcpy(block_id, dresp.block_id, 16);
+
+    /* copy the transaction count. */
+    *transaction_count = dresp.transaction_count;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto cleanup_dresp;
+
+cleanup_dresp:
+    dispose((disposable_t*)&dresp);
+
+cleanup_val:
+    memset(val, 0, size);
+    free(val);
+
+done:
+    return retval;
+}
@@ -0,0 +1,91 @@
+/**
+ * \file dataservice/dataservice_api_sendreq_artifact_watch.c
+ *
+ * \brief Watch a set of artifacts for updates.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/dataservice/api.h>
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Watch a set of artifacts for updates.
+ *
+ * Once watched, each update to one of these artifacts in a committed block is
+ * sent as a DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE notification until
+ * the child context is closed.
+ *
+ * \param sock          The socket on which this request is made.
+ * \param child         The child index watching these artifacts.
+ * \param artifact_ids  The artifact UUIDs to watch, 16 bytes each.
+ * \param count         The number of artifact UUIDs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_artifact_watch(
+    ipc_socket_context_t* sock, uint32_t child, const uint8_t* artifact_ids,
+    size_t count)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != artifact_ids || 0U == count);
+
+    /* | Artifact Watch.                                                   | */
+    /* | -------------------------------------------------- | ------------ | */
+    /* | DATA                                               | SIZE         | */
+    /* | -------------------------------------------------- | ------------ | */
+    /* | DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH          |  4 bytes     | */
+    /* | child_context_index                                |  4 bytes     | */
+    /* | artifact_ids                                       | 16 * n bytes | */
+    /* | -------------------------------------------------- | ------------ | */
+
+    /* allocate a structure large enough for writing this request. */
+    size_t reqbuflen = 2 * sizeof(uint32_t) + 16 * count;
+    uint8_t* reqbuf = (uint8_t*)malloc(reqbuflen);
+    if (NULL == reqbuf)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* copy the request ID to the buffer. */
+    uint32_t req = htonl(DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH);
+    memcpy(reqbuf, &req, sizeof(req));
+
+    /* copy the child context index parameter to the buffer. */
+    uint32_t nchild = htonl(child);
+    memcpy(reqbuf + sizeof(req), &nchild, sizeof(nchild));
+
+    /* copy the artifact ids to the buffer. */
+    if (count > 0U)
+    {
+        memcpy(reqbuf + sizeof(req) + sizeof(nchild), artifact_ids, 16 * count);
+    }
+
+    /* the request packet consists of the command, index, and artifact ids. */
+    int retval = ipc_write_data_noblock(sock, reqbuf, reqbuflen);
+    if (AGENTD_ERROR_IPC_WOULD_BLOCK != retval && AGENTD_STATUS_SUCCESS != retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE;
+    }
+
+    /* clean up memory. */
+    memset(reqbuf, 0, reqbuflen);
+    free(reqbuf);
+
+    /* return the status of this request write to the caller. */
+    return retval;
+}
@@ -0,0 +1,98 @@
+/**
+ * \file dataservice/dataservice_api_sendreq_block_cert_read.c
+ *
+ * \brief Read a slice of a block certificate from the block database.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/dataservice/api.h>
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Read a slice of a block certificate from the dataservice by block ID.
+ *
+ * \param sock          The socket on which this request is made.
+ * \param child         The child index used for the query.
+ * \param block_id      The block UUID of the certificate to read.
+ * \param cert_offset   The offset of the slice within the certificate.
+ * \param max_size      The largest slice to return.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_block_cert_read(
+    ipc_socket_context_t* sock, uint32_t child, const uint8_t* block_id,
+    uint64_t cert_offset, uint32_t max_size)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != block_id);
+
+    /* | Block certificate read packet.                                       */
+    /* | ---------------------------------------------------- | ----------- | */
+    /* | DATA                                                 | SIZE        | */
+    /* | ---------------------------------------------------- | ----------- | */
+    /* | DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ           |  4 bytes    | */
+    /* | child_context_index                                  |  4 bytes    | */
+    /* | block UUID.                                          | 16 bytes    | */
+    /* | certificate offset.                                  |  8 bytes    | */
+    /* | maximum slice size.                                  |  4 bytes    | */
+    /* | ---------------------------------------------------- | ----------- | */
+
+    /* allocate a structure large enough for writing this request. */
+    size_t reqbuflen =
+        2 * sizeof(uint32_t) + 16 + sizeof(uint64_t) + sizeof(uint32_t);
+    uint8_t* reqbuf = (uint8_t*)malloc(reqbuflen);
+    if (NULL == reqbuf)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* copy the request ID to the buffer. */
+    uint32_t req = htonl(DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ);
+    memcpy(reqbuf, &req, sizeof(req));
+
+    /* copy the child context index parameter to the buffer. */
+    uint32_t nchild = htonl(child);
+    memcpy(reqbuf + sizeof(req), &nchild, sizeof(nchild));
+
+    /* copy the block id to the buffer. */
+    memcpy(reqbuf + 2 * sizeof(uint32_t), block_id, 16);
+
+    /* copy the certificate offset to the buffer. */
+    uint64_t noffset = htonll(cert_offset);
+    memcpy(reqbuf + 2 * sizeof(uint32_t) + 16, &noffset, sizeof(noffset));
+
+    /* copy the maximum slice size to the buffer. */
+    uint32_t nmax_size = htonl(max_size);
+    memcpy(
+        reqbuf + 2 * sizeof(uint32_t) + 16 + sizeof(noffset), &nmax_size,
+        sizeof(nmax_size));
+
+    /* write the request packet. */
+    int retval = ipc_write_data_noblock(sock, reqbuf, reqbuflen);
+    if (AGENTD_ERROR_IPC_WOULD_BLOCK != retval && AGENTD_STATUS_SUCCESS != retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE;
+    }
+
+    /* clean up memory. */
+    memset(reqbuf, 0, reqbuflen);
+    free(reqbuf);
+
+    /* return the status of this request write to the caller. */
+    return retval;
+}
@@ -0,0 +1,112 @@
+/**
+ * \file dataservice/dataservice_api_sendreq_block_make_from_queue.c
+ *
+ * \brief Make a block from attested transactions in the transaction queue.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/dataservice/api.h>
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+/**
+ * \brief Make a block from attested transactions in the transaction queue.
+ *
+ * The data service assembles the block certificate from the attested
+ * transactions at the head of the transaction queue, so the transaction
+ * certificates never leave the data service.  If this call is successful, then
+ * this block and those transactions are canonized.
+ *
+ * \param sock              The socket on which this request is made.
+ * \param child             The child index used for this operation.
+ * \param block_id          The block UUID bytes for this block.
+ * \param block_height      The height of this block.
+ * \param max_transactions  The maximum number of transactions in this block.
+ * \param max_block_size    The maximum size of this block, or 0 for no limit.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory condition.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this write operation would block this
+ *        thread.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if an error occurred
+ *        when writing to the socket.
+ */
+int dataservice_api_sendreq_block_make_from_queue(
+    ipc_socket_context_t* sock, uint32_t child, const uint8_t* block_id,
+    uint64_t block_height, uint32_t max_transactions, uint32_t max_block_size)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(max_transactions > 0);
+
+    /* | Block Make From Queue Packet.                                   | */
+    /* | ------------------------------------------------ | ------------ | */
+    /* | DATA                                             | SIZE         | */
+    /* | ------------------------------------------------ | ------------ | */
+    /* | DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE | 4 bytes      | */
+    /* | child_context_index                              | 4 bytes      | */
+    /* | block_id                                         | 16 bytes     | */
+    /* | block_height                                     | 8 bytes      | */
+    /* | max_transactions                                 | 4 bytes      | */
+    /* | max_block_size                                   | 4 bytes      | */
+    /* | ------------------------------------------------ | ------------ | */
+
+    /* allocate a structure large enough for writing this request. */
+    size_t reqbuflen = 4 * sizeof(uint32_t) + 1 * 16 + sizeof(uint64_t);
+    uint8_t* reqbuf = (uint8_t*)malloc(reqbuflen);
+    if (NULL == reqbuf)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* copy the request ID to the buffer. */
+    uint32_t req = htonl(DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE);
+    memcpy(reqbuf, &req, sizeof(req));
+
+    /* copy the child context index parameter to the buffer. */
+    uint32_t nchild = htonl(child);
+    memcpy(reqbuf + sizeof(req), &nchild, sizeof(nchild));
+
+    /* copy the block id to the buffer. */
+    memcpy(reqbuf + sizeof(req) + sizeof(nchild), block_id, 16);
+
+    /* copy the block height to the buffer. */
+    uint64_t nheight = htonll(block_height);
+    memcpy(reqbuf + sizeof(req) + sizeof(nchild) + 16,
+        &nheight, sizeof(nheight));
+
+    /* copy the maximum transaction count to the buffer. */
+    uint32_t nmax_transactions = htonl(max_transactions);
+    memcpy(reqbuf + sizeof(req) + sizeof(nchild) + 16 + sizeof(nheight),
+        &nmax_transactions, sizeof(nmax_transactions));
+
+    /* copy the maximum block size to the buffer. */
+    uint32_t nmax_block_size = htonl(max_block_size);
+    memcpy(reqbuf + sizeof(req) + sizeof(nchild) + 16 + sizeof(nheight)
+            + sizeof(nmax_transactions),
+        &nmax_block_size, sizeof(nmax_block_size));
+
+    /* the request packet consists of the command, index, block_id, height,
+     * and limits. */
+    int retval = ipc_write_data_noblock(sock, reqbuf, reqbuflen);
+    if (AGENTD_ERROR_IPC_WOULD_BLOCK != retval && AGENTD_STATUS_SUCCESS != retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE;
+    }
+
+    /* clean up memory. */
+    memset(reqbuf, 0, reqbuflen);
+    free(reqbuf);
+
+    /* return the status of this request write to the caller. */
+    return retval;
+}
@@ -0,0 +1,140 @@
+/**
+ * \file dataservice/dataservice_artifact_watch_add.c
+ *
+ * \brief Add an artifact to the watch index for a child context.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/* forward decls. */
+static int dataservice_artifact_watch_index_grow(dataservice_instance_t* inst);
+
+/**
+ * \brief Add an artifact to the watch index for a child context.
+ *
+ * Watching an artifact that the child context already watches does nothing.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context.
+ * \param artifact_id   The artifact UUID to watch.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ */
+int dataservice_artifact_watch_add(
+    dataservice_instance_t* inst, uint32_t offset,
+    const uint8_t* artifact_id)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(offset < DATASERVICE_MAX_CHILD_CONTEXTS);
+    MODEL_ASSERT(NULL != artifact_id);
+
+    /* keep the index at no more than one watch per bucket on average. */
+    if (inst->artifact_watch_count >= inst->artifact_watch_bucket_count)
+    {
+        retval = dataservice_artifact_watch_index_grow(inst);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* a child context only watches an artifact once. */
+    dataservice_artifact_watch_t** bucket =
+        dataservice_artifact_watch_bucket(inst, artifact_id);
+    for (dataservice_artifact_watch_t* watch = *bucket; NULL != watch;
+         watch = watch->bucket_next)
+    {
+        if (offset == watch->child_index
+         && !memcmp(watch->artifact_id, artifact_id, 16))
+        {
+            return AGENTD_STATUS_SUCCESS;
+        }
+    }
+
+    /* create the watch. */
+    dataservice_artifact_watch_t* watch =
+        (dataservice_artifact_watch_t*)malloc(
+            sizeof(dataservice_artifact_watch_t));
+    if (NULL == watch)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    dataservice_child_details_t* child = &inst->children[offset];
+    watch->child_index = offset;
+    memcpy(watch->artifact_id, artifact_id, 16);
+
+    /* add it to its bucket and to the child context's watches. */
+    watch->bucket_next = *bucket;
+    *bucket = watch;
+    watch->child_next = child->artifact_watches;
+    child->artifact_watches = watch;
+
+    ++child->artifact_watch_count;
+    ++inst->artifact_watch_count;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Double the number of buckets in the watch index.
+ *
+ * \param inst          The data service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ */
+static int dataservice_artifact_watch_index_grow(dataservice_instance_t* inst)
+{
+    dataservice_artifact_watch_t** old_buckets = inst->artifact_watch_buckets;
+    size_t old_bucket_count = inst->artifact_watch_bucket_count;
+    size_t new_bucket_count =
+        (0U == old_bucket_count) ? 64U : 2U * old_bucket_count;
+
+    dataservice_artifact_watch_t** new_buckets =
+        (dataservice_artifact_watch_t**)calloc(
+            new_bucket_count, sizeof(dataservice_artifact_watch_t*));
+    if (NULL == new_buckets)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    inst->artifact_watch_buckets = new_buckets;
+    inst->artifact_watch_bucket_count = new_bucket_count;
+
+    /* move each watch to its bucket in the new index. */
+    for (size_t i = 0; i < old_bucket_count; ++i)
+    {
+        dataservice_artifact_watch_t* watch = old_buckets[i];
+        while (NULL != watch)
+        {
+            dataservice_artifact_watch_t* next = watch->bucket_next;
+            dataservice_artifact_watch_t** bucket =
+                dataservice_artifact_watch_bucket(inst, watch->artifact_id);
+
+            watch->bucket_next = *bucket;
+            *bucket = watch;
+            watch = next;
+        }
+    }
+
+    free(old_buckets);
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file dataservice/dataservice_artifact_watch_bucket.c
+ *
+ * \brief Get the watch index bucket for an artifact.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Get the watch index bucket for an artifact.
+ *
+ * The bucket is picked by a hash of the artifact UUID.
+ *
+ * \param inst          The data service instance.
+ * \param artifact_id   The artifact UUID.
+ *
+ * \returns the bucket head, which may be NULL.  The watch index must not be
+ * empty.
+ */
+dataservice_artifact_watch_t** dataservice_artifact_watch_bucket(
+    dataservice_instance_t* inst, const uint8_t* artifact_id)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != inst->artifact_watch_buckets);
+    MODEL_ASSERT(NULL != artifact_id);
+
+    /* FNV-1a hash of the artifact UUID. */
+    uint64_t hash = 0xcbf29ce484222325UL;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        hash ^= artifact_id[i];
+        hash *= 0x00000100000001b3UL;
+    }
+
+    /* the bucket count is a power of two. */
+    return
+        inst->artifact_watch_buckets
+            + ((size_t)hash & (inst->artifact_watch_bucket_count - 1U));
+}
@@ -0,0 +1,469 @@
+/**
+ * \file dataservice/dataservice_artifact_watch_check.c
+ *
+ * \brief Notify watchers of artifacts updated by newly committed blocks.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/certificate_types.h>
+#include <vccert/fields.h>
+#include <vccert/parser.h>
+#include <vccrypt/suite.h>
+#include <vpr/allocator/malloc_allocator.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+#include "dataservice_protocol_internal.h"
+
+/* forward decls. */
+static int dataservice_artifact_watch_check_block(
+    dataservice_instance_t* inst, vccert_parser_options_t* parser_options,
+    MDB_txn* txn, const data_block_node_t* node);
+static int dataservice_artifact_watch_check_transaction(
+    dataservice_instance_t* inst, vccert_parser_options_t* parser_options,
+    MDB_txn* txn, const uint8_t* txn_cert, size_t txn_cert_size);
+static int dataservice_artifact_watch_notify(
+    dataservice_instance_t* inst, const data_artifact_record_t* record);
+static bool dummy_txn_resolver(
+    void* options, void* parser, const uint8_t* artifact_id,
+    const uint8_t* txn_id, vccrypt_buffer_t* output_buffer, bool* trusted);
+static int32_t dummy_artifact_state_resolver(
+    void* options, void* parser, const uint8_t* artifact_id,
+    vccrypt_buffer_t* txn_id);
+static bool dummy_entity_key_resolver(
+    void* options, void* parser, uint64_t height, const uint8_t* entity_id,
+    vccrypt_buffer_t* pubenckey_buffer, vccrypt_buffer_t* pubsignkey_buffer);
+static vccert_contract_fn_t dummy_contract_resolver(
+    void* options, void* parser, const uint8_t* type_id,
+    const uint8_t* artifact_id);
+
+/* the key of the end sentry. */
+static const uint8_t ff_uuid[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+/**
+ * \brief Notify watching child contexts of artifacts updated by the blocks
+ * committed after the given block, up to and including the latest block.
+ *
+ * Each new block is read from the database and the artifact of each of its
+ * transactions is looked up in the watch index, so the cost of a check
+ * depends on the size of the new blocks and not on the number of watches.
+ * Only the final update of an artifact is notified, so an artifact updated
+ * several times since the last check is notified once.  If the check is
+ * incomplete, some artifacts may already have been notified, and are notified
+ * again when the check is retried.
+ *
+ * \param inst          The data service instance.
+ * \param prev_block_id The latest block at the last check.
+ * \param block_id      The latest block now.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success, including when there is nothing to
+ *        notify.
+ *      - AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE if the new
+ *        blocks could not all be read, in which case the check should be
+ *        tried again over the same blocks.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+int dataservice_artifact_watch_check(
+    dataservice_instance_t* inst, const uint8_t* prev_block_id,
+    const uint8_t* block_id)
+{
+    int retval;
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t crypto_suite;
+    vccert_parser_options_t parser_options;
+    MDB_txn* txn = NULL;
+    uint8_t next[16];
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != prev_block_id);
+    MODEL_ASSERT(NULL != block_id);
+
+    /* the database is only open once the root context has been created. */
+    dataservice_database_details_t* details =
+        (dataservice_database_details_t*)inst->ctx.details;
+    if (NULL == details)
+    {
+        return AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+    }
+
+    /* set up a parser for the blocks.  Failures here leave the check
+     * incomplete, so the caller tries it again over the same blocks. */
+    malloc_allocator_options_init(&alloc_opts);
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_options_init(
+            &crypto_suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+        goto dispose_alloc_opts;
+    }
+
+    if (VCCERT_STATUS_SUCCESS !=
+        vccert_parser_options_init(
+            &parser_options, &alloc_opts, &crypto_suite, &dummy_txn_resolver,
+            &dummy_artifact_state_resolver, &dummy_contract_resolver,
+            &dummy_entity_key_resolver, NULL))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+        goto dispose_crypto_suite;
+    }
+
+    /* begin a read transaction, which sees blocks committed by any process
+     * sharing this database. */
+    if (0 != mdb_txn_begin(details->env, NULL, MDB_RDONLY, &txn))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+        goto dispose_parser_options;
+    }
+
+    /* the first block follows the start sentry, whose key is all zeroes. */
+    if (!memcmp(prev_block_id, vccert_certificate_type_uuid_root_block, 16))
+    {
+        memset(next, 0, sizeof(next));
+    }
+    else
+    {
+        memcpy(next, prev_block_id, sizeof(next));
+    }
+
+    /* walk forward from the previous block to the latest block. */
+    while (memcmp(next, block_id, 16))
+    {
+        MDB_val lkey;
+        lkey.mv_size = sizeof(next);
+        lkey.mv_data = next;
+        MDB_val lval;
+        memset(&lval, 0, sizeof(lval));
+
+        /* a missing link ends the walk early. */
+        if (0 != mdb_get(txn, details->block_db, &lkey, &lval)
+         || lval.mv_size < sizeof(data_block_node_t))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+            goto transaction_abort;
+        }
+
+        const data_block_node_t* node = (const data_block_node_t*)lval.mv_data;
+        memcpy(next, node->next, sizeof(next));
+
+        /* read the next block, unless we've run off the end. */
+        lkey.mv_data = next;
+        memset(&lval, 0, sizeof(lval));
+        if (!memcmp(next, ff_uuid, 16)
+         || 0 != mdb_get(txn, details->block_db, &lkey, &lval)
+         || lval.mv_size < sizeof(data_block_node_t))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+            goto transaction_abort;
+        }
+
+        node = (const data_block_node_t*)lval.mv_data;
+        if (lval.mv_size !=
+                sizeof(data_block_node_t) + ntohll(node->net_block_cert_size))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE;
+            goto transaction_abort;
+        }
+
+        /* notify watchers of the artifacts in this block. */
+        retval =
+            dataservice_artifact_watch_check_block(
+                inst, &parser_options, txn, node);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto transaction_abort;
+        }
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+transaction_abort:
+    mdb_txn_abort(txn);
+
+dispose_parser_options:
+    dispose((disposable_t*)&parser_options);
+
+dispose_crypto_suite:
+    dispose((disposable_t*)&crypto_suite);
+
+dispose_alloc_opts:
+    dispose((disposable_t*)&alloc_opts);
+
+    return retval;
+}
+
+/**
+ * \brief Notify watchers of the artifacts updated by a block.
+ *
+ * \param inst              The data service instance.
+ * \param parser_options    The options for parsing certificates.
+ * \param txn               The transaction under which reads are done.
+ * \param node              The block node, followed by its certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success, including when the block can't be
+ *        parsed.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+static int dataservice_artifact_watch_check_block(
+    dataservice_instance_t* inst, vccert_parser_options_t* parser_options,
+    MDB_txn* txn, const data_block_node_t* node)
+{
+    int retval = AGENTD_STATUS_SUCCESS;
+    vccert_parser_context_t parser;
+    const uint8_t* wrapped_txn = NULL;
+    size_t wrapped_txn_size = 0U;
+
+    /* create a parser for this block. */
+    if (VCCERT_STATUS_SUCCESS !=
+        vccert_parser_init(
+            parser_options, &parser, (const uint8_t*)(node + 1),
+            ntohll(node->net_block_cert_size)))
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* check each wrapped transaction. */
+    if (VCCERT_STATUS_SUCCESS !=
+        vccert_parser_find_short(
+            &parser, VCCERT_FIELD_TYPE_WRAPPED_TRANSACTION_TUPLE,
+            &wrapped_txn, &wrapped_txn_size))
+    {
+        wrapped_txn = NULL;
+    }
+
+    while (NULL != wrapped_txn)
+    {
+        retval =
+            dataservice_artifact_watch_check_transaction(
+                inst, parser_options, txn, wrapped_txn, wrapped_txn_size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto dispose_parser;
+        }
+
+        if (VCCERT_STATUS_SUCCESS !=
+            vccert_parser_find_next(&parser, &wrapped_txn, &wrapped_txn_size))
+        {
+            wrapped_txn = NULL;
+        }
+    }
+
+dispose_parser:
+    dispose((disposable_t*)&parser);
+
+    return retval;
+}
+
+/**
+ * \brief Notify watchers of the artifact updated by a transaction, if this
+ * transaction is still the artifact's latest.
+ *
+ * \param inst              The data service instance.
+ * \param parser_options    The options for parsing certificates.
+ * \param txn               The transaction under which reads are done.
+ * \param txn_cert          The certificate for this transaction.
+ * \param txn_cert_size     The size of the transaction certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success, including when the transaction
+ *        can't be parsed.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+static int dataservice_artifact_watch_check_transaction(
+    dataservice_instance_t* inst, vccert_parser_options_t* parser_options,
+    MDB_txn* txn, const uint8_t* txn_cert, size_t txn_cert_size)
+{
+    int retval = AGENTD_STATUS_SUCCESS;
+    vccert_parser_context_t parser;
+    const uint8_t* transaction_id = NULL;
+    size_t transaction_id_size = 0U;
+    const uint8_t* artifact_id = NULL;
+    size_t artifact_id_size = 0U;
+    data_artifact_record_t record;
+
+    /* create a parser for this transaction. */
+    if (VCCERT_STATUS_SUCCESS !=
+        vccert_parser_init(parser_options, &parser, txn_cert, txn_cert_size))
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* get the transaction and artifact ids. */
+    if (VCCERT_STATUS_SUCCESS !=
+            vccert_parser_find_short(
+                &parser, VCCERT_FIELD_TYPE_CERTIFICATE_ID, &transaction_id,
+                &transaction_id_size)
+     || 16 != transaction_id_size
+     || VCCERT_STATUS_SUCCESS !=
+            vccert_parser_find_short(
+                &parser, VCCERT_FIELD_TYPE_ARTIFACT_ID, &artifact_id,
+                &artifact_id_size)
+     || 16 != artifact_id_size)
+    {
+        goto dispose_parser;
+    }
+
+    /* is anyone watching this artifact? */
+    bool watched = false;
+    for (dataservice_artifact_watch_t* watch =
+            *dataservice_artifact_watch_bucket(inst, artifact_id);
+         NULL != watch; watch = watch->bucket_next)
+    {
+        if (!memcmp(watch->artifact_id, artifact_id, 16))
+        {
+            watched = true;
+            break;
+        }
+    }
+
+    if (!watched)
+    {
+        goto dispose_parser;
+    }
+
+    /* read the artifact record. */
+    dataservice_database_details_t* details =
+        (dataservice_database_details_t*)inst->ctx.details;
+    MDB_val lkey;
+    lkey.mv_size = 16;
+    lkey.mv_data = (uint8_t*)artifact_id;
+    MDB_val lval;
+    memset(&lval, 0, sizeof(lval));
+    if (0 != mdb_get(txn, details->artifact_db, &lkey, &lval)
+     || sizeof(data_artifact_record_t) != lval.mv_size)
+    {
+        goto dispose_parser;
+    }
+
+    memcpy(&record, lval.mv_data, sizeof(record));
+
+    /* a later transaction for this artifact is notified instead. */
+    if (memcmp(record.txn_latest, transaction_id, 16))
+    {
+        goto dispose_parser;
+    }
+
+    retval = dataservice_artifact_watch_notify(inst, &record);
+
+dispose_parser:
+    dispose((disposable_t*)&parser);
+
+    return retval;
+}
+
+/**
+ * \brief Notify each child context watching an artifact of its update.
+ *
+ * \param inst              The data service instance.
+ * \param record            The updated artifact record.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+static int dataservice_artifact_watch_notify(
+    dataservice_instance_t* inst, const data_artifact_record_t* record)
+{
+    int retval;
+    void* payload = NULL;
+    size_t payload_size = 0U;
+
+    /* encode the notification payload once for all watchers. */
+    retval =
+        dataservice_encode_response_artifact_notify(
+            &payload, &payload_size, record);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* notify each child context watching this artifact. */
+    for (dataservice_artifact_watch_t* watch =
+            *dataservice_artifact_watch_bucket(inst, record->key);
+         NULL != watch; watch = watch->bucket_next)
+    {
+        if (memcmp(watch->artifact_id, record->key, 16))
+        {
+            continue;
+        }
+
+        retval =
+            dataservice_decode_and_dispatch_write_status(
+                inst->sock, DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE,
+                watch->child_index, AGENTD_STATUS_SUCCESS, payload,
+                payload_size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_payload;
+        }
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_payload:
+    memset(payload, 0, payload_size);
+    free(payload);
+
+    return retval;
+}
+
+/**
+ * Dummy transaction resolver.
+ */
+static bool dummy_txn_resolver(
+    void* UNUSED(options), void* UNUSED(parser),
+    const uint8_t* UNUSED(artifact_id), const uint8_t* UNUSED(txn_id),
+    vccrypt_buffer_t* UNUSED(output_buffer), bool* UNUSED(trusted))
+{
+    return false;
+}
+
+/**
+ * Dummy artifact state resolver.
+ */
+static int32_t dummy_artifact_state_resolver(
+    void* UNUSED(options), void* UNUSED(parser),
+    const uint8_t* UNUSED(artifact_id), vccrypt_buffer_t* UNUSED(txn_id))
+{
+    return -1;
+}
+
+/**
+ * Dummy entity key resolver.
+ */
+static bool dummy_entity_key_resolver(
+    void* UNUSED(options), void* UNUSED(parser), uint64_t UNUSED(height),
+    const uint8_t* UNUSED(entity_id),
+    vccrypt_buffer_t* UNUSED(pubenckey_buffer),
+    vccrypt_buffer_t* UNUSED(pubsignkey_buffer))
+{
+    return false;
+}
+
+/**
+ * Dummy contract resolver.
+ */
+static vccert_contract_fn_t dummy_contract_resolver(
+    void* UNUSED(options), void* UNUSED(parser), const uint8_t* UNUSED(type_id),
+    const uint8_t* UNUSED(artifact_id))
+{
+    return NULL;
+}
@@ -0,0 +1,48 @@
+/**
+ * \file dataservice/dataservice_artifact_watch_index_dispose.c
+ *
+ * \brief Release the watch index.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Release the watch index, along with every watch in it.
+ *
+ * \param inst          The data service instance.
+ */
+void dataservice_artifact_watch_index_dispose(dataservice_instance_t* inst)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != inst);
+
+    for (size_t i = 0; i < inst->artifact_watch_bucket_count; ++i)
+    {
+        dataservice_artifact_watch_t* watch = inst->artifact_watch_buckets[i];
+        while (NULL != watch)
+        {
+            dataservice_artifact_watch_t* next = watch->bucket_next;
+
+            /* the child context no longer holds this watch. */
+            dataservice_child_details_t* child =
+                &inst->children[watch->child_index];
+            child->artifact_watches = NULL;
+            child->artifact_watch_count = 0U;
+
+            memset(watch, 0, sizeof(dataservice_artifact_watch_t));
+            free(watch);
+            watch = next;
+        }
+    }
+
+    free(inst->artifact_watch_buckets);
+    inst->artifact_watch_buckets = NULL;
+    inst->artifact_watch_bucket_count = 0U;
+    inst->artifact_watch_count = 0U;
+}
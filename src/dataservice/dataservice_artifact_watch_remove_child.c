@@ -0,0 +1,53 @@
+/**
+ * \file dataservice/dataservice_artifact_watch_remove_child.c
+ *
+ * \brief Remove every artifact watch held by a child context.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Remove every artifact watch held by a child context.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context.
+ */
+void dataservice_artifact_watch_remove_child(
+    dataservice_instance_t* inst, uint32_t offset)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(offset < DATASERVICE_MAX_CHILD_CONTEXTS);
+
+    dataservice_child_details_t* child = &inst->children[offset];
+    dataservice_artifact_watch_t* watch = child->artifact_watches;
+
+    while (NULL != watch)
+    {
+        dataservice_artifact_watch_t* next = watch->child_next;
+
+        /* unlink this watch from its bucket. */
+        dataservice_artifact_watch_t** link =
+            dataservice_artifact_watch_bucket(inst, watch->artifact_id);
+        while (watch != *link)
+        {
+            link = &(*link)->bucket_next;
+        }
+
+        *link = watch->bucket_next;
+        --inst->artifact_watch_count;
+
+        memset(watch, 0, sizeof(dataservice_artifact_watch_t));
+        free(watch);
+        watch = next;
+    }
+
+    child->artifact_watches = NULL;
+    child->artifact_watch_count = 0U;
+}
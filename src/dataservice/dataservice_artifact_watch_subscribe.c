@@ -0,0 +1,121 @@
+/**
+ * \file dataservice/dataservice_artifact_watch_subscribe.c
+ *
+ * \brief Watch a set of artifacts on behalf of a child context.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Watch a set of artifacts on behalf of a child context.
+ *
+ * Watches are added to the watch index until the child context is closed.  If
+ * adding a watch fails, the watches already added by this call are kept.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context.
+ * \param artifact_ids  The artifact UUIDs to watch, 16 bytes each.
+ * \param count         The number of artifact UUIDs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_BAD_INDEX if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_INVALID if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this child context is not
+ *        authorized to read artifacts.
+ *      - AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT if this would exceed
+ *        the number of artifacts that a child context can watch.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_latest_get().
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_timer_arm().
+ */
+int dataservice_artifact_watch_subscribe(
+    dataservice_instance_t* inst, uint32_t offset,
+    const uint8_t* artifact_ids, size_t count)
+{
+    int retval;
+    dataservice_child_context_t* ctx = NULL;
+    uint8_t block_id[16];
+    uint64_t height;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != artifact_ids || 0U == count);
+
+    /* look up the child context. */
+    retval = dataservice_child_context_lookup(&ctx, inst, offset);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* a watcher learns of artifact updates, so it must be able to read
+     * artifacts. */
+    if (!BITCAP_ISSET(ctx->childcaps, DATASERVICE_API_CAP_APP_ARTIFACT_READ))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED;
+        goto done;
+    }
+
+    /* enforce the per-child limit. */
+    dataservice_child_details_t* child = &inst->children[offset];
+    if (count > DATASERVICE_ARTIFACT_WATCH_MAX_PER_CHILD
+     || child->artifact_watch_count >
+            DATASERVICE_ARTIFACT_WATCH_MAX_PER_CHILD - count)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT;
+        goto done;
+    }
+
+    /* the first watch starts from the latest block.  Otherwise, bring the
+     * existing watchers up to date first, so that these watches aren't
+     * notified of updates that came before them. */
+    if (0U == inst->block_notify_count && 0U == inst->artifact_watch_count)
+    {
+        retval = dataservice_block_notify_latest_get(inst, block_id, &height);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+
+        memcpy(inst->block_notify_latest, block_id, 16);
+    }
+    else
+    {
+        retval = dataservice_block_notify_check(inst);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
+    /* add each watch. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        retval =
+            dataservice_artifact_watch_add(
+                inst, offset, artifact_ids + 16 * i);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
+    /* watch for new blocks. */
+    retval = dataservice_block_notify_timer_arm(inst);
+
+done:
+    return retval;
+}
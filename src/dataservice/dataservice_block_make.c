@@ -10,6 +10,8 @@
 #include <agentd/inet.h>
 #include <agentd/status_codes.h>
 #include <cbmc/model_assert.h>
+#include <stdbool.h>
+#include <stdlib.h>
 #include <vccert/certificate_types.h>
 #include <vccert/fields.h>
 #include <vccert/parser.h>
@@ -32,6 +34,47 @@ static uint8_t ff_uuid[16] = {
     0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
 };
 
+/**
+ * \brief Artifact records updated by a block.
+ *
+ * Each artifact touched by a block is read from the database at most once and
+ * written at most once, no matter how many transactions in the block update
+ * it.  Records are appended in the order that their artifacts are first seen,
+ * and found through an open addressed hash index of record positions.  The
+ * index is never more than half full, so that probes stay short.  The records
+ * are sorted by artifact id once, just before they are written.
+ */
+typedef struct artifact_table
+{
+    data_artifact_record_t* records;
+    size_t count;
+    size_t capacity;
+    size_t* slots;
+    size_t slot_count;
+} artifact_table_t;
+
+/**
+ * \brief A transaction node to be written to the transaction database.
+ */
+typedef struct block_txn_entry
+{
+    data_transaction_node_t node;
+    const uint8_t* cert;
+    size_t order;
+    bool prev_in_block;
+} block_txn_entry_t;
+
+/**
+ * \brief The transactions in a block, collected before any of them are
+ * written so that the writes can be applied in key order.
+ */
+typedef struct block_txn_table
+{
+    block_txn_entry_t* entries;
+    size_t count;
+    size_t capacity;
+} block_txn_table_t;
+
 /* forward decls for parser callbacks. */
 static bool dummy_txn_resolver(
     void* options, void* parser, const uint8_t* artifact_id,
@@ -73,20 +116,36 @@ static int dataservice_block_make_update_end(
     MDB_dbi block_db, MDB_txn* txn, const uint8_t* block_id, uint64_t height,
     const data_block_node_t* curr_end);
 static int dataservice_block_make_update_artifact(
-    MDB_dbi artifact_db, MDB_txn* txn, const uint8_t* artifact_id,
-    const uint8_t* transaction_id, uint64_t height, uint32_t state);
+    artifact_table_t* artifacts, MDB_dbi artifact_db, MDB_txn* txn,
+    const uint8_t* artifact_id, const uint8_t* transaction_id,
+    uint64_t height, uint32_t state);
+static int dataservice_block_make_flush_artifacts(
+    artifact_table_t* artifacts, MDB_dbi artifact_db, MDB_txn* txn);
+static size_t* artifact_table_probe(
+    const artifact_table_t* artifacts, const uint8_t* artifact_id);
+static int artifact_table_reserve(artifact_table_t* artifacts);
+static int artifact_record_compare_key(const void* lhs, const void* rhs);
+static void artifact_table_dispose(artifact_table_t* artifacts);
 static int dataservice_make_block_get_first_transaction_id(
     vccert_parser_options_t* parser_options,
     const uint8_t* txn_cert, size_t txn_cert_size,
     uint8_t* first_child_txn_id);
 static int dataservice_block_make_process_child(
-    dataservice_child_context_t* child,
-    vccert_parser_options_t* parser_options, MDB_dbi txn_db,
-    MDB_dbi artifact_db, MDB_txn* txn, uint64_t height,
-    const uint8_t* block_id, const uint8_t* txn_cert, size_t txn_cert_size);
-static int dataservice_block_make_update_prev_txn(
-    MDB_dbi txn_db, MDB_txn* txn, const uint8_t* txn_id,
-    const uint8_t* next_txn_id);
+    vccert_parser_options_t* parser_options, block_txn_table_t* txns,
+    artifact_table_t* artifacts, MDB_dbi artifact_db, MDB_txn* txn,
+    uint64_t height, const uint8_t* block_id, const uint8_t* txn_cert,
+    size_t txn_cert_size);
+static int dataservice_block_make_link_transactions(block_txn_table_t* txns);
+static int dataservice_block_make_drop_transactions(
+    dataservice_child_context_t* child, MDB_txn* txn,
+    const block_txn_table_t* txns);
+static int dataservice_block_make_insert_transactions(
+    MDB_dbi txn_db, MDB_txn* txn, const block_txn_table_t* txns);
+static int dataservice_block_make_update_prev_txns(
+    MDB_dbi txn_db, MDB_txn* txn, const block_txn_table_t* txns);
+static int block_txn_entry_compare_key(const void* lhs, const void* rhs);
+static int block_txn_entry_compare_prev(const void* lhs, const void* rhs);
+static void block_txn_table_dispose(block_txn_table_t* txns);
 static int dataservice_make_block_insert_block(
     MDB_dbi block_db, MDB_dbi height_db, MDB_txn* txn, const uint8_t* block_id,
     const uint8_t* block_prev_id, const uint8_t* first_child_txn_id,
@@ -156,6 +215,8 @@ static int dataservice_make_block_insert_block(
  *        missing its state field.
  *      - AGENTD_ERROR_DATASERVICE_INVALID_ARTIFACT_NODE_SIZE if an invalid
  *        artifact node was encountered.
+ *      - AGENTD_ERROR_DATASERVICE_BLOCK_TRANSACTION_OUT_OF_ORDER if a child
+ *        transaction appears in this block before its predecessor.
  */
 int dataservice_block_make(
     dataservice_child_context_t* child,
@@ -172,6 +233,9 @@ int dataservice_block_make(
     uint64_t expected_block_height;
     const uint8_t* block_prev_uuid;
     const data_block_node_t* end_node = NULL;
+    data_block_node_t end_node_copy;
+    artifact_table_t artifacts;
+    block_txn_table_t txns;
 
     /* parameter sanity check. */
     MODEL_ASSERT(NULL != child);
@@ -218,6 +282,10 @@ int dataservice_block_make(
         goto dispose_parser_options;
     }
 
+    /* start with empty artifact and transaction tables. */
+    memset(&artifacts, 0, sizeof(artifacts));
+    memset(&txns, 0, sizeof(txns));
+
     /* create the child transaction. */
     retval = dataservice_create_child_trasaction(details->env, dtxn_ctx, &txn);
     if (AGENTD_STATUS_SUCCESS != retval)
@@ -233,6 +301,13 @@ int dataservice_block_make(
         goto maybe_transaction_abort;
     }
 
+    /* copy the end node, since the writes below invalidate it. */
+    if (NULL != end_node)
+    {
+        memcpy(&end_node_copy, end_node, sizeof(end_node_copy));
+        end_node = &end_node_copy;
+    }
+
     /* verify the block height constraint. */
     retval = constraint_matching_block_height(
         &parser, end_node, &expected_block_height);
@@ -319,14 +394,13 @@ int dataservice_block_make(
         }
     }
 
-    /* iterate through each wrapped transaction. */
+    /* collect each wrapped transaction. */
     while (NULL != wrapped_transaction_raw)
     {
         /* process this transaction. */
         retval = dataservice_block_make_process_child(
-            child, &parser_options, details->txn_db,
-            details->artifact_db, txn, expected_block_height,
-            block_id, wrapped_transaction_raw,
+            &parser_options, &txns, &artifacts, details->artifact_db, txn,
+            expected_block_height, block_id, wrapped_transaction_raw,
             wrapped_transaction_raw_size);
         if (AGENTD_STATUS_SUCCESS != retval)
         {
@@ -340,6 +414,44 @@ int dataservice_block_make(
         }
     }
 
+    /* link transactions in this block to their predecessors. */
+    retval = dataservice_block_make_link_transactions(&txns);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+
+    /* drop these transactions from the transaction queue. */
+    retval = dataservice_block_make_drop_transactions(child, txn, &txns);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+
+    /* insert these transactions into the transaction database. */
+    retval = dataservice_block_make_insert_transactions(
+        details->txn_db, txn, &txns);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+
+    /* point predecessors from earlier blocks at these transactions. */
+    retval = dataservice_block_make_update_prev_txns(
+        details->txn_db, txn, &txns);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+
+    /* write each updated artifact record once. */
+    retval = dataservice_block_make_flush_artifacts(
+        &artifacts, details->artifact_db, txn);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+
     /* commit transaction. */
     mdb_txn_commit(txn);
     txn = NULL;
@@ -353,6 +465,9 @@ maybe_transaction_abort:
         mdb_txn_abort(txn);
     }
 
+    artifact_table_dispose(&artifacts);
+    block_txn_table_dispose(&txns);
+
 dispose_parser_options:
     dispose((disposable_t*)&parser_options);
 
@@ -692,12 +807,12 @@ done:
 }
 
 /**
- * \brief Process a child transaction, updating the database.
+ * \brief Process a child transaction, collecting its database updates.
  *
- * \param child             The child context for the data service.
  * \param parser_options    The options for parsing certificates.
- * \param txn_db            The transaction database to update.
- * \param artifact_db       The artifact database to update.
+ * \param txns              The table of transactions in this block.
+ * \param artifacts         The table of artifact updates for this block.
+ * \param artifact_db       The artifact database to read.
  * \param txn               The transaction under which updates are done.
  * \param height            The height of the block to which this transaction
  *                          belongs.
@@ -708,16 +823,10 @@ done:
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
- *        be found.
  *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
  *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
  *        read from the database.
- *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
- *        update the database.
- *      - AGENTD_ERROR_DATASERVICE_MDB_DEL_FAILURE if this function failed to
- *        delete from the database.
  *      - AGENTD_ERROR_DATASERVICE_VCCERT_PARSER_INIT_FAILURE if this
  *        function failed to initialize a parser.
  *      - AGENTD_ERROR_DATASERVICE_MISSING_CHILD_TRANSACTION_UUID if a child
@@ -732,10 +841,10 @@ done:
  *        artifact node was encountered.
  */
 static int dataservice_block_make_process_child(
-    dataservice_child_context_t* child,
-    vccert_parser_options_t* parser_options, MDB_dbi txn_db,
-    MDB_dbi artifact_db, MDB_txn* txn, uint64_t height,
-    const uint8_t* block_id, const uint8_t* txn_cert, size_t txn_cert_size)
+    vccert_parser_options_t* parser_options, block_txn_table_t* txns,
+    artifact_table_t* artifacts, MDB_dbi artifact_db, MDB_txn* txn,
+    uint64_t height, const uint8_t* block_id, const uint8_t* txn_cert,
+    size_t txn_cert_size)
 {
     int retval = 0;
     vccert_parser_context_t parser;
@@ -793,18 +902,28 @@ static int dataservice_block_make_process_child(
     memcpy(&net_state, state_raw, sizeof(uint32_t));
     uint32_t state = ntohl(net_state);
 
-    /* allocate memory for the transaction node. */
-    size_t txn_rec_size = sizeof(data_transaction_node_t) + txn_cert_size;
-    uint8_t* txn_rec_data = (uint8_t*)malloc(txn_rec_size);
-    if (NULL == txn_rec_data)
+    /* grow the transaction table if it is full. */
+    if (txns->count == txns->capacity)
     {
-        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-        goto dispose_parser;
+        size_t new_capacity =
+            (0 == txns->capacity) ? 16 : 2 * txns->capacity;
+        block_txn_entry_t* new_entries =
+            (block_txn_entry_t*)realloc(
+                txns->entries, new_capacity * sizeof(block_txn_entry_t));
+        if (NULL == new_entries)
+        {
+            retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto dispose_parser;
+        }
+
+        txns->entries = new_entries;
+        txns->capacity = new_capacity;
     }
 
     /* set up transaction node data. */
-    memset(txn_rec_data, 0, txn_rec_size);
-    data_transaction_node_t* txn_rec = (data_transaction_node_t*)txn_rec_data;
+    block_txn_entry_t* entry = txns->entries + txns->count;
+    memset(entry, 0, sizeof(block_txn_entry_t));
+    data_transaction_node_t* txn_rec = &entry->node;
     memcpy(txn_rec->key, transaction_id, sizeof(txn_rec->key));
     memcpy(txn_rec->prev, prev_transaction_id, sizeof(txn_rec->prev));
     memcpy(txn_rec->next, ff_uuid, sizeof(txn_rec->next));
@@ -813,62 +932,24 @@ static int dataservice_block_make_process_child(
     txn_rec->net_txn_cert_size = htonll(txn_cert_size);
     txn_rec->net_txn_state =
         htonl(DATASERVICE_TRANSACTION_NODE_STATE_CANONIZED);
-    memcpy(txn_rec_data + sizeof(data_transaction_node_t),
-        txn_cert, txn_cert_size);
-
-    /* insert the transaction id into the transaction database. */
-    MDB_val lkey;
-    lkey.mv_size = 16;
-    lkey.mv_data = (uint8_t*)transaction_id;
-    MDB_val lval;
-    lval.mv_size = txn_rec_size;
-    lval.mv_data = txn_rec_data;
-    if (0 != mdb_put(txn, txn_db, &lkey, &lval, MDB_NOOVERWRITE))
-    {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-        goto free_data;
-    }
-
-    /* set up database transaction context. */
-    dataservice_transaction_context_t dtxn_ctx;
-    dtxn_ctx.child = child;
-    dtxn_ctx.txn = txn;
-
-    /* drop the transaction from the transaction queue. */
-    retval = dataservice_transaction_drop_internal(
-        child, &dtxn_ctx, transaction_id);
-    if (AGENTD_STATUS_SUCCESS != retval)
-    {
-        goto free_data;
-    }
-
-    /* If there is a previous transaction, fix it up. */
-    if (crypto_memcmp(prev_transaction_id, zero_uuid, 16))
-    {
-        retval = dataservice_block_make_update_prev_txn(
-            txn_db, txn, prev_transaction_id, transaction_id);
-        if (AGENTD_STATUS_SUCCESS != retval)
-        {
-            goto free_data;
-        }
-    }
+    entry->cert = txn_cert;
+    entry->order = txns->count;
 
     /* insert / update the artifact. */
     retval = dataservice_block_make_update_artifact(
-        artifact_db, txn, artifact_id, transaction_id, height,
+        artifacts, artifact_db, txn, artifact_id, transaction_id, height,
         state);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
-        goto free_data;
+        goto dispose_parser;
     }
 
+    /* this transaction is now in the table. */
+    ++txns->count;
+
     /* success. */
     retval = AGENTD_STATUS_SUCCESS;
 
-free_data:
-    memset(txn_rec_data, 0, txn_rec_size);
-    free(txn_rec_data);
-
 dispose_parser:
     dispose((disposable_t*)&parser);
 
@@ -877,11 +958,16 @@ done:
 }
 
 /**
- * \brief Update the artifact database with the latest transaction for this
- * artifact.
+ * \brief Record the latest transaction for this artifact in the artifact
+ * table.
  *
- * \param artifact_db       The artifact database to update.
- * \param txn               The transaction under which updates are done.
+ * The first time an artifact is seen in this block, its record is read from
+ * the artifact database, or a new record is created.  Later updates in the
+ * same block only change the table entry.
+ *
+ * \param artifacts         The table of artifact updates for this block.
+ * \param artifact_db       The artifact database to read.
+ * \param txn               The transaction under which reads are done.
  * \param artifact_id       The artifact id to update.
  * \param transaction_id    The latest transaction changing this artifact.
  * \param height            The height of the block to which this transaction
@@ -890,24 +976,49 @@ done:
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
- *        update the database.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
+ *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
  *        read from the database.
  *      - AGENTD_ERROR_DATASERVICE_INVALID_ARTIFACT_NODE_SIZE if an invalid
  *        artifact node was encountered.
  */
 static int dataservice_block_make_update_artifact(
-    MDB_dbi artifact_db, MDB_txn* txn, const uint8_t* artifact_id,
-    const uint8_t* transaction_id, uint64_t height, uint32_t state)
+    artifact_table_t* artifacts, MDB_dbi artifact_db, MDB_txn* txn,
+    const uint8_t* artifact_id, const uint8_t* transaction_id,
+    uint64_t height, uint32_t state)
 {
-    data_artifact_record_t record;
+    data_artifact_record_t* record;
+    size_t* slot;
     int retval = 0;
 
+    MODEL_ASSERT(NULL != artifacts);
     MODEL_ASSERT(NULL != txn);
     MODEL_ASSERT(NULL != artifact_id);
     MODEL_ASSERT(NULL != transaction_id);
 
+    /* if this artifact was already updated in this block, update it again. */
+    slot = artifact_table_probe(artifacts, artifact_id);
+    if (NULL != slot && 0U != *slot)
+    {
+        record = artifacts->records + *slot - 1U;
+        goto update_latest;
+    }
+
+    /* make room for one more artifact. */
+    retval = artifact_table_reserve(artifacts);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the index may have been rebuilt, so find the empty slot again. */
+    slot = artifact_table_probe(artifacts, artifact_id);
+    MODEL_ASSERT(NULL != slot && 0U == *slot);
+
+    /* this artifact's record goes at the end of the table. */
+    record = artifacts->records + artifacts->count;
+
     /* query for the artifact. */
     MDB_val lkey;
     lkey.mv_size = 16;
@@ -916,76 +1027,451 @@ static int dataservice_block_make_update_artifact(
     memset(&lval, 0, sizeof(lval));
     retval = mdb_get(txn, artifact_db, &lkey, &lval);
 
-    /* if not found, insert an artifact record. */
+    /* if not found, create an artifact record. */
     if (MDB_NOTFOUND == retval)
     {
-        memset(&record, 0, sizeof(record));
-        memcpy(record.key, artifact_id, sizeof(record.key));
-        memcpy(record.txn_first, transaction_id, sizeof(record.txn_first));
-        memcpy(record.txn_latest, transaction_id, sizeof(record.txn_latest));
-        record.net_height_first = htonll(height);
-        record.net_height_latest = htonll(height);
-        record.net_state_latest = htonl(state);
+        memset(record, 0, sizeof(data_artifact_record_t));
+        memcpy(record->key, artifact_id, sizeof(record->key));
+        memcpy(record->txn_first, transaction_id, sizeof(record->txn_first));
+        record->net_height_first = htonll(height);
+    }
+    /* if found, start from the stored artifact record. */
+    else if (0 == retval && sizeof(data_artifact_record_t) == lval.mv_size)
+    {
+        memcpy(record, lval.mv_data, sizeof(data_artifact_record_t));
+    }
+    /* found, but the size is wrong. */
+    else if (0 == retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_INVALID_ARTIFACT_NODE_SIZE;
+        goto done;
+    }
+    /* an error occurred. */
+    else
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+        goto done;
+    }
+
+    /* this artifact is now in the table. */
+    ++artifacts->count;
+    *slot = artifacts->count;
+
+update_latest:
+    memcpy(record->txn_latest, transaction_id, sizeof(record->txn_latest));
+    record->net_height_latest = htonll(height);
+    record->net_state_latest = htonl(state);
 
-        /* insert this record. */
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Write each artifact record in the artifact table to the artifact
+ * database.
+ *
+ * The records are sorted by artifact id and written through a single cursor
+ * in key order.  The table can't be searched after it has been flushed.
+ *
+ * \param artifacts         The table of artifact updates for this block.
+ * \param artifact_db       The artifact database to update.
+ * \param txn               The transaction under which updates are done.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        update the database.
+ */
+static int dataservice_block_make_flush_artifacts(
+    artifact_table_t* artifacts, MDB_dbi artifact_db, MDB_txn* txn)
+{
+    int retval;
+    MDB_cursor* cursor;
+
+    MODEL_ASSERT(NULL != artifacts);
+    MODEL_ASSERT(NULL != txn);
+
+    /* sort the records by key. */
+    if (artifacts->count > 1)
+    {
+        qsort(
+            artifacts->records, artifacts->count,
+            sizeof(data_artifact_record_t), &artifact_record_compare_key);
+    }
+
+    /* open a cursor for these puts. */
+    if (0 != mdb_cursor_open(txn, artifact_db, &cursor))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
+        goto done;
+    }
+
+    /* these puts walk the database in key order. */
+    for (size_t i = 0; i < artifacts->count; ++i)
+    {
+        MDB_val lkey;
         lkey.mv_size = 16;
-        lkey.mv_data = record.key;
-        lval.mv_size = sizeof(record);
-        lval.mv_data = &record;
-        if (0 != mdb_put(txn, artifact_db, &lkey, &lval, MDB_NOOVERWRITE))
+        lkey.mv_data = artifacts->records[i].key;
+        MDB_val lval;
+        lval.mv_size = sizeof(data_artifact_record_t);
+        lval.mv_data = artifacts->records + i;
+        if (0 != mdb_cursor_put(cursor, &lkey, &lval, 0))
         {
             retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-            goto done;
+            goto close_cursor;
         }
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+close_cursor:
+    mdb_cursor_close(cursor);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Find the index slot for an artifact in the artifact table.
+ *
+ * Slots are probed linearly from the slot picked by a hash of the artifact id.
+ * A slot holds one more than the position of its record, or zero if it is
+ * empty.  Artifacts are never removed from the table, so the probe can stop at
+ * the first empty slot.
+ *
+ * \param artifacts         The table of artifact updates for this block.
+ * \param artifact_id       The artifact id to find.
+ *
+ * \returns the slot for this artifact, the empty slot where it would be added,
+ * or NULL if the table has no index yet.
+ */
+static size_t* artifact_table_probe(
+    const artifact_table_t* artifacts, const uint8_t* artifact_id)
+{
+    /* an empty table has no index. */
+    if (0U == artifacts->slot_count)
+    {
+        return NULL;
+    }
 
-        /* success. */
-        retval = AGENTD_STATUS_SUCCESS;
+    /* FNV-1a hash of the artifact id. */
+    uint64_t hash = 0xcbf29ce484222325UL;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        hash ^= artifact_id[i];
+        hash *= 0x00000100000001b3UL;
     }
-    /* if found, update the artifact record. */
-    else if (0 == retval && sizeof(record) == lval.mv_size)
+
+    /* the slot count is a power of two. */
+    const size_t mask = artifacts->slot_count - 1U;
+    size_t slot = (size_t)hash & mask;
+
+    /* probe until we find this artifact or an empty slot.  The index is
+     * never full, so this ends. */
+    for (;;)
     {
-        memcpy(&record, lval.mv_data, sizeof(record));
-        memcpy(record.txn_latest, transaction_id, sizeof(record.txn_latest));
-        record.net_height_latest = htonll(height);
-        record.net_state_latest = htonl(state);
+        size_t* entry = artifacts->slots + slot;
 
-        /* update this record. */
-        lkey.mv_size = 16;
-        lkey.mv_data = record.key;
-        lval.mv_size = sizeof(record);
-        lval.mv_data = &record;
-        if (0 != mdb_put(txn, artifact_db, &lkey, &lval, 0))
+        if (0U == *entry
+         || 0 == memcmp(
+                    artifacts->records[*entry - 1U].key, artifact_id, 16))
         {
-            retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-            goto done;
+            return entry;
         }
 
-        /* success. */
-        retval = AGENTD_STATUS_SUCCESS;
+        slot = (slot + 1U) & mask;
     }
-    /* found, but the size is wrong. */
-    else if (0 == retval && sizeof(record) != lval.mv_size)
+}
+
+/**
+ * \brief Make room in the artifact table for one more artifact.
+ *
+ * The record array doubles when it is full, and the index is rebuilt at twice
+ * the size when adding an artifact would make it more than half full.
+ *
+ * \param artifacts         The table of artifact updates for this block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
+ *        encountered during this operation.
+ */
+static int artifact_table_reserve(artifact_table_t* artifacts)
+{
+    /* grow the records if they are full. */
+    if (artifacts->count == artifacts->capacity)
     {
-        retval = AGENTD_ERROR_DATASERVICE_INVALID_ARTIFACT_NODE_SIZE;
+        size_t new_capacity =
+            (0 == artifacts->capacity) ? 16 : 2 * artifacts->capacity;
+        data_artifact_record_t* new_records =
+            (data_artifact_record_t*)realloc(
+                artifacts->records,
+                new_capacity * sizeof(data_artifact_record_t));
+        if (NULL == new_records)
+        {
+            return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        artifacts->records = new_records;
+        artifacts->capacity = new_capacity;
     }
-    /* an error occurred. */
-    else
+
+    /* the index is big enough if it stays at most half full. */
+    if (2U * (artifacts->count + 1U) <= artifacts->slot_count)
     {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* rebuild the index at twice the size. */
+    size_t old_slot_count = artifacts->slot_count;
+    size_t* old_slots = artifacts->slots;
+    size_t new_slot_count = (0U == old_slot_count) ? 32U : 2U * old_slot_count;
+    size_t* new_slots = (size_t*)calloc(new_slot_count, sizeof(size_t));
+    if (NULL == new_slots)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    artifacts->slots = new_slots;
+    artifacts->slot_count = new_slot_count;
+
+    for (size_t i = 0; i < artifacts->count; ++i)
+    {
+        *artifact_table_probe(artifacts, artifacts->records[i].key) = i + 1U;
+    }
+
+    free(old_slots);
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compare two artifact records by artifact id.
+ *
+ * \param lhs               The left-hand record.
+ * \param rhs               The right-hand record.
+ *
+ * \returns less than, equal to, or greater than zero if the left-hand key is
+ * less than, equal to, or greater than the right-hand key.
+ */
+static int artifact_record_compare_key(const void* lhs, const void* rhs)
+{
+    return
+        memcmp(
+            ((const data_artifact_record_t*)lhs)->key,
+            ((const data_artifact_record_t*)rhs)->key, 16);
+}
+
+/**
+ * \brief Release the memory held by the artifact table.
+ *
+ * \param artifacts         The table of artifact updates for this block.
+ */
+static void artifact_table_dispose(artifact_table_t* artifacts)
+{
+    if (NULL != artifacts->records)
+    {
+        memset(
+            artifacts->records, 0,
+            artifacts->capacity * sizeof(data_artifact_record_t));
+        free(artifacts->records);
+    }
+
+    free(artifacts->slots);
+
+    memset(artifacts, 0, sizeof(artifact_table_t));
+}
+
+/**
+ * \brief Link each transaction in this block to a predecessor in the same
+ * block.
+ *
+ * On return, the transaction table is sorted by transaction id.  Transactions
+ * whose predecessor is an earlier transaction in this block have their
+ * predecessor's next field set in the table, and are flagged so that their
+ * predecessor is not updated in the database.
+ *
+ * \param txns              The table of transactions in this block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_BLOCK_TRANSACTION_OUT_OF_ORDER if a
+ *        transaction's predecessor appears later in this block.
+ */
+static int dataservice_block_make_link_transactions(block_txn_table_t* txns)
+{
+    MODEL_ASSERT(NULL != txns);
+
+    /* sort the transactions by key. */
+    if (txns->count > 1)
+    {
+        qsort(
+            txns->entries, txns->count, sizeof(block_txn_entry_t),
+            &block_txn_entry_compare_key);
+    }
+
+    /* find each transaction's predecessor in this block. */
+    for (size_t i = 0; i < txns->count; ++i)
+    {
+        block_txn_entry_t* entry = txns->entries + i;
+        block_txn_entry_t* prev =
+            (block_txn_entry_t*)bsearch(
+                entry->node.prev, txns->entries, txns->count,
+                sizeof(block_txn_entry_t), &block_txn_entry_compare_key);
+
+        /* a predecessor in an earlier block is updated in the database. */
+        if (NULL == prev)
+        {
+            continue;
+        }
+
+        /* a predecessor must precede this transaction in the block. */
+        if (prev->order >= entry->order)
+        {
+            return AGENTD_ERROR_DATASERVICE_BLOCK_TRANSACTION_OUT_OF_ORDER;
+        }
+
+        /* link the predecessor to this transaction. */
+        memcpy(prev->node.next, entry->node.key, sizeof(prev->node.next));
+        entry->prev_in_block = true;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Drop each transaction in this block from the transaction queue.
+ *
+ * \param child             The child context for the data service.
+ * \param txn               The transaction under which updates are done.
+ * \param txns              The table of transactions in this block, sorted
+ *                          by transaction id.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if a transaction could not be
+ *        found in the transaction queue.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
+ *        read from the database.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        update the database.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_DEL_FAILURE if this function failed to
+ *        delete from the database.
+ */
+static int dataservice_block_make_drop_transactions(
+    dataservice_child_context_t* child, MDB_txn* txn,
+    const block_txn_table_t* txns)
+{
+    int retval;
+
+    MODEL_ASSERT(NULL != child);
+    MODEL_ASSERT(NULL != txn);
+    MODEL_ASSERT(NULL != txns);
+
+    /* set up database transaction context. */
+    dataservice_transaction_context_t dtxn_ctx;
+    dtxn_ctx.child = child;
+    dtxn_ctx.txn = txn;
+
+    /* drop each transaction in key order. */
+    for (size_t i = 0; i < txns->count; ++i)
+    {
+        retval = dataservice_transaction_drop_internal(
+            child, &dtxn_ctx, txns->entries[i].node.key);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Insert each transaction in this block into the transaction database.
+ *
+ * The transactions are inserted through a single cursor in key order, so that
+ * consecutive inserts that land on the same page avoid a search from the root
+ * of the tree.
+ *
+ * \param txn_db            The transaction database to update.
+ * \param txn               The transaction under which updates are done.
+ * \param txns              The table of transactions in this block, sorted
+ *                          by transaction id.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        update the database.
+ */
+static int dataservice_block_make_insert_transactions(
+    MDB_dbi txn_db, MDB_txn* txn, const block_txn_table_t* txns)
+{
+    int retval;
+    MDB_cursor* cursor;
+
+    MODEL_ASSERT(NULL != txn);
+    MODEL_ASSERT(NULL != txns);
+
+    /* open a cursor for these inserts. */
+    if (0 != mdb_cursor_open(txn, txn_db, &cursor))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
+        goto done;
     }
 
+    /* insert each transaction in key order. */
+    for (size_t i = 0; i < txns->count; ++i)
+    {
+        const block_txn_entry_t* entry = txns->entries + i;
+        size_t cert_size = ntohll(entry->node.net_txn_cert_size);
+
+        /* reserve space for this transaction node. */
+        MDB_val lkey;
+        lkey.mv_size = 16;
+        lkey.mv_data = (uint8_t*)entry->node.key;
+        MDB_val lval;
+        lval.mv_size = sizeof(data_transaction_node_t) + cert_size;
+        lval.mv_data = NULL;
+        if (0 != mdb_cursor_put(cursor, &lkey, &lval, MDB_NOOVERWRITE | MDB_RESERVE))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
+            goto close_cursor;
+        }
+
+        /* write the node directly into the reserved space. */
+        memcpy(lval.mv_data, &entry->node, sizeof(data_transaction_node_t));
+        memcpy(
+            ((uint8_t*)lval.mv_data) + sizeof(data_transaction_node_t),
+            entry->cert, cert_size);
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+close_cursor:
+    mdb_cursor_close(cursor);
+
 done:
     return retval;
 }
 
 /**
- * \brief Update the previous transaction associatiated with an artifact.
+ * \brief Update the next field of each predecessor from an earlier block.
+ *
+ * The predecessors are visited through a single cursor in key order, and each
+ * one is rewritten under that cursor.
  *
  * \param txn_db            The transaction database to update.
  * \param txn               The database transaction under which this update is
  *                          performed.
- * \param txn_id            The transaction id to update.
- * \param next_txn_id       The next transaction id.
+ * \param txns              The table of transactions in this block.
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
@@ -996,63 +1482,155 @@ done:
  *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
  *        write to the database.
  */
-static int dataservice_block_make_update_prev_txn(
-    MDB_dbi txn_db, MDB_txn* txn, const uint8_t* txn_id,
-    const uint8_t* next_txn_id)
+static int dataservice_block_make_update_prev_txns(
+    MDB_dbi txn_db, MDB_txn* txn, const block_txn_table_t* txns)
 {
-    int retval = 0;
+    int retval;
+    const block_txn_entry_t** updates;
+    size_t update_count = 0U;
+    MDB_cursor* cursor;
+
     MODEL_ASSERT(NULL != txn);
-    MODEL_ASSERT(NULL != txn_id);
-    MODEL_ASSERT(NULL != next_txn_id);
+    MODEL_ASSERT(NULL != txns);
 
-    /* query the previous transaction id. */
-    MDB_val lkey;
-    lkey.mv_size = 16;
-    lkey.mv_data = (uint8_t*)txn_id;
-    MDB_val lval;
-    memset(&lval, 0, sizeof(lval));
-    if (0 != mdb_get(txn, txn_db, &lkey, &lval) || lval.mv_size < sizeof(data_transaction_node_t))
+    /* allocate space for the list of predecessor updates. */
+    updates =
+        (const block_txn_entry_t**)malloc(
+            (txns->count + 1) * sizeof(const block_txn_entry_t*));
+    if (NULL == updates)
     {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
         goto done;
     }
 
-    /* allocate memory for the updated record. */
-    data_transaction_node_t* rec =
-        (data_transaction_node_t*)malloc(lval.mv_size);
-    if (NULL == rec)
+    /* collect the transactions with a predecessor in an earlier block. */
+    for (size_t i = 0; i < txns->count; ++i)
     {
-        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-        goto done;
+        const block_txn_entry_t* entry = txns->entries + i;
+        if (!entry->prev_in_block
+         && crypto_memcmp(entry->node.prev, zero_uuid, 16))
+        {
+            updates[update_count++] = entry;
+        }
     }
 
-    /* copy the record. */
-    memcpy(rec, lval.mv_data, lval.mv_size);
+    /* sort these updates by predecessor id. */
+    if (update_count > 1)
+    {
+        qsort(
+            updates, update_count, sizeof(const block_txn_entry_t*),
+            &block_txn_entry_compare_prev);
+    }
 
-    /* update the next value. */
-    memcpy(rec->next, next_txn_id, sizeof(rec->next));
+    /* open a cursor for these updates. */
+    if (0 != mdb_cursor_open(txn, txn_db, &cursor))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+        goto free_updates;
+    }
 
-    /* update the record in the database. */
-    lkey.mv_size = 16;
-    lkey.mv_data = (uint8_t*)txn_id;
-    lval.mv_data = rec; /* size remains the same. */
-    if (0 != mdb_put(txn, txn_db, &lkey, &lval, 0))
+    /* update each predecessor in key order. */
+    for (size_t i = 0; i < update_count; ++i)
     {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-        goto free_rec;
+        /* position the cursor on the previous transaction. */
+        MDB_val lkey;
+        lkey.mv_size = 16;
+        lkey.mv_data = (uint8_t*)updates[i]->node.prev;
+        MDB_val lval;
+        memset(&lval, 0, sizeof(lval));
+        if (0 != mdb_cursor_get(cursor, &lkey, &lval, MDB_SET_KEY)
+         || lval.mv_size < sizeof(data_transaction_node_t))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+            goto close_cursor;
+        }
+
+        /* update the next value. */
+        data_transaction_node_t rec;
+        memcpy(&rec, lval.mv_data, sizeof(rec));
+        memcpy(rec.next, updates[i]->node.key, sizeof(rec.next));
+
+        /* update the record in the database. */
+        retval =
+            dataservice_transaction_node_header_cursor_put(
+                cursor, updates[i]->node.prev, &lval, &rec);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto close_cursor;
+        }
     }
 
     /* success. */
     retval = AGENTD_STATUS_SUCCESS;
 
-free_rec:
-    memset(rec, 0, lval.mv_size);
-    free(rec);
+close_cursor:
+    mdb_cursor_close(cursor);
+
+free_updates:
+    free(updates);
 
 done:
     return retval;
 }
 
+/**
+ * \brief Compare the keys of two transaction table entries.
+ *
+ * The key is the first field of each entry, so this comparison also works for
+ * a bare transaction id on the left hand side.
+ *
+ * \param lhs               The left hand side of the comparison.
+ * \param rhs               The right hand side of the comparison.
+ *
+ * \returns less than, equal to, or greater than zero if lhs is less than,
+ * equal to, or greater than rhs.
+ */
+static int block_txn_entry_compare_key(const void* lhs, const void* rhs)
+{
+    return memcmp(lhs, rhs, 16);
+}
+
+/**
+ * \brief Compare the predecessor ids of two transaction table entry pointers,
+ * breaking ties by block order.
+ *
+ * \param lhs               The left hand side of the comparison.
+ * \param rhs               The right hand side of the comparison.
+ *
+ * \returns less than, equal to, or greater than zero if lhs is less than,
+ * equal to, or greater than rhs.
+ */
+static int block_txn_entry_compare_prev(const void* lhs, const void* rhs)
+{
+    const block_txn_entry_t* l = *(const block_txn_entry_t* const*)lhs;
+    const block_txn_entry_t* r = *(const block_txn_entry_t* const*)rhs;
+
+    int cmp = memcmp(l->node.prev, r->node.prev, 16);
+    if (0 != cmp)
+    {
+        return cmp;
+    }
+
+    return (l->order < r->order) ? -1 : (l->order > r->order);
+}
+
+/**
+ * \brief Release the memory held by the transaction table.
+ *
+ * \param txns              The table of transactions in this block.
+ */
+static void block_txn_table_dispose(block_txn_table_t* txns)
+{
+    if (NULL != txns->entries)
+    {
+        memset(
+            txns->entries, 0, txns->capacity * sizeof(block_txn_entry_t));
+        free(txns->entries);
+    }
+
+    memset(txns, 0, sizeof(block_txn_table_t));
+}
+
 /**
  * \brief Verify the block height constraint for new blocks.
  *
@@ -0,0 +1,719 @@
+/**
+ * \file dataservice/dataservice_block_make_from_queue.c
+ *
+ * \brief Assemble and make a block from attested transactions in the
+ * transaction process queue.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/api.h>
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <time.h>
+#include <vccert/builder.h>
+#include <vccert/certificate_types.h>
+#include <vccert/fields.h>
+#include <vccrypt/suite.h>
+#include <vpr/allocator.h>
+#include <vpr/allocator/malloc_allocator.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+
+/* forward decls */
+static int dataservice_block_make_from_queue_previous_block(
+    MDB_txn* txn, MDB_dbi block_db, uint8_t* prev_block_id,
+    uint64_t* expected_block_height);
+static int dataservice_block_make_from_queue_next_attested(
+    MDB_txn* txn, MDB_dbi pq_db, const uint8_t* key,
+    const data_transaction_node_t** node, const uint8_t** cert,
+    size_t* cert_size);
+static int dataservice_block_make_from_queue_scan(
+    MDB_txn* txn, MDB_dbi pq_db, size_t max_transactions,
+    size_t max_block_size, size_t header_size, size_t* transaction_count,
+    size_t* block_size);
+static int dataservice_block_make_from_queue_build(
+    vccert_builder_context_t* builder, MDB_txn* txn, MDB_dbi pq_db,
+    const uint8_t* block_id, const uint8_t* prev_block_id,
+    uint64_t block_height, size_t transaction_count);
+static int dataservice_block_make_from_queue_hash(
+    vccrypt_suite_options_t* crypto_suite, allocator_options_t* alloc_opts,
+    const uint8_t* block_cert, size_t block_cert_size, uint8_t* block_hash,
+    size_t* block_hash_size);
+
+/**
+ * \brief Make a block from the attested transactions at the head of the
+ * transaction process queue.
+ *
+ * The data service walks the transaction process queue from its beginning,
+ * collecting attested transactions until either a transaction that has not
+ * been attested is found, the end of the queue is reached, or one of the
+ * provided limits is met.  These transactions are wrapped in a block
+ * certificate which is then canonized as per \ref dataservice_block_make.  All
+ * of this occurs under a single database transaction, so the block is either
+ * made in its entirety or not at all.
+ *
+ * \param child             The child context for this operation.
+ * \param dtxn_ctx          The dataservice transaction context for this
+ *                          operation.
+ * \param block_id          The block ID for this block.
+ * \param block_height      The expected height of this block.
+ * \param max_transactions  The maximum number of transactions to include in
+ *                          this block.  Must be greater than zero.
+ * \param max_block_size    The maximum size of the block certificate, or zero
+ *                          if the size is not limited.  A block always contains
+ *                          at least one transaction, even if that transaction
+ *                          would exceed this limit.
+ * \param block_hash        Buffer to receive the hash of the block certificate.
+ * \param block_hash_size   On input, the size of the block hash buffer.  On
+ *                          success, this is updated to the size of the hash.
+ * \param transaction_count Pointer to receive the number of transactions
+ *                          canonized in this block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if there are no attested
+ *        transactions at the head of the transaction process queue.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
+ *        encountered during this operation.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this child context is not
+ *        authorized to call this function.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT if the block height does
+ *        not follow the latest block in the blockchain.
+ *      - AGENTD_ERROR_DATASERVICE_WOULD_TRUNCATE if the block hash buffer is
+ *        too small to hold the block hash.
+ *      - AGENTD_ERROR_DATASERVICE_VCCRYPT_SUITE_OPTIONS_INIT_FAILURE if this
+ *        function failed to initialize crypto suite options.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_OPTIONS_INIT_FAILURE if this
+ *        function failed to initialize builder options.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_INIT_FAILURE if this function
+ *        failed to initialize a certificate builder.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE if this function
+ *        failed to add a field to or emit the block certificate.
+ *      - AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE if this function failed
+ *        to compute the block hash.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function failed
+ *        to create a database transaction.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_COMMIT_FAILURE if this function
+ *        failed to commit the database transaction.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function could not
+ *        read from the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_BLOCK_NODE if this function
+ *        encountered an invalid block node in the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE if this
+ *        function encountered an invalid transaction node in the database.
+ *      - any error code returned by \ref dataservice_block_make.
+ */
+int dataservice_block_make_from_queue(
+    dataservice_child_context_t* child,
+    dataservice_transaction_context_t* dtxn_ctx, const uint8_t* block_id,
+    uint64_t block_height, size_t max_transactions, size_t max_block_size,
+    uint8_t* block_hash, size_t* block_hash_size, size_t* transaction_count)
+{
+    allocator_options_t alloc_opts;
+    vccrypt_suite_options_t crypto_suite;
+    vccert_builder_options_t builder_opts;
+    vccert_builder_context_t builder;
+    int retval = 0;
+    MDB_txn* txn = NULL;
+    uint8_t prev_block_id[16];
+    uint64_t expected_block_height;
+    size_t block_size;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != child);
+    MODEL_ASSERT(NULL != child->root);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(max_transactions > 0);
+    MODEL_ASSERT(NULL != block_hash);
+    MODEL_ASSERT(NULL != block_hash_size);
+    MODEL_ASSERT(NULL != transaction_count);
+
+    /* verify that we are allowed to make a block. */
+    if (!BITCAP_ISSET(child->childcaps,
+            DATASERVICE_API_CAP_APP_BLOCK_WRITE))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED;
+        goto done;
+    }
+
+    /* get the details for this database connection. */
+    dataservice_database_details_t* details =
+        (dataservice_database_details_t*)child->root->details;
+
+    /* create allocator options for this operation. */
+    /* TODO - use a pool allocator. */
+    malloc_allocator_options_init(&alloc_opts);
+
+    /* create crypto suite options for this operation. */
+    /* TODO - this should occur at startup. */
+    if (VCCRYPT_STATUS_SUCCESS != vccrypt_suite_options_init(&crypto_suite, &alloc_opts, VCCRYPT_SUITE_VELO_V1))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCRYPT_SUITE_OPTIONS_INIT_FAILURE;
+        goto dispose_alloc_opts;
+    }
+
+    /* verify that the caller's buffer can hold the block hash. */
+    if (*block_hash_size < crypto_suite.hash_opts.hash_size)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_WOULD_TRUNCATE;
+        goto dispose_crypto_suite;
+    }
+
+    /* create builder options for building this block. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_options_init(&builder_opts, &alloc_opts, &crypto_suite))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_OPTIONS_INIT_FAILURE;
+        goto dispose_crypto_suite;
+    }
+
+    /* create the transaction under which this block is assembled. */
+    MDB_txn* parent = (NULL != dtxn_ctx) ? dtxn_ctx->txn : NULL;
+    if (0 != mdb_txn_begin(details->env, parent, 0, &txn))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE;
+        txn = NULL;
+        goto dispose_builder_opts;
+    }
+
+    /* find the previous block and verify the block height. */
+    retval =
+        dataservice_block_make_from_queue_previous_block(
+            txn, details->block_db, prev_block_id, &expected_block_height);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+    else if (block_height != expected_block_height)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT;
+        goto maybe_transaction_abort;
+    }
+
+    /* compute block certificate header size. */
+    size_t header_size =
+        /* certificate version. */
+        FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + sizeof(uint32_t)
+        /* transaction timestamp */
+        + FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + sizeof(uint64_t)
+        /* crypto suite. */
+        + FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + sizeof(uint16_t)
+        /* certificate type. */
+        + FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + 16
+        /* block id. */
+        + FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + 16
+        /* previous block id. */
+        + FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + 16
+        /* block height. */
+        + FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + sizeof(uint64_t);
+
+    /* find the attested transactions that will go into this block. */
+    retval =
+        dataservice_block_make_from_queue_scan(
+            txn, details->pq_db, max_transactions, max_block_size,
+            header_size, transaction_count, &block_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto maybe_transaction_abort;
+    }
+
+    /* create the builder for this block. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_init(&builder_opts, &builder, block_size))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_INIT_FAILURE;
+        goto maybe_transaction_abort;
+    }
+
+    /* build the block certificate.  The transaction certificates are copied
+     * directly from the database into the builder, so this must occur before
+     * any writes are made under this transaction. */
+    retval =
+        dataservice_block_make_from_queue_build(
+            &builder, txn, details->pq_db, block_id, prev_block_id,
+            block_height, *transaction_count);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto dispose_builder;
+    }
+
+    /* emit the block certificate. */
+    size_t block_cert_size;
+    const uint8_t* block_cert =
+        vccert_builder_emit(&builder, &block_cert_size);
+    if (NULL == block_cert)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+        goto dispose_builder;
+    }
+
+    /* compute the block hash. */
+    retval =
+        dataservice_block_make_from_queue_hash(
+            &crypto_suite, &alloc_opts, block_cert, block_cert_size,
+            block_hash, block_hash_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto dispose_builder;
+    }
+
+    /* canonize this block under our transaction. */
+    dataservice_transaction_context_t block_txn_ctx;
+    block_txn_ctx.child = child;
+    block_txn_ctx.txn = txn;
+    retval =
+        dataservice_block_make(
+            child, &block_txn_ctx, block_id, block_cert, block_cert_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto dispose_builder;
+    }
+
+    /* commit transaction. */
+    if (0 != mdb_txn_commit(txn))
+    {
+        txn = NULL;
+        retval = AGENTD_ERROR_DATASERVICE_MDB_TXN_COMMIT_FAILURE;
+        goto dispose_builder;
+    }
+    txn = NULL;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+dispose_builder:
+    dispose((disposable_t*)&builder);
+
+maybe_transaction_abort:
+    if (NULL != txn)
+    {
+        mdb_txn_abort(txn);
+    }
+
+dispose_builder_opts:
+    dispose((disposable_t*)&builder_opts);
+
+dispose_crypto_suite:
+    dispose((disposable_t*)&crypto_suite);
+
+dispose_alloc_opts:
+    dispose((disposable_t*)&alloc_opts);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Look up the previous block ID and the expected height of the next
+ * block.
+ *
+ * \param txn                   The database transaction for this query.
+ * \param block_db              The block database.
+ * \param prev_block_id         Buffer to receive the previous block ID.
+ * \param expected_block_height Pointer to receive the expected block height.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function could not
+ *        read from the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_BLOCK_NODE if the end node is
+ *        invalid.
+ */
+static int dataservice_block_make_from_queue_previous_block(
+    MDB_txn* txn, MDB_dbi block_db, uint8_t* prev_block_id,
+    uint64_t* expected_block_height)
+{
+    /* the latest block's ID is stored in the database as
+       ffffffff-ffff-ffff-ffff-ffffffffffff */
+    uint8_t key[16];
+    memset(key, 0xFF, sizeof(key));
+
+    /* query the blockchain for the last block ID. */
+    MDB_val lkey;
+    lkey.mv_size = sizeof(key);
+    lkey.mv_data = key;
+    MDB_val lval;
+    memset(&lval, 0, sizeof(lval));
+    int retval = mdb_get(txn, block_db, &lkey, &lval);
+    if (MDB_NOTFOUND == retval)
+    {
+        /* this is the first block after the root block. */
+        memcpy(prev_block_id, vccert_certificate_type_uuid_root_block, 16);
+        *expected_block_height = 1;
+
+        return AGENTD_STATUS_SUCCESS;
+    }
+    else if (0 != retval)
+    {
+        /* some error has occurred. */
+        return AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+    }
+
+    /* verify that this block node is valid. */
+    if (lval.mv_size < sizeof(data_block_node_t))
+    {
+        return AGENTD_ERROR_DATASERVICE_INVALID_STORED_BLOCK_NODE;
+    }
+
+    /* the end node points to the latest block. */
+    const data_block_node_t* end_node = (const data_block_node_t*)lval.mv_data;
+    memcpy(prev_block_id, end_node->prev, 16);
+    *expected_block_height = ntohll(end_node->net_block_height) + 1;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Read the process queue node following the given key, if that node is
+ * an attested transaction.
+ *
+ * \param txn           The database transaction for this query.
+ * \param pq_db         The process queue database.
+ * \param key           The key of the current node.
+ * \param node          Pointer to receive the next node.
+ * \param cert          Pointer to receive the next node's certificate.
+ * \param cert_size     Pointer to receive the next node's certificate size.
+ *
+ * The node and certificate pointers point into the database and are only valid
+ * until the next write under this transaction.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the next node is the end of the
+ *        queue or is not attested.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function could not
+ *        read from the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE if an invalid
+ *        transaction node was encountered.
+ */
+static int dataservice_block_make_from_queue_next_attested(
+    MDB_txn* txn, MDB_dbi pq_db, const uint8_t* key,
+    const data_transaction_node_t** node, const uint8_t** cert,
+    size_t* cert_size)
+{
+    MDB_val lkey;
+    MDB_val lval;
+    uint8_t next_key[16];
+
+    /* read the current node. */
+    lkey.mv_size = 16;
+    lkey.mv_data = (void*)key;
+    memset(&lval, 0, sizeof(lval));
+    int retval = mdb_get(txn, pq_db, &lkey, &lval);
+    if (MDB_NOTFOUND == retval)
+    {
+        return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+    }
+    else if (0 != retval)
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+    }
+
+    /* verify that this node is valid. */
+    if (lval.mv_size < sizeof(data_transaction_node_t))
+    {
+        return AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE;
+    }
+
+    /* if the next node is the end of the queue, there is nothing left. */
+    memcpy(next_key, ((const data_transaction_node_t*)lval.mv_data)->next, 16);
+    if (dataservice_api_node_ref_is_end(next_key))
+    {
+        return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+    }
+
+    /* read the next node. */
+    lkey.mv_size = sizeof(next_key);
+    lkey.mv_data = next_key;
+    memset(&lval, 0, sizeof(lval));
+    retval = mdb_get(txn, pq_db, &lkey, &lval);
+    if (MDB_NOTFOUND == retval)
+    {
+        return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+    }
+    else if (0 != retval)
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+    }
+
+    /* verify that this value is large enough to be a node value. */
+    if (lval.mv_size <= sizeof(data_transaction_node_t))
+    {
+        return AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE;
+    }
+
+    /* the transaction size should match exactly the data size. */
+    *node = (const data_transaction_node_t*)lval.mv_data;
+    *cert = ((const uint8_t*)lval.mv_data) + sizeof(data_transaction_node_t);
+    *cert_size = lval.mv_size - sizeof(data_transaction_node_t);
+    if (*cert_size != ntohll((*node)->net_txn_cert_size))
+    {
+        return AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE;
+    }
+
+    /* only attested transactions can be canonized. */
+    if (DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED !=
+        ntohl((*node)->net_txn_state))
+    {
+        return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Scan the process queue to determine how many transactions will fit in
+ * this block.
+ *
+ * \param txn               The database transaction for this query.
+ * \param pq_db             The process queue database.
+ * \param max_transactions  The maximum number of transactions in the block.
+ * \param max_block_size    The maximum block size, or zero for no limit.
+ * \param header_size       The size of the block certificate header.
+ * \param transaction_count Pointer to receive the transaction count.
+ * \param block_size        Pointer to receive the block certificate size.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if no attested transactions are at
+ *        the head of the process queue.
+ *      - a non-zero error code on failure.
+ */
+static int dataservice_block_make_from_queue_scan(
+    MDB_txn* txn, MDB_dbi pq_db, size_t max_transactions,
+    size_t max_block_size, size_t header_size, size_t* transaction_count,
+    size_t* block_size)
+{
+    int retval;
+    uint8_t key[16];
+    const data_transaction_node_t* node;
+    const uint8_t* cert;
+    size_t cert_size;
+
+    /* start at the beginning of the queue. */
+    memset(key, 0, sizeof(key));
+    *transaction_count = 0;
+    *block_size = header_size;
+
+    while (*transaction_count < max_transactions)
+    {
+        /* get the next attested transaction. */
+        retval =
+            dataservice_block_make_from_queue_next_attested(
+                txn, pq_db, key, &node, &cert, &cert_size);
+        if (AGENTD_ERROR_DATASERVICE_NOT_FOUND == retval)
+        {
+            break;
+        }
+        else if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* stop if this transaction would exceed the block size limit. */
+        size_t field_size = FIELD_TYPE_SIZE + FIELD_SIZE_SIZE + cert_size;
+        if (max_block_size > 0 && *transaction_count > 0 &&
+            *block_size + field_size > max_block_size)
+        {
+            break;
+        }
+
+        /* count this transaction. */
+        *block_size += field_size;
+        *transaction_count += 1;
+
+        /* advance to this transaction. */
+        memcpy(key, node->key, sizeof(key));
+    }
+
+    /* there must be at least one transaction to make a block. */
+    if (0 == *transaction_count)
+    {
+        return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Build the block certificate from the head of the process queue.
+ *
+ * \param builder           The builder for this block certificate.
+ * \param txn               The database transaction for this query.
+ * \param pq_db             The process queue database.
+ * \param block_id          The block ID for this block.
+ * \param prev_block_id     The previous block ID for this block.
+ * \param block_height      The height of this block.
+ * \param transaction_count The number of transactions to add to this block.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE if a field could not
+ *        be added to the certificate.
+ *      - a non-zero error code on failure.
+ */
+static int dataservice_block_make_from_queue_build(
+    vccert_builder_context_t* builder, MDB_txn* txn, MDB_dbi pq_db,
+    const uint8_t* block_id, const uint8_t* prev_block_id,
+    uint64_t block_height, size_t transaction_count)
+{
+    int retval;
+    uint8_t key[16];
+    const data_transaction_node_t* node;
+    const uint8_t* cert;
+    size_t cert_size;
+
+    /* get current time. */
+    time_t timestamp = time(NULL);
+    if (timestamp < 0)
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add certificate version. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_uint32(builder, VCCERT_FIELD_TYPE_CERTIFICATE_VERSION, 0x00010000))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add time to the builder. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_uint64(builder, VCCERT_FIELD_TYPE_CERTIFICATE_VALID_FROM, (uint64_t)timestamp))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add crypto suite to the builder. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_uint16(builder, VCCERT_FIELD_TYPE_CERTIFICATE_CRYPTO_SUITE, 0x0001))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add certificate type to builder. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_buffer(builder, VCCERT_FIELD_TYPE_CERTIFICATE_TYPE, vccert_certificate_type_uuid_txn_block, sizeof(vccert_certificate_type_uuid_txn_block)))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add block id to the builder. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_buffer(builder, VCCERT_FIELD_TYPE_BLOCK_UUID, block_id, 16))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add previous block id to the builder. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_buffer(builder, VCCERT_FIELD_TYPE_PREVIOUS_BLOCK_UUID, prev_block_id, 16))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* add block height to the builder. */
+    if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_uint64(builder, VCCERT_FIELD_TYPE_BLOCK_HEIGHT, block_height))
+    {
+        return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+    }
+
+    /* start at the beginning of the queue. */
+    memset(key, 0, sizeof(key));
+
+    /* add each transaction to the certificate. */
+    for (size_t i = 0; i < transaction_count; ++i)
+    {
+        /* get the next attested transaction. */
+        retval =
+            dataservice_block_make_from_queue_next_attested(
+                txn, pq_db, key, &node, &cert, &cert_size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* add the transaction certificate to the block. */
+        if (VCCERT_STATUS_SUCCESS != vccert_builder_add_short_buffer(builder, VCCERT_FIELD_TYPE_WRAPPED_TRANSACTION_TUPLE, cert, cert_size))
+        {
+            return AGENTD_ERROR_DATASERVICE_VCCERT_BUILDER_FAILURE;
+        }
+
+        /* advance to this transaction. */
+        memcpy(key, node->key, sizeof(key));
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compute the hash of the block certificate.
+ *
+ * \param crypto_suite      The crypto suite to use for the hash.
+ * \param alloc_opts        The allocator to use for the hash buffer.
+ * \param block_cert        The block certificate to hash.
+ * \param block_cert_size   The size of the block certificate.
+ * \param block_hash        Buffer to receive the hash.
+ * \param block_hash_size   Pointer to receive the size of the hash.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the hash buffer could not be
+ *        allocated.
+ *      - AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE if the hash could not
+ *        be computed.
+ */
+static int dataservice_block_make_from_queue_hash(
+    vccrypt_suite_options_t* crypto_suite, allocator_options_t* alloc_opts,
+    const uint8_t* block_cert, size_t block_cert_size, uint8_t* block_hash,
+    size_t* block_hash_size)
+{
+    int retval;
+    vccrypt_hash_context_t hash;
+    vccrypt_buffer_t hash_buffer;
+
+    /* create the hash buffer. */
+    if (VCCRYPT_STATUS_SUCCESS != vccrypt_buffer_init(&hash_buffer, alloc_opts, crypto_suite->hash_opts.hash_size))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* create the hash context. */
+    if (VCCRYPT_STATUS_SUCCESS != vccrypt_suite_hash_init(crypto_suite, &hash))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE;
+        goto cleanup_hash_buffer;
+    }
+
+    /* digest the block certificate. */
+    if (VCCRYPT_STATUS_SUCCESS != vccrypt_hash_digest(&hash, block_cert, block_cert_size))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE;
+        goto cleanup_hash;
+    }
+
+    /* finalize the hash. */
+    if (VCCRYPT_STATUS_SUCCESS != vccrypt_hash_finalize(&hash, &hash_buffer))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_VCCRYPT_HASH_FAILURE;
+        goto cleanup_hash;
+    }
+
+    /* copy the hash to the caller. */
+    memcpy(block_hash, hash_buffer.data, hash_buffer.size);
+    *block_hash_size = hash_buffer.size;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_hash:
+    dispose((disposable_t*)&hash);
+
+cleanup_hash_buffer:
+    dispose((disposable_t*)&hash_buffer);
+
+done:
+    return retval;
+}
@@ -0,0 +1,130 @@
+/**
+ * \file dataservice/dataservice_block_notify_check.c
+ *
+ * \brief Notify subscribers of a newly committed block.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Notify subscribed child contexts if a new block has been committed.
+ *
+ * Several blocks committed between two checks are reported as one
+ * notification for the latest of them.  Subscribers can walk back from that
+ * block to find the others.  Child contexts watching artifacts updated by the
+ * new blocks are notified as well.  The latest block is only recorded once
+ * every new block has been checked for watched artifacts, so that no update
+ * is missed.
+ *
+ * \param inst          The data service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success, including when there is nothing to
+ *        notify.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+int dataservice_block_notify_check(dataservice_instance_t* inst)
+{
+    int retval;
+    uint8_t block_id[16];
+    uint8_t prev_block_id[16];
+    uint64_t height;
+    void* payload = NULL;
+    size_t payload_size = 0U;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+
+    /* nothing to do without subscribers or a socket to notify them on. */
+    if ((0U == inst->block_notify_count && 0U == inst->artifact_watch_count)
+     || NULL == inst->sock)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* a failed read is tried again on the next check. */
+    if (AGENTD_STATUS_SUCCESS !=
+            dataservice_block_notify_latest_get(inst, block_id, &height))
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* if the latest block hasn't changed, there's nothing to notify. */
+    if (!memcmp(inst->block_notify_latest, block_id, 16))
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    memcpy(prev_block_id, inst->block_notify_latest, 16);
+
+    /* notify watchers of the artifacts updated by the new blocks.  If the new
+     * blocks can't all be read, the latest block is left as it was, so the
+     * next check walks the same blocks again. */
+    if (inst->artifact_watch_count > 0U)
+    {
+        retval =
+            dataservice_artifact_watch_check(inst, prev_block_id, block_id);
+        if (AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE == retval)
+        {
+            return AGENTD_STATUS_SUCCESS;
+        }
+        else if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    memcpy(inst->block_notify_latest, block_id, 16);
+
+    /* the rest is for block notification subscribers. */
+    if (0U == inst->block_notify_count)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* encode the notification payload once for all subscribers. */
+    retval =
+        dataservice_encode_response_block_notify(
+            &payload, &payload_size, block_id, height);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* notify each subscribed child context. */
+    for (uint32_t i = 0U; i < DATASERVICE_MAX_CHILD_CONTEXTS; ++i)
+    {
+        if (!inst->children[i].block_notify)
+        {
+            continue;
+        }
+
+        retval =
+            dataservice_decode_and_dispatch_write_status(
+                inst->sock, DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT, i,
+                AGENTD_STATUS_SUCCESS, payload, payload_size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_payload;
+        }
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_payload:
+    memset(payload, 0, payload_size);
+    free(payload);
+
+    return retval;
+}
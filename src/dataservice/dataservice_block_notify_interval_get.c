@@ -0,0 +1,72 @@
+/**
+ * \file dataservice/dataservice_block_notify_interval_get.c
+ *
+ * \brief Get the block notification interval.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Get the block notification interval.
+ *
+ * The interval is read from AGENTD_BLOCK_NOTIFY_MILLISECONDS, if set, and
+ * defaults to DATASERVICE_BLOCK_NOTIFY_MILLISECONDS.  A shorter interval
+ * notifies subscribers sooner after a block is committed, at the cost of more
+ * frequent database reads.  A data service that is signaled when a block is
+ * committed only needs the timer as a fallback, and so defaults to
+ * DATASERVICE_BLOCK_NOTIFY_FALLBACK_MILLISECONDS instead.
+ *
+ * \param signaled      true if the data service is signaled when a block is
+ *                      committed, so that the timer is only a fallback.
+ * \param milliseconds  Pointer to receive the interval, in milliseconds.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID if
+ *        AGENTD_BLOCK_NOTIFY_MILLISECONDS is malformed or out of range.
+ */
+int dataservice_block_notify_interval_get(
+    bool signaled, uint32_t* milliseconds)
+{
+    char* end = NULL;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != milliseconds);
+
+    /* use the default if the interval isn't set. */
+    const char* interval = getenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS");
+    if (NULL == interval)
+    {
+        *milliseconds =
+            signaled
+                ? DATASERVICE_BLOCK_NOTIFY_FALLBACK_MILLISECONDS
+                : DATASERVICE_BLOCK_NOTIFY_MILLISECONDS;
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* the interval must be a decimal number within range. */
+    if (!isdigit((unsigned char)*interval))
+    {
+        return AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID;
+    }
+
+    unsigned long value = strtoul(interval, &end, 10);
+    if (0 != *end
+     || value < DATASERVICE_BLOCK_NOTIFY_MILLISECONDS_MIN
+     || value > DATASERVICE_BLOCK_NOTIFY_MILLISECONDS_MAX)
+    {
+        return AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID;
+    }
+
+    *milliseconds = (uint32_t)value;
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,133 @@
+/**
+ * \file dataservice/dataservice_block_notify_latest_get.c
+ *
+ * \brief Read the latest block ID and height for block notifications.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccert/certificate_types.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Read the latest block ID and height for block notifications.
+ *
+ * This reads the database directly, without a capabilities check, and so
+ * SHOULD NOT BE USED OUTSIDE OF THE DATA SERVICE.
+ *
+ * \param inst          The data service instance.
+ * \param block_id      Pointer to the block UUID (16 bytes) to set.
+ * \param height        Pointer to the block height to set.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if the root context has not
+ *        been created.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function failed
+ *        to begin a transaction.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
+ *        read data from the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_INDEX_ENTRY if this function
+ *        encountered an invalid index entry.
+ */
+int dataservice_block_notify_latest_get(
+    dataservice_instance_t* inst, uint8_t* block_id, uint64_t* height)
+{
+    int retval = 0;
+    MDB_txn* txn = NULL;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(NULL != height);
+
+    /* the database is only open once the root context has been created. */
+    dataservice_database_details_t* details =
+        (dataservice_database_details_t*)inst->ctx.details;
+    if (NULL == details)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED;
+        goto done;
+    }
+
+    /* begin a read transaction, which sees blocks committed by any process
+     * sharing this database. */
+    if (0 != mdb_txn_begin(details->env, NULL, MDB_RDONLY, &txn))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE;
+        goto done;
+    }
+
+    /* the end sentry links back to the latest block. */
+    uint8_t end_block_key[16];
+    memset(end_block_key, 0xFF, sizeof(end_block_key));
+
+    MDB_val lkey;
+    lkey.mv_size = sizeof(end_block_key);
+    lkey.mv_data = end_block_key;
+    MDB_val lval;
+    memset(&lval, 0, sizeof(lval));
+
+    retval = mdb_get(txn, details->block_db, &lkey, &lval);
+    if (MDB_NOTFOUND == retval)
+    {
+        /* no blocks have been written, so the root block is the latest. */
+        memcpy(block_id, vccert_certificate_type_uuid_root_block, 16);
+        *height = 0U;
+        retval = AGENTD_STATUS_SUCCESS;
+        goto transaction_abort;
+    }
+    else if (0 != retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+        goto transaction_abort;
+    }
+
+    if (lval.mv_size != sizeof(data_block_node_t))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_INVALID_INDEX_ENTRY;
+        goto transaction_abort;
+    }
+
+    /* read the latest block's node to get its height. */
+    data_block_node_t* end_node = (data_block_node_t*)lval.mv_data;
+    memcpy(block_id, end_node->prev, 16);
+
+    lkey.mv_size = 16;
+    lkey.mv_data = block_id;
+    memset(&lval, 0, sizeof(lval));
+
+    retval = mdb_get(txn, details->block_db, &lkey, &lval);
+    if (0 != retval)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
+        goto transaction_abort;
+    }
+
+    if (lval.mv_size < sizeof(data_block_node_t))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_INVALID_INDEX_ENTRY;
+        goto transaction_abort;
+    }
+
+    data_block_node_t block_node;
+    memcpy(&block_node, lval.mv_data, sizeof(block_node));
+    *height = ntohll(block_node.net_block_height);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+    /* fall-through. */
+
+transaction_abort:
+    mdb_txn_abort(txn);
+
+done:
+    return retval;
+}
@@ -0,0 +1,103 @@
+/**
+ * \file dataservice/dataservice_block_notify_subscribe.c
+ *
+ * \brief Subscribe a child context to block commit notifications.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Subscribe a child context to block commit notifications.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context to subscribe.
+ * \param block_id      Pointer to the block UUID (16 bytes) to set to the
+ *                      latest block ID at the time of subscription.
+ * \param height        Pointer to the height to set to the latest block
+ *                      height at the time of subscription.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_BAD_INDEX if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_INVALID if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this child context is not
+ *        authorized to read the latest block ID.
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_latest_get().
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_timer_arm().
+ */
+int dataservice_block_notify_subscribe(
+    dataservice_instance_t* inst, uint32_t offset, uint8_t* block_id,
+    uint64_t* height)
+{
+    int retval;
+    dataservice_child_context_t* ctx = NULL;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(NULL != height);
+
+    /* look up the child context. */
+    retval = dataservice_child_context_lookup(&ctx, inst, offset);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* a subscriber learns of new blocks, so it must be able to read them. */
+    if (!BITCAP_ISSET(ctx->childcaps,
+            DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED;
+        goto done;
+    }
+
+    /* get the latest block, which the subscriber starts from. */
+    retval = dataservice_block_notify_latest_get(inst, block_id, height);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the first subscriber or artifact watch starts the watch from the
+     * latest block.  Otherwise, bring the existing subscribers up to date
+     * first, so that this subscriber isn't notified of a block that it already
+     * has. */
+    if (0U == inst->block_notify_count && 0U == inst->artifact_watch_count)
+    {
+        memcpy(inst->block_notify_latest, block_id, 16);
+    }
+    else
+    {
+        retval = dataservice_block_notify_check(inst);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
+    /* subscribe the child context. */
+    dataservice_child_details_t* child = &inst->children[offset];
+    if (!child->block_notify)
+    {
+        child->block_notify = true;
+        ++inst->block_notify_count;
+    }
+
+    /* watch for new blocks. */
+    retval = dataservice_block_notify_timer_arm(inst);
+
+done:
+    return retval;
+}
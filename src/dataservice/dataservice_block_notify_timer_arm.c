@@ -0,0 +1,51 @@
+/**
+ * \file dataservice/dataservice_block_notify_timer_arm.c
+ *
+ * \brief Arm the block notification timer.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Arm the block notification timer, if it isn't already armed.
+ *
+ * \param inst          The data service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - any of the errors returned by \ref ipc_event_loop_add_timer().
+ */
+int dataservice_block_notify_timer_arm(dataservice_instance_t* inst)
+{
+    int retval;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+
+    /* the timer is only available when running in the event loop. */
+    if (inst->block_notify_timer_armed
+     || NULL == inst->loop_context
+     || NULL == inst->block_notify_timer.hdr.dispose)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    retval =
+        ipc_event_loop_add_timer(
+            inst->loop_context, &inst->block_notify_timer);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    inst->block_notify_timer_armed = true;
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/**
+ * \file dataservice/dataservice_block_notify_timer_cb.c
+ *
+ * \brief Check for new blocks on behalf of block notification subscribers.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Timer callback that checks for new blocks while child contexts are
+ * subscribed to block notifications or are watching artifacts.
+ *
+ * The timer is one-shot, so it is re-armed here for as long as any child
+ * context remains subscribed or watching.
+ *
+ * \param timer         The timer that fired.
+ * \param user_context  The data service instance.
+ */
+void dataservice_block_notify_timer_cb(
+    ipc_timer_context_t* UNUSED(timer), void* user_context)
+{
+    dataservice_instance_t* inst = (dataservice_instance_t*)user_context;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != timer);
+    MODEL_ASSERT(NULL != inst);
+
+    /* this timer has fired. */
+    inst->block_notify_timer_armed = false;
+
+    /* don't do anything if we have been forced to exit. */
+    if (inst->dataservice_force_exit)
+        return;
+
+    /* notify subscribers of any new block. */
+    if (AGENTD_STATUS_SUCCESS != dataservice_block_notify_check(inst))
+    {
+        dataservice_exit_event_loop(inst);
+        return;
+    }
+
+    /* write any notifications. */
+    if (ipc_socket_writebuffer_size(inst->sock) > 0)
+    {
+        ipc_set_writecb_noblock(
+            inst->sock, &dataservice_ipc_write, inst->loop_context);
+    }
+
+    /* keep watching while there are subscribers or artifact watches. */
+    if ((inst->block_notify_count > 0U || inst->artifact_watch_count > 0U)
+     && AGENTD_STATUS_SUCCESS != dataservice_block_notify_timer_arm(inst))
+    {
+        dataservice_exit_event_loop(inst);
+    }
+}
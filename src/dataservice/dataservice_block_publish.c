@@ -0,0 +1,41 @@
+/**
+ * \file dataservice/dataservice_block_publish.c
+ *
+ * \brief Signal each block publish socket that a block has been committed.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <cbmc/model_assert.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Signal each block publish socket that a block has been committed.
+ *
+ * Each signal is a single byte, which tells the data service on the other end
+ * to check for a new block.  The write never blocks.  If a socket is full,
+ * then a signal is already waiting to be read, and this block will be found
+ * by that check.  If the data service on the other end has gone away, then
+ * there is no one left to signal.  Either way, the signal is dropped.
+ *
+ * \param inst          The data service instance.
+ */
+void dataservice_block_publish(dataservice_instance_t* inst)
+{
+    const uint8_t signal = 1U;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+
+    for (size_t i = 0; i < inst->block_publish_count; ++i)
+    {
+        /* a dropped signal is caught by the subscriber's fallback timer. */
+        (void)send(
+            inst->block_publish_start + (int)i, &signal, sizeof(signal),
+            MSG_DONTWAIT | MSG_NOSIGNAL);
+    }
+}
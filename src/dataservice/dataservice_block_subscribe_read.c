@@ -0,0 +1,74 @@
+/**
+ * \file dataservice/dataservice_block_subscribe_read.c
+ *
+ * \brief Check for a new block when a committed block is signaled.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Read callback for the block subscribe socket, which checks for a new
+ * block each time that a committed block is signaled.
+ *
+ * Every signal waiting on the socket is drained at once, since one check finds
+ * every block committed so far.  If the publishing data service goes away,
+ * the socket is dropped from the event loop, and subscribers are left to the
+ * fallback timer.
+ *
+ * \param ctx           The non-blocking socket context.
+ * \param event_flags   The event that triggered this callback.
+ * \param user_context  The data service instance.
+ */
+void dataservice_block_subscribe_read(
+    ipc_socket_context_t* ctx, int UNUSED(event_flags), void* user_context)
+{
+    dataservice_instance_t* inst = (dataservice_instance_t*)user_context;
+    uint8_t signals[64];
+    ssize_t bytes_read;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != ctx);
+    MODEL_ASSERT(NULL != inst);
+
+    /* drain every signal waiting on the socket. */
+    do
+    {
+        bytes_read = recv(ctx->fd, signals, sizeof(signals), MSG_DONTWAIT);
+    } while (bytes_read > 0);
+
+    /* stop watching a socket that the publisher has closed. */
+    if (0 == bytes_read
+     || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
+    {
+        ipc_event_loop_remove(inst->loop_context, ctx);
+    }
+
+    /* don't do anything if we have been forced to exit. */
+    if (inst->dataservice_force_exit)
+        return;
+
+    /* notify subscribers of the new block. */
+    if (AGENTD_STATUS_SUCCESS != dataservice_block_notify_check(inst))
+    {
+        dataservice_exit_event_loop(inst);
+        return;
+    }
+
+    /* write any notifications. */
+    if (ipc_socket_writebuffer_size(inst->sock) > 0)
+    {
+        ipc_set_writecb_noblock(
+            inst->sock, &dataservice_ipc_write, inst->loop_context);
+    }
+}
@@ -23,6 +23,14 @@ void dataservice_child_details_delete(dataservice_instance_t* inst, int offset)
 {
     dataservice_child_details_t* child = &inst->children[offset];
 
+    /* a closed child context is no longer subscribed to notifications. */
+    if (child->block_notify)
+    {
+        --inst->block_notify_count;
+    }
+
+    dataservice_artifact_watch_remove_child(inst, (uint32_t)offset);
+
     /* dispose of the child. */
     dispose((disposable_t*)child);
 
@@ -0,0 +1,36 @@
+/**
+ * \file dataservice/dataservice_count_sockets.c
+ *
+ * \brief Count the open descriptors in a run of consecutive descriptors.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * \brief Count the open descriptors in a run of consecutive descriptors.
+ *
+ * The supervisor hands the data service a variable number of block publish
+ * sockets, one after another, so the data service counts them on startup.
+ *
+ * \param start         The first descriptor in the run.
+ *
+ * \returns the number of open descriptors before the first closed descriptor.
+ */
+size_t dataservice_count_sockets(int start)
+{
+    size_t count = 0U;
+    struct stat statbuf;
+
+    /* count descriptors until one isn't open. */
+    while (0 == fstat(start + (int)count, &statbuf))
+    {
+        ++count;
+    }
+
+    return count;
+}
@@ -135,6 +135,11 @@ int dataservice_decode_and_dispatch(
             return dataservice_decode_and_dispatch_block_make(
                 inst, sock, breq, payload_size);
 
+        /* handle block make from queue. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE:
+            return dataservice_decode_and_dispatch_block_make_from_queue(
+                inst, sock, breq, payload_size);
+
         /* handle block read. */
         case DATASERVICE_API_METHOD_APP_BLOCK_READ:
             return dataservice_decode_and_dispatch_block_read(
@@ -155,6 +160,21 @@ int dataservice_decode_and_dispatch(
             return dataservice_decode_and_dispatch_canonized_transaction_get(
                 inst, sock, breq, payload_size);
 
+        /* handle block notification subscribe. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE:
+            return dataservice_decode_and_dispatch_block_notify_subscribe(
+                inst, sock, breq, payload_size);
+
+        /* handle artifact watch. */
+        case DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH:
+            return dataservice_decode_and_dispatch_artifact_watch(
+                inst, sock, breq, payload_size);
+
+        /* handle block certificate read. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ:
+            return dataservice_decode_and_dispatch_block_cert_read(
+                inst, sock, breq, payload_size);
+
         /* unknown method.  Return an error. */
         default:
             /* make sure to write an error to the socket as well. */
@@ -0,0 +1,153 @@
+/**
+ * \file dataservice/dataservice_decode_and_dispatch_block_cert_read.c
+ *
+ * \brief Decode and dispatch the block certificate read request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Decode and dispatch a block certificate read request.
+ *
+ * The block is read under a read-only transaction, so that the certificate is
+ * not copied out of the database.  Only the requested slice is copied into the
+ * response.
+ *
+ * Returns 0 on success or non-fatal error.  If a non-zero error message is
+ * returned, then a fatal error has occurred that should not be recovered from.
+ * Any additional information on the socket is suspect.
+ *
+ * \param inst          The instance on which the dispatch occurs.
+ * \param sock          The socket on which the request was received and the
+ *                      response is to be written.
+ * \param req           The request to be decoded and dispatched.
+ * \param size          The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
+ *        written to the client socket.
+ */
+int dataservice_decode_and_dispatch_block_cert_read(
+    dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
+    size_t size)
+{
+    int retval = 0;
+    bool dispose_dreq = false;
+    void* payload = NULL;
+    size_t payload_size = 0U;
+    uint8_t* block_bytes = NULL;
+    size_t block_size = 0U;
+    dataservice_transaction_context_t txn;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != req);
+
+    /* block certificate read request structure. */
+    dataservice_request_block_cert_read_t dreq;
+
+    /* parse the request. */
+    retval = dataservice_decode_request_block_cert_read(req, size, &dreq);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* be sure to clean up dreq. */
+    dispose_dreq = true;
+
+    /* look up the child context. */
+    dataservice_child_context_t* ctx = NULL;
+    retval = dataservice_child_context_lookup(&ctx, inst, dreq.hdr.child_index);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* read the certificate in place under a read-only transaction. */
+    retval = dataservice_data_txn_begin(ctx, &txn, NULL, true);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* call the block get method. */
+    data_block_node_t node;
+    retval =
+        dataservice_block_get(
+            ctx, &txn, dreq.block_id, &node, &block_bytes, &block_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto transaction_abort;
+    }
+
+    /* the slice must start within the certificate. */
+    if (dreq.cert_offset > block_size)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_BAD;
+        goto transaction_abort;
+    }
+
+    /* clamp the slice to the certificate and to the largest slice. */
+    size_t slice_size = block_size - (size_t)dreq.cert_offset;
+    if (slice_size > dreq.max_size)
+    {
+        slice_size = dreq.max_size;
+    }
+    if (slice_size > DATASERVICE_BLOCK_CERT_READ_MAX_SIZE)
+    {
+        slice_size = DATASERVICE_BLOCK_CERT_READ_MAX_SIZE;
+    }
+
+    /* encode the payload. */
+    retval =
+        dataservice_encode_response_block_cert_read(
+            &payload, &payload_size, &node, block_bytes + dreq.cert_offset,
+            slice_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto transaction_abort;
+    }
+
+    /* success. Fall through. */
+
+transaction_abort:
+    dataservice_data_txn_abort(&txn);
+
+done:
+    /* write the status to the caller. */
+    retval =
+        dataservice_decode_and_dispatch_write_status(
+            sock, DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ,
+            dreq.hdr.child_index, (uint32_t)retval, payload, payload_size);
+
+    /* clean up payload bytes. */
+    if (NULL != payload)
+    {
+        memset(payload, 0, payload_size);
+        free(payload);
+    }
+
+    /* clean up dreq. */
+    if (dispose_dreq)
+    {
+        dispose((disposable_t*)&dreq);
+    }
+
+    return retval;
+}
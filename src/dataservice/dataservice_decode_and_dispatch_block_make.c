@@ -43,6 +43,7 @@ int dataservice_decode_and_dispatch_block_make(
 {
     int retval = 0;
     bool dispose_dreq = false;
+    bool block_made = false;
 
     /* parameter sanity check. */
     MODEL_ASSERT(NULL != inst);
@@ -74,6 +75,7 @@ int dataservice_decode_and_dispatch_block_make(
     retval =
         dataservice_block_make(
             ctx, NULL, dreq.block_id, dreq.cert, dreq.cert_size);
+    block_made = (AGENTD_STATUS_SUCCESS == retval);
 
     /* Fall through. */
 
@@ -84,6 +86,18 @@ done:
             sock, DATASERVICE_API_METHOD_APP_BLOCK_WRITE,
             dreq.hdr.child_index, (uint32_t)retval, NULL, 0);
 
+    /* signal the other data services that a block has been committed. */
+    if (block_made)
+    {
+        dataservice_block_publish(inst);
+    }
+
+    /* notify subscribers of the new block without waiting for the timer. */
+    if (AGENTD_STATUS_SUCCESS == retval && block_made)
+    {
+        retval = dataservice_block_notify_check(inst);
+    }
+
     /* clean up dreq. */
     if (dispose_dreq)
     {
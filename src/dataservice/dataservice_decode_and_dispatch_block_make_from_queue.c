@@ -0,0 +1,144 @@
+/**
+ * \file dataservice/dataservice_decode_and_dispatch_block_make_from_queue.c
+ *
+ * \brief Decode and dispatch the block make from queue request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Decode and dispatch a block make from queue request.
+ *
+ * Returns 0 on success or non-fatal error.  If a non-zero error message is
+ * returned, then a fatal error has occurred that should not be recovered from.
+ * Any additional information on the socket is suspect.
+ *
+ * \param inst          The instance on which the dispatch occurs.
+ * \param sock          The socket on which the request was received and the
+ *                      response is to be written.
+ * \param req           The request to be decoded and dispatched.
+ * \param size          The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
+ *        written to the client socket.
+ */
+int dataservice_decode_and_dispatch_block_make_from_queue(
+    dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
+    size_t size)
+{
+    int retval = 0;
+    bool dispose_dreq = false;
+    bool block_made = false;
+    void* payload = NULL;
+    size_t payload_size = 0U;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != inst);
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != req);
+
+    /* block make from queue request structure. */
+    dataservice_request_block_make_from_queue_t dreq;
+
+    /* parse the request payload. */
+    retval = dataservice_decode_request_block_make_from_queue(req, size, &dreq);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* be sure to clean up dreq. */
+    dispose_dreq = true;
+
+    /* a block must contain at least one transaction. */
+    if (0 == dreq.max_transactions)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_BAD;
+        goto done;
+    }
+
+    /* look up the child context. */
+    dataservice_child_context_t* ctx = NULL;
+    retval = dataservice_child_context_lookup(&ctx, inst, dreq.hdr.child_index);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* call the make block from queue method.  The hash buffer is large enough
+     * for the SHA-512 hash used by the Velo V1 crypto suite. */
+    uint8_t block_hash[64];
+    size_t block_hash_size = sizeof(block_hash);
+    size_t transaction_count = 0U;
+    retval =
+        dataservice_block_make_from_queue(
+            ctx, NULL, dreq.block_id, dreq.block_height,
+            dreq.max_transactions, dreq.max_block_size, block_hash,
+            &block_hash_size, &transaction_count);
+    block_made = (AGENTD_STATUS_SUCCESS == retval);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* encode the payload. */
+    retval =
+        dataservice_encode_response_block_make_from_queue(
+            &payload, &payload_size, dreq.block_id,
+            (uint32_t)transaction_count, block_hash, block_hash_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* success. Fall through. */
+
+done:
+    /* write the status to the caller. */
+    retval =
+        dataservice_decode_and_dispatch_write_status(
+            sock, DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE,
+            dreq.hdr.child_index, (uint32_t)retval, payload, payload_size);
+
+    /* signal the other data services that a block has been committed. */
+    if (block_made)
+    {
+        dataservice_block_publish(inst);
+    }
+
+    /* notify subscribers of the new block without waiting for the timer. */
+    if (AGENTD_STATUS_SUCCESS == retval && block_made)
+    {
+        retval = dataservice_block_notify_check(inst);
+    }
+
+    /* clean up the payload. */
+    if (NULL != payload)
+    {
+        memset(payload, 0, payload_size);
+        free(payload);
+    }
+
+    /* clean up dreq. */
+    if (dispose_dreq)
+    {
+        dispose((disposable_t*)&dreq);
+    }
+
+    return retval;
+}
@@ -0,0 +1,83 @@
+/**
+ * \file dataservice/dataservice_decode_request_block_cert_read.c
+ *
+ * \brief Decode the block certificate read request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Decode a block certificate read request.
+ *
+ * \param req           The request payload to parse.
+ * \param size          The size of this request payload.
+ * \param dreq          The request structure into which this request is
+ *                      decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE if the request
+ *        packet payload size is incorrect.
+ */
+int dataservice_decode_request_block_cert_read(
+    const void* req, size_t size,
+    dataservice_request_block_cert_read_t* dreq)
+{
+    int retval = AGENTD_STATUS_SUCCESS;
+    uint64_t net_cert_offset;
+    uint32_t net_max_size;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != req);
+    MODEL_ASSERT(NULL != dreq);
+
+    /* make working with the request more convenient. */
+    const uint8_t* breq = (const uint8_t*)req;
+
+    /* initialize the request structure. */
+    retval = dataservice_request_init(&breq, &size, &dreq->hdr, sizeof(*dreq));
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the remaining payload is the block id, offset, and maximum size. */
+    if (size !=
+            sizeof(dreq->block_id) + sizeof(net_cert_offset)
+                + sizeof(net_max_size))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE;
+        goto cleanup_dreq;
+    }
+
+    /* copy the block_id. */
+    memcpy(dreq->block_id, breq, sizeof(dreq->block_id));
+    breq += sizeof(dreq->block_id);
+
+    /* copy the certificate offset. */
+    memcpy(&net_cert_offset, breq, sizeof(net_cert_offset));
+    dreq->cert_offset = ntohll(net_cert_offset);
+    breq += sizeof(net_cert_offset);
+
+    /* copy the maximum slice size. */
+    memcpy(&net_max_size, breq, sizeof(net_max_size));
+    dreq->max_size = ntohl(net_max_size);
+
+    /* success. dreq contents are owned by the caller. */
+    goto done;
+
+cleanup_dreq:
+    /* we failed, so don't pass dreq contents to the caller. */
+    dispose((disposable_t*)dreq);
+
+done:
+    return retval;
+}
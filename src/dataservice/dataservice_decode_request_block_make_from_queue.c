@@ -0,0 +1,88 @@
+/**
+ * \file dataservice/dataservice_decode_request_block_make_from_queue.c
+ *
+ * \brief Decode the block make from queue request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Decode a make block from queue request.
+ *
+ * \param req           The request payload to parse.
+ * \param size          The size of this request payload.
+ * \param dreq          The request structure into which this request is
+ *                      decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE if the request
+ *        packet payload size is incorrect.
+ */
+int dataservice_decode_request_block_make_from_queue(
+    const void* req, size_t size,
+    dataservice_request_block_make_from_queue_t* dreq)
+{
+    int retval = AGENTD_STATUS_SUCCESS;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != req);
+    MODEL_ASSERT(NULL != dreq);
+
+    /* make working with the request more convenient. */
+    const uint8_t* breq = (const uint8_t*)req;
+
+    /* initialize the request structure. */
+    retval = dataservice_request_init(&breq, &size, &dreq->hdr, sizeof(*dreq));
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* the remaining payload size must be equal to the block id, block height,
+     * and limits. */
+    if (size != sizeof(dreq->block_id) + sizeof(dreq->block_height) + sizeof(dreq->max_transactions) + sizeof(dreq->max_block_size))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE;
+        goto cleanup_dreq;
+    }
+
+    /* copy the block id. */
+    memcpy(dreq->block_id, breq, sizeof(dreq->block_id));
+    breq += sizeof(dreq->block_id);
+
+    /* copy and decode the block height. */
+    uint64_t net_block_height;
+    memcpy(&net_block_height, breq, sizeof(net_block_height));
+    dreq->block_height = ntohll(net_block_height);
+    breq += sizeof(net_block_height);
+
+    /* copy and decode the maximum transaction count. */
+    uint32_t net_max_transactions;
+    memcpy(&net_max_transactions, breq, sizeof(net_max_transactions));
+    dreq->max_transactions = ntohl(net_max_transactions);
+    breq += sizeof(net_max_transactions);
+
+    /* copy and decode the maximum block size. */
+    uint32_t net_max_block_size;
+    memcpy(&net_max_block_size, breq, sizeof(net_max_block_size));
+    dreq->max_block_size = ntohl(net_max_block_size);
+
+    /* success. dreq contents are owned by the caller. */
+    goto done;
+
+cleanup_dreq:
+    /* we failed, so don't pass dreq contents to the caller. */
+    dispose((disposable_t*)dreq);
+
+done:
+    return retval;
+}
@@ -0,0 +1,129 @@
+/**
+ * \file dataservice/dataservice_decode_response_artifact_notify.c
+ *
+ * \brief Decode an artifact update notification.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/async_api.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Decode an artifact update notification.
+ *
+ * \param resp          The notification payload to parse.
+ * \param size          The size of this notification payload.
+ * \param dresp         The decoded response structure into which this
+ *                      notification is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the
+ *        notification packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        packet is not an artifact update notification.
+ */
+int dataservice_decode_response_artifact_notify(
+    const void* resp, size_t size,
+    dataservice_response_artifact_notify_t* dresp)
+{
+    int retval = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != resp);
+    MODEL_ASSERT(NULL != dresp);
+
+    /* runtime sanity checks. */
+    if (NULL == resp || NULL == dresp)
+    {
+        return AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER;
+    }
+
+    /* | Artifact update notification packet.                               | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE        |  4 bytes     | */
+    /* | offset                                              |  4 bytes     | */
+    /* | status                                              |  4 bytes     | */
+    /* | artifact_id                                         | 16 bytes     | */
+    /* | txn_latest                                          | 16 bytes     | */
+    /* | height_latest                                       |  8 bytes     | */
+    /* | state_latest                                        |  4 bytes     | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    /* clear the response structure. */
+    memset(dresp, 0, sizeof(*dresp));
+
+    /* by default, the disposer is the memset disposer. */
+    dresp->hdr.hdr.dispose = &dataservice_decode_response_memset_disposer;
+    dresp->hdr.payload_size = 0U;
+
+    /* val is easier to work with. */
+    const uint32_t* val = (const uint32_t*)resp;
+
+    /* the size should be equal to the size we expect. */
+    uint32_t response_packet_size =
+        /* size of the API method. */
+        sizeof(uint32_t) +
+        /* size of the offset. */
+        sizeof(uint32_t) +
+        /* size of the status. */
+        sizeof(uint32_t) +
+        /* size of the artifact id and latest transaction id. */
+        2 * 16 +
+        /* size of the latest height. */
+        sizeof(uint64_t) +
+        /* size of the latest state. */
+        sizeof(uint32_t);
+    if (size != response_packet_size)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE;
+        goto done;
+    }
+
+    /* verify that the method code is the code we expect. */
+    dresp->hdr.method_code = ntohl(val[0]);
+    if (DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE != dresp->hdr.method_code)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE;
+        goto done;
+    }
+
+    /* get the offset. */
+    dresp->hdr.offset = ntohl(val[1]);
+
+    /* get the status code. */
+    dresp->hdr.status = ntohl(val[2]);
+
+    /* set the payload size. */
+    dresp->hdr.payload_size = sizeof(*dresp) - sizeof(dresp->hdr);
+
+    /* copy the artifact id and latest transaction id. */
+    const uint8_t* bval = (const uint8_t*)(val + 3);
+    memcpy(dresp->artifact_id, bval, sizeof(dresp->artifact_id));
+    memcpy(dresp->txn_latest, bval + 16, sizeof(dresp->txn_latest));
+
+    /* copy the latest height and state. */
+    uint64_t net_height;
+    memcpy(&net_height, bval + 32, sizeof(net_height));
+    dresp->height_latest = ntohll(net_height);
+
+    uint32_t net_state;
+    memcpy(&net_state, bval + 40, sizeof(net_state));
+    dresp->state_latest = ntohl(net_state);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+    /* fall-through. */
+
+done:
+    return retval;
+}
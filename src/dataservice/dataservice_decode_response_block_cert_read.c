@@ -0,0 +1,144 @@
+/**
+ * \file dataservice/dataservice_decode_response_block_cert_read.c
+ *
+ * \brief Decode the response from the block certificate read api method.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/async_api.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Decode a response from the block certificate read request.
+ *
+ * \param resp          The response payload to parse.
+ * \param size          The size of this response payload.
+ * \param dresp         The decoded response structure into which this response
+ *                      is decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE if the response
+ *        packet payload size is incorrect.
+ *      - AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER if one of the
+ *        parameters to the function is invalid.
+ *      - AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE if the
+ *        response is not a block certificate read response.
+ */
+int dataservice_decode_response_block_cert_read(
+    const void* resp, size_t size,
+    dataservice_response_block_cert_read_t* dresp)
+{
+    int retval = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != resp);
+    MODEL_ASSERT(NULL != dresp);
+
+    /* runtime sanity checks. */
+    if (NULL == resp || NULL == dresp)
+    {
+        return AGENTD_ERROR_DATASERVICE_RESPONSE_INVALID_PARAMETER;
+    }
+
+    /* | Block certificate read response packet.                            | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ          |  4 bytes     | */
+    /* | offset                                              |  4 bytes     | */
+    /* | status                                              |  4 bytes     | */
+    /* | node:                                               | 80 bytes     | */
+    /* |    key                                              | 16 bytes     | */
+    /* |    prev                                             | 16 bytes     | */
+    /* |    next                                             | 16 bytes     | */
+    /* |    first_transaction_id                             | 16 bytes     | */
+    /* |    block_height                                     |  8 bytes     | */
+    /* |    block_cert_size                                  |  8 bytes     | */
+    /* | certificate slice                                   | n - 80 bytes | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    /* clear dresp. */
+    memset(dresp, 0, sizeof(*dresp));
+
+    /* by default, the disposer is the memset disposer. */
+    dresp->hdr.hdr.dispose = &dataservice_decode_response_memset_disposer;
+    dresp->hdr.payload_size = 0U;
+
+    /* val is easier to work with. */
+    const uint32_t* val = (const uint32_t*)resp;
+
+    /* the size of the node. */
+    const size_t node_size = 4 * 16 + 2 * sizeof(uint64_t);
+
+    /* the size should be at least large enough for the header. */
+    const size_t response_packet_size = 3 * sizeof(uint32_t);
+    if (size < response_packet_size)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE;
+        goto done;
+    }
+
+    /* verify that the method code is the code we expect. */
+    dresp->hdr.method_code = ntohl(val[0]);
+    if (DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ != dresp->hdr.method_code)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE;
+        goto done;
+    }
+
+    /* get the offset. */
+    dresp->hdr.offset = ntohl(val[1]);
+
+    /* get the status code. */
+    dresp->hdr.status = ntohl(val[2]);
+    if (AGENTD_STATUS_SUCCESS != dresp->hdr.status)
+    {
+        retval = AGENTD_STATUS_SUCCESS;
+        goto done;
+    }
+
+    /* if successful, the size should be large enough to hold the node. */
+    if (size < response_packet_size + node_size)
+    {
+        retval = AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE;
+        goto done;
+    }
+
+    /* get the raw data. */
+    const uint8_t* bval = (const uint8_t*)(val + 3);
+
+    /* copy the node. */
+    memcpy(dresp->node.key, bval, sizeof(dresp->node.key));
+    memcpy(dresp->node.prev, bval + 16, sizeof(dresp->node.prev));
+    memcpy(dresp->node.next, bval + 32, sizeof(dresp->node.next));
+    memcpy(dresp->node.first_transaction_id, bval + 48,
+        sizeof(dresp->node.first_transaction_id));
+    memcpy(&dresp->node.net_block_height, bval + 64,
+        sizeof(dresp->node.net_block_height));
+    memcpy(&dresp->node.net_block_cert_size, bval + 72,
+        sizeof(dresp->node.net_block_cert_size));
+
+    /* the slice follows the node, and can't be larger than the certificate. */
+    dresp->data = bval + node_size;
+    dresp->data_size = size - response_packet_size - node_size;
+    if (dresp->data_size
+        > (uint64_t)ntohll(dresp->node.net_block_cert_size))
+    {
+        retval = AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE;
+        goto done;
+    }
+
+    /* set the payload size. */
+    dresp->hdr.payload_size = sizeof(*dresp) - sizeof(dresp->hdr);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
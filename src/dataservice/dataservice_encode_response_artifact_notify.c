@@ -0,0 +1,67 @@
+/**
+ * \file dataservice/dataservice_encode_response_artifact_notify.c
+ *
+ * \brief Encode an artifact update notification payload.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Encode an artifact update notification payload packet.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param record            The updated artifact record.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_artifact_notify(
+    void** payload, size_t* payload_size, const data_artifact_record_t* record)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != payload);
+    MODEL_ASSERT(NULL != payload_size);
+    MODEL_ASSERT(NULL != record);
+
+    /* | Artifact update notification payload.                             | */
+    /* | -------------------------------------------------- | ------------ | */
+    /* | DATA                                               | SIZE         | */
+    /* | -------------------------------------------------- | ------------ | */
+    /* | artifact_id                                        | 16 bytes     | */
+    /* | txn_latest                                         | 16 bytes     | */
+    /* | height_latest                                      |  8 bytes     | */
+    /* | state_latest                                       |  4 bytes     | */
+    /* | -------------------------------------------------- | ------------ | */
+
+    /* create the payload. */
+    *payload_size = 2U * 16U + sizeof(uint64_t) + sizeof(uint32_t);
+    uint8_t* buf = (uint8_t*)malloc(*payload_size);
+    if (NULL == buf)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* the record fields are already in network order. */
+    memcpy(buf, record->key, 16);
+    memcpy(buf + 16, record->txn_latest, 16);
+    memcpy(buf + 32, &record->net_height_latest, sizeof(uint64_t));
+    memcpy(buf + 40, &record->net_state_latest, sizeof(uint32_t));
+
+    *payload = buf;
+
+    return AGENTD_STATUS_SUCCESS;
+}
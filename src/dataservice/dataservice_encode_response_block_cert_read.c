@@ -0,0 +1,73 @@
+/**
+ * \file dataservice/dataservice_encode_response_block_cert_read.c
+ *
+ * \brief Encode the response for the block certificate read request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Encode a block certificate read response payload packet.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param node              The block node, whose certificate size is the size
+ *                          of the whole certificate.
+ * \param cert_slice        Pointer to the slice of the block certificate.
+ * \param cert_slice_size   Size of the slice of the block certificate.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_block_cert_read(
+    void** payload, size_t* payload_size, const data_block_node_t* node,
+    const void* cert_slice, size_t cert_slice_size)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != payload);
+    MODEL_ASSERT(NULL != payload_size);
+    MODEL_ASSERT(NULL != node);
+    MODEL_ASSERT(NULL != cert_slice || 0U == cert_slice_size);
+
+    /* the node is followed by the certificate slice. */
+    *payload_size = 4 * 16 + 2 * sizeof(uint64_t) + cert_slice_size;
+
+    /* create the payload. */
+    *payload = (uint8_t*)malloc(*payload_size);
+    uint8_t* payload_bytes = (uint8_t*)*payload;
+    if (NULL == payload_bytes)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* copy the node values to the payload. */
+    memcpy(payload_bytes, node->key, 16);
+    memcpy(payload_bytes + 16, node->prev, 16);
+    memcpy(payload_bytes + 32, node->next, 16);
+    memcpy(payload_bytes + 48, node->first_transaction_id, 16);
+    memcpy(payload_bytes + 64, &node->net_block_height, sizeof(uint64_t));
+    memcpy(payload_bytes + 72, &node->net_block_cert_size, sizeof(uint64_t));
+
+    /* copy the certificate slice to the payload. */
+    if (cert_slice_size > 0U)
+    {
+        memcpy(payload_bytes + 80, cert_slice, cert_slice_size);
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
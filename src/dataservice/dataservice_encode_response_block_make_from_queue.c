@@ -0,0 +1,78 @@
+/**
+ * \file dataservice/dataservice_encode_response_block_make_from_queue.c
+ *
+ * \brief Encode the response to the block make from queue request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Encode a make block from queue response payload packet.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param block_id          Pointer to the block UUID.
+ * \param transaction_count The number of transactions in this block.
+ * \param block_hash        Pointer to the block hash.
+ * \param block_hash_size   The size of the block hash.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_block_make_from_queue(
+    void** payload, size_t* payload_size, const uint8_t* block_id,
+    uint32_t transaction_count, const void* block_hash,
+    size_t block_hash_size)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != payload);
+    MODEL_ASSERT(NULL != payload_size);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(NULL != block_hash);
+
+    /* | Block make from queue response payload.                         | */
+    /* | ------------------------------------------------ | ------------ | */
+    /* | DATA                                             | SIZE         | */
+    /* | ------------------------------------------------ | ------------ | */
+    /* | block_id                                         | 16 bytes     | */
+    /* | transaction_count                                |  4 bytes     | */
+    /* | block_hash                                       | n - 20 bytes | */
+    /* | ------------------------------------------------ | ------------ | */
+
+    /* create the payload. */
+    *payload_size = 16U + sizeof(uint32_t) + block_hash_size;
+    *payload = malloc(*payload_size);
+    if (NULL == *payload)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* make working with the payload more convenient. */
+    uint8_t* bpayload = (uint8_t*)*payload;
+
+    /* copy the block id to the payload. */
+    memcpy(bpayload, block_id, 16);
+
+    /* copy the transaction count to the payload. */
+    uint32_t net_transaction_count = htonl(transaction_count);
+    memcpy(bpayload + 16, &net_transaction_count, sizeof(uint32_t));
+
+    /* copy the block hash to the payload. */
+    memcpy(bpayload + 16 + sizeof(uint32_t), block_hash, block_hash_size);
+
+    return AGENTD_STATUS_SUCCESS;
+}
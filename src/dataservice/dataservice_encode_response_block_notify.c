@@ -0,0 +1,72 @@
+/**
+ * \file dataservice/dataservice_encode_response_block_notify.c
+ *
+ * \brief Encode a block notification payload.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_protocol_internal.h"
+
+/**
+ * \brief Encode a block notification payload packet.
+ *
+ * This payload is used both for the block notification subscribe response and
+ * for each block commit notification.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param block_id          Pointer to the block UUID.
+ * \param height            The height of this block.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_block_notify(
+    void** payload, size_t* payload_size, const uint8_t* block_id,
+    uint64_t height)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != payload);
+    MODEL_ASSERT(NULL != payload_size);
+    MODEL_ASSERT(NULL != block_id);
+
+    /* | Block notification payload.                                       | */
+    /* | -------------------------------------------------- | ------------ | */
+    /* | DATA                                               | SIZE         | */
+    /* | -------------------------------------------------- | ------------ | */
+    /* | block_id                                           | 16 bytes     | */
+    /* | height                                             |  8 bytes     | */
+    /* | -------------------------------------------------- | ------------ | */
+
+    /* create the payload. */
+    *payload_size = 16U + sizeof(uint64_t);
+    uint8_t* buf = (uint8_t*)malloc(*payload_size);
+    if (NULL == buf)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* copy the block id to the payload. */
+    memcpy(buf, block_id, 16);
+
+    /* copy the block height to the payload. */
+    uint64_t net_height = htonll(height);
+    memcpy(buf + 16, &net_height, sizeof(net_height));
+
+    *payload = buf;
+
+    return AGENTD_STATUS_SUCCESS;
+}
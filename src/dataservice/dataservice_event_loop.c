@@ -25,6 +25,19 @@
  *                      requests on this socket and sends responses.
  * \param logsock       The logging service socket.  The data service logs data
  *                      on this socket.
+ * \param ring          Optional shared-memory ring, or NULL.  When set, the
+ *                      data service also serves requests on the right-hand
+ *                      side of this ring, and sends notifications there.  The
+ *                      event loop takes ownership of these descriptors.
+ * \param blocksubscribe    Optional socket on which another data service
+ *                          signals each block that it commits, or -1.  When
+ *                          set, subscribers are notified as soon as a block
+ *                          is signaled, and the block notification timer is
+ *                          only a fallback.
+ * \param blockpublish_start    The first of blockpublish_count consecutive
+ *                              sockets on which this data service signals
+ *                              each block that it commits.
+ * \param blockpublish_count    The number of block publish sockets.
  *
  * \returns a status code on service exit indicating a normal or abnormal exit.
  *          - AGENTD_STATUS_SUCCESS on normal exit.
@@ -34,17 +47,32 @@
  *            make the process socket non-blocking failed.
  *          - AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_INIT_FAILURE if
  *            initializing the event loop failed.
+ *          - AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID if
+ *            AGENTD_BLOCK_NOTIFY_MILLISECONDS is malformed or out of range.
+ *          - AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID if
+ *            AGENTD_DATASERVICE_LOW_WATERMARK or
+ *            AGENTD_DATASERVICE_HIGH_WATERMARK is malformed or out of range.
+ *          - any of the errors returned by
+ *            \ref ipc_set_watermarks_noblock().
+ *          - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the block notification
+ *            timer could not be created.
  *          - AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_ADD_FAILURE if adding the
  *            dataservice socket to the event loop failed.
  *          - AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_RUN_FAILURE if running the
  *            dataservice event loop failed.
  */
-int dataservice_event_loop(int datasock, int UNUSED(logsock))
+int dataservice_event_loop(
+    int datasock, int UNUSED(logsock), const ipc_ring_descriptors_t* ring,
+    int blocksubscribe, int blockpublish_start, size_t blockpublish_count)
 {
     int retval = 0;
     dataservice_instance_t* instance = NULL;
     ipc_socket_context_t data;
+    ipc_socket_context_t ringsock;
+    ipc_socket_context_t subscribesock;
     ipc_event_loop_context_t loop;
+    uint32_t block_notify_milliseconds;
+    size_t low_watermark, high_watermark;
 
     /* parameter sanity checking. */
     MODEL_ASSERT(datasock >= 0);
@@ -75,9 +103,88 @@ int dataservice_event_loop(int datasock, int UNUSED(logsock))
     /* set a reference to the event loop in the instance. */
     instance->loop_context = &loop;
 
+    /* open our side of the ring, if we were given one. */
+    if (NULL != ring)
+    {
+        retval =
+            ipc_make_ring_noblock(
+                ring->memfd, IPC_RING_SIDE_RHS, ring->rhs, ring->lhs,
+                &ringsock, instance);
+
+        /* the socket context keeps its own handles to the ring. */
+        close(ring->memfd);
+        close(ring->lhs);
+
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            close(ring->rhs);
+            retval = AGENTD_ERROR_DATASERVICE_IPC_MAKE_NOBLOCK_FAILURE;
+            goto cleanup_loop;
+        }
+    }
+
+    /* notifications are written to the ring if there is one, since that is
+     * where the client reads its responses, and to the data socket
+     * otherwise. */
+    instance->sock = (NULL != ring) ? &ringsock : &data;
+
+    /* signal committed blocks on the block publish sockets. */
+    instance->block_publish_start = blockpublish_start;
+    instance->block_publish_count = blockpublish_count;
+
+    /* watch the block subscribe socket, if we were given one. */
+    if (blocksubscribe >= 0)
+    {
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_make_noblock(blocksubscribe, &subscribesock, instance))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_IPC_MAKE_NOBLOCK_FAILURE;
+            goto cleanup_ring;
+        }
+    }
+
+    /* get the interval at which to watch for new blocks. */
+    retval =
+        dataservice_block_notify_interval_get(
+            blocksubscribe >= 0, &block_notify_milliseconds);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_subscribesock;
+    }
+
+    /* get the watermarks at which to pause and resume reading requests. */
+    retval = dataservice_watermarks_get(&low_watermark, &high_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_subscribesock;
+    }
+
+    /* create the timer that watches for new blocks on behalf of block
+     * notification subscribers. */
+    retval =
+        ipc_timer_init(
+            &instance->block_notify_timer, block_notify_milliseconds,
+            &dataservice_block_notify_timer_cb, instance);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_subscribesock;
+    }
+
     /* set the read, write, and error callbacks for the data socket. */
     ipc_set_readcb_noblock(&data, &dataservice_ipc_read, NULL);
 
+    /* batch the responses to a burst of requests into a single write. */
+    ipc_set_cork_noblock(&data, true);
+
+    /* stop reading requests while too many responses are waiting. */
+    retval =
+        ipc_set_watermarks_noblock(
+            &data, low_watermark, high_watermark, &dataservice_ipc_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_timer;
+    }
+
     /* on these signals, leave the event loop and shut down gracefully. */
     ipc_exit_loop_on_signal(&loop, SIGHUP);
     ipc_exit_loop_on_signal(&loop, SIGTERM);
@@ -87,19 +194,68 @@ int dataservice_event_loop(int datasock, int UNUSED(logsock))
     if (AGENTD_STATUS_SUCCESS != ipc_event_loop_add(&loop, &data))
     {
         retval = AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
-        goto cleanup_loop;
+        goto cleanup_timer;
+    }
+
+    /* the ring is served exactly like the data socket. */
+    if (NULL != ring)
+    {
+        ipc_set_readcb_noblock(&ringsock, &dataservice_ipc_read, NULL);
+        ipc_set_cork_noblock(&ringsock, true);
+        retval =
+            ipc_set_watermarks_noblock(
+                &ringsock, low_watermark, high_watermark,
+                &dataservice_ipc_watermark);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_timer;
+        }
+
+        if (AGENTD_STATUS_SUCCESS != ipc_event_loop_add(&loop, &ringsock))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
+            goto cleanup_timer;
+        }
+    }
+
+    /* check for a new block each time that one is signaled. */
+    if (blocksubscribe >= 0)
+    {
+        ipc_set_readcb_noblock(
+            &subscribesock, &dataservice_block_subscribe_read, NULL);
+
+        if (AGENTD_STATUS_SUCCESS != ipc_event_loop_add(&loop, &subscribesock))
+        {
+            retval = AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
+            goto cleanup_timer;
+        }
     }
 
     /* run the ipc event loop. */
     if (AGENTD_STATUS_SUCCESS != ipc_event_loop_run(&loop))
     {
         retval = AGENTD_ERROR_DATASERVICE_IPC_EVENT_LOOP_RUN_FAILURE;
-        goto cleanup_loop;
+        goto cleanup_timer;
     }
 
     /* success. */
     retval = AGENTD_STATUS_SUCCESS;
 
+cleanup_timer:
+    dispose((disposable_t*)&instance->block_notify_timer);
+
+cleanup_subscribesock:
+    if (blocksubscribe >= 0)
+    {
+        dispose((disposable_t*)&subscribesock);
+    }
+
+cleanup_ring:
+    if (NULL != ring)
+    {
+        dispose((disposable_t*)&ringsock);
+    }
+
 cleanup_loop:
     dispose((disposable_t*)&loop);
 
@@ -62,6 +62,9 @@ static void dataservice_instance_dispose(void* disposable)
     /* parameter sanity check. */
     MODEL_ASSERT(NULL != instance);
 
+    /* release the artifact watches held by any children. */
+    dataservice_artifact_watch_index_dispose(instance);
+
     /* dispose any children that need to be disposed. */
     for (size_t i = 0; i < DATASERVICE_MAX_CHILD_CONTEXTS; ++i)
     {
@@ -34,6 +34,21 @@ typedef struct dataservice_database_details
     MDB_dbi height_db;
 } dataservice_database_details_t;
 
+/**
+ * \brief An artifact watched by a child context.
+ *
+ * Each watch is on two lists: its bucket in the instance's watch index, which
+ * is searched when an artifact is updated, and its child context's list of
+ * watches, which is walked when the child context is closed.
+ */
+typedef struct dataservice_artifact_watch
+{
+    struct dataservice_artifact_watch* bucket_next;
+    struct dataservice_artifact_watch* child_next;
+    uint32_t child_index;
+    uint8_t artifact_id[16];
+} dataservice_artifact_watch_t;
+
 /**
  * \brief Child details.
  */
@@ -42,6 +57,9 @@ typedef struct dataservice_child_details
     disposable_t hdr;
     struct dataservice_child_details* next;
     dataservice_child_context_t ctx;
+    bool block_notify;
+    dataservice_artifact_watch_t* artifact_watches;
+    size_t artifact_watch_count;
 } dataservice_child_details_t;
 
 /**
@@ -49,6 +67,59 @@ typedef struct dataservice_child_details
  */
 #define DATASERVICE_MAX_CHILD_CONTEXTS 1024
 
+/**
+ * \brief Stop reading requests once this many response bytes are waiting to be
+ * written, and start again once the backlog drains below the low watermark.
+ */
+#define DATASERVICE_WRITEBUF_HIGH_WATERMARK (32U * 1024U * 1024U)
+#define DATASERVICE_WRITEBUF_LOW_WATERMARK (8U * 1024U * 1024U)
+
+/**
+ * \brief The range allowed for AGENTD_DATASERVICE_LOW_WATERMARK and
+ * AGENTD_DATASERVICE_HIGH_WATERMARK.
+ */
+#define DATASERVICE_WATERMARK_MIN (4U * 1024U)
+#define DATASERVICE_WATERMARK_MAX (1024U * 1024U * 1024U)
+
+/**
+ * \brief How often, in milliseconds, the latest block is checked while any
+ * child context is subscribed to block notifications, unless
+ * AGENTD_BLOCK_NOTIFY_MILLISECONDS is set.
+ *
+ * Blocks are usually made by the data service instance owned by the
+ * canonization service, so a data service that isn't signaled of commits
+ * finds them by watching the shared database.  Each check is one read-only
+ * database transaction in each data service with a subscriber.
+ */
+#define DATASERVICE_BLOCK_NOTIFY_MILLISECONDS 100U
+
+/**
+ * \brief The range allowed for AGENTD_BLOCK_NOTIFY_MILLISECONDS.
+ */
+#define DATASERVICE_BLOCK_NOTIFY_MILLISECONDS_MIN 10U
+#define DATASERVICE_BLOCK_NOTIFY_MILLISECONDS_MAX 60000U
+
+/**
+ * \brief How often, in milliseconds, the latest block is checked by a data
+ * service that is signaled when a block is committed, unless
+ * AGENTD_BLOCK_NOTIFY_MILLISECONDS is set.
+ *
+ * The signal notifies subscribers as soon as a block is committed, so this
+ * check only catches a block whose signal was lost.
+ */
+#define DATASERVICE_BLOCK_NOTIFY_FALLBACK_MILLISECONDS 5000U
+
+/**
+ * \brief The most artifacts that a single child context can watch.
+ */
+#define DATASERVICE_ARTIFACT_WATCH_MAX_PER_CHILD 65536U
+
+/**
+ * \brief The largest block certificate slice returned by a single block
+ * certificate read.
+ */
+#define DATASERVICE_BLOCK_CERT_READ_MAX_SIZE IPC_STREAM_MAX_CHUNK_SIZE
+
 /**
  * \brief The database service instance.
  */
@@ -60,6 +131,16 @@ typedef struct dataservice_instance
     dataservice_child_details_t* child_head;
     bool dataservice_force_exit;
     ipc_event_loop_context_t* loop_context;
+    ipc_socket_context_t* sock;
+    ipc_timer_context_t block_notify_timer;
+    bool block_notify_timer_armed;
+    size_t block_notify_count;
+    uint8_t block_notify_latest[16];
+    dataservice_artifact_watch_t** artifact_watch_buckets;
+    size_t artifact_watch_bucket_count;
+    size_t artifact_watch_count;
+    int block_publish_start;
+    size_t block_publish_count;
 } dataservice_instance_t;
 
 /**
@@ -170,8 +251,6 @@ int dataservice_child_context_lookup(
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -198,8 +277,6 @@ int dataservice_transaction_drop_internal(
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -211,6 +288,47 @@ int dataservice_transaction_promote_internal(
     dataservice_child_context_t* child,
     dataservice_transaction_context_t* dtxn_ctx, const uint8_t* txn_id);
 
+/**
+ * \brief Replace the header of a stored transaction node.
+ *
+ * The node is rewritten with an MDB_RESERVE put of the same size, so the
+ * header is written directly into the database page and the certificate is
+ * only copied if LMDB had to move the record to a new page.
+ *
+ * \param txn           The database transaction for this update.
+ * \param dbi           The database holding this node.
+ * \param key           The key of this node.
+ * \param old_val       The current value of this node, as read under txn
+ *                      with no intervening writes.
+ * \param header        The updated header for this node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        put to the database.
+ */
+int dataservice_transaction_node_header_put(
+    MDB_txn* txn, MDB_dbi dbi, const uint8_t* key, const MDB_val* old_val,
+    const data_transaction_node_t* header);
+
+/**
+ * \brief Replace the header of the transaction node under a cursor.
+ *
+ * \param cursor        A cursor positioned on this node.
+ * \param key           The key of this node.
+ * \param old_val       The current value of this node, as read through the
+ *                      cursor with no intervening writes.
+ * \param header        The updated header for this node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        put to the database.
+ */
+int dataservice_transaction_node_header_cursor_put(
+    MDB_cursor* cursor, const uint8_t* key, const MDB_val* old_val,
+    const data_transaction_node_t* header);
+
 /**
  * \brief Decode and dispatch requests received by the data service.
  *
@@ -254,8 +372,6 @@ int dataservice_decode_and_dispatch(
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
- *        encountered in this operation.
  *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
  *        written to the client socket.
  */
@@ -575,6 +691,30 @@ int dataservice_decode_and_dispatch_block_make(
     dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
     size_t size);
 
+/**
+ * \brief Decode and dispatch a block make from queue request.
+ *
+ * Returns 0 on success or non-fatal error.  If a non-zero error message is
+ * returned, then a fatal error has occurred that should not be recovered from.
+ * Any additional information on the socket is suspect.
+ *
+ * \param inst          The instance on which the dispatch occurs.
+ * \param sock          The socket on which the request was received and the
+ *                      response is to be written.
+ * \param req           The request to be decoded and dispatched.
+ * \param size          The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
+ *        written to the client socket.
+ */
+int dataservice_decode_and_dispatch_block_make_from_queue(
+    dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
+    size_t size);
+
 /**
  * \brief Decode and dispatch a block read request.
  *
@@ -599,6 +739,30 @@ int dataservice_decode_and_dispatch_block_read(
     dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
     size_t size);
 
+/**
+ * \brief Decode and dispatch a block certificate read request.
+ *
+ * Returns 0 on success or non-fatal error.  If a non-zero error message is
+ * returned, then a fatal error has occurred that should not be recovered from.
+ * Any additional information on the socket is suspect.
+ *
+ * \param inst          The instance on which the dispatch occurs.
+ * \param sock          The socket on which the request was received and the
+ *                      response is to be written.
+ * \param req           The request to be decoded and dispatched.
+ * \param size          The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
+ *        written to the client socket.
+ */
+int dataservice_decode_and_dispatch_block_cert_read(
+    dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
+    size_t size);
+
 /**
  * \brief Decode and dispatch a block id read by height request.
  *
@@ -697,6 +861,21 @@ void dataservice_ipc_read(
 void dataservice_ipc_write(
     ipc_socket_context_t* ctx, int event_flags, void* user_context);
 
+/**
+ * \brief Watermark callback for the data service protocol socket.
+ *
+ * Reads on the protocol socket are paused while its write buffer is above the
+ * high watermark, so that a peer which stops reading responses cannot grow
+ * the write buffer without bound.
+ *
+ * \param ctx           The non-blocking socket context.
+ * \param above         true if the write buffer crossed the high watermark,
+ *                      false if it drained below the low watermark.
+ * \param user_context  The user context for this socket.
+ */
+void dataservice_ipc_watermark(
+    ipc_socket_context_t* ctx, bool above, void* user_context);
+
 /**
  * \brief Set up a clean re-entry from the event loop and ensure that no other
  * callbacks occur by setting the appropriate force exit flag.
@@ -705,6 +884,285 @@ void dataservice_ipc_write(
  */
 void dataservice_exit_event_loop(dataservice_instance_t* instance);
 
+/**
+ * \brief Decode and dispatch a block notification subscribe request.
+ *
+ * Returns 0 on success or non-fatal error.  If a non-zero error message is
+ * returned, then a fatal error has occurred that should not be recovered from.
+ * Any additional information on the socket is suspect.
+ *
+ * \param inst          The instance on which the dispatch occurs.
+ * \param sock          The socket on which the request was received and the
+ *                      response is to be written.
+ * \param req           The request to be decoded and dispatched.
+ * \param size          The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
+ *        written to the client socket.
+ */
+int dataservice_decode_and_dispatch_block_notify_subscribe(
+    dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
+    size_t size);
+
+/**
+ * \brief Subscribe a child context to block commit notifications.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context to subscribe.
+ * \param block_id      Pointer to the block UUID (16 bytes) to set to the
+ *                      latest block ID at the time of subscription.
+ * \param height        Pointer to the height to set to the latest block
+ *                      height at the time of subscription.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_BAD_INDEX if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_INVALID if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this child context is not
+ *        authorized to read the latest block ID.
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_latest_get().
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_timer_arm().
+ */
+int dataservice_block_notify_subscribe(
+    dataservice_instance_t* inst, uint32_t offset, uint8_t* block_id,
+    uint64_t* height);
+
+/**
+ * \brief Read the latest block ID and height for block notifications.
+ *
+ * This reads the database directly, without a capabilities check, and so
+ * SHOULD NOT BE USED OUTSIDE OF THE DATA SERVICE.
+ *
+ * \param inst          The data service instance.
+ * \param block_id      Pointer to the block UUID (16 bytes) to set.
+ * \param height        Pointer to the block height to set.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if the root context has not
+ *        been created.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function failed
+ *        to begin a transaction.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
+ *        read data from the database.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_INDEX_ENTRY if this function
+ *        encountered an invalid index entry.
+ */
+int dataservice_block_notify_latest_get(
+    dataservice_instance_t* inst, uint8_t* block_id, uint64_t* height);
+
+/**
+ * \brief Notify subscribed child contexts if a new block has been committed.
+ *
+ * \param inst          The data service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success, including when there is nothing to
+ *        notify.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+int dataservice_block_notify_check(dataservice_instance_t* inst);
+
+/**
+ * \brief Get the block notification interval.
+ *
+ * \param signaled      true if the data service is signaled when a block is
+ *                      committed, so that the timer is only a fallback.
+ * \param milliseconds  Pointer to receive the interval, in milliseconds.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID if
+ *        AGENTD_BLOCK_NOTIFY_MILLISECONDS is malformed or out of range.
+ */
+int dataservice_block_notify_interval_get(
+    bool signaled, uint32_t* milliseconds);
+
+/**
+ * \brief Get the write buffer watermarks.
+ *
+ * \param low           Pointer to receive the low watermark, in bytes.
+ * \param high          Pointer to receive the high watermark, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID if either watermark is
+ *        malformed or out of range, or if the low watermark is above the high
+ *        watermark.
+ */
+int dataservice_watermarks_get(size_t* low, size_t* high);
+
+/**
+ * \brief Signal each block publish socket that a block has been committed.
+ *
+ * \param inst          The data service instance.
+ */
+void dataservice_block_publish(dataservice_instance_t* inst);
+
+/**
+ * \brief Read callback for the block subscribe socket, which checks for a new
+ * block each time that a committed block is signaled.
+ *
+ * \param ctx           The non-blocking socket context.
+ * \param event_flags   The event that triggered this callback.
+ * \param user_context  The data service instance.
+ */
+void dataservice_block_subscribe_read(
+    ipc_socket_context_t* ctx, int event_flags, void* user_context);
+
+/**
+ * \brief Arm the block notification timer, if it isn't already armed.
+ *
+ * \param inst          The data service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - any of the errors returned by \ref ipc_event_loop_add_timer().
+ */
+int dataservice_block_notify_timer_arm(dataservice_instance_t* inst);
+
+/**
+ * \brief Timer callback that checks for new blocks while child contexts are
+ * subscribed to block notifications.
+ *
+ * \param timer         The timer that fired.
+ * \param user_context  The data service instance.
+ */
+void dataservice_block_notify_timer_cb(
+    ipc_timer_context_t* timer, void* user_context);
+
+/**
+ * \brief Decode and dispatch an artifact watch request.
+ *
+ * Returns 0 on success or non-fatal error.  If a non-zero error message is
+ * returned, then a fatal error has occurred that should not be recovered from.
+ * Any additional information on the socket is suspect.
+ *
+ * \param inst          The instance on which the dispatch occurs.
+ * \param sock          The socket on which the request was received and the
+ *                      response is to be written.
+ * \param req           The request to be decoded and dispatched.
+ * \param size          The size of the request.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if data could not be
+ *        written to the client socket.
+ */
+int dataservice_decode_and_dispatch_artifact_watch(
+    dataservice_instance_t* inst, ipc_socket_context_t* sock, void* req,
+    size_t size);
+
+/**
+ * \brief Watch a set of artifacts on behalf of a child context.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context.
+ * \param artifact_ids  The artifact UUIDs to watch, 16 bytes each.
+ * \param count         The number of artifact UUIDs.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_BAD_INDEX if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_CHILD_CONTEXT_INVALID if the index is
+ *        invalid.
+ *      - AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED if this child context is not
+ *        authorized to read artifacts.
+ *      - AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT if this would exceed
+ *        the number of artifacts that a child context can watch.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_latest_get().
+ *      - any of the errors returned by
+ *        \ref dataservice_block_notify_timer_arm().
+ */
+int dataservice_artifact_watch_subscribe(
+    dataservice_instance_t* inst, uint32_t offset,
+    const uint8_t* artifact_ids, size_t count);
+
+/**
+ * \brief Add an artifact to the watch index for a child context.
+ *
+ * Watching an artifact that the child context already watches does nothing.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context.
+ * \param artifact_id   The artifact UUID to watch.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered in this operation.
+ */
+int dataservice_artifact_watch_add(
+    dataservice_instance_t* inst, uint32_t offset,
+    const uint8_t* artifact_id);
+
+/**
+ * \brief Get the watch index bucket for an artifact.
+ *
+ * \param inst          The data service instance.
+ * \param artifact_id   The artifact UUID.
+ *
+ * \returns the bucket head, which may be NULL.  The watch index must not be
+ * empty.
+ */
+dataservice_artifact_watch_t** dataservice_artifact_watch_bucket(
+    dataservice_instance_t* inst, const uint8_t* artifact_id);
+
+/**
+ * \brief Remove every artifact watch held by a child context.
+ *
+ * \param inst          The data service instance.
+ * \param offset        The offset of the child context.
+ */
+void dataservice_artifact_watch_remove_child(
+    dataservice_instance_t* inst, uint32_t offset);
+
+/**
+ * \brief Release the watch index.
+ *
+ * \param inst          The data service instance.
+ */
+void dataservice_artifact_watch_index_dispose(dataservice_instance_t* inst);
+
+/**
+ * \brief Notify watching child contexts of artifacts updated by the blocks
+ * committed after the given block, up to and including the latest block.
+ *
+ * Only the final update of an artifact is notified, so an artifact updated
+ * several times since the last check is notified once.
+ *
+ * \param inst          The data service instance.
+ * \param prev_block_id The latest block at the last check.
+ * \param block_id      The latest block now.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success, including when there is nothing to
+ *        notify.
+ *      - AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_CHECK_INCOMPLETE if the new
+ *        blocks could not all be read, in which case the check should be
+ *        tried again over the same blocks.
+ *      - AGENTD_ERROR_DATASERVICE_IPC_WRITE_DATA_FAILURE if a notification
+ *        could not be written to the socket.
+ */
+int dataservice_artifact_watch_check(
+    dataservice_instance_t* inst, const uint8_t* prev_block_id,
+    const uint8_t* block_id);
+
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 }
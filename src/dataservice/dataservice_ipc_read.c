@@ -44,7 +44,7 @@ void dataservice_ipc_read(
     /* loop until the read buffer is empty. */
     do {
         /* attempt to read a request. */
-        retval = ipc_read_data_noblock(ctx, &req, &size);
+        retval = ipc_borrow_data_noblock(ctx, &req, &size);
         switch (retval)
         {
             /* on success, decode and dispatch. */
@@ -56,9 +56,12 @@ void dataservice_ipc_read(
                     dataservice_exit_event_loop(instance);
                 }
 
-                /* clear and free the request data. */
-                memset(req, 0, size);
-                free(req);
+                /* release the request data. */
+                retval = ipc_release_data_noblock(ctx);
+                if (AGENTD_STATUS_SUCCESS != retval)
+                {
+                    dataservice_exit_event_loop(instance);
+                }
                 break;
 
             /* Wait for more data on the socket. */
@@ -0,0 +1,44 @@
+/**
+ * \file dataservice/dataservice_ipc_watermark.c
+ *
+ * \brief Watermark callback for the database protocol socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Watermark callback for the data service protocol socket.
+ *
+ * Reads on the protocol socket are paused while its write buffer is above the
+ * high watermark, so that a peer which stops reading responses cannot grow
+ * the write buffer without bound.
+ *
+ * \param ctx           The non-blocking socket context.
+ * \param above         true if the write buffer crossed the high watermark,
+ *                      false if it drained below the low watermark.
+ * \param user_context  The user context for this socket.
+ */
+void dataservice_ipc_watermark(
+    ipc_socket_context_t* ctx, bool above, void* UNUSED(user_context))
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != ctx);
+
+    if (above)
+    {
+        /* stop taking on new work until the peer catches up. */
+        ipc_pause_read_noblock(ctx);
+    }
+    else
+    {
+        /* the backlog has drained, so accept requests again. */
+        ipc_resume_read_noblock(ctx);
+    }
+}
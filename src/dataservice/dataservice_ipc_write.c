@@ -53,6 +53,11 @@ void dataservice_ipc_write(
             {
                 goto exit_failure;
             }
+
+            /* try again once the peer has made room, such as in a full
+             * ring. */
+            ipc_set_writecb_noblock(
+                ctx, &dataservice_ipc_write, instance->loop_context);
         }
         /* re-enable callback if there is more data to write. */
         else if (ipc_socket_writebuffer_size(ctx) > 0)
@@ -36,6 +36,16 @@
  *                      logger.
  * \param datasock      Pointer to the data service socket, to be updated on
  *                      successful completion of this function.
+ * \param ring          Optional shared-memory ring to hand to the data service
+ *                      alongside its socket, or NULL.  The caller keeps
+ *                      ownership of these descriptors.
+ * \param blocksubscribe    Optional socket on which the data service is told
+ *                          of blocks committed by another data service, or -1.
+ *                          The caller keeps ownership of this descriptor.
+ * \param blockpublish      Array of sockets on which the data service tells
+ *                          other data services of the blocks that it commits.
+ *                          The caller keeps ownership of these descriptors.
+ * \param blockpublish_count    The number of sockets in blockpublish.
  * \param datapid       Pointer to the data service pid, to be updated on the
  *                      successful completion of this function.
  * \param runsecure     Set to false if we are not being run in secure mode.
@@ -64,10 +74,15 @@
  */
 int dataservice_proc(
     const bootstrap_config_t* bconf, const agent_config_t* conf, int* logsock,
-    int* datasock, pid_t* datapid, bool runsecure)
+    int* datasock, const ipc_ring_descriptors_t* ring, int blocksubscribe,
+    int* blockpublish, size_t blockpublish_count, pid_t* datapid,
+    bool runsecure)
 {
     int retval = 1;
     int serversock = -1;
+    int ringmem = (NULL != ring) ? ring->memfd : -1;
+    int ringlhs = (NULL != ring) ? ring->lhs : -1;
+    int ringrhs = (NULL != ring) ? ring->rhs : -1;
     bool keep_datasock = false;
     uid_t uid;
     gid_t gid;
@@ -76,6 +91,7 @@ int dataservice_proc(
     MODEL_ASSERT(NULL != bconf);
     MODEL_ASSERT(NULL != conf);
     MODEL_ASSERT(NULL != datasock);
+    MODEL_ASSERT(NULL != blockpublish || 0U == blockpublish_count);
     MODEL_ASSERT(NULL != datapid);
 
     /* sentinel value for data socket. */
@@ -150,13 +166,55 @@ int dataservice_proc(
         }
 
         /* move the fds out of the way. */
-        if (AGENTD_STATUS_SUCCESS !=
-            privsep_protect_descriptors(&serversock, logsock, NULL))
+        if (NULL != ring)
+        {
+            retval =
+                privsep_protect_descriptors(
+                    &serversock, logsock, &ringmem, &ringlhs, &ringrhs,
+                    NULL);
+        }
+        else
+        {
+            retval = privsep_protect_descriptors(&serversock, logsock, NULL);
+        }
+
+        if (AGENTD_STATUS_SUCCESS != retval)
         {
             retval = AGENTD_ERROR_DATASERVICE_PRIVSEP_SETFDS_FAILURE;
             goto done;
         }
 
+        /* move the block sockets above every descriptor that they will be
+         * mapped to. */
+        int blockfd_min =
+            AGENTD_FD_DATASERVICE_BLOCK_PUBLISH_START
+                + (int)blockpublish_count;
+        if (blocksubscribe >= 0)
+        {
+            int desc = fcntl(blocksubscribe, F_DUPFD, blockfd_min);
+            if (desc < 0)
+            {
+                retval = AGENTD_ERROR_DATASERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+
+            close(blocksubscribe);
+            blocksubscribe = desc;
+        }
+
+        for (size_t i = 0; i < blockpublish_count; ++i)
+        {
+            int desc = fcntl(blockpublish[i], F_DUPFD, blockfd_min);
+            if (desc < 0)
+            {
+                retval = AGENTD_ERROR_DATASERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+
+            close(blockpublish[i]);
+            blockpublish[i] = desc;
+        }
+
         /* close standard file descriptors */
         retval = privsep_close_standard_fds();
         if (0 != retval)
@@ -179,9 +237,69 @@ int dataservice_proc(
             goto done;
         }
 
+        /* hand over the ring, if there is one. */
+        if (NULL != ring)
+        {
+            retval =
+                privsep_setfds(
+                    ringmem, /* ==> */ AGENTD_FD_DATASERVICE_RING_MEM,
+                    ringlhs, /* ==> */ AGENTD_FD_DATASERVICE_RING_LHS,
+                    ringrhs, /* ==> */ AGENTD_FD_DATASERVICE_RING_RHS,
+                    -1);
+            if (0 != retval)
+            {
+                perror("privsep_setfds");
+                retval = AGENTD_ERROR_DATASERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+        }
+        else
+        {
+            /* the private command looks for a ring in these slots. */
+            close(AGENTD_FD_DATASERVICE_RING_MEM);
+            close(AGENTD_FD_DATASERVICE_RING_LHS);
+            close(AGENTD_FD_DATASERVICE_RING_RHS);
+        }
+
+        /* hand over the block subscribe socket, if there is one. */
+        if (blocksubscribe >= 0)
+        {
+            retval =
+                privsep_setfds(
+                    blocksubscribe,
+                    /* ==> */ AGENTD_FD_DATASERVICE_BLOCK_SUBSCRIBE,
+                    -1);
+            if (0 != retval)
+            {
+                perror("privsep_setfds");
+                retval = AGENTD_ERROR_DATASERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+        }
+        else
+        {
+            /* the private command looks for a socket in this slot. */
+            close(AGENTD_FD_DATASERVICE_BLOCK_SUBSCRIBE);
+        }
+
+        /* hand over the block publish sockets, one after another. */
+        for (size_t i = 0; i < blockpublish_count; ++i)
+        {
+            int mapped = AGENTD_FD_DATASERVICE_BLOCK_PUBLISH_START + (int)i;
+            retval = privsep_setfds(blockpublish[i], /* ==> */ mapped, -1);
+            if (0 != retval)
+            {
+                perror("privsep_setfds");
+                retval = AGENTD_ERROR_DATASERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+        }
+
         /* close any socket above the given value. */
         retval =
-            privsep_close_other_fds(AGENTD_FD_DATASERVICE_LOG);
+            privsep_close_other_fds(
+                AGENTD_FD_DATASERVICE_BLOCK_PUBLISH_START
+                    + (int)blockpublish_count - 1);
         if (0 != retval)
         {
             perror("privsep_close_other_fds");
@@ -16,6 +16,7 @@ extern "C" {
 
 #include <agentd/bitcap.h>
 #include <agentd/dataservice.h>
+#include <agentd/dataservice/data.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -57,6 +58,24 @@ typedef struct dataservice_request_block_id_latest_read
     dataservice_request_header_t hdr;
 } dataservice_request_block_id_latest_read_t;
 
+/**
+ * \brief Block Notify Subscribe Request structure.
+ */
+typedef struct dataservice_request_block_notify_subscribe
+{
+    dataservice_request_header_t hdr;
+} dataservice_request_block_notify_subscribe_t;
+
+/**
+ * \brief Artifact Watch Request structure.
+ */
+typedef struct dataservice_request_artifact_watch
+{
+    dataservice_request_header_t hdr;
+    size_t artifact_count;
+    const uint8_t* artifact_ids;
+} dataservice_request_artifact_watch_t;
+
 /**
  * \brief Block Make Request structure.
  */
@@ -68,6 +87,18 @@ typedef struct dataservice_request_block_make
     const uint8_t* cert;
 } dataservice_request_block_make_t;
 
+/**
+ * \brief Block Make From Queue Request structure.
+ */
+typedef struct dataservice_request_block_make_from_queue
+{
+    dataservice_request_header_t hdr;
+    uint8_t block_id[16];
+    uint64_t block_height;
+    uint32_t max_transactions;
+    uint32_t max_block_size;
+} dataservice_request_block_make_from_queue_t;
+
 /**
  * \brief Block Read Request structure.
  */
@@ -78,6 +109,17 @@ typedef struct dataservice_request_block_read
     bool read_cert;
 } dataservice_request_block_read_t;
 
+/**
+ * \brief Block Certificate Read Request structure.
+ */
+typedef struct dataservice_request_block_cert_read
+{
+    dataservice_request_header_t hdr;
+    uint8_t block_id[16];
+    uint64_t cert_offset;
+    uint32_t max_size;
+} dataservice_request_block_cert_read_t;
+
 /**
  * \brief Canonized Transaction Get Request structure.
  */
@@ -331,6 +373,84 @@ int dataservice_decode_request_block_id_latest_read(
 int dataservice_encode_response_block_id_latest_read(
     void** payload, size_t* payload_size, const uint8_t* block_id);
 
+/**
+ * \brief Decode a block notification subscribe request.
+ *
+ * \param req           The request payload to parse.
+ * \param size          The size of this request payload.
+ * \param dreq          The request structure into which this request is
+ *                      decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE if the request
+ *        packet payload size is incorrect.
+ */
+int dataservice_decode_request_block_notify_subscribe(
+    const void* req, size_t size,
+    dataservice_request_block_notify_subscribe_t* dreq);
+
+/**
+ * \brief Encode a block notification payload packet.
+ *
+ * This payload is used both for the block notification subscribe response and
+ * for each block commit notification.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param block_id          Pointer to the block UUID.
+ * \param height            The height of this block.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_block_notify(
+    void** payload, size_t* payload_size, const uint8_t* block_id,
+    uint64_t height);
+
+/**
+ * \brief Decode an artifact watch request.
+ *
+ * \param req           The request payload to parse.
+ * \param size          The size of this request payload.
+ * \param dreq          The request structure into which this request is
+ *                      decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE if the request
+ *        packet payload size is incorrect.
+ */
+int dataservice_decode_request_artifact_watch(
+    const void* req, size_t size, dataservice_request_artifact_watch_t* dreq);
+
+/**
+ * \brief Encode an artifact update notification payload packet.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param record            The updated artifact record.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_artifact_notify(
+    void** payload, size_t* payload_size, const data_artifact_record_t* record);
+
 /**
  * \brief Decode a make block request.
  *
@@ -347,6 +467,48 @@ int dataservice_encode_response_block_id_latest_read(
 int dataservice_decode_request_block_make(
     const void* req, size_t size, dataservice_request_block_make_t* dreq);
 
+/**
+ * \brief Decode a make block from queue request.
+ *
+ * \param req           The request payload to parse.
+ * \param size          The size of this request payload.
+ * \param dreq          The request structure into which this request is
+ *                      decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE if the request
+ *        packet payload size is incorrect.
+ */
+int dataservice_decode_request_block_make_from_queue(
+    const void* req, size_t size,
+    dataservice_request_block_make_from_queue_t* dreq);
+
+/**
+ * \brief Encode a make block from queue response payload packet.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param block_id          Pointer to the block UUID.
+ * \param transaction_count The number of transactions in this block.
+ * \param block_hash        Pointer to the block hash.
+ * \param block_hash_size   The size of the block hash.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_block_make_from_queue(
+    void** payload, size_t* payload_size, const uint8_t* block_id,
+    uint32_t transaction_count, const void* block_hash,
+    size_t block_hash_size);
+
 /**
  * \brief Decode a block read request.
  *
@@ -392,6 +554,47 @@ int dataservice_encode_response_block_read(
     const uint8_t* prev_id, const uint8_t* next_id, const uint8_t* first_txn_id,
     uint64_t block_height, bool write_cert, const void* cert, size_t cert_size);
 
+/**
+ * \brief Decode a block certificate read request.
+ *
+ * \param req           The request payload to parse.
+ * \param size          The size of this request payload.
+ * \param dreq          The request structure into which this request is
+ *                      decoded.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_INVALID_SIZE if the request
+ *        packet payload size is incorrect.
+ */
+int dataservice_decode_request_block_cert_read(
+    const void* req, size_t size,
+    dataservice_request_block_cert_read_t* dreq);
+
+/**
+ * \brief Encode a block certificate read response payload packet.
+ *
+ * \param payload           Pointer to receive the allocated packet payload.
+ * \param payload_size      Pointer to receive the size of the payload.
+ * \param node              The block node, whose certificate size is the size
+ *                          of the whole certificate.
+ * \param cert_slice        Pointer to the slice of the block certificate.
+ * \param cert_slice_size   Size of the slice of the block certificate.
+ *
+ * On successful completion of this function, the payload pointer is updated
+ * with a buffer containing the payload packet, and the payload_size pointer is
+ * updated with the size of this payload packet.  The caller owns the payload
+ * packet and must clear and free it when it is no longer needed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered during this operation.
+ */
+int dataservice_encode_response_block_cert_read(
+    void** payload, size_t* payload_size, const data_block_node_t* node,
+    const void* cert_slice, size_t cert_slice_size);
+
 /**
  * \brief Decode a canonized transaction get request.
  *
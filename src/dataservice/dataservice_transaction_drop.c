@@ -32,8 +32,6 @@ static int dataservice_transaction_drop_fixup_prev_next(
  *        authorized to call this function.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -77,8 +75,6 @@ int dataservice_transaction_drop(
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -214,23 +210,17 @@ done:
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
  *        read from the database.
- *      - AGENTD_ERROR_DATASERVICE_MDB_DEL_FAILURE if this function failed to
- *        delete from the database.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        write to the database.
  */
 static int dataservice_transaction_drop_fixup_prev_next(
     MDB_txn* del_txn, MDB_dbi pq_db, const data_transaction_node_t* node)
 {
     int retval;
-    uint8_t* prev_buffer;
-    uint8_t* next_buffer;
-    size_t prev_buffer_size;
-    size_t next_buffer_size;
-    data_transaction_node_t* prev;
-    data_transaction_node_t* next;
+    data_transaction_node_t prev;
+    data_transaction_node_t next;
 
     /* get the previous node. */
     MDB_val lkey;
@@ -241,34 +231,20 @@ static int dataservice_transaction_drop_fixup_prev_next(
     retval = mdb_get(del_txn, pq_db, &lkey, &lval);
     if (0 != retval || lval.mv_size < sizeof(data_transaction_node_t))
     {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
-        goto done;
+        return AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
     }
 
-    /* allocate a buffer large enough to hold a copy of this data. */
-    prev_buffer_size = lval.mv_size;
-    prev_buffer = (uint8_t*)malloc(prev_buffer_size);
-    if (NULL == prev_buffer)
-    {
-        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-        goto done;
-    }
-
-    /* update the prev data. */
-    memcpy(prev_buffer, lval.mv_data, prev_buffer_size);
-    prev = (data_transaction_node_t*)prev_buffer;
-    memcpy(prev->next, node->next, sizeof(prev->next));
+    /* update the prev header. */
+    memcpy(&prev, lval.mv_data, sizeof(prev));
+    memcpy(prev.next, node->next, sizeof(prev.next));
 
     /* update the prev record in the database. */
-    lkey.mv_size = 16;
-    lkey.mv_data = (uint8_t*)node->prev;
-    lval.mv_size = prev_buffer_size;
-    lval.mv_data = prev_buffer;
-    retval = mdb_put(del_txn, pq_db, &lkey, &lval, 0);
-    if (0 != retval)
+    retval =
+        dataservice_transaction_node_header_put(
+            del_txn, pq_db, node->prev, &lval, &prev);
+    if (AGENTD_STATUS_SUCCESS != retval)
     {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-        goto maybe_cleanup_prev_buffer;
+        return retval;
     }
 
     /* get the next node. */
@@ -278,55 +254,15 @@ static int dataservice_transaction_drop_fixup_prev_next(
     retval = mdb_get(del_txn, pq_db, &lkey, &lval);
     if (0 != retval || lval.mv_size < sizeof(data_transaction_node_t))
     {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
-        goto done;
-    }
-
-    /* allocate a buffer large enough to hold a copy of this data. */
-    next_buffer_size = lval.mv_size;
-    next_buffer = (uint8_t*)malloc(next_buffer_size);
-    if (NULL == next_buffer)
-    {
-        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-        goto done;
+        return AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
     }
 
-    /* update the next data. */
-    memcpy(next_buffer, lval.mv_data, next_buffer_size);
-    next = (data_transaction_node_t*)next_buffer;
-    memcpy(next->prev, node->prev, sizeof(next->prev));
+    /* update the next header. */
+    memcpy(&next, lval.mv_data, sizeof(next));
+    memcpy(next.prev, node->prev, sizeof(next.prev));
 
     /* update the next record in the database. */
-    lkey.mv_size = 16;
-    lkey.mv_data = (uint8_t*)node->next;
-    lval.mv_size = next_buffer_size;
-    lval.mv_data = next_buffer;
-    retval = mdb_put(del_txn, pq_db, &lkey, &lval, 0);
-    if (0 != retval)
-    {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-        goto maybe_cleanup_next_buffer;
-    }
-
-    /* success. */
-    retval = AGENTD_STATUS_SUCCESS;
-
-    /* fall-through. */
-
-maybe_cleanup_next_buffer:
-    if (NULL != next_buffer)
-    {
-        memset(next_buffer, 0, next_buffer_size);
-        free(next_buffer);
-    }
-
-maybe_cleanup_prev_buffer:
-    if (NULL != prev_buffer)
-    {
-        memset(prev_buffer, 0, prev_buffer_size);
-        free(prev_buffer);
-    }
-
-done:
-    return retval;
+    return
+        dataservice_transaction_node_header_put(
+            del_txn, pq_db, node->next, &lval, &next);
 }
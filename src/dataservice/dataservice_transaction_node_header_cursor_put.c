@@ -0,0 +1,74 @@
+/**
+ * \file dataservice/dataservice_transaction_node_header_cursor_put.c
+ *
+ * \brief Replace the header of the transaction node under a cursor.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Replace the header of the transaction node under a cursor.
+ *
+ * This is the cursor form of \ref dataservice_transaction_node_header_put.
+ * The node is rewritten in place with an MDB_CURRENT | MDB_RESERVE put of the
+ * same size, so a caller walking several nodes in key order keeps its place
+ * in the tree between updates.
+ *
+ * \param cursor        A cursor positioned on this node.
+ * \param key           The key of this node.
+ * \param old_val       The current value of this node, as read through the
+ *                      cursor with no intervening writes.
+ * \param header        The updated header for this node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        put to the database.
+ */
+int dataservice_transaction_node_header_cursor_put(
+    MDB_cursor* cursor, const uint8_t* key, const MDB_val* old_val,
+    const data_transaction_node_t* header)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != cursor);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != old_val);
+    MODEL_ASSERT(old_val->mv_size >= sizeof(data_transaction_node_t));
+    MODEL_ASSERT(NULL != header);
+
+    /* reserve space for the node in place of the current value. */
+    MDB_val lkey;
+    lkey.mv_size = 16;
+    lkey.mv_data = (uint8_t*)key;
+    MDB_val lval;
+    lval.mv_size = old_val->mv_size;
+    lval.mv_data = NULL;
+    if (0 != mdb_cursor_put(cursor, &lkey, &lval, MDB_CURRENT | MDB_RESERVE))
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
+    }
+
+    /* As with the non-cursor put, an old value that was moved stays readable
+     * until this transaction ends, so its certificate can be copied across. */
+    if (lval.mv_data != old_val->mv_data)
+    {
+        memcpy(
+            ((uint8_t*)lval.mv_data) + sizeof(data_transaction_node_t),
+            ((const uint8_t*)old_val->mv_data)
+                + sizeof(data_transaction_node_t),
+            old_val->mv_size - sizeof(data_transaction_node_t));
+    }
+
+    /* write the updated header. */
+    memcpy(lval.mv_data, header, sizeof(data_transaction_node_t));
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file dataservice/dataservice_transaction_node_header_put.c
+ *
+ * \brief Replace the header of a stored transaction node.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "dataservice_internal.h"
+
+/**
+ * \brief Replace the header of a stored transaction node.
+ *
+ * The node is rewritten with an MDB_RESERVE put of the same size, so the
+ * header is written directly into the database page and the certificate is
+ * only copied if LMDB had to move the record to a new page.
+ *
+ * \param txn           The database transaction for this update.
+ * \param dbi           The database holding this node.
+ * \param key           The key of this node.
+ * \param old_val       The current value of this node, as read under txn
+ *                      with no intervening writes.
+ * \param header        The updated header for this node.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if this function failed to
+ *        put to the database.
+ */
+int dataservice_transaction_node_header_put(
+    MDB_txn* txn, MDB_dbi dbi, const uint8_t* key, const MDB_val* old_val,
+    const data_transaction_node_t* header)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != txn);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != old_val);
+    MODEL_ASSERT(old_val->mv_size >= sizeof(data_transaction_node_t));
+    MODEL_ASSERT(NULL != header);
+
+    /* reserve space for the node in place of the old value. */
+    MDB_val lkey;
+    lkey.mv_size = 16;
+    lkey.mv_data = (uint8_t*)key;
+    MDB_val lval;
+    lval.mv_size = old_val->mv_size;
+    lval.mv_data = NULL;
+    if (0 != mdb_put(txn, dbi, &lkey, &lval, MDB_RESERVE))
+    {
+        return AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
+    }
+
+    /* A same-sized put either reuses the old value's location or leaves the
+     * old page untouched until this transaction ends, so the certificate can
+     * be copied across if the record moved. */
+    if (lval.mv_data != old_val->mv_data)
+    {
+        memcpy(
+            ((uint8_t*)lval.mv_data) + sizeof(data_transaction_node_t),
+            ((const uint8_t*)old_val->mv_data)
+                + sizeof(data_transaction_node_t),
+            old_val->mv_size - sizeof(data_transaction_node_t));
+    }
+
+    /* write the updated header. */
+    memcpy(lval.mv_data, header, sizeof(data_transaction_node_t));
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -28,8 +28,6 @@
  *        authorized to call this function.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -73,8 +71,6 @@ int dataservice_transaction_promote(
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the transaction uuid could not
  *        be found.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out of memory condition was
- *        encountered during this operation.
  *      - AGENTD_ERROR_DATASERVICE_MDB_TXN_BEGIN_FAILURE if this function could
  *        not create a transaction.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if this function failed to
@@ -88,8 +84,6 @@ int dataservice_transaction_promote_internal(
 {
     int retval = 0;
     MDB_txn* txn = NULL;
-    uint8_t* new_buffer = NULL;
-    size_t new_buffer_size = 0U;
 
     /* parameter sanity check. */
     MODEL_ASSERT(NULL != child);
@@ -150,34 +144,20 @@ int dataservice_transaction_promote_internal(
         goto maybe_transaction_abort;
     }
 
-    /* allocate a buffer large enough to hold a copy of this data. */
-    new_buffer_size = lval.mv_size;
-    new_buffer = (uint8_t*)malloc(new_buffer_size);
-    if (NULL == new_buffer)
-    {
-        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-        goto maybe_transaction_abort;
-    }
-
-    /* copy the node data into the buffer. */
-    data_transaction_node_t* node;
-    memcpy(new_buffer, lval.mv_data, new_buffer_size);
-    node = (data_transaction_node_t*)new_buffer;
+    /* copy the node header so we can update it. */
+    data_transaction_node_t node;
+    memcpy(&node, lval.mv_data, sizeof(node));
 
     /* update the transaction state. */
-    node->net_txn_state = htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED);
+    node.net_txn_state = htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED);
 
-    /* attempt to update the entry. */
-    lkey.mv_size = 16;
-    lkey.mv_data = (uint8_t*)txn_id;
-    lval.mv_size = new_buffer_size;
-    lval.mv_data = new_buffer;
-    retval = mdb_put(update_txn, details->pq_db, &lkey, &lval, 0);
-    if (0 != retval)
+    /* attempt to update the entry in place. */
+    retval =
+        dataservice_transaction_node_header_put(
+            update_txn, details->pq_db, txn_id, &lval, &node);
+    if (AGENTD_STATUS_SUCCESS != retval)
     {
-        /* some error has occurred. */
-        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-        goto cleanup_new_buffer;
+        goto maybe_transaction_abort;
     }
 
     /* commit the transaction if created internally. */
@@ -192,10 +172,6 @@ int dataservice_transaction_promote_internal(
 
     /* fall-through. */
 
-cleanup_new_buffer:
-    memset(new_buffer, 0, new_buffer_size);
-    free(new_buffer);
-
 maybe_transaction_abort:
     if (NULL != txn)
     {
@@ -47,8 +47,6 @@ static int dataservice_transaction_submit_update_end(
  *            when reading data from the database.
  *          - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if a failure occurred
  *            when writing data to the database.
- *          - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition
- *            was detected during this operation.
  */
 int dataservice_transaction_submit(
     dataservice_child_context_t* child,
@@ -98,7 +96,8 @@ int dataservice_transaction_submit(
     MDB_val lval;
     memset(&lval, 0, sizeof(lval));
     bool queue_initialized = false;
-    data_transaction_node_t* end_node = NULL;
+    data_transaction_node_t end_node;
+    memset(&end_node, 0, sizeof(end_node));
 
     /* attempt to read the end of the queue from the database. */
     retval = mdb_get(txn, details->pq_db, &lkey, &lval);
@@ -106,13 +105,11 @@ int dataservice_transaction_submit(
     {
         /* the value was not found; we'll need to create it. */
         queue_initialized = false;
-        end_node = NULL;
     }
     else if (0 == retval)
     {
         /* the value was found, so the queue is initialized. */
         queue_initialized = true;
-        end_node = (data_transaction_node_t*)lval.mv_data;
 
         /* verify that this transaction is valid. */
         if (lval.mv_size < sizeof(data_transaction_node_t))
@@ -120,6 +117,9 @@ int dataservice_transaction_submit(
             retval = AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE;
             goto maybe_transaction_abort;
         }
+
+        /* copy the end node, since the put below invalidates lval. */
+        memcpy(&end_node, lval.mv_data, sizeof(end_node));
     }
     else if (0 != retval)
     {
@@ -128,17 +128,23 @@ int dataservice_transaction_submit(
         goto maybe_transaction_abort;
     }
 
-    /* create the node we are inserting. */
+    /* reserve space for the node we are inserting. */
     size_t newnode_size = sizeof(data_transaction_node_t) + txn_size;
-    data_transaction_node_t* newnode =
-        (data_transaction_node_t*)malloc(newnode_size);
-    if (NULL == newnode)
+    lkey.mv_size = 16;
+    lkey.mv_data = (uint8_t*)txn_id;
+    lval.mv_size = newnode_size;
+    lval.mv_data = NULL;
+    if (0 !=
+        mdb_put(
+            txn, details->pq_db, &lkey, &lval, MDB_NOOVERWRITE | MDB_RESERVE))
     {
-        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
         goto maybe_transaction_abort;
     }
 
-    memset(newnode, 0, newnode_size);
+    /* build the new node directly in the reserved space. */
+    data_transaction_node_t* newnode = (data_transaction_node_t*)lval.mv_data;
+    memset(newnode, 0, sizeof(data_transaction_node_t));
     memcpy(((uint8_t*)newnode) + sizeof(data_transaction_node_t),
         txn_bytes, txn_size);
     memcpy(newnode->key, txn_id, sizeof(newnode->key));
@@ -156,7 +162,7 @@ int dataservice_transaction_submit(
     /* if the queue exists, set newnode->prev to the prev of end. */
     if (queue_initialized)
     {
-        memcpy(newnode->prev, end_node->prev, sizeof(newnode->prev));
+        memcpy(newnode->prev, end_node.prev, sizeof(newnode->prev));
     }
     /* otherwise, prev is start. */
     else
@@ -164,17 +170,6 @@ int dataservice_transaction_submit(
         memset(newnode->prev, 0, sizeof(newnode->prev));
     }
 
-    /* insert the new node. */
-    lkey.mv_size = sizeof(newnode->key);
-    lkey.mv_data = newnode->key;
-    lval.mv_size = newnode_size;
-    lval.mv_data = newnode;
-    if (0 != mdb_put(txn, details->pq_db, &lkey, &lval, MDB_NOOVERWRITE))
-    {
-        retval = AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-        goto cleanup_newnode;
-    }
-
     /* if the queue does not exist, create start and end. */
     if (!queue_initialized)
     {
@@ -182,25 +177,25 @@ int dataservice_transaction_submit(
             details->pq_db, txn, txn_id);
         if (AGENTD_STATUS_SUCCESS != retval)
         {
-            goto cleanup_newnode;
+            goto maybe_transaction_abort;
         }
     }
     /* if the queue DOES exist, update end and end->prev. */
     else
     {
         retval = dataservice_transaction_submit_update_prev(
-            details->pq_db, txn, txn_id, end_node->prev);
+            details->pq_db, txn, txn_id, end_node.prev);
         if (AGENTD_STATUS_SUCCESS != retval)
         {
-            goto cleanup_newnode;
+            goto maybe_transaction_abort;
         }
 
         /* update end_node prev. */
         retval = dataservice_transaction_submit_update_end(
-            details->pq_db, txn, txn_id, end_node);
+            details->pq_db, txn, txn_id, &end_node);
         if (AGENTD_STATUS_SUCCESS != retval)
         {
-            goto cleanup_newnode;
+            goto maybe_transaction_abort;
         }
     }
 
@@ -213,10 +208,6 @@ int dataservice_transaction_submit(
 
     /* fall-through. */
 
-cleanup_newnode:
-    memset(newnode, 0, newnode_size);
-    free(newnode);
-
 maybe_transaction_abort:
     if (NULL != txn)
     {
@@ -293,8 +284,8 @@ static int dataservice_transaction_submit_create_queue(
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
- *        encountered during this operation.
+ *      - AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE if the
+ *        previous node is invalid.
  *      - AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE if a failure occurred when
  *        reading data from the database.
  *      - AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE if a failure occurred when
@@ -314,39 +305,23 @@ static int dataservice_transaction_submit_update_prev(
         return AGENTD_ERROR_DATASERVICE_MDB_GET_FAILURE;
     }
 
-    /* get the node header. */
-    data_transaction_node_t* prev_node =
-        (data_transaction_node_t*)lval.mv_data;
-    size_t prev_size =
-        sizeof(data_transaction_node_t) + ntohll(prev_node->net_txn_cert_size);
-
-    /* copy this header into a local value so we can update it. */
-    data_transaction_node_t* node = (data_transaction_node_t*)malloc(prev_size);
-    if (NULL == node)
+    /* verify that this node is valid. */
+    if (lval.mv_size < sizeof(data_transaction_node_t))
     {
-        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        return AGENTD_ERROR_DATASERVICE_INVALID_STORED_TRANSACTION_NODE;
     }
 
-    /* copy the previous node value. */
-    memcpy(node, prev_node, prev_size);
+    /* copy the node header so we can update it. */
+    data_transaction_node_t node;
+    memcpy(&node, lval.mv_data, sizeof(node));
 
     /* update this node header's next to point to the transaction. */
-    memcpy(node->next, txn_id, sizeof(node->next));
+    memcpy(node.next, txn_id, sizeof(node.next));
 
-    /* place this value in the database. */
-    lval.mv_size = prev_size;
-    lval.mv_data = node;
-    int retval = mdb_put(txn, pq_db, &lkey, &lval, 0);
-
-    /* clean up node. */
-    memset(node, 0, prev_size);
-    free(node);
-
-    /* decode success or failure. */
-    if (0 != retval)
-        return AGENTD_ERROR_DATASERVICE_MDB_PUT_FAILURE;
-    else
-        return AGENTD_STATUS_SUCCESS;
+    /* rewrite the header in place. */
+    return
+        dataservice_transaction_node_header_put(
+            txn, pq_db, prev, &lval, &node);
 }
 
 /**
@@ -0,0 +1,117 @@
+/**
+ * \file dataservice/dataservice_watermarks_get.c
+ *
+ * \brief Get the write buffer watermarks.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/private/dataservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "dataservice_internal.h"
+
+/* forward decls. */
+static int dataservice_watermark_get(
+    const char* name, size_t default_value, size_t* value);
+
+/**
+ * \brief Get the write buffer watermarks.
+ *
+ * The watermarks are read from AGENTD_DATASERVICE_LOW_WATERMARK and
+ * AGENTD_DATASERVICE_HIGH_WATERMARK, if set, and default to
+ * DATASERVICE_WRITEBUF_LOW_WATERMARK and DATASERVICE_WRITEBUF_HIGH_WATERMARK.
+ * A lower high watermark bounds the memory held for a slow client, at the cost
+ * of pausing its requests sooner.
+ *
+ * \param low           Pointer to receive the low watermark, in bytes.
+ * \param high          Pointer to receive the high watermark, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID if either watermark is
+ *        malformed or out of range, or if the low watermark is above the high
+ *        watermark.
+ */
+int dataservice_watermarks_get(size_t* low, size_t* high)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != low);
+    MODEL_ASSERT(NULL != high);
+
+    retval =
+        dataservice_watermark_get(
+            "AGENTD_DATASERVICE_LOW_WATERMARK",
+            DATASERVICE_WRITEBUF_LOW_WATERMARK, low);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        dataservice_watermark_get(
+            "AGENTD_DATASERVICE_HIGH_WATERMARK",
+            DATASERVICE_WRITEBUF_HIGH_WATERMARK, high);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* reads could never be resumed if the low watermark were above the
+     * high watermark. */
+    if (*low > *high)
+    {
+        return AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Get a single watermark from the environment.
+ *
+ * \param name          The name of the environment variable.
+ * \param default_value The watermark to use if the variable isn't set.
+ * \param value         Pointer to receive the watermark, in bytes.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID if the watermark is
+ *        malformed or out of range.
+ */
+static int dataservice_watermark_get(
+    const char* name, size_t default_value, size_t* value)
+{
+    char* end = NULL;
+
+    /* use the default if the watermark isn't set. */
+    const char* setting = getenv(name);
+    if (NULL == setting)
+    {
+        *value = default_value;
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* the watermark must be a decimal number within range. */
+    if (!isdigit((unsigned char)*setting))
+    {
+        return AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID;
+    }
+
+    unsigned long long bytes = strtoull(setting, &end, 10);
+    if (0 != *end
+     || bytes < DATASERVICE_WATERMARK_MIN
+     || bytes > DATASERVICE_WATERMARK_MAX)
+    {
+        return AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID;
+    }
+
+    *value = (size_t)bytes;
+
+    return AGENTD_STATUS_SUCCESS;
+}
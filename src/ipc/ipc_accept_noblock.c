@@ -6,9 +6,12 @@
  * \copyright 2019 Velo Payments, Inc.  All rights reserved.
  */
 
+#define _GNU_SOURCE
+
 #include <agentd/ipc.h>
 #include <agentd/status_codes.h>
 #include <cbmc/model_assert.h>
+#include <sys/socket.h>
 #include <vpr/parameters.h>
 
 #include "ipc_internal.h"
@@ -17,7 +20,8 @@
  * \brief Accept a connection from a listen socket.
  *
  * On success, the socket specified by sock contains a connection to a remote
- * peer.  The address parameter contains data about the peer.
+ * peer.  The address parameter contains data about the peer.  The accepted
+ * socket is non-blocking and close-on-exec.
  *
  * \param ctx           The non-blocking socket context from which a connection
  *                      is accepted.
@@ -33,6 +37,8 @@
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this operation would cause the socket
  *        to block.
+ *      - AGENTD_ERROR_IPC_ACCEPT_SHOULD_RETRY if this connection was lost
+ *        before it could be accepted, and the next one should be tried.
  *      - AGENTD_ERROR_IPC_ACCEPT_NOBLOCK_FAILURE if accepting this socket
  *        failed.
  */
@@ -45,7 +51,8 @@ int ipc_accept_noblock(
     MODEL_ASSERT(NULL != addr);
 
     /* attempt to accept a value from the non-blocking listen socket. */
-    int retval = accept(ctx->fd, addr, addrsize);
+    int retval =
+        accept4(ctx->fd, addr, addrsize, SOCK_NONBLOCK | SOCK_CLOEXEC);
     if (retval < 0)
     {
         if (EAGAIN == errno || EWOULDBLOCK == errno)
@@ -54,7 +61,7 @@ int ipc_accept_noblock(
         }
         /* Linuxisms: for TCP/IP, any of these means we should retry. */
         else if (
-            ENETDOWN == errno || EPROTO == errno || ENOPROTOOPT == errno || EHOSTDOWN == errno || ENONET == errno || EHOSTUNREACH == errno || EOPNOTSUPP == errno || ENETUNREACH == errno || EINTR == errno)
+            ECONNABORTED == errno || ENETDOWN == errno || EPROTO == errno || ENOPROTOOPT == errno || EHOSTDOWN == errno || ENONET == errno || EHOSTUNREACH == errno || EOPNOTSUPP == errno || ENETUNREACH == errno || EINTR == errno)
         {
             return AGENTD_ERROR_IPC_ACCEPT_SHOULD_RETRY;
         }
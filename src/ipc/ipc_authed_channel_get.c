@@ -0,0 +1,146 @@
+/**
+ * \file ipc/ipc_authed_channel_get.c
+ *
+ * \brief Get the authed channel for a socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vccrypt/compare.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Get the authed channel for a socket, keyed with the given suite and
+ * secret.
+ *
+ * The channel is created on first use and replaced if the suite or secret
+ * changes.  It is owned by the socket and released when the socket is
+ * disposed.
+ *
+ * \param impl      The socket implementation that owns the channel.
+ * \param suite     The crypto suite for this channel.
+ * \param secret    The shared secret for this channel.
+ * \param channel   Pointer to receive the channel on success.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_authed_channel_get(
+    ipc_socket_impl_t* impl, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* secret, ipc_authed_channel_t** channel)
+{
+    int retval;
+    ipc_authed_channel_t* chan;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != impl);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+    MODEL_ASSERT(NULL != channel);
+
+    /* reuse the existing channel if it is keyed the same way. */
+    chan = impl->authed;
+    if (NULL != chan)
+    {
+        if (chan->suite == suite
+         && chan->secret.size == secret->size
+         && 0 == crypto_memcmp(chan->secret.data, secret->data, secret->size))
+        {
+            *channel = chan;
+            return AGENTD_STATUS_SUCCESS;
+        }
+
+        /* the key changed, so start over. */
+        ipc_authed_channel_release(impl);
+    }
+
+    /* allocate the channel. */
+    chan = (ipc_authed_channel_t*)malloc(sizeof(ipc_authed_channel_t));
+    if (NULL == chan)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* clear the channel. */
+    memset(chan, 0, sizeof(ipc_authed_channel_t));
+    chan->suite = suite;
+
+    /* keep a copy of the secret to detect a change of key. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(&chan->secret, suite->alloc_opts, secret->size))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto free_chan;
+    }
+
+    memcpy(chan->secret.data, secret->data, secret->size);
+
+    /* create the digest scratch buffers. */
+    /* TODO - there should be a suite method for this. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &chan->read_digest, suite->alloc_opts,
+            suite->mac_short_opts.mac_size))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_secret;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &chan->write_digest, suite->alloc_opts,
+            suite->mac_short_opts.mac_size))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_read_digest;
+    }
+
+    /* key the stream ciphers for each direction. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_stream_init(suite, &chan->read_stream, secret))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_write_digest;
+    }
+
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_stream_init(suite, &chan->write_stream, secret))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_read_stream;
+    }
+
+    /* success. */
+    impl->authed = chan;
+    *channel = chan;
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+cleanup_read_stream:
+    dispose((disposable_t*)&chan->read_stream);
+
+cleanup_write_digest:
+    dispose((disposable_t*)&chan->write_digest);
+
+cleanup_read_digest:
+    dispose((disposable_t*)&chan->read_digest);
+
+cleanup_secret:
+    dispose((disposable_t*)&chan->secret);
+
+free_chan:
+    memset(chan, 0, sizeof(ipc_authed_channel_t));
+    free(chan);
+
+done:
+    return retval;
+}
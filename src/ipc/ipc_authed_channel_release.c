@@ -0,0 +1,43 @@
+/**
+ * \file ipc/ipc_authed_channel_release.c
+ *
+ * \brief Release the authed channel for a socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Release the authed channel for a socket.
+ *
+ * \param impl      The socket implementation that owns the channel.
+ */
+void ipc_authed_channel_release(ipc_socket_impl_t* impl)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != impl);
+
+    ipc_authed_channel_t* chan = impl->authed;
+    if (NULL == chan)
+    {
+        return;
+    }
+
+    /* dispose the keyed contexts and scratch buffers. */
+    dispose((disposable_t*)&chan->write_stream);
+    dispose((disposable_t*)&chan->read_stream);
+    dispose((disposable_t*)&chan->write_digest);
+    dispose((disposable_t*)&chan->read_digest);
+    dispose((disposable_t*)&chan->secret);
+
+    /* clear and free the channel. */
+    memset(chan, 0, sizeof(ipc_authed_channel_t));
+    free(chan);
+
+    impl->authed = NULL;
+}
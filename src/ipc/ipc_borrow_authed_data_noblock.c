@@ -0,0 +1,259 @@
+/**
+ * \file ipc/ipc_borrow_authed_data_noblock.c
+ *
+ * \brief Non-blocking borrowed read of an authenticated data packet value.
+ *
+ * \copyright 2019-2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <vccrypt/compare.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Borrow an authenticated data packet from a non-blocking socket.
+ *
+ * On success, the payload is decrypted into a buffer owned by the socket, and
+ * val is set to point to this buffer.  The buffer is reused across reads, so
+ * small packets do not require an allocation.  The payload remains valid
+ * until \ref ipc_release_data_noblock() is called, which must happen before
+ * any other read on this socket.
+ *
+ * \param sock          The socket context from which the value is read.
+ * \param iv            The 64-bit IV to expect for this packet.
+ * \param val           Pointer to receive the payload pointer.
+ * \param size          Pointer to the variable to receive the size of this
+ *                      packet.
+ * \param suite         The crypto suite to use for authenticating this packet.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
+ *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_READ_BUFFER_DRAIN_FAILURE if draining the read buffer
+ *        failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ *      - AGENTD_ERROR_IPC_UNAUTHORIZED_PACKET if the packet could not be
+ *        authenticated.
+ */
+int ipc_borrow_authed_data_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, void** val, uint32_t* size,
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret)
+{
+    int retval = 0;
+    uint8_t type = 0U;
+    uint32_t nsize = 0U;
+    uint8_t dheader[sizeof(type) + sizeof(nsize)];
+    uint8_t* header = NULL;
+    ipc_authed_channel_t* chan = NULL;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+    MODEL_ASSERT(0U == ((ipc_socket_impl_t*)sock->impl)->pool_used);
+    MODEL_ASSERT(NULL != val);
+    MODEL_ASSERT(NULL != size);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+
+    /* get the socket details. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* we need at least this many bytes to see the header. */
+    ssize_t header_sz =
+        sizeof(uint8_t) + sizeof(uint32_t) + suite->mac_short_opts.mac_size;
+
+    /* make sure that the header is buffered, reading ahead if needed. */
+    retval = ipc_socket_read_ahead(sock, header_sz);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* get the encrypted header data. */
+    header = (uint8_t*)evbuffer_pullup(sock_impl->readbuf, header_sz);
+    if (NULL == header)
+    {
+        retval = AGENTD_ERROR_IPC_WOULD_BLOCK;
+        goto done;
+    }
+
+    /* get the keyed crypto state for this socket. */
+    retval = ipc_authed_channel_get(sock_impl, suite, secret, &chan);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* start decryption of the stream. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_stream_continue_decryption(
+            &chan->read_stream, &iv, sizeof(iv), 0))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto done;
+    }
+
+    /* decrypt enough of the header to determine the type and size. */
+    size_t offset = 0;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_stream_decrypt(
+            &chan->read_stream, header, sizeof(dheader), dheader, &offset))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_dheader;
+    }
+
+    /* verify that the type is IPC_DATA_TYPE_AUTHED_PACKET. */
+    type = dheader[0];
+    if (IPC_DATA_TYPE_AUTHED_PACKET != type)
+    {
+        retval = AGENTD_ERROR_IPC_UNAUTHORIZED_PACKET;
+        goto cleanup_dheader;
+    }
+
+    /* verify that the size makes sense. */
+    memcpy(&nsize, dheader + 1, sizeof(nsize));
+    *size = ntohl(nsize);
+    if (*size > IPC_AUTHED_PACKET_MAX_SIZE)
+    {
+        retval = AGENTD_ERROR_IPC_UNAUTHORIZED_PACKET;
+        goto cleanup_dheader;
+    }
+
+    /* compute the total packet size. */
+    ssize_t packet_size = header_sz + *size;
+
+    /* make sure that the whole packet is buffered. */
+    retval = ipc_socket_read_ahead(sock, packet_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_dheader;
+    }
+
+    /* pull up the entire packet. */
+    header = (uint8_t*)evbuffer_pullup(sock_impl->readbuf, packet_size);
+    if (NULL == header)
+    {
+        retval = AGENTD_ERROR_IPC_WOULD_BLOCK;
+        goto cleanup_dheader;
+    }
+
+    /* set up MAC. */
+    vccrypt_mac_context_t mac;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_mac_short_init(suite, &mac, secret))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_dheader;
+    }
+
+    /* digest the packet. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_mac_digest(&mac, header, sizeof(dheader)) ||
+        VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_mac_digest(&mac, header + header_sz, *size))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* finalize the mac. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_mac_finalize(&mac, &chan->read_digest))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* compare the digest against the mac in the packet. */
+    if (0 !=
+        crypto_memcmp(
+            chan->read_digest.data, header + sizeof(dheader),
+            chan->read_digest.size))
+    {
+        retval = AGENTD_ERROR_IPC_UNAUTHORIZED_PACKET;
+        goto cleanup_mac;
+    }
+
+    /* the payload has been authenticated.  grow the payload buffer if
+     * needed. */
+    if (NULL == sock_impl->pool || sock_impl->pool_size < *size)
+    {
+        size_t pool_size =
+            (sock_impl->pool_size > 0U) ? sock_impl->pool_size : 256U;
+        while (pool_size < *size)
+        {
+            pool_size *= 2U;
+        }
+
+        uint8_t* pool = (uint8_t*)malloc(pool_size);
+        if (NULL == pool)
+        {
+            retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+            goto cleanup_mac;
+        }
+
+        ipc_socket_pool_release(sock_impl);
+        sock_impl->pool = pool;
+        sock_impl->pool_size = pool_size;
+    }
+
+    /* from here on, the payload buffer must be cleared on failure. */
+    sock_impl->pool_used = *size;
+
+    /* the stream is already positioned just past the header, so only the
+     * output offset is reset for the payload. */
+    offset = 0;
+
+    /* decrypt the payload. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_stream_decrypt(
+            &chan->read_stream, header + header_sz, *size, sock_impl->pool,
+            &offset))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_val;
+    }
+
+    /* finally, drain the packet from this buffer. */
+    if (0 != evbuffer_drain(sock_impl->readbuf, packet_size))
+    {
+        retval = AGENTD_ERROR_IPC_READ_BUFFER_DRAIN_FAILURE;
+        goto cleanup_val;
+    }
+
+    /* lend the decrypted payload to the caller until it is released. */
+    *val = sock_impl->pool;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto cleanup_mac;
+
+cleanup_val:
+    memset(sock_impl->pool, 0, sock_impl->pool_used);
+    sock_impl->pool_used = 0U;
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+cleanup_dheader:
+    memset(dheader, 0, sizeof(dheader));
+
+done:
+    return retval;
+}
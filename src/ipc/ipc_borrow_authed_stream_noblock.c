@@ -0,0 +1,94 @@
+/**
+ * \file ipc/ipc_borrow_authed_stream_noblock.c
+ *
+ * \brief Borrow the next frame of a streamed authenticated message.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Borrow the next frame of a streamed authenticated message from a
+ * non-blocking socket.
+ *
+ * The frame type is returned in frame.  For a begin frame, the total size of
+ * the stream is available in reader->total_size.  For a chunk frame, val and
+ * size describe the chunk, which is borrowed as per
+ * \ref ipc_borrow_authed_data_noblock().  For begin and end frames, val is
+ * set to NULL and size to 0.  In every case, \ref ipc_release_data_noblock()
+ * must be called before the next read on this socket.
+ *
+ * Frames that arrive out of order, chunks that overrun the total size, and an
+ * end frame before the full payload has arrived are rejected.
+ *
+ * \param sock          The socket context from which the frame is read.
+ * \param iv            The 64-bit IV to expect for this frame.
+ * \param reader        The stream state for this socket.
+ * \param frame         Pointer to receive the frame type.
+ * \param val           Pointer to receive the chunk pointer.
+ * \param size          Pointer to receive the chunk size.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if the frame was out of
+ *        order or the wrong size.
+ *      - any of the errors returned by
+ *        \ref ipc_borrow_authed_data_noblock().
+ */
+int ipc_borrow_authed_stream_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, ipc_stream_reader_t* reader,
+    int* frame, void** val, uint32_t* size, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* secret)
+{
+    int retval = 0;
+    void* payload = NULL;
+    uint32_t payload_size = 0U;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != reader);
+    MODEL_ASSERT(NULL != frame);
+    MODEL_ASSERT(NULL != val);
+    MODEL_ASSERT(NULL != size);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+
+    /* each frame is a single authenticated packet. */
+    retval =
+        ipc_borrow_authed_data_noblock(
+            sock, iv, &payload, &payload_size, suite, secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* check the frame against the stream state. */
+    const void* chunk = NULL;
+    retval =
+        ipc_stream_reader_accept(
+            reader, payload, payload_size, frame, &chunk, size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto release_frame;
+    }
+
+    *val = (void*)chunk;
+
+    /* success; the caller releases the frame. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+release_frame:
+    ipc_release_data_noblock(sock);
+
+done:
+    return retval;
+}
@@ -0,0 +1,123 @@
+/**
+ * \file ipc/ipc_borrow_data_noblock.c
+ *
+ * \brief Non-blocking borrowed read of a data packet value.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Borrow a raw data packet from a non-blocking socket.
+ *
+ * On success, val is set to point to the payload of this packet in the
+ * socket's read buffer, and size is set to the size of the payload.  No copy
+ * is made.  The payload remains valid until \ref ipc_release_data_noblock() is
+ * called, which must happen before any other read on this socket.
+ *
+ * \param sock          The socket context from which the value is read.
+ * \param val           Pointer to receive the payload pointer.
+ * \param size          Pointer to the variable to receive the size of this
+ *                      packet.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
+ *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if an unexpected data type
+ *        was encountered when attempting to read this value.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if an unexpected data size
+ *        was encountered when attempting to read this value.
+ */
+int ipc_borrow_data_noblock(
+    ipc_socket_context_t* sock, void** val, uint32_t* size)
+{
+    ssize_t retval = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+    MODEL_ASSERT(NULL != ((ipc_socket_impl_t*)sock->impl)->readbuf);
+    MODEL_ASSERT(0U == ((ipc_socket_impl_t*)sock->impl)->borrowed_size);
+    MODEL_ASSERT(NULL != val);
+    MODEL_ASSERT(NULL != size);
+
+    /* get the socket details. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* compute the header size. */
+    ssize_t header_sz = sizeof(uint8_t) + sizeof(uint32_t);
+
+    /* make sure that the header is buffered, reading ahead if needed. */
+    retval = ipc_socket_read_ahead(sock, header_sz);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* we need the header data. */
+    uint8_t* mem = (uint8_t*)evbuffer_pullup(sock_impl->readbuf, header_sz);
+    if (NULL == mem)
+    {
+        retval = AGENTD_ERROR_IPC_WOULD_BLOCK;
+        goto done;
+    }
+
+    /* if the type does not match our expected type, return an error. */
+    if (IPC_DATA_TYPE_DATA_PACKET != mem[0])
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE;
+        goto done;
+    }
+
+    /* decode the size of this packet. */
+    uint32_t nsize = 0;
+    memcpy(&nsize, mem + 1, sizeof(uint32_t));
+
+    /* sanity check on size. */
+    *size = ntohl(nsize);
+    if (*size <= 0 || *size >= 1024 * 1024 * 1024)
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+        goto done;
+    }
+
+    /* make sure that the whole packet is buffered. */
+    size_t packet_size = *size + (size_t)header_sz;
+    retval = ipc_socket_read_ahead(sock, packet_size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* linearize the packet in the read buffer. */
+    mem = (uint8_t*)evbuffer_pullup(sock_impl->readbuf, packet_size);
+    if (NULL == mem)
+    {
+        retval = AGENTD_ERROR_IPC_WOULD_BLOCK;
+        goto done;
+    }
+
+    /* lend the payload to the caller until it is released. */
+    *val = mem + header_sz;
+    sock_impl->borrowed_size = packet_size;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
@@ -43,6 +43,8 @@
  *        created.
  *      - AGENTD_ERROR_IPC_EVENT_ADD_FAILURE if the event cannot be added to the
  *        event loop.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the write buffer watermark
+ *        callback could not be added.
  */
 int ipc_event_loop_add(
     ipc_event_loop_context_t* loop, ipc_socket_context_t* sock)
@@ -79,6 +81,13 @@ int ipc_event_loop_add(
         }
     }
 
+    /* watch the write buffer for watermark crossings. */
+    retval = ipc_socket_watermark_attach(sock);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_writebuf;
+    }
+
     /* maybe create a read event. */
     if (sock->read)
     {
@@ -100,8 +109,8 @@ int ipc_event_loop_add(
             goto cleanup_writebuf;
         }
 
-        /* add the event to the event base. */
-        if (0 != event_add(sock_impl->read_ev, NULL))
+        /* add the event to the event base, unless reads are paused. */
+        if (0 != ipc_socket_read_event_add(sock_impl))
         {
             retval = AGENTD_ERROR_IPC_EVENT_ADD_FAILURE;
             goto cleanup_read_ev;
@@ -137,6 +146,9 @@ int ipc_event_loop_add(
         }
     }
 
+    /* remember the loop, so corked writes can be flushed by it. */
+    sock_impl->loop = loop_impl;
+
     /* success. */
     retval = AGENTD_STATUS_SUCCESS;
     goto done;
@@ -158,6 +170,7 @@ cleanup_read_ev:
 cleanup_writebuf:
     evbuffer_free(sock_impl->writebuf);
     sock_impl->writebuf = NULL;
+    sock_impl->watermark_entry = NULL;
 
 cleanup_readbuf:
     evbuffer_free(sock_impl->readbuf);
@@ -0,0 +1,52 @@
+/**
+ * \file ipc/ipc_event_loop_flush.c
+ *
+ * \brief Flush corked sockets at the end of an event loop iteration.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Flush every corked socket with pending data, once.
+ *
+ * Each socket gets a single write.  Anything that the socket does not accept
+ * stays in the write buffer for the socket's write callback, and errors are
+ * left for that callback to discover.
+ *
+ * \param loop_impl The event loop whose sockets are flushed.
+ */
+void ipc_event_loop_flush(ipc_event_loop_impl_t* loop_impl)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != loop_impl);
+
+    /* take the list of sockets to flush. */
+    ipc_socket_context_t* sock = loop_impl->flush_head;
+    loop_impl->flush_head = NULL;
+
+    while (NULL != sock)
+    {
+        ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+        ipc_socket_context_t* next = sock_impl->flush_next;
+
+        /* this socket is no longer queued. */
+        sock_impl->flush_pending = false;
+        sock_impl->flush_next = NULL;
+
+        /* write whatever the socket will take, and ring any doorbell for
+         * packets placed directly in a ring. */
+        if ((NULL != sock_impl->writebuf
+                && evbuffer_get_length(sock_impl->writebuf) > 0)
+         || (NULL != sock_impl->ring && sock_impl->ring->doorbell_pending))
+        {
+            ipc_socket_write_from_buffer(sock);
+        }
+
+        sock = next;
+    }
+}
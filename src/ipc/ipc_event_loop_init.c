@@ -110,6 +110,18 @@ static void ipc_event_loop_dispose(void* disposable)
         internal->sig_head = next;
     }
 
+    /* sockets still waiting for a flush no longer belong to this loop. */
+    while (NULL != internal->flush_head)
+    {
+        ipc_socket_impl_t* sock_impl =
+            (ipc_socket_impl_t*)internal->flush_head->impl;
+
+        internal->flush_head = sock_impl->flush_next;
+        sock_impl->flush_pending = false;
+        sock_impl->flush_next = NULL;
+        sock_impl->loop = NULL;
+    }
+
     /* clean up the event. */
     event_base_free(internal->evb);
 
@@ -0,0 +1,117 @@
+/**
+ * \file ipc/ipc_event_loop_on_signal.c
+ *
+ * \brief Call a user callback when a given signal is caught.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/* forward decls */
+static void ipc_signal_callback_cb(evutil_socket_t, short, void*);
+
+/**
+ * \brief Call the given callback when the given signal is caught.
+ *
+ * Unlike \ref ipc_exit_loop_on_signal(), the event loop keeps running after
+ * the callback returns.  The callback is called from the event loop, so it is
+ * free to use any of the loop's sockets and timers.
+ *
+ * \param loop          The event loop context on which the callback is run.
+ * \param sig           The signal that triggers this callback.
+ * \param cb            The callback to call when the signal is caught.
+ * \param user_context  The user context to pass to the callback.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ *      - AGENTD_ERROR_IPC_EVSIGNAL_NEW_FAILURE if a new signal event could not
+ *        be created.
+ *      - AGENTD_ERROR_IPC_EVENT_ADD_FAILURE if the signal event could not be
+ *        added to the event base.
+ */
+int ipc_event_loop_on_signal(
+    ipc_event_loop_context_t* loop, int sig, ipc_signal_event_cb_t cb,
+    void* user_context)
+{
+    int retval = 0;
+
+    /* parameter sanity checking. */
+    MODEL_ASSERT(NULL != loop);
+    MODEL_ASSERT(NULL != cb);
+
+    /* get the impls. */
+    ipc_event_loop_impl_t* loop_impl = (ipc_event_loop_impl_t*)loop->impl;
+
+    /* create an event structure. */
+    ipc_signal_event_impl_t* sigev =
+        (ipc_signal_event_impl_t*)malloc(sizeof(ipc_signal_event_impl_t));
+    if (NULL == sigev)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* save the callback details. */
+    memset(sigev, 0, sizeof(ipc_signal_event_impl_t));
+    sigev->sig = sig;
+    sigev->callback = cb;
+    sigev->user_context = user_context;
+
+    /* create the event for this signal. */
+    sigev->ev =
+        evsignal_new(loop_impl->evb, sig, &ipc_signal_callback_cb, sigev);
+    if (NULL == sigev->ev)
+    {
+        retval = AGENTD_ERROR_IPC_EVSIGNAL_NEW_FAILURE;
+        goto cleanup_sigev;
+    }
+
+    /* add the event to the event base. */
+    if (0 != event_add(sigev->ev, NULL))
+    {
+        retval = AGENTD_ERROR_IPC_EVENT_ADD_FAILURE;
+        goto cleanup_event;
+    }
+
+    /* add this event structure to our loop. */
+    sigev->next = loop_impl->sig_head;
+    loop_impl->sig_head = sigev;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+cleanup_event:
+    event_free(sigev->ev);
+    sigev->ev = NULL;
+
+cleanup_sigev:
+    free(sigev);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Event loop callback.  Pass the signal on to the user callback.
+ *
+ * \param fd        The signal number for this callback.
+ * \param what      The flags for this event.
+ * \param ctx       The signal event for this callback.
+ */
+static void ipc_signal_callback_cb(
+    evutil_socket_t UNUSED(fd), short UNUSED(what), void* ctx)
+{
+    ipc_signal_event_impl_t* sigev = (ipc_signal_event_impl_t*)ctx;
+
+    sigev->callback(sigev->sig, sigev->user_context);
+}
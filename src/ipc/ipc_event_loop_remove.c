@@ -56,6 +56,10 @@ int ipc_event_loop_remove(
         sock_impl->write_ev = NULL;
     }
 
+    /* this socket will no longer be flushed by the loop. */
+    ipc_socket_flush_cancel(sock);
+    sock_impl->loop = NULL;
+
     /* free the buffers if set. */
     if (NULL != sock_impl->readbuf)
         evbuffer_free(sock_impl->readbuf);
@@ -63,6 +67,9 @@ int ipc_event_loop_remove(
         evbuffer_free(sock_impl->writebuf);
     sock_impl->readbuf = sock_impl->writebuf = NULL;
 
+    /* the watermark callback went with the write buffer. */
+    sock_impl->watermark_entry = NULL;
+
     /* success. */
     return AGENTD_STATUS_SUCCESS;
 }
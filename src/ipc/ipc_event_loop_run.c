@@ -18,18 +18,35 @@
 /**
  * \brief Run the event loop for IPC non-blocking I/O.
  *
+ * The loop is run one iteration at a time, so that corked sockets can be
+ * flushed at the end of each iteration.
+ *
  * \param loop          The event loop context to run.
  *
  * \returns 0 on success and non-zero on failure.
  */
 ssize_t ipc_event_loop_run(ipc_event_loop_context_t* loop)
 {
+    int retval;
+
     /* parameter sanity check. */
     MODEL_ASSERT(NULL != loop);
 
     /* get the loop impl. */
     ipc_event_loop_impl_t* loop_impl = (ipc_event_loop_impl_t*)loop->impl;
 
+    /* run until the loop is exited, broken, or runs out of events. */
+    do
+    {
+        /* run a single iteration of the event loop. */
+        retval = event_base_loop(loop_impl->evb, EVLOOP_ONCE);
+
+        /* flush any writes corked during this iteration. */
+        ipc_event_loop_flush(loop_impl);
+    } while (0 == retval
+          && !event_base_got_exit(loop_impl->evb)
+          && !event_base_got_break(loop_impl->evb));
+
     /* return the status code from running the event loop. */
-    return event_base_loop(loop_impl->evb, 0);
+    return retval;
 }
@@ -11,14 +11,99 @@
 
 #include <agentd/ipc.h>
 #include <event.h>
+#include <stdatomic.h>
+#include <stdbool.h>
 #include <stdint.h>
+#include <vccrypt/suite.h>
 #include <vpr/disposable.h>
+#include <vpr/parameters.h>
 
 /* make this header C++ friendly. */
 #ifdef __cplusplus
 extern "C" {
 #endif  //__cplusplus
 
+/**
+ * \brief Crypto state kept for authenticated packets on a non-blocking socket.
+ *
+ * The stream ciphers are keyed once per socket and only re-IVed per packet.
+ *
+ * There is no MAC context here.  vccrypt can neither reset a finalized MAC
+ * context nor copy a keyed one, so a MAC context can't be reused across
+ * packets.  An HMAC must also hash its padded key block again for every
+ * message unless the hash midstate can be copied, which vccrypt's hash
+ * interface does not allow.  A cached context would therefore only save the
+ * context allocation, and the mac_short cases of agentd-ipc-bench measure that
+ * cost against the whole per-packet MAC.
+ */
+typedef struct ipc_authed_channel
+{
+    vccrypt_suite_options_t* suite;
+    vccrypt_buffer_t secret;
+    vccrypt_stream_context_t read_stream;
+    vccrypt_stream_context_t write_stream;
+    vccrypt_buffer_t read_digest;
+    vccrypt_buffer_t write_digest;
+} ipc_authed_channel_t;
+
+/**
+ * \brief One direction of a shared-memory ring.
+ *
+ * head and tail are free-running byte counters, owned by the producer and the
+ * consumer respectively, and kept on separate cache lines.
+ */
+typedef struct ipc_ring_half
+{
+    _Alignas(64) _Atomic uint32_t head;
+    _Alignas(64) _Atomic uint32_t tail;
+    _Atomic uint32_t writer_waiting;
+    _Atomic uint32_t writer_closed;
+    _Atomic uint32_t reader_closed;
+} ipc_ring_half_t;
+
+/**
+ * \brief Header at the start of a shared-memory ring mapping.
+ *
+ * half[0] carries data from the left-hand side to the right-hand side, and
+ * half[1] the other way.  The data areas for each half follow the header.
+ */
+typedef struct ipc_ring_shared
+{
+    uint32_t magic;
+    uint32_t capacity;
+    ipc_ring_half_t half[2];
+} ipc_ring_shared_t;
+
+/**
+ * \brief Magic number identifying a shared-memory ring mapping.
+ */
+#define IPC_RING_MAGIC 0x52474E49U
+
+/**
+ * \brief The smallest and largest capacity of one direction of a ring.
+ */
+#define IPC_RING_MIN_CAPACITY 4096U
+#define IPC_RING_MAX_CAPACITY (1024U * 1024U * 1024U)
+
+/**
+ * \brief One side's view of a shared-memory ring.
+ */
+typedef struct ipc_ring
+{
+    ipc_ring_shared_t* shared;
+    size_t map_size;
+    uint32_t mask;
+    ipc_ring_half_t* rx;
+    ipc_ring_half_t* tx;
+    uint8_t* rx_data;
+    uint8_t* tx_data;
+    int peer_doorbell;
+    bool doorbell_pending;
+} ipc_ring_t;
+
+/* forward decl for the event loop impl. */
+struct ipc_event_loop_impl;
+
 /**
  * \brief Internal context for non-blocking sockets.
  */
@@ -28,8 +113,32 @@ typedef struct ipc_socket_impl
     struct event* write_ev;
     struct evbuffer* readbuf;
     struct evbuffer* writebuf;
+    size_t borrowed_size;
+    uint8_t* pool;
+    size_t pool_size;
+    size_t pool_used;
+    size_t read_chunk;
+    ipc_authed_channel_t* authed;
+    ipc_ring_t* ring;
+    struct ipc_event_loop_impl* loop;
+    bool corked;
+    bool flush_pending;
+    ipc_socket_context_t* flush_next;
+    size_t low_watermark;
+    size_t high_watermark;
+    ipc_socket_watermark_cb_t watermark_cb;
+    struct evbuffer_cb_entry* watermark_entry;
+    bool above_watermark;
+    bool read_paused;
+    bool read_resume;
 } ipc_socket_impl_t;
 
+/**
+ * \brief The largest decrypted payload buffer that a socket keeps between
+ * authenticated reads.  Larger buffers are released along with the packet.
+ */
+#define IPC_SOCKET_POOL_RETAIN_MAX (64U * 1024U)
+
 /**
  * \brief Internal context for timers.
  */
@@ -45,6 +154,9 @@ typedef struct ipc_signal_event_impl
 {
     struct ipc_signal_event_impl* next;
     struct event* ev;
+    int sig;
+    ipc_signal_event_cb_t callback;
+    void* user_context;
 } ipc_signal_event_impl_t;
 
 /**
@@ -54,8 +166,208 @@ typedef struct ipc_event_loop_impl
 {
     struct event_base* evb;
     ipc_signal_event_impl_t* sig_head;
+    ipc_socket_context_t* flush_head;
 } ipc_event_loop_impl_t;
 
+/**
+ * \brief Release the decrypted payload buffer for a socket.
+ *
+ * \param impl      The socket implementation that owns the buffer.
+ */
+void ipc_socket_pool_release(ipc_socket_impl_t* impl);
+
+/**
+ * \brief Get the authed channel for a socket, keyed with the given suite and
+ * secret.
+ *
+ * The channel is created on first use and replaced if the suite or secret
+ * changes.  It is owned by the socket and released when the socket is
+ * disposed.
+ *
+ * \param impl      The socket implementation that owns the channel.
+ * \param suite     The crypto suite for this channel.
+ * \param secret    The shared secret for this channel.
+ * \param channel   Pointer to receive the channel on success.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_authed_channel_get(
+    ipc_socket_impl_t* impl, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* secret, ipc_authed_channel_t** channel);
+
+/**
+ * \brief Release the authed channel for a socket.
+ *
+ * \param impl      The socket implementation that owns the channel.
+ */
+void ipc_authed_channel_release(ipc_socket_impl_t* impl);
+
+/**
+ * \brief Read up to howmuch bytes from a socket into its read buffer.
+ *
+ * \param sock      The socket to read.
+ * \param howmuch   The maximum number of bytes to read, or -1 for up to the
+ *                  socket's read chunk size.
+ *
+ * \returns the number of bytes read, 0 on EOF, or -1 on error with errno set.
+ */
+ssize_t ipc_socket_read_upto(ipc_socket_context_t* sock, int howmuch);
+
+/**
+ * \brief Make sure that at least needed bytes are in a socket's read buffer.
+ *
+ * If fewer bytes are buffered, this reads from the socket once, taking up to
+ * the socket's read chunk size or the rest of the needed bytes, whichever is
+ * larger, so that packets queued behind the current one are picked up by the
+ * same system call.
+ *
+ * \param sock      The socket to read.
+ * \param needed    The number of bytes that must be buffered.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS if at least needed bytes are buffered.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if fewer bytes are available.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
+ */
+int ipc_socket_read_ahead(ipc_socket_context_t* sock, size_t needed);
+
+/**
+ * \brief Read exactly size bytes from a blocking socket.
+ *
+ * \param sock      The blocking socket to read.
+ * \param buf       The buffer to read into.
+ * \param size      The number of bytes to read.
+ *
+ * \returns the number of bytes read, which is less than size only if the peer
+ * closed the socket or a read failed.
+ */
+ssize_t ipc_read_exact_block(int sock, void* buf, size_t size);
+
+/**
+ * \brief Compute the number of bytes that can be written to a ring.
+ *
+ * \param ring      The ring to check.
+ *
+ * \returns the free space in the transmit half of this ring.
+ */
+uint32_t ipc_ring_space(ipc_ring_t* ring);
+
+/**
+ * \brief Copy data into the transmit half of a ring, without publishing it.
+ *
+ * The caller must have checked that offset + size bytes are free.
+ *
+ * \param ring      The ring to write.
+ * \param offset    The offset past the current head at which to copy.
+ * \param data      The data to copy.
+ * \param size      The size of the data to copy.
+ */
+void ipc_ring_copy_in(
+    ipc_ring_t* ring, uint32_t offset, const void* data, uint32_t size);
+
+/**
+ * \brief Publish data copied into the transmit half of a ring to the reader.
+ *
+ * If the ring was empty, the peer's doorbell is marked as pending, to be rung
+ * by \ref ipc_ring_write().
+ *
+ * \param ring      The ring to publish.
+ * \param size      The number of bytes to publish.
+ */
+void ipc_ring_publish(ipc_ring_t* ring, uint32_t size);
+
+/**
+ * \brief Ring a doorbell.
+ *
+ * \param doorbell  The eventfd doorbell to ring.
+ */
+void ipc_ring_doorbell(int doorbell);
+
+/**
+ * \brief Read up to howmuch bytes from a ring socket into its read buffer.
+ *
+ * \param sock      The ring socket to read.
+ * \param howmuch   The maximum number of bytes to read, or -1 for as many as
+ *                  are available.
+ *
+ * \returns the number of bytes read, 0 if the peer has closed the ring and no
+ * data remains, or -1 on error with errno set.  errno is EAGAIN if the ring is
+ * empty.
+ */
+ssize_t ipc_ring_read(ipc_socket_context_t* sock, int howmuch);
+
+/**
+ * \brief Move the write buffer of a ring socket into the ring, and ring the
+ * peer's doorbell if it is pending.
+ *
+ * \param sock      The ring socket to write.
+ *
+ * \returns the number of bytes written, or -1 on error with errno set.  errno
+ * is EAGAIN if the ring is full and EPIPE if the peer has closed the ring.
+ */
+ssize_t ipc_ring_write(ipc_socket_context_t* sock);
+
+/**
+ * \brief Release the ring for a socket, telling the peer that it is closed.
+ *
+ * \param impl      The socket implementation that owns the ring.
+ */
+void ipc_ring_release(ipc_socket_impl_t* impl);
+
+/**
+ * \brief Watch the write buffer of a socket for watermark crossings.
+ *
+ * This is a no-op if the socket has no write buffer yet, or no watermarks.
+ *
+ * \param sock      The socket to watch.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the write buffer callback could
+ *        not be added.
+ */
+int ipc_socket_watermark_attach(ipc_socket_context_t* sock);
+
+/**
+ * \brief Add a read event to the event loop, unless reads are paused.
+ *
+ * \param sock_impl The socket implementation that owns the read event.
+ *
+ * \returns 0 on success and non-zero on failure, as per event_add().
+ */
+int ipc_socket_read_event_add(ipc_socket_impl_t* sock_impl);
+
+/**
+ * \brief Write the buffered data for a socket now, or defer it to the end of
+ * the event loop iteration if the socket is corked.
+ *
+ * \param sock      The socket to write.
+ *
+ * \returns the number of bytes written, 0 if the write was deferred, or -1 on
+ * error, as per \ref ipc_socket_write_from_buffer().
+ */
+ssize_t ipc_socket_write_or_defer(ipc_socket_context_t* sock);
+
+/**
+ * \brief Remove a socket from its event loop's list of sockets to flush.
+ *
+ * \param sock      The socket to remove.
+ */
+void ipc_socket_flush_cancel(ipc_socket_context_t* sock);
+
+/**
+ * \brief Flush every corked socket with pending data, once.
+ *
+ * \param loop_impl The event loop whose sockets are flushed.
+ */
+void ipc_event_loop_flush(ipc_event_loop_impl_t* loop_impl);
+
 /**
  * \brief Event loop callback.  Decode an event and send it to the ipc callback.
  *
@@ -60,6 +60,7 @@ int ipc_make_noblock(
 
     /* clear this structure. */
     memset(impl, 0, sizeof(ipc_socket_impl_t));
+    impl->read_chunk = IPC_SOCKET_DEFAULT_READ_CHUNK;
 
     /* set the socket to non-blocking. */
     ssize_t retval = ipc_fcntl_nonblock(sock);
@@ -119,6 +120,9 @@ static void ipc_socket_context_dispose(void* disposable)
     MODEL_ASSERT(NULL != ctx);
     MODEL_ASSERT(NULL != impl);
 
+    /* make sure the event loop no longer references this socket. */
+    ipc_socket_flush_cancel(ctx);
+
     /* if the read event is set for this socket, free it. */
     if (NULL != impl->read_ev)
     {
@@ -145,6 +149,15 @@ static void ipc_socket_context_dispose(void* disposable)
         evbuffer_free(impl->writebuf);
     }
 
+    /* clear and free the decrypted payload buffer. */
+    ipc_socket_pool_release(impl);
+
+    /* release the authed channel. */
+    ipc_authed_channel_release(impl);
+
+    /* release the shared-memory ring. */
+    ipc_ring_release(impl);
+
     /* close the socket. */
     close(ctx->fd);
 
@@ -0,0 +1,161 @@
+/**
+ * \file ipc/ipc_make_ring_noblock.c
+ *
+ * \brief Open one side of a shared-memory ring for non-blocking I/O.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Open one side of a shared-memory ring for asynchronous (non-blocking)
+ * I/O.  Afterward, the ipc_*_noblock socket I/O methods can be used exactly as
+ * they would be for a socket.
+ *
+ * The doorbell for this side becomes the descriptor of the socket context and
+ * is owned by it.  The shared memory and the peer's doorbell are duplicated
+ * or mapped, so the caller still owns memfd and peer_doorbell and should close
+ * them once both sides have been opened.  The blocking ipc_*_block methods do
+ * not work on a ring.
+ *
+ * \param memfd         The shared memory descriptor from \ref ipc_ringpair().
+ * \param side          The side of the ring being opened.  See
+ *                      \ref ipc_ring_side_enum_t.
+ * \param doorbell      The doorbell for this side.
+ * \param peer_doorbell The doorbell for the other side.
+ * \param ctx           The socket context to initialize using this call.
+ * \param user_context  The user context for this connection.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition
+ *        occurred during this operation.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if the side is invalid.
+ *      - AGENTD_ERROR_IPC_RING_MAP_FAILURE if mapping the shared memory or
+ *        duplicating the peer doorbell failed.
+ *      - AGENTD_ERROR_IPC_RING_INVALID if the shared memory is not a valid
+ *        ring.
+ *      - AGENTD_ERROR_IPC_FCNTL_GETFL_FAILURE if the fcntl flags could not be
+ *        read.
+ *      - AGENTD_ERROR_IPC_FCNTL_SETFL_FAILURE if the fcntl flags could not be
+ *        updated.
+ */
+int ipc_make_ring_noblock(
+    int memfd, int side, int doorbell, int peer_doorbell,
+    ipc_socket_context_t* ctx, void* user_context)
+{
+    int retval;
+    struct stat st;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(0 <= memfd);
+    MODEL_ASSERT(0 <= doorbell);
+    MODEL_ASSERT(0 <= peer_doorbell);
+    MODEL_ASSERT(NULL != ctx);
+
+    /* verify the side. */
+    if (IPC_RING_SIDE_LHS != side && IPC_RING_SIDE_RHS != side)
+    {
+        retval = AGENTD_ERROR_IPC_INVALID_ARGUMENT;
+        goto done;
+    }
+
+    /* allocate this side's view of the ring. */
+    ipc_ring_t* ring = (ipc_ring_t*)malloc(sizeof(ipc_ring_t));
+    if (NULL == ring)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    memset(ring, 0, sizeof(ipc_ring_t));
+
+    /* the shared memory must at least hold the header. */
+    if (0 != fstat(memfd, &st))
+    {
+        retval = AGENTD_ERROR_IPC_RING_MAP_FAILURE;
+        goto cleanup_ring;
+    }
+
+    if (st.st_size < (off_t)sizeof(ipc_ring_shared_t))
+    {
+        retval = AGENTD_ERROR_IPC_RING_INVALID;
+        goto cleanup_ring;
+    }
+
+    /* map the shared memory. */
+    ring->map_size = (size_t)st.st_size;
+    ring->shared =
+        (ipc_ring_shared_t*)mmap(
+            NULL, ring->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, memfd, 0);
+    if (MAP_FAILED == ring->shared)
+    {
+        retval = AGENTD_ERROR_IPC_RING_MAP_FAILURE;
+        goto cleanup_ring;
+    }
+
+    /* verify the header.  The capacity is only read once, so the peer can't
+     * change it out from under us. */
+    uint32_t capacity = ring->shared->capacity;
+    if (IPC_RING_MAGIC != ring->shared->magic
+     || capacity < IPC_RING_MIN_CAPACITY || capacity > IPC_RING_MAX_CAPACITY
+     || 0U != (capacity & (capacity - 1U))
+     || ring->map_size
+            < sizeof(ipc_ring_shared_t) + 2U * (size_t)capacity)
+    {
+        retval = AGENTD_ERROR_IPC_RING_INVALID;
+        goto cleanup_map;
+    }
+
+    /* the left-hand side transmits on the first half. */
+    size_t tx_index = (IPC_RING_SIDE_LHS == side) ? 0U : 1U;
+    size_t rx_index = 1U - tx_index;
+    uint8_t* data = ((uint8_t*)ring->shared) + sizeof(ipc_ring_shared_t);
+    ring->mask = capacity - 1U;
+    ring->tx = &ring->shared->half[tx_index];
+    ring->rx = &ring->shared->half[rx_index];
+    ring->tx_data = data + tx_index * capacity;
+    ring->rx_data = data + rx_index * capacity;
+
+    /* keep our own handle to the peer's doorbell. */
+    ring->peer_doorbell = dup(peer_doorbell);
+    if (ring->peer_doorbell < 0)
+    {
+        retval = AGENTD_ERROR_IPC_RING_MAP_FAILURE;
+        goto cleanup_map;
+    }
+
+    /* our doorbell drives the socket context. */
+    retval = ipc_make_noblock(doorbell, ctx, user_context);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_peer_doorbell;
+    }
+
+    /* success. */
+    ((ipc_socket_impl_t*)ctx->impl)->ring = ring;
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+cleanup_peer_doorbell:
+    close(ring->peer_doorbell);
+
+cleanup_map:
+    munmap(ring->shared, ring->map_size);
+
+cleanup_ring:
+    free(ring);
+
+done:
+    return retval;
+}
@@ -0,0 +1,48 @@
+/**
+ * \file ipc/ipc_pause_read_noblock.c
+ *
+ * \brief Stop delivering read events for a non-blocking socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Stop delivering read events for a non-blocking socket.
+ *
+ * While paused, the read callback can still be changed with
+ * \ref ipc_set_readcb_noblock(), but it is not called until the socket is
+ * resumed.
+ *
+ * \param sock          The socket to pause.
+ */
+void ipc_pause_read_noblock(ipc_socket_context_t* sock)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    if (sock_impl->read_paused)
+    {
+        return;
+    }
+
+    sock_impl->read_paused = true;
+    sock_impl->read_resume = false;
+
+    /* only a pending read event is taken out of the loop, so that a one-shot
+     * event that has already fired isn't brought back on resume. */
+    if (NULL != sock_impl->read_ev
+     && event_pending(sock_impl->read_ev, EV_READ, NULL))
+    {
+        event_del(sock_impl->read_ev);
+        sock_impl->read_resume = true;
+    }
+}
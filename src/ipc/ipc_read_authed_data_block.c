@@ -16,6 +16,8 @@
 #include <vccrypt/compare.h>
 #include <vpr/parameters.h>
 
+#include "ipc_internal.h"
+
 /**
  * \brief Read an authenticated data packet from the blocking socket.
  *
@@ -89,7 +91,8 @@ int ipc_read_authed_data_block(
     dheader = (uint8_t*)dhbuffer.data;
 
     /* attempt to read the header. */
-    if ((ssize_t)header_size != read(sock, header, header_size))
+    if ((ssize_t)header_size
+        != ipc_read_exact_block(sock, header, header_size))
     {
         retval = AGENTD_ERROR_IPC_READ_BLOCK_FAILURE;
         goto cleanup_dhbuffer;
@@ -142,7 +145,7 @@ int ipc_read_authed_data_block(
     /* verify that the size makes sense. */
     memcpy(&nsize, dheader + 1, sizeof(nsize));
     *size = ntohl(nsize);
-    if (*size > 10ULL * 1024ULL * 1024ULL /* 10 MB */)
+    if (*size > IPC_AUTHED_PACKET_MAX_SIZE)
     {
         retval = AGENTD_ERROR_IPC_UNAUTHORIZED_PACKET;
         goto cleanup_mac;
@@ -158,7 +161,7 @@ int ipc_read_authed_data_block(
     }
 
     /* read the payload. */
-    if (*size != read(sock, payload.data, *size))
+    if ((ssize_t)*size != ipc_read_exact_block(sock, payload.data, *size))
     {
         retval = AGENTD_ERROR_IPC_READ_BLOCK_FAILURE;
         goto cleanup_payload;
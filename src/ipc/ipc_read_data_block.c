@@ -15,6 +15,8 @@
 #include <unistd.h>
 #include <vpr/parameters.h>
 
+#include "ipc_internal.h"
+
 /**
  * \brief Read a raw data packet from the blocking socket.
  *
@@ -72,7 +74,7 @@ int ipc_read_data_block(int sock, void** val, uint32_t* size)
         return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
 
     /* attempt to read the data. */
-    if (*size != read(sock, *val, *size))
+    if ((ssize_t)*size != ipc_read_exact_block(sock, *val, *size))
     {
         free(*val);
         *val = NULL;
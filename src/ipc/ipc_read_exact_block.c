@@ -0,0 +1,52 @@
+/**
+ * \file ipc/ipc_read_exact_block.c
+ *
+ * \brief Read an exact number of bytes from a blocking socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Read exactly size bytes from a blocking socket.
+ *
+ * A stream socket can return a large packet over several reads, so this keeps
+ * reading until the full size has arrived.
+ *
+ * \param sock      The blocking socket to read.
+ * \param buf       The buffer to read into.
+ * \param size      The number of bytes to read.
+ *
+ * \returns the number of bytes read, which is less than size only if the peer
+ * closed the socket or a read failed.
+ */
+ssize_t ipc_read_exact_block(int sock, void* buf, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(sock >= 0);
+    MODEL_ASSERT(NULL != buf || 0 == size);
+
+    size_t total = 0;
+
+    while (total < size)
+    {
+        ssize_t n = read(sock, (uint8_t*)buf + total, size - total);
+        if (n < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        else if (n <= 0)
+        {
+            break;
+        }
+
+        total += (size_t)n;
+    }
+
+    return (ssize_t)total;
+}
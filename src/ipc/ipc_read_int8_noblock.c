@@ -29,6 +29,9 @@
  *      - AGENTD_STATUS_SUCCESS on success.
  *      - AGENTD_ERROR_IPC_WOULD_BLOCK if the the operation was halted because
  *        it would block this thread.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read was
  *        unexpected.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the data size read was
@@ -52,11 +55,11 @@ int ipc_read_int8_noblock(ipc_socket_context_t* sock, int8_t* val)
     /* compute the header size. */
     ssize_t header_sz = sizeof(uint8_t) + sizeof(uint32_t);
 
-    /* read data from the socket into our buffer. */
-    int retval = evbuffer_read(sock_impl->readbuf, sock->fd, -1);
-    if (retval < 0)
+    /* make sure that the header is buffered, reading ahead if needed. */
+    int retval = ipc_socket_read_ahead(sock, header_sz);
+    if (AGENTD_STATUS_SUCCESS != retval)
     {
-        return AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE;
+        return retval;
     }
 
     /* we need the header data. */
@@ -83,11 +86,11 @@ int ipc_read_int8_noblock(ipc_socket_context_t* sock, int8_t* val)
         return AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
     }
 
-    /* if the buffer size is less than this size, wait for more data to be
-     * available. */
-    if (evbuffer_get_length(sock_impl->readbuf) < (size + (size_t)header_sz))
+    /* make sure that the value is buffered. */
+    retval = ipc_socket_read_ahead(sock, size + (size_t)header_sz);
+    if (AGENTD_STATUS_SUCCESS != retval)
     {
-        return AGENTD_ERROR_IPC_WOULD_BLOCK;
+        return retval;
     }
 
     /* drain the header from the buffer. */
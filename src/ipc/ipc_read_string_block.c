@@ -15,6 +15,8 @@
 #include <unistd.h>
 #include <vpr/parameters.h>
 
+#include "ipc_internal.h"
+
 /**
  * \brief Read a character string from the blocking socket.
  *
@@ -72,7 +74,7 @@ int ipc_read_string_block(int sock, char** val)
         return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
 
     /* attempt to read the string. */
-    if (size != read(sock, *val, size))
+    if ((ssize_t)size != ipc_read_exact_block(sock, *val, size))
     {
         free(*val);
         *val = NULL;
@@ -0,0 +1,104 @@
+/**
+ * \file ipc/ipc_receivesockets_noblock.c
+ *
+ * \brief Non-blocking read of a batch of sockets from the Unix domain socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Receive a batch of socket descriptors sent by the unix domain peer in
+ * a single message.
+ *
+ * This reads one message sent by \ref ipc_sendsockets_noblock() or
+ * \ref ipc_sendsocket_block().  socks must have room for IPC_SOCKET_BATCH_MAX
+ * descriptors.  The caller owns the received socket handles and must close
+ * them when no longer needed.
+ *
+ * \param ctx           The unix domain socket from which the descriptors are
+ *                      received.
+ * \param socks         Array to receive the socket descriptors.
+ * \param count         Pointer to receive the number of descriptors received.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this operation would block.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if this operation failed.
+ */
+int ipc_receivesockets_noblock(
+    ipc_socket_context_t* ctx, int* socks, size_t* count)
+{
+    struct msghdr m;
+    struct cmsghdr* cm;
+    struct iovec iov;
+    char dummy[100];
+    char buf[CMSG_SPACE(IPC_SOCKET_BATCH_MAX * sizeof(int))];
+    ssize_t readlen;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != ctx);
+    MODEL_ASSERT(NULL != socks);
+    MODEL_ASSERT(NULL != count);
+
+    /* set up receive buffer */
+    iov.iov_base = dummy;
+    iov.iov_len = sizeof(dummy);
+    memset(&m, 0, sizeof(m));
+    m.msg_iov = &iov;
+    m.msg_iovlen = 1;
+    m.msg_controllen = sizeof(buf);
+    m.msg_control = buf;
+
+    *count = 0U;
+
+    /* read a message from the socket. */
+    readlen = recvmsg(ctx->fd, &m, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    if (readlen < 0)
+    {
+        if (EWOULDBLOCK == errno || EAGAIN == errno)
+        {
+            return AGENTD_ERROR_IPC_WOULD_BLOCK;
+        }
+        else
+        {
+            return AGENTD_ERROR_IPC_READ_BLOCK_FAILURE;
+        }
+    }
+
+    /* collect every socket passed in the control messages. */
+    for (cm = CMSG_FIRSTHDR(&m); NULL != cm; cm = CMSG_NXTHDR(&m, cm))
+    {
+        if (SOL_SOCKET == cm->cmsg_level && SCM_RIGHTS == cm->cmsg_type)
+        {
+            size_t fds = (cm->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+
+            /* the control buffer only has room for a single batch. */
+            if (*count + fds > IPC_SOCKET_BATCH_MAX)
+            {
+                fds = IPC_SOCKET_BATCH_MAX - *count;
+            }
+
+            memcpy(socks + *count, CMSG_DATA(cm), fds * sizeof(int));
+            *count += fds;
+        }
+    }
+
+    /* Verify that we received at least one socket. */
+    if (0U == *count)
+    {
+        return AGENTD_ERROR_IPC_READ_BLOCK_FAILURE;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/**
+ * \file ipc/ipc_release_data_noblock.c
+ *
+ * \brief Release a borrowed data packet.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Release a data packet borrowed from a non-blocking socket.
+ *
+ * The packet is drained from the socket's read buffer, and any decrypted
+ * payload is cleared.  It is safe to call this method when no packet is
+ * borrowed.
+ *
+ * \param sock          The socket context from which the packet was borrowed.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BUFFER_DRAIN_FAILURE if draining the read buffer
+ *        failed.
+ */
+int ipc_release_data_noblock(ipc_socket_context_t* sock)
+{
+    int retval = AGENTD_STATUS_SUCCESS;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket details. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* drain the borrowed packet from the read buffer. */
+    if (sock_impl->borrowed_size > 0U)
+    {
+        if (0 != evbuffer_drain(sock_impl->readbuf, sock_impl->borrowed_size))
+        {
+            retval = AGENTD_ERROR_IPC_READ_BUFFER_DRAIN_FAILURE;
+        }
+
+        sock_impl->borrowed_size = 0U;
+    }
+
+    /* clear the decrypted payload, keeping small buffers for reuse. */
+    if (sock_impl->pool_size > IPC_SOCKET_POOL_RETAIN_MAX)
+    {
+        ipc_socket_pool_release(sock_impl);
+    }
+    else if (sock_impl->pool_used > 0U)
+    {
+        memset(sock_impl->pool, 0, sock_impl->pool_used);
+        sock_impl->pool_used = 0U;
+    }
+
+    return retval;
+}
@@ -0,0 +1,42 @@
+/**
+ * \file ipc/ipc_resume_read_noblock.c
+ *
+ * \brief Resume delivering read events for a paused non-blocking socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Resume delivering read events for a paused non-blocking socket.
+ *
+ * \param sock          The socket to resume.
+ */
+void ipc_resume_read_noblock(ipc_socket_context_t* sock)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    if (!sock_impl->read_paused)
+    {
+        return;
+    }
+
+    sock_impl->read_paused = false;
+
+    /* put back the read event that was pending when we paused. */
+    if (sock_impl->read_resume && NULL != sock_impl->read_ev)
+    {
+        event_add(sock_impl->read_ev, NULL);
+    }
+
+    sock_impl->read_resume = false;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file ipc/ipc_ring_copy_in.c
+ *
+ * \brief Copy data into a shared-memory ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Copy data into the transmit half of a ring, without publishing it.
+ *
+ * The caller must have checked that offset + size bytes are free.
+ *
+ * \param ring      The ring to write.
+ * \param offset    The offset past the current head at which to copy.
+ * \param data      The data to copy.
+ * \param size      The size of the data to copy.
+ */
+void ipc_ring_copy_in(
+    ipc_ring_t* ring, uint32_t offset, const void* data, uint32_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != ring);
+    MODEL_ASSERT(NULL != data || 0U == size);
+    MODEL_ASSERT(offset + size <= ipc_ring_space(ring));
+
+    uint32_t head = atomic_load_explicit(&ring->tx->head, memory_order_relaxed);
+    uint32_t start = (head + offset) & ring->mask;
+
+    /* copy up to the end of the ring, then wrap around. */
+    uint32_t first = ring->mask + 1U - start;
+    if (first > size)
+    {
+        first = size;
+    }
+
+    if (first > 0U)
+    {
+        memcpy(ring->tx_data + start, data, first);
+    }
+
+    if (size > first)
+    {
+        memcpy(ring->tx_data, ((const uint8_t*)data) + first, size - first);
+    }
+}
@@ -0,0 +1,44 @@
+/**
+ * \file ipc/ipc_ring_descriptors_close.c
+ *
+ * \brief Close the descriptors of a shared-memory ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <unistd.h>
+
+/* forward decls. */
+static void ipc_ring_descriptor_close(int* desc);
+
+/**
+ * \brief Close any open descriptors of a shared-memory ring, and set them to
+ * -1.
+ *
+ * \param ring          The ring descriptors to close.
+ */
+void ipc_ring_descriptors_close(ipc_ring_descriptors_t* ring)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != ring);
+
+    ipc_ring_descriptor_close(&ring->memfd);
+    ipc_ring_descriptor_close(&ring->lhs);
+    ipc_ring_descriptor_close(&ring->rhs);
+}
+
+/**
+ * \brief Close a single ring descriptor, if it is open.
+ *
+ * \param desc          Pointer to the descriptor to close.
+ */
+static void ipc_ring_descriptor_close(int* desc)
+{
+    if (*desc >= 0)
+    {
+        close(*desc);
+        *desc = -1;
+    }
+}
@@ -0,0 +1,36 @@
+/**
+ * \file ipc/ipc_ring_descriptors_valid.c
+ *
+ * \brief Check whether the descriptors of a shared-memory ring are open.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * \brief Check whether every descriptor of a shared-memory ring is open.
+ *
+ * Services use this to find out whether the process that spawned them handed
+ * them a ring alongside their sockets.
+ *
+ * \param ring          The ring descriptors to check.
+ *
+ * \returns true if the memfd and both doorbells are open, and false otherwise.
+ */
+bool ipc_ring_descriptors_valid(const ipc_ring_descriptors_t* ring)
+{
+    struct stat statbuf;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != ring);
+
+    return
+        ring->memfd >= 0 && 0 == fstat(ring->memfd, &statbuf)
+     && ring->lhs >= 0 && 0 == fstat(ring->lhs, &statbuf)
+     && ring->rhs >= 0 && 0 == fstat(ring->rhs, &statbuf);
+}
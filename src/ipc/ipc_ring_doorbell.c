@@ -0,0 +1,26 @@
+/**
+ * \file ipc/ipc_ring_doorbell.c
+ *
+ * \brief Ring a shared-memory ring doorbell.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <unistd.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Ring a doorbell.
+ *
+ * \param doorbell  The eventfd doorbell to ring.
+ */
+void ipc_ring_doorbell(int doorbell)
+{
+    uint64_t one = 1U;
+
+    /* a doorbell that can't take another ring is already ringing. */
+    ssize_t written = write(doorbell, &one, sizeof(one));
+    (void)written;
+}
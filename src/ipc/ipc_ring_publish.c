@@ -0,0 +1,40 @@
+/**
+ * \file ipc/ipc_ring_publish.c
+ *
+ * \brief Publish data written to a shared-memory ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Publish data copied into the transmit half of a ring to the reader.
+ *
+ * If the ring was empty, the peer's doorbell is marked as pending, to be rung
+ * by \ref ipc_ring_write().
+ *
+ * \param ring      The ring to publish.
+ * \param size      The number of bytes to publish.
+ */
+void ipc_ring_publish(ipc_ring_t* ring, uint32_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != ring);
+
+    uint32_t head = atomic_load_explicit(&ring->tx->head, memory_order_relaxed);
+
+    /* make the data visible to the reader. */
+    atomic_store(&ring->tx->head, head + size);
+
+    /* The reader only sleeps on its doorbell once it has seen the ring empty.
+     * Both sides use sequentially consistent stores and loads here, so either
+     * we see its final tail or it sees our new head. */
+    if (atomic_load(&ring->tx->tail) == head)
+    {
+        ring->doorbell_pending = true;
+    }
+}
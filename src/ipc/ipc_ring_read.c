@@ -0,0 +1,145 @@
+/**
+ * \file ipc/ipc_ring_read.c
+ *
+ * \brief Read from a shared-memory ring into a socket's read buffer.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "ipc_internal.h"
+
+/* forward decls. */
+static ssize_t ipc_ring_consume(ipc_ring_t* ring, struct evbuffer* buf,
+    uint32_t limit);
+
+/**
+ * \brief Read up to howmuch bytes from a ring socket into its read buffer.
+ *
+ * The doorbell for this side is only cleared once the ring has been seen
+ * empty, so a read that leaves data in the ring will be called again by the
+ * event loop.
+ *
+ * \param sock      The ring socket to read.
+ * \param howmuch   The maximum number of bytes to read, or -1 for as many as
+ *                  are available.
+ *
+ * \returns the number of bytes read, 0 if the peer has closed the ring and no
+ * data remains, or -1 on error with errno set.  errno is EAGAIN if the ring is
+ * empty.
+ */
+ssize_t ipc_ring_read(ipc_socket_context_t* sock, int howmuch)
+{
+    ssize_t retval;
+    uint64_t count;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+    ipc_ring_t* ring = sock_impl->ring;
+    uint32_t limit = (howmuch < 0) ? UINT32_MAX : (uint32_t)howmuch;
+
+    /* read whatever is in the ring. */
+    retval = ipc_ring_consume(ring, sock_impl->readbuf, limit);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    /* the ring is empty, so clear our doorbell... */
+    retval = read(sock->fd, &count, sizeof(count));
+    (void)retval;
+
+    /* ...and check again, in case the writer published before the clear. */
+    bool closed = 0U != atomic_load(&ring->rx->writer_closed);
+    retval = ipc_ring_consume(ring, sock_impl->readbuf, limit);
+    if (0 != retval)
+    {
+        /* data may remain, so make sure we are called again. */
+        ipc_ring_doorbell(sock->fd);
+        return retval;
+    }
+
+    /* an empty ring whose writer has gone away is at EOF. */
+    if (closed)
+    {
+        return 0;
+    }
+
+    errno = EAGAIN;
+    return -1;
+}
+
+/**
+ * \brief Move up to limit bytes from the receive half of a ring into a buffer.
+ *
+ * \param ring      The ring to read.
+ * \param buf       The buffer to append to.
+ * \param limit     The maximum number of bytes to move.
+ *
+ * \returns the number of bytes moved, or -1 on error with errno set.
+ */
+static ssize_t ipc_ring_consume(ipc_ring_t* ring, struct evbuffer* buf,
+    uint32_t limit)
+{
+    uint32_t total = 0U;
+
+    while (total < limit)
+    {
+        uint32_t tail =
+            atomic_load_explicit(&ring->rx->tail, memory_order_relaxed);
+        uint32_t avail = atomic_load(&ring->rx->head) - tail;
+
+        /* a writer that claims more than the ring holds is not trusted. */
+        if (avail > ring->mask + 1U)
+        {
+            errno = EPROTO;
+            return -1;
+        }
+
+        if (0U == avail)
+        {
+            break;
+        }
+
+        if (avail > limit - total)
+        {
+            avail = limit - total;
+        }
+
+        /* copy up to the end of the ring, then wrap around. */
+        uint32_t start = tail & ring->mask;
+        uint32_t first = ring->mask + 1U - start;
+        if (first > avail)
+        {
+            first = avail;
+        }
+
+        if (0 != evbuffer_add(buf, ring->rx_data + start, first)
+         || (avail > first
+                && 0 != evbuffer_add(buf, ring->rx_data, avail - first)))
+        {
+            errno = ENOMEM;
+            return -1;
+        }
+
+        /* hand the space back to the writer. */
+        atomic_store(&ring->rx->tail, tail + avail);
+        total += avail;
+
+        /* wake the writer if it ran out of room. */
+        if (0U != atomic_exchange(&ring->rx->writer_waiting, 0U))
+        {
+            ipc_ring_doorbell(ring->peer_doorbell);
+        }
+    }
+
+    return (ssize_t)total;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file ipc/ipc_ring_release.c
+ *
+ * \brief Release the shared-memory ring for a socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Release the ring for a socket, telling the peer that it is closed.
+ *
+ * \param impl      The socket implementation that owns the ring.
+ */
+void ipc_ring_release(ipc_socket_impl_t* impl)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != impl);
+
+    ipc_ring_t* ring = impl->ring;
+    if (NULL == ring)
+    {
+        return;
+    }
+
+    /* let the peer see EOF on its reads and EPIPE on its writes. */
+    atomic_store(&ring->tx->writer_closed, 1U);
+    atomic_store(&ring->rx->reader_closed, 1U);
+    ipc_ring_doorbell(ring->peer_doorbell);
+
+    /* release our view of the ring. */
+    munmap(ring->shared, ring->map_size);
+    close(ring->peer_doorbell);
+    memset(ring, 0, sizeof(ipc_ring_t));
+    free(ring);
+    impl->ring = NULL;
+}
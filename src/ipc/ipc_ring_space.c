@@ -0,0 +1,37 @@
+/**
+ * \file ipc/ipc_ring_space.c
+ *
+ * \brief Compute the free space in a shared-memory ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Compute the number of bytes that can be written to a ring.
+ *
+ * \param ring      The ring to check.
+ *
+ * \returns the free space in the transmit half of this ring.
+ */
+uint32_t ipc_ring_space(ipc_ring_t* ring)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != ring);
+
+    uint32_t head = atomic_load_explicit(&ring->tx->head, memory_order_relaxed);
+    uint32_t tail = atomic_load(&ring->tx->tail);
+    uint32_t used = head - tail;
+
+    /* a tail that has run past the head leaves no room. */
+    if (used > ring->mask + 1U)
+    {
+        return 0U;
+    }
+
+    return ring->mask + 1U - used;
+}
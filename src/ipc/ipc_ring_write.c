@@ -0,0 +1,112 @@
+/**
+ * \file ipc/ipc_ring_write.c
+ *
+ * \brief Write a socket's write buffer into a shared-memory ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief The number of write buffer chunks copied per pass.
+ */
+#define IPC_RING_WRITE_VECS 8
+
+/**
+ * \brief Move the write buffer of a ring socket into the ring, and ring the
+ * peer's doorbell if it is pending.
+ *
+ * \param sock      The ring socket to write.
+ *
+ * \returns the number of bytes written, or -1 on error with errno set.  errno
+ * is EAGAIN if the ring is full and EPIPE if the peer has closed the ring.
+ */
+ssize_t ipc_ring_write(ipc_socket_context_t* sock)
+{
+    struct evbuffer_iovec vec[IPC_RING_WRITE_VECS];
+    size_t total = 0U;
+    size_t length;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+    ipc_ring_t* ring = sock_impl->ring;
+
+    /* don't write to a ring that nobody will read. */
+    if (0U != atomic_load(&ring->tx->reader_closed))
+    {
+        errno = EPIPE;
+        return -1;
+    }
+
+    while ((length = evbuffer_get_length(sock_impl->writebuf)) > 0U)
+    {
+        uint32_t space = ipc_ring_space(ring);
+        if (0U == space)
+        {
+            /* ask the reader to wake us, then check again in case it already
+             * made room. */
+            atomic_store(&ring->tx->writer_waiting, 1U);
+            space = ipc_ring_space(ring);
+            if (0U == space)
+            {
+                break;
+            }
+        }
+
+        if (length > space)
+        {
+            length = space;
+        }
+
+        /* copy the front of the write buffer into the ring. */
+        int nvec =
+            evbuffer_peek(
+                sock_impl->writebuf, length, NULL, vec, IPC_RING_WRITE_VECS);
+        if (nvec > IPC_RING_WRITE_VECS)
+        {
+            nvec = IPC_RING_WRITE_VECS;
+        }
+
+        uint32_t copied = 0U;
+        for (int i = 0; i < nvec && copied < length; ++i)
+        {
+            uint32_t size = (uint32_t)vec[i].iov_len;
+            if (size > length - copied)
+            {
+                size = (uint32_t)(length - copied);
+            }
+
+            ipc_ring_copy_in(ring, copied, vec[i].iov_base, size);
+            copied += size;
+        }
+
+        ipc_ring_publish(ring, copied);
+        evbuffer_drain(sock_impl->writebuf, copied);
+        total += copied;
+    }
+
+    /* one doorbell covers everything published since the reader slept. */
+    if (ring->doorbell_pending)
+    {
+        ring->doorbell_pending = false;
+        ipc_ring_doorbell(ring->peer_doorbell);
+    }
+
+    /* a full ring would block. */
+    if (0U == total && evbuffer_get_length(sock_impl->writebuf) > 0U)
+    {
+        errno = EAGAIN;
+        return -1;
+    }
+
+    return (ssize_t)total;
+}
@@ -0,0 +1,135 @@
+/**
+ * \file ipc/ipc_ringpair.c
+ *
+ * \brief Create a shared-memory ring pair for inter-process communication.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#define _GNU_SOURCE
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Create a shared-memory ring pair, as an alternative to a socket pair
+ * for non-blocking I/O between two services.
+ *
+ * The ring consists of a sealed memfd holding one single-producer,
+ * single-consumer ring per direction, and an eventfd doorbell for each side.
+ * On success, memfd is set to the shared memory descriptor, and lhs and rhs
+ * are set to the doorbells for the left-hand and right-hand sides.  Each side
+ * is opened with \ref ipc_make_ring_noblock().
+ *
+ * \param capacity      The capacity of each direction of the ring, in bytes.
+ *                      This must be a power of two no smaller than 4096 and
+ *                      no larger than 1 GB.
+ * \param memfd         Pointer to the integer variable updated to the shared
+ *                      memory descriptor.
+ * \param lhs           Pointer to the integer variable updated to the
+ *                      left-hand-side doorbell.
+ * \param rhs           Pointer to the integer variable updated to the
+ *                      right-hand-side doorbell.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if the capacity is invalid.
+ *      - AGENTD_ERROR_IPC_RING_CREATE_FAILURE if creating the shared memory
+ *        or the doorbells failed.
+ *      - AGENTD_ERROR_IPC_RING_MAP_FAILURE if mapping the shared memory
+ *        failed.
+ */
+int ipc_ringpair(uint32_t capacity, int* memfd, int* lhs, int* rhs)
+{
+    int retval;
+    int fd, lhs_doorbell;
+    ipc_ring_shared_t* shared;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != memfd);
+    MODEL_ASSERT(NULL != lhs);
+    MODEL_ASSERT(NULL != rhs);
+
+    /* the capacity must be a power of two within range. */
+    if (capacity < IPC_RING_MIN_CAPACITY || capacity > IPC_RING_MAX_CAPACITY
+     || 0U != (capacity & (capacity - 1U)))
+    {
+        retval = AGENTD_ERROR_IPC_INVALID_ARGUMENT;
+        goto done;
+    }
+
+    /* create the shared memory. */
+    fd = memfd_create("agentd-ipc-ring", MFD_ALLOW_SEALING);
+    if (fd < 0)
+    {
+        retval = AGENTD_ERROR_IPC_RING_CREATE_FAILURE;
+        goto done;
+    }
+
+    /* size it for the header and both directions. */
+    size_t map_size = sizeof(ipc_ring_shared_t) + 2U * (size_t)capacity;
+    if (0 != ftruncate(fd, (off_t)map_size))
+    {
+        retval = AGENTD_ERROR_IPC_RING_CREATE_FAILURE;
+        goto cleanup_memfd;
+    }
+
+    /* seal the size, so neither side can truncate the other's mapping. */
+    if (0 != fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL))
+    {
+        retval = AGENTD_ERROR_IPC_RING_CREATE_FAILURE;
+        goto cleanup_memfd;
+    }
+
+    /* write the header.  The rest of the memory is already zeroed. */
+    shared =
+        (ipc_ring_shared_t*)mmap(
+            NULL, sizeof(ipc_ring_shared_t), PROT_READ | PROT_WRITE,
+            MAP_SHARED, fd, 0);
+    if (MAP_FAILED == shared)
+    {
+        retval = AGENTD_ERROR_IPC_RING_MAP_FAILURE;
+        goto cleanup_memfd;
+    }
+
+    shared->magic = IPC_RING_MAGIC;
+    shared->capacity = capacity;
+    munmap(shared, sizeof(ipc_ring_shared_t));
+
+    /* create the doorbells. */
+    lhs_doorbell = eventfd(0, EFD_NONBLOCK);
+    if (lhs_doorbell < 0)
+    {
+        retval = AGENTD_ERROR_IPC_RING_CREATE_FAILURE;
+        goto cleanup_memfd;
+    }
+
+    *rhs = eventfd(0, EFD_NONBLOCK);
+    if (*rhs < 0)
+    {
+        retval = AGENTD_ERROR_IPC_RING_CREATE_FAILURE;
+        goto cleanup_lhs;
+    }
+
+    /* success. */
+    *memfd = fd;
+    *lhs = lhs_doorbell;
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+cleanup_lhs:
+    close(lhs_doorbell);
+
+cleanup_memfd:
+    close(fd);
+
+done:
+    return retval;
+}
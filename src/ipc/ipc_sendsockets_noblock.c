@@ -0,0 +1,103 @@
+/**
+ * \file ipc/ipc_sendsockets_noblock.c
+ *
+ * \brief Non-blocking write of a batch of socket descriptors to a local peer.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Send a batch of socket descriptors to the unix domain peer in a single
+ * message, without blocking.
+ *
+ * Up to IPC_SOCKET_BATCH_MAX descriptors from socks are sent.  On success,
+ * sent is set to the number of descriptors sent, which are the first sent
+ * entries of socks.  The caller maintains the local socket handles, and these
+ * should be closed by the caller once sent.
+ *
+ * \param ctx           The non-blocking unix domain socket through which the
+ *                      descriptors are sent.
+ * \param socks         The socket descriptors to send.
+ * \param count         The number of socket descriptors in socks.
+ * \param sent          Pointer to receive the number of descriptors sent.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if count is 0.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if this operation would block, in which
+ *        case nothing was sent.
+ *      - AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE if this operation failed.
+ */
+int ipc_sendsockets_noblock(
+    ipc_socket_context_t* ctx, const int* socks, size_t count, size_t* sent)
+{
+    struct msghdr m;
+    struct cmsghdr* cm;
+    struct iovec iov;
+    char buf[CMSG_SPACE(IPC_SOCKET_BATCH_MAX * sizeof(int))];
+    char dummy[2];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != ctx);
+    MODEL_ASSERT(NULL != socks);
+    MODEL_ASSERT(NULL != sent);
+
+    *sent = 0U;
+
+    /* there must be something to send. */
+    if (0U == count)
+    {
+        return AGENTD_ERROR_IPC_INVALID_ARGUMENT;
+    }
+
+    /* send no more than a single batch. */
+    if (count > IPC_SOCKET_BATCH_MAX)
+    {
+        count = IPC_SOCKET_BATCH_MAX;
+    }
+
+    /* build message header. */
+    memset(&m, 0, sizeof(m));
+    memset(buf, 0, sizeof(buf));
+    m.msg_controllen = CMSG_SPACE(count * sizeof(int));
+    m.msg_control = buf;
+
+    /* build socket control message header carrying every descriptor. */
+    cm = CMSG_FIRSTHDR(&m);
+    cm->cmsg_level = SOL_SOCKET;
+    cm->cmsg_type = SCM_RIGHTS;
+    cm->cmsg_len = CMSG_LEN(count * sizeof(int));
+    memcpy(CMSG_DATA(cm), socks, count * sizeof(int));
+    m.msg_iov = &iov;
+    m.msg_iovlen = 1;
+    iov.iov_base = dummy;
+    iov.iov_len = 1;
+    memset(dummy, 0, sizeof(dummy));
+
+    /* attempt to send this message to the peer. */
+    if (sendmsg(ctx->fd, &m, MSG_DONTWAIT | MSG_NOSIGNAL) < 0)
+    {
+        if (EWOULDBLOCK == errno || EAGAIN == errno)
+        {
+            return AGENTD_ERROR_IPC_WOULD_BLOCK;
+        }
+        else
+        {
+            return AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE;
+        }
+    }
+
+    /* success */
+    *sent = count;
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,36 @@
+/**
+ * \file ipc/ipc_set_cork_noblock.c
+ *
+ * \brief Set whether writes to a non-blocking socket are corked.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Set whether writes to a non-blocking socket are corked.
+ *
+ * When a socket is corked, ipc_write_data_noblock() and friends only append
+ * to the socket's write buffer.  The event loop then writes each corked socket
+ * with pending data once, at the end of the loop iteration, so several
+ * messages written by one handler go out in a single write.  Corking has no
+ * effect on a socket that has not been added to an event loop.
+ *
+ * \param sock          The socket to set.
+ * \param corked        true if writes should be corked, false otherwise.
+ */
+void ipc_set_cork_noblock(ipc_socket_context_t* sock, bool corked)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    sock_impl->corked = corked;
+}
@@ -0,0 +1,39 @@
+/**
+ * \file ipc/ipc_set_read_chunk_noblock.c
+ *
+ * \brief Set how much a non-blocking socket reads ahead.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <limits.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Set how much a non-blocking socket reads ahead.
+ *
+ * When a non-blocking read needs more data than is buffered, it reads up to
+ * this many bytes from the socket in one call, or the rest of the packet if
+ * that is larger.  Packets that arrive behind the one being read are then
+ * parsed from the read buffer without another system call.
+ *
+ * \param sock          The socket to set.
+ * \param chunk         The read-ahead size in bytes, which must be no more than
+ *                      INT_MAX, or 0 to use IPC_SOCKET_DEFAULT_READ_CHUNK.
+ */
+void ipc_set_read_chunk_noblock(ipc_socket_context_t* sock, size_t chunk)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+    MODEL_ASSERT(chunk <= INT_MAX);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    sock_impl->read_chunk =
+        (0 == chunk) ? IPC_SOCKET_DEFAULT_READ_CHUNK : chunk;
+}
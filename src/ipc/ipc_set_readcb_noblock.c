@@ -57,6 +57,7 @@ void ipc_set_readcb_noblock(
         /* if the callback was cleared, then we are done. */
         if (NULL == sock->read)
         {
+            sock_impl->read_resume = false;
             return;
         }
 
@@ -70,8 +71,8 @@ void ipc_set_readcb_noblock(
             return;
         }
 
-        /* add the event to the event base. */
-        if (0 != event_add(sock_impl->read_ev, NULL))
+        /* add the event to the event base, unless reads are paused. */
+        if (0 != ipc_socket_read_event_add(sock_impl))
         {
             /* TODO - bubble this error to the caller. */
             return;
@@ -0,0 +1,59 @@
+/**
+ * \file ipc/ipc_set_watermarks_noblock.c
+ *
+ * \brief Set the write buffer watermarks for a non-blocking socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Set the write buffer watermarks for a non-blocking socket.
+ *
+ * The callback is called once when the write buffer grows to at least high
+ * bytes, and once more when it then drains to at most low bytes, so a service
+ * can stop and restart the reads that feed this socket.  It is called from
+ * within the write or drain that crossed the watermark, and must not dispose
+ * this socket.  A high watermark of 0 disables the callback.
+ *
+ * \param sock          The socket to set.
+ * \param low           The low watermark, in bytes.
+ * \param high          The high watermark, in bytes.
+ * \param cb            The callback to call when a watermark is crossed.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if low is above high.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the write buffer callback could
+ *        not be added.
+ */
+int ipc_set_watermarks_noblock(
+    ipc_socket_context_t* sock, size_t low, size_t high,
+    ipc_socket_watermark_cb_t cb)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* the low watermark can't be above the high watermark. */
+    if (low > high)
+    {
+        return AGENTD_ERROR_IPC_INVALID_ARGUMENT;
+    }
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* set the watermarks. */
+    sock_impl->low_watermark = low;
+    sock_impl->high_watermark = high;
+    sock_impl->watermark_cb = cb;
+
+    /* watch the write buffer, if it exists yet. */
+    return ipc_socket_watermark_attach(sock);
+}
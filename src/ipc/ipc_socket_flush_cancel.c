@@ -0,0 +1,49 @@
+/**
+ * \file ipc/ipc_socket_flush_cancel.c
+ *
+ * \brief Remove a socket from its event loop's flush list.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Remove a socket from its event loop's list of sockets to flush.
+ *
+ * \param sock      The socket to remove.
+ */
+void ipc_socket_flush_cancel(ipc_socket_context_t* sock)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* nothing to do if this socket is not queued. */
+    if (!sock_impl->flush_pending || NULL == sock_impl->loop)
+    {
+        return;
+    }
+
+    /* unlink this socket from the flush list. */
+    ipc_socket_context_t** link = &sock_impl->loop->flush_head;
+    while (NULL != *link)
+    {
+        if (*link == sock)
+        {
+            *link = sock_impl->flush_next;
+            break;
+        }
+
+        link = &((ipc_socket_impl_t*)(*link)->impl)->flush_next;
+    }
+
+    sock_impl->flush_pending = false;
+    sock_impl->flush_next = NULL;
+}
@@ -0,0 +1,35 @@
+/**
+ * \file ipc/ipc_socket_pool_release.c
+ *
+ * \brief Release the decrypted payload buffer for a socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Release the decrypted payload buffer for a socket.
+ *
+ * \param impl      The socket implementation that owns the buffer.
+ */
+void ipc_socket_pool_release(ipc_socket_impl_t* impl)
+{
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != impl);
+
+    /* clear and free the buffer, if any. */
+    if (NULL != impl->pool)
+    {
+        memset(impl->pool, 0, impl->pool_used);
+        free(impl->pool);
+    }
+
+    impl->pool = NULL;
+    impl->pool_size = 0U;
+    impl->pool_used = 0U;
+}
@@ -0,0 +1,85 @@
+/**
+ * \file ipc/ipc_socket_read_ahead.c
+ *
+ * \brief Make sure that enough data is buffered for a non-blocking read.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <limits.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Make sure that at least needed bytes are in a socket's read buffer.
+ *
+ * If fewer bytes are buffered, this reads from the socket once, taking up to
+ * the socket's read chunk size or the rest of the needed bytes, whichever is
+ * larger, so that packets queued behind the current one are picked up by the
+ * same system call.
+ *
+ * \param sock      The socket to read.
+ * \param needed    The number of bytes that must be buffered.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS if at least needed bytes are buffered.
+ *      - AGENTD_ERROR_IPC_WOULD_BLOCK if fewer bytes are available.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE if reading from the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_EVBUFFER_EOF if the peer closed the socket.
+ */
+int ipc_socket_read_ahead(ipc_socket_context_t* sock, size_t needed)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+    MODEL_ASSERT(NULL != ((ipc_socket_impl_t*)sock->impl)->readbuf);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* if the data is already buffered, there is nothing to read. */
+    size_t buffered = evbuffer_get_length(sock_impl->readbuf);
+    if (buffered >= needed)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* read the rest of what is needed, or a full chunk if that is more. */
+    size_t howmuch = needed - buffered;
+    if (howmuch < sock_impl->read_chunk)
+    {
+        howmuch = sock_impl->read_chunk;
+    }
+
+    if (howmuch > INT_MAX)
+    {
+        howmuch = INT_MAX;
+    }
+
+    ssize_t retval = ipc_socket_read_upto(sock, (int)howmuch);
+    if (retval < 0 && (EAGAIN == errno || EWOULDBLOCK == errno))
+    {
+        return AGENTD_ERROR_IPC_WOULD_BLOCK;
+    }
+    else if (retval < 0)
+    {
+        return AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE;
+    }
+    else if (0 == retval)
+    {
+        return AGENTD_ERROR_IPC_EVBUFFER_EOF;
+    }
+
+    /* a short read means that the rest hasn't arrived yet. */
+    if (evbuffer_get_length(sock_impl->readbuf) < needed)
+    {
+        return AGENTD_ERROR_IPC_WOULD_BLOCK;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
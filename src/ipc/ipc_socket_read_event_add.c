@@ -0,0 +1,35 @@
+/**
+ * \file ipc/ipc_socket_read_event_add.c
+ *
+ * \brief Add a read event to the event loop, unless reads are paused.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Add a read event to the event loop, unless reads are paused.
+ *
+ * \param sock_impl The socket implementation that owns the read event.
+ *
+ * \returns 0 on success and non-zero on failure, as per event_add().
+ */
+int ipc_socket_read_event_add(ipc_socket_impl_t* sock_impl)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock_impl);
+    MODEL_ASSERT(NULL != sock_impl->read_ev);
+
+    /* a paused socket adds the event when it is resumed. */
+    if (sock_impl->read_paused)
+    {
+        sock_impl->read_resume = true;
+        return 0;
+    }
+
+    return event_add(sock_impl->read_ev, NULL);
+}
@@ -36,16 +36,6 @@ ssize_t ipc_socket_read_to_buffer(ipc_socket_context_t* sock)
     MODEL_ASSERT(NULL != sock->impl);
     MODEL_ASSERT(NULL != ((ipc_socket_impl_t*)sock->impl)->readbuf);
 
-    /* get the socket impl. */
-    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
-
-    /* we can't perform a write using an invalid buffer. */
-    if (NULL == sock_impl->readbuf)
-    {
-        errno = EFAULT;
-        return -1;
-    }
-
-    /* use libevent's read method. */
-    return evbuffer_read(sock_impl->readbuf, sock->fd, -1);
+    /* read as much as is available. */
+    return ipc_socket_read_upto(sock, -1);
 }
@@ -0,0 +1,96 @@
+/**
+ * \file ipc/ipc_socket_read_upto.c
+ *
+ * \brief Read a bounded amount of data to the read buffer from the socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <sys/uio.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Read up to howmuch bytes from a socket into its read buffer.
+ *
+ * \param sock      The socket to read.
+ * \param howmuch   The maximum number of bytes to read, or -1 for up to the
+ *                  socket's read chunk size.
+ *
+ * \returns the number of bytes read, 0 on EOF, or -1 on error with errno set.
+ */
+ssize_t ipc_socket_read_upto(ipc_socket_context_t* sock, int howmuch)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+    MODEL_ASSERT(NULL != ((ipc_socket_impl_t*)sock->impl)->readbuf);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* we can't perform a read using an invalid buffer. */
+    if (NULL == sock_impl->readbuf)
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    /* without a limit, read up to the socket's read chunk size. */
+    size_t limit = (howmuch < 0) ? sock_impl->read_chunk : (size_t)howmuch;
+
+    /* a ring socket reads from shared memory. */
+    if (NULL != sock_impl->ring)
+    {
+        return ipc_ring_read(sock, (int)limit);
+    }
+
+    /* reserve space and read into it directly, since evbuffer_read() caps
+     * each read at a few kilobytes. */
+    struct evbuffer_iovec vec[2];
+    int nvec = evbuffer_reserve_space(sock_impl->readbuf, limit, vec, 2);
+    if (nvec < 0)
+    {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    /* don't read past the limit, even if more space was reserved. */
+    struct iovec iov[2];
+    size_t remaining = limit;
+    for (int i = 0; i < nvec; ++i)
+    {
+        iov[i].iov_base = vec[i].iov_base;
+        iov[i].iov_len =
+            (vec[i].iov_len < remaining) ? vec[i].iov_len : remaining;
+        remaining -= iov[i].iov_len;
+    }
+
+    ssize_t retval = readv(sock->fd, iov, nvec);
+    if (retval <= 0)
+    {
+        return retval;
+    }
+
+    /* commit only the bytes that were read. */
+    size_t left = (size_t)retval;
+    int ncommit = 0;
+    while (ncommit < nvec && left > 0)
+    {
+        vec[ncommit].iov_len =
+            (iov[ncommit].iov_len < left) ? iov[ncommit].iov_len : left;
+        left -= vec[ncommit].iov_len;
+        ++ncommit;
+    }
+
+    if (0 != evbuffer_commit_space(sock_impl->readbuf, vec, ncommit))
+    {
+        errno = EFAULT;
+        return -1;
+    }
+
+    return retval;
+}
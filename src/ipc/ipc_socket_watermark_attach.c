@@ -0,0 +1,98 @@
+/**
+ * \file ipc/ipc_socket_watermark_attach.c
+ *
+ * \brief Watch the write buffer of a socket for watermark crossings.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/* forward decls. */
+static void ipc_socket_watermark_cb(
+    struct evbuffer* buf, const struct evbuffer_cb_info* info, void* arg);
+
+/**
+ * \brief Watch the write buffer of a socket for watermark crossings.
+ *
+ * This is a no-op if the socket has no write buffer yet, or no watermarks.
+ *
+ * \param sock      The socket to watch.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the write buffer callback could
+ *        not be added.
+ */
+int ipc_socket_watermark_attach(ipc_socket_context_t* sock)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* nothing to watch until the socket is in a loop. */
+    if (NULL == sock_impl->writebuf)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* drop any previous watch. */
+    if (NULL != sock_impl->watermark_entry)
+    {
+        evbuffer_remove_cb_entry(
+            sock_impl->writebuf, sock_impl->watermark_entry);
+        sock_impl->watermark_entry = NULL;
+    }
+
+    /* start over below the high watermark. */
+    sock_impl->above_watermark = false;
+
+    /* a high watermark of 0 means no watch. */
+    if (0U == sock_impl->high_watermark || NULL == sock_impl->watermark_cb)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    sock_impl->watermark_entry =
+        evbuffer_add_cb(sock_impl->writebuf, &ipc_socket_watermark_cb, sock);
+    if (NULL == sock_impl->watermark_entry)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Write buffer callback that reports watermark crossings.
+ *
+ * \param buf       The write buffer.
+ * \param info      The change to the write buffer.
+ * \param arg       The socket that owns the write buffer.
+ */
+static void ipc_socket_watermark_cb(
+    struct evbuffer* UNUSED(buf), const struct evbuffer_cb_info* info,
+    void* arg)
+{
+    ipc_socket_context_t* sock = (ipc_socket_context_t*)arg;
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+    size_t length = info->orig_size + info->n_added - info->n_deleted;
+
+    if (!sock_impl->above_watermark && length >= sock_impl->high_watermark)
+    {
+        sock_impl->above_watermark = true;
+        sock_impl->watermark_cb(sock, true, sock->user_context);
+    }
+    else if (sock_impl->above_watermark && length <= sock_impl->low_watermark)
+    {
+        sock_impl->above_watermark = false;
+        sock_impl->watermark_cb(sock, false, sock->user_context);
+    }
+}
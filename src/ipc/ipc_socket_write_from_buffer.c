@@ -47,6 +47,12 @@ ssize_t ipc_socket_write_from_buffer(ipc_socket_context_t* sock)
         return -1;
     }
 
+    /* a ring socket writes to shared memory. */
+    if (NULL != sock_impl->ring)
+    {
+        return ipc_ring_write(sock);
+    }
+
     /* use libevent's write method. */
     return evbuffer_write(sock_impl->writebuf, sock->fd);
 }
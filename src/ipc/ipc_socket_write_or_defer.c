@@ -0,0 +1,47 @@
+/**
+ * \file ipc/ipc_socket_write_or_defer.c
+ *
+ * \brief Write buffered data now, or defer it for a corked socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Write the buffered data for a socket now, or defer it to the end of
+ * the event loop iteration if the socket is corked.
+ *
+ * \param sock      The socket to write.
+ *
+ * \returns the number of bytes written, 0 if the write was deferred, or -1 on
+ * error, as per \ref ipc_socket_write_from_buffer().
+ */
+ssize_t ipc_socket_write_or_defer(ipc_socket_context_t* sock)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+
+    /* get the socket impl. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* an uncorked socket, or one not in a loop, is written right away. */
+    if (!sock_impl->corked || NULL == sock_impl->loop)
+    {
+        return ipc_socket_write_from_buffer(sock);
+    }
+
+    /* otherwise, queue it to be flushed at the end of this iteration. */
+    if (!sock_impl->flush_pending)
+    {
+        sock_impl->flush_pending = true;
+        sock_impl->flush_next = sock_impl->loop->flush_head;
+        sock_impl->loop->flush_head = sock;
+    }
+
+    return 0;
+}
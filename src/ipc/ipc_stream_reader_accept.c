@@ -0,0 +1,109 @@
+/**
+ * \file ipc/ipc_stream_reader_accept.c
+ *
+ * \brief Accept a decrypted stream frame into a stream reader.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Accept a decrypted stream frame into a stream reader.
+ *
+ * This checks the frame against the reader's state, and updates that state,
+ * just as \ref ipc_borrow_authed_stream_noblock() does.  It lets a caller that
+ * reads authenticated packets some other way, such as a blocking client, follow
+ * a stream.
+ *
+ * \param reader        The stream state.
+ * \param payload       The decrypted payload of the frame.
+ * \param payload_size  The size of the decrypted payload.
+ * \param frame         Pointer to receive the frame type.
+ * \param val           Pointer to receive the chunk pointer, which points into
+ *                      payload.  This is NULL for begin and end frames.
+ * \param size          Pointer to receive the chunk size.  This is 0 for begin
+ *                      and end frames.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if the frame was out of
+ *        order or the wrong size.
+ */
+int ipc_stream_reader_accept(
+    ipc_stream_reader_t* reader, const void* payload, uint32_t payload_size,
+    int* frame, const void** val, uint32_t* size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != reader);
+    MODEL_ASSERT(NULL != payload);
+    MODEL_ASSERT(NULL != frame);
+    MODEL_ASSERT(NULL != val);
+    MODEL_ASSERT(NULL != size);
+
+    *val = NULL;
+    *size = 0U;
+
+    /* every frame starts with its type. */
+    if (payload_size < 1U)
+    {
+        return AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION;
+    }
+
+    const uint8_t* bytes = (const uint8_t*)payload;
+    *frame = bytes[0];
+
+    switch (*frame)
+    {
+        case IPC_STREAM_FRAME_BEGIN:
+            /* a begin frame carries the total size, and can't interrupt
+             * another stream. */
+            if (reader->open
+             || sizeof(uint8_t) + sizeof(uint64_t) != payload_size)
+            {
+                return AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION;
+            }
+
+            uint64_t ntotal;
+            memcpy(&ntotal, bytes + 1, sizeof(ntotal));
+            reader->open = true;
+            reader->total_size = ntohll(ntotal);
+            reader->received = 0U;
+            break;
+
+        case IPC_STREAM_FRAME_CHUNK:
+            /* a chunk must be within an open stream and its total size. */
+            if (!reader->open || 1U == payload_size
+             || payload_size - 1U > IPC_STREAM_MAX_CHUNK_SIZE
+             || payload_size - 1U > reader->total_size - reader->received)
+            {
+                return AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION;
+            }
+
+            *val = bytes + 1;
+            *size = payload_size - 1U;
+            reader->received += *size;
+            break;
+
+        case IPC_STREAM_FRAME_END:
+            /* a stream only ends once its full payload has arrived. */
+            if (!reader->open || 1U != payload_size
+             || reader->received != reader->total_size)
+            {
+                return AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION;
+            }
+
+            reader->open = false;
+            break;
+
+        default:
+            return AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/**
+ * \file ipc/ipc_write_authed_datav_noblock.c
+ *
+ * \brief Non-blocking write of an authenticated data packet gathered from
+ * several fragments.
+ *
+ * \copyright 2019-2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Write an authenticated data packet, gathered from several fragments,
+ * to a non-blocking socket.
+ *
+ * Each fragment is encrypted directly into the socket's write buffer, so the
+ * caller does not need to assemble the fragments into a single buffer first.
+ * On the wire, this packet is identical to one written by
+ * \ref ipc_write_authed_data_noblock() with the concatenated fragments.
+ *
+ * \param sock          The socket context to which the value is written.
+ * \param iv            The 64-bit IV to use for this packet.
+ * \param iov           The fragments making up the payload of this packet.
+ * \param iovcnt        The number of fragments.
+ * \param suite         The crypto suite to use for authenticating this packet.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE if the packet is too
+ *        large to frame.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        payload data to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_datav_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, const struct iovec* iov,
+    size_t iovcnt, vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret)
+{
+    uint8_t type = IPC_DATA_TYPE_AUTHED_PACKET;
+    size_t size = 0U;
+    int retval = 0;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != iov || 0U == iovcnt);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+
+    /* get the socket details. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* compute the payload size. */
+    for (size_t i = 0; i < iovcnt; ++i)
+    {
+        size += iov[i].iov_len;
+        if (size > UINT32_MAX)
+        {
+            retval = AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE;
+            goto done;
+        }
+    }
+
+    uint32_t nsize = htonl((uint32_t)size);
+
+    /* get the keyed crypto state for this socket. */
+    ipc_authed_channel_t* chan = NULL;
+    retval = ipc_authed_channel_get(sock_impl, suite, secret, &chan);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* reserve contiguous space for the whole packet in the write buffer. */
+    size_t mac_size = chan->write_digest.size;
+    size_t header_size = sizeof(type) + sizeof(nsize);
+    size_t packet_size = header_size + mac_size + size;
+    struct evbuffer_iovec space;
+    if (1 != evbuffer_reserve_space(sock_impl->writebuf, packet_size, &space, 1))
+    {
+        retval = AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE;
+        goto done;
+    }
+
+    /* create a mac instance for building the packet authentication code. */
+    vccrypt_mac_context_t mac;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_mac_short_init(suite, &mac, secret))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto done;
+    }
+
+    /* start the stream cipher. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_stream_continue_encryption(
+            &chan->write_stream, &iv, sizeof(iv), 0))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* treat the reserved space as a byte array for convenience. */
+    uint8_t* bpacket = (uint8_t*)space.iov_base;
+    size_t offset = 0;
+
+    /* encrypt the type. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_stream_encrypt(
+            &chan->write_stream, &type, sizeof(type), bpacket, &offset))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* encrypt the size. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_stream_encrypt(
+            &chan->write_stream, &nsize, sizeof(nsize), bpacket, &offset))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* encrypt each fragment of the payload, after the digest. */
+    for (size_t i = 0; i < iovcnt; ++i)
+    {
+        if (iov[i].iov_len > 0U
+         && VCCRYPT_STATUS_SUCCESS !=
+                vccrypt_stream_encrypt(
+                    &chan->write_stream, iov[i].iov_base, iov[i].iov_len,
+                    bpacket + mac_size, &offset))
+        {
+            retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+            goto cleanup_mac;
+        }
+    }
+
+    /* digest the packet header and payload. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_mac_digest(&mac, bpacket, header_size) ||
+        VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_mac_digest(
+                &mac, bpacket + header_size + mac_size, size))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* finalize the digest. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_mac_finalize(&mac, &chan->write_digest))
+    {
+        retval = AGENTD_ERROR_IPC_CRYPTO_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* copy the digest to the packet. */
+    memcpy(bpacket + header_size, chan->write_digest.data, mac_size);
+
+    /* commit the packet to the write buffer. */
+    space.iov_len = packet_size;
+    if (0 != evbuffer_commit_space(sock_impl->writebuf, &space, 1))
+    {
+        retval = AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+done:
+    return retval;
+}
@@ -0,0 +1,62 @@
+/**
+ * \file ipc/ipc_write_authed_stream_begin_noblock.c
+ *
+ * \brief Begin a streamed authenticated message on a non-blocking socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Begin a streamed authenticated message on a non-blocking socket.
+ *
+ * A stream lets a payload larger than a single authenticated packet be sent
+ * and consumed a piece at a time.  It is a begin frame, any number of chunk
+ * frames, and an end frame, each sent as its own authenticated packet with
+ * its own IV.  The chunk payloads must add up to total_size.
+ *
+ * \param sock          The socket context to which the frame is written.
+ * \param iv            The 64-bit IV to use for this frame.
+ * \param total_size    The total size of the payload that will follow.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        frame to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_stream_begin_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, uint64_t total_size,
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret)
+{
+    uint8_t header[sizeof(uint8_t) + sizeof(uint64_t)];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+
+    /* the begin frame is its type followed by the total size. */
+    uint64_t ntotal = htonll(total_size);
+    header[0] = IPC_STREAM_FRAME_BEGIN;
+    memcpy(header + 1, &ntotal, sizeof(ntotal));
+
+    struct iovec iov;
+    iov.iov_base = header;
+    iov.iov_len = sizeof(header);
+
+    return ipc_write_authed_datav_noblock(sock, iv, &iov, 1, suite, secret);
+}
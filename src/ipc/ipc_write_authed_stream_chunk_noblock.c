@@ -0,0 +1,66 @@
+/**
+ * \file ipc/ipc_write_authed_stream_chunk_noblock.c
+ *
+ * \brief Write the next chunk of a streamed authenticated message.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <sys/uio.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief Write the next chunk of a streamed authenticated message to a
+ * non-blocking socket.
+ *
+ * The chunk is framed and encrypted directly from val into the write buffer.
+ *
+ * \param sock          The socket context to which the frame is written.
+ * \param iv            The 64-bit IV to use for this frame.
+ * \param val           The payload of this chunk.
+ * \param size          The size of this chunk, between 1 and
+ *                      IPC_STREAM_MAX_CHUNK_SIZE bytes.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_INVALID_ARGUMENT if the chunk size is out of range.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        frame to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_stream_chunk_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, const void* val, uint32_t size,
+    vccrypt_suite_options_t* suite, vccrypt_buffer_t* secret)
+{
+    uint8_t header = IPC_STREAM_FRAME_CHUNK;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != val);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+
+    /* a chunk must fit in a single authenticated packet. */
+    if (0U == size || size > IPC_STREAM_MAX_CHUNK_SIZE)
+    {
+        return AGENTD_ERROR_IPC_INVALID_ARGUMENT;
+    }
+
+    /* the chunk frame is its type followed by the payload. */
+    struct iovec iov[2];
+    iov[0].iov_base = &header;
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = (void*)val;
+    iov[1].iov_len = size;
+
+    return ipc_write_authed_datav_noblock(sock, iv, iov, 2, suite, secret);
+}
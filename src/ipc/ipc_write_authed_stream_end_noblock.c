@@ -0,0 +1,50 @@
+/**
+ * \file ipc/ipc_write_authed_stream_end_noblock.c
+ *
+ * \brief End a streamed authenticated message on a non-blocking socket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <sys/uio.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/**
+ * \brief End a streamed authenticated message on a non-blocking socket.
+ *
+ * \param sock          The socket context to which the frame is written.
+ * \param iv            The 64-bit IV to use for this frame.
+ * \param suite         The crypto suite to use for authenticating this frame.
+ * \param secret        The shared secret between the peer and host.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error condition while executing.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        frame to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_CRYPTO_FAILURE if a crypto operation failed.
+ */
+int ipc_write_authed_stream_end_noblock(
+    ipc_socket_context_t* sock, uint64_t iv, vccrypt_suite_options_t* suite,
+    vccrypt_buffer_t* secret)
+{
+    uint8_t header = IPC_STREAM_FRAME_END;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != secret);
+
+    /* the end frame is just its type. */
+    struct iovec iov;
+    iov.iov_base = &header;
+    iov.iov_len = sizeof(header);
+
+    return ipc_write_authed_datav_noblock(sock, iv, &iov, 1, suite, secret);
+}
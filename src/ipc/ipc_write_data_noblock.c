@@ -29,10 +29,6 @@
  *
  * \returns A status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_IPC_WRITE_BUFFER_TYPE_ADD_FAILURE if adding the type
- *        data to the write buffer failed.
- *      - AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE if adding the size
- *        data to the write buffer failed.
  *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
  *        payload data to the write buffer failed.
  *      - AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE if a non-blocking write
@@ -43,40 +39,12 @@ int ipc_write_data_noblock(
 {
     /* parameter sanity checks. */
     MODEL_ASSERT(NULL != sock);
-    MODEL_ASSERT(NULL != sock->impl);
-    MODEL_ASSERT(NULL != ((ipc_socket_impl_t*)sock->impl)->writebuf);
     MODEL_ASSERT(NULL != val);
 
-    /* get the socket details. */
-    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+    /* write the value as a single fragment. */
+    struct iovec iov;
+    iov.iov_base = (void*)val;
+    iov.iov_len = size;
 
-    /* attempt to write the type. */
-    uint8_t type = IPC_DATA_TYPE_DATA_PACKET;
-    if (0 != evbuffer_add(sock_impl->writebuf, &type, sizeof(type)))
-    {
-        return AGENTD_ERROR_IPC_WRITE_BUFFER_TYPE_ADD_FAILURE;
-    }
-
-    /* attempt to write the size. */
-    uint32_t nsize = htonl(size);
-    if (0 != evbuffer_add(sock_impl->writebuf, &nsize, sizeof(nsize)))
-    {
-        return AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE;
-    }
-
-    /* add the data to the buffer. */
-    if (0 != evbuffer_add(sock_impl->writebuf, val, size))
-    {
-        return AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE;
-    }
-
-    /* attempt to write the data. */
-    int retval = ipc_socket_write_from_buffer(sock);
-    if (retval < 0)
-    {
-        return AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE;
-    }
-
-    /* success. */
-    return AGENTD_STATUS_SUCCESS;
+    return ipc_write_datav_noblock(sock, &iov, 1);
 }
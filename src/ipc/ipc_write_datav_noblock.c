@@ -0,0 +1,196 @@
+/**
+ * \file ipc/ipc_write_datav_noblock.c
+ *
+ * \brief Non-blocking write of a data packet gathered from several fragments.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <arpa/inet.h>
+#include <cbmc/model_assert.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <vpr/parameters.h>
+
+#include "ipc_internal.h"
+
+/* forward decls. */
+static int ipc_write_datav_to_buffer(
+    struct evbuffer* buf, uint8_t type, uint32_t nsize, size_t packet_size,
+    const struct iovec* iov, size_t iovcnt);
+static void ipc_write_datav_to_ring(
+    ipc_ring_t* ring, uint8_t type, uint32_t nsize, const struct iovec* iov,
+    size_t iovcnt);
+
+/**
+ * \brief Write a raw data packet, gathered from several fragments, to a
+ * non-blocking socket.
+ *
+ * The packet is framed directly in the socket's write buffer, or in the ring
+ * of a ring socket with room for it, so the caller does not need to assemble
+ * the fragments into a single buffer first.  On the
+ * wire, this packet is identical to one written by
+ * \ref ipc_write_data_noblock() with the concatenated fragments.
+ *
+ * \param sock          The socket context to which the value is written.
+ * \param iov           The fragments making up the payload of this packet.
+ * \param iovcnt        The number of fragments.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE if the packet is too
+ *        large to frame.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        payload data to the write buffer failed.
+ *      - AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE if a non-blocking write
+ *        failed.
+ */
+int ipc_write_datav_noblock(
+    ipc_socket_context_t* sock, const struct iovec* iov, size_t iovcnt)
+{
+    int retval;
+    uint8_t type = IPC_DATA_TYPE_DATA_PACKET;
+    size_t size = 0U;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != sock);
+    MODEL_ASSERT(NULL != sock->impl);
+    MODEL_ASSERT(NULL != ((ipc_socket_impl_t*)sock->impl)->writebuf);
+    MODEL_ASSERT(NULL != iov || 0U == iovcnt);
+
+    /* get the socket details. */
+    ipc_socket_impl_t* sock_impl = (ipc_socket_impl_t*)sock->impl;
+
+    /* compute the payload size. */
+    for (size_t i = 0; i < iovcnt; ++i)
+    {
+        size += iov[i].iov_len;
+        if (size > UINT32_MAX)
+        {
+            return AGENTD_ERROR_IPC_WRITE_BUFFER_SIZE_ADD_FAILURE;
+        }
+    }
+
+    /* a ring with nothing queued ahead of this packet takes it directly;
+     * otherwise, frame it in the write buffer. */
+    uint32_t nsize = htonl((uint32_t)size);
+    size_t packet_size = sizeof(type) + sizeof(nsize) + size;
+    if (NULL != sock_impl->ring
+     && 0U == evbuffer_get_length(sock_impl->writebuf)
+     && ipc_ring_space(sock_impl->ring) >= packet_size)
+    {
+        ipc_write_datav_to_ring(sock_impl->ring, type, nsize, iov, iovcnt);
+    }
+    else
+    {
+        retval =
+            ipc_write_datav_to_buffer(
+                sock_impl->writebuf, type, nsize, packet_size, iov, iovcnt);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* attempt to write the data, unless the socket is corked.  Data that
+     * would block stays buffered for the write callback. */
+    if (ipc_socket_write_or_defer(sock) < 0
+     && EAGAIN != errno && EWOULDBLOCK != errno)
+    {
+        return AGENTD_ERROR_IPC_WRITE_NONBLOCK_FAILURE;
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Frame a packet in a socket's write buffer.
+ *
+ * \param buf           The write buffer.
+ * \param type          The packet type.
+ * \param nsize         The payload size, in network byte order.
+ * \param packet_size   The size of the framed packet.
+ * \param iov           The fragments making up the payload of this packet.
+ * \param iovcnt        The number of fragments.
+ *
+ * \returns A status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE if adding the
+ *        payload data to the write buffer failed.
+ */
+static int ipc_write_datav_to_buffer(
+    struct evbuffer* buf, uint8_t type, uint32_t nsize, size_t packet_size,
+    const struct iovec* iov, size_t iovcnt)
+{
+    /* reserve contiguous space for the whole packet. */
+    struct evbuffer_iovec space;
+    if (1 != evbuffer_reserve_space(buf, packet_size, &space, 1))
+    {
+        return AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE;
+    }
+
+    /* write the type and size. */
+    uint8_t* out = (uint8_t*)space.iov_base;
+    memcpy(out, &type, sizeof(type));
+    out += sizeof(type);
+    memcpy(out, &nsize, sizeof(nsize));
+    out += sizeof(nsize);
+
+    /* gather the fragments. */
+    for (size_t i = 0; i < iovcnt; ++i)
+    {
+        if (iov[i].iov_len > 0U)
+        {
+            memcpy(out, iov[i].iov_base, iov[i].iov_len);
+            out += iov[i].iov_len;
+        }
+    }
+
+    /* commit the packet to the write buffer. */
+    space.iov_len = packet_size;
+    if (0 != evbuffer_commit_space(buf, &space, 1))
+    {
+        return AGENTD_ERROR_IPC_WRITE_BUFFER_PAYLOAD_ADD_FAILURE;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Frame a packet directly in the transmit half of a ring.
+ *
+ * The caller must have checked that the ring has room for the packet.
+ *
+ * \param ring          The ring.
+ * \param type          The packet type.
+ * \param nsize         The payload size, in network byte order.
+ * \param iov           The fragments making up the payload of this packet.
+ * \param iovcnt        The number of fragments.
+ */
+static void ipc_write_datav_to_ring(
+    ipc_ring_t* ring, uint8_t type, uint32_t nsize, const struct iovec* iov,
+    size_t iovcnt)
+{
+    uint32_t offset = 0U;
+
+    /* write the type and size. */
+    ipc_ring_copy_in(ring, offset, &type, sizeof(type));
+    offset += sizeof(type);
+    ipc_ring_copy_in(ring, offset, &nsize, sizeof(nsize));
+    offset += sizeof(nsize);
+
+    /* gather the fragments. */
+    for (size_t i = 0; i < iovcnt; ++i)
+    {
+        ipc_ring_copy_in(ring, offset, iov[i].iov_base, iov[i].iov_len);
+        offset += iov[i].iov_len;
+    }
+
+    /* hand the packet to the reader. */
+    ipc_ring_publish(ring, offset);
+}
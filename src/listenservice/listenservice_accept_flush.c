@@ -0,0 +1,84 @@
+/**
+ * \file listenservice/listenservice_accept_flush.c
+ *
+ * \brief Send queued accepted sockets to the protocol service.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "listenservice_internal.h"
+
+/**
+ * \brief Send queued accepted sockets to the protocol service, in batches.
+ *
+ * Sent sockets are closed locally.  If the accept socket would block, the
+ * rest stay queued and are sent once it becomes writable.  The listen sockets
+ * are paused while the queue is full, and resumed once it has room again.
+ *
+ * \param instance      The listenservice instance.
+ */
+void listenservice_accept_flush(listenservice_instance_t* instance)
+{
+    int retval;
+    size_t sent;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != instance);
+
+    while (instance->accepted_count > 0U)
+    {
+        /* send as many sockets as fit in one message. */
+        retval =
+            ipc_sendsockets_noblock(
+                &instance->acceptsock, instance->accepted,
+                instance->accepted_count, &sent);
+        if (AGENTD_ERROR_IPC_WOULD_BLOCK == retval)
+        {
+            /* try again once the protocol service catches up. */
+            ipc_set_writecb_noblock(
+                &instance->acceptsock, &listenservice_ipc_accept_write,
+                instance->loop_context);
+            break;
+        }
+        else if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            listenservice_exit_event_loop(instance);
+            return;
+        }
+
+        /* the protocol service has its own copies of the sent sockets. */
+        for (size_t i = 0; i < sent; ++i)
+        {
+            close(instance->accepted[i]);
+        }
+
+        instance->accepted_count -= sent;
+        memmove(
+            instance->accepted, instance->accepted + sent,
+            instance->accepted_count * sizeof(int));
+    }
+
+    /* stop accepting while the queue is full, and resume once it has room. */
+    bool full = instance->accepted_count >= LISTENSERVICE_ACCEPT_QUEUE_MAX;
+    if (full != instance->listen_paused)
+    {
+        for (int i = 0; i < instance->listensocket_count; ++i)
+        {
+            if (full)
+            {
+                ipc_pause_read_noblock(instance->listensockets + i);
+            }
+            else
+            {
+                ipc_resume_read_noblock(instance->listensockets + i);
+            }
+        }
+
+        instance->listen_paused = full;
+    }
+}
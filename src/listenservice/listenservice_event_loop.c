@@ -10,6 +10,7 @@
 #include <agentd/status_codes.h>
 #include <cbmc/model_assert.h>
 #include <signal.h>
+#include <unistd.h>
 #include <vpr/parameters.h>
 
 #include "listenservice_internal.h"
@@ -73,7 +74,25 @@ int listenservice_event_loop(
     memset(&instance, 0, sizeof(instance));
     /* set a reference to the event loop in the instance. */
     instance.loop_context = &loop;
-    instance.acceptsock = acceptsock;
+    instance.listensockets = listensockets;
+    instance.listensocket_count = listensocket_count;
+
+    /* set the accept socket to non-blocking, so a busy protocol service
+     * doesn't stall the listener. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_make_noblock(acceptsock, &instance.acceptsock, &instance))
+    {
+        retval = AGENTD_ERROR_LISTENSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
+        goto cleanup_loop;
+    }
+
+    /* add the accept socket to the event loop. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_event_loop_add(&loop, &instance.acceptsock))
+    {
+        retval = AGENTD_ERROR_LISTENSERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
+        goto cleanup_acceptsock;
+    }
 
     /* on these signals, leave the event loop and shut down gracefully. */
     ipc_exit_loop_on_signal(&loop, SIGHUP);
@@ -88,7 +107,7 @@ int listenservice_event_loop(
             ipc_make_noblock(listenstart + i, listensockets + i, &instance))
         {
             retval = AGENTD_ERROR_DATASERVICE_IPC_MAKE_NOBLOCK_FAILURE;
-            goto cleanup_loop;
+            goto cleanup_acceptsock;
         }
 
         /* set the read, write, and error callbacks for the data socket. */
@@ -100,7 +119,7 @@ int listenservice_event_loop(
             ipc_event_loop_add(&loop, listensockets + i))
         {
             retval = AGENTD_ERROR_LISTENSERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
-            goto cleanup_loop;
+            goto cleanup_acceptsock;
         }
     }
 
@@ -121,6 +140,16 @@ cleanup_listensockets:
         dispose((disposable_t*)listensockets + i);
     }
 
+cleanup_acceptsock:
+    /* close any sockets that the protocol service never took. */
+    for (size_t i = 0; i < instance.accepted_count; ++i)
+    {
+        close(instance.accepted[i]);
+    }
+
+    ipc_event_loop_remove(&loop, &instance.acceptsock);
+    dispose((disposable_t*)&instance.acceptsock);
+
 cleanup_loop:
     dispose((disposable_t*)&loop);
 
@@ -18,6 +18,13 @@
 extern "C" {
 #endif  //__cplusplus
 
+/**
+ * \brief The most accepted sockets that the listen service holds while waiting
+ * for the protocol service to take them.  Once this many are queued, the
+ * listen sockets are paused until the queue drains.
+ */
+#define LISTENSERVICE_ACCEPT_QUEUE_MAX 1024U
+
 /**
  * \brief Instance type for listen service.
  */
@@ -25,7 +32,12 @@ typedef struct listenservice_instance
 {
     ipc_event_loop_context_t* loop_context;
     bool listenservice_force_exit;
-    int acceptsock;
+    ipc_socket_context_t acceptsock;
+    ipc_socket_context_t* listensockets;
+    int listensocket_count;
+    bool listen_paused;
+    int accepted[LISTENSERVICE_ACCEPT_QUEUE_MAX];
+    size_t accepted_count;
 } listenservice_instance_t;
 
 /**
@@ -48,6 +60,28 @@ int listenservice_count_sockets(int listenstart);
 void listenservice_ipc_accept(
     ipc_socket_context_t* ctx, int event_flags, void* user_context);
 
+/**
+ * \brief Write callback on the accept socket, called once the protocol service
+ * can take more sockets.
+ *
+ * \param ctx           The accept socket context.
+ * \param event_flags   The event that triggered this callback.
+ * \param user_context  The listenservice instance.
+ */
+void listenservice_ipc_accept_write(
+    ipc_socket_context_t* ctx, int event_flags, void* user_context);
+
+/**
+ * \brief Send queued accepted sockets to the protocol service, in batches.
+ *
+ * Sent sockets are closed locally.  If the accept socket would block, the
+ * rest stay queued and are sent once it becomes writable.  The listen sockets
+ * are paused while the queue is full, and resumed once it has room again.
+ *
+ * \param instance      The listenservice instance.
+ */
+void listenservice_accept_flush(listenservice_instance_t* instance);
+
 /**
  * \brief Set up a clean re-entry from the event loop and ensure that no other
  * callbacks occur by setting the appropriate force exit flag.
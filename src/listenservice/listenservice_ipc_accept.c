@@ -16,7 +16,8 @@
  * \brief Read callback on listen sockets to accept a new socket.
  *
  * This callback is registered as part of the ipc callback mechanism for a
- * listen socket.  It forwards a socket to the accept socket in the \ref
+ * listen socket.  It accepts every pending connection on the listen socket,
+ * and forwards them in batches to the accept socket in the \ref
  * listenservice_instance_t context structure.
  */
 void listenservice_ipc_accept(
@@ -25,7 +26,7 @@ void listenservice_ipc_accept(
     ssize_t retval = 0;
     int sock = 0;
     struct sockaddr_in peer;
-    socklen_t peersize = sizeof(peer);
+    socklen_t peersize;
     listenservice_instance_t* instance =
         (listenservice_instance_t*)user_context;
 
@@ -38,28 +39,31 @@ void listenservice_ipc_accept(
     if (instance->listenservice_force_exit)
         return;
 
-    /* attempt to accept a socket. */
-    retval =
-        ipc_accept_noblock(ctx, &sock, (struct sockaddr*)&peer, &peersize);
-    if (AGENTD_ERROR_IPC_WOULD_BLOCK == retval || AGENTD_ERROR_IPC_ACCEPT_SHOULD_RETRY == retval)
+    /* accept connections until none are left, or the queue is full. */
+    while (instance->accepted_count < LISTENSERVICE_ACCEPT_QUEUE_MAX)
     {
-        return;
-    }
-    else if (AGENTD_STATUS_SUCCESS != retval)
-    {
-        listenservice_exit_event_loop(instance);
-        return;
-    }
+        peersize = sizeof(peer);
+        retval =
+            ipc_accept_noblock(
+                ctx, &sock, (struct sockaddr*)&peer, &peersize);
+        if (AGENTD_ERROR_IPC_WOULD_BLOCK == retval)
+        {
+            break;
+        }
+        else if (AGENTD_ERROR_IPC_ACCEPT_SHOULD_RETRY == retval)
+        {
+            continue;
+        }
+        else if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            listenservice_exit_event_loop(instance);
+            return;
+        }
 
-    /* attempt to send this socket to the protocol service. */
-    retval =
-        ipc_sendsocket_block(instance->acceptsock, sock);
-    if (AGENTD_STATUS_SUCCESS != retval)
-    {
-        listenservice_exit_event_loop(instance);
-        goto cleanup_socket;
+        /* queue this socket for the protocol service. */
+        instance->accepted[instance->accepted_count++] = sock;
     }
 
-cleanup_socket:
-    close(sock);
+    /* attempt to send the queued sockets to the protocol service. */
+    listenservice_accept_flush(instance);
 }
@@ -0,0 +1,38 @@
+/**
+ * \file listenservice/listenservice_ipc_accept_write.c
+ *
+ * \brief Send queued sockets once the accept socket is writable.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "listenservice_internal.h"
+
+/**
+ * \brief Write callback on the accept socket, called once the protocol service
+ * can take more sockets.
+ *
+ * \param ctx           The accept socket context.
+ * \param event_flags   The event that triggered this callback.
+ * \param user_context  The listenservice instance.
+ */
+void listenservice_ipc_accept_write(
+    ipc_socket_context_t* UNUSED(ctx), int UNUSED(event_flags),
+    void* user_context)
+{
+    listenservice_instance_t* instance =
+        (listenservice_instance_t*)user_context;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(event_flags & IPC_SOCKET_EVENT_WRITE);
+    MODEL_ASSERT(NULL != instance);
+
+    /* don't hand off any more sockets if we are quiescing. */
+    if (instance->listenservice_force_exit)
+        return;
+
+    listenservice_accept_flush(instance);
+}
@@ -0,0 +1,131 @@
+/**
+ * \file protocolservice/protocolservice_api_recvresp_artifact_notification.c
+ *
+ * \brief Read an artifact notification.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Receive an artifact notification.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset of the first watch request.
+ * \param artifact_id               Array to receive the 16 byte id of the
+ *                                  updated artifact.
+ * \param txn_latest                Array to receive the 16 byte id of the
+ *                                  latest transaction for this artifact.
+ * \param height_latest             Pointer to receive the block height of the
+ *                                  latest transaction.
+ * \param state_latest              Pointer to receive the latest state of the
+ *                                  artifact.
+ *
+ * Artifact notifications are pushed by the server to a watching connection
+ * between responses, so a client should expect one whenever it reads.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_artifact_notification(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset,
+    uint8_t* artifact_id, uint8_t* txn_latest, uint64_t* height_latest,
+    uint32_t* state_latest)
+{
+    int retval;
+    uint32_t* val;
+    uint32_t size;
+    uint64_t net_height;
+    uint32_t net_state;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != server_iv);
+    MODEL_ASSERT(NULL != shared_secret);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != artifact_id);
+    MODEL_ASSERT(NULL != txn_latest);
+    MODEL_ASSERT(NULL != height_latest);
+    MODEL_ASSERT(NULL != state_latest);
+
+    /* read the response from the server. */
+    /* TODO - fix constness in ipc method for shared secret. */
+    retval =
+        ipc_read_authed_data_block(
+            sock, *server_iv, (void**)&val, &size, suite,
+            (vccrypt_buffer_t*)shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* update the server_iv on successful read. */
+    *server_iv += 1;
+
+    /* verify that the notification is large enough for the header. */
+    if (size < 3 * sizeof(uint32_t))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+        goto cleanup_val;
+    }
+
+    /* verify the notification id. */
+    if (UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_NOTIFICATION != ntohl(val[0]))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE;
+        goto cleanup_val;
+    }
+
+    /* verify that the notification holds the artifact record. */
+    if (AGENTD_STATUS_SUCCESS != ntohl(val[1])
+     || size !=
+            3 * sizeof(uint32_t) + 16 + 16 + sizeof(net_height)
+                + sizeof(net_state))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
+        goto cleanup_val;
+    }
+
+    /* set the offset. */
+    *offset = ntohl(val[2]);
+
+    /* copy the artifact id, latest transaction id, height, and state. */
+    const uint8_t* bval = (const uint8_t*)(val + 3);
+    memcpy(artifact_id, bval, 16);
+    memcpy(txn_latest, bval + 16, 16);
+    memcpy(&net_height, bval + 32, sizeof(net_height));
+    memcpy(&net_state, bval + 32 + sizeof(net_height), sizeof(net_state));
+    *height_latest = ntohll(net_height);
+    *state_latest = ntohl(net_state);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_val:
+    memset(val, 0, size);
+    free(val);
+
+done:
+    return retval;
+}
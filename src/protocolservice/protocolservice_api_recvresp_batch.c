@@ -0,0 +1,137 @@
+/**
+ * \file protocolservice/protocolservice_api_recvresp_batch.c
+ *
+ * \brief Receive a batch response.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+/**
+ * \brief Receive a batch response.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset for this response.
+ * \param status                    The status for this response.
+ * \param responses                 Pointer to be populated with the
+ *                                  sub-responses on success.  This buffer is
+ *                                  dynamically allocated and must be freed by
+ *                                  the caller.
+ * \param responses_size            The size of the sub-responses returned.
+ *
+ * The sub-responses are returned as a sequence of packets, each prefixed by
+ * its size as a 32-bit network order value.  Each packet is laid out just as
+ * the response to the same request sent on its own would be, starting with its
+ * request ID, status, and offset.  Sub-responses may be in a different order
+ * than the sub-requests.
+ *
+ * If the status code is updated with an error from the service, then this error
+ * will be reflected in the status variable, and a AGENTD_STATUS_SUCCESS will be
+ * returned by this function.  Thus, both the return value of this function and
+ * the upstream status code must be checked for correct operation.
+ *
+ * Possible upstream status codes:
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_BATCH if the batch was
+ *        malformed, too large, or nested.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_batch(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    uint8_t** responses, size_t* responses_size)
+{
+    int retval;
+    uint32_t* val;
+    uint32_t size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != server_iv);
+    MODEL_ASSERT(NULL != shared_secret);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != status);
+    MODEL_ASSERT(NULL != responses);
+    MODEL_ASSERT(NULL != responses_size);
+
+    /* read the response from the server. */
+    /* TODO - fix constness in ipc method for shared secret. */
+    retval =
+        ipc_read_authed_data_block(
+            sock, *server_iv, (void**)&val, &size, suite,
+            (vccrypt_buffer_t*)shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* update the server_iv on successful read. */
+    *server_iv += 1;
+
+    /* verify that the response is the correct size. */
+    uint32_t dsize = size;
+    if (dsize < 3 * sizeof(uint32_t))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+        goto cleanup_val;
+    }
+
+    /* verify the request id. */
+    if (UNAUTH_PROTOCOL_REQ_ID_BATCH != ntohl(val[0]))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE;
+        goto cleanup_val;
+    }
+
+    /* set the status and offset. */
+    *status = ntohl(val[1]);
+    *offset = ntohl(val[2]);
+    /* decrement size. */
+    dsize -= 3 * sizeof(uint32_t);
+
+    /* was the status successful? */
+    if (AGENTD_STATUS_SUCCESS != *status)
+    {
+        retval = AGENTD_STATUS_SUCCESS;
+        goto cleanup_val;
+    }
+
+    /* allocate space for the sub-responses. */
+    *responses_size = dsize;
+    *responses = (uint8_t*)malloc(dsize > 0 ? dsize : 1);
+    if (NULL == *responses)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_val;
+    }
+
+    /* copy the sub-responses. */
+    memcpy(*responses, val + 3, dsize);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto cleanup_val;
+
+cleanup_val:
+    memset(val, 0, size);
+    free(val);
+
+done:
+    return retval;
+}
@@ -10,6 +10,18 @@
 #include <agentd/protocolservice/api.h>
 #include <agentd/status_codes.h>
 #include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief The largest block response that is accepted as a stream.
+ */
+#define PROTOCOLSERVICE_API_BLOCK_STREAM_MAX (1024U * 1024U * 1024U)
+
+/* forward decls. */
+static int protocolservice_api_recvresp_block_get_stream(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, ipc_stream_reader_t* reader,
+    uint32_t** val, uint32_t* size);
 
 /**
  * \brief Receive a block get response.
@@ -42,8 +54,13 @@
  * returned by this function.  Thus, both the return value of this function and
  * the upstream status code must be checked for correct operation.
  *
+ * A block too large for a single packet arrives as a stream, which is gathered
+ * here, so the caller sees the same result either way.
+ *
  * Possible upstream status codes:
  *      - AGENTD_ERROR_DATASERVICE_NOT_FOUND if the block could not be found.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_RESPONSE_TOO_LARGE_FOR_BATCH if the
+ *        block was requested in a batch and is too large to be streamed.
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
@@ -51,6 +68,8 @@
  *        failed.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
  *        the socket was unexpected.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if a streamed response
+ *        was malformed.
  *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
  *        out-of-memory error.
  */
@@ -88,6 +107,29 @@ int protocolservice_api_recvresp_block_get(
     /* update the server_iv on successful read. */
     *server_iv += 1;
 
+    /* a large block arrives as a stream, starting with a begin frame. */
+    ipc_stream_reader_t reader;
+    int frame;
+    const void* chunk;
+    uint32_t chunk_size;
+    memset(&reader, 0, sizeof(reader));
+    if (AGENTD_STATUS_SUCCESS ==
+            ipc_stream_reader_accept(
+                &reader, val, size, &frame, &chunk, &chunk_size)
+     && IPC_STREAM_FRAME_BEGIN == frame)
+    {
+        memset(val, 0, size);
+        free(val);
+
+        retval =
+            protocolservice_api_recvresp_block_get_stream(
+                sock, suite, server_iv, shared_secret, &reader, &val, &size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto done;
+        }
+    }
+
     /* verify that the response is the correct size. */
     if (size < 3 * sizeof(uint32_t))
     {
@@ -157,3 +199,102 @@ cleanup_val:
 done:
     return retval;
 }
+
+/**
+ * \brief Gather a streamed block get response.
+ *
+ * \param sock          The socket from which the stream is read.
+ * \param suite         The crypto suite to use to verify each frame.
+ * \param server_iv     Pointer to the server IV, updated for each frame.
+ * \param shared_secret The shared secret key for this response.
+ * \param reader        The stream state, after the begin frame.
+ * \param val           Pointer to receive the gathered response, which must be
+ *                      freed by the caller on success.
+ * \param size          Pointer to receive the size of the gathered response.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the stream is too small
+ *        or too large to be a block get response.
+ *      - AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION if a frame was out of
+ *        order or the wrong size.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - any of the errors returned by \ref ipc_read_authed_data_block().
+ */
+static int protocolservice_api_recvresp_block_get_stream(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, ipc_stream_reader_t* reader,
+    uint32_t** val, uint32_t* size)
+{
+    int retval;
+    int frame;
+    const void* chunk;
+    uint32_t chunk_size;
+    void* frame_val;
+    uint32_t frame_size;
+
+    /* the stream must hold a response header, and can't be unbounded. */
+    if (reader->total_size < 3 * sizeof(uint32_t)
+     || reader->total_size > PROTOCOLSERVICE_API_BLOCK_STREAM_MAX)
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+        goto done;
+    }
+
+    /* gather the response here. */
+    uint8_t* buffer = (uint8_t*)malloc(reader->total_size);
+    if (NULL == buffer)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    do
+    {
+        /* read the next frame. */
+        /* TODO - fix constness in ipc method for shared secret. */
+        retval =
+            ipc_read_authed_data_block(
+                sock, *server_iv, &frame_val, &frame_size, suite,
+                (vccrypt_buffer_t*)shared_secret);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_buffer;
+        }
+
+        *server_iv += 1;
+
+        /* copy each chunk to its place in the response. */
+        retval =
+            ipc_stream_reader_accept(
+                reader, frame_val, frame_size, &frame, &chunk, &chunk_size);
+        if (AGENTD_STATUS_SUCCESS == retval
+         && IPC_STREAM_FRAME_CHUNK == frame)
+        {
+            memcpy(
+                buffer + reader->received - chunk_size, chunk, chunk_size);
+        }
+
+        memset(frame_val, 0, frame_size);
+        free(frame_val);
+
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_buffer;
+        }
+    } while (IPC_STREAM_FRAME_END != frame);
+
+    /* success. */
+    *val = (uint32_t*)buffer;
+    *size = (uint32_t)reader->total_size;
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+cleanup_buffer:
+    memset(buffer, 0, reader->total_size);
+    free(buffer);
+
+done:
+    return retval;
+}
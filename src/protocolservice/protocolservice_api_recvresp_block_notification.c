@@ -0,0 +1,119 @@
+/**
+ * \file protocolservice/protocolservice_api_recvresp_block_notification.c
+ *
+ * \brief Read a block notification.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Receive a block notification.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset of the subscribe request.
+ * \param block_id                  Array to receive the 16 byte id of the
+ *                                  newly committed latest block.
+ * \param height                    Pointer to receive the height of this block.
+ *
+ * Block notifications are pushed by the server to a subscribed connection
+ * between responses, so a client should expect one whenever it reads.  If
+ * several blocks were committed since the last notification, only the latest
+ * is reported.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_block_notification(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint8_t* block_id,
+    uint64_t* height)
+{
+    int retval;
+    uint32_t* val;
+    uint32_t size;
+    uint64_t net_height;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != server_iv);
+    MODEL_ASSERT(NULL != shared_secret);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != block_id);
+    MODEL_ASSERT(NULL != height);
+
+    /* read the response from the server. */
+    /* TODO - fix constness in ipc method for shared secret. */
+    retval =
+        ipc_read_authed_data_block(
+            sock, *server_iv, (void**)&val, &size, suite,
+            (vccrypt_buffer_t*)shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* update the server_iv on successful read. */
+    *server_iv += 1;
+
+    /* verify that the notification is large enough for the header. */
+    if (size < 3 * sizeof(uint32_t))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+        goto cleanup_val;
+    }
+
+    /* verify the notification id. */
+    if (UNAUTH_PROTOCOL_REQ_ID_BLOCK_NOTIFICATION != ntohl(val[0]))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE;
+        goto cleanup_val;
+    }
+
+    /* verify that the notification holds a block id and height. */
+    if (AGENTD_STATUS_SUCCESS != ntohl(val[1])
+     || size != 3 * sizeof(uint32_t) + 16 + sizeof(net_height))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
+        goto cleanup_val;
+    }
+
+    /* set the offset. */
+    *offset = ntohl(val[2]);
+
+    /* copy the block id and height. */
+    const uint8_t* bval = (const uint8_t*)(val + 3);
+    memcpy(block_id, bval, 16);
+    memcpy(&net_height, bval + 16, sizeof(net_height));
+    *height = ntohll(net_height);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_val:
+    memset(val, 0, size);
+    free(val);
+
+done:
+    return retval;
+}
@@ -0,0 +1,169 @@
+/**
+ * \file protocolservice/protocolservice_api_recvresp_handshake_resume_block.c
+ *
+ * \brief Read a handshake resume response from the peer.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+#include <vccrypt/compare.h>
+
+/**
+ * \brief Receive a handshake resume response from the API.
+ *
+ * \param sock              The socket from which this response is read.
+ * \param suite             The crypto suite to use to verify this response.
+ * \param key_nonce         The client key nonce sent with the request.
+ * \param shared_secret     The shared secret for the resumed session.
+ * \param offset            The offset for this response.
+ * \param status            The status for this response.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  If the
+ * ticket was not accepted, the client should fall back to a full handshake on a
+ * new connection.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed or could not be verified.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_handshake_resume_block(
+    int sock, vccrypt_suite_options_t* suite,
+    const vccrypt_buffer_t* key_nonce, const vccrypt_buffer_t* shared_secret,
+    uint32_t* offset, uint32_t* status)
+{
+    int retval = 0;
+    uint32_t* val = NULL;
+    uint32_t size = 0U;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(sock >= 0);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != key_nonce);
+    MODEL_ASSERT(NULL != shared_secret);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != status);
+
+    /* | Handshake resume response packet.                                  | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME             |   4 bytes    | */
+    /* | status                                              |   4 bytes    | */
+    /* | offset                                              |   4 bytes    | */
+    /* | server_hmac                                         |  32 bytes    | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    /* read a data packet from the socket. */
+    retval = ipc_read_data_block(sock, (void**)&val, &size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* Verify that the size is at least large enough to get the status and
+     * offset. */
+    const size_t header_size = 3 * sizeof(uint32_t);
+    if (size < header_size)
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
+        goto cleanup_val;
+    }
+
+    /* verify the request id. */
+    if (UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME != ntohl(val[0]))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE;
+        goto cleanup_val;
+    }
+
+    /* assign status and offset. */
+    *status = ntohl(val[1]);
+    *offset = ntohl(val[2]);
+
+    /* if the status indicates failure, then stop. */
+    if (AGENTD_STATUS_SUCCESS != *status)
+    {
+        retval = AGENTD_STATUS_SUCCESS;
+        goto cleanup_val;
+    }
+
+    /* verify the payload size. */
+    const size_t mac_size = suite->mac_short_opts.mac_size;
+    if (size != header_size + mac_size)
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
+        goto cleanup_val;
+    }
+
+    /* the server hmac covers the header and the client key nonce. */
+    vccrypt_buffer_t digest;
+    retval =
+        vccrypt_buffer_init(
+            &digest, suite->alloc_opts, header_size + key_nonce->size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_val;
+    }
+
+    memcpy(digest.data, val, header_size);
+    memcpy(
+        (uint8_t*)digest.data + header_size, key_nonce->data, key_nonce->size);
+
+    /* create buffer for holding mac output. */
+    vccrypt_buffer_t mac_buffer;
+    retval = vccrypt_buffer_init(&mac_buffer, suite->alloc_opts, mac_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_digest;
+    }
+
+    /* compute the expected hmac. */
+    retval =
+        protocolservice_session_key_derive(
+            suite, shared_secret, digest.data, digest.size, &mac_buffer);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac_buffer;
+    }
+
+    /* verify that the hmac matches. */
+    if (0 !=
+        crypto_memcmp(
+            mac_buffer.data, (const uint8_t*)val + header_size, mac_size))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
+        goto cleanup_mac_buffer;
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_mac_buffer:
+    dispose((disposable_t*)&mac_buffer);
+
+cleanup_digest:
+    dispose((disposable_t*)&digest);
+
+cleanup_val:
+    memset(val, 0, size);
+    free(val);
+
+done:
+    return retval;
+}
@@ -0,0 +1,150 @@
+/**
+ * \file protocolservice/protocolservice_api_recvresp_session_ticket_get.c
+ *
+ * \brief Read a session ticket get response.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+/**
+ * \brief Receive a session ticket get response.
+ *
+ * \param sock                      The socket from which this response is read.
+ * \param suite                     The crypto suite to use to verify this
+ *                                  response.
+ * \param server_iv                 Pointer to the server IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this response.
+ * \param offset                    The offset for this response.
+ * \param status                    The status for this response.
+ * \param ticket                    Array to receive the
+ *                                  PROTOCOLSERVICE_SESSION_TICKET_SIZE byte
+ *                                  ticket.
+ * \param session_key               Buffer to receive the session key for this
+ *                                  ticket, which is derived from the shared
+ *                                  secret and the ticket id.  This buffer must
+ *                                  not have been previously initialized.  On
+ *                                  success, this is owned by the caller and
+ *                                  must be disposed.
+ *
+ * On a successful return from this function, the status is updated with the
+ * status code from the API request.  This status should be checked.  A zero
+ * status indicates the request to the remote peer was successful, and a
+ * non-zero status indicates that the request to the remote peer failed.  The
+ * ticket and session key are only set when the status is zero.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_READ_BLOCK_FAILURE if a blocking read on the socket
+ *        failed.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
+ *        the socket was unexpected.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE if the response was
+ *        malformed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ */
+int protocolservice_api_recvresp_session_ticket_get(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    uint8_t* ticket, vccrypt_buffer_t* session_key)
+{
+    int retval;
+    uint32_t* val;
+    uint32_t size;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != server_iv);
+    MODEL_ASSERT(NULL != shared_secret);
+    MODEL_ASSERT(NULL != offset);
+    MODEL_ASSERT(NULL != status);
+    MODEL_ASSERT(NULL != ticket);
+    MODEL_ASSERT(NULL != session_key);
+
+    /* read the response from the server. */
+    /* TODO - fix constness in ipc method for shared secret. */
+    retval =
+        ipc_read_authed_data_block(
+            sock, *server_iv, (void**)&val, &size, suite,
+            (vccrypt_buffer_t*)shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* update the server_iv on successful read. */
+    *server_iv += 1;
+
+    /* verify that the response is large enough for the header. */
+    if (size < 3 * sizeof(uint32_t))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+        goto cleanup_val;
+    }
+
+    /* verify the request id. */
+    if (UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET != ntohl(val[0]))
+    {
+        retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE;
+        goto cleanup_val;
+    }
+
+    /* set the status and offset. */
+    *status = ntohl(val[1]);
+    *offset = ntohl(val[2]);
+
+    /* was the status successful? */
+    if (AGENTD_STATUS_SUCCESS != *status)
+    {
+        retval = AGENTD_STATUS_SUCCESS;
+        goto cleanup_val;
+    }
+
+    /* verify that the response holds exactly one ticket. */
+    if (size != 3 * sizeof(uint32_t) + PROTOCOLSERVICE_SESSION_TICKET_SIZE)
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
+        goto cleanup_val;
+    }
+
+    /* create the session key buffer. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+            suite, session_key))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_val;
+    }
+
+    /* the session key is derived from the shared secret and the ticket id,
+     * just as the server derived it. */
+    const uint8_t* bval = (const uint8_t*)(val + 3);
+    retval =
+        protocolservice_session_key_derive(
+            suite, shared_secret, bval, PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE,
+            session_key);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)session_key);
+        goto cleanup_val;
+    }
+
+    /* copy the ticket. */
+    memcpy(ticket, bval, PROTOCOLSERVICE_SESSION_TICKET_SIZE);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_val:
+    memset(val, 0, size);
+    free(val);
+
+done:
+    return retval;
+}
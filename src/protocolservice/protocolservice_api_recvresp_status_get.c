@@ -6,10 +6,12 @@
  * \copyright 2020 Velo Payments, Inc.  All rights reserved.
  */
 
+#include <agentd/inet.h>
 #include <agentd/ipc.h>
 #include <agentd/protocolservice/api.h>
 #include <agentd/status_codes.h>
 #include <cbmc/model_assert.h>
+#include <string.h>
 
 /**
  * \brief Receive a status get response.
@@ -22,6 +24,9 @@
  * \param shared_secret             The shared secret key for this response.
  * \param offset                    The offset for this response.
  * \param status                    The status for this response.
+ * \param stats                     If not NULL, this is populated with the
+ *                                  service counters from a successful
+ *                                  response.
  *
  * On a successful return from this function, the status is updated with the
  * status code from the API request.  This status should be checked.  A zero
@@ -39,12 +44,15 @@
  *        failed.
  *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_TYPE if the data type read from
  *        the socket was unexpected.
+ *      - AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE if the response is too
+ *        small to hold the requested counters.
  *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
  *        out-of-memory error.
  */
 int protocolservice_api_recvresp_status_get(
     int sock, vccrypt_suite_options_t* suite, uint64_t* server_iv,
-    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status)
+    const vccrypt_buffer_t* shared_secret, uint32_t* offset, uint32_t* status,
+    protocolservice_api_status_t* stats)
 {
     int retval;
     uint32_t* val;
@@ -89,6 +97,28 @@ int protocolservice_api_recvresp_status_get(
     *status = ntohl(val[1]);
     *offset = ntohl(val[2]);
 
+    /* a successful response carries the service counters. */
+    if (NULL != stats && AGENTD_STATUS_SUCCESS == *status)
+    {
+        uint64_t net_counters[7];
+        if (size < 3 * sizeof(uint32_t) + sizeof(net_counters))
+        {
+            retval = AGENTD_ERROR_IPC_READ_UNEXPECTED_DATA_SIZE;
+            goto cleanup_val;
+        }
+
+        memcpy(
+            net_counters, (const uint8_t*)val + 3 * sizeof(uint32_t),
+            sizeof(net_counters));
+        stats->response_cache_hits = ntohll(net_counters[0]);
+        stats->response_cache_misses = ntohll(net_counters[1]);
+        stats->schedule_queue_depth = ntohll(net_counters[2]);
+        stats->dataservice_inflight = ntohll(net_counters[3]);
+        stats->schedule_dispatched = ntohll(net_counters[4]);
+        stats->schedule_wait_total_usec = ntohll(net_counters[5]);
+        stats->schedule_wait_max_usec = ntohll(net_counters[6]);
+    }
+
     /* success. */
     retval = AGENTD_STATUS_SUCCESS;
     goto cleanup_val;
@@ -0,0 +1,123 @@
+/**
+ * \file protocolservice/protocolservice_api_sendreq_batch.c
+ *
+ * \brief Send a batch request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include <agentd/protocolservice/api.h>
+
+/**
+ * \brief Send a batch request.
+ *
+ * \param sock                      The socket to which this request is written.
+ * \param suite                     The crypto suite to use for this handshake.
+ * \param client_iv                 Pointer to the client IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this request.
+ * \param offset                    The offset for this batch request.
+ * \param requests                  The sub-requests to send in this batch.
+ * \param count                     The number of sub-requests.
+ *
+ * This function sends every sub-request to the server in a single packet.  The
+ * server answers with a single batch response, which is read with \ref
+ * protocolservice_api_recvresp_batch().
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_batch(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* client_iv,
+    const vccrypt_buffer_t* shared_secret, uint32_t offset,
+    const protocolservice_api_batch_request_t* requests, size_t count)
+{
+    int retval;
+
+    /* parameter sanity checking. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != client_iv);
+    MODEL_ASSERT(NULL != shared_secret);
+    MODEL_ASSERT(NULL != requests || 0 == count);
+
+    /* each sub-request has a size, request id, and offset, then its body. */
+    size_t req_size = 2*sizeof(uint32_t);
+    for (size_t i = 0; i < count; ++i)
+    {
+        req_size += 3*sizeof(uint32_t) + requests[i].body_size;
+    }
+
+    /* create a buffer for holding the request. */
+    vccrypt_buffer_t req;
+    if (VCCRYPT_STATUS_SUCCESS !=
+            vccrypt_buffer_init(
+                &req, suite->alloc_opts, req_size))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* populate the request header. */
+    uint8_t* breq = (uint8_t*)req.data;
+    uint32_t net_method_id = htonl(UNAUTH_PROTOCOL_REQ_ID_BATCH);
+    uint32_t net_request_id = htonl(offset);
+    memcpy(breq, &net_method_id, sizeof(net_method_id));
+    memcpy(breq + sizeof(uint32_t), &net_request_id, sizeof(net_request_id));
+    breq += 2*sizeof(uint32_t);
+
+    /* populate each sub-request. */
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t net_sub_size =
+            htonl(2*sizeof(uint32_t) + requests[i].body_size);
+        uint32_t net_sub_method_id = htonl(requests[i].request_id);
+        uint32_t net_sub_request_id = htonl(requests[i].offset);
+        memcpy(breq, &net_sub_size, sizeof(net_sub_size));
+        memcpy(
+            breq + sizeof(uint32_t), &net_sub_method_id,
+            sizeof(net_sub_method_id));
+        memcpy(
+            breq + 2*sizeof(uint32_t), &net_sub_request_id,
+            sizeof(net_sub_request_id));
+        breq += 3*sizeof(uint32_t);
+
+        if (requests[i].body_size > 0)
+        {
+            memcpy(breq, requests[i].body, requests[i].body_size);
+            breq += requests[i].body_size;
+        }
+    }
+
+    /* write IPC authed request packet to the server. */
+    /* TODO - shared secret parameter in ipc should be const. */
+    retval =
+        ipc_write_authed_data_block(
+            sock, *client_iv, req.data, req.size, suite,
+            (vccrypt_buffer_t*)shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_req;
+    }
+
+    /* increment client iv. */
+    *client_iv += 1;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto cleanup_req;
+
+cleanup_req:
+    dispose((disposable_t*)&req);
+
+done:
+    return retval;
+}
@@ -0,0 +1,69 @@
+/**
+ * \file protocolservice/protocolservice_api_sendreq_block_notify_subscribe.c
+ *
+ * \brief Subscribe to block notifications.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+/**
+ * \brief Send a block notification subscribe request.
+ *
+ * \param sock                      The socket to which this request is written.
+ * \param suite                     The crypto suite to use for this request.
+ * \param client_iv                 Pointer to the client IV, updated by this
+ *                                  call.
+ * \param shared_secret             The shared secret key for this request.
+ *
+ * This function asks the server to push a notification to this connection
+ * each time a block is committed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_block_notify_subscribe(
+    int sock, vccrypt_suite_options_t* suite, uint64_t* client_iv,
+    const vccrypt_buffer_t* shared_secret)
+{
+    int retval;
+
+    /* parameter sanity checking. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != client_iv);
+    MODEL_ASSERT(NULL != shared_secret);
+
+    /* build the request. */
+    uint32_t req[2] = {
+        htonl(UNAUTH_PROTOCOL_REQ_ID_BLOCK_NOTIFY_SUBSCRIBE),
+        htonl(0UL) };
+
+    /* write IPC authed request packet to the server. */
+    /* TODO - shared secret parameter in ipc should be const. */
+    retval =
+        ipc_write_authed_data_block(
+            sock, *client_iv, req, sizeof(req), suite,
+            (vccrypt_buffer_t*)shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* increment client iv. */
+    *client_iv += 1;
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+done:
+    return retval;
+}
@@ -0,0 +1,194 @@
+/**
+ * \file protocolservice/protocolservice_api_sendreq_handshake_resume_block.c
+ *
+ * \brief Write a handshake resume request to the peer.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <arpa/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Send a handshake resume request to the API.
+ *
+ * \param sock              The socket to which this request is written.
+ * \param suite             The crypto suite to use for this request.
+ * \param entity_id         The entity UUID originating this request.
+ * \param ticket            The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte
+ *                          ticket to redeem.
+ * \param session_key       The session key that goes with this ticket.
+ * \param key_nonce         Buffer to receive the client key nonce for this
+ *                          request.  This buffer must not have been previously
+ *                          initialized.  On success, this is owned by the
+ *                          caller and must be disposed.
+ * \param shared_secret     Buffer to receive the shared secret for the
+ *                          resumed session.  This buffer must not have been
+ *                          previously initialized.  On success, this is owned
+ *                          by the caller and must be disposed.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_IPC_WRITE_BLOCK_FAILURE if a blocking write on the socket
+ *        failed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if this operation encountered an
+ *        out-of-memory error.
+ *      - a non-zero error response if something else has failed.
+ */
+int protocolservice_api_sendreq_handshake_resume_block(
+    int sock, vccrypt_suite_options_t* suite, const uint8_t* entity_id,
+    const uint8_t* ticket, const vccrypt_buffer_t* session_key,
+    vccrypt_buffer_t* key_nonce, vccrypt_buffer_t* shared_secret)
+{
+    int retval = 0;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(sock >= 0);
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != entity_id);
+    MODEL_ASSERT(NULL != ticket);
+    MODEL_ASSERT(NULL != session_key);
+    MODEL_ASSERT(NULL != key_nonce);
+    MODEL_ASSERT(NULL != shared_secret);
+
+    /* | Handshake resume request packet.                                   | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME             |   4 bytes    | */
+    /* | offset                                              |   4 bytes    | */
+    /* | record:                                             | 176 bytes    | */
+    /* |    protocol_version                                 |   4 bytes    | */
+    /* |    crypto_suite                                     |   4 bytes    | */
+    /* |    entity_id                                        |  16 bytes    | */
+    /* |    ticket                                           |  88 bytes    | */
+    /* |    client key nonce                                 |  32 bytes    | */
+    /* |    client_hmac                                      |  32 bytes    | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    /* create prng. */
+    vccrypt_prng_context_t prng;
+    retval = vccrypt_suite_prng_init(suite, &prng);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    /* initialize key nonce buffer. */
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_nonce(
+            suite, key_nonce);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_prng;
+    }
+
+    /* read key nonce from prng. */
+    retval = vccrypt_prng_read(&prng, key_nonce, key_nonce->size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key_nonce;
+    }
+
+    /* initialize the shared secret buffer. */
+    retval =
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+            suite, shared_secret);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_key_nonce;
+    }
+
+    /* derive the shared secret for the resumed session. */
+    retval =
+        protocolservice_session_key_derive(
+            suite, session_key, key_nonce->data, key_nonce->size,
+            shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_shared_secret;
+    }
+
+    /* compute the payload size. */
+    uint32_t request = htonl(UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME);
+    uint32_t offset = htonl(0);
+    uint32_t protocol_version = htonl(0x01);
+    uint32_t crypto_suite = htonl(VCCRYPT_SUITE_VELO_V1);
+    size_t signed_size =
+        sizeof(request) + sizeof(offset) + sizeof(protocol_version)
+      + sizeof(crypto_suite) + 16 /* entity_id */
+      + PROTOCOLSERVICE_SESSION_TICKET_SIZE + key_nonce->size;
+    size_t payload_size = signed_size + suite->mac_short_opts.mac_size;
+
+    /* create handshake resume payload buffer. */
+    vccrypt_buffer_t payload;
+    retval = vccrypt_buffer_init(&payload, suite->alloc_opts, payload_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_shared_secret;
+    }
+
+    /* write the request values to the payload buffer. */
+    uint8_t* pbuf = (uint8_t*)payload.data;
+    memcpy(pbuf, &request, sizeof(request));
+    pbuf += sizeof(request);
+    memcpy(pbuf, &offset, sizeof(offset));
+    pbuf += sizeof(offset);
+    memcpy(pbuf, &protocol_version, sizeof(protocol_version));
+    pbuf += sizeof(protocol_version);
+    memcpy(pbuf, &crypto_suite, sizeof(crypto_suite));
+    pbuf += sizeof(crypto_suite);
+    memcpy(pbuf, entity_id, 16);
+    pbuf += 16;
+    memcpy(pbuf, ticket, PROTOCOLSERVICE_SESSION_TICKET_SIZE);
+    pbuf += PROTOCOLSERVICE_SESSION_TICKET_SIZE;
+    memcpy(pbuf, key_nonce->data, key_nonce->size);
+    pbuf += key_nonce->size;
+
+    /* sign the request with the derived shared secret. */
+    vccrypt_buffer_t mac_buffer = payload;
+    mac_buffer.data = pbuf;
+    mac_buffer.size = suite->mac_short_opts.mac_size;
+    retval =
+        protocolservice_session_key_derive(
+            suite, shared_secret, payload.data, signed_size, &mac_buffer);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_payload;
+    }
+
+    /* write data packet with request payload to socket. */
+    retval = ipc_write_data_block(sock, payload.data, payload.size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_payload;
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_payload:
+    dispose((disposable_t*)&payload);
+
+cleanup_shared_secret:
+    if (retval != AGENTD_STATUS_SUCCESS)
+    {
+        dispose((disposable_t*)shared_secret);
+    }
+
+cleanup_key_nonce:
+    if (retval != AGENTD_STATUS_SUCCESS)
+    {
+        dispose((disposable_t*)key_nonce);
+    }
+
+cleanup_prng:
+    dispose((disposable_t*)&prng);
+
+done:
+    return retval;
+}
@@ -0,0 +1,99 @@
+/**
+ * \file protocolservice/protocolservice_session_key_derive.c
+ *
+ * \brief Derive a key from a parent key and some context data.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/protocolservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+/**
+ * \brief Derive a key from a parent key and some context data.
+ *
+ * The derived key is the short MAC of the data, keyed with the parent key,
+ * truncated to the size of the derived key buffer.
+ *
+ * \param suite             The crypto suite to use for this derivation.
+ * \param key               The parent key.
+ * \param data              The context data for this derivation.
+ * \param size              The size of the context data.
+ * \param derived           The initialized buffer to receive the derived key.
+ *                          It can be no larger than the short MAC size.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the key could
+ *        not be derived.
+ */
+int protocolservice_session_key_derive(
+    vccrypt_suite_options_t* suite, const vccrypt_buffer_t* key,
+    const void* data, size_t size, vccrypt_buffer_t* derived)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != suite);
+    MODEL_ASSERT(NULL != key);
+    MODEL_ASSERT(NULL != data);
+    MODEL_ASSERT(NULL != derived);
+
+    /* the derived key can't be larger than the mac. */
+    if (derived->size > suite->mac_short_opts.mac_size)
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE;
+        goto done;
+    }
+
+    /* create the mac, keyed with the parent key. */
+    vccrypt_mac_context_t mac;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_mac_short_init(suite, &mac, (vccrypt_buffer_t*)key))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE;
+        goto done;
+    }
+
+    /* create a buffer for the mac output. */
+    vccrypt_buffer_t mac_buffer;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &mac_buffer, suite->alloc_opts, suite->mac_short_opts.mac_size))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE;
+        goto cleanup_mac;
+    }
+
+    /* digest the context data. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_mac_digest(&mac, (const uint8_t*)data, size))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE;
+        goto cleanup_mac_buffer;
+    }
+
+    /* finalize the mac. */
+    if (VCCRYPT_STATUS_SUCCESS != vccrypt_mac_finalize(&mac, &mac_buffer))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE;
+        goto cleanup_mac_buffer;
+    }
+
+    /* the derived key is the leading part of the mac. */
+    memcpy(derived->data, mac_buffer.data, derived->size);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_mac_buffer:
+    dispose((disposable_t*)&mac_buffer);
+
+cleanup_mac:
+    dispose((disposable_t*)&mac);
+
+done:
+    return retval;
+}
@@ -0,0 +1,54 @@
+/**
+ * \file protocolservice/unauthorized_protocol_child_context_close.c
+ *
+ * \brief Close a pooled dataservice child context.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/api.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Close a pooled dataservice child context, returning its pool entry
+ * to the free state.
+ *
+ * Responses still in flight for this child context are dropped as they
+ * arrive, since no connection holds their tags.  The child context stays
+ * mapped, in the closing state, until the last of them has arrived, so that
+ * each one releases its in-flight slot.
+ *
+ * \param svc       The protocol service instance.
+ * \param cc        The child context to close.
+ */
+void unauthorized_protocol_child_context_close(
+    unauthorized_protocol_service_instance_t* svc,
+    unauthorized_protocol_child_context_t* cc)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+    MODEL_ASSERT(NULL != cc);
+    MODEL_ASSERT(UPCC_READY == cc->state || UPCC_CLOSING == cc->state);
+    MODEL_ASSERT(0U == cc->connection_count);
+
+    /* wait for outstanding responses before closing. */
+    if (cc->request_sequence != cc->response_sequence)
+    {
+        cc->state = UPCC_CLOSING;
+        return;
+    }
+
+    /* send a child context close request to the dataservice. */
+    dataservice_api_sendreq_child_context_close(&svc->data, cc->child);
+
+    /* set the write callback for the dataservice socket. */
+    ipc_set_writecb_noblock(
+        &svc->data, &unauthorized_protocol_service_dataservice_write,
+        &svc->loop);
+
+    svc->dataservice_child_map[cc->child] = NULL;
+    cc->child = -1;
+    cc->state = UPCC_FREE;
+}
@@ -0,0 +1,82 @@
+/**
+ * \file protocolservice/unauthorized_protocol_child_context_release.c
+ *
+ * \brief Detach a connection from its pooled dataservice child context.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Detach a connection from its pooled dataservice child context.
+ *
+ * \param conn      The connection to detach.
+ *
+ * The child context stays open for later connections, unless it carries
+ * notification subscriptions or enough idle child contexts with the same
+ * capabilities are already open.  Responses to the connection's outstanding
+ * requests are dropped when they arrive, since no connection holds their tags.
+ */
+void unauthorized_protocol_child_context_release(
+    unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+    unauthorized_protocol_child_context_t* cc = conn->child_context;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cc);
+
+    /* remove the connection from the child context. */
+    for (size_t i = 0; i < cc->connection_count; ++i)
+    {
+        if (conn == cc->connections[i])
+        {
+            cc->connections[i] = cc->connections[--cc->connection_count];
+            cc->connections[cc->connection_count] = NULL;
+            break;
+        }
+    }
+
+    conn->child_context = NULL;
+    conn->dataservice_child_context = -1;
+
+    /* a child context being created, or still in use, stays as it is. */
+    if (UPCC_READY != cc->state || cc->connection_count > 0U)
+    {
+        return;
+    }
+
+    /* notification subscriptions can't be dropped, so the child context
+     * can't be shared again. */
+    if (cc->subscribed)
+    {
+        unauthorized_protocol_child_context_close(svc, cc);
+        return;
+    }
+
+    /* count the idle child contexts with these capabilities. */
+    size_t idle = 0U;
+    for (size_t i = 0; i < svc->num_connections; ++i)
+    {
+        unauthorized_protocol_child_context_t* other = svc->child_contexts + i;
+
+        if (UPCC_READY == other->state
+         && 0U == other->connection_count
+         && !memcmp(
+                other->dataservice_caps, cc->dataservice_caps,
+                sizeof(cc->dataservice_caps)))
+        {
+            ++idle;
+        }
+    }
+
+    /* keep only a few idle child contexts open. */
+    if (idle > UNAUTHORIZED_PROTOCOL_SERVICE_CHILD_CONTEXT_IDLE_MAX)
+    {
+        unauthorized_protocol_child_context_close(svc, cc);
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * \file protocolservice/unauthorized_protocol_child_context_route.c
+ *
+ * \brief Find the connection that a dataservice response answers.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Find the connection that a dataservice response answers.
+ *
+ * The data service answers the requests for a child context in order, so a
+ * response answers the request tagged with the child context's next response
+ * sequence number.  That request is the oldest outstanding request on its
+ * connection, and is made the connection's current request.
+ *
+ * \param cc        The child context on which the response was received.
+ *
+ * \returns the connection, or NULL if the request's connection has closed.
+ */
+unauthorized_protocol_connection_t* unauthorized_protocol_child_context_route(
+    unauthorized_protocol_child_context_t* cc)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cc);
+
+    uint32_t sequence = cc->response_sequence++;
+
+    for (size_t i = 0; i < cc->connection_count; ++i)
+    {
+        unauthorized_protocol_connection_t* conn = cc->connections[i];
+
+        if (conn->pending_count > 0U
+         && sequence == conn->pending_requests[conn->pending_head].sequence)
+        {
+            unauthorized_protocol_connection_request_pop(conn);
+            return conn;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,95 @@
+/**
+ * \file protocolservice/unauthorized_protocol_connection_artifact_watch_add.c
+ *
+ * \brief Add artifacts to the set that a connection watches.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static int artifact_id_compare(const void* lhs, const void* rhs);
+
+/**
+ * \brief Add artifacts to the set that a connection watches.
+ *
+ * The set is kept sorted, so that notifications for a shared child context
+ * can be matched to the connections watching each artifact with a binary
+ * search.  Artifacts that are already watched are only kept once.
+ *
+ * \param conn          The connection watching these artifacts.
+ * \param artifact_ids  The 16 byte artifact ids, laid end to end.
+ * \param count         The number of artifact ids.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT if the connection would
+ *        watch too many artifacts.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the set could not be grown.
+ */
+int unauthorized_protocol_connection_artifact_watch_add(
+    unauthorized_protocol_connection_t* conn, const uint8_t* artifact_ids,
+    size_t count)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != artifact_ids);
+
+    /* a connection can only watch so many artifacts. */
+    if (count > UNAUTHORIZED_PROTOCOL_SERVICE_ARTIFACT_WATCH_MAX
+     || conn->artifact_watch_count
+            > UNAUTHORIZED_PROTOCOL_SERVICE_ARTIFACT_WATCH_MAX - count)
+    {
+        return AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT;
+    }
+
+    /* grow the set to hold the new ids. */
+    uint8_t* ids =
+        (uint8_t*)realloc(
+            conn->artifact_watch_ids, 16 * (conn->artifact_watch_count + count));
+    if (NULL == ids)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    memcpy(ids + 16 * conn->artifact_watch_count, artifact_ids, 16 * count);
+    conn->artifact_watch_ids = ids;
+    conn->artifact_watch_count += count;
+
+    /* sort the set, and drop duplicates. */
+    qsort(ids, conn->artifact_watch_count, 16, &artifact_id_compare);
+
+    size_t unique = 0U;
+    for (size_t i = 0; i < conn->artifact_watch_count; ++i)
+    {
+        if (0U == unique || memcmp(ids + 16 * (unique - 1), ids + 16 * i, 16))
+        {
+            memmove(ids + 16 * unique, ids + 16 * i, 16);
+            ++unique;
+        }
+    }
+
+    conn->artifact_watch_count = unique;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Compare two artifact ids.
+ *
+ * \param lhs           The left-hand artifact id.
+ * \param rhs           The right-hand artifact id.
+ *
+ * \returns the order of the two ids, as per memcmp.
+ */
+static int artifact_id_compare(const void* lhs, const void* rhs)
+{
+    return memcmp(lhs, rhs, 16);
+}
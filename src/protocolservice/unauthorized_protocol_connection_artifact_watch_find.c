@@ -0,0 +1,52 @@
+/**
+ * \file protocolservice/unauthorized_protocol_connection_artifact_watch_find.c
+ *
+ * \brief Check whether a connection watches an artifact.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Check whether a connection watches an artifact.
+ *
+ * \param conn          The connection to check.
+ * \param artifact_id   The 16 byte artifact id.
+ *
+ * \returns true if the connection watches this artifact, and false otherwise.
+ */
+bool unauthorized_protocol_connection_artifact_watch_find(
+    const unauthorized_protocol_connection_t* conn,
+    const uint8_t* artifact_id)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != artifact_id);
+
+    /* binary search the sorted set. */
+    size_t lo = 0U;
+    size_t hi = conn->artifact_watch_count;
+    while (lo < hi)
+    {
+        size_t mid = lo + (hi - lo) / 2U;
+        int cmp = memcmp(conn->artifact_watch_ids + 16 * mid, artifact_id, 16);
+        if (0 == cmp)
+        {
+            return true;
+        }
+        else if (cmp < 0)
+        {
+            lo = mid + 1U;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,64 @@
+/**
+ * \file
+ * protocolservice/unauthorized_protocol_connection_block_stream_continue.c
+ *
+ * \brief Request the next slice of a streamed block.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/api.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Request the next slice of a streamed block from the data service, if
+ * the client socket's write buffer has room for it.
+ *
+ * \param conn              The connection to which the block is streamed.
+ */
+void unauthorized_protocol_connection_block_stream_continue(
+    unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_block_stream_t* stream = &conn->block_stream;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(APCS_STREAM_RESP_TO_CLIENT == conn->state);
+
+    /* only one slice is requested at a time, and the next slice waits until
+     * the client has taken most of the last one. */
+    if (!stream->active
+     || stream->slice_pending
+     || stream->position >= stream->cert_size
+     || ipc_socket_writebuffer_size(&conn->ctx) >= IPC_STREAM_MAX_CHUNK_SIZE)
+    {
+        return;
+    }
+
+    /* the slice answers the request that is being streamed. */
+    conn->request_id = UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET;
+    conn->current_request_offset = stream->request_offset;
+    conn->current_request_batched = false;
+
+    /* request the next slice. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_api_sendreq_block_cert_read(
+            &conn->svc->data, conn->dataservice_child_context,
+            stream->block_id, stream->position, IPC_STREAM_MAX_CHUNK_SIZE))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return;
+    }
+
+    /* route the response back to this connection. */
+    unauthorized_protocol_connection_request_push(conn);
+    stream->slice_pending = true;
+
+    /* set the write callback for the dataservice socket. */
+    ipc_set_writecb_noblock(
+        &conn->svc->data, &unauthorized_protocol_service_dataservice_write,
+        &conn->svc->loop);
+}
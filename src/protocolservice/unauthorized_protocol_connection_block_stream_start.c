@@ -0,0 +1,54 @@
+/**
+ * \file
+ * protocolservice/unauthorized_protocol_connection_block_stream_start.c
+ *
+ * \brief Start streaming a large block to the client.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Start streaming a block whose certificate is too large for a single
+ * stream chunk to the client.
+ *
+ * Stream frames can't be interleaved with other responses, so the stream
+ * starts once the responses to this connection's earlier requests have been
+ * written, and no further requests are dispatched until it ends.
+ *
+ * \param conn              The connection to which the block is streamed.
+ * \param dresp             The first slice of the block certificate.
+ */
+void unauthorized_protocol_connection_block_stream_start(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_block_cert_read_t* dresp)
+{
+    unauthorized_protocol_block_stream_t* stream = &conn->block_stream;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != dresp);
+    MODEL_ASSERT(!conn->current_request_batched);
+
+    /* remember the block being streamed. */
+    memset(stream, 0, sizeof(*stream));
+    stream->active = true;
+    stream->request_offset = conn->current_request_offset;
+    memcpy(stream->block_id, dresp->node.key, sizeof(stream->block_id));
+    stream->cert_size = ntohll(dresp->node.net_block_cert_size);
+
+    /* responses to earlier requests are still to come.  This slice is read
+     * again once they have been written. */
+    if (conn->pending_count > 0U)
+    {
+        return;
+    }
+
+    /* otherwise, the stream starts with this slice. */
+    conn->state = APCS_STREAM_RESP_TO_CLIENT;
+    unauthorized_protocol_connection_block_stream_write(conn, dresp);
+}
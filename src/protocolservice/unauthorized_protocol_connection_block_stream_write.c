@@ -0,0 +1,171 @@
+/**
+ * \file
+ * protocolservice/unauthorized_protocol_connection_block_stream_write.c
+ *
+ * \brief Write a slice of a streamed block to the client.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static int unauthorized_protocol_connection_block_stream_begin(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_block_cert_read_t* dresp);
+
+/**
+ * \brief Write a slice of a streamed block to the client.
+ *
+ * The begin frame and response header precede the first slice, and the end
+ * frame follows the last.  Once the stream has begun, a failure can't be
+ * reported to the client, so the connection is closed instead.
+ *
+ * \param conn              The connection to which the block is streamed.
+ * \param dresp             The slice of the block certificate.
+ */
+void unauthorized_protocol_connection_block_stream_write(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_block_cert_read_t* dresp)
+{
+    unauthorized_protocol_block_stream_t* stream = &conn->block_stream;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != dresp);
+    MODEL_ASSERT(stream->active);
+
+    /* this slice is no longer waited on. */
+    stream->slice_pending = false;
+
+    /* the slice must pick up where the last one left off. */
+    if (AGENTD_STATUS_SUCCESS != dresp->hdr.status
+     || 0U == dresp->data_size
+     || (uint64_t)ntohll(dresp->node.net_block_cert_size)
+            != stream->cert_size
+     || dresp->data_size > stream->cert_size - stream->position)
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return;
+    }
+
+    /* the first slice is preceded by the begin frame and header. */
+    if (!stream->started)
+    {
+        if (AGENTD_STATUS_SUCCESS !=
+            unauthorized_protocol_connection_block_stream_begin(conn, dresp))
+        {
+            unauthorized_protocol_service_close_connection(conn);
+            return;
+        }
+
+        stream->started = true;
+    }
+
+    /* write this slice as a single chunk. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_write_authed_stream_chunk_noblock(
+            &conn->ctx, conn->server_iv, dresp->data,
+            (uint32_t)dresp->data_size, &conn->svc->suite,
+            &conn->shared_secret))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return;
+    }
+
+    ++conn->server_iv;
+    stream->position += dresp->data_size;
+
+    /* after the last slice, end the stream and resume the connection's
+     * requests. */
+    if (stream->position == stream->cert_size)
+    {
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_write_authed_stream_end_noblock(
+                &conn->ctx, conn->server_iv, &conn->svc->suite,
+                &conn->shared_secret))
+        {
+            unauthorized_protocol_service_close_connection(conn);
+            return;
+        }
+
+        ++conn->server_iv;
+        memset(stream, 0, sizeof(*stream));
+        conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
+
+        /* requests queued during the stream wait their turn again. */
+        if (conn->queue_count > 0U)
+        {
+            unauthorized_protocol_service_schedule_add(conn);
+        }
+    }
+
+    /* the write callback requests the next slice as this one drains. */
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+}
+
+/**
+ * \brief Write the begin frame and response header of a streamed block.
+ *
+ * \param conn              The connection to which the block is streamed.
+ * \param dresp             The first slice of the block certificate.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - any of the errors returned by the
+ *        \ref ipc_write_authed_stream_begin_noblock() family.
+ */
+static int unauthorized_protocol_connection_block_stream_begin(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_block_cert_read_t* dresp)
+{
+    int retval;
+    uint8_t header[3 * sizeof(uint32_t) + 5 * 16];
+
+    /* build the response header. */
+    uint32_t net_method = htonl(UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET);
+    uint32_t net_status = htonl(AGENTD_STATUS_SUCCESS);
+    uint32_t net_offset = htonl(conn->block_stream.request_offset);
+    memcpy(header, &net_method, 4);
+    memcpy(header + 4, &net_status, 4);
+    memcpy(header + 8, &net_offset, 4);
+    memcpy(header + 12, dresp->node.key, 16);
+    memcpy(header + 28, dresp->node.prev, 16);
+    memcpy(header + 44, dresp->node.next, 16);
+    memcpy(header + 60, dresp->node.first_transaction_id, 16);
+    memcpy(header + 76, &dresp->node.net_block_height, 8);
+    memcpy(header + 84, &dresp->node.net_block_cert_size, 8);
+
+    /* the begin frame carries the size of the whole response. */
+    retval =
+        ipc_write_authed_stream_begin_noblock(
+            &conn->ctx, conn->server_iv,
+            sizeof(header) + conn->block_stream.cert_size, &conn->svc->suite,
+            &conn->shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    ++conn->server_iv;
+
+    /* the header is the first chunk. */
+    retval =
+        ipc_write_authed_stream_chunk_noblock(
+            &conn->ctx, conn->server_iv, header, sizeof(header),
+            &conn->svc->suite, &conn->shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    ++conn->server_iv;
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -164,6 +164,28 @@ static void unauthorized_protocol_connection_dispose(void* disposable)
     dispose((disposable_t*)&conn->client_key_nonce);
     dispose((disposable_t*)&conn->entity_public_key);
 
+    /* release any batch response still being collected. */
+    if (NULL != conn->batch_buffer)
+    {
+        memset(conn->batch_buffer, 0, conn->batch_capacity);
+        free(conn->batch_buffer);
+    }
+
+    /* release the set of watched artifacts. */
+    free(conn->artifact_watch_ids);
+
+    /* release any requests still queued for the scheduler. */
+    for (size_t i = 0; i < conn->queue_count; ++i)
+    {
+        unauthorized_protocol_queued_request_t* queued =
+            conn->queued_requests
+                + (conn->queue_head + i)
+                    % UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX;
+
+        memset(queued->packet, 0, queued->packet_size);
+        free(queued->packet);
+    }
+
     /* clean up the instance. */
     memset(conn, 0, sizeof(unauthorized_protocol_connection_t));
 }
@@ -0,0 +1,62 @@
+/**
+ * \file protocolservice/unauthorized_protocol_connection_request_enqueue.c
+ *
+ * \brief Queue a request until the scheduler dispatches it.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Queue a request read from the client until the scheduler dispatches
+ * it.
+ *
+ * The connection takes ownership of the request packet.  The caller must have
+ * checked that the connection's pipeline has room.
+ *
+ * \param conn              The connection on which the request was read.
+ * \param packet            The request packet.
+ * \param packet_size       The size of the request packet.
+ * \param request_id        The request ID.
+ * \param request_offset    The offset of the request.
+ */
+void unauthorized_protocol_connection_request_enqueue(
+    unauthorized_protocol_connection_t* conn, void* packet,
+    uint32_t packet_size, uint32_t request_id, uint32_t request_offset)
+{
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != packet);
+    MODEL_ASSERT(
+        conn->queue_count < UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX);
+
+    size_t tail =
+        (conn->queue_head + conn->queue_count)
+            % UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX;
+
+    unauthorized_protocol_queued_request_t* queued =
+        conn->queued_requests + tail;
+    queued->packet = packet;
+    queued->packet_size = packet_size;
+    queued->request_id = request_id;
+    queued->request_offset = request_offset;
+    clock_gettime(CLOCK_MONOTONIC, &queued->enqueued);
+
+    ++conn->queue_count;
+    ++svc->schedule_queued;
+
+    /* no more requests are read until a queued batch has been answered. */
+    if (UNAUTH_PROTOCOL_REQ_ID_BATCH == request_id)
+    {
+        conn->batch_queued = true;
+    }
+
+    /* a connection with queued requests waits its turn at the end of the
+     * schedule. */
+    unauthorized_protocol_service_schedule_add(conn);
+}
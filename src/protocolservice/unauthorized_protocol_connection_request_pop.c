@@ -0,0 +1,47 @@
+/**
+ * \file protocolservice/unauthorized_protocol_connection_request_pop.c
+ *
+ * \brief Take the oldest request waiting on the data service.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Take the oldest request waiting on the data service, making it the
+ * connection's current request.
+ *
+ * The data service answers the requests for a child context in order, so each
+ * response routed to a connection belongs to its oldest outstanding request.
+ *
+ * \param conn          The connection to which a response was sent.
+ *
+ * \returns true if a request was waiting, and false otherwise.
+ */
+bool unauthorized_protocol_connection_request_pop(
+    unauthorized_protocol_connection_t* conn)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+
+    if (0U == conn->pending_count)
+    {
+        return false;
+    }
+
+    /* restore the request so the response handler can answer it. */
+    conn->request_id = conn->pending_requests[conn->pending_head].request_id;
+    conn->current_request_offset =
+        conn->pending_requests[conn->pending_head].request_offset;
+    conn->current_request_batched =
+        conn->pending_requests[conn->pending_head].batched;
+
+    conn->pending_head =
+        (conn->pending_head + 1U) % UNAUTHORIZED_PROTOCOL_SERVICE_PENDING_MAX;
+    --conn->pending_count;
+
+    return true;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file protocolservice/unauthorized_protocol_connection_request_push.c
+ *
+ * \brief Record a request that is waiting on the data service.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Record a request that is waiting on the data service.
+ *
+ * The request ID, offset, and batch membership are taken from the
+ * connection's current request.  The request is tagged with its child
+ * context's next request sequence number, so that its response can be routed
+ * back to this connection.  The caller must have checked that the
+ * connection's pipeline has room.
+ *
+ * \param conn          The connection on which the request was read.
+ */
+void unauthorized_protocol_connection_request_push(
+    unauthorized_protocol_connection_t* conn)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != conn->child_context);
+    MODEL_ASSERT(
+        conn->pending_count < UNAUTHORIZED_PROTOCOL_SERVICE_PENDING_MAX);
+
+    size_t tail =
+        (conn->pending_head + conn->pending_count)
+            % UNAUTHORIZED_PROTOCOL_SERVICE_PENDING_MAX;
+
+    conn->pending_requests[tail].sequence =
+        conn->child_context->request_sequence++;
+    conn->pending_requests[tail].request_id = conn->request_id;
+    conn->pending_requests[tail].request_offset = conn->current_request_offset;
+    conn->pending_requests[tail].batched = conn->current_request_batched;
+    ++conn->pending_count;
+    ++conn->svc->dataservice_inflight;
+}
@@ -0,0 +1,152 @@
+/**
+ * \file protocolservice/unauthorized_protocol_connection_write_response.c
+ *
+ * \brief Write a command response to the client, or add it to a batch.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static int unauthorized_protocol_connection_batch_append(
+    unauthorized_protocol_connection_t* conn, const void* payload,
+    size_t size);
+
+/**
+ * \brief Write a command response to the client.
+ *
+ * If the current request is part of a batch, the response is added to the
+ * batch instead, and the batch response is written once every sub-request in
+ * the batch has been answered.  The server IV is advanced for each packet
+ * written.
+ *
+ * \param conn          The connection to which the response is written.
+ * \param payload       The response payload.
+ * \param size          The size of the response payload.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the batch response could not be
+ *        grown.
+ *      - any of the errors returned by \ref ipc_write_authed_data_noblock().
+ */
+int unauthorized_protocol_connection_write_response(
+    unauthorized_protocol_connection_t* conn, const void* payload,
+    size_t size)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != payload);
+
+    /* a response to a sub-request waits for the rest of its batch. */
+    if (conn->current_request_batched)
+    {
+        conn->current_request_batched = false;
+
+        retval =
+            unauthorized_protocol_connection_batch_append(conn, payload, size);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return retval;
+        }
+
+        /* if sub-requests are still outstanding, there's nothing to write. */
+        --conn->batch_remaining;
+        if (conn->batch_remaining > 0U)
+        {
+            return AGENTD_STATUS_SUCCESS;
+        }
+
+        /* the batch is complete, so write it as a single packet. */
+        retval =
+            ipc_write_authed_data_noblock(
+                &conn->ctx, conn->server_iv, conn->batch_buffer,
+                conn->batch_size, &conn->svc->suite, &conn->shared_secret);
+
+        /* the batch buffer is no longer needed. */
+        memset(conn->batch_buffer, 0, conn->batch_capacity);
+        free(conn->batch_buffer);
+        conn->batch_buffer = NULL;
+        conn->batch_size = 0U;
+        conn->batch_capacity = 0U;
+    }
+    else
+    {
+        retval =
+            ipc_write_authed_data_noblock(
+                &conn->ctx, conn->server_iv, payload, size,
+                &conn->svc->suite, &conn->shared_secret);
+    }
+
+    /* Update the server iv on success. */
+    if (AGENTD_STATUS_SUCCESS == retval)
+    {
+        ++conn->server_iv;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Append a sub-response to the connection's batch response.
+ *
+ * \param conn          The connection with an open batch.
+ * \param payload       The sub-response payload.
+ * \param size          The size of the sub-response payload.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the batch response could not be
+ *        grown.
+ */
+static int unauthorized_protocol_connection_batch_append(
+    unauthorized_protocol_connection_t* conn, const void* payload,
+    size_t size)
+{
+    MODEL_ASSERT(NULL != conn->batch_buffer);
+
+    /* each sub-response is prefixed with its size. */
+    size_t needed = conn->batch_size + sizeof(uint32_t) + size;
+    if (size > UINT32_MAX || needed < conn->batch_size)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* grow the batch buffer if needed. */
+    if (needed > conn->batch_capacity)
+    {
+        size_t capacity = 2U * conn->batch_capacity;
+        if (capacity < needed)
+        {
+            capacity = needed;
+        }
+
+        uint8_t* buffer = (uint8_t*)malloc(capacity);
+        if (NULL == buffer)
+        {
+            return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        /* move the batch over, scrubbing the old buffer. */
+        memcpy(buffer, conn->batch_buffer, conn->batch_size);
+        memset(conn->batch_buffer, 0, conn->batch_capacity);
+        free(conn->batch_buffer);
+        conn->batch_buffer = buffer;
+        conn->batch_capacity = capacity;
+    }
+
+    uint32_t net_size = htonl((uint32_t)size);
+    memcpy(conn->batch_buffer + conn->batch_size, &net_size, sizeof(net_size));
+    memcpy(
+        conn->batch_buffer + conn->batch_size + sizeof(net_size), payload,
+        size);
+    conn->batch_size = needed;
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,39 @@
+/**
+ * \file protocolservice/unauthorized_protocol_entity_table_find.c
+ *
+ * \brief Find an entity in an authorized entity table.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Find an entity in an authorized entity table.
+ *
+ * \param table         The table to search.
+ * \param entity_uuid   The UUID of the entity to find.
+ *
+ * \returns the entity, or NULL if it is not in the table.
+ */
+const unauthorized_protocol_entity_t* unauthorized_protocol_entity_table_find(
+    const unauthorized_protocol_entity_table_t* table,
+    const uint8_t* entity_uuid)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(NULL != entity_uuid);
+
+    const unauthorized_protocol_entity_t* entity =
+        unauthorized_protocol_entity_table_probe(table, entity_uuid);
+
+    /* an empty slot means that the entity isn't in the table. */
+    if (NULL == entity || !entity->in_use)
+    {
+        return NULL;
+    }
+
+    return entity;
+}
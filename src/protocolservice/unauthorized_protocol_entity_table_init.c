@@ -0,0 +1,93 @@
+/**
+ * \file protocolservice/unauthorized_protocol_entity_table_init.c
+ *
+ * \brief Initialize an empty authorized entity table.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static void unauthorized_protocol_entity_table_dispose(void* disposable);
+
+/**
+ * \brief Initialize an empty authorized entity table with room for the given
+ * number of entities.
+ *
+ * On success, the table is owned by the caller and must be disposed by
+ * calling \ref dispose() when no longer needed.
+ *
+ * \param table         The table to initialize.
+ * \param count         The number of entities that the table must hold.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the table could not be
+ *        allocated.
+ */
+int unauthorized_protocol_entity_table_init(
+    unauthorized_protocol_entity_table_t* table, size_t count)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+
+    /* keep the table at most half full, with a power of two capacity so that
+     * a hash can be reduced to a slot with a mask. */
+    size_t capacity = UNAUTHORIZED_PROTOCOL_SERVICE_ENTITY_TABLE_MIN_CAPACITY;
+    while (capacity < 2U * count)
+    {
+        if (capacity > SIZE_MAX / 2U / sizeof(unauthorized_protocol_entity_t))
+        {
+            return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        }
+
+        capacity *= 2U;
+    }
+
+    /* allocate the slots. */
+    unauthorized_protocol_entity_t* entities =
+        (unauthorized_protocol_entity_t*)
+            calloc(capacity, sizeof(unauthorized_protocol_entity_t));
+    if (NULL == entities)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* set up the table. */
+    memset(table, 0, sizeof(unauthorized_protocol_entity_table_t));
+    table->hdr.dispose = &unauthorized_protocol_entity_table_dispose;
+    table->entities = entities;
+    table->capacity = capacity;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Dispose of an authorized entity table.
+ *
+ * \param disposable        The table to dispose.
+ */
+static void unauthorized_protocol_entity_table_dispose(void* disposable)
+{
+    unauthorized_protocol_entity_table_t* table =
+        (unauthorized_protocol_entity_table_t*)disposable;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+
+    /* scrub and free the slots. */
+    memset(
+        table->entities, 0,
+        table->capacity * sizeof(unauthorized_protocol_entity_t));
+    free(table->entities);
+
+    /* clear the table. */
+    memset(table, 0, sizeof(unauthorized_protocol_entity_table_t));
+}
@@ -0,0 +1,61 @@
+/**
+ * \file protocolservice/unauthorized_protocol_entity_table_insert.c
+ *
+ * \brief Add an entity to an authorized entity table.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Add an entity to an authorized entity table.
+ *
+ * If the entity is already in the table, its key, capabilities, and weight
+ * are replaced.
+ *
+ * \param table         The table to which the entity is added.
+ * \param entity        The entity to add.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE if the table
+ *        has no room for another entity.
+ */
+int unauthorized_protocol_entity_table_insert(
+    unauthorized_protocol_entity_table_t* table,
+    const unauthorized_protocol_entity_t* entity)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(NULL != entity);
+
+    unauthorized_protocol_entity_t* slot =
+        unauthorized_protocol_entity_table_probe(table, entity->entity_uuid);
+    if (NULL == slot)
+    {
+        return AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE;
+    }
+
+    /* a new entity can't fill the table past half, or probes grow long. */
+    if (!slot->in_use)
+    {
+        if (2U * (table->count + 1U) > table->capacity)
+        {
+            return AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE;
+        }
+
+        ++table->count;
+    }
+
+    /* copy the entity into its slot. */
+    memcpy(slot, entity, sizeof(unauthorized_protocol_entity_t));
+    slot->in_use = true;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
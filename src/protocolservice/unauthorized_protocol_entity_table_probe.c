@@ -0,0 +1,69 @@
+/**
+ * \file protocolservice/unauthorized_protocol_entity_table_probe.c
+ *
+ * \brief Find the slot for an entity in an authorized entity table.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Find the slot for an entity in an authorized entity table.
+ *
+ * Slots are probed linearly from the slot picked by a hash of the entity
+ * UUID.  Entities are never removed from a table, so the probe can stop at the
+ * first empty slot.
+ *
+ * \param table         The table to probe.
+ * \param entity_uuid   The UUID of the entity.
+ *
+ * \returns the slot holding the entity, the empty slot where it would be
+ * added, or NULL if the table is full.
+ */
+unauthorized_protocol_entity_t* unauthorized_protocol_entity_table_probe(
+    const unauthorized_protocol_entity_table_t* table,
+    const uint8_t* entity_uuid)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != table);
+    MODEL_ASSERT(NULL != entity_uuid);
+
+    /* an uninitialized table has no slots. */
+    if (0U == table->capacity)
+    {
+        return NULL;
+    }
+
+    /* FNV-1a hash of the entity UUID. */
+    uint64_t hash = 0xcbf29ce484222325UL;
+    for (size_t i = 0; i < 16; ++i)
+    {
+        hash ^= entity_uuid[i];
+        hash *= 0x00000100000001b3UL;
+    }
+
+    /* the capacity is a power of two. */
+    const size_t mask = table->capacity - 1U;
+    size_t slot = (size_t)hash & mask;
+
+    /* probe until we find this entity or an empty slot. */
+    for (size_t i = 0; i < table->capacity; ++i)
+    {
+        unauthorized_protocol_entity_t* entity = table->entities + slot;
+
+        if (!entity->in_use
+         || 0 == memcmp(entity->entity_uuid, entity_uuid, 16))
+        {
+            return entity;
+        }
+
+        slot = (slot + 1U) & mask;
+    }
+
+    /* the table is full. */
+    return NULL;
+}
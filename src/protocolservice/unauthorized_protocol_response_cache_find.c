@@ -0,0 +1,127 @@
+/**
+ * \file protocolservice/unauthorized_protocol_response_cache_find.c
+ *
+ * \brief Find a response in the response cache.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static void unauthorized_protocol_response_cache_record(
+    unauthorized_protocol_response_cache_t* cache, uint64_t hash);
+
+/**
+ * \brief Find a response in the response cache.
+ *
+ * Every lookup counts as a hit or a miss, and is recorded in the cache's
+ * frequency sketch.  A hit becomes the most recently used entry.
+ *
+ * \param cache         The cache to search.
+ * \param request_id    The request ID of the response.
+ * \param id            The block or transaction ID of the response.
+ *
+ * \returns the cached response, or NULL if it is not in the cache.
+ */
+const unauthorized_protocol_response_cache_entry_t*
+unauthorized_protocol_response_cache_find(
+    unauthorized_protocol_response_cache_t* cache, uint32_t request_id,
+    const uint8_t* id)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(NULL != id);
+
+    uint64_t hash = unauthorized_protocol_response_cache_hash(request_id, id);
+
+    /* the sketch sees every request, whether or not it is cached. */
+    unauthorized_protocol_response_cache_record(cache, hash);
+
+    /* search the bucket for this key. */
+    unauthorized_protocol_response_cache_entry_t* entry =
+        cache->buckets[
+            hash & (UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUCKETS - 1U)];
+    while (NULL != entry
+        && (entry->hash != hash
+         || entry->request_id != request_id
+         || memcmp(entry->id, id, sizeof(entry->id))))
+    {
+        entry = entry->hash_next;
+    }
+
+    if (NULL == entry)
+    {
+        ++cache->misses;
+        return NULL;
+    }
+
+    ++cache->hits;
+
+    /* move this entry to the front of the LRU list. */
+    if (cache->lru_head != entry)
+    {
+        entry->lru_prev->lru_next = entry->lru_next;
+        if (NULL != entry->lru_next)
+        {
+            entry->lru_next->lru_prev = entry->lru_prev;
+        }
+        else
+        {
+            cache->lru_tail = entry->lru_prev;
+        }
+
+        entry->lru_prev = NULL;
+        entry->lru_next = cache->lru_head;
+        cache->lru_head->lru_prev = entry;
+        cache->lru_head = entry;
+    }
+
+    return entry;
+}
+
+/**
+ * \brief Record an access in the frequency sketch.
+ *
+ * Each key has two saturating counters, picked by different bits of its hash.
+ * Once enough accesses have been recorded, every counter is halved so that old
+ * accesses fade.
+ *
+ * \param cache         The cache recording the access.
+ * \param hash          The hash of the key that was accessed.
+ */
+static void unauthorized_protocol_response_cache_record(
+    unauthorized_protocol_response_cache_t* cache, uint64_t hash)
+{
+    const size_t mask =
+        UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SIZE - 1U;
+    uint8_t* first = cache->sketch + (hash & mask);
+    uint8_t* second = cache->sketch + ((hash >> 32) & mask);
+
+    if (*first < UINT8_MAX)
+    {
+        ++*first;
+    }
+
+    if (*second < UINT8_MAX)
+    {
+        ++*second;
+    }
+
+    /* age the sketch. */
+    ++cache->sketch_samples;
+    if (cache->sketch_samples
+            >= UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SAMPLE)
+    {
+        for (size_t i = 0;
+             i < UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SIZE; ++i)
+        {
+            cache->sketch[i] /= 2U;
+        }
+
+        cache->sketch_samples = 0U;
+    }
+}
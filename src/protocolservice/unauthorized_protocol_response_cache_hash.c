@@ -0,0 +1,42 @@
+/**
+ * \file protocolservice/unauthorized_protocol_response_cache_hash.c
+ *
+ * \brief Hash a response cache key.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Hash a response cache key.
+ *
+ * \param request_id    The request ID of the cached response.
+ * \param id            The block or transaction ID of the cached response.
+ *
+ * \returns the hash of this key.
+ */
+uint64_t unauthorized_protocol_response_cache_hash(
+    uint32_t request_id, const uint8_t* id)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != id);
+
+    /* FNV-1a hash of the request ID followed by the ID. */
+    uint64_t hash = 0xcbf29ce484222325UL;
+    for (size_t i = 0; i < 4; ++i)
+    {
+        hash ^= (uint8_t)(request_id >> (8 * i));
+        hash *= 0x00000100000001b3UL;
+    }
+
+    for (size_t i = 0; i < 16; ++i)
+    {
+        hash ^= id[i];
+        hash *= 0x00000100000001b3UL;
+    }
+
+    return hash;
+}
@@ -0,0 +1,63 @@
+/**
+ * \file protocolservice/unauthorized_protocol_response_cache_init.c
+ *
+ * \brief Initialize an empty response cache.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static void unauthorized_protocol_response_cache_dispose(void* disposable);
+
+/**
+ * \brief Initialize an empty response cache.
+ *
+ * The cache is owned by the caller and must be disposed by calling
+ * \ref dispose() when no longer needed.
+ *
+ * \param cache         The cache to initialize.
+ * \param budget        The most bytes that the cache can hold.
+ */
+void unauthorized_protocol_response_cache_init(
+    unauthorized_protocol_response_cache_t* cache, size_t budget)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cache);
+
+    /* an empty cache has no entries and no access history. */
+    memset(cache, 0, sizeof(unauthorized_protocol_response_cache_t));
+    cache->hdr.dispose = &unauthorized_protocol_response_cache_dispose;
+    cache->budget = budget;
+}
+
+/**
+ * \brief Dispose of a response cache.
+ *
+ * \param disposable        The cache to dispose.
+ */
+static void unauthorized_protocol_response_cache_dispose(void* disposable)
+{
+    unauthorized_protocol_response_cache_t* cache =
+        (unauthorized_protocol_response_cache_t*)disposable;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cache);
+
+    /* every entry is on the LRU list. */
+    for (unauthorized_protocol_response_cache_entry_t* i = cache->lru_head;
+         i != NULL;)
+    {
+        unauthorized_protocol_response_cache_entry_t* next = i->lru_next;
+        free(i);
+        i = next;
+    }
+
+    /* clear the cache. */
+    memset(cache, 0, sizeof(unauthorized_protocol_response_cache_t));
+}
@@ -0,0 +1,202 @@
+/**
+ * \file protocolservice/unauthorized_protocol_response_cache_insert.c
+ *
+ * \brief Add a response to the response cache.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static uint8_t unauthorized_protocol_response_cache_frequency(
+    const unauthorized_protocol_response_cache_t* cache, uint64_t hash);
+static void unauthorized_protocol_response_cache_evict(
+    unauthorized_protocol_response_cache_t* cache,
+    unauthorized_protocol_response_cache_entry_t* entry);
+
+/**
+ * \brief Add a response to the response cache.
+ *
+ * The response is only added if it fits in the budget by evicting entries
+ * that have been requested less often than it has.  A response that is not
+ * admitted is not an error.
+ *
+ * \param cache         The cache to which the response is added.
+ * \param request_id    The request ID of the response.
+ * \param id            The block or transaction ID of the response.
+ * \param data          The encoded response, following its header.
+ * \param size          The size of the encoded response.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the entry could not be
+ *        allocated.
+ */
+int unauthorized_protocol_response_cache_insert(
+    unauthorized_protocol_response_cache_t* cache, uint32_t request_id,
+    const uint8_t* id, const uint8_t* data, size_t size)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != cache);
+    MODEL_ASSERT(NULL != id);
+    MODEL_ASSERT(NULL != data);
+
+    uint64_t hash = unauthorized_protocol_response_cache_hash(request_id, id);
+    size_t bucket =
+        hash & (UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUCKETS - 1U);
+
+    /* a response that can never fit isn't cached. */
+    size_t entry_size =
+        sizeof(unauthorized_protocol_response_cache_entry_t) + size;
+    if (size > cache->budget || entry_size > cache->budget)
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* another request may have already cached this response. */
+    for (unauthorized_protocol_response_cache_entry_t* i =
+             cache->buckets[bucket];
+         i != NULL; i = i->hash_next)
+    {
+        if (i->hash == hash && i->request_id == request_id
+         && !memcmp(i->id, id, sizeof(i->id)))
+        {
+            return AGENTD_STATUS_SUCCESS;
+        }
+    }
+
+    /* find out whether enough room can be made from less popular entries,
+     * before evicting any of them. */
+    uint8_t frequency =
+        unauthorized_protocol_response_cache_frequency(cache, hash);
+    size_t available = cache->budget - cache->used;
+    unauthorized_protocol_response_cache_entry_t* victim = cache->lru_tail;
+    while (available < entry_size)
+    {
+        if (NULL == victim
+         || unauthorized_protocol_response_cache_frequency(
+                cache, victim->hash) >= frequency)
+        {
+            return AGENTD_STATUS_SUCCESS;
+        }
+
+        available +=
+            sizeof(unauthorized_protocol_response_cache_entry_t)
+                + victim->size;
+        victim = victim->lru_prev;
+    }
+
+    /* create the entry. */
+    unauthorized_protocol_response_cache_entry_t* entry =
+        (unauthorized_protocol_response_cache_entry_t*)malloc(entry_size);
+    if (NULL == entry)
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    memset(entry, 0, sizeof(unauthorized_protocol_response_cache_entry_t));
+    entry->hash = hash;
+    entry->request_id = request_id;
+    memcpy(entry->id, id, sizeof(entry->id));
+    entry->size = size;
+    memcpy(entry->data, data, size);
+
+    /* make room for it. */
+    while (cache->budget - cache->used < entry_size)
+    {
+        unauthorized_protocol_response_cache_evict(cache, cache->lru_tail);
+    }
+
+    /* add it to its bucket and to the front of the LRU list. */
+    entry->hash_next = cache->buckets[bucket];
+    cache->buckets[bucket] = entry;
+
+    entry->lru_next = cache->lru_head;
+    if (NULL != cache->lru_head)
+    {
+        cache->lru_head->lru_prev = entry;
+    }
+    else
+    {
+        cache->lru_tail = entry;
+    }
+
+    cache->lru_head = entry;
+    cache->used += entry_size;
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
+
+/**
+ * \brief Estimate how often a key has been requested recently.
+ *
+ * \param cache         The cache holding the frequency sketch.
+ * \param hash          The hash of the key.
+ *
+ * \returns the smaller of the key's two sketch counters.
+ */
+static uint8_t unauthorized_protocol_response_cache_frequency(
+    const unauthorized_protocol_response_cache_t* cache, uint64_t hash)
+{
+    const size_t mask =
+        UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SIZE - 1U;
+    uint8_t first = cache->sketch[hash & mask];
+    uint8_t second = cache->sketch[(hash >> 32) & mask];
+
+    return (first < second) ? first : second;
+}
+
+/**
+ * \brief Remove an entry from the response cache and free it.
+ *
+ * \param cache         The cache holding the entry.
+ * \param entry         The entry to evict.
+ */
+static void unauthorized_protocol_response_cache_evict(
+    unauthorized_protocol_response_cache_t* cache,
+    unauthorized_protocol_response_cache_entry_t* entry)
+{
+    MODEL_ASSERT(NULL != entry);
+
+    /* unlink it from its bucket. */
+    unauthorized_protocol_response_cache_entry_t** link =
+        cache->buckets
+            + (entry->hash
+                & (UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUCKETS - 1U));
+    while (*link != entry)
+    {
+        link = &(*link)->hash_next;
+    }
+
+    *link = entry->hash_next;
+
+    /* unlink it from the LRU list. */
+    if (NULL != entry->lru_prev)
+    {
+        entry->lru_prev->lru_next = entry->lru_next;
+    }
+    else
+    {
+        cache->lru_head = entry->lru_next;
+    }
+
+    if (NULL != entry->lru_next)
+    {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    }
+    else
+    {
+        cache->lru_tail = entry->lru_prev;
+    }
+
+    cache->used -=
+        sizeof(unauthorized_protocol_response_cache_entry_t) + entry->size;
+    free(entry);
+}
@@ -6,8 +6,6 @@
  * \copyright 2020 Velo Payments, Inc.  All rights reserved.
  */
 
-#include <agentd/dataservice/api.h>
-
 #include "unauthorized_protocol_service_private.h"
 
 /**
@@ -24,24 +22,28 @@ void unauthorized_protocol_service_close_connection(
     /* remove the connection from the event loop. */
     ipc_event_loop_remove(&svc->loop, &conn->ctx);
 
-    /* if still associated with a dataservice child context, remove it. */
-    if (conn->dataservice_child_context >= 0)
+    /* a connection waiting on a child context is on the wait list. */
+    if (APCS_DATASERVICE_CHILD_CONTEXT_WAIT == conn->state)
+    {
+        unauthorized_protocol_connection_remove(
+            &svc->dataservice_context_create_head, conn);
+    }
+    else
     {
-        /* send a child context close request to the dataservice. */
-        dataservice_api_sendreq_child_context_close(
-            &svc->data, conn->dataservice_child_context);
+        unauthorized_protocol_connection_remove(
+            &svc->used_connection_head, conn);
+    }
 
-        /* set the write callback for the dataservice socket. */
-        ipc_set_writecb_noblock(
-            &svc->data, &unauthorized_protocol_service_dataservice_write,
-            &svc->loop);
+    /* drop any requests still waiting on the scheduler. */
+    unauthorized_protocol_service_schedule_remove(conn);
 
-        svc->dataservice_child_map[conn->dataservice_child_context] = NULL;
-        conn->dataservice_child_context = -1;
+    /* if still associated with a dataservice child context, detach from it.
+     * The child context itself usually stays open for later connections. */
+    if (NULL != conn->child_context)
+    {
+        unauthorized_protocol_child_context_release(conn);
     }
 
-    unauthorized_protocol_connection_remove(
-        &svc->used_connection_head, conn);
     dispose((disposable_t*)conn);
     unauthorized_protocol_connection_push_front(
         &svc->free_connection_head, conn);
@@ -10,14 +10,39 @@
 
 #include "unauthorized_protocol_service_private.h"
 
+/* forward decls. */
+static bool unauthorized_protocol_service_command_read_one(
+    unauthorized_protocol_connection_t* conn);
+
 /**
  * \brief Attempt to read a command from the client.
  *
+ * Commands are read until none are left, until the connection has as many
+ * requests queued or outstanding as its pipeline window allows, or until a
+ * batch request is read.  In the latter cases, reading resumes once a response
+ * has been written.  Each command is queued for the scheduler, which
+ * dispatches it when it is this connection's turn.
+ *
  * \param conn      The connection from which this command should be read.
  */
 void unauthorized_protocol_service_command_read(
     unauthorized_protocol_connection_t* conn)
 {
+    while (unauthorized_protocol_service_command_read_one(conn))
+        ;
+}
+
+/**
+ * \brief Read and queue a single command from the client.
+ *
+ * \param conn      The connection from which this command should be read.
+ *
+ * \returns true if another command can be read now, and false otherwise.
+ */
+static bool unauthorized_protocol_service_command_read_one(
+    unauthorized_protocol_connection_t* conn)
+{
+    bool more = false;
     void* req = NULL;
     uint32_t size = 0U;
     uint32_t request_id;
@@ -33,21 +58,22 @@ void unauthorized_protocol_service_command_read(
         ipc_set_readcb_noblock(
             &conn->ctx, &unauthorized_protocol_service_connection_read,
             &conn->svc->loop);
-        return;
+        return false;
     }
     if (AGENTD_ERROR_IPC_EVBUFFER_READ_FAILURE == retval || AGENTD_ERROR_IPC_EVBUFFER_EOF == retval)
     {
         unauthorized_protocol_service_close_connection(conn);
-        return;
+        return false;
     }
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         unauthorized_protocol_service_error_response(
             conn, 0, AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_REQUEST, 0, true);
-        return;
+        return false;
     }
 
-    /* from here on, we are committed.  Don't call this callback again. */
+    /* from here on, we are committed.  Don't call this callback again until
+     * we know whether the pipeline has room for another request. */
     ++conn->client_iv;
     ipc_set_readcb_noblock(&conn->ctx, NULL, &conn->svc->loop);
 
@@ -76,12 +102,27 @@ void unauthorized_protocol_service_command_read(
     breq += request_offset_size;
     request_offset = ntohl(request_offset);
 
-    /* decode and dispatch this request. */
-    unauthorized_protocol_service_decode_and_dispatch(
-        conn, request_id, request_offset, breq, size - expected_size);
+    /* queue this request, which takes ownership of the packet, and give the
+     * scheduler a chance to dispatch it. */
+    unauthorized_protocol_connection_request_enqueue(
+        conn, req, size, request_id, request_offset);
+    unauthorized_protocol_service_schedule(conn->svc);
+
+    /* keep reading while the connection is open, its pipeline has room, and
+     * no batch is being collected. */
+    more =
+        (APCS_READ_COMMAND_REQ_FROM_CLIENT == conn->state
+         || APCS_WRITE_COMMAND_RESP_TO_CLIENT == conn->state)
+        && conn->pending_count + conn->queue_count
+            < conn->svc->pipeline_window
+        && 0U == conn->batch_remaining
+        && !conn->batch_queued;
+
+    return more;
 
-    /* fall-through to clean up data. */
 cleanup_data:
     memset(req, 0, size);
     free(req);
+
+    return more;
 }
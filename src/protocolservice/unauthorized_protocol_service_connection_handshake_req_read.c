@@ -53,6 +53,18 @@ void unauthorized_protocol_service_connection_handshake_req_read(
     /* set up the read buffer pointer. */
     const uint8_t* breq = (const uint8_t*)req;
 
+    /* a client holding a session ticket can resume its session instead. */
+    if (size >= sizeof(request_id))
+    {
+        memcpy(&request_id, breq, sizeof(request_id));
+        if (UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME == ntohl(request_id))
+        {
+            unauthorized_protocol_service_connection_handshake_resume(
+                conn, breq, size);
+            goto cleanup_data;
+        }
+    }
+
     /* verify that the size matches what we expect. */
     const size_t request_id_size = sizeof(request_id);
     const size_t request_offset_size = sizeof(request_offset);
@@ -139,8 +151,22 @@ void unauthorized_protocol_service_connection_handshake_req_read(
         goto cleanup_data;
     }
 
-    /* write an entropy request to the random service to gather entropy for this
-     * handshake. */
+    /* draw the entropy for this handshake from the local pool if we can, so
+     * that the response can be written right away. */
+    if (unauthorized_protocol_service_entropy_pool_draw(conn))
+    {
+        if (AGENTD_STATUS_SUCCESS !=
+            unauthorized_protocol_service_write_handshake_request_response(
+                conn))
+        {
+            unauthorized_protocol_service_close_connection(conn);
+        }
+
+        goto cleanup_data;
+    }
+
+    /* otherwise, write an entropy request to the random service to gather
+     * entropy for this handshake. */
     if (AGENTD_STATUS_SUCCESS !=
         unauthorized_protocol_service_write_entropy_request(conn))
     {
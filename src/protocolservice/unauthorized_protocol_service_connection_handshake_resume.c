@@ -0,0 +1,307 @@
+/**
+ * \file
+ * protocolservice/unauthorized_protocol_service_connection_handshake_resume.c
+ *
+ * \brief Resume a session from a handshake resume request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <vccrypt/compare.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static int unauthorized_protocol_service_write_handshake_resume_response(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Resume a session from a handshake resume request.
+ *
+ * This takes the place of the handshake request, the entropy request, and the
+ * handshake acknowledgement for a client holding a session ticket.  The new
+ * shared secret is derived from the ticket's session key and the client key
+ * nonce, and the request must be signed with it.  The ticket is only redeemed
+ * once the signature checks out.  On success, the resume response is written
+ * and the connection proceeds as if the handshake acknowledgement had been
+ * written.
+ *
+ * \param conn      The connection on which the request was read.
+ * \param req       The request packet.
+ * \param size      The size of the request packet.
+ */
+void unauthorized_protocol_service_connection_handshake_resume(
+    unauthorized_protocol_connection_t* conn, const uint8_t* req,
+    size_t size)
+{
+    int retval;
+    uint32_t request_offset;
+    uint32_t protocol_version;
+    uint32_t crypto_suite;
+    uint8_t ticket[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+    const uint8_t* breq = req;
+
+    /* | Handshake resume request packet.                                   | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME             |   4 bytes    | */
+    /* | offset                                              |   4 bytes    | */
+    /* | record:                                             | 176 bytes    | */
+    /* |    protocol_version                                 |   4 bytes    | */
+    /* |    crypto_suite                                     |   4 bytes    | */
+    /* |    entity_id                                        |  16 bytes    | */
+    /* |    ticket                                           |  88 bytes    | */
+    /* |    client key nonce                                 |  32 bytes    | */
+    /* |    client_hmac                                      |  32 bytes    | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    /* verify that the size matches what we expect. */
+    const size_t mac_size = conn->svc->suite.mac_short_opts.mac_size;
+    const size_t signed_size =
+        sizeof(uint32_t) + sizeof(request_offset) + sizeof(protocol_version)
+      + sizeof(crypto_suite) + sizeof(conn->entity_uuid) + sizeof(ticket)
+      + conn->client_key_nonce.size;
+    if (size != signed_size + mac_size)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME,
+            AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_REQUEST, 0, false);
+        return;
+    }
+
+    /* skip the request ID, which the caller has already checked. */
+    breq += sizeof(uint32_t);
+
+    /* read the request offset.  It should be 0x00000000. */
+    memcpy(&request_offset, breq, sizeof(request_offset));
+    breq += sizeof(request_offset);
+
+    /* read the protocol version.  It should be 0x00000001. */
+    memcpy(&protocol_version, breq, sizeof(protocol_version));
+    breq += sizeof(protocol_version);
+
+    /* read the crypto suite.  It should be VCCRYPT_SUITE_VELO_V1. */
+    memcpy(&crypto_suite, breq, sizeof(crypto_suite));
+    breq += sizeof(crypto_suite);
+
+    if (0x00000000 != ntohl(request_offset)
+     || 0x00000001 != ntohl(protocol_version)
+     || VCCRYPT_SUITE_VELO_V1 != ntohl(crypto_suite))
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME,
+            AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_REQUEST, 0, false);
+        return;
+    }
+
+    /* read the entity uuid. */
+    memcpy(conn->entity_uuid, breq, sizeof(conn->entity_uuid));
+    breq += sizeof(conn->entity_uuid);
+
+    /* read the ticket. */
+    memcpy(ticket, breq, sizeof(ticket));
+    breq += sizeof(ticket);
+
+    /* read the client key nonce. */
+    memcpy(conn->client_key_nonce.data, breq, conn->client_key_nonce.size);
+    breq += conn->client_key_nonce.size;
+
+    /* Verify that this is still a valid entity. */
+    if (AGENTD_STATUS_SUCCESS !=
+        unauthorized_protocol_service_get_entity_key(conn))
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME,
+            AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED, 0, false);
+        return;
+    }
+
+    /* create a buffer for the session key. */
+    vccrypt_buffer_t session_key;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+            &conn->svc->suite, &session_key))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return;
+    }
+
+    /* open the ticket.  It is only redeemed once the request is verified, so
+     * that a forged request can't use up another client's ticket. */
+    retval =
+        unauthorized_protocol_service_session_ticket_open(
+            conn->svc, conn->entity_uuid, ticket, &session_key);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME, retval, 0, false);
+        goto cleanup_session_key;
+    }
+
+    /* derive the shared secret for this session. */
+    retval =
+        protocolservice_session_key_derive(
+            &conn->svc->suite, &session_key, conn->client_key_nonce.data,
+            conn->client_key_nonce.size, &conn->shared_secret);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME, retval, 0, false);
+        goto cleanup_session_key;
+    }
+
+    /* create a buffer for the expected client hmac. */
+    vccrypt_buffer_t mac_buffer;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(&mac_buffer, &conn->svc->alloc_opts, mac_size))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        goto cleanup_session_key;
+    }
+
+    /* the client proves that it holds the session key by signing the
+     * request with the derived shared secret. */
+    retval =
+        protocolservice_session_key_derive(
+            &conn->svc->suite, &conn->shared_secret, req, signed_size,
+            &mac_buffer);
+    if (AGENTD_STATUS_SUCCESS != retval
+     || 0 != crypto_memcmp(mac_buffer.data, breq, mac_size))
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME,
+            AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED, 0, false);
+        goto cleanup_mac_buffer;
+    }
+
+    /* redeem the ticket, so that this request can't be replayed. */
+    retval =
+        unauthorized_protocol_service_session_ticket_redeem(
+            conn->svc, ticket);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME, retval, 0, false);
+        goto cleanup_mac_buffer;
+    }
+
+    /* write the resume response and walk state / callbacks. */
+    if (AGENTD_STATUS_SUCCESS !=
+        unauthorized_protocol_service_write_handshake_resume_response(conn))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        goto cleanup_mac_buffer;
+    }
+
+    /* success. */
+
+cleanup_mac_buffer:
+    dispose((disposable_t*)&mac_buffer);
+
+cleanup_session_key:
+    dispose((disposable_t*)&session_key);
+    memset(ticket, 0, sizeof(ticket));
+}
+
+/**
+ * \brief Write the response for a handshake resume request.
+ *
+ * \param conn          The connection for which the response should be written.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - a non-zero return code on failure.
+ */
+static int unauthorized_protocol_service_write_handshake_resume_response(
+    unauthorized_protocol_connection_t* conn)
+{
+    int retval;
+
+    /* | Handshake resume response packet.                                  | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME             |   4 bytes    | */
+    /* | status                                              |   4 bytes    | */
+    /* | offset                                              |   4 bytes    | */
+    /* | server_hmac                                         |  32 bytes    | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    uint32_t header[3] = {
+        htonl(UNAUTH_PROTOCOL_REQ_ID_HANDSHAKE_RESUME),
+        htonl(AGENTD_STATUS_SUCCESS),
+        htonl(0x00U) };
+    const size_t mac_size = conn->svc->suite.mac_short_opts.mac_size;
+
+    /* the server hmac covers the header and the client key nonce. */
+    vccrypt_buffer_t digest;
+    retval =
+        vccrypt_buffer_init(
+            &digest, &conn->svc->alloc_opts,
+            sizeof(header) + conn->client_key_nonce.size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    memcpy(digest.data, header, sizeof(header));
+    memcpy(
+        (uint8_t*)digest.data + sizeof(header), conn->client_key_nonce.data,
+        conn->client_key_nonce.size);
+
+    /* create the response payload buffer. */
+    vccrypt_buffer_t payload;
+    retval =
+        vccrypt_buffer_init(
+            &payload, &conn->svc->alloc_opts, sizeof(header) + mac_size);
+    if (VCCRYPT_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_digest;
+    }
+
+    /* sign the response into the tail of the payload. */
+    memcpy(payload.data, header, sizeof(header));
+    vccrypt_buffer_t mac_buffer = payload;
+    mac_buffer.data = (uint8_t*)payload.data + sizeof(header);
+    mac_buffer.size = mac_size;
+    retval =
+        protocolservice_session_key_derive(
+            &conn->svc->suite, &conn->shared_secret, digest.data, digest.size,
+            &mac_buffer);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_payload;
+    }
+
+    /* write packet to connection. */
+    retval = ipc_write_data_noblock(&conn->ctx, payload.data, payload.size);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_payload;
+    }
+
+    /* the resumed session starts fresh IVs, as after a full handshake. */
+    conn->client_iv = 0x0000000000000001UL;
+    conn->server_iv = 0x8000000000000001UL;
+
+    /* once the response is written, get a dataservice child context just as
+     * after a handshake acknowledgement. */
+    conn->state = UPCS_WRITE_HANDSHAKE_ACK_TO_CLIENT;
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_payload:
+    dispose((disposable_t*)&payload);
+
+cleanup_digest:
+    dispose((disposable_t*)&digest);
+
+done:
+    return retval;
+}
@@ -43,8 +43,10 @@ void unauthorized_protocol_service_connection_read(
             unauthorized_protocol_service_connection_handshake_ack_read(conn);
             break;
 
-        /* we expect to read a command request from the client. */
+        /* we expect to read a command request from the client, possibly
+         * while a response to an earlier request is being written. */
         case APCS_READ_COMMAND_REQ_FROM_CLIENT:
+        case APCS_WRITE_COMMAND_RESP_TO_CLIENT:
             unauthorized_protocol_service_command_read(conn);
             break;
 
@@ -0,0 +1,51 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_connection_watermark.c
+ *
+ * \brief Pause or resume reads from a client whose responses are backed up.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Watermark callback for a client connection.
+ *
+ * While responses to a client are backed up, reads from that client are
+ * paused, so that a client which stops reading responses cannot grow its
+ * write buffer without bound.  Reads stay paused while the data service is
+ * backed up, even once the client catches up.
+ *
+ * \param ctx           The socket context for this watermark callback.
+ * \param above         true if the write buffer crossed the high watermark,
+ *                      false if it drained below the low watermark.
+ * \param user_context  The user context for this callback (expected: a
+ *                      protocol connection).
+ */
+void unauthorized_protocol_service_connection_watermark(
+    ipc_socket_context_t* ctx, bool above, void* user_context)
+{
+    /* get the connection from the user context. */
+    unauthorized_protocol_connection_t* conn =
+        (unauthorized_protocol_connection_t*)user_context;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != ctx);
+    MODEL_ASSERT(NULL != conn);
+
+    /* the data service watermark checks this flag before resuming. */
+    conn->client_backpressure = above;
+
+    if (above)
+    {
+        ipc_pause_read_noblock(ctx);
+    }
+    else if (!conn->svc->dataservice_backpressure)
+    {
+        ipc_resume_read_noblock(ctx);
+    }
+}
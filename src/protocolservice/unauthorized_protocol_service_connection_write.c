@@ -49,6 +49,12 @@ void unauthorized_protocol_service_connection_write(
             ipc_set_writecb_noblock(
                 &conn->ctx, &unauthorized_protocol_service_connection_write,
                 &conn->svc->loop);
+
+            /* keep a streamed block flowing as the client drains it. */
+            if (APCS_STREAM_RESP_TO_CLIENT == conn->state)
+            {
+                unauthorized_protocol_connection_block_stream_continue(conn);
+            }
         }
     }
     else
@@ -76,12 +82,34 @@ void unauthorized_protocol_service_connection_write(
                     conn);
                 return;
 
-            /* after writing a command response to the client, reset. */
+            /* after writing a command response to the client, reset.  If the
+             * pipeline was full or a batch was being collected, pick up any
+             * requests that were buffered in the meantime. */
             case APCS_WRITE_COMMAND_RESP_TO_CLIENT:
+                /* a block stream waiting on earlier responses starts once
+                 * they have all been written. */
+                if (conn->block_stream.active && 0U == conn->pending_count)
+                {
+                    conn->state = APCS_STREAM_RESP_TO_CLIENT;
+                    unauthorized_protocol_connection_block_stream_continue(
+                        conn);
+                    return;
+                }
+
                 conn->state = APCS_READ_COMMAND_REQ_FROM_CLIENT;
-                ipc_set_readcb_noblock(
-                    &conn->ctx, &unauthorized_protocol_service_connection_read,
-                    &conn->svc->loop);
+                if (conn->pending_count + conn->queue_count
+                        < conn->svc->pipeline_window
+                 && 0U == conn->batch_remaining
+                 && !conn->batch_queued)
+                {
+                    unauthorized_protocol_service_command_read(conn);
+                }
+                return;
+
+            /* a streamed block is read from the data service a slice at a
+             * time, as the last slice drains. */
+            case APCS_STREAM_RESP_TO_CLIENT:
+                unauthorized_protocol_connection_block_stream_continue(conn);
                 return;
 
             /* if we are in a forced unauthorized state, close the
@@ -0,0 +1,39 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_dataservice_hangup.c
+ *
+ * \brief Watch the data service socket for hangup while using a ring.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <vpr/parameters.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Handle read events on the data service socket while dataservice
+ * traffic runs over a ring.
+ *
+ * Once bootstrapped, the data service never writes to its socket when a ring
+ * carries its traffic, so any read event on the socket means that the data
+ * service has gone away.  In this case, the protocol service shuts down.
+ *
+ * \param ctx           The socket context for this read callback.
+ * \param event_flags   The event flags that led to this callback being called.
+ * \param user_context  The user context for this callback (expected: a protocol
+ *                      service instance).
+ */
+void unauthorized_protocol_service_dataservice_hangup(
+    ipc_socket_context_t* UNUSED(ctx), int UNUSED(event_flags),
+    void* user_context)
+{
+    /* get the instance from the user context. */
+    unauthorized_protocol_service_instance_t* svc =
+        (unauthorized_protocol_service_instance_t*)user_context;
+
+    /* don't go further if we are already shutting down. */
+    if (svc->force_exit)
+        return;
+
+    unauthorized_protocol_service_exit_event_loop(svc);
+}
@@ -42,6 +42,12 @@ void unauthorized_protocol_service_dataservice_read(
         retval = unauthorized_protocol_service_handle_dataservice_packet(svc);
     } while (AGENTD_STATUS_SUCCESS == retval
              && ipc_socket_readbuffer_size(ctx) > 0);
+
+    /* answered requests make room for queued ones. */
+    if (!svc->force_exit)
+    {
+        unauthorized_protocol_service_schedule(svc);
+    }
 }
 
 /**
@@ -82,6 +88,49 @@ static int unauthorized_protocol_service_handle_dataservice_packet(
     /* decode the method. */
     uint32_t method = ntohl(resp[0]);
 
+    /* a response to a client request is routed to the connection holding the
+     * request that it answers, since child contexts are shared.
+     * Notifications aren't responses, so they don't answer a request. */
+    svc->dataservice_response_conn = NULL;
+    if (DATASERVICE_API_METHOD_LL_CHILD_CONTEXT_CREATE != method
+     && DATASERVICE_API_METHOD_LL_CHILD_CONTEXT_CLOSE != method
+     && DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT != method
+     && DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE != method
+     && resp_size >= 2 * sizeof(uint32_t))
+    {
+        uint32_t child = ntohl(resp[1]);
+        const size_t child_max =
+            sizeof(svc->dataservice_child_map)
+                / sizeof(svc->dataservice_child_map[0]);
+        unauthorized_protocol_child_context_t* cc =
+            (child < child_max) ? svc->dataservice_child_map[child] : NULL;
+        unauthorized_protocol_connection_t* conn =
+            (NULL != cc) ? unauthorized_protocol_child_context_route(cc) : NULL;
+
+        /* this request is no longer in flight. */
+        if (NULL != cc && svc->dataservice_inflight > 0U)
+        {
+            --svc->dataservice_inflight;
+        }
+
+        /* a closing child context is closed once its last response is in. */
+        if (NULL != cc
+         && UPCC_CLOSING == cc->state
+         && cc->request_sequence == cc->response_sequence)
+        {
+            unauthorized_protocol_child_context_close(svc, cc);
+        }
+
+        /* drop responses for requests that are no longer wanted, such as
+         * those outstanding when a connection closed. */
+        if (NULL == conn || UPCS_UNAUTHORIZED == conn->state)
+        {
+            goto cleanup_resp;
+        }
+
+        svc->dataservice_response_conn = conn;
+    }
+
     /* dispatch the method. */
     switch (method)
     {
@@ -133,6 +182,36 @@ static int unauthorized_protocol_service_handle_dataservice_packet(
                 svc, resp, resp_size);
             break;
 
+        /* block notification subscribe response. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE:
+            ups_dispatch_dataservice_response_block_notify_subscribe(
+                svc, resp, resp_size);
+            break;
+
+        /* block commit notification. */
+        case DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT:
+            ups_dispatch_dataservice_notification_block_commit(
+                svc, resp, resp_size);
+            break;
+
+        /* artifact watch response. */
+        case DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH:
+            ups_dispatch_dataservice_response_artifact_watch(
+                svc, resp, resp_size);
+            break;
+
+        /* block certificate read response. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ:
+            ups_dispatch_dataservice_response_block_cert_read(
+                svc, resp, resp_size);
+            break;
+
+        /* artifact update notification. */
+        case DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE:
+            ups_dispatch_dataservice_notification_artifact_update(
+                svc, resp, resp_size);
+            break;
+
         /* unknown method. */
         default:
             /* TODO - if this happens after everything is decoded, log and shut
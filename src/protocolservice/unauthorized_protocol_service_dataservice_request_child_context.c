@@ -1,23 +1,35 @@
 /**
  * \file protocolservice/unauthorized_protocol_service_dataservice_request_child_context.c
  *
- * \brief Send a child context create request to the data service.
+ * \brief Assign a pooled dataservice child context to a connection.
  *
  * \copyright 2020 Velo Payments, Inc.  All rights reserved.
  */
 
 #include <agentd/dataservice/api.h>
+#include <string.h>
 
 #include "unauthorized_protocol_service_private.h"
 
+/* forward decls. */
+static unauthorized_protocol_child_context_t*
+unauthorized_protocol_child_context_find(
+    unauthorized_protocol_service_instance_t* svc,
+    const unauthorized_protocol_connection_t* conn);
+static unauthorized_protocol_child_context_t*
+unauthorized_protocol_child_context_create(
+    unauthorized_protocol_service_instance_t* svc,
+    const unauthorized_protocol_connection_t* conn);
+
 /**
- * \brief Request that a dataservice child context be created.
+ * \brief Assign a pooled dataservice child context to a connection.
  *
- * \param conn      The connection to be assigned a child context when this
- *                  request completes.
+ * \param conn      The connection to be assigned a child context.
  *
- * This connection is pushed to the dataservice context create list, where it
- * will remain until the next dataservice context create request completes.
+ * The connection shares an open child context with the same capabilities if
+ * one has room, and can read commands right away.  Otherwise, a new child
+ * context is requested, and the connection waits on the dataservice context
+ * create list until it is created.
  */
 void unauthorized_protocol_service_dataservice_request_child_context(
     unauthorized_protocol_connection_t* conn)
@@ -25,47 +37,173 @@ void unauthorized_protocol_service_dataservice_request_child_context(
     unauthorized_protocol_service_instance_t* svc =
         (unauthorized_protocol_service_instance_t*)conn->svc;
 
-    /* remove the connection from the connection list. */
-    unauthorized_protocol_connection_remove(
-        &svc->used_connection_head, conn);
-    /* place the connection onto the dataservice connection wait head. */
-    unauthorized_protocol_connection_push_front(
-        &svc->dataservice_context_create_head, conn);
-
-    /* set the client connection state to wait for the child context. */
-    conn->state = APCS_DATASERVICE_CHILD_CONTEXT_WAIT;
-
-    /* TODO - derive bitset from client authorization. */
-    BITCAP_INIT_FALSE(conn->dataservice_caps);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps, DATASERVICE_API_CAP_APP_BLOCK_READ);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps,
-        DATASERVICE_API_CAP_APP_BLOCK_ID_BY_HEIGHT_READ);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CLOSE);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps, DATASERVICE_API_CAP_APP_TRANSACTION_READ);
-    BITCAP_SET_TRUE(
-        conn->dataservice_caps, DATASERVICE_API_CAP_APP_ARTIFACT_READ);
-
-    /*
-     * TODO - we need a way to tie a unique ID (i.e. client UUID) to the client
-     * context to ensure that we can't get a race to escalate privileges.  For
-     * now, clients have 100% access to the API.  THIS IS DEMO ONLY AND NOT
-     * PRODUCTION HARDENED.
-     */
-
-    /* send a child context create request to the dataservice. */
+    /* share a child context if one has room, or else create one. */
+    unauthorized_protocol_child_context_t* cc =
+        unauthorized_protocol_child_context_find(svc, conn);
+    if (NULL == cc)
+    {
+        cc = unauthorized_protocol_child_context_create(svc, conn);
+        if (NULL == cc)
+        {
+            /* TODO - log that the pool is exhausted. */
+            unauthorized_protocol_service_close_connection(conn);
+            return;
+        }
+    }
+
+    /* attach the connection to this child context. */
+    cc->connections[cc->connection_count++] = conn;
+    conn->child_context = cc;
+
+    /* if the child context is still being created, wait for it. */
+    if (UPCC_CREATING == cc->state)
+    {
+        /* remove the connection from the connection list. */
+        unauthorized_protocol_connection_remove(
+            &svc->used_connection_head, conn);
+        /* place the connection onto the dataservice connection wait head. */
+        unauthorized_protocol_connection_push_front(
+            &svc->dataservice_context_create_head, conn);
+
+        /* set the client connection state to wait for the child context. */
+        conn->state = APCS_DATASERVICE_CHILD_CONTEXT_WAIT;
+        return;
+    }
+
+    /* the child context is open, so the connection can read commands. */
+    conn->dataservice_child_context = cc->child;
+    conn->state = APCS_READ_COMMAND_REQ_FROM_CLIENT;
+
+    /* set connection read callback to read request from client. */
+    ipc_set_readcb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_read,
+        &svc->loop);
+}
+
+/**
+ * \brief Find a pooled child context that this connection can share.
+ *
+ * Of the child contexts with the connection's capabilities and room for
+ * another connection, the least shared is chosen.  A child context carrying
+ * notification subscriptions, or one that is closing, is never shared with a
+ * new connection.
+ *
+ * \param svc       The protocol service instance.
+ * \param conn      The connection looking for a child context.
+ *
+ * \returns the child context, or NULL if none can be shared.
+ */
+static unauthorized_protocol_child_context_t*
+unauthorized_protocol_child_context_find(
+    unauthorized_protocol_service_instance_t* svc,
+    const unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_child_context_t* best = NULL;
+
+    for (size_t i = 0; i < svc->num_connections; ++i)
+    {
+        unauthorized_protocol_child_context_t* cc = svc->child_contexts + i;
+
+        if (UPCC_FREE == cc->state
+         || UPCC_CLOSING == cc->state
+         || cc->subscribed
+         || cc->connection_count
+                >= UNAUTHORIZED_PROTOCOL_SERVICE_CHILD_CONTEXT_SHARE_MAX
+         || memcmp(
+                cc->dataservice_caps, conn->dataservice_caps,
+                sizeof(cc->dataservice_caps)))
+        {
+            continue;
+        }
+
+        if (NULL == best || cc->connection_count < best->connection_count)
+        {
+            best = cc;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * \brief Request a new child context with this connection's capabilities.
+ *
+ * A free pool entry is used if there is one.  Otherwise, an idle child context
+ * with no outstanding responses is closed to make room.
+ *
+ * \param svc       The protocol service instance.
+ * \param conn      The connection needing a child context.
+ *
+ * \returns the child context being created, or NULL if the pool is exhausted.
+ */
+static unauthorized_protocol_child_context_t*
+unauthorized_protocol_child_context_create(
+    unauthorized_protocol_service_instance_t* svc,
+    const unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_child_context_t* cc = NULL;
+
+    /* look for a free pool entry, remembering an idle one. */
+    for (size_t i = 0; i < svc->num_connections; ++i)
+    {
+        unauthorized_protocol_child_context_t* candidate =
+            svc->child_contexts + i;
+
+        if (UPCC_FREE == candidate->state)
+        {
+            cc = candidate;
+            break;
+        }
+
+        if (NULL == cc
+         && UPCC_READY == candidate->state
+         && 0U == candidate->connection_count
+         && candidate->request_sequence == candidate->response_sequence)
+        {
+            cc = candidate;
+        }
+    }
+
+    if (NULL == cc)
+    {
+        return NULL;
+    }
+
+    /* close an idle child context to make room. */
+    if (UPCC_READY == cc->state)
+    {
+        unauthorized_protocol_child_context_close(svc, cc);
+    }
+
+    /* set up the pool entry. */
+    memset(cc, 0, sizeof(unauthorized_protocol_child_context_t));
+    cc->state = UPCC_CREATING;
+    cc->child = -1;
+    memcpy(
+        cc->dataservice_caps, conn->dataservice_caps,
+        sizeof(cc->dataservice_caps));
+
+    /* the data service answers create requests in order. */
+    if (NULL == svc->child_context_create_tail)
+    {
+        svc->child_context_create_head = cc;
+    }
+    else
+    {
+        svc->child_context_create_tail->create_next = cc;
+    }
+
+    svc->child_context_create_tail = cc;
+
+    /* send a child context create request to the dataservice, with the
+     * capabilities that the entity table granted this connection's entity. */
     dataservice_api_sendreq_child_context_create(
-        &svc->data, conn->dataservice_caps, sizeof(conn->dataservice_caps));
+        &svc->data, cc->dataservice_caps, sizeof(cc->dataservice_caps));
 
     /* set the write callback for the dataservice socket. */
     ipc_set_writecb_noblock(
         &svc->data, &unauthorized_protocol_service_dataservice_write,
         &svc->loop);
+
+    return cc;
 }
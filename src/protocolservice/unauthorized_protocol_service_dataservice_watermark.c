@@ -0,0 +1,61 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_dataservice_watermark.c
+ *
+ * \brief Apply backpressure from the data service socket to clients.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Watermark callback for the dataservice socket.
+ *
+ * While the dataservice socket is backed up, reads on every client connection
+ * are paused, so that clients cannot queue requests faster than the data
+ * service accepts them.  Connections waiting on a child context are paused and
+ * resumed too.  The pause is kept by the socket, so it carries over when a
+ * connection moves between the open and waiting lists.  A connection whose own
+ * responses are backed up stays paused until its client catches up.
+ *
+ * \param ctx           The socket context for this watermark callback.
+ * \param above         true if the write buffer crossed the high watermark,
+ *                      false if it drained below the low watermark.
+ * \param user_context  The user context for this callback (expected: a protocol
+ *                      service instance).
+ */
+void unauthorized_protocol_service_dataservice_watermark(
+    ipc_socket_context_t* UNUSED(ctx), bool above, void* user_context)
+{
+    /* get the instance from the user context. */
+    unauthorized_protocol_service_instance_t* svc =
+        (unauthorized_protocol_service_instance_t*)user_context;
+
+    /* parameter sanity check. */
+    MODEL_ASSERT(NULL != svc);
+
+    /* new connections check this flag when they are accepted. */
+    svc->dataservice_backpressure = above;
+
+    /* pause or resume every open or waiting client connection. */
+    unauthorized_protocol_connection_t* lists[2] = {
+        svc->used_connection_head, svc->dataservice_context_create_head };
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); ++i)
+    {
+        for (unauthorized_protocol_connection_t* conn = lists[i];
+             NULL != conn; conn = conn->next)
+        {
+            if (above)
+            {
+                ipc_pause_read_noblock(&conn->ctx);
+            }
+            else if (!conn->client_backpressure)
+            {
+                ipc_resume_read_noblock(&conn->ctx);
+            }
+        }
+    }
+}
@@ -23,6 +23,9 @@ void unauthorized_protocol_service_decode_and_dispatch(
     unauthorized_protocol_connection_t* conn, uint32_t request_id,
     uint32_t request_offset, const uint8_t* breq, size_t size)
 {
+    /* remember whether a response is already being written. */
+    unauthorized_protocol_connection_state_t prev_state = conn->state;
+
     /* save the request id. */
     conn->request_id = request_id;
 
@@ -99,9 +102,37 @@ void unauthorized_protocol_service_decode_and_dispatch(
                 conn, request_offset, breq, size);
             break;
 
+        case UNAUTH_PROTOCOL_REQ_ID_BATCH:
+            unauthorized_protocol_service_handle_request_batch(
+                conn, request_offset, breq, size);
+            break;
+
+        case UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET:
+            unauthorized_protocol_service_handle_request_session_ticket_get(
+                conn, request_offset, breq, size);
+            break;
+
+        case UNAUTH_PROTOCOL_REQ_ID_BLOCK_NOTIFY_SUBSCRIBE:
+            unauthorized_protocol_service_handle_request_block_notify_subscribe(
+                conn, request_offset, breq, size);
+            break;
+
+        case UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_WATCH:
+            unauthorized_protocol_service_handle_request_artifact_watch(
+                conn, request_offset, breq, size);
+            break;
+
         /* TODO - replace with valid error code. */
         default:
             unauthorized_protocol_service_error_response(
                 conn, request_id, 8675309, request_offset, true);
     }
+
+    /* a request sent to the data service waits in the pipeline, and the
+     * connection can keep reading requests in the meantime. */
+    if (APCS_READ_COMMAND_RESP_FROM_APP == conn->state)
+    {
+        unauthorized_protocol_connection_request_push(conn);
+        conn->state = prev_state;
+    }
 }
@@ -0,0 +1,404 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_entity_table_load.c
+ *
+ * \brief Load the authorized entity table for the service.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static void unauthorized_protocol_entity_default_caps(
+    unauthorized_protocol_entity_t* entity);
+static bool unauthorized_protocol_entity_parse_line(
+    unauthorized_protocol_entity_t* entity, char* line, bool* blank);
+static bool unauthorized_protocol_entity_parse_hex(
+    uint8_t* out, size_t size, const char* str, bool allow_dashes);
+static bool unauthorized_protocol_entity_parse_cap(
+    unauthorized_protocol_entity_t* entity, const char* cap);
+static bool unauthorized_protocol_entity_parse_weight(
+    unauthorized_protocol_entity_t* entity, const char* weight);
+
+/**
+ * \brief Load the authorized entity table for the service.
+ *
+ * The table holds the bootstrap entity from the environment, along with every
+ * entity listed in the file named by AGENTD_AUTHORIZED_ENTITIES_FILE, if set.
+ * The new table replaces the service's table only if it loads completely, so
+ * a bad file leaves the current entities in place.
+ *
+ * Each line of the file describes one entity as its UUID, its public key in
+ * hex, and an optional list of capabilities, separated by whitespace.  The
+ * capabilities are block_read, transaction_read, transaction_submit, and
+ * artifact_read; an entity without a capability list gets all of them.  The
+ * list can also hold weight=N, which gives the entity's connections N times
+ * the default share of the data service when it is busy.  Blank lines and
+ * anything following a '#' are ignored.  An entity listed more than once takes
+ * its last entry, including the bootstrap entity.
+ *
+ * \param svc           The protocol service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the table could not be
+ *        allocated.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE if the entity
+ *        file could not be read or is malformed.
+ */
+int unauthorized_protocol_service_entity_table_load(
+    unauthorized_protocol_service_instance_t* svc)
+{
+    int retval;
+    FILE* file = NULL;
+    char* line = NULL;
+    size_t line_size = 0U;
+    size_t lines = 0U;
+    unauthorized_protocol_entity_table_t table;
+    unauthorized_protocol_entity_t entity;
+    bool blank;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+
+    /* if an entity file is configured, count its lines to size the table. */
+    const char* path = getenv("AGENTD_AUTHORIZED_ENTITIES_FILE");
+    if (NULL != path)
+    {
+        file = fopen(path, "r");
+        if (NULL == file)
+        {
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE;
+            goto done;
+        }
+
+        while (getline(&line, &line_size, file) >= 0)
+        {
+            ++lines;
+        }
+
+        if (ferror(file))
+        {
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE;
+            goto cleanup_file;
+        }
+
+        rewind(file);
+    }
+
+    /* create a table with room for every line plus the bootstrap entity. */
+    retval = unauthorized_protocol_entity_table_init(&table, lines + 1U);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_file;
+    }
+
+    /* add the bootstrap entity. */
+    MODEL_ASSERT(
+        sizeof(entity.public_key) == svc->authorized_entity_pubkey.size);
+    memset(&entity, 0, sizeof(entity));
+    memcpy(
+        entity.entity_uuid, svc->authorized_entity_id,
+        sizeof(entity.entity_uuid));
+    memcpy(
+        entity.public_key, svc->authorized_entity_pubkey.data,
+        sizeof(entity.public_key));
+    unauthorized_protocol_entity_default_caps(&entity);
+    entity.weight = 1U;
+    retval = unauthorized_protocol_entity_table_insert(&table, &entity);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_table;
+    }
+
+    /* add each entity in the file. */
+    while (NULL != file && getline(&line, &line_size, file) >= 0)
+    {
+        if (!unauthorized_protocol_entity_parse_line(&entity, line, &blank))
+        {
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE;
+            goto cleanup_table;
+        }
+
+        if (blank)
+        {
+            continue;
+        }
+
+        retval = unauthorized_protocol_entity_table_insert(&table, &entity);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            goto cleanup_table;
+        }
+    }
+
+    if (NULL != file && ferror(file))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE;
+        goto cleanup_table;
+    }
+
+    /* the new table replaces the old one. */
+    if (NULL != svc->entities.hdr.dispose)
+    {
+        dispose((disposable_t*)&svc->entities);
+    }
+
+    memcpy(&svc->entities, &table, sizeof(table));
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto cleanup_entity;
+
+cleanup_table:
+    dispose((disposable_t*)&table);
+
+cleanup_entity:
+    memset(&entity, 0, sizeof(entity));
+
+cleanup_file:
+    if (NULL != file)
+    {
+        fclose(file);
+    }
+
+    free(line);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Grant an entity every capability that a client can be given.
+ *
+ * \param entity        The entity to update.
+ */
+static void unauthorized_protocol_entity_default_caps(
+    unauthorized_protocol_entity_t* entity)
+{
+    BITCAP_INIT_FALSE(entity->dataservice_caps);
+    unauthorized_protocol_entity_parse_cap(entity, "block_read");
+    unauthorized_protocol_entity_parse_cap(entity, "transaction_read");
+    unauthorized_protocol_entity_parse_cap(entity, "transaction_submit");
+    unauthorized_protocol_entity_parse_cap(entity, "artifact_read");
+}
+
+/**
+ * \brief Parse a line of the entity file.
+ *
+ * \param entity        The entity to populate from this line.
+ * \param line          The line to parse, which is modified by parsing.
+ * \param blank         Set to true if this line holds no entity.
+ *
+ * \returns true if the line is well formed, and false otherwise.
+ */
+static bool unauthorized_protocol_entity_parse_line(
+    unauthorized_protocol_entity_t* entity, char* line, bool* blank)
+{
+    char* save = NULL;
+    const char* delim = " \t\r\n";
+
+    /* ignore comments. */
+    char* comment = strchr(line, '#');
+    if (NULL != comment)
+    {
+        *comment = 0;
+    }
+
+    /* the first token is the entity UUID. */
+    char* uuid = strtok_r(line, delim, &save);
+    if (NULL == uuid)
+    {
+        *blank = true;
+        return true;
+    }
+
+    *blank = false;
+    memset(entity, 0, sizeof(unauthorized_protocol_entity_t));
+    if (!unauthorized_protocol_entity_parse_hex(
+            entity->entity_uuid, sizeof(entity->entity_uuid), uuid, true))
+    {
+        return false;
+    }
+
+    /* the second token is the entity public key. */
+    char* pubkey = strtok_r(NULL, delim, &save);
+    if (NULL == pubkey
+     || !unauthorized_protocol_entity_parse_hex(
+            entity->public_key, sizeof(entity->public_key), pubkey, false))
+    {
+        return false;
+    }
+
+    /* the remaining tokens are capabilities, or the scheduling weight. */
+    bool has_caps = false;
+    entity->weight = 1U;
+    BITCAP_INIT_FALSE(entity->dataservice_caps);
+    for (char* cap = strtok_r(NULL, delim, &save); NULL != cap;
+         cap = strtok_r(NULL, delim, &save))
+    {
+        if (!strncmp(cap, "weight=", 7))
+        {
+            if (!unauthorized_protocol_entity_parse_weight(entity, cap + 7))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        if (!unauthorized_protocol_entity_parse_cap(entity, cap))
+        {
+            return false;
+        }
+
+        has_caps = true;
+    }
+
+    /* an entity without a capability list gets all of them. */
+    if (!has_caps)
+    {
+        unauthorized_protocol_entity_default_caps(entity);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Parse an entity's scheduling weight.
+ *
+ * \param entity        The entity to update.
+ * \param weight        The weight, as a decimal string.
+ *
+ * \returns true if the weight is a number from 1 to
+ * UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_WEIGHT_MAX, and false otherwise.
+ */
+static bool unauthorized_protocol_entity_parse_weight(
+    unauthorized_protocol_entity_t* entity, const char* weight)
+{
+    char* end = NULL;
+
+    if (!isdigit((unsigned char)*weight))
+    {
+        return false;
+    }
+
+    unsigned long value = strtoul(weight, &end, 10);
+    if (0 != *end
+     || value < 1UL
+     || value > UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_WEIGHT_MAX)
+    {
+        return false;
+    }
+
+    entity->weight = (uint32_t)value;
+
+    return true;
+}
+
+/**
+ * \brief Parse a hex string of exactly the given size.
+ *
+ * \param out           The buffer to receive the parsed bytes.
+ * \param size          The number of bytes expected.
+ * \param str           The string to parse.
+ * \param allow_dashes  Whether dashes, as found in a UUID, are skipped.
+ *
+ * \returns true if the string is well formed, and false otherwise.
+ */
+static bool unauthorized_protocol_entity_parse_hex(
+    uint8_t* out, size_t size, const char* str, bool allow_dashes)
+{
+    size_t digits = 0U;
+
+    for (; 0 != *str; ++str)
+    {
+        if (allow_dashes && '-' == *str)
+        {
+            continue;
+        }
+
+        if (!isxdigit((unsigned char)*str) || digits >= 2U * size)
+        {
+            return false;
+        }
+
+        uint8_t nibble =
+            isdigit((unsigned char)*str)
+                ? (uint8_t)(*str - '0')
+                : (uint8_t)(tolower((unsigned char)*str) - 'a' + 10);
+
+        if (0U == digits % 2U)
+        {
+            out[digits / 2U] = (uint8_t)(nibble << 4);
+        }
+        else
+        {
+            out[digits / 2U] |= nibble;
+        }
+
+        ++digits;
+    }
+
+    return 2U * size == digits;
+}
+
+/**
+ * \brief Grant an entity the data service capabilities behind the named
+ * client capability.
+ *
+ * Every entity can close its own child context.
+ *
+ * \param entity        The entity to update.
+ * \param cap           The name of the client capability.
+ *
+ * \returns true if the capability name is known, and false otherwise.
+ */
+static bool unauthorized_protocol_entity_parse_cap(
+    unauthorized_protocol_entity_t* entity, const char* cap)
+{
+    if (!strcmp(cap, "block_read"))
+    {
+        BITCAP_SET_TRUE(
+            entity->dataservice_caps,
+            DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
+        BITCAP_SET_TRUE(
+            entity->dataservice_caps, DATASERVICE_API_CAP_APP_BLOCK_READ);
+        BITCAP_SET_TRUE(
+            entity->dataservice_caps,
+            DATASERVICE_API_CAP_APP_BLOCK_ID_BY_HEIGHT_READ);
+    }
+    else if (!strcmp(cap, "transaction_read"))
+    {
+        BITCAP_SET_TRUE(
+            entity->dataservice_caps,
+            DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+    }
+    else if (!strcmp(cap, "transaction_submit"))
+    {
+        BITCAP_SET_TRUE(
+            entity->dataservice_caps,
+            DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    }
+    else if (!strcmp(cap, "artifact_read"))
+    {
+        BITCAP_SET_TRUE(
+            entity->dataservice_caps, DATASERVICE_API_CAP_APP_ARTIFACT_READ);
+    }
+    else
+    {
+        return false;
+    }
+
+    BITCAP_SET_TRUE(
+        entity->dataservice_caps, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CLOSE);
+
+    return true;
+}
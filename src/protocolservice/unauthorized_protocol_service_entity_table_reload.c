@@ -0,0 +1,34 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_entity_table_reload.c
+ *
+ * \brief Reload the authorized entity table when the reload signal is caught.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <vpr/parameters.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Reload the authorized entity table when the reload signal is caught.
+ *
+ * Connections that have already been authorized keep the capabilities that
+ * they were granted.
+ *
+ * \param sig           The signal that was caught.
+ * \param user_context  The protocol service instance.
+ */
+void unauthorized_protocol_service_entity_table_reload(
+    int UNUSED(sig), void* user_context)
+{
+    unauthorized_protocol_service_instance_t* svc =
+        (unauthorized_protocol_service_instance_t*)user_context;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+
+    /* on failure, the current table stays in place. */
+    (void)unauthorized_protocol_service_entity_table_load(svc);
+}
@@ -0,0 +1,64 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_entropy_pool_draw.c
+ *
+ * \brief Fill a connection's server nonces from the local entropy pool.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Fill a connection's server nonces from the local entropy pool.
+ *
+ * Drawing from the pool lets a handshake proceed without a round trip to the
+ * random service.  Bytes drawn from the pool are scrubbed from it, and the pool
+ * is topped up once it drops below its low watermark.
+ *
+ * \param conn          The connection for which the nonces are drawn.
+ *
+ * \returns true if the nonces were filled, or false if the pool does not hold
+ * enough entropy, in which case the caller should fall back to
+ * \ref unauthorized_protocol_service_write_entropy_request().
+ */
+bool unauthorized_protocol_service_entropy_pool_draw(
+    unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+    bool drawn = false;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+
+    const size_t needed =
+        conn->server_key_nonce.size + conn->server_challenge_nonce.size;
+    if (svc->entropy_pool_size >= needed)
+    {
+        /* take the bytes from the end of the pool. */
+        svc->entropy_pool_size -= needed;
+        uint8_t* bytes = svc->entropy_pool + svc->entropy_pool_size;
+
+        memcpy(
+            conn->server_key_nonce.data, bytes, conn->server_key_nonce.size);
+        memcpy(
+            conn->server_challenge_nonce.data,
+            bytes + conn->server_key_nonce.size,
+            conn->server_challenge_nonce.size);
+
+        /* never hand out the same bytes twice. */
+        memset(bytes, 0, needed);
+        drawn = true;
+    }
+
+    /* top up the pool in the background once it runs low.  A failed refill
+     * only means that later handshakes ask the random service directly. */
+    if (svc->entropy_pool_size
+            < UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_LOW_WATERMARK)
+    {
+        unauthorized_protocol_service_entropy_pool_refill(svc);
+    }
+
+    return drawn;
+}
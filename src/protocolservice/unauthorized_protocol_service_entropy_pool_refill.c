@@ -0,0 +1,70 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_entropy_pool_refill.c
+ *
+ * \brief Request enough random bytes to fill the local entropy pool.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/randomservice.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Request enough random bytes to fill the local entropy pool.
+ *
+ * Requests are only written for the space in the pool that isn't already
+ * covered by a pending refill.
+ *
+ * \param svc           The protocol service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_PRNG_REQUEST_FAILURE if a refill request
+ *        could not be written.
+ */
+int unauthorized_protocol_service_entropy_pool_refill(
+    unauthorized_protocol_service_instance_t* svc)
+{
+    bool written = false;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+
+    /* request refills until the pool would be full. */
+    while (svc->entropy_pool_size
+                + (svc->entropy_refills_pending + 1)
+                    * UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_REFILL_SIZE
+            <= UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_SIZE)
+    {
+        /* TODO - replace with random API method. */
+        uint32_t payload[3] = {
+            htonl(RANDOMSERVICE_API_METHOD_GET_RANDOM_BYTES),
+            htonl(UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_OFFSET),
+            htonl(UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_REFILL_SIZE)
+        };
+
+        /* attempt to write the request payload to the random socket. */
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_write_data_noblock(&svc->random, payload, sizeof(payload)))
+        {
+            return AGENTD_ERROR_PROTOCOLSERVICE_PRNG_REQUEST_FAILURE;
+        }
+
+        ++svc->entropy_refills_pending;
+        written = true;
+    }
+
+    /* set the write callback for the random socket. */
+    if (written)
+    {
+        ipc_set_writecb_noblock(
+            &svc->random, &unauthorized_protocol_service_random_write,
+            &svc->loop);
+    }
+
+    /* success. */
+    return AGENTD_STATUS_SUCCESS;
+}
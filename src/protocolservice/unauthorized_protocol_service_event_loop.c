@@ -21,6 +21,10 @@
  *                      listens for connections on this socket.
  * \param datasock      The data service socket.  The protocol service
  *                      communicates with the dataservice using this socket.
+ * \param ring          Optional shared-memory ring to the data service, or
+ *                      NULL.  When set, dataservice requests travel over this
+ *                      ring, and the data service socket is only watched for
+ *                      hangup.
  * \param logsock       The logging service socket.  The protocol service logs
  *                      on this socket.
  *
@@ -34,9 +38,14 @@
  *            the protocol service socket to the event loop failed.
  *          - AGENTD_ERROR_PROTOCOLSERVICE_IPC_EVENT_LOOP_RUN_FAILURE if running
  *            the protocol service event loop failed.
+ *          - AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID if a configured
+ *            watermark is malformed or out of range.
+ *          - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the data service watermarks
+ *            could not be set.
  */
 int unauthorized_protocol_service_event_loop(
-    int randomsock, int protosock, int datasock, int UNUSED(logsock))
+    int randomsock, int protosock, int datasock,
+    const ipc_ring_descriptors_t* ring, int UNUSED(logsock))
 {
     int retval = 0;
     unauthorized_protocol_service_instance_t inst;
@@ -50,7 +59,7 @@ int unauthorized_protocol_service_event_loop(
     /* TODO - get the number of connections from config. */
     retval =
         unauthorized_protocol_service_instance_init(
-            &inst, randomsock, datasock, protosock, 1000);
+            &inst, randomsock, datasock, ring, protosock, 1000);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         goto done;
@@ -67,6 +76,22 @@ int unauthorized_protocol_service_event_loop(
         goto cleanup_inst;
     }
 
+    /* batch requests to the random and data services into a single write per
+     * event loop iteration. */
+    ipc_set_cork_noblock(&inst.random, true);
+    ipc_set_cork_noblock(&inst.data, true);
+
+    /* stop reading client requests while the data service is backed up. */
+    retval =
+        ipc_set_watermarks_noblock(
+            &inst.data, inst.dataservice_low_watermark,
+            inst.dataservice_high_watermark,
+            &unauthorized_protocol_service_dataservice_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_inst;
+    }
+
     /* set the read callback for the random socket. */
     ipc_set_readcb_noblock(
         &inst.random, &unauthorized_protocol_service_random_read, NULL);
@@ -78,6 +103,15 @@ int unauthorized_protocol_service_event_loop(
         goto cleanup_inst;
     }
 
+    /* start filling the entropy pool so that handshakes don't have to wait
+     * on the random service. */
+    if (AGENTD_STATUS_SUCCESS !=
+        unauthorized_protocol_service_entropy_pool_refill(&inst))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_PRNG_REQUEST_FAILURE;
+        goto cleanup_inst;
+    }
+
     /* set the read callback for the dataservice socket. */
     ipc_set_readcb_noblock(
         &inst.data, &unauthorized_protocol_service_dataservice_read, NULL);
@@ -89,6 +123,21 @@ int unauthorized_protocol_service_event_loop(
         goto cleanup_inst;
     }
 
+    /* with a ring, the data service socket only tells us about hangups. */
+    if (inst.data_ring)
+    {
+        ipc_set_readcb_noblock(
+            &inst.data_socket,
+            &unauthorized_protocol_service_dataservice_hangup, NULL);
+
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_event_loop_add(&inst.loop, &inst.data_socket))
+        {
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_IPC_EVENT_LOOP_ADD_FAILURE;
+            goto cleanup_inst;
+        }
+    }
+
     /* run the ipc event loop. */
     if (AGENTD_STATUS_SUCCESS != ipc_event_loop_run(&inst.loop))
     {
@@ -8,7 +8,6 @@
 
 #include <agentd/status_codes.h>
 #include <stddef.h>
-#include <vccrypt/compare.h>
 
 #include "unauthorized_protocol_service_private.h"
 
@@ -16,28 +15,43 @@
  * \brief Get the entity key associated with the data read during a handshake
  * request.
  *
+ * On success, the entity's public key, capabilities, and scheduling weight
+ * are copied to the connection.
+ *
  * \param conn          The connection for which the entity key should be
  *                      resolved.
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - a non-zero return code on failure.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED if the entity is not in
+ *        the authorized entity table.
  */
 int unauthorized_protocol_service_get_entity_key(
     unauthorized_protocol_connection_t* conn)
 {
     /* verify that the entity id is authorized. */
-    /* TODO - this should perform a database lookup. */
-    if (0 != crypto_memcmp(conn->entity_uuid, conn->svc->authorized_entity_id, 16))
+    const unauthorized_protocol_entity_t* entity =
+        unauthorized_protocol_entity_table_find(
+            &conn->svc->entities, conn->entity_uuid);
+    if (NULL == entity
+     || sizeof(entity->public_key) != conn->entity_public_key.size)
     {
-        return 1;
+        return AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED;
     }
 
     /* the entity id is valid, so copy the entity public key. */
     memcpy(
-        conn->entity_public_key.data, conn->svc->authorized_entity_pubkey.data,
+        conn->entity_public_key.data, entity->public_key,
         conn->entity_public_key.size);
 
+    /* the connection gets this entity's capabilities. */
+    memcpy(
+        conn->dataservice_caps, entity->dataservice_caps,
+        sizeof(conn->dataservice_caps));
+
+    /* the connection is scheduled with this entity's weight. */
+    conn->schedule_weight = entity->weight;
+
     /* success */
     return AGENTD_STATUS_SUCCESS;
 }
@@ -0,0 +1,79 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_handle_request_artifact_watch.c
+ *
+ * \brief Handle the artifact watch request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/api.h>
+#include <agentd/status_codes.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Handle an artifact_watch request.
+ *
+ * \param conn              The connection making this request.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_artifact_watch(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* breq, size_t size)
+{
+    int retval;
+
+    /* the request is a non-empty list of artifact ids. */
+    if (0 == size || 0 != size % 16)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_WATCH,
+            AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_REQUEST,
+            request_offset, true);
+        return;
+    }
+
+    /* the child context is shared, so remember which artifacts this
+     * connection watches. */
+    retval =
+        unauthorized_protocol_connection_artifact_watch_add(
+            conn, breq, size / 16);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_WATCH, retval,
+            request_offset, true);
+        return;
+    }
+
+    /* save the request offset. */
+    conn->current_request_offset = request_offset;
+
+    /* wait on the response from the "app" (dataservice) */
+    conn->state = APCS_READ_COMMAND_RESP_FROM_APP;
+
+    /* write the request to the dataservice using our child context. */
+    retval =
+        dataservice_api_sendreq_artifact_watch(
+            &conn->svc->data, conn->dataservice_child_context, breq,
+            size / 16);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_WATCH,
+            retval,
+            request_offset, true);
+        return;
+    }
+
+    /* the watches belong to the child context, so it can't be shared with
+     * new connections. */
+    conn->child_context->subscribed = true;
+
+    /* set the write callback for the dataservice socket. */
+    ipc_set_writecb_noblock(
+        &conn->svc->data, &unauthorized_protocol_service_dataservice_write,
+        &conn->svc->loop);
+}
@@ -0,0 +1,182 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_handle_request_batch.c
+ *
+ * \brief Handle a batch of sub-requests carried in a single request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static bool unauthorized_protocol_service_batch_next(
+    const uint8_t** breq, size_t* size, uint32_t* request_id,
+    uint32_t* request_offset, const uint8_t** body, size_t* body_size);
+
+/**
+ * \brief Handle a batch request.
+ *
+ * The batch body is a sequence of sub-requests, each prefixed by its size as a
+ * 32-bit network order value.  A sub-request is laid out just like a request
+ * packet: request ID, request offset, then the request body.
+ *
+ * Each sub-request is dispatched as if it had arrived on its own, and the
+ * responses are collected into a single batch response.  The batch response
+ * starts with the batch request ID, status, and offset, followed by each
+ * sub-response prefixed by its size.  Every sub-response carries its own
+ * request ID and offset, so that the client can match them to its
+ * sub-requests.
+ *
+ * \param conn              The connection.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_batch(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* breq, size_t size)
+{
+    const uint8_t* pos;
+    size_t remaining;
+    uint32_t request_id;
+    uint32_t sub_offset;
+    const uint8_t* body;
+    size_t body_size;
+    size_t count = 0U;
+
+    /* save the request offset. */
+    conn->current_request_offset = request_offset;
+
+    /* only one batch can be outstanding at a time. */
+    if (conn->batch_remaining > 0U)
+    {
+        goto malformed_batch;
+    }
+
+    /* verify every sub-request before dispatching any of them. */
+    pos = breq;
+    remaining = size;
+    while (remaining > 0U)
+    {
+        if (!unauthorized_protocol_service_batch_next(
+                &pos, &remaining, &request_id, &sub_offset, &body, &body_size)
+         || UNAUTH_PROTOCOL_REQ_ID_BATCH == request_id
+         || ++count > UNAUTHORIZED_PROTOCOL_SERVICE_BATCH_MAX)
+        {
+            goto malformed_batch;
+        }
+    }
+
+    /* an empty batch is an error. */
+    if (0U == count)
+    {
+        goto malformed_batch;
+    }
+
+    /* start the batch response with the batch header. */
+    const size_t header_size = 3 * sizeof(uint32_t);
+    conn->batch_buffer = (uint8_t*)malloc(header_size);
+    if (NULL == conn->batch_buffer)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_BATCH,
+            AGENTD_ERROR_GENERAL_OUT_OF_MEMORY, request_offset, true);
+        return;
+    }
+
+    uint32_t header[3] = {
+        htonl(UNAUTH_PROTOCOL_REQ_ID_BATCH),
+        htonl(AGENTD_STATUS_SUCCESS),
+        htonl(request_offset) };
+    memcpy(conn->batch_buffer, header, header_size);
+    conn->batch_size = header_size;
+    conn->batch_capacity = header_size;
+    conn->batch_remaining = count;
+
+    /* dispatch each sub-request as part of this batch. */
+    pos = breq;
+    remaining = size;
+    while (remaining > 0U)
+    {
+        unauthorized_protocol_service_batch_next(
+            &pos, &remaining, &request_id, &sub_offset, &body, &body_size);
+
+        conn->current_request_batched = true;
+        unauthorized_protocol_service_decode_and_dispatch(
+            conn, request_id, sub_offset, body, body_size);
+        conn->current_request_batched = false;
+
+        /* stop if the sub-request closed the connection or failed. */
+        if (APCS_READ_COMMAND_REQ_FROM_CLIENT != conn->state
+         && APCS_WRITE_COMMAND_RESP_TO_CLIENT != conn->state)
+        {
+            return;
+        }
+    }
+
+    return;
+
+malformed_batch:
+    unauthorized_protocol_service_error_response(
+        conn, UNAUTH_PROTOCOL_REQ_ID_BATCH,
+        AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_BATCH, request_offset, true);
+}
+
+/**
+ * \brief Decode the next sub-request in a batch.
+ *
+ * \param breq              Pointer to the batch bytestream, advanced past the
+ *                          sub-request on success.
+ * \param size              Pointer to the remaining batch size, reduced by the
+ *                          size of the sub-request on success.
+ * \param request_id        Pointer to receive the sub-request ID.
+ * \param request_offset    Pointer to receive the sub-request offset.
+ * \param body              Pointer to receive the sub-request body.
+ * \param body_size         Pointer to receive the sub-request body size.
+ *
+ * \returns true if a well-formed sub-request was decoded, and false otherwise.
+ */
+static bool unauthorized_protocol_service_batch_next(
+    const uint8_t** breq, size_t* size, uint32_t* request_id,
+    uint32_t* request_offset, const uint8_t** body, size_t* body_size)
+{
+    uint32_t net_size;
+    uint32_t net_request_id;
+    uint32_t net_request_offset;
+
+    /* read the sub-request size. */
+    if (*size < sizeof(net_size))
+    {
+        return false;
+    }
+
+    memcpy(&net_size, *breq, sizeof(net_size));
+    size_t sub_size = ntohl(net_size);
+
+    /* the sub-request must hold an ID and offset, and fit in the batch. */
+    if (sub_size < sizeof(net_request_id) + sizeof(net_request_offset)
+     || sub_size > *size - sizeof(net_size))
+    {
+        return false;
+    }
+
+    const uint8_t* sub = *breq + sizeof(net_size);
+    memcpy(&net_request_id, sub, sizeof(net_request_id));
+    memcpy(
+        &net_request_offset, sub + sizeof(net_request_id),
+        sizeof(net_request_offset));
+
+    *request_id = ntohl(net_request_id);
+    *request_offset = ntohl(net_request_offset);
+    *body = sub + sizeof(net_request_id) + sizeof(net_request_offset);
+    *body_size =
+        sub_size - sizeof(net_request_id) - sizeof(net_request_offset);
+
+    /* advance past this sub-request. */
+    *breq = sub + sub_size;
+    *size -= sizeof(net_size) + sub_size;
+
+    return true;
+}
@@ -46,18 +46,42 @@ void unauthorized_protocol_service_handle_request_block_by_id_get(
     breq += id_size;
     size -= id_size;
 
+    /* a cached block is answered without asking the dataservice, as long as
+     * this connection could have read it from the dataservice. */
+    if (BITCAP_ISSET(
+            conn->dataservice_caps, DATASERVICE_API_CAP_APP_BLOCK_READ)
+     && unauthorized_protocol_service_response_cache_write(
+            conn, UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET,
+            request_offset, block_id))
+    {
+        goto cleanup_ids;
+    }
+
     /* save the request offset. */
     conn->current_request_offset = request_offset;
 
     /* wait on the response from the "app" (dataservice) */
     conn->state = APCS_READ_COMMAND_RESP_FROM_APP;
 
-    /* write the request to the dataservice using our child context. */
+    /* write the request to the dataservice using our child context.  A batch
+     * response is a single packet, so a batched request reads the whole
+     * block.  Otherwise, the first slice of the certificate is read, and a
+     * larger certificate is streamed to the client a slice at a time. */
     /* TODO - this needs to go to the application service. */
-    retval =
-        dataservice_api_sendreq_block_get(
-            &conn->svc->data, conn->dataservice_child_context, block_id,
-            true);
+    if (conn->current_request_batched)
+    {
+        retval =
+            dataservice_api_sendreq_block_get(
+                &conn->svc->data, conn->dataservice_child_context, block_id,
+                true);
+    }
+    else
+    {
+        retval =
+            dataservice_api_sendreq_block_cert_read(
+                &conn->svc->data, conn->dataservice_child_context, block_id,
+                0U, IPC_STREAM_MAX_CHUNK_SIZE);
+    }
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         unauthorized_protocol_service_error_response(
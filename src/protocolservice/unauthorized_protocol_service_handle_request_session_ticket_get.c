@@ -0,0 +1,91 @@
+/**
+ * \file
+ * protocolservice/unauthorized_protocol_service_handle_request_session_ticket_get.c
+ *
+ * \brief Handle a session ticket get request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <vpr/parameters.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Handle a session ticket get request.
+ *
+ * \param conn              The connection.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_session_ticket_get(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* UNUSED(breq), size_t size)
+{
+    int retval;
+
+    /* | Session ticket get response packet.                                | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | DATA                                                | SIZE         | */
+    /* | --------------------------------------------------- | ------------ | */
+    /* | UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET           |   4 bytes    | */
+    /* | status                                              |   4 bytes    | */
+    /* | offset                                              |   4 bytes    | */
+    /* | ticket                                              |  88 bytes    | */
+    /* | --------------------------------------------------- | ------------ | */
+
+    /* this request has no body. */
+    if (0U != size)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET,
+            AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_REQUEST, request_offset,
+            true);
+        return;
+    }
+
+    /* issue a ticket for this session. */
+    uint8_t ticket[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+    retval = unauthorized_protocol_service_session_ticket_issue(conn, ticket);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET, retval,
+            request_offset, true);
+        return;
+    }
+
+    /* build the payload. */
+    uint8_t payload[3 * sizeof(uint32_t) + sizeof(ticket)];
+    uint32_t header[3] = {
+        htonl(UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET),
+        htonl(AGENTD_STATUS_SUCCESS),
+        htonl(request_offset) };
+    memcpy(payload, header, sizeof(header));
+    memcpy(payload + sizeof(header), ticket, sizeof(ticket));
+
+    /* write the response. */
+    retval =
+        unauthorized_protocol_connection_write_response(
+            conn, payload, sizeof(payload));
+
+    /* the ticket is only needed on the wire. */
+    memset(payload, 0, sizeof(payload));
+    memset(ticket, 0, sizeof(ticket));
+
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return;
+    }
+
+    /* evolve connection state. */
+    conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
+
+    /* set the write callback for the protocol socket. */
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+}
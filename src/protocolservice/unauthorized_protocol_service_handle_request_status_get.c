@@ -7,7 +7,9 @@
  */
 
 #include <agentd/dataservice/api.h>
+#include <agentd/inet.h>
 #include <agentd/status_codes.h>
+#include <string.h>
 #include <vpr/parameters.h>
 
 #include "unauthorized_protocol_service_private.h"
@@ -15,6 +17,9 @@
 /**
  * \brief Handle a status get request.
  *
+ * The response carries the response cache hit and miss counts, followed by
+ * the scheduler's queue depth, in-flight count, and request wait times.
+ *
  * \param conn              The connection.
  * \param request_offset    The offset of the request.
  * \param breq              The bytestream of the request.
@@ -26,26 +31,36 @@ void unauthorized_protocol_service_handle_request_status_get(
 {
     int retval = AGENTD_STATUS_SUCCESS;
 
-    /* build the payload. */
-    uint32_t payload[3] = {
-        htonl(UNAUTH_PROTOCOL_REQ_ID_STATUS_GET), 
+    /* build the payload header. */
+    uint32_t header[3] = {
+        htonl(UNAUTH_PROTOCOL_REQ_ID_STATUS_GET),
         htonl(retval),
         htonl(request_offset) };
 
+    /* the service counters follow the header. */
+    uint64_t counters[7] = {
+        htonll(conn->svc->response_cache.hits),
+        htonll(conn->svc->response_cache.misses),
+        htonll(conn->svc->schedule_queued),
+        htonll(conn->svc->dataservice_inflight),
+        htonll(conn->svc->schedule_dispatched),
+        htonll(conn->svc->schedule_wait_total_usec),
+        htonll(conn->svc->schedule_wait_max_usec) };
+
+    uint8_t payload[sizeof(header) + sizeof(counters)];
+    memcpy(payload, header, sizeof(header));
+    memcpy(payload + sizeof(header), counters, sizeof(counters));
+
     /* write the response. */
     retval =
-        ipc_write_authed_data_noblock(
-            &conn->ctx, conn->server_iv, payload, sizeof(payload),
-            &conn->svc->suite, &conn->shared_secret);
+        unauthorized_protocol_connection_write_response(
+            conn, payload, sizeof(payload));
     if (AGENTD_STATUS_SUCCESS != retval)
     {
         unauthorized_protocol_service_close_connection(conn);
         return;
     }
 
-    /* update the server iv. */
-    ++conn->server_iv;
-
     /* evolve connection state. */
     conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
 
@@ -46,6 +46,17 @@ void unauthorized_protocol_service_handle_request_transaction_by_id_get(
     breq += id_size;
     size -= id_size;
 
+    /* a cached transaction is answered without asking the dataservice, as
+     * long as this connection could have read it from the dataservice. */
+    if (BITCAP_ISSET(
+            conn->dataservice_caps, DATASERVICE_API_CAP_APP_TRANSACTION_READ)
+     && unauthorized_protocol_service_response_cache_write(
+            conn, UNAUTH_PROTOCOL_REQ_ID_TRANSACTION_BY_ID_GET,
+            request_offset, txn_id))
+    {
+        goto cleanup_ids;
+    }
+
     /* save the request offset. */
     conn->current_request_offset = request_offset;
 
@@ -12,6 +12,7 @@
 #include <ctype.h>
 #include <signal.h>
 #include <string.h>
+#include <unistd.h>
 #include <vpr/allocator/malloc_allocator.h>
 #include <vpr/parameters.h>
 
@@ -32,6 +33,10 @@ static int convert_hexstring(
  * \param inst          The service instance to initialize.
  * \param random        The random socket to use for this instance.
  * \param data          The dataservice socket to use for this instance.
+ * \param ring          Optional shared-memory ring to the dataservice, or
+ *                      NULL.  When set, dataservice requests use the
+ *                      left-hand side of this ring instead of the socket.
+ *                      The instance takes ownership of these descriptors.
  * \param proto         The protocol socket to use for this instance.
  * \param max_socks     The maximum number of socket connections to accept.
  *
@@ -39,7 +44,7 @@ static int convert_hexstring(
  */
 int unauthorized_protocol_service_instance_init(
     unauthorized_protocol_service_instance_t* inst, int random, int data,
-    int proto, size_t max_socks)
+    const ipc_ring_descriptors_t* ring, int proto, size_t max_socks)
 {
     int retval = AGENTD_STATUS_SUCCESS;
 
@@ -54,6 +59,14 @@ int unauthorized_protocol_service_instance_init(
     memset(inst, 0, sizeof(unauthorized_protocol_service_instance_t));
     inst->hdr.dispose = &unauthorized_protocol_service_instance_dispose;
 
+    /* read the pipeline window and watermarks, which may be tuned from the
+     * environment. */
+    retval = unauthorized_protocol_service_settings_read(inst);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
     /* create the allocator for this instance. */
     malloc_allocator_options_init(&inst->alloc_opts);
 
@@ -103,11 +116,25 @@ int unauthorized_protocol_service_instance_init(
         goto cleanup_authorized_entity_pubkey_buffer;
     }
 
+    /* derive the session ticket key from the agent private key. */
+    retval = unauthorized_protocol_service_session_ticket_key_init(inst);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_authorized_entity_pubkey_buffer;
+    }
+
+    /* load the authorized entity table. */
+    retval = unauthorized_protocol_service_entity_table_load(inst);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_session_tickets;
+    }
+
     /* set the protocol socket to non-blocking. */
     if (AGENTD_STATUS_SUCCESS != ipc_make_noblock(proto, &inst->proto, inst))
     {
         retval = AGENTD_ERROR_PROTOCOLSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
-        goto cleanup_authorized_entity_pubkey_buffer;
+        goto cleanup_entities;
     }
 
     /* set the random socket to non-blocking. */
@@ -117,8 +144,39 @@ int unauthorized_protocol_service_instance_init(
         goto cleanup_proto;
     }
 
-    /* set the data socket to non-blocking. */
-    if (AGENTD_STATUS_SUCCESS != ipc_make_noblock(data, &inst->data, inst))
+    /* with a ring, dataservice requests travel over the ring, and the socket
+     * only tells us when the data service has gone away. */
+    if (NULL != ring)
+    {
+        retval =
+            ipc_make_ring_noblock(
+                ring->memfd, IPC_RING_SIDE_LHS, ring->lhs, ring->rhs,
+                &inst->data, inst);
+
+        /* the socket context keeps its own handles to the ring. */
+        close(ring->memfd);
+        close(ring->rhs);
+
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            close(ring->lhs);
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
+            goto cleanup_random;
+        }
+
+        if (AGENTD_STATUS_SUCCESS !=
+            ipc_make_noblock(data, &inst->data_socket, inst))
+        {
+            dispose((disposable_t*)&inst->data);
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
+            goto cleanup_random;
+        }
+
+        inst->data_ring = true;
+    }
+    /* otherwise, set the data socket to non-blocking. */
+    else if (AGENTD_STATUS_SUCCESS !=
+             ipc_make_noblock(data, &inst->data, inst))
     {
         retval = AGENTD_ERROR_PROTOCOLSERVICE_IPC_MAKE_NOBLOCK_FAILURE;
         goto cleanup_random;
@@ -136,6 +194,16 @@ int unauthorized_protocol_service_instance_init(
     ipc_exit_loop_on_signal(&inst->loop, SIGTERM);
     ipc_exit_loop_on_signal(&inst->loop, SIGQUIT);
 
+    /* on SIGUSR1, reload the authorized entity table. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_event_loop_on_signal(
+            &inst->loop, SIGUSR1,
+            &unauthorized_protocol_service_entity_table_reload, inst))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_IPC_EVENT_LOOP_INIT_FAILURE;
+        goto cleanup_loop;
+    }
+
     /* create a single dynamic array and size for all connections so that
      * we can reference them by offset in constant time.
      */
@@ -161,18 +229,47 @@ int unauthorized_protocol_service_instance_init(
             &inst->free_connection_head, inst->connections + i);
     }
 
+    /* create the child context pool.  Each connection may need a child
+     * context of its own, if no two connections share capabilities. */
+    inst->child_contexts = (unauthorized_protocol_child_context_t*)
+        malloc(max_socks * sizeof(unauthorized_protocol_child_context_t));
+    if (NULL == inst->child_contexts)
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_connections;
+    }
+
+    /* every pool entry starts out free. */
+    memset(
+        inst->child_contexts, 0,
+        max_socks * sizeof(unauthorized_protocol_child_context_t));
+    for (size_t i = 0; i < max_socks; ++i)
+    {
+        inst->child_contexts[i].state = UPCC_FREE;
+        inst->child_contexts[i].child = -1;
+    }
+
+    /* start with an empty response cache. */
+    unauthorized_protocol_response_cache_init(
+        &inst->response_cache,
+        UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUDGET);
+
     /* success. */
     retval = AGENTD_STATUS_SUCCESS;
     goto done;
 
-    /*cleanup_connections:
-    free(inst->connections); */
+cleanup_connections:
+    free(inst->connections);
 
 cleanup_loop:
     dispose((disposable_t*)&inst->loop);
 
 cleanup_data:
     dispose((disposable_t*)&inst->data);
+    if (inst->data_ring)
+    {
+        dispose((disposable_t*)&inst->data_socket);
+    }
 
 cleanup_random:
     dispose((disposable_t*)&inst->random);
@@ -180,6 +277,12 @@ cleanup_random:
 cleanup_proto:
     dispose((disposable_t*)&inst->proto);
 
+cleanup_entities:
+    dispose((disposable_t*)&inst->entities);
+
+cleanup_session_tickets:
+    unauthorized_protocol_service_session_tickets_dispose(inst);
+
 cleanup_authorized_entity_pubkey_buffer:
     dispose((disposable_t*)&inst->authorized_entity_pubkey);
 
@@ -226,12 +329,22 @@ static void unauthorized_protocol_service_instance_dispose(void* disposable)
         i = next;
     }
 
+    /* dispose of the session ticket key and redeemed tickets. */
+    unauthorized_protocol_service_session_tickets_dispose(inst);
+
     /* free connection array. */
     memset(
         inst->connections, 0,
         inst->num_connections * sizeof(unauthorized_protocol_connection_t));
     free(inst->connections);
 
+    /* free the child context pool.  The data service closes the child
+     * contexts when this process disconnects. */
+    memset(
+        inst->child_contexts, 0,
+        inst->num_connections * sizeof(unauthorized_protocol_child_context_t));
+    free(inst->child_contexts);
+
     /* dispose of the proto socket. */
     dispose((disposable_t*)&inst->proto);
 
@@ -240,10 +353,20 @@ static void unauthorized_protocol_service_instance_dispose(void* disposable)
 
     /* dispose of the data socket. */
     dispose((disposable_t*)&inst->data);
+    if (inst->data_ring)
+    {
+        dispose((disposable_t*)&inst->data_socket);
+    }
 
     /* dispose of the loop. */
     dispose((disposable_t*)&inst->loop);
 
+    /* dispose of the authorized entity table. */
+    dispose((disposable_t*)&inst->entities);
+
+    /* dispose of the response cache. */
+    dispose((disposable_t*)&inst->response_cache);
+
     /* dispose of crypto buffers. */
     dispose((disposable_t*)&inst->authorized_entity_pubkey);
     dispose((disposable_t*)&inst->agent_privkey);
@@ -12,9 +12,16 @@
 
 #include "unauthorized_protocol_service_private.h"
 
+/* forward decls. */
+static void unauthorized_protocol_service_accept_socket(
+    unauthorized_protocol_service_instance_t* inst, int recvsock);
+
 /**
  * \brief Handle read events on the protocol socket.
  *
+ * The listen service passes accepted sockets in batches.  Every batch waiting
+ * on the socket is received and each socket is given a connection.
+ *
  * \param ctx           The non-blocking socket context.
  * \param event_flags   The event that triggered this callback.
  * \param user_context  The user context for this proto socket.
@@ -23,22 +30,46 @@ void unauthorized_protocol_service_ipc_read(
     ipc_socket_context_t* ctx, int UNUSED(event_flags),
     void* user_context)
 {
-    int recvsock;
-
-    /* TODO - This should be non-blocking on the listener and protocol side. */
+    int recvsocks[IPC_SOCKET_BATCH_MAX];
+    size_t count;
 
     /* get the instance from the user context. */
     unauthorized_protocol_service_instance_t* inst =
         (unauthorized_protocol_service_instance_t*)user_context;
 
+    /* receive batches of sockets until none are left. */
+    while (!inst->force_exit)
+    {
+        /* attempt to receive a batch of sockets from the listen service. */
+        int retval = ipc_receivesockets_noblock(ctx, recvsocks, &count);
+        if (AGENTD_STATUS_SUCCESS != retval)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            unauthorized_protocol_service_accept_socket(inst, recvsocks[i]);
+        }
+    }
+}
+
+/**
+ * \brief Set up a connection for a socket received from the listen service.
+ *
+ * If no connection is available, or the connection can't be set up, the
+ * socket is closed.
+ *
+ * \param inst          The protocol service instance.
+ * \param recvsock      The socket received from the listen service.
+ */
+static void unauthorized_protocol_service_accept_socket(
+    unauthorized_protocol_service_instance_t* inst, int recvsock)
+{
     /* don't accept any more sockets if we're shutting down. */
     if (inst->force_exit)
-        return;
-
-    /* attempt to receive a socket from the listen service. */
-    int retval = ipc_receivesocket_noblock(ctx, &recvsock);
-    if (AGENTD_STATUS_SUCCESS != retval)
     {
+        close(recvsock);
         return;
     }
 
@@ -63,6 +94,20 @@ void unauthorized_protocol_service_ipc_read(
         return;
     }
 
+    /* stop reading from this client while its responses are backed up. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_set_watermarks_noblock(
+            &conn->ctx, inst->connection_low_watermark,
+            inst->connection_high_watermark,
+            &unauthorized_protocol_service_connection_watermark))
+    {
+        dispose((disposable_t*)conn);
+        unauthorized_protocol_connection_push_front(
+            &inst->free_connection_head, conn);
+        close(recvsock);
+        return;
+    }
+
     /* add the socket to the event loop. */
     if (AGENTD_STATUS_SUCCESS != ipc_event_loop_add(&inst->loop, &conn->ctx))
     {
@@ -78,6 +123,12 @@ void unauthorized_protocol_service_ipc_read(
         &conn->ctx, &unauthorized_protocol_service_connection_read,
         &conn->svc->loop);
 
+    /* don't read from this client until the data service catches up. */
+    if (inst->dataservice_backpressure)
+    {
+        ipc_pause_read_noblock(&conn->ctx);
+    }
+
     /* this is now a used connection. */
     unauthorized_protocol_connection_push_front(
         &inst->used_connection_head, conn);
@@ -20,6 +20,7 @@ extern "C" {
 #include <agentd/ipc.h>
 #include <agentd/protocolservice/api.h>
 #include <stdint.h>
+#include <time.h>
 
 /* Forward decl for unauthorized protocol service data structure. */
 struct unauthorized_protocol_service_instance;
@@ -27,6 +28,9 @@ struct unauthorized_protocol_service_instance;
 /* Forward decl for an unauthorized protocol connection. */
 struct unauthorized_protocol_connection;
 
+/* Forward decl for a pooled dataservice child context. */
+struct unauthorized_protocol_child_context;
+
 /**
  * \brief The unauthorized protocol service instance.
  */
@@ -39,6 +43,13 @@ typedef struct unauthorized_protocol_service_instance
 typedef struct unauthorized_protocol_connection
     unauthorized_protocol_connection_t;
 
+/**
+ * \brief A dataservice child context, shared by the connections of entities
+ * with the same capabilities.
+ */
+typedef struct unauthorized_protocol_child_context
+    unauthorized_protocol_child_context_t;
+
 /**
  * \brief States for an unauthorized protocol socket.
  */
@@ -83,10 +94,342 @@ typedef enum unauthorized_protocol_connection_state
     /** \brief Write the command response to the client. */
     APCS_WRITE_COMMAND_RESP_TO_CLIENT,
 
+    /** \brief Stream a block to the client. */
+    APCS_STREAM_RESP_TO_CLIENT,
+
     /** \brief This connection is quiescing. */
     APCS_QUIESCING,
 } unauthorized_protocol_connection_state_t;
 
+/**
+ * \brief The most requests that a single connection can have outstanding.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX 32U
+
+/**
+ * \brief The default number of requests that a single connection can have
+ * outstanding.  This can be set with AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_DEFAULT_PIPELINE_WINDOW 8U
+
+/**
+ * \brief The most sub-requests that a single batch request can carry.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_BATCH_MAX 16U
+
+/**
+ * \brief The most requests that can be waiting on the data service for a
+ * single connection.  A batch is only read while the pipeline has room, so
+ * this leaves space for a full batch on top of a nearly full pipeline.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_PENDING_MAX \
+    (UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX \
+        + UNAUTHORIZED_PROTOCOL_SERVICE_BATCH_MAX)
+
+/**
+ * \brief A client request waiting on a response from the data service.
+ */
+typedef struct unauthorized_protocol_pending_request
+{
+    uint32_t sequence;
+    uint32_t request_id;
+    uint32_t request_offset;
+    bool batched;
+} unauthorized_protocol_pending_request_t;
+
+/**
+ * \brief A client request that has been read, waiting for the scheduler to
+ * dispatch it.
+ */
+typedef struct unauthorized_protocol_queued_request
+{
+    void* packet;
+    uint32_t packet_size;
+    uint32_t request_id;
+    uint32_t request_offset;
+    struct timespec enqueued;
+} unauthorized_protocol_queued_request_t;
+
+/**
+ * \brief The number of requests that a connection may dispatch in each round
+ * of the scheduler, for each unit of its entity's weight.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_QUANTUM 4
+
+/**
+ * \brief The largest scheduling weight that an entity can be given.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_WEIGHT_MAX 64U
+
+/**
+ * \brief The most requests, across every connection, that can be waiting on
+ * the data service at once.  Further requests wait in their connection's
+ * queue.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX 128U
+
+/**
+ * \brief The most connections that can share a single dataservice child
+ * context.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_CHILD_CONTEXT_SHARE_MAX 8U
+
+/**
+ * \brief The most idle child contexts that are kept open for each set of
+ * capabilities.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_CHILD_CONTEXT_IDLE_MAX 2U
+
+/**
+ * \brief The most artifacts that a single connection can watch.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ARTIFACT_WATCH_MAX 65536U
+
+/**
+ * \brief States for a pooled dataservice child context.
+ */
+typedef enum unauthorized_protocol_child_context_state
+{
+    /** \brief This pool entry has no child context. */
+    UPCC_FREE,
+
+    /** \brief Waiting on the data service to create the child context. */
+    UPCC_CREATING,
+
+    /** \brief The child context can carry requests. */
+    UPCC_READY,
+
+    /** \brief Waiting on outstanding responses before closing. */
+    UPCC_CLOSING,
+} unauthorized_protocol_child_context_state_t;
+
+/**
+ * \brief A pooled dataservice child context.
+ *
+ * The data service answers the requests for a child context in order.  Each
+ * request sent on this context is tagged with the next request sequence
+ * number, and each response answers the next response sequence number, so a
+ * response is routed to the connection holding the request with that tag.
+ * The difference between the two is the number of responses still owed, and
+ * the child context isn't closed until they have all arrived.
+ */
+struct unauthorized_protocol_child_context
+{
+    unauthorized_protocol_child_context_state_t state;
+    int child;
+    BITCAP(dataservice_caps, DATASERVICE_API_CAP_BITS_MAX);
+    bool subscribed;
+    uint32_t request_sequence;
+    uint32_t response_sequence;
+    size_t connection_count;
+    unauthorized_protocol_connection_t*
+        connections[UNAUTHORIZED_PROTOCOL_SERVICE_CHILD_CONTEXT_SHARE_MAX];
+    unauthorized_protocol_child_context_t* create_next;
+};
+
+/**
+ * \brief The most redeemed session tickets that a protocol service instance
+ * remembers.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAX 4096U
+
+/**
+ * \brief How long, in seconds, a session ticket can be redeemed after it is
+ * issued.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_LIFETIME 3600
+
+/**
+ * \brief The offset of the expiry time in a session ticket, which follows the
+ * ticket id.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_EXPIRES_OFFSET \
+    PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE
+
+/**
+ * \brief The offset of the sealed session key in a session ticket.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_OFFSET \
+    (UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_EXPIRES_OFFSET \
+        + sizeof(uint64_t))
+
+/**
+ * \brief The size of the sealed session key in a session ticket.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_SIZE 32U
+
+/**
+ * \brief The offset of the MAC in a session ticket, which covers everything
+ * before it.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_OFFSET \
+    (UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_OFFSET \
+        + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_SIZE)
+
+/**
+ * \brief The size of the MAC in a session ticket.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_SIZE \
+    (PROTOCOLSERVICE_SESSION_TICKET_SIZE \
+        - UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_OFFSET)
+
+/**
+ * \brief The size of the local pool of random bytes that handshakes draw from.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_SIZE 4096U
+
+/**
+ * \brief Top up the entropy pool once it holds fewer than this many bytes.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_LOW_WATERMARK 1024U
+
+/**
+ * \brief The number of random bytes to request for each entropy pool refill.
+ * This is the most that the random service returns for a single request.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_REFILL_SIZE 1024U
+
+/**
+ * \brief The request offset used for entropy pool refills, which can't clash
+ * with a connection offset.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_OFFSET 0xFFFFFFFFU
+
+/**
+ * \brief A session ticket that has been redeemed.  It is remembered until it
+ * expires, so that it can't be redeemed again.
+ */
+typedef struct unauthorized_protocol_session_ticket
+{
+    uint8_t ticket_id[PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE];
+    time_t expires;
+} unauthorized_protocol_session_ticket_t;
+
+/**
+ * \brief The size of an authorized entity's public key.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ENTITY_KEY_SIZE 32U
+
+/**
+ * \brief The smallest number of slots in an authorized entity table.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_ENTITY_TABLE_MIN_CAPACITY 16U
+
+/**
+ * \brief An entity that is authorized to connect to the protocol service.
+ */
+typedef struct unauthorized_protocol_entity
+{
+    bool in_use;
+    uint8_t entity_uuid[16];
+    uint8_t public_key[UNAUTHORIZED_PROTOCOL_SERVICE_ENTITY_KEY_SIZE];
+    BITCAP(dataservice_caps, DATASERVICE_API_CAP_BITS_MAX);
+    uint32_t weight;
+} unauthorized_protocol_entity_t;
+
+/**
+ * \brief The authorized entities, in an open addressed hash table keyed by
+ * entity UUID.  The table is never more than half full, so that probes stay
+ * short.
+ */
+typedef struct unauthorized_protocol_entity_table
+{
+    disposable_t hdr;
+    unauthorized_protocol_entity_t* entities;
+    size_t capacity;
+    size_t count;
+} unauthorized_protocol_entity_table_t;
+
+/**
+ * \brief The most bytes that the response cache holds, counting the size of
+ * each entry along with its response.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUDGET \
+    (32U * 1024U * 1024U)
+
+/**
+ * \brief The number of hash buckets in the response cache.  This must be a
+ * power of two.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUCKETS 4096U
+
+/**
+ * \brief The number of access counters in the response cache's frequency
+ * sketch.  This must be a power of two.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SIZE 4096U
+
+/**
+ * \brief Halve every counter in the frequency sketch after this many
+ * accesses, so that the sketch follows the recent working set.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SAMPLE \
+    (8U * UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SIZE)
+
+/**
+ * \brief An encoded response held in the response cache.
+ *
+ * The cached response is everything after the method, status, and offset
+ * header, which differs between requests.
+ */
+typedef struct unauthorized_protocol_response_cache_entry
+    unauthorized_protocol_response_cache_entry_t;
+
+struct unauthorized_protocol_response_cache_entry
+{
+    unauthorized_protocol_response_cache_entry_t* hash_next;
+    unauthorized_protocol_response_cache_entry_t* lru_prev;
+    unauthorized_protocol_response_cache_entry_t* lru_next;
+    uint64_t hash;
+    uint32_t request_id;
+    uint8_t id[16];
+    size_t size;
+    uint8_t data[];
+};
+
+/**
+ * \brief A cache of encoded data service responses for data that never
+ * changes once committed, keyed by request ID and block or transaction ID.
+ *
+ * Entries are evicted in least recently used order.  To keep a scan of cold
+ * data from flushing the cache, a new response is only admitted in place of
+ * entries that have been requested less often than it has, according to a
+ * small frequency sketch of recent requests.
+ */
+typedef struct unauthorized_protocol_response_cache
+{
+    disposable_t hdr;
+    unauthorized_protocol_response_cache_entry_t*
+        buckets[UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_BUCKETS];
+    unauthorized_protocol_response_cache_entry_t* lru_head;
+    unauthorized_protocol_response_cache_entry_t* lru_tail;
+    size_t budget;
+    size_t used;
+    uint8_t sketch[UNAUTHORIZED_PROTOCOL_SERVICE_RESPONSE_CACHE_SKETCH_SIZE];
+    size_t sketch_samples;
+    uint64_t hits;
+    uint64_t misses;
+} unauthorized_protocol_response_cache_t;
+
+/**
+ * \brief A block being streamed to the client.
+ *
+ * A block whose certificate is larger than a single stream chunk is read from
+ * the data service one slice at a time.  The next slice is requested as the
+ * client socket's write buffer drains, so that at most a couple of slices are
+ * held for the connection at once.
+ */
+typedef struct unauthorized_protocol_block_stream
+{
+    bool active;
+    bool started;
+    bool slice_pending;
+    uint32_t request_offset;
+    uint8_t block_id[16];
+    uint64_t position;
+    uint64_t cert_size;
+} unauthorized_protocol_block_stream_t;
+
 /**
  * \brief Context for an unauthorized protocol connection.
  */
@@ -99,6 +442,7 @@ typedef struct unauthorized_protocol_connection
     unauthorized_protocol_connection_state_t state;
     unauthorized_protocol_service_instance_t* svc;
     int dataservice_child_context;
+    unauthorized_protocol_child_context_t* child_context;
     BITCAP(dataservice_caps, DATASERVICE_API_CAP_BITS_MAX);
     bool key_found;
     uint8_t entity_uuid[16];
@@ -112,6 +456,33 @@ typedef struct unauthorized_protocol_connection
     uint64_t server_iv;
     uint32_t current_request_offset;
     unauthorized_protocol_request_id_t request_id;
+    bool current_request_batched;
+    unauthorized_protocol_pending_request_t
+        pending_requests[UNAUTHORIZED_PROTOCOL_SERVICE_PENDING_MAX];
+    size_t pending_head;
+    size_t pending_count;
+    size_t batch_remaining;
+    uint8_t* batch_buffer;
+    size_t batch_size;
+    size_t batch_capacity;
+    bool block_notify;
+    uint32_t block_notify_offset;
+    bool artifact_watch;
+    uint32_t artifact_watch_offset;
+    uint8_t* artifact_watch_ids;
+    size_t artifact_watch_count;
+    unauthorized_protocol_queued_request_t
+        queued_requests[UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX];
+    size_t queue_head;
+    size_t queue_count;
+    bool batch_queued;
+    uint32_t schedule_weight;
+    int64_t schedule_deficit;
+    bool schedule_credited;
+    bool schedule_active;
+    unauthorized_protocol_connection_t* schedule_next;
+    unauthorized_protocol_block_stream_t block_stream;
+    bool client_backpressure;
 } unauthorized_protocol_connection_t;
 
 /**
@@ -126,22 +497,79 @@ struct unauthorized_protocol_service_instance
     unauthorized_protocol_connection_t* free_connection_head;
     unauthorized_protocol_connection_t* used_connection_head;
     unauthorized_protocol_connection_t* dataservice_context_create_head;
+    unauthorized_protocol_child_context_t* child_contexts;
+    unauthorized_protocol_child_context_t* child_context_create_head;
+    unauthorized_protocol_child_context_t* child_context_create_tail;
     /* TODO - hard-coded to current number of dataservice children. Should be
      * dynamically determined. */
-    unauthorized_protocol_connection_t* dataservice_child_map[1024];
+    unauthorized_protocol_child_context_t* dataservice_child_map[1024];
+    unauthorized_protocol_connection_t* dataservice_response_conn;
     ipc_socket_context_t random;
     ipc_socket_context_t data;
     ipc_socket_context_t proto;
+    /* when data runs over a ring, the data service socket is kept only to
+     * notice the data service going away. */
+    bool data_ring;
+    ipc_socket_context_t data_socket;
     ipc_event_loop_context_t loop;
     allocator_options_t alloc_opts;
     vccrypt_suite_options_t suite;
     vccrypt_buffer_t agent_pubkey;
     vccrypt_buffer_t agent_privkey;
+    vccrypt_buffer_t session_ticket_key;
     vccrypt_buffer_t authorized_entity_pubkey;
     uint8_t agent_id[16];
     uint8_t authorized_entity_id[16];
+    unauthorized_protocol_entity_table_t entities;
+    unauthorized_protocol_response_cache_t response_cache;
+    bool dataservice_backpressure;
+    size_t dataservice_low_watermark;
+    size_t dataservice_high_watermark;
+    size_t connection_low_watermark;
+    size_t connection_high_watermark;
+    size_t pipeline_window;
+    unauthorized_protocol_session_ticket_t
+        session_tickets_redeemed[
+            UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAX];
+    uint64_t session_ticket_counter;
+    uint8_t entropy_pool[UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_SIZE];
+    size_t entropy_pool_size;
+    size_t entropy_refills_pending;
+    unauthorized_protocol_connection_t* schedule_head;
+    unauthorized_protocol_connection_t* schedule_tail;
+    size_t schedule_queued;
+    size_t dataservice_inflight;
+    uint64_t schedule_dispatched;
+    uint64_t schedule_wait_total_usec;
+    uint64_t schedule_wait_max_usec;
 };
 
+/**
+ * \brief Stop reading client requests once this many bytes of requests are
+ * waiting to be written to the data service, and start again once the backlog
+ * drains below the low watermark.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_HIGH_WATERMARK \
+    (4U * 1024U * 1024U)
+#define UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_LOW_WATERMARK \
+    (1U * 1024U * 1024U)
+
+/**
+ * \brief Stop reading requests from a client once this many bytes of responses
+ * are waiting to be written to it, and start again once the backlog drains
+ * below the low watermark.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_CONNECTION_HIGH_WATERMARK \
+    (4U * 1024U * 1024U)
+#define UNAUTHORIZED_PROTOCOL_SERVICE_CONNECTION_LOW_WATERMARK \
+    (1U * 1024U * 1024U)
+
+/**
+ * \brief The range allowed for a configured watermark, in bytes.
+ */
+#define UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MIN (4U * 1024U)
+#define UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MAX (1024U * 1024U * 1024U)
+
 /**
  * \brief Initialize an unauthorized protocol connection instance.
  *
@@ -180,6 +608,129 @@ void unauthorized_protocol_connection_remove(
 void unauthorized_protocol_service_close_connection(
     unauthorized_protocol_connection_t* conn);
 
+/**
+ * \brief Record a request that is waiting on the data service.
+ *
+ * The request ID, offset, and batch membership are taken from the
+ * connection's current request.  The caller must have checked that the
+ * connection's pipeline has room.
+ *
+ * \param conn          The connection on which the request was read.
+ */
+void unauthorized_protocol_connection_request_push(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Take the oldest request waiting on the data service, making it the
+ * connection's current request.
+ *
+ * The data service answers the requests for a child context in order, so each
+ * response belongs to the oldest outstanding request on its connection.
+ *
+ * \param conn          The connection to which a response was sent.
+ *
+ * \returns true if a request was waiting, and false otherwise.
+ */
+bool unauthorized_protocol_connection_request_pop(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Queue a request read from the client until the scheduler dispatches
+ * it.
+ *
+ * The connection takes ownership of the request packet.  The caller must have
+ * checked that the connection's pipeline has room.
+ *
+ * \param conn              The connection on which the request was read.
+ * \param packet            The request packet.
+ * \param packet_size       The size of the request packet.
+ * \param request_id        The request ID.
+ * \param request_offset    The offset of the request.
+ */
+void unauthorized_protocol_connection_request_enqueue(
+    unauthorized_protocol_connection_t* conn, void* packet,
+    uint32_t packet_size, uint32_t request_id, uint32_t request_offset);
+
+/**
+ * \brief Dispatch queued client requests, sharing the data service fairly
+ * between connections.
+ *
+ * Connections with queued requests take turns in deficit round-robin order.
+ * On each turn, a connection may dispatch as many data service requests as
+ * its entity's weight allows, and any overdraft is charged against its next
+ * turn.  Dispatching stops while
+ * UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX requests are waiting
+ * on the data service.
+ *
+ * \param svc           The protocol service instance.
+ */
+void unauthorized_protocol_service_schedule(
+    unauthorized_protocol_service_instance_t* svc);
+
+/**
+ * \brief Remove a connection from the scheduler, dropping any requests that it
+ * has queued.
+ *
+ * \param conn          The connection to remove.
+ */
+void unauthorized_protocol_service_schedule_remove(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Add a connection with queued requests to the end of the schedule.
+ *
+ * \param conn          The connection to add.
+ */
+void unauthorized_protocol_service_schedule_add(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Set the number of requests that each connection can have
+ * outstanding.
+ *
+ * The window is clamped to between 1 and
+ * UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX.  A window of 1 processes one
+ * request at a time, as clients without pipelining expect.
+ *
+ * \param inst          The service instance.
+ * \param window        The number of outstanding requests to allow.
+ */
+void unauthorized_protocol_service_set_pipeline_window(
+    unauthorized_protocol_service_instance_t* inst, size_t window);
+
+/**
+ * \brief Get a numeric setting from the environment.
+ *
+ * \param name          The name of the environment variable.
+ * \param default_value The value to use if the variable isn't set.
+ * \param min           The smallest value allowed.
+ * \param max           The largest value allowed.
+ * \param value         Pointer to receive the value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID if the variable is not a
+ *        decimal number from min to max.
+ */
+int unauthorized_protocol_service_setting_get(
+    const char* name, size_t default_value, size_t min, size_t max,
+    size_t* value);
+
+/**
+ * \brief Read the tunable settings for the protocol service from the
+ * environment.
+ *
+ * \param inst          The service instance to update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID if a setting is
+ *        malformed or out of range, or if a low watermark is above its high
+ *        watermark.
+ */
+int unauthorized_protocol_service_settings_read(
+    unauthorized_protocol_service_instance_t* inst);
+
 /**
  * \brief Push a protocol connection onto the given list.
  *
@@ -196,6 +747,10 @@ void unauthorized_protocol_connection_push_front(
  * \param inst          The service instance to initialize.
  * \param random        The random socket to use for this instance.
  * \param data          The dataservice socket to use for this instance.
+ * \param ring          Optional shared-memory ring to the dataservice, or
+ *                      NULL.  When set, dataservice requests use the
+ *                      left-hand side of this ring instead of the socket.
+ *                      The instance takes ownership of these descriptors.
  * \param proto         The protocol socket to use for this instance.
  * \param max_socks     The maximum number of socket connections to accept.
  *
@@ -203,7 +758,7 @@ void unauthorized_protocol_connection_push_front(
  */
 int unauthorized_protocol_service_instance_init(
     unauthorized_protocol_service_instance_t* inst, int random, int data,
-    int proto, size_t max_socks);
+    const ipc_ring_descriptors_t* ring, int proto, size_t max_socks);
 
 /**
  * \brief Handle read events on the protocol socket.
@@ -270,6 +825,18 @@ void unauthorized_protocol_service_random_write(
 void unauthorized_protocol_service_dataservice_read(
     ipc_socket_context_t* ctx, int event_flags, void* user_context);
 
+/**
+ * \brief Handle read events on the data service socket while dataservice
+ * traffic runs over a ring.
+ *
+ * \param ctx           The socket context for this read callback.
+ * \param event_flags   The event flags that led to this callback being called.
+ * \param user_context  The user context for this callback (expected: a protocol
+ *                      service instance).
+ */
+void unauthorized_protocol_service_dataservice_hangup(
+    ipc_socket_context_t* ctx, int event_flags, void* user_context);
+
 /**
  * \brief Write data to the dataservice socket.
  *
@@ -281,6 +848,37 @@ void unauthorized_protocol_service_dataservice_read(
 void unauthorized_protocol_service_dataservice_write(
     ipc_socket_context_t* ctx, int event_flags, void* user_context);
 
+/**
+ * \brief Watermark callback for the dataservice socket.
+ *
+ * While the dataservice socket is backed up, reads on every client connection
+ * are paused, so that clients cannot queue requests faster than the data
+ * service accepts them.
+ *
+ * \param ctx           The socket context for this watermark callback.
+ * \param above         true if the write buffer crossed the high watermark,
+ *                      false if it drained below the low watermark.
+ * \param user_context  The user context for this callback (expected: a protocol
+ *                      service instance).
+ */
+void unauthorized_protocol_service_dataservice_watermark(
+    ipc_socket_context_t* ctx, bool above, void* user_context);
+
+/**
+ * \brief Watermark callback for a client connection.
+ *
+ * While responses to a client are backed up, reads from that client are
+ * paused.  Reads stay paused while the data service is backed up.
+ *
+ * \param ctx           The socket context for this watermark callback.
+ * \param above         true if the write buffer crossed the high watermark,
+ *                      false if it drained below the low watermark.
+ * \param user_context  The user context for this callback (expected: a
+ *                      protocol connection).
+ */
+void unauthorized_protocol_service_connection_watermark(
+    ipc_socket_context_t* ctx, bool above, void* user_context);
+
 /**
  * \brief Set up a clean re-entry from the event loop and ensure that no other
  * callbacks occur by setting the appropriate force exit flag.
@@ -319,6 +917,20 @@ int unauthorized_protocol_service_write_handshake_request_response(
 void unauthorized_protocol_service_connection_handshake_ack_read(
     unauthorized_protocol_connection_t* conn);
 
+/**
+ * \brief Resume a session from a handshake resume request.
+ *
+ * This takes the place of the handshake request, the entropy request, and the
+ * handshake acknowledgement for a client holding a session ticket.
+ *
+ * \param conn      The connection on which the request was read.
+ * \param req       The request packet.
+ * \param size      The size of the request packet.
+ */
+void unauthorized_protocol_service_connection_handshake_resume(
+    unauthorized_protocol_connection_t* conn, const uint8_t* req,
+    size_t size);
+
 /**
  * \brief Attempt to read a command from the client.
  *
@@ -339,20 +951,290 @@ void unauthorized_protocol_service_command_read(
 int unauthorized_protocol_service_write_entropy_request(
     unauthorized_protocol_connection_t* conn);
 
+/**
+ * \brief Fill a connection's server nonces from the local entropy pool.
+ *
+ * Drawing from the pool lets a handshake proceed without a round trip to the
+ * random service.  Bytes drawn from the pool are scrubbed from it, and the pool
+ * is topped up once it drops below its low watermark.
+ *
+ * \param conn          The connection for which the nonces are drawn.
+ *
+ * \returns true if the nonces were filled, or false if the pool does not hold
+ * enough entropy, in which case the caller should fall back to
+ * \ref unauthorized_protocol_service_write_entropy_request().
+ */
+bool unauthorized_protocol_service_entropy_pool_draw(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Request enough random bytes to fill the local entropy pool.
+ *
+ * Requests are only written for the space in the pool that isn't already
+ * covered by a pending refill.
+ *
+ * \param svc           The protocol service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_PRNG_REQUEST_FAILURE if a refill request
+ *        could not be written.
+ */
+int unauthorized_protocol_service_entropy_pool_refill(
+    unauthorized_protocol_service_instance_t* svc);
+
 /**
  * \brief Get the entity key associated with the data read during a handshake
  * request.
  *
+ * On success, the entity's public key, capabilities, and scheduling weight
+ * are copied to the connection.
+ *
  * \param conn          The connection for which the entity key should be
  *                      resolved.
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - a non-zero return code on failure.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED if the entity is not in
+ *        the authorized entity table.
  */
 int unauthorized_protocol_service_get_entity_key(
     unauthorized_protocol_connection_t* conn);
 
+/**
+ * \brief Initialize an empty authorized entity table with room for the given
+ * number of entities.
+ *
+ * On success, the table is owned by the caller and must be disposed by
+ * calling \ref dispose() when no longer needed.
+ *
+ * \param table         The table to initialize.
+ * \param count         The number of entities that the table must hold.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the table could not be
+ *        allocated.
+ */
+int unauthorized_protocol_entity_table_init(
+    unauthorized_protocol_entity_table_t* table, size_t count);
+
+/**
+ * \brief Add an entity to an authorized entity table.
+ *
+ * If the entity is already in the table, its key and capabilities are
+ * replaced.
+ *
+ * \param table         The table to which the entity is added.
+ * \param entity        The entity to add.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE if the table
+ *        has no room for another entity.
+ */
+int unauthorized_protocol_entity_table_insert(
+    unauthorized_protocol_entity_table_t* table,
+    const unauthorized_protocol_entity_t* entity);
+
+/**
+ * \brief Find the slot for an entity in an authorized entity table.
+ *
+ * Slots are probed linearly from the slot picked by a hash of the entity
+ * UUID.  Entities are never removed from a table, so the probe can stop at the
+ * first empty slot.
+ *
+ * \param table         The table to probe.
+ * \param entity_uuid   The UUID of the entity.
+ *
+ * \returns the slot holding the entity, the empty slot where it would be
+ * added, or NULL if the table is full.
+ */
+unauthorized_protocol_entity_t* unauthorized_protocol_entity_table_probe(
+    const unauthorized_protocol_entity_table_t* table,
+    const uint8_t* entity_uuid);
+
+/**
+ * \brief Find an entity in an authorized entity table.
+ *
+ * \param table         The table to search.
+ * \param entity_uuid   The UUID of the entity to find.
+ *
+ * \returns the entity, or NULL if it is not in the table.
+ */
+const unauthorized_protocol_entity_t* unauthorized_protocol_entity_table_find(
+    const unauthorized_protocol_entity_table_t* table,
+    const uint8_t* entity_uuid);
+
+/**
+ * \brief Load the authorized entity table for the service.
+ *
+ * The table holds the bootstrap entity from the environment, along with every
+ * entity listed in the file named by AGENTD_AUTHORIZED_ENTITIES_FILE, if set.
+ * The new table replaces the service's table only if it loads completely, so
+ * a bad file leaves the current entities in place.
+ *
+ * \param svc           The protocol service instance.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the table could not be
+ *        allocated.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE if the entity
+ *        file could not be read or is malformed.
+ */
+int unauthorized_protocol_service_entity_table_load(
+    unauthorized_protocol_service_instance_t* svc);
+
+/**
+ * \brief Reload the authorized entity table when the reload signal is caught.
+ *
+ * Connections that have already been authorized keep the capabilities that
+ * they were granted.
+ *
+ * \param sig           The signal that was caught.
+ * \param user_context  The protocol service instance.
+ */
+void unauthorized_protocol_service_entity_table_reload(
+    int sig, void* user_context);
+
+/**
+ * \brief Initialize an empty response cache.
+ *
+ * The cache is owned by the caller and must be disposed by calling
+ * \ref dispose() when no longer needed.
+ *
+ * \param cache         The cache to initialize.
+ * \param budget        The most bytes that the cache can hold.
+ */
+void unauthorized_protocol_response_cache_init(
+    unauthorized_protocol_response_cache_t* cache, size_t budget);
+
+/**
+ * \brief Hash a response cache key.
+ *
+ * \param request_id    The request ID of the cached response.
+ * \param id            The block or transaction ID of the cached response.
+ *
+ * \returns the hash of this key.
+ */
+uint64_t unauthorized_protocol_response_cache_hash(
+    uint32_t request_id, const uint8_t* id);
+
+/**
+ * \brief Find a response in the response cache.
+ *
+ * Every lookup counts as a hit or a miss, and is recorded in the cache's
+ * frequency sketch.  A hit becomes the most recently used entry.
+ *
+ * \param cache         The cache to search.
+ * \param request_id    The request ID of the response.
+ * \param id            The block or transaction ID of the response.
+ *
+ * \returns the cached response, or NULL if it is not in the cache.
+ */
+const unauthorized_protocol_response_cache_entry_t*
+unauthorized_protocol_response_cache_find(
+    unauthorized_protocol_response_cache_t* cache, uint32_t request_id,
+    const uint8_t* id);
+
+/**
+ * \brief Add a response to the response cache.
+ *
+ * The response is only added if it fits in the budget by evicting entries
+ * that have been requested less often than it has.  A response that is not
+ * admitted is not an error.
+ *
+ * \param cache         The cache to which the response is added.
+ * \param request_id    The request ID of the response.
+ * \param id            The block or transaction ID of the response.
+ * \param data          The encoded response, following its header.
+ * \param size          The size of the encoded response.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the entry could not be
+ *        allocated.
+ */
+int unauthorized_protocol_response_cache_insert(
+    unauthorized_protocol_response_cache_t* cache, uint32_t request_id,
+    const uint8_t* id, const uint8_t* data, size_t size);
+
+/**
+ * \brief Answer a request from the response cache, if its response is cached.
+ *
+ * \param conn              The connection on which the request was read.
+ * \param request_id        The request ID.
+ * \param request_offset    The offset of the request.
+ * \param id                The block or transaction ID of the request.
+ *
+ * \returns true if the request was answered, and false if it must be sent to
+ * the data service.
+ */
+bool unauthorized_protocol_service_response_cache_write(
+    unauthorized_protocol_connection_t* conn, uint32_t request_id,
+    uint32_t request_offset, const uint8_t* id);
+
+/**
+ * \brief Write a command response to the client.
+ *
+ * If the current request is part of a batch, the response is added to the
+ * batch instead, and the batch response is written once every sub-request in
+ * the batch has been answered.  The server IV is advanced for each packet
+ * written.
+ *
+ * \param conn          The connection to which the response is written.
+ * \param payload       The response payload.
+ * \param size          The size of the response payload.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the batch response could not be
+ *        grown.
+ *      - any of the errors returned by \ref ipc_write_authed_data_noblock().
+ */
+int unauthorized_protocol_connection_write_response(
+    unauthorized_protocol_connection_t* conn, const void* payload,
+    size_t size);
+
+/**
+ * \brief Start streaming a block whose certificate is too large for a single
+ * stream chunk to the client.
+ *
+ * Stream frames can't be interleaved with other responses, so the stream
+ * starts once the responses to this connection's earlier requests have been
+ * written, and no further requests are dispatched until it ends.
+ *
+ * \param conn              The connection to which the block is streamed.
+ * \param dresp             The first slice of the block certificate.
+ */
+void unauthorized_protocol_connection_block_stream_start(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_block_cert_read_t* dresp);
+
+/**
+ * \brief Write a slice of a streamed block to the client.
+ *
+ * The begin frame and response header precede the first slice, and the end
+ * frame follows the last.  Once the stream has begun, a failure can't be
+ * reported to the client, so the connection is closed instead.
+ *
+ * \param conn              The connection to which the block is streamed.
+ * \param dresp             The slice of the block certificate.
+ */
+void unauthorized_protocol_connection_block_stream_write(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_block_cert_read_t* dresp);
+
+/**
+ * \brief Request the next slice of a streamed block from the data service, if
+ * the client socket's write buffer has room for it.
+ *
+ * \param conn              The connection to which the block is streamed.
+ */
+void unauthorized_protocol_connection_block_stream_continue(
+    unauthorized_protocol_connection_t* conn);
+
 /**
  * \brief Write an error response to the socket and set the connection state to
  * unauthorized.
@@ -395,6 +1277,30 @@ void unauthorized_protocol_service_handle_request_latest_block_id_get(
     unauthorized_protocol_connection_t* conn, uint32_t request_offset,
     const uint8_t* breq, size_t size);
 
+/**
+ * \brief Handle a block_notify_subscribe request.
+ *
+ * \param conn              The connection making this request.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_block_notify_subscribe(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* breq, size_t size);
+
+/**
+ * \brief Handle an artifact_watch request.
+ *
+ * \param conn              The connection making this request.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_artifact_watch(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* breq, size_t size);
+
 /**
  * \brief Handle a transaction submit request.
  *
@@ -527,6 +1433,21 @@ void unauthorized_protocol_service_handle_request_artifact_last_txn_get(
     unauthorized_protocol_connection_t* conn, uint32_t request_offset,
     const uint8_t* breq, size_t size);
 
+/**
+ * \brief Handle a batch request.
+ *
+ * Each sub-request in the batch is dispatched as if it had arrived on its own,
+ * and the responses are collected into a single batch response.
+ *
+ * \param conn              The connection.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_batch(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* breq, size_t size);
+
 /**
  * \brief Handle a status get request.
  *
@@ -540,17 +1461,230 @@ void unauthorized_protocol_service_handle_request_status_get(
     const uint8_t* breq, size_t size);
 
 /**
- * \brief Request that a dataservice child context be created.
+ * \brief Handle a session ticket get request.
  *
- * \param conn      The connection to be assigned a child context when this
- *                  request completes.
+ * \param conn              The connection.
+ * \param request_offset    The offset of the request.
+ * \param breq              The bytestream of the request.
+ * \param size              The size of this request bytestream.
+ */
+void unauthorized_protocol_service_handle_request_session_ticket_get(
+    unauthorized_protocol_connection_t* conn, uint32_t request_offset,
+    const uint8_t* breq, size_t size);
+
+/**
+ * \brief Derive the key that seals session tickets.
+ *
+ * The key is derived from the agent private key, so every protocol service
+ * worker for this agent derives the same key, and can redeem tickets issued
+ * by any of them.
+ *
+ * \param svc       The protocol service instance, with its agent private key
+ *                  set.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the key could
+ *        not be derived.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_key_init(
+    unauthorized_protocol_service_instance_t* svc);
+
+/**
+ * \brief Seal or unseal the session key in a session ticket.
+ *
+ * The session key is masked with a pad derived from the ticket key and the
+ * ticket id, so applying this twice restores the session key.
+ *
+ * \param svc       The protocol service instance.
+ * \param ticket    The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket, whose
+ *                  session key field is updated in place.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the pad could
+ *        not be derived.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_seal(
+    unauthorized_protocol_service_instance_t* svc, uint8_t* ticket);
+
+/**
+ * \brief Compute the MAC of a session ticket.
+ *
+ * The MAC covers the entity to which the ticket is issued and every field of
+ * the ticket before the MAC, keyed with the ticket key.
+ *
+ * \param svc           The protocol service instance.
+ * \param entity_uuid   The entity to which the ticket is issued.
+ * \param ticket        The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket.
+ * \param mac           Array to receive the
+ *                      UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_SIZE
+ *                      byte MAC.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the MAC could
+ *        not be computed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_mac(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* entity_uuid,
+    const uint8_t* ticket, uint8_t* mac);
+
+/**
+ * \brief Issue a session ticket for an authorized connection.
  *
- * This connection is pushed to the dataservice context create list, where it
- * will remain until the next dataservice context create request completes.
+ * The ticket id and its session key are derived from the connection's shared
+ * secret, so issuing a ticket does not need the random service.  The ticket
+ * id input also carries a per-service counter, so tickets issued to the same
+ * connection before its IV moves on are still distinct.  The session key is
+ * sealed into the ticket, so the service keeps no state for it.
+ *
+ * \param conn      The connection for which the ticket is issued.
+ * \param ticket    Array to receive the PROTOCOLSERVICE_SESSION_TICKET_SIZE
+ *                  byte ticket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the ticket or
+ *        session key could not be derived.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_issue(
+    unauthorized_protocol_connection_t* conn, uint8_t* ticket);
+
+/**
+ * \brief Open a session ticket, without redeeming it.
+ *
+ * The ticket must carry a valid MAC for the entity presenting it, must not
+ * have expired, and must not already have been redeemed.
+ *
+ * \param svc           The protocol service instance.
+ * \param entity_uuid   The entity presenting the ticket.
+ * \param ticket        The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket.
+ * \param session_key   The initialized buffer to receive the session key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID if the ticket is
+ *        forged, was issued to another entity, has expired, or has already
+ *        been redeemed.
+ *      - a non-zero error code if the ticket could not be checked.
+ */
+int unauthorized_protocol_service_session_ticket_open(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* entity_uuid,
+    const uint8_t* ticket, vccrypt_buffer_t* session_key);
+
+/**
+ * \brief Redeem an opened session ticket, so that it can't be redeemed again.
+ *
+ * \param svc           The protocol service instance.
+ * \param ticket        The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID if the ticket has
+ *        already been redeemed, or too many unexpired tickets have been
+ *        redeemed to remember another.
+ */
+int unauthorized_protocol_service_session_ticket_redeem(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* ticket);
+
+/**
+ * \brief Dispose of the session ticket key, and forget every redeemed session
+ * ticket.
+ *
+ * \param svc           The protocol service instance.
+ */
+void unauthorized_protocol_service_session_tickets_dispose(
+    unauthorized_protocol_service_instance_t* svc);
+
+/**
+ * \brief Assign a pooled dataservice child context to a connection.
+ *
+ * \param conn      The connection to be assigned a child context.
+ *
+ * The connection shares an open child context with the same capabilities if
+ * one has room, and can read commands right away.  Otherwise, a new child
+ * context is requested, and the connection waits on the dataservice context
+ * create list until it is created.
  */
 void unauthorized_protocol_service_dataservice_request_child_context(
     unauthorized_protocol_connection_t* conn);
 
+/**
+ * \brief Detach a connection from its pooled dataservice child context.
+ *
+ * \param conn      The connection to detach.
+ *
+ * The child context stays open for later connections, unless it carries
+ * notification subscriptions or enough idle child contexts with the same
+ * capabilities are already open.
+ */
+void unauthorized_protocol_child_context_release(
+    unauthorized_protocol_connection_t* conn);
+
+/**
+ * \brief Close a pooled dataservice child context, returning its pool entry
+ * to the free state.
+ *
+ * If responses are still owed on the child context, it is left closing, and
+ * is closed once the last of them arrives.
+ *
+ * \param svc       The protocol service instance.
+ * \param cc        The child context to close.
+ */
+void unauthorized_protocol_child_context_close(
+    unauthorized_protocol_service_instance_t* svc,
+    unauthorized_protocol_child_context_t* cc);
+
+/**
+ * \brief Find the connection that a dataservice response answers.
+ *
+ * The oldest request of that connection is made its current request.
+ *
+ * \param cc        The child context on which the response was received.
+ *
+ * \returns the connection, or NULL if the request's connection has closed.
+ */
+unauthorized_protocol_connection_t* unauthorized_protocol_child_context_route(
+    unauthorized_protocol_child_context_t* cc);
+
+/**
+ * \brief Add artifacts to the set that a connection watches.
+ *
+ * \param conn          The connection watching these artifacts.
+ * \param artifact_ids  The 16 byte artifact ids, laid end to end.
+ * \param count         The number of artifact ids.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_DATASERVICE_ARTIFACT_WATCH_LIMIT if the connection would
+ *        watch too many artifacts.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if the set could not be grown.
+ */
+int unauthorized_protocol_connection_artifact_watch_add(
+    unauthorized_protocol_connection_t* conn, const uint8_t* artifact_ids,
+    size_t count);
+
+/**
+ * \brief Check whether a connection watches an artifact.
+ *
+ * \param conn          The connection to check.
+ * \param artifact_id   The 16 byte artifact id.
+ *
+ * \returns true if the connection watches this artifact, and false otherwise.
+ */
+bool unauthorized_protocol_connection_artifact_watch_find(
+    const unauthorized_protocol_connection_t* conn,
+    const uint8_t* artifact_id);
+
 /**
  * Handle a child_context_create response.
  *
@@ -584,6 +1718,56 @@ void ups_dispatch_dataservice_response_block_id_latest_read(
     unauthorized_protocol_service_instance_t* svc, const void* resp,
     size_t resp_size);
 
+/**
+ * Handle a block_notify_subscribe response.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The response from the block notify subscribe call.
+ * \param resp_size         The size of the response.
+ */
+void ups_dispatch_dataservice_response_block_notify_subscribe(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size);
+
+/**
+ * Handle a block commit notification from the data service.
+ *
+ * The notification is pushed to the subscribed connection, outside of the
+ * request and response cycle.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The notification packet.
+ * \param resp_size         The size of the notification packet.
+ */
+void ups_dispatch_dataservice_notification_block_commit(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size);
+
+/**
+ * Handle an artifact_watch response.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The response from the artifact watch call.
+ * \param resp_size         The size of the response.
+ */
+void ups_dispatch_dataservice_response_artifact_watch(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size);
+
+/**
+ * Handle an artifact update notification from the data service.
+ *
+ * The notification is pushed to the watching connection, outside of the
+ * request and response cycle.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The notification packet.
+ * \param resp_size         The size of the notification packet.
+ */
+void ups_dispatch_dataservice_notification_artifact_update(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size);
+
 /**
  * Handle a block id by height read response.
  *
@@ -627,6 +1811,17 @@ void ups_dispatch_dataservice_response_block_read(
     unauthorized_protocol_connection_t* conn,
     const dataservice_response_block_get_t* dresp);
 
+/**
+ * Handle a block certificate read response.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The response from the block certificate read call.
+ * \param resp_size         The size of the response.
+ */
+void ups_dispatch_dataservice_response_block_cert_read(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size);
+
 /**
  * Handle a block id read next response.
  *
@@ -36,6 +36,8 @@
  * \param logsock       Socket used to communicate with the logger.
  * \param acceptsock    Socket used to receive accepted peers.
  * \param datasock      Socket used to communicate with the data service.
+ * \param ring          Optional shared-memory ring to the data service, or
+ *                      NULL.  The caller keeps ownership of these descriptors.
  * \param protopid      Pointer to the protocol service pid, to be updated on
  *                      the successful completion of this function.
  * \param runsecure     Set to false if we are not being run in secure mode.
@@ -65,9 +67,13 @@
  */
 int unauthorized_protocol_proc(
     const bootstrap_config_t* bconf, const agent_config_t* conf, int randomsock,
-    int logsock, int acceptsock, int datasock, pid_t* protopid, bool runsecure)
+    int logsock, int acceptsock, int datasock,
+    const ipc_ring_descriptors_t* ring, pid_t* protopid, bool runsecure)
 {
     int retval = 1;
+    int ringmem = (NULL != ring) ? ring->memfd : -1;
+    int ringlhs = (NULL != ring) ? ring->lhs : -1;
+    int ringrhs = (NULL != ring) ? ring->rhs : -1;
     uid_t uid;
     gid_t gid;
 
@@ -132,9 +138,21 @@ int unauthorized_protocol_proc(
         }
 
         /* move the fds out of the way. */
-        if (AGENTD_STATUS_SUCCESS !=
-            privsep_protect_descriptors(
-                &randomsock, &acceptsock, &logsock, &datasock, NULL))
+        if (NULL != ring)
+        {
+            retval =
+                privsep_protect_descriptors(
+                    &randomsock, &acceptsock, &logsock, &datasock, &ringmem,
+                    &ringlhs, &ringrhs, NULL);
+        }
+        else
+        {
+            retval =
+                privsep_protect_descriptors(
+                    &randomsock, &acceptsock, &logsock, &datasock, NULL);
+        }
+
+        if (AGENTD_STATUS_SUCCESS != retval)
         {
             retval = AGENTD_ERROR_CONFIG_PRIVSEP_SETFDS_FAILURE;
             goto done;
@@ -164,9 +182,29 @@ int unauthorized_protocol_proc(
             goto done;
         }
 
+        /* hand over the ring, if there is one. */
+        if (NULL != ring)
+        {
+            retval =
+                privsep_setfds(
+                    ringmem, /* ==> */ AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_MEM,
+                    ringlhs, /* ==> */ AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_LHS,
+                    ringrhs, /* ==> */ AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_RHS,
+                    -1);
+            if (0 != retval)
+            {
+                perror("privsep_setfds");
+                retval = AGENTD_ERROR_PROTOCOLSERVICE_PRIVSEP_SETFDS_FAILURE;
+                goto done;
+            }
+        }
+
         /* close any socket above the given value. */
         retval =
-            privsep_close_other_fds(AGENTD_FD_UNAUTHORIZED_PROTOSVC_RANDOM);
+            privsep_close_other_fds(
+                (NULL != ring)
+                    ? AGENTD_FD_UNAUTHORIZED_PROTOSVC_RING_RHS
+                    : AGENTD_FD_UNAUTHORIZED_PROTOSVC_RANDOM);
         if (0 != retval)
         {
             perror("privsep_close_other_fds");
@@ -15,6 +15,9 @@
 /* forward decls. */
 static int unauthorized_protocol_service_handle_random_response(
     unauthorized_protocol_service_instance_t* svc);
+static int unauthorized_protocol_service_entropy_pool_add(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* bresp,
+    size_t size);
 
 /**
  * \brief Read data from the random service socket.
@@ -107,6 +110,15 @@ static int unauthorized_protocol_service_handle_random_response(
     bresp += sizeof(request_offset);
     size -= sizeof(request_offset);
     request_offset = ntohl(request_offset);
+
+    /* is this a refill for the entropy pool? */
+    if (UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_OFFSET == request_offset)
+    {
+        retval =
+            unauthorized_protocol_service_entropy_pool_add(svc, bresp, size);
+        goto cleanup_resp;
+    }
+
     if (request_offset >= svc->num_connections)
     {
         retval = AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE;
@@ -173,3 +185,48 @@ cleanup_resp:
 done:
     return retval;
 }
+
+/**
+ * \brief Add the bytes from a refill response to the entropy pool.
+ *
+ * \param svc               The protocol service instance.
+ * \param bresp             The response, starting at the status.
+ * \param size              The size of the response, starting at the status.
+ *
+ * \returns a status code indicating success or failure.
+ */
+static int unauthorized_protocol_service_entropy_pool_add(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* bresp,
+    size_t size)
+{
+    uint32_t status;
+
+    /* this refill is no longer pending. */
+    if (svc->entropy_refills_pending > 0U)
+    {
+        --svc->entropy_refills_pending;
+    }
+
+    /* a failed refill leaves the pool as is.  Handshakes fall back to asking
+     * the random service directly until a later refill succeeds. */
+    memcpy(&status, bresp, sizeof(status));
+    bresp += sizeof(status);
+    size -= sizeof(status);
+    if (AGENTD_STATUS_SUCCESS != ntohl(status))
+    {
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* add as many bytes as fit in the pool. */
+    size_t room =
+        UNAUTHORIZED_PROTOCOL_SERVICE_ENTROPY_POOL_SIZE - svc->entropy_pool_size;
+    if (size > room)
+    {
+        size = room;
+    }
+
+    memcpy(svc->entropy_pool + svc->entropy_pool_size, bresp, size);
+    svc->entropy_pool_size += size;
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_response_cache_write.c
+ *
+ * \brief Answer a request from the response cache.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Answer a request from the response cache, if its response is cached.
+ *
+ * \param conn              The connection on which the request was read.
+ * \param request_id        The request ID.
+ * \param request_offset    The offset of the request.
+ * \param id                The block or transaction ID of the request.
+ *
+ * \returns true if the request was answered, and false if it must be sent to
+ * the data service.
+ */
+bool unauthorized_protocol_service_response_cache_write(
+    unauthorized_protocol_connection_t* conn, uint32_t request_id,
+    uint32_t request_offset, const uint8_t* id)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != id);
+
+    const unauthorized_protocol_response_cache_entry_t* entry =
+        unauthorized_protocol_response_cache_find(
+            &conn->svc->response_cache, request_id, id);
+    if (NULL == entry)
+    {
+        return false;
+    }
+
+    /* build the payload: the header for this request, then the cached
+     * response. */
+    uint32_t net_method = htonl(request_id);
+    uint32_t net_status = htonl(AGENTD_STATUS_SUCCESS);
+    uint32_t net_offset = htonl(request_offset);
+    size_t payload_size = 3 * sizeof(uint32_t) + entry->size;
+    uint8_t* payload = (uint8_t*)malloc(payload_size);
+    if (NULL == payload)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, request_id, AGENTD_ERROR_GENERAL_OUT_OF_MEMORY,
+            request_offset, true);
+        return true;
+    }
+
+    memcpy(payload, &net_method, 4);
+    memcpy(payload + 4, &net_status, 4);
+    memcpy(payload + 8, &net_offset, 4);
+    memcpy(payload + 12, entry->data, entry->size);
+
+    /* attempt to write this payload to the socket. */
+    int retval =
+        unauthorized_protocol_connection_write_response(
+            conn, payload, payload_size);
+
+    /* clean up payload. */
+    memset(payload, 0, payload_size);
+    free(payload);
+
+    /* check status of write. */
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return true;
+    }
+
+    /* evolve connection state. */
+    conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
+
+    /* set the write callback. */
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+
+    return true;
+}
@@ -0,0 +1,196 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_schedule.c
+ *
+ * \brief Dispatch queued client requests in deficit round-robin order.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static void unauthorized_protocol_service_schedule_dispatch(
+    unauthorized_protocol_connection_t* conn, const struct timespec* now);
+
+/**
+ * \brief Dispatch queued client requests, sharing the data service fairly
+ * between connections.
+ *
+ * Connections with queued requests take turns in deficit round-robin order.
+ * On each turn, a connection may dispatch as many data service requests as
+ * its entity's weight allows, and any overdraft is charged against its next
+ * turn.  Dispatching stops while
+ * UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX requests are waiting
+ * on the data service.  A connection streaming a block leaves the schedule,
+ * keeping its queued requests, and rejoins it when the stream ends.
+ *
+ * \param svc           The protocol service instance.
+ */
+void unauthorized_protocol_service_schedule(
+    unauthorized_protocol_service_instance_t* svc)
+{
+    struct timespec now;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    while (NULL != svc->schedule_head
+        && svc->dataservice_inflight
+            < UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX)
+    {
+        unauthorized_protocol_connection_t* conn = svc->schedule_head;
+
+        /* a connection earns its quantum once per turn, and always earns
+         * something, so that every turn makes progress. */
+        if (!conn->schedule_credited)
+        {
+            int64_t weight =
+                (conn->schedule_weight > 0U) ? conn->schedule_weight : 1;
+            conn->schedule_deficit +=
+                UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_QUANTUM * weight;
+            conn->schedule_credited = true;
+        }
+
+        /* dispatch requests while this connection has credit. */
+        while (conn->schedule_active
+            && !conn->block_stream.active
+            && conn->queue_count > 0U
+            && conn->schedule_deficit > 0
+            && svc->dataservice_inflight
+                < UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX)
+        {
+            /* a connection that is closing gets nothing more. */
+            if (APCS_READ_COMMAND_REQ_FROM_CLIENT != conn->state
+             && APCS_WRITE_COMMAND_RESP_TO_CLIENT != conn->state)
+            {
+                unauthorized_protocol_service_schedule_remove(conn);
+                break;
+            }
+
+            unauthorized_protocol_service_schedule_dispatch(conn, &now);
+        }
+
+        /* a connection that was closed has already left the schedule. */
+        if (!conn->schedule_active)
+        {
+            continue;
+        }
+
+        /* the in-flight limit was reached, so this turn resumes later. */
+        if (conn->queue_count > 0U && conn->schedule_deficit > 0
+         && !conn->block_stream.active)
+        {
+            break;
+        }
+
+        /* the turn is over, so take this connection off the front. */
+        svc->schedule_head = conn->schedule_next;
+        if (NULL == svc->schedule_head)
+        {
+            svc->schedule_tail = NULL;
+        }
+
+        conn->schedule_next = NULL;
+        conn->schedule_credited = false;
+
+        /* an idle or streaming connection leaves the schedule, and can't
+         * save up credit. */
+        if (0U == conn->queue_count || conn->block_stream.active)
+        {
+            conn->schedule_active = false;
+            conn->schedule_deficit = 0;
+            continue;
+        }
+
+        /* otherwise, it waits for its next turn. */
+        if (NULL == svc->schedule_tail)
+        {
+            svc->schedule_head = conn;
+        }
+        else
+        {
+            svc->schedule_tail->schedule_next = conn;
+        }
+
+        svc->schedule_tail = conn;
+    }
+}
+
+/**
+ * \brief Dispatch the request at the front of a connection's queue.
+ *
+ * The connection is charged for each data service request that the request
+ * makes, or for one request if it is answered without the data service.
+ *
+ * \param conn          The connection whose request is dispatched.
+ * \param now           The time at which this round of scheduling started.
+ */
+static void unauthorized_protocol_service_schedule_dispatch(
+    unauthorized_protocol_connection_t* conn, const struct timespec* now)
+{
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+    unauthorized_protocol_queued_request_t queued;
+
+    /* take the request off the queue. */
+    memcpy(
+        &queued, conn->queued_requests + conn->queue_head,
+        sizeof(queued));
+    memset(conn->queued_requests + conn->queue_head, 0, sizeof(queued));
+    conn->queue_head =
+        (conn->queue_head + 1U) % UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX;
+    --conn->queue_count;
+    --svc->schedule_queued;
+
+    if (UNAUTH_PROTOCOL_REQ_ID_BATCH == queued.request_id)
+    {
+        conn->batch_queued = false;
+    }
+
+    /* record how long this request waited. */
+    int64_t wait_usec =
+        (int64_t)(now->tv_sec - queued.enqueued.tv_sec) * 1000000
+            + (now->tv_nsec - queued.enqueued.tv_nsec) / 1000;
+    if (wait_usec < 0)
+    {
+        wait_usec = 0;
+    }
+
+    ++svc->schedule_dispatched;
+    svc->schedule_wait_total_usec += (uint64_t)wait_usec;
+    if ((uint64_t)wait_usec > svc->schedule_wait_max_usec)
+    {
+        svc->schedule_wait_max_usec = (uint64_t)wait_usec;
+    }
+
+    /* the request ID and offset precede the request body. */
+    const size_t header_size = 2 * sizeof(uint32_t);
+    size_t pending_before = conn->pending_count;
+
+    /* decode and dispatch this request, which stands on its own. */
+    conn->current_request_batched = false;
+    unauthorized_protocol_service_decode_and_dispatch(
+        conn, queued.request_id, queued.request_offset,
+        (const uint8_t*)queued.packet + header_size,
+        queued.packet_size - header_size);
+
+    /* charge the connection for what this request cost. */
+    if (conn->pending_count > pending_before)
+    {
+        conn->schedule_deficit -=
+            (int64_t)(conn->pending_count - pending_before);
+    }
+    else
+    {
+        conn->schedule_deficit -= 1;
+    }
+
+    /* clean up the request packet. */
+    memset(queued.packet, 0, queued.packet_size);
+    free(queued.packet);
+}
@@ -0,0 +1,48 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_schedule_add.c
+ *
+ * \brief Add a connection to the scheduler.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Add a connection with queued requests to the end of the schedule.
+ *
+ * A connection that is already in the schedule keeps its place.
+ *
+ * \param conn          The connection to add.
+ */
+void unauthorized_protocol_service_schedule_add(
+    unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+
+    if (conn->schedule_active)
+    {
+        return;
+    }
+
+    conn->schedule_active = true;
+    conn->schedule_credited = false;
+    conn->schedule_deficit = 0;
+    conn->schedule_next = NULL;
+
+    if (NULL == svc->schedule_tail)
+    {
+        svc->schedule_head = conn;
+    }
+    else
+    {
+        svc->schedule_tail->schedule_next = conn;
+    }
+
+    svc->schedule_tail = conn;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_schedule_remove.c
+ *
+ * \brief Remove a connection from the scheduler.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Remove a connection from the scheduler, dropping any requests that it
+ * has queued.
+ *
+ * \param conn          The connection to remove.
+ */
+void unauthorized_protocol_service_schedule_remove(
+    unauthorized_protocol_connection_t* conn)
+{
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+
+    /* drop the queued requests. */
+    while (conn->queue_count > 0U)
+    {
+        unauthorized_protocol_queued_request_t* queued =
+            conn->queued_requests + conn->queue_head;
+
+        memset(queued->packet, 0, queued->packet_size);
+        free(queued->packet);
+        memset(queued, 0, sizeof(unauthorized_protocol_queued_request_t));
+
+        conn->queue_head =
+            (conn->queue_head + 1U) % UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX;
+        --conn->queue_count;
+        --svc->schedule_queued;
+    }
+
+    conn->batch_queued = false;
+
+    /* unlink the connection from the schedule. */
+    if (conn->schedule_active)
+    {
+        unauthorized_protocol_connection_t* prev = NULL;
+        unauthorized_protocol_connection_t* i = svc->schedule_head;
+        while (i != conn)
+        {
+            prev = i;
+            i = i->schedule_next;
+        }
+
+        if (NULL == prev)
+        {
+            svc->schedule_head = conn->schedule_next;
+        }
+        else
+        {
+            prev->schedule_next = conn->schedule_next;
+        }
+
+        if (svc->schedule_tail == conn)
+        {
+            svc->schedule_tail = prev;
+        }
+
+        conn->schedule_active = false;
+        conn->schedule_next = NULL;
+    }
+}
@@ -0,0 +1,150 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_session_ticket_issue.c
+ *
+ * \brief Issue a session ticket for an authorized connection.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Issue a session ticket for an authorized connection.
+ *
+ * The ticket id and its session key are derived from the connection's shared
+ * secret, so issuing a ticket does not need the random service.  The ticket
+ * id input also carries a per-service counter, so tickets issued to the same
+ * connection before its IV moves on are still distinct.  The session key is
+ * sealed into the ticket along with its expiry time, and the ticket is signed
+ * with the ticket key, so the service keeps no state for it and any worker
+ * can redeem it.
+ *
+ * \param conn      The connection for which the ticket is issued.
+ * \param ticket    Array to receive the PROTOCOLSERVICE_SESSION_TICKET_SIZE
+ *                  byte ticket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the ticket or
+ *        session key could not be derived.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_issue(
+    unauthorized_protocol_connection_t* conn, uint8_t* ticket)
+{
+    int retval;
+    unauthorized_protocol_service_instance_t* svc = conn->svc;
+    uint8_t sealed[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != conn);
+    MODEL_ASSERT(NULL != ticket);
+
+    /* create a buffer for the ticket id. */
+    vccrypt_buffer_t ticket_id;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &ticket_id, &svc->alloc_opts,
+            PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* the ticket id is derived from the shared secret, the client IV, and the
+     * service ticket counter.  The client IV only moves on once per request
+     * frame, so the counter keeps tickets issued within one batch apart. */
+    uint64_t ticket_input[2] = {
+        htonll(conn->client_iv),
+        htonll(svc->session_ticket_counter++) };
+    retval =
+        protocolservice_session_key_derive(
+            &svc->suite, &conn->shared_secret, ticket_input,
+            sizeof(ticket_input), &ticket_id);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_ticket_id;
+    }
+
+    /* create a buffer for the session key. */
+    vccrypt_buffer_t session_key;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+            &svc->suite, &session_key))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto cleanup_ticket_id;
+    }
+
+    /* the session key must fit the ticket. */
+    if (UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_SIZE !=
+            session_key.size)
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE;
+        goto cleanup_session_key;
+    }
+
+    /* the session key is derived from the shared secret and the ticket id,
+     * so the client can derive it too. */
+    retval =
+        protocolservice_session_key_derive(
+            &svc->suite, &conn->shared_secret, ticket_id.data,
+            ticket_id.size, &session_key);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_session_key;
+    }
+
+    /* lay out the ticket id, the expiry time, and the session key. */
+    uint64_t net_expires =
+        htonll(
+            (int64_t)time(NULL)
+                + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_LIFETIME);
+    memcpy(sealed, ticket_id.data, PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE);
+    memcpy(
+        sealed + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_EXPIRES_OFFSET,
+        &net_expires, sizeof(net_expires));
+    memcpy(
+        sealed + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_OFFSET,
+        session_key.data, session_key.size);
+
+    /* seal the session key. */
+    retval = unauthorized_protocol_service_session_ticket_seal(svc, sealed);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sealed;
+    }
+
+    /* sign the ticket for this entity. */
+    retval =
+        unauthorized_protocol_service_session_ticket_mac(
+            svc, conn->entity_uuid, sealed,
+            sealed + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_OFFSET);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_sealed;
+    }
+
+    /* copy the ticket to the caller. */
+    memcpy(ticket, sealed, PROTOCOLSERVICE_SESSION_TICKET_SIZE);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_sealed:
+    memset(sealed, 0, sizeof(sealed));
+
+cleanup_session_key:
+    dispose((disposable_t*)&session_key);
+
+cleanup_ticket_id:
+    dispose((disposable_t*)&ticket_id);
+
+done:
+    return retval;
+}
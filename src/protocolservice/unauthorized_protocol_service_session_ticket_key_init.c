@@ -0,0 +1,64 @@
+/**
+ * \file
+ * protocolservice/unauthorized_protocol_service_session_ticket_key_init.c
+ *
+ * \brief Derive the key that seals session tickets.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* the context data for the ticket key derivation. */
+static const char session_ticket_key_label[] = "agentd session ticket key";
+
+/**
+ * \brief Derive the key that seals session tickets.
+ *
+ * The key is derived from the agent private key, so every protocol service
+ * worker for this agent derives the same key, and can redeem tickets issued
+ * by any of them.
+ *
+ * \param svc       The protocol service instance, with its agent private key
+ *                  set.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the key could
+ *        not be derived.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_key_init(
+    unauthorized_protocol_service_instance_t* svc)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+
+    /* create a buffer for the ticket key. */
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &svc->session_ticket_key, &svc->alloc_opts,
+            svc->suite.mac_short_opts.mac_size))
+    {
+        return AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+    }
+
+    /* derive the ticket key from the agent private key. */
+    retval =
+        protocolservice_session_key_derive(
+            &svc->suite, &svc->agent_privkey, session_ticket_key_label,
+            sizeof(session_ticket_key_label) - 1, &svc->session_ticket_key);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        dispose((disposable_t*)&svc->session_ticket_key);
+        return retval;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_session_ticket_mac.c
+ *
+ * \brief Compute the MAC of a session ticket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* the domain of the MAC, which keeps it apart from the pad derivation. */
+#define SESSION_TICKET_MAC_DOMAIN 0x02U
+
+/**
+ * \brief Compute the MAC of a session ticket.
+ *
+ * The MAC covers the entity to which the ticket is issued and every field of
+ * the ticket before the MAC, keyed with the ticket key.  Binding the entity
+ * here means that the ticket doesn't need to carry it.
+ *
+ * \param svc           The protocol service instance.
+ * \param entity_uuid   The entity to which the ticket is issued.
+ * \param ticket        The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket.
+ * \param mac           Array to receive the
+ *                      UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_SIZE
+ *                      byte MAC.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the MAC could
+ *        not be computed.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_mac(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* entity_uuid,
+    const uint8_t* ticket, uint8_t* mac)
+{
+    int retval;
+    uint8_t mac_input[
+        1 + 16 + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_OFFSET];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+    MODEL_ASSERT(NULL != entity_uuid);
+    MODEL_ASSERT(NULL != ticket);
+    MODEL_ASSERT(NULL != mac);
+
+    /* create a buffer for the MAC. */
+    vccrypt_buffer_t mac_buffer;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &mac_buffer, &svc->alloc_opts,
+            UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_SIZE))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* the MAC covers the entity and the ticket fields. */
+    mac_input[0] = SESSION_TICKET_MAC_DOMAIN;
+    memcpy(mac_input + 1, entity_uuid, 16);
+    memcpy(
+        mac_input + 1 + 16, ticket,
+        UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_OFFSET);
+    retval =
+        protocolservice_session_key_derive(
+            &svc->suite, &svc->session_ticket_key, mac_input,
+            sizeof(mac_input), &mac_buffer);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_mac_buffer;
+    }
+
+    /* copy the MAC to the caller. */
+    memcpy(mac, mac_buffer.data, mac_buffer.size);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_mac_buffer:
+    dispose((disposable_t*)&mac_buffer);
+
+done:
+    memset(mac_input, 0, sizeof(mac_input));
+    return retval;
+}
@@ -0,0 +1,124 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_session_ticket_open.c
+ *
+ * \brief Open a session ticket, without redeeming it.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <vccrypt/compare.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Open a session ticket, without redeeming it.
+ *
+ * The ticket must carry a valid MAC for the entity presenting it, must not
+ * have expired, and must not already have been redeemed.  The ticket is only
+ * redeemed once the client has proven that it holds the session key, so a
+ * request that fails that proof doesn't use up the ticket.
+ *
+ * \param svc           The protocol service instance.
+ * \param entity_uuid   The entity presenting the ticket.
+ * \param ticket        The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket.
+ * \param session_key   The initialized buffer to receive the session key.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID if the ticket is
+ *        forged, was issued to another entity, has expired, or has already
+ *        been redeemed.
+ *      - a non-zero error code if the ticket could not be checked.
+ */
+int unauthorized_protocol_service_session_ticket_open(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* entity_uuid,
+    const uint8_t* ticket, vccrypt_buffer_t* session_key)
+{
+    int retval;
+    uint8_t mac[UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_SIZE];
+    uint8_t opened[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+    uint64_t net_expires;
+    time_t now = time(NULL);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+    MODEL_ASSERT(NULL != entity_uuid);
+    MODEL_ASSERT(NULL != ticket);
+    MODEL_ASSERT(NULL != session_key);
+
+    /* the session key must fit the ticket. */
+    if (UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_SIZE !=
+            session_key->size)
+    {
+        return AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID;
+    }
+
+    /* the ticket must have been issued by this agent to this entity. */
+    retval =
+        unauthorized_protocol_service_session_ticket_mac(
+            svc, entity_uuid, ticket, mac);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto done;
+    }
+
+    const uint8_t* ticket_mac =
+        ticket + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAC_OFFSET;
+    if (0 != crypto_memcmp(mac, ticket_mac, sizeof(mac)))
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID;
+        goto done;
+    }
+
+    /* the ticket must not have expired. */
+    memcpy(
+        &net_expires,
+        ticket + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_EXPIRES_OFFSET,
+        sizeof(net_expires));
+    if ((int64_t)ntohll(net_expires) <= (int64_t)now)
+    {
+        retval = AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID;
+        goto done;
+    }
+
+    /* the ticket must not already have been redeemed. */
+    for (size_t i = 0; i < UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAX; ++i)
+    {
+        unauthorized_protocol_session_ticket_t* entry =
+            svc->session_tickets_redeemed + i;
+
+        if (entry->expires > now
+         && 0 == crypto_memcmp(
+                    entry->ticket_id, ticket, sizeof(entry->ticket_id)))
+        {
+            retval = AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID;
+            goto done;
+        }
+    }
+
+    /* unseal the session key. */
+    memcpy(opened, ticket, sizeof(opened));
+    retval = unauthorized_protocol_service_session_ticket_seal(svc, opened);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_opened;
+    }
+
+    memcpy(
+        session_key->data,
+        opened + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_OFFSET,
+        session_key->size);
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_opened:
+    memset(opened, 0, sizeof(opened));
+
+done:
+    memset(mac, 0, sizeof(mac));
+    return retval;
+}
@@ -0,0 +1,82 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_session_ticket_redeem.c
+ *
+ * \brief Redeem an opened session ticket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <vccrypt/compare.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Redeem an opened session ticket, so that it can't be redeemed again.
+ *
+ * The ticket id is remembered until the ticket expires.  Tickets are sealed
+ * rather than held by a worker, so each worker remembers the tickets that it
+ * has redeemed.  If every slot holds an unexpired ticket, the ticket is
+ * rejected, and the client falls back to a full handshake.
+ *
+ * \param svc           The protocol service instance.
+ * \param ticket        The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID if the ticket has
+ *        already been redeemed, or too many unexpired tickets have been
+ *        redeemed to remember another.
+ */
+int unauthorized_protocol_service_session_ticket_redeem(
+    unauthorized_protocol_service_instance_t* svc, const uint8_t* ticket)
+{
+    unauthorized_protocol_session_ticket_t* slot = NULL;
+    uint64_t net_expires;
+    time_t now = time(NULL);
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+    MODEL_ASSERT(NULL != ticket);
+
+    /* look for this ticket, remembering a free slot. */
+    for (size_t i = 0; i < UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_MAX; ++i)
+    {
+        unauthorized_protocol_session_ticket_t* entry =
+            svc->session_tickets_redeemed + i;
+
+        if (entry->expires <= now)
+        {
+            if (NULL == slot)
+            {
+                slot = entry;
+            }
+
+            continue;
+        }
+
+        if (0 == crypto_memcmp(
+                    entry->ticket_id, ticket, sizeof(entry->ticket_id)))
+        {
+            return AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID;
+        }
+    }
+
+    /* a ticket that can't be remembered can't be redeemed. */
+    if (NULL == slot)
+    {
+        return AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID;
+    }
+
+    /* remember this ticket until it expires. */
+    memcpy(
+        &net_expires,
+        ticket + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_EXPIRES_OFFSET,
+        sizeof(net_expires));
+    memcpy(slot->ticket_id, ticket, sizeof(slot->ticket_id));
+    slot->expires = (time_t)ntohll(net_expires);
+
+    return AGENTD_STATUS_SUCCESS;
+}
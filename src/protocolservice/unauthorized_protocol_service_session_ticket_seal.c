@@ -0,0 +1,85 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_session_ticket_seal.c
+ *
+ * \brief Seal or unseal the session key in a session ticket.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* the domain of the pad derivation, which keeps it apart from the MAC. */
+#define SESSION_TICKET_PAD_DOMAIN 0x01U
+
+/**
+ * \brief Seal or unseal the session key in a session ticket.
+ *
+ * The session key is masked with a pad derived from the ticket key and the
+ * ticket id, so applying this twice restores the session key.  Each ticket id
+ * is only issued once, so no pad is reused.
+ *
+ * \param svc       The protocol service instance.
+ * \param ticket    The PROTOCOLSERVICE_SESSION_TICKET_SIZE byte ticket, whose
+ *                  session key field is updated in place.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_KEY_DERIVATION_FAILURE if the pad could
+ *        not be derived.
+ *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
+ *        encountered.
+ */
+int unauthorized_protocol_service_session_ticket_seal(
+    unauthorized_protocol_service_instance_t* svc, uint8_t* ticket)
+{
+    int retval;
+    uint8_t pad_input[1 + PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE];
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+    MODEL_ASSERT(NULL != ticket);
+
+    /* create a buffer for the pad. */
+    vccrypt_buffer_t pad;
+    if (VCCRYPT_STATUS_SUCCESS !=
+        vccrypt_buffer_init(
+            &pad, &svc->alloc_opts,
+            UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_SIZE))
+    {
+        retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
+        goto done;
+    }
+
+    /* derive the pad from the ticket id. */
+    pad_input[0] = SESSION_TICKET_PAD_DOMAIN;
+    memcpy(pad_input + 1, ticket, PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE);
+    retval =
+        protocolservice_session_key_derive(
+            &svc->suite, &svc->session_ticket_key, pad_input,
+            sizeof(pad_input), &pad);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        goto cleanup_pad;
+    }
+
+    /* mask the session key with the pad. */
+    const uint8_t* bpad = (const uint8_t*)pad.data;
+    uint8_t* key =
+        ticket + UNAUTHORIZED_PROTOCOL_SERVICE_SESSION_TICKET_KEY_OFFSET;
+    for (size_t i = 0; i < pad.size; ++i)
+    {
+        key[i] ^= bpad[i];
+    }
+
+    /* success. */
+    retval = AGENTD_STATUS_SUCCESS;
+
+cleanup_pad:
+    dispose((disposable_t*)&pad);
+
+done:
+    return retval;
+}
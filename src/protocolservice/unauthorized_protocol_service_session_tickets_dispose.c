@@ -0,0 +1,30 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_session_tickets_dispose.c
+ *
+ * \brief Dispose of the session ticket key and redeemed session tickets.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Dispose of the session ticket key, and forget every redeemed session
+ * ticket.
+ *
+ * \param svc           The protocol service instance.
+ */
+void unauthorized_protocol_service_session_tickets_dispose(
+    unauthorized_protocol_service_instance_t* svc)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != svc);
+
+    dispose((disposable_t*)&svc->session_ticket_key);
+
+    memset(
+        svc->session_tickets_redeemed, 0,
+        sizeof(svc->session_tickets_redeemed));
+}
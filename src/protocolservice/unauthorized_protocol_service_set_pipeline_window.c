@@ -0,0 +1,40 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_set_pipeline_window.c
+ *
+ * \brief Set the number of requests each connection can have outstanding.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Set the number of requests that each connection can have
+ * outstanding.
+ *
+ * The window is clamped to between 1 and
+ * UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX.  A window of 1 processes one
+ * request at a time, as clients without pipelining expect.
+ *
+ * \param inst          The service instance.
+ * \param window        The number of outstanding requests to allow.
+ */
+void unauthorized_protocol_service_set_pipeline_window(
+    unauthorized_protocol_service_instance_t* inst, size_t window)
+{
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != inst);
+
+    if (window < 1U)
+    {
+        window = 1U;
+    }
+    else if (window > UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX)
+    {
+        window = UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX;
+    }
+
+    inst->pipeline_window = window;
+}
@@ -0,0 +1,64 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_setting_get.c
+ *
+ * \brief Get a numeric setting from the environment.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Get a numeric setting from the environment.
+ *
+ * \param name          The name of the environment variable.
+ * \param default_value The value to use if the variable isn't set.
+ * \param min           The smallest value allowed.
+ * \param max           The largest value allowed.
+ * \param value         Pointer to receive the value.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID if the variable is not a
+ *        decimal number from min to max.
+ */
+int unauthorized_protocol_service_setting_get(
+    const char* name, size_t default_value, size_t min, size_t max,
+    size_t* value)
+{
+    char* end = NULL;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != name);
+    MODEL_ASSERT(min <= max);
+    MODEL_ASSERT(NULL != value);
+
+    /* use the default if the setting isn't set. */
+    const char* setting = getenv(name);
+    if (NULL == setting)
+    {
+        *value = default_value;
+        return AGENTD_STATUS_SUCCESS;
+    }
+
+    /* the setting must be a decimal number within range. */
+    if (!isdigit((unsigned char)*setting))
+    {
+        return AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID;
+    }
+
+    unsigned long long number = strtoull(setting, &end, 10);
+    if (0 != *end || number < min || number > max)
+    {
+        return AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID;
+    }
+
+    *value = (size_t)number;
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/**
+ * \file protocolservice/unauthorized_protocol_service_settings_read.c
+ *
+ * \brief Read the tunable settings for the protocol service.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <cbmc/model_assert.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * \brief Read the tunable settings for the protocol service from the
+ * environment.
+ *
+ * Each setting falls back to its default if it isn't set.
+ *      - AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW is the number of requests each
+ *        connection can have outstanding, from 1 to
+ *        UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX.
+ *      - AGENTD_PROTOCOLSERVICE_DATASERVICE_LOW_WATERMARK and
+ *        AGENTD_PROTOCOLSERVICE_DATASERVICE_HIGH_WATERMARK bound the requests
+ *        waiting to be written to the data service.
+ *      - AGENTD_PROTOCOLSERVICE_CONNECTION_LOW_WATERMARK and
+ *        AGENTD_PROTOCOLSERVICE_CONNECTION_HIGH_WATERMARK bound the responses
+ *        waiting to be written to each client.
+ *
+ * \param inst          The service instance to update.
+ *
+ * \returns a status code indicating success or failure.
+ *      - AGENTD_STATUS_SUCCESS on success.
+ *      - AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID if a setting is
+ *        malformed or out of range, or if a low watermark is above its high
+ *        watermark.
+ */
+int unauthorized_protocol_service_settings_read(
+    unauthorized_protocol_service_instance_t* inst)
+{
+    int retval;
+    size_t window;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != inst);
+
+    /* get the pipeline window. */
+    retval =
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW",
+            UNAUTHORIZED_PROTOCOL_SERVICE_DEFAULT_PIPELINE_WINDOW,
+            1U, UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX, &window);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    unauthorized_protocol_service_set_pipeline_window(inst, window);
+
+    /* get the data service watermarks. */
+    retval =
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_DATASERVICE_LOW_WATERMARK",
+            UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_LOW_WATERMARK,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MIN,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MAX,
+            &inst->dataservice_low_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_DATASERVICE_HIGH_WATERMARK",
+            UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_HIGH_WATERMARK,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MIN,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MAX,
+            &inst->dataservice_high_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* get the client connection watermarks. */
+    retval =
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_CONNECTION_LOW_WATERMARK",
+            UNAUTHORIZED_PROTOCOL_SERVICE_CONNECTION_LOW_WATERMARK,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MIN,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MAX,
+            &inst->connection_low_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    retval =
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_CONNECTION_HIGH_WATERMARK",
+            UNAUTHORIZED_PROTOCOL_SERVICE_CONNECTION_HIGH_WATERMARK,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MIN,
+            UNAUTHORIZED_PROTOCOL_SERVICE_WATERMARK_MAX,
+            &inst->connection_high_watermark);
+    if (AGENTD_STATUS_SUCCESS != retval)
+    {
+        return retval;
+    }
+
+    /* reads could never be resumed if a low watermark were above its high
+     * watermark. */
+    if (inst->dataservice_low_watermark > inst->dataservice_high_watermark
+     || inst->connection_low_watermark > inst->connection_high_watermark)
+    {
+        return AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID;
+    }
+
+    return AGENTD_STATUS_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/**
+ * \file
+ * protocolservice/ups_dispatch_dataservice_notification_artifact_update.c
+ *
+ * \brief Push an artifact update notification to watching connections.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/async_api.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/* forward decls. */
+static void ups_notify_artifact_update(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_artifact_notify_t* dresp);
+
+/**
+ * Handle an artifact update notification from the data service.
+ *
+ * The child context carries the watches of every connection sharing it, so
+ * the notification is pushed only to the connections that watch this
+ * artifact, outside of the request and response cycle.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The notification packet.
+ * \param resp_size         The size of the notification packet.
+ */
+void ups_dispatch_dataservice_notification_artifact_update(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size)
+{
+    dataservice_response_artifact_notify_t dresp;
+
+    /* decode the notification. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_response_artifact_notify(
+            resp, resp_size, &dresp))
+    {
+        /* TODO - log a fatal error here. */
+        unauthorized_protocol_service_exit_event_loop(svc);
+        return;
+    }
+
+    /* get the child context for this child id. */
+    const size_t child_max =
+        sizeof(svc->dataservice_child_map)
+            / sizeof(svc->dataservice_child_map[0]);
+    unauthorized_protocol_child_context_t* cc =
+        (dresp.hdr.offset < child_max)
+            ? svc->dataservice_child_map[dresp.hdr.offset] : NULL;
+    if (NULL == cc)
+    {
+        goto cleanup_dresp;
+    }
+
+    /* push the notification to each watching connection.  Walk backward,
+     * since a failed write closes the connection and removes it. */
+    for (size_t i = cc->connection_count; i > 0; --i)
+    {
+        unauthorized_protocol_connection_t* conn = cc->connections[i - 1];
+
+        if (conn->artifact_watch
+         && unauthorized_protocol_connection_artifact_watch_find(
+                conn, dresp.artifact_id))
+        {
+            ups_notify_artifact_update(conn, &dresp);
+        }
+    }
+
+cleanup_dresp:
+    dispose((disposable_t*)&dresp);
+}
+
+/**
+ * \brief Push an artifact update notification to a watching connection.
+ *
+ * \param conn              The connection to notify.
+ * \param dresp             The decoded notification.
+ */
+static void ups_notify_artifact_update(
+    unauthorized_protocol_connection_t* conn,
+    const dataservice_response_artifact_notify_t* dresp)
+{
+    /* only push to a connection that is between commands. */
+    if (APCS_READ_COMMAND_REQ_FROM_CLIENT != conn->state
+     && APCS_WRITE_COMMAND_RESP_TO_CLIENT != conn->state)
+    {
+        return;
+    }
+
+    /* build the payload. */
+    uint32_t net_method = htonl(UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_NOTIFICATION);
+    uint32_t net_status = htonl(AGENTD_STATUS_SUCCESS);
+    uint32_t net_offset = conn->artifact_watch_offset;
+    uint64_t net_height = htonll(dresp->height_latest);
+    uint32_t net_state = htonl(dresp->state_latest);
+    uint8_t payload[
+        3 * sizeof(uint32_t) + 16 + 16 + sizeof(uint64_t) + sizeof(uint32_t)];
+    memcpy(payload, &net_method, 4);
+    memcpy(payload + 4, &net_status, 4);
+    memcpy(payload + 8, &net_offset, 4);
+    memcpy(payload + 12, dresp->artifact_id, 16);
+    memcpy(payload + 28, dresp->txn_latest, 16);
+    memcpy(payload + 44, &net_height, sizeof(net_height));
+    memcpy(payload + 52, &net_state, sizeof(net_state));
+
+    /* a notification is never part of a batch, so write it directly. */
+    if (AGENTD_STATUS_SUCCESS !=
+        ipc_write_authed_data_noblock(
+            &conn->ctx, conn->server_iv, payload, sizeof(payload),
+            &conn->svc->suite, &conn->shared_secret))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        return;
+    }
+
+    /* update the server iv. */
+    ++conn->server_iv;
+
+    /* evolve connection state. */
+    conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
+
+    /* set the write callback. */
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+}
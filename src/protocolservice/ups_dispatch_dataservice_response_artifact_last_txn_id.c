@@ -38,9 +38,8 @@ void ups_dispatch_dataservice_response_artifact_last_txn_id(
 
         /* attempt to write this payload to the socket. */
         if (AGENTD_STATUS_SUCCESS !=
-            ipc_write_authed_data_noblock(
-                &conn->ctx, conn->server_iv, payload, sizeof(payload),
-                &conn->svc->suite, &conn->shared_secret))
+            unauthorized_protocol_connection_write_response(
+                conn, payload, sizeof(payload)))
         {
             unauthorized_protocol_service_close_connection(conn);
             return;
@@ -74,9 +73,8 @@ void ups_dispatch_dataservice_response_artifact_last_txn_id(
 
         /* attempt to write this payload to the socket. */
         int retval =
-            ipc_write_authed_data_noblock(
-                &conn->ctx, conn->server_iv, payload, payload_size,
-                &conn->svc->suite, &conn->shared_secret);
+            unauthorized_protocol_connection_write_response(
+                conn, payload, payload_size);
 
         /* clean up payload. */
         memset(payload, 0, payload_size);
@@ -90,9 +88,6 @@ void ups_dispatch_dataservice_response_artifact_last_txn_id(
         }
     }
 
-    /* Update the server iv on success. */
-    ++conn->server_iv;
-
     /* evolve connection state. */
     conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
 
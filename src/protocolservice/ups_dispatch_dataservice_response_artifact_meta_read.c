@@ -34,9 +34,8 @@ void ups_dispatch_dataservice_response_artifact_meta_read(
         return;
     }
 
-    /* get the connection associated with this child id. */
-    unauthorized_protocol_connection_t* conn =
-        svc->dataservice_child_map[dresp.hdr.offset];
+    /* get the connection that this response was routed to. */
+    unauthorized_protocol_connection_t* conn = svc->dataservice_response_conn;
     if (NULL == conn)
     {
         /* TODO - how do we handle a failure here? */
@@ -0,0 +1,82 @@
+/**
+ * \file protocolservice/ups_dispatch_dataservice_response_artifact_watch.c
+ *
+ * \brief Handle the response from the dataservice artifact watch request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/async_api.h>
+#include <agentd/status_codes.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * Handle an artifact_watch response.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The response from the artifact watch call.
+ * \param resp_size         The size of the response.
+ */
+void ups_dispatch_dataservice_response_artifact_watch(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size)
+{
+    dataservice_response_artifact_watch_t dresp;
+
+    /* decode the response. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_response_artifact_watch(
+            resp, resp_size, &dresp))
+    {
+        /* TODO - log a fatal error here. */
+        unauthorized_protocol_service_exit_event_loop(svc);
+        return;
+    }
+
+    /* get the connection that this response was routed to. */
+    unauthorized_protocol_connection_t* conn = svc->dataservice_response_conn;
+    if (NULL == conn)
+    {
+        /* TODO - warn level log about mismatch. */
+        goto cleanup_dresp;
+    }
+
+    /* notifications carry the offset of the first watch request. */
+    if (AGENTD_STATUS_SUCCESS == dresp.hdr.status && !conn->artifact_watch)
+    {
+        conn->artifact_watch = true;
+        conn->artifact_watch_offset = conn->current_request_offset;
+    }
+
+    /* build the payload. */
+    uint32_t net_method = htonl(UNAUTH_PROTOCOL_REQ_ID_ARTIFACT_WATCH);
+    uint32_t net_status = htonl(dresp.hdr.status);
+    uint32_t net_offset = conn->current_request_offset;
+    uint8_t payload[3 * sizeof(uint32_t)];
+    memcpy(payload, &net_method, 4);
+    memcpy(payload + 4, &net_status, 4);
+    memcpy(payload + 8, &net_offset, 4);
+
+    /* attempt to write this payload to the socket. */
+    if (AGENTD_STATUS_SUCCESS !=
+        unauthorized_protocol_connection_write_response(
+            conn, payload, sizeof(payload)))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        goto cleanup_dresp;
+    }
+
+    /* evolve connection state. */
+    conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
+
+    /* set the write callback. */
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+
+    /* success. */
+
+cleanup_dresp:
+    dispose((disposable_t*)&dresp);
+}
@@ -0,0 +1,88 @@
+/**
+ * \file protocolservice/ups_dispatch_dataservice_response_block_cert_read.c
+ *
+ * \brief Handle the response from the dataservice block certificate read
+ * request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/async_api.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * Handle a block certificate read response.
+ *
+ * A block whose whole certificate arrived in this slice is answered with a
+ * single response.  Otherwise, the block is streamed to the client, and this
+ * is its first slice.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The response from the block certificate read call.
+ * \param resp_size         The size of the response.
+ */
+void ups_dispatch_dataservice_response_block_cert_read(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size)
+{
+    dataservice_response_block_cert_read_t dresp;
+
+    /* decode the response. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_response_block_cert_read(
+            resp, resp_size, &dresp))
+    {
+        /* TODO - log fatal error about decode. */
+        unauthorized_protocol_service_exit_event_loop(svc);
+        return;
+    }
+
+    /* get the connection that this response was routed to. */
+    unauthorized_protocol_connection_t* conn = svc->dataservice_response_conn;
+    if (NULL == conn)
+    {
+        goto cleanup_dresp;
+    }
+
+    /* a later slice of a block that is being streamed. */
+    if (APCS_STREAM_RESP_TO_CLIENT == conn->state)
+    {
+        unauthorized_protocol_connection_block_stream_write(conn, &dresp);
+        goto cleanup_dresp;
+    }
+
+    /* only a block get reads a block certificate. */
+    if (UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET != conn->request_id)
+    {
+        unauthorized_protocol_service_error_response(
+            conn, conn->request_id,
+            AGENTD_ERROR_PROTOCOLSERVICE_MALFORMED_RESPONSE,
+            conn->current_request_offset, true);
+        goto cleanup_dresp;
+    }
+
+    /* a failure, or a whole certificate, is answered as a block read. */
+    if (AGENTD_STATUS_SUCCESS != dresp.hdr.status
+     || dresp.data_size
+            == (uint64_t)ntohll(dresp.node.net_block_cert_size))
+    {
+        dataservice_response_block_get_t block;
+        memset(&block, 0, sizeof(block));
+        memcpy(&block.hdr, &dresp.hdr, sizeof(block.hdr));
+        memcpy(&block.node, &dresp.node, sizeof(block.node));
+        block.data = dresp.data;
+        block.data_size = dresp.data_size;
+
+        ups_dispatch_dataservice_response_block_read(conn, &block);
+        goto cleanup_dresp;
+    }
+
+    /* otherwise, stream the block. */
+    unauthorized_protocol_connection_block_stream_start(conn, &dresp);
+
+cleanup_dresp:
+    dispose((disposable_t*)&dresp);
+}
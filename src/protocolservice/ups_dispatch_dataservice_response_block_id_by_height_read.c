@@ -36,9 +36,8 @@ void ups_dispatch_dataservice_response_block_id_by_height_read(
         return;
     }
 
-    /* get the connection associated with this child id. */
-    unauthorized_protocol_connection_t* conn =
-        svc->dataservice_child_map[dresp.hdr.offset];
+    /* get the connection that this response was routed to. */
+    unauthorized_protocol_connection_t* conn = svc->dataservice_response_conn;
     if (NULL == conn)
     {
         /* TODO - how do we handle a failure here? */
@@ -57,17 +56,13 @@ void ups_dispatch_dataservice_response_block_id_by_height_read(
 
     /* attempt to write this payload to the socket. */
     if (AGENTD_STATUS_SUCCESS !=
-        ipc_write_authed_data_noblock(
-            &conn->ctx, conn->server_iv, payload, sizeof(payload),
-            &conn->svc->suite, &conn->shared_secret))
+        unauthorized_protocol_connection_write_response(
+            conn, payload, sizeof(payload)))
     {
         unauthorized_protocol_service_close_connection(conn);
         goto cleanup_dresp;
     }
 
-    /* Update the server iv on success. */
-    ++conn->server_iv;
-
     /* evolve connection state. */
     conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
 
@@ -0,0 +1,93 @@
+/**
+ * \file
+ * protocolservice/ups_dispatch_dataservice_response_block_notify_subscribe.c
+ *
+ * \brief Handle the response from the dataservice block notify subscribe
+ * request.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice/async_api.h>
+#include <agentd/inet.h>
+#include <agentd/status_codes.h>
+
+#include "unauthorized_protocol_service_private.h"
+
+/**
+ * Handle a block_notify_subscribe response.
+ *
+ * \param svc               The protocol service instance.
+ * \param resp              The response from the block notify subscribe call.
+ * \param resp_size         The size of the response.
+ */
+void ups_dispatch_dataservice_response_block_notify_subscribe(
+    unauthorized_protocol_service_instance_t* svc, const void* resp,
+    size_t resp_size)
+{
+    dataservice_response_block_notify_t dresp;
+
+    /* decode the response. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_response_block_notify(
+            resp, resp_size, &dresp))
+    {
+        /* TODO - log a fatal error here. */
+        unauthorized_protocol_service_exit_event_loop(svc);
+        return;
+    }
+
+    /* get the connection that this response was routed to. */
+    unauthorized_protocol_connection_t* conn = svc->dataservice_response_conn;
+    if (NULL == conn)
+    {
+        /* TODO - warn level log about mismatch. */
+        goto cleanup_dresp;
+    }
+
+    /* notifications carry the offset of the subscribe request. */
+    if (AGENTD_STATUS_SUCCESS == dresp.hdr.status)
+    {
+        conn->block_notify = true;
+        conn->block_notify_offset = conn->current_request_offset;
+    }
+
+    /* build the payload. */
+    uint32_t net_method = htonl(UNAUTH_PROTOCOL_REQ_ID_BLOCK_NOTIFY_SUBSCRIBE);
+    uint32_t net_status = htonl(dresp.hdr.status);
+    uint32_t net_offset = conn->current_request_offset;
+    uint64_t net_height = htonll(dresp.height);
+    uint8_t payload[3 * sizeof(uint32_t) + 16 + sizeof(uint64_t)];
+    size_t payload_size = 3 * sizeof(uint32_t);
+    memcpy(payload, &net_method, 4);
+    memcpy(payload + 4, &net_status, 4);
+    memcpy(payload + 8, &net_offset, 4);
+    if (AGENTD_STATUS_SUCCESS == dresp.hdr.status)
+    {
+        memcpy(payload + 12, dresp.block_id, 16);
+        memcpy(payload + 28, &net_height, sizeof(net_height));
+        payload_size = sizeof(payload);
+    }
+
+    /* attempt to write this payload to the socket. */
+    if (AGENTD_STATUS_SUCCESS !=
+        unauthorized_protocol_connection_write_response(
+            conn, payload, payload_size))
+    {
+        unauthorized_protocol_service_close_connection(conn);
+        goto cleanup_dresp;
+    }
+
+    /* evolve connection state. */
+    conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
+
+    /* set the write callback. */
+    ipc_set_writecb_noblock(
+        &conn->ctx, &unauthorized_protocol_service_connection_write,
+        &conn->svc->loop);
+
+    /* success. */
+
+cleanup_dresp:
+    dispose((disposable_t*)&dresp);
+}
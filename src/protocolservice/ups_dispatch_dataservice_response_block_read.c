@@ -10,9 +10,19 @@
 
 #include "unauthorized_protocol_service_private.h"
 
+/* the next ID of the last node in a chain. */
+static const uint8_t ff_uuid[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
 /**
  * Handle a block read response.
  *
+ * The whole block certificate is in the response.  Larger blocks are streamed
+ * instead, which a batch can't carry, so a batched request for a block whose
+ * response would not fit in a single authenticated packet gets an error status.
+ *
  * \param conn              The peer connection context.
  * \param dresp             The decoded response.
  */
@@ -20,13 +30,29 @@ void ups_dispatch_dataservice_response_block_read(
     unauthorized_protocol_connection_t* conn,
     const dataservice_response_block_get_t* dresp)
 {
+    int status = dresp->hdr.status;
+    size_t payload_size =
+        /* method, status, offset */
+        3 * sizeof(uint32_t)
+        /* key, prev, next, first_transaction_id, height, size */
+        + 5 * 16
+        /* block cert. */
+        + dresp->data_size;
+
+    /* a batch response is a single packet. */
+    if (AGENTD_STATUS_SUCCESS == status
+     && payload_size > IPC_AUTHED_PACKET_MAX_SIZE)
+    {
+        status = AGENTD_ERROR_PROTOCOLSERVICE_RESPONSE_TOO_LARGE_FOR_BATCH;
+    }
+
     /* build the payload. */
     uint32_t net_method = htonl(UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET);
-    uint32_t net_status = htonl(dresp->hdr.status);
+    uint32_t net_status = htonl(status);
     uint32_t net_offset = htonl(conn->current_request_offset);
 
     /* if the API call wasn't successful, return the error payload. */
-    if (AGENTD_STATUS_SUCCESS != dresp->hdr.status)
+    if (AGENTD_STATUS_SUCCESS != status)
     {
         uint8_t payload[3 * sizeof(uint32_t)];
         memcpy(payload, &net_method, 4);
@@ -35,9 +61,8 @@ void ups_dispatch_dataservice_response_block_read(
 
         /* attempt to write this payload to the socket. */
         if (AGENTD_STATUS_SUCCESS !=
-            ipc_write_authed_data_noblock(
-                &conn->ctx, conn->server_iv, payload, sizeof(payload),
-                &conn->svc->suite, &conn->shared_secret))
+            unauthorized_protocol_connection_write_response(
+                conn, payload, sizeof(payload)))
         {
             unauthorized_protocol_service_close_connection(conn);
             return;
@@ -46,13 +71,6 @@ void ups_dispatch_dataservice_response_block_read(
     /* full payload. */
     else
     {
-        size_t payload_size =
-            /* method, status, offset */
-            3 * sizeof(uint32_t)
-            /* key, prev, next, first_transaction_id, height, size */
-            + 5 * 16
-            /* block cert. */
-            + dresp->data_size;
         uint8_t* payload = (uint8_t*)malloc(payload_size);
         if (NULL == payload)
         {
@@ -79,11 +97,21 @@ void ups_dispatch_dataservice_response_block_read(
         /* populate certificate. */
         memcpy(payload + 92, dresp->data, dresp->data_size);
 
+        /* a block never changes once it has a successor, so its response
+         * can be cached.  The latest block's next ID is still to come. */
+        if (memcmp(dresp->node.next, ff_uuid, sizeof(ff_uuid)))
+        {
+            /* a response that can't be cached is still sent. */
+            (void)unauthorized_protocol_response_cache_insert(
+                &conn->svc->response_cache,
+                UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET, dresp->node.key,
+                payload + 12, payload_size - 12);
+        }
+
         /* attempt to write this payload to the socket. */
         int retval =
-            ipc_write_authed_data_noblock(
-                &conn->ctx, conn->server_iv, payload, payload_size,
-                &conn->svc->suite, &conn->shared_secret);
+            unauthorized_protocol_connection_write_response(
+                conn, payload, payload_size);
 
         /* clean up payload. */
         memset(payload, 0, payload_size);
@@ -97,9 +125,6 @@ void ups_dispatch_dataservice_response_block_read(
         }
     }
 
-    /* Update the server iv on success. */
-    ++conn->server_iv;
-
     /* evolve connection state. */
     conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
 
@@ -35,35 +35,51 @@ void ups_dispatch_dataservice_response_child_context_create(
         return;
     }
 
-    /* TODO - select based on client ID. */
-    unauthorized_protocol_connection_t* conn =
-        svc->dataservice_context_create_head;
-    if (NULL == conn)
+    /* the data service answers create requests in order. */
+    unauthorized_protocol_child_context_t* cc =
+        svc->child_context_create_head;
+    if (NULL == cc)
     {
         /* TODO - we should indicate an error here. */
         goto cleanup_dresp;
     }
 
-    /* remove the context from the dataservice wait queue and add to connection
-     * queue. */
-    unauthorized_protocol_connection_remove(
-        &svc->dataservice_context_create_head, conn);
-    unauthorized_protocol_connection_push_front(
-        &svc->used_connection_head, conn);
+    svc->child_context_create_head = cc->create_next;
+    if (NULL == svc->child_context_create_head)
+    {
+        svc->child_context_create_tail = NULL;
+    }
 
-    /* save the context in the connection. */
-    conn->dataservice_child_context = dresp.child;
+    cc->create_next = NULL;
 
-    /* save the connection to the context array. */
-    svc->dataservice_child_map[dresp.child] = conn;
+    /* the child context is open. */
+    cc->child = dresp.child;
+    cc->state = UPCC_READY;
+    svc->dataservice_child_map[dresp.child] = cc;
+
+    /* wake each connection waiting on this child context. */
+    for (size_t i = 0; i < cc->connection_count; ++i)
+    {
+        unauthorized_protocol_connection_t* conn = cc->connections[i];
 
-    /* evolve the state of the connection. */
-    conn->state = APCS_READ_COMMAND_REQ_FROM_CLIENT;
+        /* remove the connection from the dataservice wait queue and add to
+         * connection queue. */
+        unauthorized_protocol_connection_remove(
+            &svc->dataservice_context_create_head, conn);
+        unauthorized_protocol_connection_push_front(
+            &svc->used_connection_head, conn);
 
-    /* set connection read callback to read request from client. */
-    ipc_set_readcb_noblock(
-        &conn->ctx, &unauthorized_protocol_service_connection_read,
-        &conn->svc->loop);
+        /* save the context in the connection. */
+        conn->dataservice_child_context = dresp.child;
+
+        /* evolve the state of the connection. */
+        conn->state = APCS_READ_COMMAND_REQ_FROM_CLIENT;
+
+        /* set connection read callback to read request from client. */
+        ipc_set_readcb_noblock(
+            &conn->ctx, &unauthorized_protocol_service_connection_read,
+            &conn->svc->loop);
+    }
 
 cleanup_dresp:
     dispose((disposable_t*)&dresp);
@@ -11,6 +11,12 @@
 
 #include "unauthorized_protocol_service_private.h"
 
+/* the next ID of the last node in a chain. */
+static const uint8_t ff_uuid[16] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
 /**
  * Handle a transaction read response.
  *
@@ -36,9 +42,8 @@ void ups_dispatch_dataservice_response_transaction_read(
 
         /* attempt to write this payload to the socket. */
         if (AGENTD_STATUS_SUCCESS !=
-            ipc_write_authed_data_noblock(
-                &conn->ctx, conn->server_iv, payload, sizeof(payload),
-                &conn->svc->suite, &conn->shared_secret))
+            unauthorized_protocol_connection_write_response(
+                conn, payload, sizeof(payload)))
         {
             unauthorized_protocol_service_close_connection(conn);
             return;
@@ -85,11 +90,24 @@ void ups_dispatch_dataservice_response_transaction_read(
         /* populate certificate. */
         memcpy(payload + 104, dresp->data, dresp->data_size);
 
+        /* a canonized transaction never changes once it has a successor, so
+         * its response can be cached.  Queued transactions and the latest
+         * transaction of an artifact can still change. */
+        if (DATASERVICE_TRANSACTION_NODE_STATE_CANONIZED
+                == ntohl(dresp->node.net_txn_state)
+         && memcmp(dresp->node.next, ff_uuid, sizeof(ff_uuid)))
+        {
+            /* a response that can't be cached is still sent. */
+            (void)unauthorized_protocol_response_cache_insert(
+                &conn->svc->response_cache,
+                UNAUTH_PROTOCOL_REQ_ID_TRANSACTION_BY_ID_GET, dresp->node.key,
+                payload + 12, payload_size - 12);
+        }
+
         /* attempt to write this payload to the socket. */
         int retval =
-            ipc_write_authed_data_noblock(
-                &conn->ctx, conn->server_iv, payload, payload_size,
-                &conn->svc->suite, &conn->shared_secret);
+            unauthorized_protocol_connection_write_response(
+                conn, payload, payload_size);
 
         /* clean up payload. */
         memset(payload, 0, payload_size);
@@ -103,9 +121,6 @@ void ups_dispatch_dataservice_response_transaction_read(
         }
     }
 
-    /* Update the server iv on success. */
-    ++conn->server_iv;
-
     /* evolve connection state. */
     conn->state = APCS_WRITE_COMMAND_RESP_TO_CLIENT;
 
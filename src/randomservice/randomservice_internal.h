@@ -67,8 +67,6 @@ int randomservice_decode_and_dispatch(
  *
  * \returns a status code indicating success or failure.
  *      - AGENTD_STATUS_SUCCESS on success.
- *      - AGENTD_ERROR_GENERAL_OUT_OF_MEMORY if an out-of-memory condition was
- *        encountered in this operation.
  *      - AGENTD_ERROR_RANDOMSERVICE_IPC_WRITE_DATA_FAILURE if data could not be
  *        written to the client socket.
  */
@@ -46,7 +46,7 @@ void randomservice_ipc_read(
     do
     {
         /* attempt to read a request. */
-        retval = ipc_read_data_noblock(ctx, &req, &size);
+        retval = ipc_borrow_data_noblock(ctx, &req, &size);
         switch (retval)
         {
             /* on success, decode and dispatch. */
@@ -57,9 +57,12 @@ void randomservice_ipc_read(
                     randomservice_exit_event_loop(instance);
                 }
 
-                /* clear and free the request data. */
-                memset(req, 0, size);
-                free(req);
+                /* release the request data. */
+                retval = ipc_release_data_noblock(ctx);
+                if (AGENTD_STATUS_SUCCESS != retval)
+                {
+                    randomservice_exit_event_loop(instance);
+                }
                 break;
 
             /* Wait for more data on the socket. */
@@ -23,6 +23,7 @@ typedef struct canonization_process
     const bootstrap_config_t* bconf;
     const agent_config_t* conf;
     int* data_socket;
+    ipc_ring_descriptors_t* data_ring;
     int* random_socket;
     int* log_socket;
     int control_socket;
@@ -44,6 +45,10 @@ static int supervisor_start_canonizationservice(process_t* proc);
  *                              canonization service.  This configuration must
  *                              be valid for the lifetime of the service.
  * \param data_socket           The data socket descriptor.
+ * \param data_ring             The shared-memory ring to the data service.  If
+ *                              its descriptors are valid, the service uses
+ *                              this ring for dataservice requests.  They are
+ *                              closed once the service has been started.
  * \param random_socket         The random socket descriptor.
  * \param log_socket            The log socket descriptor.
  * \param control_socket        The control socket descriptor.
@@ -54,8 +59,9 @@ static int supervisor_start_canonizationservice(process_t* proc);
  */
 int supervisor_create_canonizationservice(
     process_t** svc, const bootstrap_config_t* bconf,
-    const agent_config_t* conf, int* data_socket, int* random_socket,
-    int* log_socket, int* control_socket)
+    const agent_config_t* conf, int* data_socket,
+    ipc_ring_descriptors_t* data_ring, int* random_socket, int* log_socket,
+    int* control_socket)
 {
     int retval;
 
@@ -76,6 +82,7 @@ int supervisor_create_canonizationservice(
     canonization_proc->bconf = bconf;
     canonization_proc->conf = conf;
     canonization_proc->data_socket = data_socket;
+    canonization_proc->data_ring = data_ring;
     canonization_proc->random_socket = random_socket;
     canonization_proc->log_socket = log_socket;
 
@@ -122,12 +129,17 @@ static int supervisor_start_canonizationservice(process_t* proc)
         start_canonization_proc(
             canonization_proc->bconf, canonization_proc->conf,
             canonization_proc->log_socket, canonization_proc->data_socket,
+            (canonization_proc->data_ring->memfd >= 0)
+                ? canonization_proc->data_ring : NULL,
             canonization_proc->random_socket,
             &canonization_proc->control_socket,
             &canonization_proc->hdr.process_id,
             true),
         done);
 
+    /* the child process owns its copy of the ring. */
+    ipc_ring_descriptors_close(canonization_proc->data_ring);
+
     /* attempt to send config data to the canonization proc. */
     TRY_OR_FAIL(
         canonization_api_sendreq_configure(
@@ -195,6 +207,9 @@ static void supervisor_dispose_canonizationservice(void* disposable)
         *canonization_proc->data_socket = -1;
     }
 
+    /* clean up the data ring if valid. */
+    ipc_ring_descriptors_close(canonization_proc->data_ring);
+
     /* clean up the random socket if valid. */
     if (*canonization_proc->random_socket > 0)
     {
@@ -26,6 +26,17 @@
  *                              socket.
  * \param log_socket            Pointer to the descriptor holding the log socket
  *                              for this instance.
+ * \param ring                  Pointer to the ring descriptors to receive a
+ *                              shared-memory ring to the data service, if
+ *                              the configuration enables one.  Otherwise,
+ *                              these are set to -1.  The caller owns these
+ *                              descriptors.
+ * \param block_publish_sockets     Array of descriptors on which the data
+ *                                  service signals each block that it
+ *                                  commits.  This array must be valid for the
+ *                                  lifetime of the service, and the caller
+ *                                  owns these descriptors.
+ * \param block_publish_count       The number of block publish descriptors.
  *
  * \returns a status indicating success or failure.
  *          - AGENTD_STATUS_SUCCESS on success.
@@ -33,17 +44,30 @@
  */
 int supervisor_create_data_service_for_canonizationservice(
     process_t** svc, const bootstrap_config_t* bconf,
-    const agent_config_t* conf, int* data_socket, int* log_socket)
+    const agent_config_t* conf, int* data_socket, int* log_socket,
+    ipc_ring_descriptors_t* ring, int* block_publish_sockets,
+    size_t block_publish_count)
 {
     int retval;
 
+    /* without a ring, the data service is reached over its socket. */
+    ring->memfd = ring->lhs = ring->rhs = -1;
+    if (conf->ipc_ring_capacity_set)
+    {
+        TRY_OR_FAIL(
+            ipc_ringpair(
+                (uint32_t)conf->ipc_ring_capacity, &ring->memfd, &ring->lhs,
+                &ring->rhs),
+            done);
+    }
+
     /* allocate memory for the dataservice process. */
     dataservice_process_t* data_proc =
         (dataservice_process_t*)malloc(sizeof(dataservice_process_t));
     if (NULL == data_proc)
     {
         retval = AGENTD_ERROR_GENERAL_OUT_OF_MEMORY;
-        goto done;
+        goto cleanup_ring;
     }
 
     /* set up data_proc structure. */
@@ -53,6 +77,9 @@ int supervisor_create_data_service_for_canonizationservice(
     data_proc->bconf = bconf;
     data_proc->conf = conf;
     data_proc->log_socket = log_socket;
+    data_proc->ring = ring;
+    data_proc->block_publish = block_publish_sockets;
+    data_proc->block_publish_count = block_publish_count;
 
     /* save the supervisor data socket to be set later. */
     data_proc->supervisor_data_socket = data_socket;
@@ -110,6 +137,9 @@ int supervisor_create_data_service_for_canonizationservice(
     *svc = (process_t*)data_proc;
     goto done;
 
+cleanup_ring:
+    ipc_ring_descriptors_close(ring);
+
 done:
     return retval;
 }
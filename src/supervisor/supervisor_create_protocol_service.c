@@ -22,6 +22,7 @@ typedef struct protocol_process
     int* random_socket;
     int* accept_socket;
     int* data_socket;
+    ipc_ring_descriptors_t* data_ring;
     int* log_socket;
 } protocol_process_t;
 
@@ -41,6 +42,10 @@ static int supervisor_start_protocol_service(process_t* proc);
  * \param random_socket         The random socket descriptor.
  * \param accept_socket         The accept socket descriptor.
  * \param data_socket           The data socket descriptor.
+ * \param data_ring             The shared-memory ring to the data service.  If
+ *                              its descriptors are valid, the service uses
+ *                              this ring for dataservice requests.  They are
+ *                              closed once the service has been started.
  * \param log_socket            The log socket descriptor.
  *
  * \returns a status indicating success or failure.
@@ -50,7 +55,7 @@ static int supervisor_start_protocol_service(process_t* proc);
 int supervisor_create_protocol_service(
     process_t** svc, const bootstrap_config_t* bconf,
     const agent_config_t* conf, int* random_socket, int* accept_socket,
-    int* data_socket, int* log_socket)
+    int* data_socket, ipc_ring_descriptors_t* data_ring, int* log_socket)
 {
     int retval;
 
@@ -72,6 +77,7 @@ int supervisor_create_protocol_service(
     protocol_proc->random_socket = random_socket;
     protocol_proc->accept_socket = accept_socket;
     protocol_proc->data_socket = data_socket;
+    protocol_proc->data_ring = data_ring;
     protocol_proc->log_socket = log_socket;
 
     /* success */
@@ -102,6 +108,8 @@ static int supervisor_start_protocol_service(process_t* proc)
             protocol_proc->bconf, protocol_proc->conf,
             *protocol_proc->random_socket, *protocol_proc->log_socket,
             *protocol_proc->accept_socket, *protocol_proc->data_socket,
+            (protocol_proc->data_ring->memfd >= 0)
+                ? protocol_proc->data_ring : NULL,
             &protocol_proc->hdr.process_id, true),
         done);
 
@@ -110,6 +118,7 @@ static int supervisor_start_protocol_service(process_t* proc)
     *protocol_proc->log_socket = -1;
     *protocol_proc->accept_socket = -1;
     *protocol_proc->data_socket = -1;
+    ipc_ring_descriptors_close(protocol_proc->data_ring);
 
     /* success */
     retval = AGENTD_STATUS_SUCCESS;
@@ -153,6 +162,9 @@ static void supervisor_dispose_protocol_service(void* disposable)
         *protocol_proc->data_socket = -1;
     }
 
+    /* clean up the data ring if valid. */
+    ipc_ring_descriptors_close(protocol_proc->data_ring);
+
     if (protocol_proc->hdr.running)
     {
         /* call the process stop method. */
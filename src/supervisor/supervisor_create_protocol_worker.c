@@ -0,0 +1,208 @@
+/**
+ * \file supervisor/supervisor_create_protocol_worker.c
+ *
+ * \brief Create a protocol service worker and its dedicated services.
+ *
+ * \copyright 2020 Velo Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/control.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <agentd/supervisor/supervisor_internal.h>
+#include <cbmc/model_assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* forward decls. */
+static void supervisor_dispose_protocol_worker(void* disposable);
+static void supervisor_protocol_worker_cleanup_process(process_t** proc);
+static void supervisor_protocol_worker_close(int* sock);
+
+/**
+ * \brief Create a protocol service worker, along with its random service and
+ * data service, as processes that can be started.
+ *
+ * The worker gets its own copy of the accept socket, so that every worker
+ * reads accepted sockets from the same queue.  The worker's block publish
+ * socket is handed to the canonization data service, which signals each
+ * committed block on it to the worker's data service.  On success, the worker
+ * is owned by the caller and must be disposed by calling \ref dispose() when
+ * no longer needed.
+ *
+ * \param worker                The worker to create.
+ * \param bconf                 Agentd bootstrap config for this worker.
+ * \param conf                  Agentd configuration to be used to build the
+ *                              worker.  This configuration must be valid for
+ *                              the lifetime of the worker.
+ * \param accept_socket         The protocol side of the accept socket, which
+ *                              is duplicated for this worker.
+ *
+ * \returns a status indicating success or failure.
+ *          - AGENTD_STATUS_SUCCESS on success.
+ *          - AGENTD_ERROR_SUPERVISOR_DUP_FAILURE if the accept socket could not
+ *            be duplicated.
+ *          - a non-zero error code on failure.
+ */
+int supervisor_create_protocol_worker(
+    supervisor_protocol_worker_t* worker, const bootstrap_config_t* bconf,
+    const agent_config_t* conf, int accept_socket)
+{
+    int retval;
+
+    /* parameter sanity checks. */
+    MODEL_ASSERT(NULL != worker);
+    MODEL_ASSERT(NULL != bconf);
+    MODEL_ASSERT(NULL != conf);
+    MODEL_ASSERT(accept_socket >= 0);
+
+    /* set up the worker so that it can be disposed at any point. */
+    memset(worker, 0, sizeof(supervisor_protocol_worker_t));
+    worker->hdr.dispose = &supervisor_dispose_protocol_worker;
+    worker->random_svc_log_sock = -1;
+    worker->random_svc_log_dummy_sock = -1;
+    worker->data_svc_log_sock = -1;
+    worker->data_svc_log_dummy_sock = -1;
+    worker->protocol_svc_log_sock = -1;
+    worker->protocol_svc_log_dummy_sock = -1;
+    worker->protocol_svc_random_sock = -1;
+    worker->protocol_svc_accept_sock = -1;
+    worker->protocol_svc_data_sock = -1;
+    worker->protocol_svc_data_ring.memfd = -1;
+    worker->protocol_svc_data_ring.lhs = -1;
+    worker->protocol_svc_data_ring.rhs = -1;
+    worker->data_svc_block_subscribe_sock = -1;
+    worker->block_publish_sock = -1;
+
+    /* TODO - replace with log service. */
+    TRY_OR_FAIL(
+        ipc_socketpair(
+            AF_UNIX, SOCK_STREAM, 0,
+            &worker->random_svc_log_sock, &worker->random_svc_log_dummy_sock),
+        cleanup_worker);
+    TRY_OR_FAIL(
+        ipc_socketpair(
+            AF_UNIX, SOCK_STREAM, 0,
+            &worker->data_svc_log_sock, &worker->data_svc_log_dummy_sock),
+        cleanup_worker);
+    TRY_OR_FAIL(
+        ipc_socketpair(
+            AF_UNIX, SOCK_STREAM, 0,
+            &worker->protocol_svc_log_sock,
+            &worker->protocol_svc_log_dummy_sock),
+        cleanup_worker);
+
+    /* the canonization data service signals committed blocks to the data
+     * service for this worker on this socket pair. */
+    TRY_OR_FAIL(
+        ipc_socketpair(
+            AF_UNIX, SOCK_STREAM, 0,
+            &worker->data_svc_block_subscribe_sock,
+            &worker->block_publish_sock),
+        cleanup_worker);
+
+    /* every worker reads from the same accept queue. */
+    worker->protocol_svc_accept_sock = dup(accept_socket);
+    if (worker->protocol_svc_accept_sock < 0)
+    {
+        retval = AGENTD_ERROR_SUPERVISOR_DUP_FAILURE;
+        goto cleanup_worker;
+    }
+
+    /* create the random service for this worker. */
+    TRY_OR_FAIL(
+        supervisor_create_random_service(
+            &worker->random_service, bconf, conf,
+            &worker->random_svc_log_sock, &worker->protocol_svc_random_sock),
+        cleanup_worker);
+
+    /* create the data service for this worker. */
+    TRY_OR_FAIL(
+        supervisor_create_data_service_for_auth_protocol_service(
+            &worker->data_service, bconf, conf,
+            &worker->protocol_svc_data_sock, &worker->data_svc_log_sock,
+            &worker->protocol_svc_data_ring,
+            &worker->data_svc_block_subscribe_sock),
+        cleanup_worker);
+
+    /* create the protocol service for this worker. */
+    TRY_OR_FAIL(
+        supervisor_create_protocol_service(
+            &worker->protocol_service, bconf, conf,
+            &worker->protocol_svc_random_sock,
+            &worker->protocol_svc_accept_sock,
+            &worker->protocol_svc_data_sock, &worker->protocol_svc_data_ring,
+            &worker->protocol_svc_log_sock),
+        cleanup_worker);
+
+    /* success */
+    retval = AGENTD_STATUS_SUCCESS;
+    goto done;
+
+cleanup_worker:
+    dispose((disposable_t*)worker);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Dispose of a protocol service worker by cleaning up its processes and
+ * sockets.
+ *
+ * \param disposable        The worker to clean up.
+ */
+static void supervisor_dispose_protocol_worker(void* disposable)
+{
+    supervisor_protocol_worker_t* worker =
+        (supervisor_protocol_worker_t*)disposable;
+
+    /* clean up the processes, most dependent first. */
+    supervisor_protocol_worker_cleanup_process(&worker->protocol_service);
+    supervisor_protocol_worker_cleanup_process(&worker->data_service);
+    supervisor_protocol_worker_cleanup_process(&worker->random_service);
+
+    /* close any sockets that weren't handed off to a child. */
+    supervisor_protocol_worker_close(&worker->random_svc_log_sock);
+    supervisor_protocol_worker_close(&worker->random_svc_log_dummy_sock);
+    supervisor_protocol_worker_close(&worker->data_svc_log_sock);
+    supervisor_protocol_worker_close(&worker->data_svc_log_dummy_sock);
+    supervisor_protocol_worker_close(&worker->protocol_svc_log_sock);
+    supervisor_protocol_worker_close(&worker->protocol_svc_log_dummy_sock);
+    supervisor_protocol_worker_close(&worker->protocol_svc_random_sock);
+    supervisor_protocol_worker_close(&worker->protocol_svc_accept_sock);
+    supervisor_protocol_worker_close(&worker->protocol_svc_data_sock);
+    ipc_ring_descriptors_close(&worker->protocol_svc_data_ring);
+    supervisor_protocol_worker_close(&worker->data_svc_block_subscribe_sock);
+    supervisor_protocol_worker_close(&worker->block_publish_sock);
+}
+
+/**
+ * \brief Dispose and free a worker process, if it was created.
+ *
+ * \param proc              Pointer to the process pointer to clean up.
+ */
+static void supervisor_protocol_worker_cleanup_process(process_t** proc)
+{
+    if (NULL != *proc)
+    {
+        dispose((disposable_t*)*proc);
+        free(*proc);
+        *proc = NULL;
+    }
+}
+
+/**
+ * \brief Close a worker socket, if it is valid.
+ *
+ * \param sock              Pointer to the socket to close.
+ */
+static void supervisor_protocol_worker_close(int* sock)
+{
+    if (*sock >= 0)
+    {
+        close(*sock);
+        *sock = -1;
+    }
+}
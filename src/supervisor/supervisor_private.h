@@ -15,6 +15,7 @@ extern "C" {
 #endif /*__cplusplus*/
 
 #include <agentd/dataservice.h>
+#include <agentd/ipc.h>
 #include <agentd/supervisor.h>
 #include <agentd/supervisor/supervisor_internal.h>
 
@@ -28,6 +29,10 @@ typedef struct dataservice_process
     const agent_config_t* conf;
     int* supervisor_data_socket;
     int* log_socket;
+    ipc_ring_descriptors_t* ring;
+    int* block_subscribe;
+    int* block_publish;
+    size_t block_publish_count;
     BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
 } dataservice_process_t;
 
@@ -31,8 +31,13 @@ int supervisor_start_data_service(process_t* proc)
     TRY_OR_FAIL(
         dataservice_proc(
             data_proc->bconf, data_proc->conf, data_proc->log_socket,
-            data_proc->supervisor_data_socket, &data_proc->hdr.process_id,
-            true),
+            data_proc->supervisor_data_socket,
+            (data_proc->ring->memfd >= 0) ? data_proc->ring : NULL,
+            (NULL != data_proc->block_subscribe)
+                ? *data_proc->block_subscribe
+                : -1,
+            data_proc->block_publish, data_proc->block_publish_count,
+            &data_proc->hdr.process_id, true),
         done);
 
     /* attempt to send the initialize root context request. */
@@ -82,7 +82,7 @@ void canonizationservice_isolation_test::SetUp()
     /* spawn the canonization service process. */
     canonization_proc_status =
         start_canonization_proc(
-            &bconf, &conf, &logsock, &datasock_srv, &rprotosock,
+            &bconf, &conf, &logsock, &datasock_srv, NULL, &rprotosock,
             &controlsock_srv, &canonizationpid, false);
 
     /* create the mock dataservice. */
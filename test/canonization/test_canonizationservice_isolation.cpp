@@ -127,9 +127,9 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry)
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the transaction query api call. */
-    dataservice->register_callback_transaction_get_first(
-        [&](const dataservice_request_transaction_get_first_t&,
+    /* mock the block make from queue api call. */
+    dataservice->register_callback_block_make_from_queue(
+        [&](const dataservice_request_block_make_from_queue_t&,
             std::ostream&) {
             return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
         });
@@ -158,10 +158,6 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry)
     /* set our expected caps. */
     BITCAP(EXPECTED_CAPS, DATASERVICE_API_CAP_BITS_MAX);
     BITCAP_INIT_FALSE(EXPECTED_CAPS);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(
         EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
     BITCAP_SET_TRUE(
@@ -181,10 +177,10 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry)
         dataservice->request_matches_block_id_latest_read(
             EXPECTED_CHILD_INDEX));
 
-    /* a get first call should have been made. */
+    /* a block make from queue call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
+        dataservice->request_matches_block_make_from_queue(
+            EXPECTED_CHILD_INDEX, NULL, 1, 10));
 
     /* a child close should have occurred. */
     EXPECT_TRUE(
@@ -201,10 +197,10 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry)
         dataservice->request_matches_block_id_latest_read(
             EXPECTED_CHILD_INDEX));
 
-    /* a second get first call should have been made. */
+    /* a second block make from queue call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
+        dataservice->request_matches_block_make_from_queue(
+            EXPECTED_CHILD_INDEX, NULL, 1, 10));
 
     /* a child close should have occurred. */
     EXPECT_TRUE(
@@ -230,9 +226,9 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry_with_block)
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the transaction query api call. */
-    dataservice->register_callback_transaction_get_first(
-        [&](const dataservice_request_transaction_get_first_t&,
+    /* mock the block make from queue api call. */
+    dataservice->register_callback_block_make_from_queue(
+        [&](const dataservice_request_block_make_from_queue_t&,
             std::ostream&) {
             return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
         });
@@ -278,10 +274,6 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry_with_block)
     /* set our expected caps. */
     BITCAP(EXPECTED_CAPS, DATASERVICE_API_CAP_BITS_MAX);
     BITCAP_INIT_FALSE(EXPECTED_CAPS);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(
         EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
     BITCAP_SET_TRUE(
@@ -306,10 +298,10 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry_with_block)
         dataservice->request_matches_block_read(
             EXPECTED_CHILD_INDEX, dummy_block_id));
 
-    /* a get first call should have been made. */
+    /* a block make from queue call should have been made at height 17. */
     EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
+        dataservice->request_matches_block_make_from_queue(
+            EXPECTED_CHILD_INDEX, NULL, 17, 10));
 
     /* a child close should have occurred. */
     EXPECT_TRUE(
@@ -331,141 +323,10 @@ TEST_F(canonizationservice_isolation_test, no_txn_retry_with_block)
         dataservice->request_matches_block_read(
             EXPECTED_CHILD_INDEX, dummy_block_id));
 
-    /* a second get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-}
-
-/**
- * Test that the canonization service tries again when the first transaction
- * hasn't been attested.
- */
-TEST_F(canonizationservice_isolation_test, no_attested_retry)
-{
-    const uint8_t EXPECTED_TRANSACTION_ID[16] = {
-        0xb8, 0x4e, 0x5b, 0xe9, 0x0c, 0x4b, 0x49, 0x88,
-        0x92, 0x50, 0xe0, 0xb0, 0x3f, 0xb2, 0xfe, 0x36
-    };
-    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
-        0xf2, 0x66, 0xf1, 0x55, 0x5f, 0xc1, 0x4b, 0x06,
-        0xac, 0xd2, 0x08, 0x66, 0x83, 0xe3, 0x41, 0xc1
-    };
-    const uint8_t EXPECTED_TRANSACTION_BEGIN[16] = {
-        0x00, 0X00, 0X00, 0X00, 0X00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-    };
-    const uint8_t EXPECTED_TRANSACTION_END[16] = {
-        0xff, 0Xff, 0Xff, 0Xff, 0Xff, 0xff, 0xff, 0xff,
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
-    };
-    const uint8_t EXPECTED_CERT[] = { 0x00, 0x01, 0x02, 0x03 };
-    const size_t EXPECTED_CERT_SIZE = sizeof(EXPECTED_CERT);
-
-    /* register dataservice helper mocks. */
-    ASSERT_EQ(0, dataservice_mock_register_helper());
-
-    /* mock the transaction query api call. */
-    dataservice->register_callback_transaction_get_first(
-        [&](const dataservice_request_transaction_get_first_t&,
-            std::ostream& out) {
-            void* payload;
-            size_t payload_size;
-
-            int retval =
-                dataservice_encode_response_transaction_get_first(
-                    &payload, &payload_size, EXPECTED_TRANSACTION_ID,
-                    EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_END,
-                    EXPECTED_ARTIFACT_ID,
-                    htonl(DATASERVICE_TRANSACTION_NODE_STATE_SUBMITTED),
-                    EXPECTED_CERT, EXPECTED_CERT_SIZE);
-            if (AGENTD_STATUS_SUCCESS != retval)
-            {
-                return retval;
-            }
-
-            out.write((const char*)payload, payload_size);
-            free(payload);
-
-            return AGENTD_STATUS_SUCCESS;
-        });
-
-    /* mock the latest block id query api call. */
-    dataservice->register_callback_block_id_latest_read(
-        [&](const dataservice_request_block_id_latest_read_t&,
-            std::ostream& out) {
-            out.write((const char*)vccert_certificate_type_uuid_root_block, 16);
-
-            return AGENTD_STATUS_SUCCESS;
-        });
-
-    /* start the mock. */
-    dataservice->start();
-
-    /* we should be able to configure and start the canonization service. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        canonizationservice_configure_and_start(1, 10));
-
-    usleep(30000);
-
-    /* stop the mock. */
-    dataservice->stop();
-
-    /* set our expected caps. */
-    BITCAP(EXPECTED_CAPS, DATASERVICE_API_CAP_BITS_MAX);
-    BITCAP_INIT_FALSE(EXPECTED_CAPS);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_WRITE);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CLOSE);
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a second get first call should have been made. */
+    /* a second block make from queue call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
+        dataservice->request_matches_block_make_from_queue(
+            EXPECTED_CHILD_INDEX, NULL, 17, 10));
 
     /* a child close should have occurred. */
     EXPECT_TRUE(
@@ -474,268 +335,34 @@ TEST_F(canonizationservice_isolation_test, no_attested_retry)
 }
 
 /**
- * Test that the canonization service builds a block with a single attested
- * record.
+ * Test that the canonization service makes a single block when attested
+ * transactions are available, and then waits for more.
  */
 TEST_F(canonizationservice_isolation_test, one_attested_block)
 {
-    const uint8_t EXPECTED_TRANSACTION_ID[16] = {
-        0xb8, 0x4e, 0x5b, 0xe9, 0x0c, 0x4b, 0x49, 0x88,
-        0x92, 0x50, 0xe0, 0xb0, 0x3f, 0xb2, 0xfe, 0x36
-    };
-    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
-        0xf2, 0x66, 0xf1, 0x55, 0x5f, 0xc1, 0x4b, 0x06,
-        0xac, 0xd2, 0x08, 0x66, 0x83, 0xe3, 0x41, 0xc1
-    };
-    const uint8_t EXPECTED_TRANSACTION_BEGIN[16] = {
-        0x00, 0X00, 0X00, 0X00, 0X00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-    };
-    const uint8_t EXPECTED_TRANSACTION_END[16] = {
-        0xff, 0Xff, 0Xff, 0Xff, 0Xff, 0xff, 0xff, 0xff,
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
-    };
-    const uint8_t EXPECTED_CERT[] = { 0x00, 0x01, 0x02, 0x03 };
-    const size_t EXPECTED_CERT_SIZE = sizeof(EXPECTED_CERT);
+    const uint8_t EXPECTED_HASH[64] = { 0x01, 0x02, 0x03, 0x04 };
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the first transaction query api call. */
-    bool first_run = true;
-    dataservice->register_callback_transaction_get_first(
-        [&](const dataservice_request_transaction_get_first_t&,
-            std::ostream& out) {
-            /* only return a result the first time. */
-            if (first_run)
-            {
-                void* payload;
-                size_t payload_size;
-
-                first_run = false;
-
-                int retval =
-                    dataservice_encode_response_transaction_get_first(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID,
-                        EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_END,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
-                if (AGENTD_STATUS_SUCCESS != retval)
-                {
-                    return retval;
-                }
-
-                out.write((const char*)payload, payload_size);
-                free(payload);
-
-                return AGENTD_STATUS_SUCCESS;
-            }
-            else
-            {
-                return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
-            }
-        });
-
-    /* mock the transaction query api call. */
-    dataservice->register_callback_transaction_get(
-        [&](const dataservice_request_transaction_get_t&,
-            std::ostream&) {
-            /* only the first record is found. */
-            return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
-        });
-
-    /* mock the latest block id query api call. */
-    dataservice->register_callback_block_id_latest_read(
-        [&](const dataservice_request_block_id_latest_read_t&,
-            std::ostream& out) {
-            out.write((const char*)vccert_certificate_type_uuid_root_block, 16);
-
-            return AGENTD_STATUS_SUCCESS;
-        });
-
-    /* start the mock. */
-    dataservice->start();
-
-    /* we should be able to configure and start the canonization service. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        canonizationservice_configure_and_start(1, 10));
-
-    usleep(30000);
-
-    /* stop the mock. */
-    dataservice->stop();
-
-    /* set our expected caps. */
-    BITCAP(EXPECTED_CAPS, DATASERVICE_API_CAP_BITS_MAX);
-    BITCAP_INIT_FALSE(EXPECTED_CAPS);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_WRITE);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CLOSE);
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a block make call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_make(
-            EXPECTED_CHILD_INDEX, NULL, 0, NULL));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a second get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-}
-
-/**
- * Test that the canonization service builds a block with a multiple attested
- * records.
- */
-TEST_F(canonizationservice_isolation_test, multiple_attested_txns_one_block)
-{
-    const uint8_t EXPECTED_TRANSACTION_ID_01[16] = {
-        0xb8, 0x4e, 0x5b, 0xe9, 0x0c, 0x4b, 0x49, 0x88,
-        0x92, 0x50, 0xe0, 0xb0, 0x3f, 0xb2, 0xfe, 0x36
-    };
-    const uint8_t EXPECTED_TRANSACTION_ID_02[16] = {
-        0xad, 0x32, 0xff, 0x01, 0xb9, 0x63, 0x41, 0x28,
-        0x83, 0x38, 0x12, 0xa4, 0x23, 0x54, 0x5f, 0xcd
-    };
-    const uint8_t EXPECTED_TRANSACTION_ID_03[16] = {
-        0x16, 0xc0, 0x8c, 0xde, 0xfd, 0x24, 0x43, 0xb9,
-        0x92, 0x48, 0x95, 0x23, 0x33, 0xec, 0xa1, 0x43
-    };
-    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
-        0xf2, 0x66, 0xf1, 0x55, 0x5f, 0xc1, 0x4b, 0x06,
-        0xac, 0xd2, 0x08, 0x66, 0x83, 0xe3, 0x41, 0xc1
-    };
-    const uint8_t EXPECTED_TRANSACTION_BEGIN[16] = {
-        0x00, 0X00, 0X00, 0X00, 0X00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-    };
-    const uint8_t EXPECTED_TRANSACTION_END[16] = {
-        0xff, 0Xff, 0Xff, 0Xff, 0Xff, 0xff, 0xff, 0xff,
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
-    };
-    const uint8_t EXPECTED_CERT[] = { 0x00, 0x01, 0x02, 0x03 };
-    const size_t EXPECTED_CERT_SIZE = sizeof(EXPECTED_CERT);
-
-    /* register dataservice helper mocks. */
-    ASSERT_EQ(0, dataservice_mock_register_helper());
-
-    /* mock the first transaction query api call. */
-    bool first_run = true;
-    dataservice->register_callback_transaction_get_first(
-        [&](const dataservice_request_transaction_get_first_t&,
-            std::ostream& out) {
-            /* only return a result the first time. */
-            if (first_run)
-            {
-                void* payload;
-                size_t payload_size;
-
-                first_run = false;
-
-                int retval =
-                    dataservice_encode_response_transaction_get_first(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID_01,
-                        EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_ID_02,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
-                if (AGENTD_STATUS_SUCCESS != retval)
-                {
-                    return retval;
-                }
-
-                out.write((const char*)payload, payload_size);
-                free(payload);
-
-                return AGENTD_STATUS_SUCCESS;
-            }
-            else
-            {
-                return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
-            }
-        });
-
-    /* mock the transaction query api call. */
-    dataservice->register_callback_transaction_get(
-        [&](const dataservice_request_transaction_get_t& txn,
+    /* mock the block make from queue api call. */
+    int run_count = 0;
+    dataservice->register_callback_block_make_from_queue(
+        [&](const dataservice_request_block_make_from_queue_t& req,
             std::ostream& out) {
             void* payload;
             size_t payload_size;
             int retval;
 
-            if (!crypto_memcmp(txn.txn_id, EXPECTED_TRANSACTION_ID_02, 16))
+            /* on the first run, make a block of two transactions. */
+            if (run_count < 1)
             {
-                retval =
-                    dataservice_encode_response_transaction_get(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID_02,
-                        EXPECTED_TRANSACTION_ID_01, EXPECTED_TRANSACTION_ID_03,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
-                if (AGENTD_STATUS_SUCCESS != retval)
-                {
-                    return retval;
-                }
-
-                out.write((const char*)payload, payload_size);
-                free(payload);
+                ++run_count;
 
-                return AGENTD_STATUS_SUCCESS;
-            }
-            else if (!crypto_memcmp(txn.txn_id, EXPECTED_TRANSACTION_ID_03, 16))
-            {
                 retval =
-                    dataservice_encode_response_transaction_get(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID_03,
-                        EXPECTED_TRANSACTION_ID_02, EXPECTED_TRANSACTION_END,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
+                    dataservice_encode_response_block_make_from_queue(
+                        &payload, &payload_size, req.block_id, 2,
+                        EXPECTED_HASH, sizeof(EXPECTED_HASH));
                 if (AGENTD_STATUS_SUCCESS != retval)
                 {
                     return retval;
@@ -748,7 +375,6 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_txns_one_block)
             }
             else
             {
-                /* no more records found. */
                 return AGENTD_ERROR_DATASERVICE_NOT_FOUND;
             }
         });
@@ -777,10 +403,6 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_txns_one_block)
     /* set our expected caps. */
     BITCAP(EXPECTED_CAPS, DATASERVICE_API_CAP_BITS_MAX);
     BITCAP_INIT_FALSE(EXPECTED_CAPS);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(
         EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
     BITCAP_SET_TRUE(
@@ -800,25 +422,10 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_txns_one_block)
         dataservice->request_matches_block_id_latest_read(
             EXPECTED_CHILD_INDEX));
 
-    /* a get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a get call should have been made. */
+    /* a block make from queue call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_transaction_get(
-            EXPECTED_CHILD_INDEX, EXPECTED_TRANSACTION_ID_02));
-
-    /* a get call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get(
-            EXPECTED_CHILD_INDEX, EXPECTED_TRANSACTION_ID_03));
-
-    /* a block make call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_make(
-            EXPECTED_CHILD_INDEX, NULL, 0, NULL));
+        dataservice->request_matches_block_make_from_queue(
+            EXPECTED_CHILD_INDEX, NULL, 1, 10));
 
     /* a child close should have occurred. */
     EXPECT_TRUE(
@@ -835,10 +442,10 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_txns_one_block)
         dataservice->request_matches_block_id_latest_read(
             EXPECTED_CHILD_INDEX));
 
-    /* a second get first call should have been made. */
+    /* a second block make from queue call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
+        dataservice->request_matches_block_make_from_queue(
+            EXPECTED_CHILD_INDEX, NULL, 1, 10));
 
     /* a child close should have occurred. */
     EXPECT_TRUE(
@@ -847,106 +454,35 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_txns_one_block)
 }
 
 /**
- * Test that the canonization service builds multiple blocks with attested
- * transactions in them.
+ * Test that the canonization service immediately makes another block when the
+ * previous block was filled to the maximum transaction count.
  */
-TEST_F(canonizationservice_isolation_test, multiple_attested_multiple_blocks)
+TEST_F(canonizationservice_isolation_test, full_blocks_rerun)
 {
-    const uint8_t EXPECTED_TRANSACTION_ID_01[16] = {
-        0xb8, 0x4e, 0x5b, 0xe9, 0x0c, 0x4b, 0x49, 0x88,
-        0x92, 0x50, 0xe0, 0xb0, 0x3f, 0xb2, 0xfe, 0x36
-    };
-    const uint8_t EXPECTED_TRANSACTION_ID_02[16] = {
-        0xad, 0x32, 0xff, 0x01, 0xb9, 0x63, 0x41, 0x28,
-        0x83, 0x38, 0x12, 0xa4, 0x23, 0x54, 0x5f, 0xcd
-    };
-    const uint8_t EXPECTED_TRANSACTION_ID_03[16] = {
-        0x16, 0xc0, 0x8c, 0xde, 0xfd, 0x24, 0x43, 0xb9,
-        0x92, 0x48, 0x95, 0x23, 0x33, 0xec, 0xa1, 0x43
-    };
-    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
-        0xf2, 0x66, 0xf1, 0x55, 0x5f, 0xc1, 0x4b, 0x06,
-        0xac, 0xd2, 0x08, 0x66, 0x83, 0xe3, 0x41, 0xc1
-    };
-    const uint8_t EXPECTED_TRANSACTION_BEGIN[16] = {
-        0x00, 0X00, 0X00, 0X00, 0X00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-    };
-    const uint8_t EXPECTED_TRANSACTION_END[16] = {
-        0xff, 0Xff, 0Xff, 0Xff, 0Xff, 0xff, 0xff, 0xff,
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
-    };
-    const uint8_t EXPECTED_CERT[] = { 0x00, 0x01, 0x02, 0x03 };
-    const size_t EXPECTED_CERT_SIZE = sizeof(EXPECTED_CERT);
+    const uint8_t EXPECTED_HASH[64] = { 0x01, 0x02, 0x03, 0x04 };
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the first transaction query api call. */
+    /* mock the block make from queue api call. */
     int run_count = 0;
-    dataservice->register_callback_transaction_get_first(
-        [&](const dataservice_request_transaction_get_first_t&,
+    dataservice->register_callback_block_make_from_queue(
+        [&](const dataservice_request_block_make_from_queue_t& req,
             std::ostream& out) {
             void* payload;
             size_t payload_size;
             int retval;
 
-            /* on the first run, return the first attested txn. */
-            if (run_count < 1)
-            {
-                ++run_count;
-
-                retval =
-                    dataservice_encode_response_transaction_get_first(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID_01,
-                        EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_ID_02,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
-                if (AGENTD_STATUS_SUCCESS != retval)
-                {
-                    return retval;
-                }
-
-                out.write((const char*)payload, payload_size);
-                free(payload);
-
-                return AGENTD_STATUS_SUCCESS;
-            }
-            /* on the second run, return the second attested txn. */
-            else if (run_count < 2)
+            /* on the first two runs, fill a block. */
+            if (run_count < 2)
             {
                 ++run_count;
 
                 retval =
-                    dataservice_encode_response_transaction_get_first(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID_02,
-                        EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_ID_03,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
-                if (AGENTD_STATUS_SUCCESS != retval)
-                {
-                    return retval;
-                }
-
-                out.write((const char*)payload, payload_size);
-                free(payload);
-
-                return AGENTD_STATUS_SUCCESS;
-            }
-            /* on the second run, return the third attested txn. */
-            else if (run_count < 3)
-            {
-                ++run_count;
-
-                retval =
-                    dataservice_encode_response_transaction_get_first(
-                        &payload, &payload_size, EXPECTED_TRANSACTION_ID_03,
-                        EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_END,
-                        EXPECTED_ARTIFACT_ID,
-                        htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                        EXPECTED_CERT, EXPECTED_CERT_SIZE);
+                    dataservice_encode_response_block_make_from_queue(
+                        &payload, &payload_size, req.block_id,
+                        req.max_transactions, EXPECTED_HASH,
+                        sizeof(EXPECTED_HASH));
                 if (AGENTD_STATUS_SUCCESS != retval)
                 {
                     return retval;
@@ -963,33 +499,6 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_multiple_blocks)
             }
         });
 
-    /* mock the transaction query api call. */
-    dataservice->register_callback_transaction_get(
-        [&](const dataservice_request_transaction_get_t& txn,
-            std::ostream& out) {
-            void* payload;
-            size_t payload_size;
-            int retval;
-
-            /* return a dummy txn. */
-            retval =
-                dataservice_encode_response_transaction_get_first(
-                    &payload, &payload_size, txn.txn_id,
-                    EXPECTED_TRANSACTION_BEGIN, EXPECTED_TRANSACTION_ID_01,
-                    EXPECTED_ARTIFACT_ID,
-                    htonl(DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED),
-                    EXPECTED_CERT, EXPECTED_CERT_SIZE);
-            if (AGENTD_STATUS_SUCCESS != retval)
-            {
-                return retval;
-            }
-
-            out.write((const char*)payload, payload_size);
-            free(payload);
-
-            return AGENTD_STATUS_SUCCESS;
-        });
-
     /* mock the latest block id query api call. */
     dataservice->register_callback_block_id_latest_read(
         [&](const dataservice_request_block_id_latest_read_t&,
@@ -1014,10 +523,6 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_multiple_blocks)
     /* set our expected caps. */
     BITCAP(EXPECTED_CAPS, DATASERVICE_API_CAP_BITS_MAX);
     BITCAP_INIT_FALSE(EXPECTED_CAPS);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_FIRST_READ);
-    BITCAP_SET_TRUE(
-        EXPECTED_CAPS, DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(
         EXPECTED_CAPS, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
     BITCAP_SET_TRUE(
@@ -1027,98 +532,27 @@ TEST_F(canonizationservice_isolation_test, multiple_attested_multiple_blocks)
     BITCAP_SET_TRUE(
         EXPECTED_CAPS, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CLOSE);
 
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a block make call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_make(
-            EXPECTED_CHILD_INDEX, NULL, 0, NULL));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a block make call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_make(
-            EXPECTED_CHILD_INDEX, NULL, 0, NULL));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a block make call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_make(
-            EXPECTED_CHILD_INDEX, NULL, 0, NULL));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child create should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_create(
-            EXPECTED_CAPS));
-
-    /* a get latest block id call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_id_latest_read(
-            EXPECTED_CHILD_INDEX));
-
-    /* a second get first call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_transaction_get_first(
-            EXPECTED_CHILD_INDEX));
-
-    /* a child close should have occurred. */
-    EXPECT_TRUE(
-        dataservice->request_matches_child_context_close(
-            EXPECTED_CHILD_INDEX));
+    /* three rounds should occur: two full blocks and one empty queue. */
+    for (int i = 0; i < 3; ++i)
+    {
+        /* a child create should have occurred. */
+        EXPECT_TRUE(
+            dataservice->request_matches_child_context_create(
+                EXPECTED_CAPS));
+
+        /* a get latest block id call should have been made. */
+        EXPECT_TRUE(
+            dataservice->request_matches_block_id_latest_read(
+                EXPECTED_CHILD_INDEX));
+
+        /* a block make from queue call should have been made. */
+        EXPECT_TRUE(
+            dataservice->request_matches_block_make_from_queue(
+                EXPECTED_CHILD_INDEX, NULL, 1, 1));
+
+        /* a child close should have occurred. */
+        EXPECT_TRUE(
+            dataservice->request_matches_child_context_close(
+                EXPECTED_CHILD_INDEX));
+    }
 }
@@ -312,6 +312,133 @@ TEST(config_test, loglevel_bad_range)
     dispose((disposable_t*)&user_context);
 }
 
+/**
+ * Test that a protocol workers setting adds this data to the config.
+ */
+TEST(config_test, protocol_workers_config)
+{
+    YY_BUFFER_STATE state;
+    yyscan_t scanner;
+    config_context_t context;
+    test_context user_context;
+
+    test_context_init(&user_context);
+
+    context.set_error = &set_error;
+    context.val_callback = &config_callback;
+    context.user_context = &user_context;
+
+    ASSERT_EQ(0, yylex_init(&scanner));
+    ASSERT_NE(nullptr,
+        state = yy_scan_string("protocol workers 4", scanner));
+    ASSERT_EQ(0, yyparse(scanner, &context));
+    yy_delete_buffer(state, scanner);
+    yylex_destroy(scanner);
+
+    /* there are no errors. */
+    ASSERT_EQ(0U, user_context.errors.size());
+
+    /* verify user config. */
+    ASSERT_NE(nullptr, user_context.config);
+    ASSERT_FALSE(user_context.config->loglevel_set);
+    ASSERT_TRUE(user_context.config->protocol_workers_set);
+    ASSERT_EQ(4L, user_context.config->protocol_workers);
+
+    dispose((disposable_t*)&user_context);
+}
+
+/**
+ * Test that bad protocol workers ranges raise an error.
+ */
+TEST(config_test, protocol_workers_bad_range)
+{
+    YY_BUFFER_STATE state;
+    yyscan_t scanner;
+    config_context_t context;
+    test_context user_context;
+
+    test_context_init(&user_context);
+
+    context.set_error = &set_error;
+    context.val_callback = &config_callback;
+    context.user_context = &user_context;
+
+    ASSERT_EQ(0, yylex_init(&scanner));
+    ASSERT_NE(nullptr,
+        state = yy_scan_string("protocol workers 0", scanner));
+    ASSERT_EQ(0, yyparse(scanner, &context));
+    yy_delete_buffer(state, scanner);
+    yylex_destroy(scanner);
+
+    /* there is one error. */
+    ASSERT_EQ(1U, user_context.errors.size());
+
+    dispose((disposable_t*)&user_context);
+}
+
+/**
+ * Test that an ipc ring setting adds this data to the config.
+ */
+TEST(config_test, ipc_ring_config)
+{
+    YY_BUFFER_STATE state;
+    yyscan_t scanner;
+    config_context_t context;
+    test_context user_context;
+
+    test_context_init(&user_context);
+
+    context.set_error = &set_error;
+    context.val_callback = &config_callback;
+    context.user_context = &user_context;
+
+    ASSERT_EQ(0, yylex_init(&scanner));
+    ASSERT_NE(nullptr,
+        state = yy_scan_string("ipc ring 65536", scanner));
+    ASSERT_EQ(0, yyparse(scanner, &context));
+    yy_delete_buffer(state, scanner);
+    yylex_destroy(scanner);
+
+    /* there are no errors. */
+    ASSERT_EQ(0U, user_context.errors.size());
+
+    /* verify user config. */
+    ASSERT_NE(nullptr, user_context.config);
+    ASSERT_TRUE(user_context.config->ipc_ring_capacity_set);
+    ASSERT_EQ(65536L, user_context.config->ipc_ring_capacity);
+
+    dispose((disposable_t*)&user_context);
+}
+
+/**
+ * Test that an ipc ring capacity that isn't a power of two raises an error.
+ */
+TEST(config_test, ipc_ring_bad_capacity)
+{
+    YY_BUFFER_STATE state;
+    yyscan_t scanner;
+    config_context_t context;
+    test_context user_context;
+
+    test_context_init(&user_context);
+
+    context.set_error = &set_error;
+    context.val_callback = &config_callback;
+    context.user_context = &user_context;
+
+    ASSERT_EQ(0, yylex_init(&scanner));
+    ASSERT_NE(nullptr,
+        state = yy_scan_string("ipc ring 10000", scanner));
+    ASSERT_EQ(0, yyparse(scanner, &context));
+    yy_delete_buffer(state, scanner);
+    yylex_destroy(scanner);
+
+    /* there is one error. */
+    ASSERT_EQ(1U, user_context.errors.size());
+
+    dispose((disposable_t*)&user_context);
+}
+
 /**
  * Test that the secret parameter adds data to the config.
  */
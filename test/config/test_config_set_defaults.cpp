@@ -105,6 +105,7 @@ TEST(config_set_defaults_test, empty_config)
     ASSERT_FALSE(user_context.config->loglevel_set);
     ASSERT_FALSE(user_context.config->block_max_milliseconds_set);
     ASSERT_FALSE(user_context.config->block_max_transactions_set);
+    ASSERT_FALSE(user_context.config->protocol_workers_set);
     ASSERT_EQ(nullptr, user_context.config->secret);
     ASSERT_EQ(nullptr, user_context.config->rootblock);
     ASSERT_EQ(nullptr, user_context.config->datastore);
@@ -124,6 +125,8 @@ TEST(config_set_defaults_test, empty_config)
     ASSERT_EQ(5000, user_context.config->block_max_milliseconds);
     ASSERT_TRUE(user_context.config->block_max_transactions_set);
     ASSERT_EQ(500, user_context.config->block_max_transactions);
+    ASSERT_TRUE(user_context.config->protocol_workers_set);
+    ASSERT_EQ(1, user_context.config->protocol_workers);
     ASSERT_STREQ("root/secret.cert", user_context.config->secret);
     ASSERT_STREQ("root/root.cert", user_context.config->rootblock);
     ASSERT_STREQ("data", user_context.config->datastore);
@@ -9,6 +9,7 @@
 #include <agentd/dataservice/api.h>
 #include <agentd/status_codes.h>
 #include <vccert/certificate_types.h>
+#include <vector>
 
 #include "test_dataservice.h"
 
@@ -2906,6 +2907,139 @@ TEST_F(dataservice_test, transaction_promote)
     dispose((disposable_t*)&ctx);
 }
 
+/**
+ * Test that updating the header of transactions whose certificates span
+ * overflow pages preserves the certificates.
+ */
+TEST_F(dataservice_test, transaction_promote_drop_large_certificates)
+{
+    uint8_t foo1_key[16] = {
+        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
+        0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
+    };
+    uint8_t foo2_key[16] = {
+        0x3b, 0x2c, 0x2b, 0x3b, 0x8f, 0x0e, 0x47, 0x87,
+        0xa2, 0x7a, 0xd2, 0x43, 0x3e, 0x55, 0xbc, 0x3e
+    };
+    uint8_t foo3_key[16] = {
+        0xd3, 0x57, 0x10, 0x49, 0x8f, 0x12, 0x4f, 0x3b,
+        0x9d, 0x08, 0xd6, 0x0f, 0x53, 0x0d, 0xd7, 0x04
+    };
+    uint8_t foo_artifact[16] = {
+        0xcf, 0xa1, 0x51, 0xc4, 0x7c, 0x0f, 0x4d, 0xbd,
+        0xa0, 0xd6, 0x22, 0x51, 0x34, 0xd1, 0x61, 0xdc
+    };
+    uint8_t begin_key[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t end_key[16] = {
+        0Xff, 0Xff, 0Xff, 0Xff, 0Xff, 0Xff, 0Xff, 0Xff,
+        0Xff, 0Xff, 0Xff, 0Xff, 0Xff, 0Xff, 0Xff, 0Xff
+    };
+    vector<uint8_t> foo1_data(10000), foo2_data(10000), foo3_data(10000);
+    uint8_t* txn_bytes = NULL;
+    size_t txn_size = 0;
+    data_transaction_node_t node;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+    string DB_PATH;
+
+    /* fill each certificate with a distinct pattern. */
+    for (size_t i = 0; i < foo1_data.size(); ++i)
+    {
+        foo1_data[i] = (uint8_t)i;
+        foo2_data[i] = (uint8_t)(i * 3);
+        foo3_data[i] = (uint8_t)(i * 7);
+    }
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_PROMOTE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_DROP);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* submit all three transactions. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_submit(
+            &child, nullptr, foo1_key, foo_artifact, foo1_data.data(),
+            foo1_data.size()));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_submit(
+            &child, nullptr, foo2_key, foo_artifact, foo2_data.data(),
+            foo2_data.size()));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_submit(
+            &child, nullptr, foo3_key, foo_artifact, foo3_data.data(),
+            foo3_data.size()));
+
+    /* promote the second transaction. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_promote(
+            &child, nullptr, foo2_key));
+
+    /* drop the first transaction. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_drop(
+            &child, nullptr, foo1_key));
+
+    /* the second transaction is now first, and its certificate is intact. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_get_first(
+            &child, nullptr, &node, &txn_bytes, &txn_size));
+    EXPECT_EQ(0, memcmp(node.key, foo2_key, 16));
+    EXPECT_EQ(0, memcmp(node.prev, begin_key, 16));
+    EXPECT_EQ(0, memcmp(node.next, foo3_key, 16));
+    EXPECT_EQ(
+        DATASERVICE_TRANSACTION_NODE_STATE_ATTESTED,
+        ntohl(node.net_txn_state));
+    ASSERT_EQ(foo2_data.size(), txn_size);
+    EXPECT_EQ(0, memcmp(txn_bytes, foo2_data.data(), txn_size));
+    free(txn_bytes);
+
+    /* the third transaction's certificate is intact. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_transaction_get(
+            &child, nullptr, foo3_key, &node, &txn_bytes, &txn_size));
+    EXPECT_EQ(0, memcmp(node.prev, foo2_key, 16));
+    EXPECT_EQ(0, memcmp(node.next, end_key, 16));
+    ASSERT_EQ(foo3_data.size(), txn_size);
+    EXPECT_EQ(0, memcmp(txn_bytes, foo3_data.data(), txn_size));
+    free(txn_bytes);
+
+    /* dispose of the context. */
+    dispose((disposable_t*)&ctx);
+}
+
 /**
  * Test that dataservice_transaction_submit respects the bitcap for this action.
  */
@@ -3366,14 +3500,23 @@ TEST_F(dataservice_test, transaction_make_block_simple)
 }
 
 /**
- * Test that the bitset is enforced for making blocks.
+ * Test that a block with several transactions for the same artifact records
+ * the first and latest of these transactions in the artifact record.
  */
-TEST_F(dataservice_test, transaction_make_block_bitset)
+TEST_F(dataservice_test, transaction_make_block_same_artifact)
 {
-    uint8_t foo_key[16] = {
+    uint8_t foo1_key[16] = {
         0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
         0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
     };
+    uint8_t foo2_key[16] = {
+        0x3b, 0x2c, 0x2b, 0x3b, 0x8f, 0x0e, 0x47, 0x87,
+        0xa2, 0x7a, 0xd2, 0x43, 0x3e, 0x55, 0xbc, 0x3e
+    };
+    uint8_t foo3_key[16] = {
+        0xd3, 0x57, 0x10, 0x49, 0x8f, 0x12, 0x4f, 0x3b,
+        0x9d, 0x08, 0xd6, 0x0f, 0x53, 0x0d, 0xd7, 0x04
+    };
     uint8_t foo_prev[16] = {
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
@@ -3386,13 +3529,21 @@ TEST_F(dataservice_test, transaction_make_block_bitset)
         0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
         0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
     };
-    uint8_t* foo_cert = nullptr;
-    size_t foo_cert_length = 0;
+    uint8_t* foo1_cert = nullptr;
+    size_t foo1_cert_length = 0;
+    uint8_t* foo2_cert = nullptr;
+    size_t foo2_cert_length = 0;
+    uint8_t* foo3_cert = nullptr;
+    size_t foo3_cert_length = 0;
     uint8_t* foo_block_cert = nullptr;
     size_t foo_block_cert_length = 0;
     string DB_PATH;
     dataservice_root_context_t ctx;
     dataservice_child_context_t child;
+    data_transaction_node_t node;
+    data_artifact_record_t foo_artifact_record;
+    uint8_t* txn_bytes;
+    size_t txn_size;
 
     /* create the directory for this test. */
     ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
@@ -3412,15 +3563,14 @@ TEST_F(dataservice_test, transaction_make_block_bitset)
 
     /* create a reduced capabilities set for the child context. */
     BITCAP_INIT_FALSE(reducedcaps);
-    /* DO NOT ALLOW BLOCK_WRITE. */
-    /*BITCAP_SET_TRUE(reducedcaps,
-                    DATASERVICE_API_CAP_APP_BLOCK_WRITE);*/
     BITCAP_SET_TRUE(reducedcaps,
-        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+        DATASERVICE_API_CAP_APP_BLOCK_WRITE);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_ARTIFACT_READ);
 
     /* explicitly grant the capability to create child contexts in the child
      * context. */
@@ -3430,47 +3580,92 @@ TEST_F(dataservice_test, transaction_make_block_bitset)
     /* create a child context using this reduced capabilities set. */
     ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
 
-    /* create foo transaction. */
+    /* create three transactions for the same artifact. */
     ASSERT_EQ(0,
         create_dummy_transaction(
-            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+            foo1_key, foo_prev, foo_artifact, &foo1_cert, &foo1_cert_length));
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo2_key, foo1_key, foo_artifact, &foo2_cert, &foo2_cert_length));
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo3_key, foo2_key, foo_artifact, &foo3_cert, &foo3_cert_length));
 
-    /* submit foo transaction. */
+    /* submit these transactions. */
     ASSERT_EQ(0,
         dataservice_transaction_submit(
-            &child, nullptr, foo_key, foo_artifact, foo_cert,
-            foo_cert_length));
+            &child, nullptr, foo1_key, foo_artifact, foo1_cert,
+            foo1_cert_length));
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo2_key, foo_artifact, foo2_cert,
+            foo2_cert_length));
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo3_key, foo_artifact, foo3_cert,
+            foo3_cert_length));
 
-    /* create foo block. */
+    /* create a block holding all three transactions. */
     ASSERT_EQ(0,
         create_dummy_block(
             &builder_opts,
             foo_block_id, vccert_certificate_type_uuid_root_block, 1,
             &foo_block_cert, &foo_block_cert_length,
-            foo_cert, foo_cert_length,
+            foo1_cert, foo1_cert_length,
+            foo2_cert, foo2_cert_length,
+            foo3_cert, foo3_cert_length,
             nullptr));
 
-    /* make block should fail because of missing capability. */
-    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED,
+    /* make block. */
+    ASSERT_EQ(0,
         dataservice_block_make(
             &child, nullptr, foo_block_id,
             foo_block_cert, foo_block_cert_length));
 
+    /* the middle transaction is linked to its neighbors. */
+    ASSERT_EQ(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, foo2_key, &node, &txn_bytes, &txn_size));
+    EXPECT_EQ(0, memcmp(node.prev, foo1_key, 16));
+    EXPECT_EQ(0, memcmp(node.next, foo3_key, 16));
+    free(txn_bytes);
+
+    /* getting the artifact record by artifact id should return success. */
+    ASSERT_EQ(0,
+        dataservice_artifact_get(
+            &child, nullptr, foo_artifact, &foo_artifact_record));
+    /* the key should match the artifact ID. */
+    EXPECT_EQ(0, memcmp(foo_artifact_record.key, foo_artifact, 16));
+    /* the first transaction should be the first foo transaction. */
+    EXPECT_EQ(0, memcmp(foo_artifact_record.txn_first, foo1_key, 16));
+    /* the latest transaction should be the last foo transaction. */
+    EXPECT_EQ(0, memcmp(foo_artifact_record.txn_latest, foo3_key, 16));
+    /* the first and latest heights for this artifact should be 1. */
+    EXPECT_EQ(1U, ntohll(foo_artifact_record.net_height_first));
+    EXPECT_EQ(1U, ntohll(foo_artifact_record.net_height_latest));
+
     /* clean up. */
     dispose((disposable_t*)&ctx);
-    free(foo_cert);
+    free(foo1_cert);
+    free(foo2_cert);
+    free(foo3_cert);
     free(foo_block_cert);
 }
 
 /**
- * Test that appending a block with an invalid height will fail.
+ * Test that a block holding a transaction before its predecessor is rejected,
+ * and that none of its transactions leave the transaction queue.
  */
-TEST_F(dataservice_test, transaction_make_block_bad_height)
+TEST_F(dataservice_test, transaction_make_block_out_of_order)
 {
-    uint8_t foo_key[16] = {
+    uint8_t foo1_key[16] = {
         0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
         0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
     };
+    uint8_t foo2_key[16] = {
+        0x3b, 0x2c, 0x2b, 0x3b, 0x8f, 0x0e, 0x47, 0x87,
+        0xa2, 0x7a, 0xd2, 0x43, 0x3e, 0x55, 0xbc, 0x3e
+    };
     uint8_t foo_prev[16] = {
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
@@ -3483,13 +3678,18 @@ TEST_F(dataservice_test, transaction_make_block_bad_height)
         0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
         0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
     };
-    uint8_t* foo_cert = nullptr;
-    size_t foo_cert_length = 0;
+    uint8_t* foo1_cert = nullptr;
+    size_t foo1_cert_length = 0;
+    uint8_t* foo2_cert = nullptr;
+    size_t foo2_cert_length = 0;
     uint8_t* foo_block_cert = nullptr;
     size_t foo_block_cert_length = 0;
     string DB_PATH;
     dataservice_root_context_t ctx;
     dataservice_child_context_t child;
+    data_transaction_node_t node;
+    uint8_t* txn_bytes;
+    size_t txn_size;
 
     /* create the directory for this test. */
     ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
@@ -3511,10 +3711,10 @@ TEST_F(dataservice_test, transaction_make_block_bad_height)
     BITCAP_INIT_FALSE(reducedcaps);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_BLOCK_WRITE);
-    BITCAP_SET_TRUE(reducedcaps,
-        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_TRANSACTION_READ);
 
@@ -3526,48 +3726,89 @@ TEST_F(dataservice_test, transaction_make_block_bad_height)
     /* create a child context using this reduced capabilities set. */
     ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
 
-    /* create foo transaction. */
+    /* create two transactions for the same artifact. */
     ASSERT_EQ(0,
         create_dummy_transaction(
-            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+            foo1_key, foo_prev, foo_artifact, &foo1_cert, &foo1_cert_length));
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo2_key, foo1_key, foo_artifact, &foo2_cert, &foo2_cert_length));
 
-    /* submit foo transaction. */
+    /* submit these transactions. */
     ASSERT_EQ(0,
         dataservice_transaction_submit(
-            &child, nullptr, foo_key, foo_artifact, foo_cert,
-            foo_cert_length));
+            &child, nullptr, foo1_key, foo_artifact, foo1_cert,
+            foo1_cert_length));
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo2_key, foo_artifact, foo2_cert,
+            foo2_cert_length));
 
-    /* create foo block with invalid 0 block height. */
+    /* create a block holding the second transaction before the first. */
     ASSERT_EQ(0,
         create_dummy_block(
             &builder_opts,
-            foo_block_id, vccert_certificate_type_uuid_root_block, 0,
+            foo_block_id, vccert_certificate_type_uuid_root_block, 1,
             &foo_block_cert, &foo_block_cert_length,
-            foo_cert, foo_cert_length,
+            foo2_cert, foo2_cert_length,
+            foo1_cert, foo1_cert_length,
             nullptr));
 
-    /* make block fails due to invalid block height. */
-    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT,
+    /* make block fails because foo2 precedes its predecessor. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_BLOCK_TRANSACTION_OUT_OF_ORDER,
         dataservice_block_make(
             &child, nullptr, foo_block_id,
             foo_block_cert, foo_block_cert_length));
 
+    /* neither transaction was canonized. */
+    EXPECT_NE(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, foo1_key, &node, &txn_bytes, &txn_size));
+    EXPECT_NE(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, foo2_key, &node, &txn_bytes, &txn_size));
+
+    /* both transactions are still in the transaction queue. */
+    ASSERT_EQ(0,
+        dataservice_transaction_get(
+            &child, nullptr, foo1_key, &node, &txn_bytes, &txn_size));
+    free(txn_bytes);
+    ASSERT_EQ(0,
+        dataservice_transaction_get(
+            &child, nullptr, foo2_key, &node, &txn_bytes, &txn_size));
+    free(txn_bytes);
+
     /* clean up. */
     dispose((disposable_t*)&ctx);
-    free(foo_cert);
+    free(foo1_cert);
+    free(foo2_cert);
     free(foo_block_cert);
 }
 
 /**
- * Test that appending a block with an invalid previous block ID will fail.
+ * Test that transactions whose predecessors are in an earlier block are
+ * linked to those predecessors, and that the predecessors keep their
+ * certificates when their headers are rewritten.
  */
-TEST_F(dataservice_test, transaction_make_block_bad_prev_block_id)
+TEST_F(dataservice_test, transaction_make_block_prev_in_earlier_block)
 {
-    uint8_t foo_key[16] = {
+    uint8_t foo1_key[16] = {
         0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
         0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
     };
-    uint8_t foo_prev[16] = {
+    uint8_t foo2_key[16] = {
+        0x3b, 0x2c, 0x2b, 0x3b, 0x8f, 0x0e, 0x47, 0x87,
+        0xa2, 0x7a, 0xd2, 0x43, 0x3e, 0x55, 0xbc, 0x3e
+    };
+    uint8_t bar1_key[16] = {
+        0xd3, 0x57, 0x10, 0x49, 0x8f, 0x12, 0x4f, 0x3b,
+        0x9d, 0x08, 0xd6, 0x0f, 0x53, 0x0d, 0xd7, 0x04
+    };
+    uint8_t bar2_key[16] = {
+        0x12, 0xa1, 0x6c, 0x5e, 0x0b, 0x33, 0x4e, 0x1d,
+        0x8a, 0x51, 0x70, 0x2f, 0xc4, 0x9e, 0x06, 0xb7
+    };
+    uint8_t zero_prev[16] = {
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
         0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
     };
@@ -3575,17 +3816,37 @@ TEST_F(dataservice_test, transaction_make_block_bad_prev_block_id)
         0xef, 0x44, 0xe7, 0xb4, 0xbf, 0x39, 0x45, 0xe4,
         0xb3, 0x4b, 0x6e, 0x82, 0xee, 0x41, 0x76, 0x21
     };
-    uint8_t foo_block_id[16] = {
+    uint8_t bar_artifact[16] = {
+        0x41, 0x6b, 0x1f, 0x0c, 0x7a, 0x58, 0x4d, 0x92,
+        0xb6, 0x2e, 0x13, 0x9d, 0x5f, 0xa0, 0xc8, 0x74
+    };
+    uint8_t block1_id[16] = {
         0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
         0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
     };
-    uint8_t* foo_cert = nullptr;
-    size_t foo_cert_length = 0;
-    uint8_t* foo_block_cert = nullptr;
-    size_t foo_block_cert_length = 0;
+    uint8_t block2_id[16] = {
+        0x5c, 0x0f, 0x2a, 0x8e, 0x61, 0xd4, 0x4b, 0x07,
+        0x9f, 0x3c, 0xe2, 0x18, 0x47, 0xb5, 0x2d, 0x6a
+    };
+    uint8_t* foo1_cert = nullptr;
+    size_t foo1_cert_length = 0;
+    uint8_t* foo2_cert = nullptr;
+    size_t foo2_cert_length = 0;
+    uint8_t* bar1_cert = nullptr;
+    size_t bar1_cert_length = 0;
+    uint8_t* bar2_cert = nullptr;
+    size_t bar2_cert_length = 0;
+    uint8_t* block1_cert = nullptr;
+    size_t block1_cert_length = 0;
+    uint8_t* block2_cert = nullptr;
+    size_t block2_cert_length = 0;
     string DB_PATH;
     dataservice_root_context_t ctx;
     dataservice_child_context_t child;
+    data_transaction_node_t node;
+    data_artifact_record_t artifact_record;
+    uint8_t* txn_bytes;
+    size_t txn_size;
 
     /* create the directory for this test. */
     ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
@@ -3607,12 +3868,12 @@ TEST_F(dataservice_test, transaction_make_block_bad_prev_block_id)
     BITCAP_INIT_FALSE(reducedcaps);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_BLOCK_WRITE);
-    BITCAP_SET_TRUE(reducedcaps,
-        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
     BITCAP_SET_TRUE(reducedcaps,
         DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_ARTIFACT_READ);
 
     /* explicitly grant the capability to create child contexts in the child
      * context. */
@@ -3622,45 +3883,567 @@ TEST_F(dataservice_test, transaction_make_block_bad_prev_block_id)
     /* create a child context using this reduced capabilities set. */
     ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
 
-    /* create foo transaction. */
+    /* create two transactions for each of two artifacts. */
     ASSERT_EQ(0,
         create_dummy_transaction(
-            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+            foo1_key, zero_prev, foo_artifact, &foo1_cert, &foo1_cert_length));
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo2_key, foo1_key, foo_artifact, &foo2_cert, &foo2_cert_length));
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            bar1_key, zero_prev, bar_artifact, &bar1_cert, &bar1_cert_length));
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            bar2_key, bar1_key, bar_artifact, &bar2_cert, &bar2_cert_length));
 
-    /* submit foo transaction. */
+    /* submit the first transaction of each artifact. */
     ASSERT_EQ(0,
         dataservice_transaction_submit(
-            &child, nullptr, foo_key, foo_artifact, foo_cert,
-            foo_cert_length));
+            &child, nullptr, foo1_key, foo_artifact, foo1_cert,
+            foo1_cert_length));
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, bar1_key, bar_artifact, bar1_cert,
+            bar1_cert_length));
 
-    /* create foo block with invalid previous block ID. */
+    /* make the first block from these transactions. */
     ASSERT_EQ(0,
         create_dummy_block(
             &builder_opts,
-            foo_block_id, zero_uuid, 1,
-            &foo_block_cert, &foo_block_cert_length,
-            foo_cert, foo_cert_length,
+            block1_id, vccert_certificate_type_uuid_root_block, 1,
+            &block1_cert, &block1_cert_length,
+            foo1_cert, foo1_cert_length,
+            bar1_cert, bar1_cert_length,
             nullptr));
-
-    /* make block fails due to invalid previous block ID. */
-    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_INVALID_PREVIOUS_BLOCK_UUID,
+    ASSERT_EQ(0,
         dataservice_block_make(
-            &child, nullptr, foo_block_id,
-            foo_block_cert, foo_block_cert_length));
+            &child, nullptr, block1_id, block1_cert, block1_cert_length));
 
-    /* clean up. */
-    dispose((disposable_t*)&ctx);
-    free(foo_cert);
-    free(foo_block_cert);
-}
+    /* submit the second transaction of each artifact. */
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo2_key, foo_artifact, foo2_cert,
+            foo2_cert_length));
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, bar2_key, bar_artifact, bar2_cert,
+            bar2_cert_length));
 
-/**
- * Test that appending a block with an invalid block ID will fail.
- */
-TEST_F(dataservice_test, transaction_make_block_bad_block_id)
-{
-    uint8_t foo_key[16] = {
-        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
+    /* make the second block from these transactions. */
+    ASSERT_EQ(0,
+        create_dummy_block(
+            &builder_opts,
+            block2_id, block1_id, 2,
+            &block2_cert, &block2_cert_length,
+            bar2_cert, bar2_cert_length,
+            foo2_cert, foo2_cert_length,
+            nullptr));
+    ASSERT_EQ(0,
+        dataservice_block_make(
+            &child, nullptr, block2_id, block2_cert, block2_cert_length));
+
+    /* the first foo transaction points at the second and kept its cert. */
+    ASSERT_EQ(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, foo1_key, &node, &txn_bytes, &txn_size));
+    EXPECT_EQ(0, memcmp(node.next, foo2_key, 16));
+    EXPECT_EQ(0, memcmp(node.block_id, block1_id, 16));
+    ASSERT_EQ(foo1_cert_length, txn_size);
+    EXPECT_EQ(0, memcmp(txn_bytes, foo1_cert, txn_size));
+    free(txn_bytes);
+
+    /* the first bar transaction points at the second and kept its cert. */
+    ASSERT_EQ(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, bar1_key, &node, &txn_bytes, &txn_size));
+    EXPECT_EQ(0, memcmp(node.next, bar2_key, 16));
+    ASSERT_EQ(bar1_cert_length, txn_size);
+    EXPECT_EQ(0, memcmp(txn_bytes, bar1_cert, txn_size));
+    free(txn_bytes);
+
+    /* the second foo transaction points back at the first. */
+    ASSERT_EQ(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, foo2_key, &node, &txn_bytes, &txn_size));
+    EXPECT_EQ(0, memcmp(node.prev, foo1_key, 16));
+    EXPECT_EQ(0, memcmp(node.block_id, block2_id, 16));
+    ASSERT_EQ(foo2_cert_length, txn_size);
+    EXPECT_EQ(0, memcmp(txn_bytes, foo2_cert, txn_size));
+    free(txn_bytes);
+
+    /* each artifact record spans both blocks. */
+    ASSERT_EQ(0,
+        dataservice_artifact_get(
+            &child, nullptr, foo_artifact, &artifact_record));
+    EXPECT_EQ(0, memcmp(artifact_record.txn_first, foo1_key, 16));
+    EXPECT_EQ(0, memcmp(artifact_record.txn_latest, foo2_key, 16));
+    EXPECT_EQ(1U, ntohll(artifact_record.net_height_first));
+    EXPECT_EQ(2U, ntohll(artifact_record.net_height_latest));
+    ASSERT_EQ(0,
+        dataservice_artifact_get(
+            &child, nullptr, bar_artifact, &artifact_record));
+    EXPECT_EQ(0, memcmp(artifact_record.txn_first, bar1_key, 16));
+    EXPECT_EQ(0, memcmp(artifact_record.txn_latest, bar2_key, 16));
+    EXPECT_EQ(1U, ntohll(artifact_record.net_height_first));
+    EXPECT_EQ(2U, ntohll(artifact_record.net_height_latest));
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+    free(foo1_cert);
+    free(foo2_cert);
+    free(bar1_cert);
+    free(bar2_cert);
+    free(block1_cert);
+    free(block2_cert);
+}
+
+/**
+ * Test that a block with more distinct artifacts than the artifact table
+ * starts with records each of them, including one updated on both sides of the
+ * table growing.
+ */
+TEST_F(dataservice_test, transaction_make_block_many_artifacts)
+{
+    const size_t ARTIFACT_COUNT = 24;
+    uint8_t keys[ARTIFACT_COUNT + 1][16];
+    uint8_t artifacts[ARTIFACT_COUNT][16];
+    uint8_t* certs[ARTIFACT_COUNT + 1];
+    size_t lengths[ARTIFACT_COUNT + 1];
+    uint8_t foo_block_id[16] = {
+        0x52, 0x0e, 0x61, 0x3c, 0x1a, 0x5b, 0x4f, 0x0d,
+        0x8e, 0x2b, 0x11, 0x9a, 0x60, 0x7c, 0x43, 0xd8
+    };
+    uint8_t* foo_block_cert = nullptr;
+    size_t foo_block_cert_length = 0;
+    string DB_PATH;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+    data_artifact_record_t record;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_WRITE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_ARTIFACT_READ);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* create one transaction per artifact, in descending artifact order. */
+    for (size_t i = 0; i < ARTIFACT_COUNT; ++i)
+    {
+        memset(keys[i], 0, 16);
+        keys[i][0] = 0x10;
+        keys[i][15] = (uint8_t)(i + 1);
+        memset(artifacts[i], 0, 16);
+        artifacts[i][0] = (uint8_t)(0xF0 - i);
+        artifacts[i][15] = 0x5A;
+
+        ASSERT_EQ(0,
+            create_dummy_transaction(
+                keys[i], zero_uuid, artifacts[i], &certs[i], &lengths[i]));
+        ASSERT_EQ(0,
+            dataservice_transaction_submit(
+                &child, nullptr, keys[i], artifacts[i], certs[i],
+                lengths[i]));
+    }
+
+    /* the last transaction updates the first artifact again. */
+    memset(keys[ARTIFACT_COUNT], 0, 16);
+    keys[ARTIFACT_COUNT][0] = 0x20;
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            keys[ARTIFACT_COUNT], keys[0], artifacts[0],
+            &certs[ARTIFACT_COUNT], &lengths[ARTIFACT_COUNT]));
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, keys[ARTIFACT_COUNT], artifacts[0],
+            certs[ARTIFACT_COUNT], lengths[ARTIFACT_COUNT]));
+
+    /* create a block holding every transaction. */
+    ASSERT_EQ(0,
+        create_dummy_block(
+            &builder_opts,
+            foo_block_id, vccert_certificate_type_uuid_root_block, 1,
+            &foo_block_cert, &foo_block_cert_length,
+            certs[0], lengths[0],
+            certs[1], lengths[1],
+            certs[2], lengths[2],
+            certs[3], lengths[3],
+            certs[4], lengths[4],
+            certs[5], lengths[5],
+            certs[6], lengths[6],
+            certs[7], lengths[7],
+            certs[8], lengths[8],
+            certs[9], lengths[9],
+            certs[10], lengths[10],
+            certs[11], lengths[11],
+            certs[12], lengths[12],
+            certs[13], lengths[13],
+            certs[14], lengths[14],
+            certs[15], lengths[15],
+            certs[16], lengths[16],
+            certs[17], lengths[17],
+            certs[18], lengths[18],
+            certs[19], lengths[19],
+            certs[20], lengths[20],
+            certs[21], lengths[21],
+            certs[22], lengths[22],
+            certs[23], lengths[23],
+            certs[24], lengths[24],
+            nullptr));
+
+    /* make block. */
+    ASSERT_EQ(0,
+        dataservice_block_make(
+            &child, nullptr, foo_block_id,
+            foo_block_cert, foo_block_cert_length));
+
+    /* every artifact has a record. */
+    for (size_t i = 0; i < ARTIFACT_COUNT; ++i)
+    {
+        ASSERT_EQ(0,
+            dataservice_artifact_get(
+                &child, nullptr, artifacts[i], &record));
+        EXPECT_EQ(0, memcmp(record.key, artifacts[i], 16));
+        EXPECT_EQ(0, memcmp(record.txn_first, keys[i], 16));
+        EXPECT_EQ(1U, ntohll(record.net_height_latest));
+
+        /* only the first artifact was updated twice. */
+        const uint8_t* latest = (0 == i) ? keys[ARTIFACT_COUNT] : keys[i];
+        EXPECT_EQ(0, memcmp(record.txn_latest, latest, 16));
+    }
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+    for (size_t i = 0; i <= ARTIFACT_COUNT; ++i)
+    {
+        free(certs[i]);
+    }
+    free(foo_block_cert);
+}
+
+/**
+ * Test that the bitset is enforced for making blocks.
+ */
+TEST_F(dataservice_test, transaction_make_block_bitset)
+{
+    uint8_t foo_key[16] = {
+        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
+        0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
+    };
+    uint8_t foo_prev[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t foo_artifact[16] = {
+        0xef, 0x44, 0xe7, 0xb4, 0xbf, 0x39, 0x45, 0xe4,
+        0xb3, 0x4b, 0x6e, 0x82, 0xee, 0x41, 0x76, 0x21
+    };
+    uint8_t foo_block_id[16] = {
+        0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
+        0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
+    };
+    uint8_t* foo_cert = nullptr;
+    size_t foo_cert_length = 0;
+    uint8_t* foo_block_cert = nullptr;
+    size_t foo_block_cert_length = 0;
+    string DB_PATH;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    /* DO NOT ALLOW BLOCK_WRITE. */
+    /*BITCAP_SET_TRUE(reducedcaps,
+                    DATASERVICE_API_CAP_APP_BLOCK_WRITE);*/
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* create foo transaction. */
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+
+    /* submit foo transaction. */
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo_key, foo_artifact, foo_cert,
+            foo_cert_length));
+
+    /* create foo block. */
+    ASSERT_EQ(0,
+        create_dummy_block(
+            &builder_opts,
+            foo_block_id, vccert_certificate_type_uuid_root_block, 1,
+            &foo_block_cert, &foo_block_cert_length,
+            foo_cert, foo_cert_length,
+            nullptr));
+
+    /* make block should fail because of missing capability. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED,
+        dataservice_block_make(
+            &child, nullptr, foo_block_id,
+            foo_block_cert, foo_block_cert_length));
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+    free(foo_cert);
+    free(foo_block_cert);
+}
+
+/**
+ * Test that appending a block with an invalid height will fail.
+ */
+TEST_F(dataservice_test, transaction_make_block_bad_height)
+{
+    uint8_t foo_key[16] = {
+        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
+        0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
+    };
+    uint8_t foo_prev[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t foo_artifact[16] = {
+        0xef, 0x44, 0xe7, 0xb4, 0xbf, 0x39, 0x45, 0xe4,
+        0xb3, 0x4b, 0x6e, 0x82, 0xee, 0x41, 0x76, 0x21
+    };
+    uint8_t foo_block_id[16] = {
+        0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
+        0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
+    };
+    uint8_t* foo_cert = nullptr;
+    size_t foo_cert_length = 0;
+    uint8_t* foo_block_cert = nullptr;
+    size_t foo_block_cert_length = 0;
+    string DB_PATH;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_WRITE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* create foo transaction. */
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+
+    /* submit foo transaction. */
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo_key, foo_artifact, foo_cert,
+            foo_cert_length));
+
+    /* create foo block with invalid 0 block height. */
+    ASSERT_EQ(0,
+        create_dummy_block(
+            &builder_opts,
+            foo_block_id, vccert_certificate_type_uuid_root_block, 0,
+            &foo_block_cert, &foo_block_cert_length,
+            foo_cert, foo_cert_length,
+            nullptr));
+
+    /* make block fails due to invalid block height. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT,
+        dataservice_block_make(
+            &child, nullptr, foo_block_id,
+            foo_block_cert, foo_block_cert_length));
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+    free(foo_cert);
+    free(foo_block_cert);
+}
+
+/**
+ * Test that appending a block with an invalid previous block ID will fail.
+ */
+TEST_F(dataservice_test, transaction_make_block_bad_prev_block_id)
+{
+    uint8_t foo_key[16] = {
+        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
+        0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
+    };
+    uint8_t foo_prev[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t foo_artifact[16] = {
+        0xef, 0x44, 0xe7, 0xb4, 0xbf, 0x39, 0x45, 0xe4,
+        0xb3, 0x4b, 0x6e, 0x82, 0xee, 0x41, 0x76, 0x21
+    };
+    uint8_t foo_block_id[16] = {
+        0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
+        0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
+    };
+    uint8_t* foo_cert = nullptr;
+    size_t foo_cert_length = 0;
+    uint8_t* foo_block_cert = nullptr;
+    size_t foo_block_cert_length = 0;
+    string DB_PATH;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_WRITE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* create foo transaction. */
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+
+    /* submit foo transaction. */
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo_key, foo_artifact, foo_cert,
+            foo_cert_length));
+
+    /* create foo block with invalid previous block ID. */
+    ASSERT_EQ(0,
+        create_dummy_block(
+            &builder_opts,
+            foo_block_id, zero_uuid, 1,
+            &foo_block_cert, &foo_block_cert_length,
+            foo_cert, foo_cert_length,
+            nullptr));
+
+    /* make block fails due to invalid previous block ID. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_INVALID_PREVIOUS_BLOCK_UUID,
+        dataservice_block_make(
+            &child, nullptr, foo_block_id,
+            foo_block_cert, foo_block_cert_length));
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+    free(foo_cert);
+    free(foo_block_cert);
+}
+
+/**
+ * Test that appending a block with an invalid block ID will fail.
+ */
+TEST_F(dataservice_test, transaction_make_block_bad_block_id)
+{
+    uint8_t foo_key[16] = {
+        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
         0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
     };
     uint8_t foo_prev[16] = {
@@ -3751,6 +4534,272 @@ TEST_F(dataservice_test, transaction_make_block_bad_block_id)
     free(foo_block_cert);
 }
 
+/**
+ * Test that we can make a block from the attested transactions in the process
+ * queue.
+ */
+TEST_F(dataservice_test, transaction_make_block_from_queue_simple)
+{
+    uint8_t foo_key[16] = {
+        0x9b, 0xfe, 0xec, 0xc9, 0x28, 0x5d, 0x44, 0xba,
+        0x84, 0xdf, 0xd6, 0xfd, 0x3e, 0xe8, 0x79, 0x2f
+    };
+    uint8_t foo_prev[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t foo_artifact[16] = {
+        0xef, 0x44, 0xe7, 0xb4, 0xbf, 0x39, 0x45, 0xe4,
+        0xb3, 0x4b, 0x6e, 0x82, 0xee, 0x41, 0x76, 0x21
+    };
+    uint8_t bar_key[16] = {
+        0x2a, 0x8b, 0x41, 0x0e, 0x56, 0x4d, 0x4c, 0x8e,
+        0x9d, 0x3a, 0x6c, 0x1f, 0x0b, 0x77, 0xe2, 0x14
+    };
+    uint8_t bar_artifact[16] = {
+        0x71, 0x0f, 0x3d, 0x5a, 0x02, 0x9e, 0x4b, 0x61,
+        0xa8, 0x53, 0xc4, 0x0e, 0x91, 0x2d, 0x6f, 0xb7
+    };
+    uint8_t foo_block_id[16] = {
+        0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
+        0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
+    };
+    uint8_t* foo_cert = nullptr;
+    size_t foo_cert_length = 0;
+    uint8_t* bar_cert = nullptr;
+    size_t bar_cert_length = 0;
+    string DB_PATH;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+    data_transaction_node_t node;
+    data_artifact_record_t foo_artifact_record;
+    data_block_node_t block_node;
+    uint8_t* txn_bytes;
+    size_t txn_size;
+    uint8_t* block_txn_bytes;
+    size_t block_txn_size;
+    uint8_t block_id_for_height_1[16];
+    uint8_t latest_block_id[16];
+    uint8_t block_hash[64];
+    size_t block_hash_size = sizeof(block_hash);
+    size_t transaction_count = 0;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_WRITE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_PROMOTE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_ARTIFACT_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_ID_BY_HEIGHT_READ);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* an empty process queue can't make a block. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_NOT_FOUND,
+        dataservice_block_make_from_queue(
+            &child, nullptr, foo_block_id, 1, 10, 0, block_hash,
+            &block_hash_size, &transaction_count));
+
+    /* create foo transaction. */
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+
+    /* create bar transaction. */
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            bar_key, foo_prev, bar_artifact, &bar_cert, &bar_cert_length));
+
+    /* submit foo transaction. */
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, foo_key, foo_artifact, foo_cert,
+            foo_cert_length));
+
+    /* submit bar transaction. */
+    ASSERT_EQ(0,
+        dataservice_transaction_submit(
+            &child, nullptr, bar_key, bar_artifact, bar_cert,
+            bar_cert_length));
+
+    /* an unattested process queue can't make a block. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_NOT_FOUND,
+        dataservice_block_make_from_queue(
+            &child, nullptr, foo_block_id, 1, 10, 0, block_hash,
+            &block_hash_size, &transaction_count));
+
+    /* promote foo transaction. */
+    ASSERT_EQ(0,
+        dataservice_transaction_promote(
+            &child, nullptr, foo_key));
+
+    /* a block of the wrong height can't be made. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_INVALID_BLOCK_HEIGHT,
+        dataservice_block_make_from_queue(
+            &child, nullptr, foo_block_id, 2, 10, 0, block_hash,
+            &block_hash_size, &transaction_count));
+
+    /* make block. */
+    ASSERT_EQ(0,
+        dataservice_block_make_from_queue(
+            &child, nullptr, foo_block_id, 1, 10, 0, block_hash,
+            &block_hash_size, &transaction_count));
+
+    /* only the attested foo transaction is in this block. */
+    EXPECT_EQ(1U, transaction_count);
+    /* the block hash is a SHA-512 hash. */
+    EXPECT_EQ(64U, block_hash_size);
+
+    /* getting the foo transaction by id should return not found. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_NOT_FOUND,
+        dataservice_transaction_get(
+            &child, nullptr, foo_key, &node, &txn_bytes, &txn_size));
+
+    /* getting the bar transaction by id should still return success. */
+    ASSERT_EQ(0,
+        dataservice_transaction_get(
+            &child, nullptr, bar_key, &node, &txn_bytes, &txn_size));
+    free(txn_bytes);
+
+    /* getting the block transaction by id should return success. */
+    ASSERT_EQ(0,
+        dataservice_block_transaction_get(
+            &child, nullptr, foo_key, &node, &txn_bytes, &txn_size));
+    free(txn_bytes);
+
+    /* getting the block record by block id should return success. */
+    ASSERT_EQ(0,
+        dataservice_block_get(
+            &child, nullptr, foo_block_id, &block_node,
+            &block_txn_bytes, &block_txn_size));
+    /* the key should match our block id. */
+    ASSERT_EQ(0, memcmp(block_node.key, foo_block_id, 16));
+    ASSERT_EQ(0, memcmp(block_node.first_transaction_id, foo_key, 16));
+    ASSERT_EQ(1U, ntohll(block_node.net_block_height));
+    free(block_txn_bytes);
+
+    /* verify that a block ID exists for block height 1. */
+    ASSERT_EQ(0,
+        dataservice_block_id_by_height_get(
+            &child, nullptr, 1, block_id_for_height_1));
+    /* this block ID matches our block ID. */
+    EXPECT_EQ(0, memcmp(foo_block_id, block_id_for_height_1, 16));
+
+    /* verify that the latest block id matches our block id. */
+    ASSERT_EQ(0,
+        dataservice_latest_block_id_get(
+            &child, nullptr, latest_block_id));
+    /* this block ID matches our block ID. */
+    EXPECT_EQ(0, memcmp(foo_block_id, latest_block_id, 16));
+
+    /* getting the artifact record by artifact id should return success. */
+    ASSERT_EQ(0,
+        dataservice_artifact_get(
+            &child, nullptr, foo_artifact, &foo_artifact_record));
+    /* the first transaction should be the foo transaction. */
+    ASSERT_EQ(0, memcmp(foo_artifact_record.txn_first, foo_key, 16));
+    /* the first height for this artifact should be 1. */
+    ASSERT_EQ(1U, ntohll(foo_artifact_record.net_height_first));
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+    free(foo_cert);
+    free(bar_cert);
+}
+
+/**
+ * Test that the bitset is enforced for making blocks from the process queue.
+ */
+TEST_F(dataservice_test, transaction_make_block_from_queue_bitset)
+{
+    uint8_t foo_block_id[16] = {
+        0x96, 0x1e, 0xdd, 0x16, 0xbd, 0xa6, 0x4b, 0x9d,
+        0x93, 0xac, 0x40, 0xd4, 0x74, 0x85, 0x0d, 0xe5
+    };
+    string DB_PATH;
+    dataservice_root_context_t ctx;
+    dataservice_child_context_t child;
+    uint8_t block_hash[64];
+    size_t block_hash_size = sizeof(block_hash);
+    size_t transaction_count = 0;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+
+    /* precondition: ctx is invalid. */
+    memset(&ctx, 0xFF, sizeof(ctx));
+    /* precondition: disposer is NULL. */
+    ctx.hdr.dispose = nullptr;
+
+    /* explicitly grant the capability to create this root context. */
+    BITCAP_SET_TRUE(ctx.apicaps, DATASERVICE_API_CAP_LL_ROOT_CONTEXT_CREATE);
+
+    /* initialize the root context given a test data directory. */
+    ASSERT_EQ(0, dataservice_root_context_init(&ctx, DB_PATH.c_str()));
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP_INIT_FALSE(reducedcaps);
+    /* DO NOT ALLOW BLOCK_WRITE. */
+    /*BITCAP_SET_TRUE(reducedcaps,
+                    DATASERVICE_API_CAP_APP_BLOCK_WRITE);*/
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+
+    /* explicitly grant the capability to create child contexts in the child
+     * context. */
+    BITCAP_SET_TRUE(child.childcaps,
+        DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CREATE);
+
+    /* create a child context using this reduced capabilities set. */
+    ASSERT_EQ(0, dataservice_child_context_create(&ctx, &child, reducedcaps));
+
+    /* making a block should fail. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_NOT_AUTHORIZED,
+        dataservice_block_make_from_queue(
+            &child, nullptr, foo_block_id, 1, 10, 0, block_hash,
+            &block_hash_size, &transaction_count));
+
+    /* clean up. */
+    dispose((disposable_t*)&ctx);
+}
+
 /**
  * Test that dataservice_api_node_ref_is_beginning matches against a begin node.
  */
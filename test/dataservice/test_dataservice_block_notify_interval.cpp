@@ -0,0 +1,90 @@
+/**
+ * \file test_dataservice_block_notify_interval.cpp
+ *
+ * Test the block notification interval setting.
+ *
+ * \copyright 2020 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+#include "../../src/dataservice/dataservice_internal.h"
+
+using namespace std;
+
+/**
+ * \brief The default interval is used when none is set.
+ */
+TEST(dataservice_block_notify_interval_test, default_interval)
+{
+    uint32_t milliseconds = 0U;
+
+    unsetenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS");
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_block_notify_interval_get(false, &milliseconds));
+    EXPECT_EQ(DATASERVICE_BLOCK_NOTIFY_MILLISECONDS, milliseconds);
+}
+
+/**
+ * \brief A data service that is signaled of new blocks defaults to the longer
+ * fallback interval.
+ */
+TEST(dataservice_block_notify_interval_test, signaled_default_interval)
+{
+    uint32_t milliseconds = 0U;
+
+    unsetenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS");
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_block_notify_interval_get(true, &milliseconds));
+    EXPECT_EQ(DATASERVICE_BLOCK_NOTIFY_FALLBACK_MILLISECONDS, milliseconds);
+
+    /* a configured interval is used either way. */
+    ASSERT_EQ(0, setenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS", "250", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_block_notify_interval_get(true, &milliseconds));
+    EXPECT_EQ(250U, milliseconds);
+
+    unsetenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS");
+}
+
+/**
+ * \brief An interval within range is used.
+ */
+TEST(dataservice_block_notify_interval_test, configured_interval)
+{
+    uint32_t milliseconds = 0U;
+
+    ASSERT_EQ(0, setenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS", "10", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_block_notify_interval_get(false, &milliseconds));
+    EXPECT_EQ(10U, milliseconds);
+
+    ASSERT_EQ(0, setenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS", "60000", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_block_notify_interval_get(false, &milliseconds));
+    EXPECT_EQ(60000U, milliseconds);
+
+    unsetenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS");
+}
+
+/**
+ * \brief A malformed or out of range interval is rejected.
+ */
+TEST(dataservice_block_notify_interval_test, invalid_interval)
+{
+    const char* BAD[] = { "", "9", "60001", "-100", " 100", "100ms", "x" };
+    uint32_t milliseconds = 0U;
+
+    for (const char* bad : BAD)
+    {
+        ASSERT_EQ(0, setenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS", bad, 1));
+        EXPECT_EQ(AGENTD_ERROR_DATASERVICE_BLOCK_NOTIFY_INTERVAL_INVALID,
+            dataservice_block_notify_interval_get(false, &milliseconds)) << bad;
+    }
+
+    unsetenv("AGENTD_BLOCK_NOTIFY_MILLISECONDS");
+}
@@ -0,0 +1,92 @@
+/**
+ * \file test_dataservice_block_publish.cpp
+ *
+ * Test signaling committed blocks on the block publish sockets.
+ *
+ * \copyright 2020 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/dataservice.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <gtest/gtest.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "../../src/dataservice/dataservice_internal.h"
+
+using namespace std;
+
+/**
+ * \brief Each committed block is signaled on the block publish socket.
+ */
+TEST(dataservice_block_publish_test, signals_subscriber)
+{
+    dataservice_instance_t inst;
+    int publish, subscribe;
+    uint8_t signals[16];
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &subscribe, &publish));
+
+    memset(&inst, 0, sizeof(inst));
+    inst.block_publish_start = publish;
+    inst.block_publish_count = 1U;
+
+    dataservice_block_publish(&inst);
+    dataservice_block_publish(&inst);
+
+    /* every signal is waiting for the subscriber. */
+    EXPECT_EQ(2, recv(subscribe, signals, sizeof(signals), MSG_DONTWAIT));
+
+    close(subscribe);
+    close(publish);
+}
+
+/**
+ * \brief A subscriber that has gone away doesn't stop the publisher.
+ */
+TEST(dataservice_block_publish_test, closed_subscriber)
+{
+    dataservice_instance_t inst;
+    int publish, subscribe;
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &subscribe, &publish));
+    close(subscribe);
+
+    memset(&inst, 0, sizeof(inst));
+    inst.block_publish_start = publish;
+    inst.block_publish_count = 1U;
+
+    /* this must not raise SIGPIPE. */
+    dataservice_block_publish(&inst);
+
+    close(publish);
+}
+
+/**
+ * \brief Only the open descriptors at the start of a run are counted.
+ */
+TEST(dataservice_block_publish_test, count_sockets)
+{
+    const int START = 900;
+    int lhs, rhs;
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* lay out a run of two descriptors, followed by a closed descriptor. */
+    ASSERT_EQ(START, dup2(lhs, START));
+    ASSERT_EQ(START + 1, dup2(rhs, START + 1));
+    close(START + 2);
+
+    EXPECT_EQ(2U, dataservice_count_sockets(START));
+    EXPECT_EQ(0U, dataservice_count_sockets(START + 2));
+
+    close(START);
+    close(START + 1);
+    close(lhs);
+    close(rhs);
+}
@@ -2354,3 +2354,259 @@ TEST(dataservice_decode_test,
     /* the data pointer should be correct. */
     ASSERT_EQ(resp + 84, dresp.data);
 }
+
+/**
+ * Test that we check for sizes when decoding a block certificate read.
+ */
+TEST(dataservice_decode_test, response_block_cert_read_bad_sizes)
+{
+    uint8_t resp[100] = { 0 };
+    dataservice_response_block_cert_read_t dresp;
+    uint32_t net_method = htonl(DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ);
+    memcpy(resp, &net_method, sizeof(net_method));
+
+    /* a zero size is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_block_cert_read(
+            resp, 0, &dresp));
+
+    /* a truncated size is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_block_cert_read(
+            resp, 2 * sizeof(uint32_t), &dresp));
+
+    /* a successful response must hold the node. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_block_cert_read(
+            resp, 3 * sizeof(uint32_t) + 79, &dresp));
+
+    /* a slice can't be larger than the certificate, whose size is zero. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_block_cert_read(
+            resp, 3 * sizeof(uint32_t) + 81, &dresp));
+}
+
+/**
+ * Test that a block certificate read response packet with an invalid method
+ * code returns an error.
+ */
+TEST(dataservice_decode_test, response_block_cert_read_bad_method_code)
+{
+    uint8_t resp[12] = {
+        /* bad method code. */
+        0x80, 0x00, 0x00, 0x00,
+
+        /* offset == 1023 */
+        0x00, 0x00, 0x03, 0xFF,
+
+        /* status == 0x12345678 */
+        0x12, 0x34, 0x56, 0x78
+    };
+    dataservice_response_block_cert_read_t dresp;
+
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RECVRESP_UNEXPECTED_METHOD_CODE,
+        dataservice_decode_response_block_cert_read(
+            resp, sizeof(resp), &dresp));
+}
+
+/**
+ * Test that a block certificate read response packet carrying a slice of a
+ * larger certificate is successfully decoded.
+ */
+TEST(dataservice_decode_test, response_block_cert_read_decoded_slice)
+{
+    const uint8_t EXPECTED_NODE_KEY[] = {
+        0x1c, 0x44, 0x0e, 0x5b, 0x71, 0x3a, 0x4d, 0x2e,
+        0x8f, 0x90, 0x63, 0xd7, 0x2a, 0xb5, 0x06, 0xc1
+    };
+    const uint64_t EXPECTED_NET_BLOCK_HEIGHT = htonll(97);
+    const uint64_t EXPECTED_NET_CERT_SIZE = htonll(4096);
+    const uint8_t EXPECTED_SLICE[] = { 0x01, 0x02, 0x03, 0x04 };
+    uint8_t resp[3 * sizeof(uint32_t) + 80 + sizeof(EXPECTED_SLICE)];
+    dataservice_response_block_cert_read_t dresp;
+
+    /* build the response. */
+    uint32_t net_method = htonl(DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ);
+    uint32_t net_offset = htonl(1023);
+    uint32_t net_status = htonl(AGENTD_STATUS_SUCCESS);
+    memset(resp, 0, sizeof(resp));
+    memcpy(resp, &net_method, 4);
+    memcpy(resp + 4, &net_offset, 4);
+    memcpy(resp + 8, &net_status, 4);
+    memcpy(resp + 12, EXPECTED_NODE_KEY, 16);
+    memcpy(resp + 76, &EXPECTED_NET_BLOCK_HEIGHT, 8);
+    memcpy(resp + 84, &EXPECTED_NET_CERT_SIZE, 8);
+    memcpy(resp + 92, EXPECTED_SLICE, sizeof(EXPECTED_SLICE));
+
+    /* a valid response is successfully decoded. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_decode_response_block_cert_read(
+            resp, sizeof(resp), &dresp));
+
+    /* the disposer is set to the memset disposer. */
+    ASSERT_EQ(&dataservice_decode_response_memset_disposer,
+        dresp.hdr.hdr.dispose);
+    /* the header is correct. */
+    ASSERT_EQ(DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ,
+        dresp.hdr.method_code);
+    ASSERT_EQ(1023U, dresp.hdr.offset);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)dresp.hdr.status);
+    /* the node is correct. */
+    ASSERT_EQ(0, memcmp(EXPECTED_NODE_KEY, dresp.node.key, 16));
+    ASSERT_EQ(EXPECTED_NET_BLOCK_HEIGHT, dresp.node.net_block_height);
+    /* the certificate size is the size of the whole certificate. */
+    ASSERT_EQ(EXPECTED_NET_CERT_SIZE, dresp.node.net_block_cert_size);
+    /* the data is the slice. */
+    ASSERT_EQ(sizeof(EXPECTED_SLICE), dresp.data_size);
+    ASSERT_EQ(resp + 92, dresp.data);
+}
+
+/**
+ * Test that we check for sizes when decoding a block notification.
+ */
+TEST(dataservice_decode_test, response_block_notify_bad_sizes)
+{
+    uint32_t resp[9] = {
+        htonl(DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT),
+        htonl(1023),
+        htonl(AGENTD_STATUS_SUCCESS)
+    };
+    dataservice_response_block_notify_t dresp;
+
+    /* a truncated header is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_block_notify(
+            resp, 2 * sizeof(uint32_t), &dresp));
+
+    /* a successful notification without a block is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_block_notify(
+            resp, 3 * sizeof(uint32_t), &dresp));
+}
+
+/**
+ * Test that a block notification is successfully decoded.
+ */
+TEST(dataservice_decode_test, response_block_notify_decoded)
+{
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0x6b, 0x0f, 0x3a, 0x9e, 0x21, 0x44, 0x4c, 0x7d,
+        0x88, 0x13, 0x5e, 0xa2, 0xc0, 0x7b, 0x19, 0xd4
+    };
+    const uint64_t EXPECTED_HEIGHT = 0x0102030405060708UL;
+    uint8_t resp[3 * sizeof(uint32_t) + 16 + sizeof(uint64_t)];
+    uint32_t net_method = htonl(DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT);
+    uint32_t net_offset = htonl(1023);
+    uint32_t net_status = htonl(AGENTD_STATUS_SUCCESS);
+    uint64_t net_height = htonll(EXPECTED_HEIGHT);
+    dataservice_response_block_notify_t dresp;
+
+    memcpy(resp, &net_method, 4);
+    memcpy(resp + 4, &net_offset, 4);
+    memcpy(resp + 8, &net_status, 4);
+    memcpy(resp + 12, EXPECTED_BLOCK_ID, 16);
+    memcpy(resp + 28, &net_height, 8);
+
+    /* a valid notification is successfully decoded. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_decode_response_block_notify(
+            resp, sizeof(resp), &dresp));
+
+    /* the method code is correct. */
+    ASSERT_EQ(DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT,
+        (int)dresp.hdr.method_code);
+    /* the offset is correct. */
+    ASSERT_EQ(1023U, dresp.hdr.offset);
+    /* the status is correct. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)dresp.hdr.status);
+    /* the block id should match. */
+    ASSERT_EQ(0, memcmp(EXPECTED_BLOCK_ID, dresp.block_id, 16));
+    /* the height should match. */
+    ASSERT_EQ(EXPECTED_HEIGHT, dresp.height);
+
+    dispose((disposable_t*)&dresp);
+}
+
+/**
+ * Test that we check for sizes when decoding an artifact notification.
+ */
+TEST(dataservice_decode_test, response_artifact_notify_bad_sizes)
+{
+    uint32_t resp[14] = {
+        htonl(DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE),
+        htonl(1023),
+        htonl(AGENTD_STATUS_SUCCESS)
+    };
+    dataservice_response_artifact_notify_t dresp;
+
+    /* a truncated header is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_artifact_notify(
+            resp, 2 * sizeof(uint32_t), &dresp));
+
+    /* a notification without an artifact record is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_artifact_notify(
+            resp, 3 * sizeof(uint32_t), &dresp));
+
+    /* a notification with trailing data is invalid. */
+    ASSERT_EQ(AGENTD_ERROR_DATASERVICE_RESPONSE_PACKET_INVALID_SIZE,
+        dataservice_decode_response_artifact_notify(
+            resp, sizeof(resp), &dresp));
+}
+
+/**
+ * Test that an artifact notification is successfully decoded.
+ */
+TEST(dataservice_decode_test, response_artifact_notify_decoded)
+{
+    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
+        0x1f, 0x92, 0x6c, 0x04, 0xb7, 0x3a, 0x4d, 0xe1,
+        0x95, 0x28, 0x0c, 0x7f, 0x63, 0xda, 0x41, 0xb8
+    };
+    const uint8_t EXPECTED_TXN_LATEST[16] = {
+        0xa4, 0x5d, 0x18, 0xe3, 0x6e, 0x02, 0x47, 0x9b,
+        0xb1, 0x7c, 0x39, 0x86, 0xfd, 0x20, 0x5a, 0x0e
+    };
+    const uint64_t EXPECTED_HEIGHT = 0x0102030405060708UL;
+    const uint32_t EXPECTED_STATE = 0x11223344;
+    uint8_t resp[3 * sizeof(uint32_t) + 32 + sizeof(uint64_t)
+                 + sizeof(uint32_t)];
+    uint32_t net_method = htonl(DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE);
+    uint32_t net_offset = htonl(1023);
+    uint32_t net_status = htonl(AGENTD_STATUS_SUCCESS);
+    uint64_t net_height = htonll(EXPECTED_HEIGHT);
+    uint32_t net_state = htonl(EXPECTED_STATE);
+    dataservice_response_artifact_notify_t dresp;
+
+    memcpy(resp, &net_method, 4);
+    memcpy(resp + 4, &net_offset, 4);
+    memcpy(resp + 8, &net_status, 4);
+    memcpy(resp + 12, EXPECTED_ARTIFACT_ID, 16);
+    memcpy(resp + 28, EXPECTED_TXN_LATEST, 16);
+    memcpy(resp + 44, &net_height, 8);
+    memcpy(resp + 52, &net_state, 4);
+
+    /* a valid notification is successfully decoded. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        dataservice_decode_response_artifact_notify(
+            resp, sizeof(resp), &dresp));
+
+    /* the method code is correct. */
+    ASSERT_EQ(DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE,
+        (int)dresp.hdr.method_code);
+    /* the offset is correct. */
+    ASSERT_EQ(1023U, dresp.hdr.offset);
+    /* the status is correct. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)dresp.hdr.status);
+    /* the artifact id should match. */
+    ASSERT_EQ(0, memcmp(EXPECTED_ARTIFACT_ID, dresp.artifact_id, 16));
+    /* the latest transaction id should match. */
+    ASSERT_EQ(0, memcmp(EXPECTED_TXN_LATEST, dresp.txn_latest, 16));
+    /* the height should match. */
+    ASSERT_EQ(EXPECTED_HEIGHT, dresp.height_latest);
+    /* the state should match. */
+    ASSERT_EQ(EXPECTED_STATE, dresp.state_latest);
+
+    dispose((disposable_t*)&dresp);
+}
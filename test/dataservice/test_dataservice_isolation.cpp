@@ -7,6 +7,7 @@
  */
 
 #include <agentd/dataservice/api.h>
+#include <agentd/dataservice/async_api.h>
 #include <agentd/dataservice/private/dataservice.h>
 #include <agentd/status_codes.h>
 #include <iostream>
@@ -3163,6 +3164,285 @@ TEST_F(dataservice_isolation_test, read_block_no_cert)
     free(foo_block_cert);
 }
 
+/**
+ * Test that a block certificate can be read a slice at a time.
+ */
+TEST_F(dataservice_isolation_test, read_block_cert_slices)
+{
+    uint32_t offset;
+    uint32_t status;
+    uint32_t child_context;
+    int sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int recvresp_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    string DB_PATH;
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    /* Run the send / receive on creating the root context. */
+    nonblockmode(
+        /* onRead. */
+        [&]() {
+            if (recvresp_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                recvresp_status =
+                    dataservice_api_recvresp_root_context_init(
+                        &nonblockdatasock, &offset, &status);
+
+                if (recvresp_status != AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        },
+        /* onWrite. */
+        [&]() {
+            if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                sendreq_status =
+                    dataservice_api_sendreq_root_context_init(
+                        &nonblockdatasock, DB_PATH.c_str());
+            }
+        });
+
+    /* verify that everything ran correctly. */
+    EXPECT_EQ(0, sendreq_status);
+    EXPECT_EQ(0, recvresp_status);
+    EXPECT_EQ(0U, offset);
+    EXPECT_EQ(0U, status);
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+    BITCAP_INIT_FALSE(reducedcaps);
+
+    /* explicitly grant submitting and getting the first transaction, making
+     * a block, reading a block, and reading an artifact. */
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_SUBMIT);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_PQ_TRANSACTION_DROP);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_ARTIFACT_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_WRITE);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_ID_BY_HEIGHT_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+
+    /* create child context. */
+    sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    recvresp_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    nonblockmode(
+        /* onRead. */
+        [&]() {
+            if (recvresp_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                recvresp_status =
+                    dataservice_api_recvresp_child_context_create(
+                        &nonblockdatasock, &offset, &status, &child_context);
+
+                if (recvresp_status != AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        },
+        /* onWrite. */
+        [&]() {
+            if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                sendreq_status =
+                    dataservice_api_sendreq_child_context_create(
+                        &nonblockdatasock, reducedcaps, sizeof(reducedcaps));
+            }
+        });
+
+    /* verify that everything ran correctly. */
+    ASSERT_EQ(0, sendreq_status);
+    ASSERT_EQ(0, recvresp_status);
+    ASSERT_EQ(0U, offset);
+    ASSERT_EQ(0U, status);
+    ASSERT_EQ(DATASERVICE_MAX_CHILD_CONTEXTS - 1U, child_context);
+
+    const uint8_t foo_key[16] = {
+        0x05, 0x09, 0x43, 0x34, 0x0f, 0xb0, 0x4a, 0xa2,
+        0xa1, 0xf2, 0x26, 0x15, 0x6a, 0x56, 0x45, 0x4d
+    };
+    const uint8_t foo_prev[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    const uint8_t foo_artifact[16] = {
+        0xc3, 0x84, 0x33, 0x0b, 0xf5, 0x0d, 0x42, 0xa2,
+        0x9a, 0x52, 0xb5, 0xa4, 0xb3, 0x5b, 0xcf, 0x72
+    };
+    uint8_t* foo_cert = nullptr;
+    size_t foo_cert_length = 0;
+
+    /* create the foo transaction. */
+    ASSERT_EQ(0,
+        create_dummy_transaction(
+            foo_key, foo_prev, foo_artifact, &foo_cert, &foo_cert_length));
+
+    /* submit a transaction. */
+    sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    recvresp_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    nonblockmode(
+        /* onRead. */
+        [&]() {
+            if (recvresp_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                recvresp_status =
+                    dataservice_api_recvresp_transaction_submit(
+                        &nonblockdatasock, &offset, &status);
+
+                if (recvresp_status != AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        },
+        /* onWrite. */
+        [&]() {
+            if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                sendreq_status =
+                    dataservice_api_sendreq_transaction_submit(
+                        &nonblockdatasock, child_context, foo_key, foo_artifact,
+                        foo_cert, foo_cert_length);
+            }
+        });
+
+    /* verify that everything ran correctly. */
+    ASSERT_EQ(0, sendreq_status);
+    ASSERT_EQ(0, recvresp_status);
+    ASSERT_EQ(DATASERVICE_MAX_CHILD_CONTEXTS - 1U, offset);
+    ASSERT_EQ(0U, status);
+
+    uint8_t* foo_block_cert = nullptr;
+    size_t foo_block_cert_length = 0;
+    const uint8_t foo_block_id[16] = {
+        0x5f, 0x5f, 0x5b, 0xea, 0xdb, 0xcd, 0x4c, 0xff,
+        0xb3, 0x40, 0x99, 0x2e, 0x07, 0xf9, 0xc1, 0xef
+    };
+
+    /* create the block for below. */
+    ASSERT_EQ(0,
+        create_dummy_block_for_isolation(
+            &builder_opts,
+            foo_block_id, vccert_certificate_type_uuid_root_block, 1,
+            &foo_block_cert, &foo_block_cert_length,
+            foo_cert, foo_cert_length,
+            nullptr));
+
+    /* make a block. */
+    sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    recvresp_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    nonblockmode(
+        /* onRead. */
+        [&]() {
+            if (recvresp_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                recvresp_status =
+                    dataservice_api_recvresp_block_make(
+                        &nonblockdatasock, &offset, &status);
+
+                if (recvresp_status != AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        },
+        /* onWrite. */
+        [&]() {
+            if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                sendreq_status =
+                    dataservice_api_sendreq_block_make(
+                        &nonblockdatasock, child_context, foo_block_id,
+                        foo_block_cert, foo_block_cert_length);
+            }
+        });
+    /* verify that everything ran correctly. */
+    ASSERT_EQ(0U, status);
+    EXPECT_EQ(0, sendreq_status);
+    EXPECT_EQ(0, recvresp_status);
+    ASSERT_EQ(DATASERVICE_MAX_CHILD_CONTEXTS - 1U, offset);
+
+    /* read the block certificate a few bytes at a time. */
+    const uint32_t SLICE_SIZE = 7U;
+    vector<uint8_t> gathered;
+    while (gathered.size() < foo_block_cert_length)
+    {
+        dataservice_response_block_cert_read_t dresp;
+        void* resp = nullptr;
+        uint32_t resp_size = 0U;
+        int decode_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+
+        sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+        nonblockmode(
+            /* onRead. */
+            [&]() {
+                if (decode_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    if (AGENTD_STATUS_SUCCESS ==
+                        ipc_read_data_noblock(
+                            &nonblockdatasock, &resp, &resp_size))
+                    {
+                        decode_status =
+                            dataservice_decode_response_block_cert_read(
+                                resp, resp_size, &dresp);
+                        ipc_exit_loop(&loop);
+                    }
+                }
+            },
+            /* onWrite. */
+            [&]() {
+                if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    sendreq_status =
+                        dataservice_api_sendreq_block_cert_read(
+                            &nonblockdatasock, child_context, foo_block_id,
+                            gathered.size(), SLICE_SIZE);
+                }
+            });
+
+        /* verify that everything ran correctly. */
+        ASSERT_EQ(0, sendreq_status);
+        ASSERT_EQ(0, decode_status);
+        ASSERT_EQ(DATASERVICE_MAX_CHILD_CONTEXTS - 1U, dresp.hdr.offset);
+        ASSERT_EQ(0U, dresp.hdr.status);
+        ASSERT_EQ(0, memcmp(foo_block_id, dresp.node.key, 16));
+        ASSERT_EQ(
+            foo_block_cert_length,
+            (size_t)ntohll(dresp.node.net_block_cert_size));
+        ASSERT_GT(dresp.data_size, 0U);
+        ASSERT_LE(dresp.data_size, SLICE_SIZE);
+
+        /* gather this slice. */
+        const uint8_t* slice = (const uint8_t*)dresp.data;
+        gathered.insert(gathered.end(), slice, slice + dresp.data_size);
+
+        dispose((disposable_t*)&dresp);
+        free(resp);
+    }
+
+    /* the slices make up the certificate. */
+    ASSERT_EQ(foo_block_cert_length, gathered.size());
+    EXPECT_EQ(0, memcmp(foo_block_cert, gathered.data(), gathered.size()));
+
+    /* clean up. */
+    free(foo_cert);
+    free(foo_block_cert);
+}
+
 /**
  * Test that we can create a context, close it, create it again, and get the
  * same context back.
@@ -3379,3 +3659,114 @@ TEST_F(dataservice_isolation_test, no_context_leak)
     EXPECT_EQ(0, recvresp_status);
     ASSERT_EQ(0U, status);
 }
+
+/**
+ * Test that a data service bootstrapped over its socket serves requests over a
+ * shared-memory ring.
+ */
+TEST_F(dataservice_ring_isolation_test, latest_block_id_get_over_ring)
+{
+    uint32_t offset;
+    uint32_t status;
+    uint32_t child_context;
+    int sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int recvresp_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    string DB_PATH;
+
+    ASSERT_EQ(0, dataservice_proc_status);
+    ASSERT_TRUE(ipc_ring_descriptors_valid(&ring));
+
+    /* create the directory for this test. */
+    ASSERT_EQ(0, createDirectoryName(__COUNTER__, DB_PATH));
+
+    /* the root context is created over the socket, as the supervisor does. */
+    ASSERT_EQ(0,
+        dataservice_api_sendreq_root_context_init_block(
+            datasock, DB_PATH.c_str()));
+    ASSERT_EQ(0,
+        dataservice_api_recvresp_root_context_init_block(
+            datasock, &offset, &status));
+    ASSERT_EQ(0U, offset);
+    ASSERT_EQ(0U, status);
+
+    /* create a reduced capabilities set for the child context. */
+    BITCAP(reducedcaps, DATASERVICE_API_CAP_BITS_MAX);
+    BITCAP_INIT_FALSE(reducedcaps);
+
+    /* explicitly grant reading the latest block id. */
+    BITCAP_SET_TRUE(reducedcaps,
+        DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
+
+    /* create a child context over the ring. */
+    nonblockmode(
+        /* onRead. */
+        [&]() {
+            if (recvresp_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                recvresp_status =
+                    dataservice_api_recvresp_child_context_create(
+                        &nonblockdatasock, &offset, &status, &child_context);
+
+                if (recvresp_status != AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        },
+        /* onWrite. */
+        [&]() {
+            if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                sendreq_status =
+                    dataservice_api_sendreq_child_context_create(
+                        &nonblockdatasock, reducedcaps, sizeof(reducedcaps));
+            }
+        });
+
+    /* verify that everything ran correctly. */
+    ASSERT_EQ(0, sendreq_status);
+    ASSERT_EQ(0, recvresp_status);
+    ASSERT_EQ(0U, offset);
+    ASSERT_EQ(0U, status);
+    ASSERT_EQ(DATASERVICE_MAX_CHILD_CONTEXTS - 1U, child_context);
+
+    /* set the block id to something unexpected. */
+    uint8_t latest_block_id[16];
+    memset(latest_block_id, 0xFE, sizeof(latest_block_id));
+
+    /* query the latest block id over the ring. */
+    sendreq_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    recvresp_status = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    nonblockmode(
+        /* onRead. */
+        [&]() {
+            if (recvresp_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                recvresp_status =
+                    dataservice_api_recvresp_latest_block_id_get(
+                        &nonblockdatasock, &offset, &status, latest_block_id);
+
+                if (recvresp_status != AGENTD_ERROR_IPC_WOULD_BLOCK)
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        },
+        /* onWrite. */
+        [&]() {
+            if (sendreq_status == AGENTD_ERROR_IPC_WOULD_BLOCK)
+            {
+                sendreq_status =
+                    dataservice_api_sendreq_latest_block_id_get(
+                        &nonblockdatasock, child_context);
+            }
+        });
+
+    /* verify that everything ran correctly. */
+    EXPECT_EQ(0, sendreq_status);
+    EXPECT_EQ(0, recvresp_status);
+    ASSERT_EQ(DATASERVICE_MAX_CHILD_CONTEXTS - 1U, offset);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    ASSERT_EQ(
+        0, memcmp(latest_block_id, vccert_certificate_type_uuid_root_block, 16));
+}
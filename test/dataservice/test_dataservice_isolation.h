@@ -54,6 +54,10 @@ protected:
     /* Google Test overrides. */
     void SetUp() override;
     void TearDown() override;
+
+    /* override to run the nonblocking requests over a shared-memory ring. */
+    virtual bool use_ring() { return false; }
+
     int create_dummy_transaction(
         const uint8_t* txn_id, const uint8_t* prev_txn_id,
         const uint8_t* artifact_id, uint8_t** cert, size_t* cert_length);
@@ -78,6 +82,7 @@ protected:
     bootstrap_config_t bconf;
     int datasock;
     int logsock;
+    ipc_ring_descriptors_t ring;
     pid_t datapid;
     int dataservice_proc_status;
     char* path;
@@ -100,6 +105,16 @@ protected:
     static const uint8_t zero_uuid[16];
 };
 
+/**
+ * The dataservice ring isolation test runs the same nonblocking requests as
+ * the dataservice isolation test, but over a shared-memory ring.  The blocking
+ * requests still use the data service socket.
+ */
+class dataservice_ring_isolation_test : public dataservice_isolation_test {
+protected:
+    bool use_ring() override { return true; }
+};
+
 extern "C" {
 int create_dummy_block_for_isolation(
     vccert_builder_options_t* builder_opts,
@@ -129,11 +129,21 @@ void dataservice_isolation_test::SetUp()
 
     logsock = dup(STDERR_FILENO);
 
+    /* create the ring, if this test uses one. */
+    ring.memfd = ring.lhs = ring.rhs = -1;
+    if (use_ring())
+    {
+        ipc_ringpair(
+            16 * IPC_RING_CAPACITY_MINIMUM, &ring.memfd, &ring.lhs,
+            &ring.rhs);
+    }
+
     /* spawn the dataservice process. */
     dataservice_proc_status =
         dataservice_proc(
-            &bconf, user_context.config, &logsock, &datasock, &datapid,
-            false);
+            &bconf, user_context.config, &logsock, &datasock,
+            ipc_ring_descriptors_valid(&ring) ? &ring : NULL, -1, NULL, 0U,
+            &datapid, false);
 
     /* by default, we run in blocking mode. */
     nonblockdatasock_configured = false;
@@ -176,6 +186,7 @@ void dataservice_isolation_test::TearDown()
     yylex_destroy(scanner);
     if (logsock >= 0)
         close(logsock);
+    ipc_ring_descriptors_close(&ring);
     dispose((disposable_t*)&bconf);
     dispose((disposable_t*)&user_context);
     free(path);
@@ -191,7 +202,19 @@ void dataservice_isolation_test::nonblockmode(
     /* handle a non-blocking event loop. */
     if (!nonblockdatasock_configured)
     {
-        ipc_make_noblock(datasock, &nonblockdatasock, this);
+        if (ipc_ring_descriptors_valid(&ring))
+        {
+            /* the ring context owns our doorbell. */
+            ipc_make_ring_noblock(
+                ring.memfd, IPC_RING_SIDE_LHS, ring.lhs, ring.rhs,
+                &nonblockdatasock, this);
+            ring.lhs = -1;
+        }
+        else
+        {
+            ipc_make_noblock(datasock, &nonblockdatasock, this);
+        }
+
         nonblockdatasock_configured = true;
         ipc_event_loop_init(&loop);
     }
@@ -0,0 +1,83 @@
+/**
+ * \file test_dataservice_watermarks.cpp
+ *
+ * Test the write buffer watermark settings.
+ *
+ * \copyright 2020 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+
+#include "../../src/dataservice/dataservice_internal.h"
+
+using namespace std;
+
+/**
+ * \brief The default watermarks are used when none are set.
+ */
+TEST(dataservice_watermarks_test, default_watermarks)
+{
+    size_t low = 0U, high = 0U;
+
+    unsetenv("AGENTD_DATASERVICE_LOW_WATERMARK");
+    unsetenv("AGENTD_DATASERVICE_HIGH_WATERMARK");
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, dataservice_watermarks_get(&low, &high));
+    EXPECT_EQ((size_t)DATASERVICE_WRITEBUF_LOW_WATERMARK, low);
+    EXPECT_EQ((size_t)DATASERVICE_WRITEBUF_HIGH_WATERMARK, high);
+}
+
+/**
+ * \brief Watermarks within range are used.
+ */
+TEST(dataservice_watermarks_test, configured_watermarks)
+{
+    size_t low = 0U, high = 0U;
+
+    ASSERT_EQ(0, setenv("AGENTD_DATASERVICE_LOW_WATERMARK", "65536", 1));
+    ASSERT_EQ(0, setenv("AGENTD_DATASERVICE_HIGH_WATERMARK", "262144", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, dataservice_watermarks_get(&low, &high));
+    EXPECT_EQ(65536U, low);
+    EXPECT_EQ(262144U, high);
+
+    unsetenv("AGENTD_DATASERVICE_LOW_WATERMARK");
+    unsetenv("AGENTD_DATASERVICE_HIGH_WATERMARK");
+}
+
+/**
+ * \brief Malformed or out of range watermarks are rejected.
+ */
+TEST(dataservice_watermarks_test, invalid_watermarks)
+{
+    const char* BAD[] = { "", "4095", "1073741825", "-4096", " 4096", "4k" };
+    size_t low = 0U, high = 0U;
+
+    unsetenv("AGENTD_DATASERVICE_LOW_WATERMARK");
+
+    for (const char* bad : BAD)
+    {
+        ASSERT_EQ(0, setenv("AGENTD_DATASERVICE_HIGH_WATERMARK", bad, 1));
+        EXPECT_EQ(AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID,
+            dataservice_watermarks_get(&low, &high)) << bad;
+    }
+
+    unsetenv("AGENTD_DATASERVICE_HIGH_WATERMARK");
+}
+
+/**
+ * \brief A low watermark above the high watermark is rejected.
+ */
+TEST(dataservice_watermarks_test, low_above_high)
+{
+    size_t low = 0U, high = 0U;
+
+    ASSERT_EQ(0, setenv("AGENTD_DATASERVICE_LOW_WATERMARK", "8192", 1));
+    ASSERT_EQ(0, setenv("AGENTD_DATASERVICE_HIGH_WATERMARK", "4096", 1));
+    EXPECT_EQ(AGENTD_ERROR_DATASERVICE_WATERMARK_INVALID,
+        dataservice_watermarks_get(&low, &high));
+
+    unsetenv("AGENTD_DATASERVICE_LOW_WATERMARK");
+    unsetenv("AGENTD_DATASERVICE_HIGH_WATERMARK");
+}
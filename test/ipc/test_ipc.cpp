@@ -12,9 +12,13 @@
 #include <arpa/inet.h>
 #include <fcntl.h>
 #include <gtest/gtest.h>
+#include <signal.h>
 #include <stdint.h>
+#include <string>
 #include <sys/socket.h>
+#include <thread>
 #include <time.h>
+#include <vector>
 #include <vpr/disposable.h>
 
 #include "test_ipc.h"
@@ -492,6 +496,48 @@ TEST_F(ipc_test, ipc_read_data_block_success)
     close(rhs);
 }
 
+/**
+ * \brief A data packet larger than the socket buffer can be read from a
+ * blocking socket, even though it arrives over several reads.
+ */
+TEST_F(ipc_test, ipc_read_data_block_large)
+{
+    int lhs, rhs;
+    std::vector<uint8_t> data(4 * 1024 * 1024);
+    void* val = nullptr;
+    uint32_t size = 0;
+    int write_resp = -1;
+
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (uint8_t)i;
+    }
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* write the packet from another thread, since it doesn't fit in the socket
+     * buffer. */
+    std::thread writer([&]() {
+        write_resp = ipc_write_data_block(lhs, data.data(), data.size());
+    });
+
+    /* read a data packet from the rhs socket. */
+    int read_resp = ipc_read_data_block(rhs, &val, &size);
+    writer.join();
+    ASSERT_EQ(0, read_resp);
+    ASSERT_EQ(0, write_resp);
+
+    /* the data is a copy of what was written. */
+    ASSERT_EQ(data.size(), size);
+    EXPECT_EQ(0, memcmp(data.data(), val, size));
+
+    /* clean up. */
+    free(val);
+    close(lhs);
+    close(rhs);
+}
+
 /**
  * \brief It is possible to read a uint64_t value from a blocking socket.
  */
@@ -1678,6 +1724,343 @@ TEST_F(ipc_test, ipc_read_authed_noblock_success)
     dispose((disposable_t*)&key);
 }
 
+/**
+ * \brief A non-blocking read picks up the packets queued behind the one it
+ * reads, so they can still be read after the peer has hung up.
+ */
+TEST_F(ipc_test, ipc_read_data_noblock_read_ahead)
+{
+    int lhs, rhs;
+    ipc_socket_context_t sock;
+    ipc_event_loop_context_t ra_loop;
+    const char* TEST_STRINGS[] = { "one", "two", "three" };
+    void* val = nullptr;
+    uint32_t size = 0;
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* queue three packets and hang up. */
+    for (const char* str : TEST_STRINGS)
+    {
+        ASSERT_EQ(0, ipc_write_data_block(lhs, str, strlen(str)));
+    }
+
+    close(lhs);
+
+    /* set up the reading side. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_make_noblock(rhs, &sock, nullptr));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&ra_loop));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_add(&ra_loop, &sock));
+
+    /* the first read buffers every packet. */
+    for (const char* str : TEST_STRINGS)
+    {
+        ASSERT_EQ(
+            AGENTD_STATUS_SUCCESS, ipc_read_data_noblock(&sock, &val, &size));
+        ASSERT_EQ(strlen(str), size);
+        EXPECT_EQ(0, memcmp(str, val, size));
+        free(val);
+        val = nullptr;
+    }
+
+    /* only then is the hang up seen. */
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_EVBUFFER_EOF,
+        ipc_read_data_noblock(&sock, &val, &size));
+
+    /* clean up. */
+    dispose((disposable_t*)&sock);
+    dispose((disposable_t*)&ra_loop);
+    close(rhs);
+}
+
+/**
+ * \brief A read chunk smaller than a packet still reads the whole packet.
+ */
+TEST_F(ipc_test, ipc_set_read_chunk_noblock_small)
+{
+    int lhs, rhs;
+    ipc_socket_context_t sock;
+    ipc_event_loop_context_t ra_loop;
+    const char TEST_STRING[] = "This is a test.";
+    void* val = nullptr;
+    uint32_t size = 0;
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+    ASSERT_EQ(0, ipc_write_data_block(lhs, TEST_STRING, strlen(TEST_STRING)));
+
+    /* set up the reading side with a one byte read chunk. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_make_noblock(rhs, &sock, nullptr));
+    ipc_set_read_chunk_noblock(&sock, 1);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&ra_loop));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_add(&ra_loop, &sock));
+
+    /* the header and the payload each take one read. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS, ipc_read_data_noblock(&sock, &val, &size));
+    ASSERT_EQ(strlen(TEST_STRING), size);
+    EXPECT_EQ(0, memcmp(TEST_STRING, val, size));
+    free(val);
+
+    /* nothing else is waiting. */
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_WOULD_BLOCK,
+        ipc_read_data_noblock(&sock, &val, &size));
+
+    /* clean up. */
+    dispose((disposable_t*)&sock);
+    dispose((disposable_t*)&ra_loop);
+    close(lhs);
+    close(rhs);
+}
+
+/**
+ * \brief A batch of sockets can be passed in a single message.
+ */
+TEST_F(ipc_test, ipc_sendsockets_noblock_batch)
+{
+    int lhs, rhs;
+    int pipes[3][2];
+    int sendsocks[3];
+    int recvsocks[IPC_SOCKET_BATCH_MAX];
+    size_t count = 0;
+    ipc_socket_context_t sender, receiver;
+
+    /* create a datagram socket pair, as used between the listen service and
+     * the protocol service. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_DGRAM, 0, &lhs, &rhs));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_make_noblock(lhs, &sender, nullptr));
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS, ipc_make_noblock(rhs, &receiver, nullptr));
+
+    /* nothing has been sent yet. */
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_WOULD_BLOCK,
+        ipc_receivesockets_noblock(&receiver, recvsocks, &count));
+
+    /* send the write ends of three pipes at once. */
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(0, pipe(pipes[i]));
+        sendsocks[i] = pipes[i][1];
+    }
+
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_sendsockets_noblock(&sender, sendsocks, 3, &count));
+    EXPECT_EQ(3U, count);
+
+    /* they all arrive in one message, in order. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_receivesockets_noblock(&receiver, recvsocks, &count));
+    ASSERT_EQ(3U, count);
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_WOULD_BLOCK,
+        ipc_receivesockets_noblock(&receiver, recvsocks, &count));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        char ch = 'a' + i;
+        char rch = 0;
+
+        close(pipes[i][1]);
+        ASSERT_EQ(1, write(recvsocks[i], &ch, 1));
+        ASSERT_EQ(1, read(pipes[i][0], &rch, 1));
+        EXPECT_EQ(ch, rch);
+
+        close(recvsocks[i]);
+        close(pipes[i][0]);
+    }
+
+    /* clean up. */
+    dispose((disposable_t*)&sender);
+    dispose((disposable_t*)&receiver);
+}
+
+/**
+ * \brief It is possible to borrow consecutive data packets from a non-blocking
+ * socket, releasing each before reading the next.
+ */
+TEST_F(ipc_test, ipc_borrow_data_noblock_success)
+{
+    int lhs, rhs;
+    const char TEST_STRING1[] = "This is a test.";
+    const char TEST_STRING2[] = "This is another test.";
+    string str1, str2;
+    void* val = nullptr;
+    uint32_t size = 0;
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* write two data packets to the lhs socket. */
+    ASSERT_EQ(0, ipc_write_data_block(lhs, TEST_STRING1, strlen(TEST_STRING1)));
+    ASSERT_EQ(0, ipc_write_data_block(lhs, TEST_STRING2, strlen(TEST_STRING2)));
+
+    int read_resp1 = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int read_resp2 = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int release_resp1 = -1;
+    int release_resp2 = -1;
+
+    nonblockmode(
+        rhs,
+        /* onRead */
+        [&]() {
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK == read_resp1)
+            {
+                read_resp1 =
+                    ipc_borrow_data_noblock(&nonblockdatasock, &val, &size);
+                if (AGENTD_STATUS_SUCCESS == read_resp1)
+                {
+                    str1.assign((const char*)val, size);
+                    release_resp1 = ipc_release_data_noblock(&nonblockdatasock);
+                }
+            }
+
+            if (AGENTD_STATUS_SUCCESS == read_resp1
+             && AGENTD_ERROR_IPC_WOULD_BLOCK == read_resp2)
+            {
+                read_resp2 =
+                    ipc_borrow_data_noblock(&nonblockdatasock, &val, &size);
+                if (AGENTD_STATUS_SUCCESS == read_resp2)
+                {
+                    str2.assign((const char*)val, size);
+                    release_resp2 = ipc_release_data_noblock(&nonblockdatasock);
+                }
+            }
+
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp1
+             && AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp2)
+            {
+                ipc_exit_loop(&loop);
+            }
+            else if (AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp1
+                  && AGENTD_STATUS_SUCCESS != read_resp1)
+            {
+                ipc_exit_loop(&loop);
+            }
+        },
+        /* onWrite */
+        [&]() {
+        });
+
+    /* both reads and releases should have succeeded. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, read_resp1);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, release_resp1);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, read_resp2);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, release_resp2);
+
+    /* the borrowed payloads match what was written. */
+    EXPECT_EQ(string(TEST_STRING1), str1);
+    EXPECT_EQ(string(TEST_STRING2), str2);
+
+    /* clean up. */
+    close(lhs);
+    close(rhs);
+}
+
+/**
+ * \brief It is possible to borrow consecutive authed packets from a
+ * non-blocking socket, reusing the socket's payload buffer.
+ */
+TEST_F(ipc_test, ipc_borrow_authed_data_noblock_success)
+{
+    int lhs, rhs;
+    const char TEST_STRING1[] = "This is a test.";
+    const char TEST_STRING2[] = "This is another test.";
+    string str1, str2;
+    void* val = nullptr;
+    uint32_t size = 0;
+    uint64_t iv = 12345;
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* create key for stream cipher. */
+    /* TODO - there should be a suite method for this. */
+    vccrypt_buffer_t key;
+    ASSERT_EQ(
+        0,
+        vccrypt_buffer_init(
+            &key, &alloc_opts, suite.stream_cipher_opts.key_size));
+
+    /* set a null key. */
+    memset(key.data, 0, key.size);
+
+    /* write two authed packets to the lhs socket. */
+    ASSERT_EQ(
+        0,
+        ipc_write_authed_data_block(
+            lhs, iv, TEST_STRING1, strlen(TEST_STRING1), &suite, &key));
+    ASSERT_EQ(
+        0,
+        ipc_write_authed_data_block(
+            lhs, iv + 1, TEST_STRING2, strlen(TEST_STRING2), &suite, &key));
+
+    int read_resp1 = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int read_resp2 = AGENTD_ERROR_IPC_WOULD_BLOCK;
+
+    nonblockmode(
+        rhs,
+        /* onRead */
+        [&]() {
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK == read_resp1)
+            {
+                read_resp1 =
+                    ipc_borrow_authed_data_noblock(
+                        &nonblockdatasock, iv, &val, &size, &suite, &key);
+                if (AGENTD_STATUS_SUCCESS == read_resp1)
+                {
+                    str1.assign((const char*)val, size);
+                    ipc_release_data_noblock(&nonblockdatasock);
+                }
+            }
+
+            if (AGENTD_STATUS_SUCCESS == read_resp1
+             && AGENTD_ERROR_IPC_WOULD_BLOCK == read_resp2)
+            {
+                read_resp2 =
+                    ipc_borrow_authed_data_noblock(
+                        &nonblockdatasock, iv + 1, &val, &size, &suite, &key);
+                if (AGENTD_STATUS_SUCCESS == read_resp2)
+                {
+                    str2.assign((const char*)val, size);
+                    ipc_release_data_noblock(&nonblockdatasock);
+                }
+            }
+
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp1
+             && AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp2)
+            {
+                ipc_exit_loop(&loop);
+            }
+            else if (AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp1
+                  && AGENTD_STATUS_SUCCESS != read_resp1)
+            {
+                ipc_exit_loop(&loop);
+            }
+        },
+        /* onWrite */
+        [&]() {
+        });
+
+    /* both reads should have succeeded. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, read_resp1);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, read_resp2);
+
+    /* the decrypted payloads match what was written. */
+    EXPECT_EQ(string(TEST_STRING1), str1);
+    EXPECT_EQ(string(TEST_STRING2), str2);
+
+    /* clean up. */
+    close(lhs);
+    close(rhs);
+    dispose((disposable_t*)&key);
+}
+
 /**
  * \brief It is possible to write a packet via ipc_write_authed_noblock and read
  * it using ipc_read_authed_block.
@@ -1762,57 +2145,823 @@ TEST_F(ipc_test, ipc_write_authed_noblock_success)
     dispose((disposable_t*)&key);
 }
 
-static void test_timer_cb(ipc_timer_context_t*, void* user_context)
-{
-    function<void()>* func = (function<void()>*)user_context;
-
-    (*func)();
-}
-
 /**
- * \brief It is possible to create a timer and have it fire.
+ * \brief A packet gathered from several fragments via
+ * ipc_write_authed_datav_noblock can be read as a single authed packet.
  */
-TEST_F(ipc_test, ipc_timer)
+TEST_F(ipc_test, ipc_write_authed_datav_noblock_success)
 {
     int lhs, rhs;
-    bool callback_called = false;
-    timespec start_time;
-    timespec callback_time;
-    timespec expected_time;
-    ipc_timer_context_t timer;
+    const char TEST_STRING[] = "This is a test.";
+    void* str = nullptr;
+    uint32_t str_size = 0;
+    uint64_t iv = 12345;
 
-    function<void()> callback = [&]() {
-        ASSERT_EQ(0, clock_gettime(CLOCK_REALTIME, &callback_time));
-        callback_called = true;
-    };
+    /* split the test string into three fragments, one of them empty. */
+    struct iovec iov[3];
+    iov[0].iov_base = (void*)TEST_STRING;
+    iov[0].iov_len = 5;
+    iov[1].iov_base = nullptr;
+    iov[1].iov_len = 0;
+    iov[2].iov_base = (void*)(TEST_STRING + 5);
+    iov[2].iov_len = strlen(TEST_STRING) - 5;
 
     /* create a socket pair for testing. */
     ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
 
-    /* set up the loop, using one of the sockets as a hack. */
-    timermode_setup(lhs);
+    /* create key for stream cipher. */
+    /* TODO - there should be a suite method for this. */
+    vccrypt_buffer_t key;
+    ASSERT_EQ(
+        0,
+        vccrypt_buffer_init(
+            &key, &alloc_opts, suite.stream_cipher_opts.key_size));
 
-    /* initialize the timer event. */
-    ASSERT_EQ(0, ipc_timer_init(&timer, 250, &test_timer_cb, &callback));
+    /* set a null key. */
+    memset(key.data, 0, key.size);
 
-    /* add the timer to the loop. */
-    ASSERT_EQ(0, ipc_event_loop_add_timer(&loop, &timer));
+    int write_resp = AGENTD_ERROR_IPC_WOULD_BLOCK;
 
-    /* get the current time. */
-    ASSERT_EQ(0, clock_gettime(CLOCK_REALTIME, &start_time));
+    /* writing to the socket should succeed. */
+    nonblockmode(
+        lhs,
+        /* onRead */
+        [&]() {
+        },
+        /* onWrite */
+        [&]() {
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK == write_resp)
+            {
+                write_resp =
+                    ipc_write_authed_datav_noblock(
+                        &nonblockdatasock, iv, iov, 3, &suite, &key);
+            }
+            else
+            {
+                if (ipc_socket_writebuffer_size(&nonblockdatasock) > 0)
+                {
+                    int bytes_written =
+                        ipc_socket_write_from_buffer(&nonblockdatasock);
 
-    /* run the loop. */
-    timermode();
+                    if (bytes_written == 0 || (bytes_written < 0 && (errno != EAGAIN && errno != EWOULDBLOCK)))
+                    {
+                        ipc_exit_loop(&loop);
+                    }
+                }
+                else
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        });
+    /* the write should have succeeded. */
+    ASSERT_EQ(0, write_resp);
 
-    /* verify that the callback was called. */
-    ASSERT_TRUE(callback_called);
+    /* read an authed packet from the rhs socket. */
+    ASSERT_EQ(
+        0,
+        ipc_read_authed_data_block(rhs, iv, &str, &str_size, &suite, &key));
+    /* the data is valid. */
+    ASSERT_NE(nullptr, str);
 
-    /* we expect the callback to happen at least 250 milliseconds after
-     * start_time. */
-    memcpy(&expected_time, &start_time, sizeof(timespec));
-    expected_time.tv_nsec += 250 * 1000 * 1000;
-    expected_time.tv_sec += expected_time.tv_nsec / (1000 * 1000 * 1000);
-    expected_time.tv_nsec %= 1000 * 1000 * 1000;
+    /* the string size is the length of our string. */
+    ASSERT_EQ(strlen(TEST_STRING), str_size);
+
+    /* the data is a copy of the test string. */
+    EXPECT_EQ(0, memcmp(TEST_STRING, str, str_size));
+
+    /* clean up. */
+    free(str);
+    close(lhs);
+    close(rhs);
+    dispose((disposable_t*)&key);
+}
+
+/**
+ * \brief Authed packets written on the same socket with different secrets can
+ * each be read with the matching secret.
+ */
+TEST_F(ipc_test, ipc_write_authed_noblock_secret_change)
+{
+    int lhs, rhs;
+    const char TEST_STRING1[] = "This is a test.";
+    const char TEST_STRING2[] = "This is another test.";
+    void* str = nullptr;
+    uint32_t str_size = 0;
+    uint64_t iv = 12345;
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* create two keys for stream cipher. */
+    /* TODO - there should be a suite method for this. */
+    vccrypt_buffer_t key1, key2;
+    ASSERT_EQ(
+        0,
+        vccrypt_buffer_init(
+            &key1, &alloc_opts, suite.stream_cipher_opts.key_size));
+    ASSERT_EQ(
+        0,
+        vccrypt_buffer_init(
+            &key2, &alloc_opts, suite.stream_cipher_opts.key_size));
+
+    /* set a null key and a non-null key. */
+    memset(key1.data, 0, key1.size);
+    memset(key2.data, 0x5a, key2.size);
+
+    int write_resp1 = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int write_resp2 = AGENTD_ERROR_IPC_WOULD_BLOCK;
+
+    /* writing to the socket should succeed. */
+    nonblockmode(
+        lhs,
+        /* onRead */
+        [&]() {
+        },
+        /* onWrite */
+        [&]() {
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK == write_resp1)
+            {
+                write_resp1 =
+                    ipc_write_authed_data_noblock(
+                        &nonblockdatasock, iv, TEST_STRING1,
+                        strlen(TEST_STRING1), &suite, &key1);
+                write_resp2 =
+                    ipc_write_authed_data_noblock(
+                        &nonblockdatasock, iv, TEST_STRING2,
+                        strlen(TEST_STRING2), &suite, &key2);
+            }
+            else
+            {
+                if (ipc_socket_writebuffer_size(&nonblockdatasock) > 0)
+                {
+                    int bytes_written =
+                        ipc_socket_write_from_buffer(&nonblockdatasock);
+
+                    if (bytes_written == 0 || (bytes_written < 0 && (errno != EAGAIN && errno != EWOULDBLOCK)))
+                    {
+                        ipc_exit_loop(&loop);
+                    }
+                }
+                else
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        });
+    /* the writes should have succeeded. */
+    ASSERT_EQ(0, write_resp1);
+    ASSERT_EQ(0, write_resp2);
+
+    /* read the first packet with the first key. */
+    ASSERT_EQ(
+        0,
+        ipc_read_authed_data_block(rhs, iv, &str, &str_size, &suite, &key1));
+    ASSERT_NE(nullptr, str);
+    ASSERT_EQ(strlen(TEST_STRING1), str_size);
+    EXPECT_EQ(0, memcmp(TEST_STRING1, str, str_size));
+    free(str);
+    str = nullptr;
+
+    /* read the second packet with the second key. */
+    ASSERT_EQ(
+        0,
+        ipc_read_authed_data_block(rhs, iv, &str, &str_size, &suite, &key2));
+    ASSERT_NE(nullptr, str);
+    ASSERT_EQ(strlen(TEST_STRING2), str_size);
+    EXPECT_EQ(0, memcmp(TEST_STRING2, str, str_size));
+
+    /* clean up. */
+    free(str);
+    close(lhs);
+    close(rhs);
+    dispose((disposable_t*)&key1);
+    dispose((disposable_t*)&key2);
+}
+
+/**
+ * \brief A streamed authenticated message can be written as begin, chunk, and
+ * end frames, and read back a chunk at a time.
+ */
+TEST_F(ipc_test, ipc_authed_stream_noblock_success)
+{
+    int lhs, rhs;
+    const char TEST_CHUNK1[] = "This is ";
+    const char TEST_CHUNK2[] = "a streamed test.";
+    const size_t total = strlen(TEST_CHUNK1) + strlen(TEST_CHUNK2);
+    std::vector<int> frames;
+    std::string payload;
+    ipc_stream_reader_t reader;
+    int write_resp = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int read_resp = AGENTD_STATUS_SUCCESS;
+    uint64_t iv = 0;
+
+    memset(&reader, 0, sizeof(reader));
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* create key for stream cipher. */
+    vccrypt_buffer_t key;
+    ASSERT_EQ(
+        0,
+        vccrypt_buffer_init(
+            &key, &alloc_opts, suite.stream_cipher_opts.key_size));
+    memset(key.data, 0, key.size);
+
+    /* write the stream, one frame per IV. */
+    nonblockmode(
+        lhs,
+        /* onRead */
+        [&]() {
+        },
+        /* onWrite */
+        [&]() {
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK == write_resp)
+            {
+                write_resp =
+                    ipc_write_authed_stream_begin_noblock(
+                        &nonblockdatasock, 0, total, &suite, &key);
+                if (AGENTD_STATUS_SUCCESS == write_resp)
+                    write_resp =
+                        ipc_write_authed_stream_chunk_noblock(
+                            &nonblockdatasock, 1, TEST_CHUNK1,
+                            strlen(TEST_CHUNK1), &suite, &key);
+                if (AGENTD_STATUS_SUCCESS == write_resp)
+                    write_resp =
+                        ipc_write_authed_stream_chunk_noblock(
+                            &nonblockdatasock, 2, TEST_CHUNK2,
+                            strlen(TEST_CHUNK2), &suite, &key);
+                if (AGENTD_STATUS_SUCCESS == write_resp)
+                    write_resp =
+                        ipc_write_authed_stream_end_noblock(
+                            &nonblockdatasock, 3, &suite, &key);
+            }
+            else
+            {
+                if (ipc_socket_writebuffer_size(&nonblockdatasock) > 0)
+                {
+                    int bytes_written =
+                        ipc_socket_write_from_buffer(&nonblockdatasock);
+
+                    if (bytes_written == 0 || (bytes_written < 0 && (errno != EAGAIN && errno != EWOULDBLOCK)))
+                    {
+                        ipc_exit_loop(&loop);
+                    }
+                }
+                else
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        });
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, write_resp);
+
+    /* read frames until the stream ends. */
+    nonblockmode(
+        rhs,
+        /* onRead */
+        [&]() {
+            for (;;)
+            {
+                int frame;
+                void* val;
+                uint32_t size;
+
+                read_resp =
+                    ipc_borrow_authed_stream_noblock(
+                        &nonblockdatasock, iv, &reader, &frame, &val, &size,
+                        &suite, &key);
+                if (AGENTD_ERROR_IPC_WOULD_BLOCK == read_resp)
+                {
+                    read_resp = AGENTD_STATUS_SUCCESS;
+                    return;
+                }
+                else if (AGENTD_STATUS_SUCCESS != read_resp)
+                {
+                    ipc_exit_loop(&loop);
+                    return;
+                }
+
+                ++iv;
+                frames.push_back(frame);
+                payload.append((const char*)val, size);
+                ipc_release_data_noblock(&nonblockdatasock);
+
+                if (IPC_STREAM_FRAME_END == frame)
+                {
+                    ipc_exit_loop(&loop);
+                    return;
+                }
+            }
+        },
+        /* onWrite */
+        [&]() {
+        });
+
+    /* every frame arrived in order. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, read_resp);
+    std::vector<int> expected_frames = {
+        IPC_STREAM_FRAME_BEGIN, IPC_STREAM_FRAME_CHUNK, IPC_STREAM_FRAME_CHUNK,
+        IPC_STREAM_FRAME_END };
+    EXPECT_EQ(expected_frames, frames);
+    EXPECT_EQ(std::string(TEST_CHUNK1) + TEST_CHUNK2, payload);
+    EXPECT_EQ(total, reader.total_size);
+    EXPECT_FALSE(reader.open);
+
+    /* clean up. */
+    close(lhs);
+    close(rhs);
+    dispose((disposable_t*)&key);
+}
+
+/**
+ * \brief A stream chunk that doesn't follow a begin frame is rejected.
+ */
+TEST_F(ipc_test, ipc_authed_stream_noblock_chunk_without_begin)
+{
+    int lhs, rhs;
+    const char TEST_CHUNK[] = "This is a test.";
+    ipc_stream_reader_t reader;
+    int write_resp = AGENTD_ERROR_IPC_WOULD_BLOCK;
+    int read_resp = AGENTD_ERROR_IPC_WOULD_BLOCK;
+
+    memset(&reader, 0, sizeof(reader));
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* create key for stream cipher. */
+    vccrypt_buffer_t key;
+    ASSERT_EQ(
+        0,
+        vccrypt_buffer_init(
+            &key, &alloc_opts, suite.stream_cipher_opts.key_size));
+    memset(key.data, 0, key.size);
+
+    /* write a chunk on its own. */
+    nonblockmode(
+        lhs,
+        /* onRead */
+        [&]() {
+        },
+        /* onWrite */
+        [&]() {
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK == write_resp)
+            {
+                write_resp =
+                    ipc_write_authed_stream_chunk_noblock(
+                        &nonblockdatasock, 0, TEST_CHUNK, strlen(TEST_CHUNK),
+                        &suite, &key);
+            }
+            else
+            {
+                if (ipc_socket_writebuffer_size(&nonblockdatasock) > 0)
+                {
+                    int bytes_written =
+                        ipc_socket_write_from_buffer(&nonblockdatasock);
+
+                    if (bytes_written == 0 || (bytes_written < 0 && (errno != EAGAIN && errno != EWOULDBLOCK)))
+                    {
+                        ipc_exit_loop(&loop);
+                    }
+                }
+                else
+                {
+                    ipc_exit_loop(&loop);
+                }
+            }
+        });
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, write_resp);
+
+    /* reading it is a protocol violation. */
+    nonblockmode(
+        rhs,
+        /* onRead */
+        [&]() {
+            int frame;
+            void* val;
+            uint32_t size;
+
+            read_resp =
+                ipc_borrow_authed_stream_noblock(
+                    &nonblockdatasock, 0, &reader, &frame, &val, &size,
+                    &suite, &key);
+            if (AGENTD_ERROR_IPC_WOULD_BLOCK != read_resp)
+            {
+                ipc_exit_loop(&loop);
+            }
+        },
+        /* onWrite */
+        [&]() {
+        });
+
+    EXPECT_EQ(AGENTD_ERROR_IPC_STREAM_PROTOCOL_VIOLATION, read_resp);
+
+    /* clean up. */
+    close(lhs);
+    close(rhs);
+    dispose((disposable_t*)&key);
+}
+
+/**
+ * \brief Writes to a corked socket are buffered until the end of the event
+ * loop iteration, and then flushed.
+ */
+TEST_F(ipc_test, ipc_set_cork_noblock_flush)
+{
+    int lhs, rhs;
+    const char TEST_STRING1[] = "This is a test.";
+    const char TEST_STRING2[] = "This is another test.";
+    void* str = nullptr;
+    uint32_t str_size = 0;
+    int write_resp1 = -1;
+    int write_resp2 = -1;
+    size_t corked_size = 0;
+    bool written = false;
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* write two packets to a corked socket. */
+    nonblockmode(
+        lhs,
+        /* onRead */
+        [&]() {
+        },
+        /* onWrite */
+        [&]() {
+            if (!written)
+            {
+                ipc_set_cork_noblock(&nonblockdatasock, true);
+                write_resp1 =
+                    ipc_write_data_noblock(
+                        &nonblockdatasock, TEST_STRING1, strlen(TEST_STRING1));
+                write_resp2 =
+                    ipc_write_data_noblock(
+                        &nonblockdatasock, TEST_STRING2, strlen(TEST_STRING2));
+                corked_size = ipc_socket_writebuffer_size(&nonblockdatasock);
+                written = true;
+                ipc_exit_loop(&loop);
+            }
+        });
+
+    /* the writes should have succeeded. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, write_resp1);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, write_resp2);
+
+    /* both packets were held in the write buffer... */
+    EXPECT_EQ(
+        2 * (sizeof(uint8_t) + sizeof(uint32_t))
+            + strlen(TEST_STRING1) + strlen(TEST_STRING2),
+        corked_size);
+
+    /* ...and flushed by the event loop. */
+    EXPECT_EQ(0U, ipc_socket_writebuffer_size(&nonblockdatasock));
+
+    /* both packets can be read. */
+    ASSERT_EQ(0, ipc_read_data_block(rhs, &str, &str_size));
+    ASSERT_EQ(strlen(TEST_STRING1), str_size);
+    EXPECT_EQ(0, memcmp(TEST_STRING1, str, str_size));
+    free(str);
+    str = nullptr;
+
+    ASSERT_EQ(0, ipc_read_data_block(rhs, &str, &str_size));
+    ASSERT_EQ(strlen(TEST_STRING2), str_size);
+    EXPECT_EQ(0, memcmp(TEST_STRING2, str, str_size));
+
+    /* clean up. */
+    free(str);
+    close(lhs);
+    close(rhs);
+}
+
+/**
+ * \brief State shared by the watermark test callbacks.
+ */
+struct test_watermark_context
+{
+    ipc_event_loop_context_t* loop;
+    std::vector<bool> crossings;
+    size_t reads;
+    size_t reads_at_drain;
+};
+
+static void test_watermark_cb(
+    ipc_socket_context_t* ctx, bool above, void* user_context)
+{
+    test_watermark_context* t = (test_watermark_context*)user_context;
+
+    t->crossings.push_back(above);
+
+    if (above)
+    {
+        ipc_pause_read_noblock(ctx);
+    }
+    else
+    {
+        t->reads_at_drain = t->reads;
+        ipc_resume_read_noblock(ctx);
+        ipc_exit_loop(t->loop);
+    }
+}
+
+static void test_watermark_read(
+    ipc_socket_context_t* ctx, int, void* user_context)
+{
+    test_watermark_context* t = (test_watermark_context*)user_context;
+
+    ++t->reads;
+    ipc_socket_read_to_buffer(ctx);
+}
+
+static void test_watermark_write(
+    ipc_socket_context_t* ctx, int, void* user_context)
+{
+    test_watermark_context* t = (test_watermark_context*)user_context;
+
+    /* the corked data is flushed at the end of this iteration. */
+    ipc_set_writecb_noblock(ctx, NULL, t->loop);
+}
+
+/**
+ * \brief The watermark callback fires when the write buffer crosses the high
+ * watermark and again when it drains below the low watermark, and a socket
+ * paused in between receives no read callbacks.
+ */
+TEST_F(ipc_test, ipc_set_watermarks_noblock_pause)
+{
+    int lhs, rhs;
+    ipc_socket_context_t sock;
+    ipc_event_loop_context_t wm_loop;
+    test_watermark_context t;
+    const std::string payload(100, 'x');
+    const char TEST_STRING[] = "This is a test.";
+
+    /* the low watermark can't be above the high watermark. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_make_noblock(lhs, &sock, &t));
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_INVALID_ARGUMENT,
+        ipc_set_watermarks_noblock(&sock, 512, 256, &test_watermark_cb));
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_set_watermarks_noblock(&sock, 64, 256, &test_watermark_cb));
+
+    /* set up a corked socket in an event loop. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&wm_loop));
+    t.loop = &wm_loop;
+    t.reads = 0;
+    t.reads_at_drain = 0;
+    ipc_set_cork_noblock(&sock, true);
+    ipc_set_readcb_noblock(&sock, &test_watermark_read, NULL);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_add(&wm_loop, &sock));
+
+    /* two packets stay below the high watermark... */
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(
+            AGENTD_STATUS_SUCCESS,
+            ipc_write_data_noblock(&sock, payload.data(), payload.size()));
+    }
+
+    EXPECT_TRUE(t.crossings.empty());
+
+    /* ...and the third crosses it. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_write_data_noblock(&sock, payload.data(), payload.size()));
+    ASSERT_EQ(1U, t.crossings.size());
+    EXPECT_TRUE(t.crossings[0]);
+
+    /* data from the peer is waiting, but reads are paused. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_write_data_block(rhs, TEST_STRING, strlen(TEST_STRING)));
+
+    /* run the loop until the write buffer drains. */
+    ipc_set_writecb_noblock(&sock, &test_watermark_write, &wm_loop);
+    ipc_event_loop_run(&wm_loop);
+
+    ASSERT_EQ(2U, t.crossings.size());
+    EXPECT_FALSE(t.crossings[1]);
+    EXPECT_EQ(0U, ipc_socket_writebuffer_size(&sock));
+    EXPECT_EQ(0U, t.reads_at_drain);
+
+    /* clean up. */
+    dispose((disposable_t*)&sock);
+    dispose((disposable_t*)&wm_loop);
+    close(lhs);
+    close(rhs);
+}
+
+/**
+ * \brief A ring pair can only be created with a power of two capacity within
+ * range.
+ */
+TEST_F(ipc_test, ipc_ringpair_bad_capacity)
+{
+    int memfd, lhs, rhs;
+
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_INVALID_ARGUMENT,
+        ipc_ringpair(5000, &memfd, &lhs, &rhs));
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_INVALID_ARGUMENT,
+        ipc_ringpair(1024, &memfd, &lhs, &rhs));
+}
+
+/**
+ * \brief State shared by the ring test callbacks.
+ */
+struct test_ring_context
+{
+    ipc_event_loop_context_t* loop;
+    std::vector<std::string> packets;
+    size_t expected;
+    int status;
+};
+
+static void test_ring_write(
+    ipc_socket_context_t* ctx, int, void* user_context)
+{
+    test_ring_context* t = (test_ring_context*)user_context;
+
+    if (ipc_socket_writebuffer_size(ctx) > 0)
+    {
+        ipc_socket_write_from_buffer(ctx);
+    }
+
+    /* anything left waits for the reader to make room. */
+    ipc_set_writecb_noblock(ctx, NULL, t->loop);
+}
+
+static void test_ring_wake(
+    ipc_socket_context_t* ctx, int, void* user_context)
+{
+    test_ring_context* t = (test_ring_context*)user_context;
+
+    /* nothing is sent to the writer, so this just clears its doorbell. */
+    ipc_socket_read_to_buffer(ctx);
+
+    if (ipc_socket_writebuffer_size(ctx) > 0)
+    {
+        ipc_set_writecb_noblock(ctx, &test_ring_write, t->loop);
+    }
+}
+
+static void test_ring_read(
+    ipc_socket_context_t* ctx, int, void* user_context)
+{
+    test_ring_context* t = (test_ring_context*)user_context;
+    void* val = nullptr;
+    uint32_t size = 0;
+    int retval;
+
+    do
+    {
+        retval = ipc_read_data_noblock(ctx, &val, &size);
+        if (AGENTD_STATUS_SUCCESS == retval)
+        {
+            t->packets.emplace_back((const char*)val, size);
+            free(val);
+        }
+        else if (AGENTD_ERROR_IPC_WOULD_BLOCK != retval)
+        {
+            t->status = retval;
+            ipc_exit_loop(t->loop);
+            return;
+        }
+    } while (AGENTD_STATUS_SUCCESS == retval
+          && ipc_socket_readbuffer_size(ctx) > 0);
+
+    if (t->packets.size() == t->expected)
+    {
+        ipc_exit_loop(t->loop);
+    }
+}
+
+/**
+ * \brief Data packets written to one side of a ring can be read from the
+ * other, including packets that wrap around the ring and packets that have to
+ * wait for the reader to make room.
+ */
+TEST_F(ipc_test, ipc_ring_write_read_data_noblock)
+{
+    int memfd, lhs, rhs;
+    ipc_socket_context_t writer, reader;
+    ipc_event_loop_context_t ring_loop;
+    test_ring_context t;
+    std::vector<std::string> sent;
+    void* val = nullptr;
+    uint32_t size = 0;
+
+    /* create a small ring, so that the packets below wrap around it. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_ringpair(4096, &memfd, &lhs, &rhs));
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_make_ring_noblock(
+            memfd, IPC_RING_SIDE_LHS, lhs, rhs, &writer, &t));
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_make_ring_noblock(
+            memfd, IPC_RING_SIDE_RHS, rhs, lhs, &reader, &t));
+    close(memfd);
+
+    /* set up the event loop. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&ring_loop));
+    t.loop = &ring_loop;
+    t.status = AGENTD_STATUS_SUCCESS;
+    t.expected = 20;
+    ipc_set_readcb_noblock(&writer, &test_ring_wake, NULL);
+    ipc_set_readcb_noblock(&reader, &test_ring_read, NULL);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_add(&ring_loop, &writer));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_add(&ring_loop, &reader));
+
+    /* write more than the ring can hold. */
+    for (size_t i = 0; i < t.expected; ++i)
+    {
+        sent.emplace_back(3000, (char)('a' + i));
+        ASSERT_EQ(
+            AGENTD_STATUS_SUCCESS,
+            ipc_write_data_noblock(
+                &writer, sent.back().data(), sent.back().size()));
+    }
+
+    EXPECT_GT(ipc_socket_writebuffer_size(&writer), 0U);
+
+    /* run the loop until every packet has been read. */
+    ipc_event_loop_run(&ring_loop);
+
+    EXPECT_EQ(AGENTD_STATUS_SUCCESS, t.status);
+    EXPECT_EQ(sent, t.packets);
+
+    /* once the writer is closed, the reader sees EOF. */
+    dispose((disposable_t*)&writer);
+    EXPECT_EQ(
+        AGENTD_ERROR_IPC_EVBUFFER_EOF,
+        ipc_read_data_noblock(&reader, &val, &size));
+
+    /* clean up. */
+    dispose((disposable_t*)&reader);
+    dispose((disposable_t*)&ring_loop);
+}
+
+static void test_timer_cb(ipc_timer_context_t*, void* user_context)
+{
+    function<void()>* func = (function<void()>*)user_context;
+
+    (*func)();
+}
+
+/**
+ * \brief It is possible to create a timer and have it fire.
+ */
+TEST_F(ipc_test, ipc_timer)
+{
+    int lhs, rhs;
+    bool callback_called = false;
+    timespec start_time;
+    timespec callback_time;
+    timespec expected_time;
+    ipc_timer_context_t timer;
+
+    function<void()> callback = [&]() {
+        ASSERT_EQ(0, clock_gettime(CLOCK_REALTIME, &callback_time));
+        callback_called = true;
+    };
+
+    /* create a socket pair for testing. */
+    ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+
+    /* set up the loop, using one of the sockets as a hack. */
+    timermode_setup(lhs);
+
+    /* initialize the timer event. */
+    ASSERT_EQ(0, ipc_timer_init(&timer, 250, &test_timer_cb, &callback));
+
+    /* add the timer to the loop. */
+    ASSERT_EQ(0, ipc_event_loop_add_timer(&loop, &timer));
+
+    /* get the current time. */
+    ASSERT_EQ(0, clock_gettime(CLOCK_REALTIME, &start_time));
+
+    /* run the loop. */
+    timermode();
+
+    /* verify that the callback was called. */
+    ASSERT_TRUE(callback_called);
+
+    /* we expect the callback to happen at least 250 milliseconds after
+     * start_time. */
+    memcpy(&expected_time, &start_time, sizeof(timespec));
+    expected_time.tv_nsec += 250 * 1000 * 1000;
+    expected_time.tv_sec += expected_time.tv_nsec / (1000 * 1000 * 1000);
+    expected_time.tv_nsec %= 1000 * 1000 * 1000;
 
     /* the callback time should be greater than or equal to the expected time.*/
     EXPECT_TRUE(
@@ -1837,3 +2986,52 @@ TEST_F(ipc_test, ipc_timer)
     close(rhs);
     dispose((disposable_t*)&timer);
 }
+
+static void test_signal_cb(int sig, void* user_context)
+{
+    function<void(int)>* func = (function<void(int)>*)user_context;
+
+    (*func)(sig);
+}
+
+/**
+ * \brief A signal callback is called from the event loop when its signal is
+ * caught, and the loop keeps running afterward.
+ */
+TEST_F(ipc_test, ipc_event_loop_on_signal)
+{
+    ipc_event_loop_context_t sig_loop;
+    int caught = 0;
+    int count = 0;
+
+    function<void(int)> callback = [&](int sig) {
+        caught = sig;
+        ++count;
+        ipc_exit_loop(&sig_loop);
+    };
+
+    /* create the loop. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&sig_loop));
+
+    /* call our callback on SIGUSR1. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS,
+        ipc_event_loop_on_signal(
+            &sig_loop, SIGUSR1, &test_signal_cb, &callback));
+
+    /* raise the signal, then run the loop until the callback exits it. */
+    ASSERT_EQ(0, raise(SIGUSR1));
+    ipc_event_loop_run(&sig_loop);
+
+    EXPECT_EQ(SIGUSR1, caught);
+    EXPECT_EQ(1, count);
+
+    /* the callback stays registered for the next signal. */
+    ASSERT_EQ(0, raise(SIGUSR1));
+    ipc_event_loop_run(&sig_loop);
+
+    EXPECT_EQ(2, count);
+
+    /* clean up. */
+    dispose((disposable_t*)&sig_loop);
+}
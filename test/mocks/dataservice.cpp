@@ -6,6 +6,7 @@
  * \copyright 2019-2020 Velo-Payments, Inc.  All rights reserved.
  */
 
+#include <agentd/inet.h>
 #include <agentd/ipc.h>
 #include <agentd/status_codes.h>
 #include <iostream>
@@ -168,6 +169,75 @@ void mock_dataservice::mock_dataservice::register_callback_block_id_latest_read(
     block_id_latest_read_callback = cb;
 }
 
+/**
+ * \brief Register a mock callback for block_notify_subscribe.
+ *
+ * \param cb                The callback to register.
+ */
+void mock_dataservice::mock_dataservice::
+    register_callback_block_notify_subscribe(
+        function<
+            int(const dataservice_request_block_notify_subscribe_t&,
+                ostream&)>
+            cb)
+{
+    block_notify_subscribe_callback = cb;
+}
+
+/**
+ * \brief Add a block notification to write after a successful
+ * block_notify_subscribe response.
+ *
+ * \param block_id          The block id for this notification.
+ * \param block_height      The block height for this notification.
+ */
+void mock_dataservice::mock_dataservice::add_block_notification(
+    const uint8_t* block_id, uint64_t block_height)
+{
+    uint64_t net_block_height = htonll(block_height);
+    string notification((const char*)block_id, 16);
+    notification.append((const char*)&net_block_height, sizeof(uint64_t));
+
+    block_notifications.push_back(notification);
+}
+
+/**
+ * \brief Register a mock callback for artifact_watch.
+ *
+ * \param cb                The callback to register.
+ */
+void mock_dataservice::mock_dataservice::register_callback_artifact_watch(
+    function<
+        int(const dataservice_request_artifact_watch_t&,
+            ostream&)>
+        cb)
+{
+    artifact_watch_callback = cb;
+}
+
+/**
+ * \brief Add an artifact notification to write after a successful
+ * artifact_watch response.
+ *
+ * \param artifact_id       The artifact id for this notification.
+ * \param txn_latest        The latest transaction id for this notification.
+ * \param height_latest     The latest block height for this notification.
+ * \param state_latest      The latest artifact state for this notification.
+ */
+void mock_dataservice::mock_dataservice::add_artifact_notification(
+    const uint8_t* artifact_id, const uint8_t* txn_latest,
+    uint64_t height_latest, uint32_t state_latest)
+{
+    uint64_t net_height_latest = htonll(height_latest);
+    uint32_t net_state_latest = htonl(state_latest);
+    string notification((const char*)artifact_id, 16);
+    notification.append((const char*)txn_latest, 16);
+    notification.append((const char*)&net_height_latest, sizeof(uint64_t));
+    notification.append((const char*)&net_state_latest, sizeof(uint32_t));
+
+    artifact_notifications.push_back(notification);
+}
+
 /**
  * \brief Register a mock callback for block_make.
  *
@@ -182,6 +252,21 @@ void mock_dataservice::mock_dataservice::register_callback_block_make(
     block_make_callback = cb;
 }
 
+/**
+ * \brief Register a mock callback for block_make_from_queue.
+ *
+ * \param cb                The callback to register.
+ */
+void mock_dataservice::mock_dataservice::
+    register_callback_block_make_from_queue(
+        function<
+            int(const dataservice_request_block_make_from_queue_t&,
+                ostream&)>
+            cb)
+{
+    block_make_from_queue_callback = cb;
+}
+
 /**
  * \brief Register a mock callback for block_read.
  *
@@ -497,6 +582,13 @@ bool mock_dataservice::mock_dataservice::mock_read_and_dispatch()
                     breq, payload_size);
             break;
 
+        /* handle block make from queue. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE:
+            retval =
+                mock_decode_and_dispatch_block_make_from_queue(
+                    breq, payload_size);
+            break;
+
         /* handle block read. */
         case DATASERVICE_API_METHOD_APP_BLOCK_READ:
             retval =
@@ -504,6 +596,13 @@ bool mock_dataservice::mock_dataservice::mock_read_and_dispatch()
                     breq, payload_size);
             break;
 
+        /* handle block certificate read. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ:
+            retval =
+                mock_decode_and_dispatch_block_cert_read(
+                    breq, payload_size);
+            break;
+
         /* handle block by height read. */
         case DATASERVICE_API_METHOD_APP_BLOCK_ID_BY_HEIGHT_READ:
             retval =
@@ -518,6 +617,20 @@ bool mock_dataservice::mock_dataservice::mock_read_and_dispatch()
                     breq, payload_size);
             break;
 
+        /* handle block notify subscribe. */
+        case DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE:
+            retval =
+                mock_decode_and_dispatch_block_notify_subscribe(
+                    breq, payload_size);
+            break;
+
+        /* handle artifact watch. */
+        case DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH:
+            retval =
+                mock_decode_and_dispatch_artifact_watch(
+                    breq, payload_size);
+            break;
+
         /* handle canonized transaction read. */
         case DATASERVICE_API_METHOD_APP_TRANSACTION_READ:
             retval =
@@ -1135,6 +1248,54 @@ done:
     return retval;
 }
 
+/**
+ * \brief Mock for the block make from queue call.
+ *
+ * \param req       The request payload.
+ * \param size      The request payload size.
+ *
+ * \returns true if the request could be processed and false otherwise.
+ */
+bool mock_dataservice::mock_dataservice::
+    mock_decode_and_dispatch_block_make_from_queue(
+        const void* request, size_t payload_size)
+{
+    bool retval = false;
+    dataservice_request_block_make_from_queue_t dreq;
+    stringstream payout;
+    string payload;
+    uint32_t status = AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+
+    /* parse the request payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_block_make_from_queue(
+            request, payload_size, &dreq))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* if the mock callback is set, call it. */
+    if (!!block_make_from_queue_callback)
+    {
+        status = block_make_from_queue_callback(dreq, payout);
+    }
+
+    /* get the payload if set. */
+    payload = payout.str();
+
+    /* success. */
+    retval = true;
+    goto done;
+
+done:
+    mock_write_status(
+        DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE,
+        dreq.hdr.child_index, status, payload.data(), payload.size());
+
+    return retval;
+}
+
 /**
  * \brief Mock for the block read call.
  *
@@ -1183,6 +1344,102 @@ done:
     return retval;
 }
 
+/**
+ * \brief Mock for the block certificate read call.
+ *
+ * The block is taken from the block read callback, and the requested slice of
+ * its certificate is returned.
+ *
+ * \param req       The request payload.
+ * \param size      The request payload size.
+ *
+ * \returns true if the request could be processed and false otherwise.
+ */
+bool mock_dataservice::mock_dataservice::
+    mock_decode_and_dispatch_block_cert_read(
+        const void* request, size_t payload_size)
+{
+    bool retval = false;
+    dataservice_request_block_cert_read_t dreq;
+    dataservice_request_block_read_t block_dreq;
+    stringstream payout;
+    string block;
+    void* payload = nullptr;
+    size_t payload_size_out = 0U;
+    uint32_t status = AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+
+    /* the size of the node at the start of a block read response. */
+    const size_t node_size = 4 * 16 + sizeof(uint64_t);
+
+    /* parse the request payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_block_cert_read(
+            request, payload_size, &dreq))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* read the whole block with the block read callback. */
+    memset(&block_dreq, 0, sizeof(block_dreq));
+    memcpy(&block_dreq.hdr, &dreq.hdr, sizeof(block_dreq.hdr));
+    memcpy(block_dreq.block_id, dreq.block_id, sizeof(block_dreq.block_id));
+    block_dreq.read_cert = true;
+    if (!!block_read_callback)
+    {
+        status = block_read_callback(block_dreq, payout);
+    }
+
+    /* get the block if set. */
+    block = payout.str();
+
+    /* slice the certificate that follows the node. */
+    if (AGENTD_STATUS_SUCCESS == status)
+    {
+        if (block.size() < node_size
+         || dreq.cert_offset > block.size() - node_size)
+        {
+            status = AGENTD_ERROR_DATASERVICE_REQUEST_PACKET_BAD;
+        }
+        else
+        {
+            const uint8_t* bblock = (const uint8_t*)block.data();
+            size_t cert_size = block.size() - node_size;
+            size_t slice_size = cert_size - dreq.cert_offset;
+            if (slice_size > dreq.max_size)
+            {
+                slice_size = dreq.max_size;
+            }
+
+            data_block_node_t node;
+            memcpy(node.key, bblock, 16);
+            memcpy(node.prev, bblock + 16, 16);
+            memcpy(node.next, bblock + 32, 16);
+            memcpy(node.first_transaction_id, bblock + 48, 16);
+            memcpy(&node.net_block_height, bblock + 64, sizeof(uint64_t));
+            node.net_block_cert_size = htonll(cert_size);
+
+            status =
+                dataservice_encode_response_block_cert_read(
+                    &payload, &payload_size_out, &node,
+                    bblock + node_size + dreq.cert_offset, slice_size);
+        }
+    }
+
+    /* success. */
+    retval = true;
+    goto done;
+
+done:
+    mock_write_status(
+        DATASERVICE_API_METHOD_APP_BLOCK_CERT_READ, dreq.hdr.child_index,
+        status, payload, payload_size_out);
+
+    free(payload);
+
+    return retval;
+}
+
 /**
  * \brief Mock for the block id by height read call.
  *
@@ -1279,6 +1536,132 @@ done:
     return retval;
 }
 
+/**
+ * \brief Mock for the block notify subscribe call.
+ *
+ * On success, each block notification added to the mock is written after the
+ * response.
+ *
+ * \param req       The request payload.
+ * \param size      The request payload size.
+ *
+ * \returns true if the request could be processed and false otherwise.
+ */
+bool mock_dataservice::mock_dataservice::
+    mock_decode_and_dispatch_block_notify_subscribe(
+        const void* request, size_t payload_size)
+{
+    bool retval = false;
+    dataservice_request_block_notify_subscribe_t dreq;
+    stringstream payout;
+    string payload;
+    uint32_t status = AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+
+    /* parse the request payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_block_notify_subscribe(
+            request, payload_size, &dreq))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* if the mock callback is set, call it. */
+    if (!!block_notify_subscribe_callback)
+    {
+        status = block_notify_subscribe_callback(dreq, payout);
+    }
+
+    /* get the payload if set. */
+    payload = payout.str();
+
+    /* success. */
+    retval = true;
+    goto done;
+
+done:
+    mock_write_status(
+        DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE, dreq.hdr.child_index,
+        status, payload.data(), payload.size());
+
+    /* write the notifications for this subscription. */
+    if (retval && AGENTD_STATUS_SUCCESS == status)
+    {
+        for (const auto& notification : block_notifications)
+        {
+            mock_write_status(
+                DATASERVICE_API_NOTIFICATION_BLOCK_COMMIT,
+                dreq.hdr.child_index, AGENTD_STATUS_SUCCESS,
+                notification.data(), notification.size());
+        }
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Mock for the artifact watch call.
+ *
+ * On success, each artifact notification added to the mock is written after
+ * the response.
+ *
+ * \param req       The request payload.
+ * \param size      The request payload size.
+ *
+ * \returns true if the request could be processed and false otherwise.
+ */
+bool mock_dataservice::mock_dataservice::
+    mock_decode_and_dispatch_artifact_watch(
+        const void* request, size_t payload_size)
+{
+    bool retval = false;
+    dataservice_request_artifact_watch_t dreq;
+    stringstream payout;
+    string payload;
+    uint32_t status = AGENTD_ERROR_DATASERVICE_NOT_FOUND;
+
+    /* parse the request payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_artifact_watch(
+            request, payload_size, &dreq))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* if the mock callback is set, call it. */
+    if (!!artifact_watch_callback)
+    {
+        status = artifact_watch_callback(dreq, payout);
+    }
+
+    /* get the payload if set. */
+    payload = payout.str();
+
+    /* success. */
+    retval = true;
+    goto done;
+
+done:
+    mock_write_status(
+        DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH, dreq.hdr.child_index,
+        status, payload.data(), payload.size());
+
+    /* write the notifications for this watch. */
+    if (retval && AGENTD_STATUS_SUCCESS == status)
+    {
+        for (const auto& notification : artifact_notifications)
+        {
+            mock_write_status(
+                DATASERVICE_API_NOTIFICATION_ARTIFACT_UPDATE,
+                dreq.hdr.child_index, AGENTD_STATUS_SUCCESS,
+                notification.data(), notification.size());
+        }
+    }
+
+    return retval;
+}
+
 /**
  * \brief Mock for the canonized transaction get call.
  *
@@ -1563,6 +1946,167 @@ done:
     return retval;
 }
 
+/**
+ * \brief Return true if the next popped request matches this request.
+ *
+ * \param child_index       The child index for this request.
+ */
+bool mock_dataservice::mock_dataservice::
+    request_matches_block_notify_subscribe(
+        uint32_t child_index)
+{
+    bool retval = false;
+    void* val = nullptr;
+    uint32_t size = 0U;
+    const uint8_t* breq = nullptr;
+    uint32_t nmethod = 0U, method = 0U;
+    dataservice_request_block_notify_subscribe_t dreq;
+
+    /* read a request from the test socket. */
+    if (AGENTD_STATUS_SUCCESS != ipc_read_data_block(testsock, &val, &size))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* make working with the request more convenient. */
+    breq = (const uint8_t*)val;
+
+    /* the payload should be at least large enough for the method. */
+    if (size < sizeof(uint32_t))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* get the method. */
+    memcpy(&nmethod, breq, sizeof(uint32_t));
+    method = htonl(nmethod);
+
+    /* increment breq past command. */
+    breq += sizeof(uint32_t);
+
+    /* decrement size. */
+    size -= sizeof(uint32_t);
+
+    /* verify the method. */
+    if (DATASERVICE_API_METHOD_APP_BLOCK_NOTIFY_SUBSCRIBE != method)
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* parse the requset payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_block_notify_subscribe(
+            breq, size, &dreq))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* verify the request. */
+    if (
+        child_index != dreq.hdr.child_index)
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* successful match. */
+    retval = true;
+    goto cleanup_val;
+
+cleanup_val:
+    free(val);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Return true if the next popped request matches this request.
+ *
+ * \param child_index       The child index for this request.
+ * \param artifact_ids      The artifact ids for this request.
+ * \param artifact_count    The number of artifact ids.
+ */
+bool mock_dataservice::mock_dataservice::
+    request_matches_artifact_watch(
+        uint32_t child_index, const uint8_t* artifact_ids,
+        size_t artifact_count)
+{
+    bool retval = false;
+    void* val = nullptr;
+    uint32_t size = 0U;
+    const uint8_t* breq = nullptr;
+    uint32_t nmethod = 0U, method = 0U;
+    dataservice_request_artifact_watch_t dreq;
+
+    /* read a request from the test socket. */
+    if (AGENTD_STATUS_SUCCESS != ipc_read_data_block(testsock, &val, &size))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* make working with the request more convenient. */
+    breq = (const uint8_t*)val;
+
+    /* the payload should be at least large enough for the method. */
+    if (size < sizeof(uint32_t))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* get the method. */
+    memcpy(&nmethod, breq, sizeof(uint32_t));
+    method = htonl(nmethod);
+
+    /* increment breq past command. */
+    breq += sizeof(uint32_t);
+
+    /* decrement size. */
+    size -= sizeof(uint32_t);
+
+    /* verify the method. */
+    if (DATASERVICE_API_METHOD_APP_ARTIFACT_WATCH != method)
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* parse the requset payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_artifact_watch(
+            breq, size, &dreq))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* verify the request. */
+    if (
+        child_index != dreq.hdr.child_index
+     || artifact_count != dreq.artifact_count
+     || memcmp(artifact_ids, dreq.artifact_ids, 16 * artifact_count))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* successful match. */
+    retval = true;
+    goto cleanup_val;
+
+cleanup_val:
+    free(val);
+
+done:
+    return retval;
+}
+
 /**
  * \brief Return true if the next popped request matches this request.
  *
@@ -1645,6 +2189,88 @@ done:
     return retval;
 }
 
+/**
+ * \brief Return true if the next popped request matches this request.
+ *
+ * \param child_index       The child index for this request.
+ * \param block_id          The block id for this request.
+ * \param block_height      The block height for this request.
+ * \param max_transactions  The maximum transaction count for this request.
+ */
+bool mock_dataservice::mock_dataservice::
+    request_matches_block_make_from_queue(
+        uint32_t child_index, const uint8_t* block_id, uint64_t block_height,
+        uint32_t max_transactions)
+{
+    bool retval = false;
+    void* val = nullptr;
+    uint32_t size = 0U;
+    const uint8_t* breq = nullptr;
+    uint32_t nmethod = 0U, method = 0U;
+    dataservice_request_block_make_from_queue_t dreq;
+
+    /* read a request from the test socket. */
+    if (AGENTD_STATUS_SUCCESS != ipc_read_data_block(testsock, &val, &size))
+    {
+        retval = false;
+        goto done;
+    }
+
+    /* make working with the request more convenient. */
+    breq = (const uint8_t*)val;
+
+    /* the payload should be at least large enough for the method. */
+    if (size < sizeof(uint32_t))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* get the method. */
+    memcpy(&nmethod, breq, sizeof(uint32_t));
+    method = htonl(nmethod);
+
+    /* increment breq past command. */
+    breq += sizeof(uint32_t);
+
+    /* decrement size. */
+    size -= sizeof(uint32_t);
+
+    /* verify the method. */
+    if (DATASERVICE_API_METHOD_APP_BLOCK_MAKE_FROM_QUEUE != method)
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* parse the requset payload. */
+    if (AGENTD_STATUS_SUCCESS !=
+        dataservice_decode_request_block_make_from_queue(
+            breq, size, &dreq))
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* verify the request. */
+    if (
+        child_index != dreq.hdr.child_index || ((NULL != block_id) && (0 != memcmp(block_id, dreq.block_id, 16))) || block_height != dreq.block_height || max_transactions != dreq.max_transactions)
+    {
+        retval = false;
+        goto cleanup_val;
+    }
+
+    /* successful match. */
+    retval = true;
+    goto cleanup_val;
+
+cleanup_val:
+    free(val);
+
+done:
+    return retval;
+}
+
 /**
  * \brief Return true if the next popped request matches this request.
  *
@@ -17,6 +17,7 @@
 #include <functional>
 #include <list>
 #include <memory>
+#include <string>
 #include <sys/types.h>
 
 #include "../../src/dataservice/dataservice_protocol_internal.h"
@@ -110,6 +111,54 @@ public:
                 std::ostream&)>
             cb);
 
+    /**
+         * \brief Register a mock callback for block_notify_subscribe.
+         *
+         * \param cb                The callback to register.
+         */
+    void register_callback_block_notify_subscribe(
+        std::function<
+            int(const dataservice_request_block_notify_subscribe_t&,
+                std::ostream&)>
+            cb);
+
+    /**
+         * \brief Add a block notification to write after a successful
+         * block_notify_subscribe response.
+         *
+         * \param block_id          The block id for this notification.
+         * \param block_height      The block height for this notification.
+         */
+    void add_block_notification(
+        const uint8_t* block_id, uint64_t block_height);
+
+    /**
+         * \brief Register a mock callback for artifact_watch.
+         *
+         * \param cb                The callback to register.
+         */
+    void register_callback_artifact_watch(
+        std::function<
+            int(const dataservice_request_artifact_watch_t&,
+                std::ostream&)>
+            cb);
+
+    /**
+         * \brief Add an artifact notification to write after a successful
+         * artifact_watch response.
+         *
+         * \param artifact_id       The artifact id for this notification.
+         * \param txn_latest        The latest transaction id for this
+         *                          notification.
+         * \param height_latest     The latest block height for this
+         *                          notification.
+         * \param state_latest      The latest artifact state for this
+         *                          notification.
+         */
+    void add_artifact_notification(
+        const uint8_t* artifact_id, const uint8_t* txn_latest,
+        uint64_t height_latest, uint32_t state_latest);
+
     /**
          * \brief Register a mock callback for block_make.
          *
@@ -121,6 +170,17 @@ public:
                 std::ostream&)>
             cb);
 
+    /**
+         * \brief Register a mock callback for block_make_from_queue.
+         *
+         * \param cb                The callback to register.
+         */
+    void register_callback_block_make_from_queue(
+        std::function<
+            int(const dataservice_request_block_make_from_queue_t&,
+                std::ostream&)>
+            cb);
+
     /**
          * \brief Register a mock callback for block_read.
          *
@@ -268,6 +328,25 @@ public:
     bool request_matches_block_id_latest_read(
         uint32_t child_index);
 
+    /**
+         * \brief Return true if the next popped request matches this request.
+         *
+         * \param child_index       The child index for this request.
+         */
+    bool request_matches_block_notify_subscribe(
+        uint32_t child_index);
+
+    /**
+         * \brief Return true if the next popped request matches this request.
+         *
+         * \param child_index       The child index for this request.
+         * \param artifact_ids      The artifact ids for this request.
+         * \param artifact_count    The number of artifact ids.
+         */
+    bool request_matches_artifact_watch(
+        uint32_t child_index, const uint8_t* artifact_ids,
+        size_t artifact_count);
+
     /**
          * \brief Return true if the next popped request matches this request.
          *
@@ -280,6 +359,19 @@ public:
         uint32_t child_index, const uint8_t* block_id, size_t cert_size,
         const uint8_t* cert);
 
+    /**
+         * \brief Return true if the next popped request matches this request.
+         *
+         * \param child_index       The child index for this request.
+         * \param block_id          The block id for this request.
+         * \param block_height      The block height for this request.
+         * \param max_transactions  The maximum transaction count for this
+         *                          request.
+         */
+    bool request_matches_block_make_from_queue(
+        uint32_t child_index, const uint8_t* block_id, uint64_t block_height,
+        uint32_t max_transactions);
+
     /**
          * \brief Return true if the next popped request matches this request.
          *
@@ -404,10 +496,24 @@ private:
         int(const dataservice_request_block_id_latest_read_t&,
             std::ostream&)>
         block_id_latest_read_callback;
+    std::function<
+        int(const dataservice_request_block_notify_subscribe_t&,
+            std::ostream&)>
+        block_notify_subscribe_callback;
+    std::list<std::string> block_notifications;
+    std::function<
+        int(const dataservice_request_artifact_watch_t&,
+            std::ostream&)>
+        artifact_watch_callback;
+    std::list<std::string> artifact_notifications;
     std::function<
         int(const dataservice_request_block_make_t&,
             std::ostream&)>
         block_make_callback;
+    std::function<
+        int(const dataservice_request_block_make_from_queue_t&,
+            std::ostream&)>
+        block_make_from_queue_callback;
     std::function<
         int(const dataservice_request_block_read_t&,
             std::ostream&)>
@@ -625,6 +731,17 @@ private:
     bool mock_decode_and_dispatch_block_make(
         const void* request, size_t payload_size);
 
+    /**
+         * \brief Mock for the block make from queue call.
+         *
+         * \param req       The request payload.
+         * \param size      The request payload size.
+         *
+         * \returns true if the request could be processed and false otherwise.
+         */
+    bool mock_decode_and_dispatch_block_make_from_queue(
+        const void* request, size_t payload_size);
+
     /**
          * \brief Mock for the block read call.
          *
@@ -636,6 +753,20 @@ private:
     bool mock_decode_and_dispatch_block_read(
         const void* request, size_t payload_size);
 
+    /**
+         * \brief Mock for the block certificate read call.
+         *
+         * The block is taken from the block read callback, and the requested
+         * slice of its certificate is returned.
+         *
+         * \param req       The request payload.
+         * \param size      The request payload size.
+         *
+         * \returns true if the request could be processed and false otherwise.
+         */
+    bool mock_decode_and_dispatch_block_cert_read(
+        const void* request, size_t payload_size);
+
     /**
          * \brief Mock for the block id by height read call.
          *
@@ -658,6 +789,28 @@ private:
     bool mock_decode_and_dispatch_block_id_latest_read(
         const void* request, size_t payload_size);
 
+    /**
+         * \brief Mock for the block notify subscribe call.
+         *
+         * \param req       The request payload.
+         * \param size      The request payload size.
+         *
+         * \returns true if the request could be processed and false otherwise.
+         */
+    bool mock_decode_and_dispatch_block_notify_subscribe(
+        const void* request, size_t payload_size);
+
+    /**
+         * \brief Mock for the artifact watch call.
+         *
+         * \param req       The request payload.
+         * \param size      The request payload size.
+         *
+         * \returns true if the request could be processed and false otherwise.
+         */
+    bool mock_decode_and_dispatch_artifact_watch(
+        const void* request, size_t payload_size);
+
     /**
          * \brief Mock for the canonized transaction get call.
          *
@@ -9,6 +9,7 @@
 #include <agentd/protocolservice/api.h>
 #include <agentd/status_codes.h>
 #include <iostream>
+#include <signal.h>
 #include <string>
 #include <unistd.h>
 #include <vpr/disposable.h>
@@ -1087,9 +1088,10 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_by_id_happy_path)
 }
 
 /**
- * Test the happy path of block_get_next_id.
+ * Test that a block too large for a single packet is streamed to the client,
+ * and that it is refused in a batch.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_by_id_streamed)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
@@ -1098,12 +1100,20 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
         0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
         0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
     };
-    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
-        0xbd, 0xbc, 0xbd, 0x4a, 0x2d, 0x39, 0x4f, 0x23,
-        0xbc, 0xc6, 0xf7, 0xb8, 0x03, 0xa5, 0x7f, 0x6a
-    };
+    const uint32_t BATCH_OFFSET = 29U;
     vccrypt_buffer_t shared_secret;
-    uint8_t next_id[16];
+    data_block_node_t data_block_node;
+    uint8_t* block_cert = nullptr;
+    size_t block_cert_size = 0UL;
+    uint8_t* responses = nullptr;
+    size_t responses_size = 0U;
+
+    /* a certificate that can't fit in a single authenticated packet. */
+    vector<uint8_t> large_cert(IPC_AUTHED_PACKET_MAX_SIZE + 1U);
+    for (size_t i = 0; i < large_cert.size(); ++i)
+    {
+        large_cert[i] = (uint8_t)(i * 31U);
+    }
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
@@ -1118,8 +1128,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
             int retval =
                 dataservice_encode_response_block_read(
                     &payload, &payload_size, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
-                    EXPECTED_NEXT_BLOCK_ID, EXPECTED_BLOCK_ID, 10, false,
-                    EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
+                    EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID, 10, true,
+                    large_cert.data(), large_cert.size());
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -1142,24 +1152,48 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
 
     /* send the block get request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_block_next_id_get(
+        protocolservice_api_sendreq_block_get(
             protosock, &suite, &client_iv, &shared_secret,
             EXPECTED_BLOCK_ID));
 
-    /* get the response. */
+    /* the streamed response is gathered into the usual result. */
+    uint64_t first_server_iv = server_iv;
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_block_next_id_get(
+        protocolservice_api_recvresp_block_get(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, next_id));
-
-    /* the status should indicate success. */
-    ASSERT_EQ(
-        AGENTD_STATUS_SUCCESS, (int)status);
-    /* the offset should be zero. */
+            &status, &data_block_node, &block_cert, &block_cert_size));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
     ASSERT_EQ(0U, offset);
+    ASSERT_EQ(large_cert.size(), block_cert_size);
+    EXPECT_EQ(0, memcmp(block_cert, large_cert.data(), block_cert_size));
+    EXPECT_EQ(0, memcmp(data_block_node.key, EXPECTED_BLOCK_ID, 16));
+    free(block_cert);
 
-    /* in the mock above, we hack in the next block id. */
-    ASSERT_EQ(0, memcmp(next_id, EXPECTED_NEXT_BLOCK_ID, 16));
+    /* a begin frame, more than one chunk, and an end frame were read. */
+    EXPECT_GT(server_iv - first_server_iv, 3U);
+
+    /* the same block can't be carried in a batch response. */
+    protocolservice_api_batch_request_t requests[1] = {
+        { UNAUTH_PROTOCOL_REQ_ID_BLOCK_BY_ID_GET, 1U, EXPECTED_BLOCK_ID,
+          sizeof(EXPECTED_BLOCK_ID) },
+    };
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_batch(
+            protosock, &suite, &client_iv, &shared_secret, BATCH_OFFSET,
+            requests, 1U));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_batch(
+            protosock, &suite, &server_iv, &shared_secret, &offset, &status,
+            &responses, &responses_size));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    ASSERT_EQ(sizeof(uint32_t) + 3 * sizeof(uint32_t), responses_size);
+
+    uint32_t net_status;
+    memcpy(&net_status, responses + sizeof(uint32_t) + 4, 4);
+    EXPECT_EQ(
+        AGENTD_ERROR_PROTOCOLSERVICE_RESPONSE_TOO_LARGE_FOR_BATCH,
+        (int)ntohl(net_status));
+    free(responses);
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1180,11 +1214,6 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
     /* verify proper connection setup. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
 
-    /* a block get call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_block_read(
-            EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
-
     /* verify proper connection teardown. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
 
@@ -1193,24 +1222,21 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
 }
 
 /**
- * Test that block_get_next_id returns NOT_FOUND if the block id is the end
- * sentry.
+ * Test that a block with a successor is answered from the response cache the
+ * second time it is requested.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id_end)
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_by_id_cached)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
     const uint8_t EXPECTED_BLOCK_ID[16] = {
-        0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
-        0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
-    };
-    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+        0x5e, 0x19, 0x83, 0x2c, 0x47, 0xd0, 0x4a, 0x6f,
+        0xa2, 0x3b, 0x90, 0x1e, 0xc4, 0x75, 0x08, 0xdd
     };
     vccrypt_buffer_t shared_secret;
-    uint8_t next_id[16];
+    data_block_node_t data_block_node;
+    protocolservice_api_status_t stats;
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
@@ -1225,7 +1251,7 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id_end)
             int retval =
                 dataservice_encode_response_block_read(
                     &payload, &payload_size, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
-                    EXPECTED_NEXT_BLOCK_ID, EXPECTED_BLOCK_ID, 10, false,
+                    EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID, 10, true,
                     EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
@@ -1247,23 +1273,42 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id_end)
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
         do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the block get request. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_block_next_id_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_BLOCK_ID));
-
-    /* get the response. */
+    /* request the same block twice. */
+    for (int i = 0; i < 2; ++i)
+    {
+        uint8_t* block_cert = nullptr;
+        size_t block_cert_size = 0UL;
+
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_block_get(
+                protosock, &suite, &client_iv, &shared_secret,
+                EXPECTED_BLOCK_ID));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_recvresp_block_get(
+                protosock, &suite, &server_iv, &shared_secret, &offset,
+                &status, &data_block_node, &block_cert, &block_cert_size));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+        ASSERT_EQ(0U, offset);
+
+        /* both responses carry the same block. */
+        EXPECT_EQ(0, memcmp(data_block_node.key, EXPECTED_BLOCK_ID, 16));
+        ASSERT_EQ(16U, block_cert_size);
+        EXPECT_EQ(0, memcmp(block_cert, EXPECTED_BLOCK_ID, 16));
+
+        free(block_cert);
+    }
+
+    /* the status counters show one miss and one hit. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_status_get(
+            protosock, &suite, &client_iv, &shared_secret));
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_block_next_id_get(
+        protocolservice_api_recvresp_status_get(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, next_id));
-
-    /* the status should indicate failure. */
-    ASSERT_EQ(
-        AGENTD_ERROR_DATASERVICE_NOT_FOUND, (int)status);
-    /* the offset should be zero. */
-    ASSERT_EQ(0U, offset);
+            &status, &stats));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    EXPECT_EQ(1U, stats.response_cache_hits);
+    EXPECT_EQ(1U, stats.response_cache_misses);
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1284,22 +1329,24 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id_end)
     /* verify proper connection setup. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
 
-    /* a block get call should have been made. */
+    /* only the first request should have reached the dataservice. */
     EXPECT_TRUE(
         dataservice->request_matches_block_read(
             EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
 
-    /* verify proper connection teardown. */
-    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+    /* the second request was answered from the cache. */
+    EXPECT_FALSE(
+        dataservice->request_matches_block_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
 
     /* clean up. */
     dispose((disposable_t*)&shared_secret);
 }
 
 /**
- * Test the happy path of block_get_prev_id.
+ * Test the happy path of block_get_next_id.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
@@ -1308,12 +1355,12 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
         0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
         0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
     };
-    const uint8_t EXPECTED_PREV_BLOCK_ID[16] = {
-        0x58, 0x73, 0x64, 0xa8, 0x4d, 0x75, 0x41, 0x40,
-        0x84, 0x76, 0x9f, 0x4e, 0x12, 0xa4, 0xdb, 0xb0
+    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
+        0xbd, 0xbc, 0xbd, 0x4a, 0x2d, 0x39, 0x4f, 0x23,
+        0xbc, 0xc6, 0xf7, 0xb8, 0x03, 0xa5, 0x7f, 0x6a
     };
     vccrypt_buffer_t shared_secret;
-    uint8_t prev_id[16];
+    uint8_t next_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
@@ -1327,9 +1374,9 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
 
             int retval =
                 dataservice_encode_response_block_read(
-                    &payload, &payload_size, EXPECTED_BLOCK_ID,
-                    EXPECTED_PREV_BLOCK_ID, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
-                    10, false, EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
+                    &payload, &payload_size, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
+                    EXPECTED_NEXT_BLOCK_ID, EXPECTED_BLOCK_ID, 10, false,
+                    EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -1352,15 +1399,15 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
 
     /* send the block get request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_block_prev_id_get(
+        protocolservice_api_sendreq_block_next_id_get(
             protosock, &suite, &client_iv, &shared_secret,
             EXPECTED_BLOCK_ID));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_block_prev_id_get(
+        protocolservice_api_recvresp_block_next_id_get(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, prev_id));
+            &status, next_id));
 
     /* the status should indicate success. */
     ASSERT_EQ(
@@ -1368,8 +1415,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
 
-    /* in the mock above, we hack in the prev block id. */
-    ASSERT_EQ(0, memcmp(prev_id, EXPECTED_PREV_BLOCK_ID, 16));
+    /* in the mock above, we hack in the next block id. */
+    ASSERT_EQ(0, memcmp(next_id, EXPECTED_NEXT_BLOCK_ID, 16));
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1403,10 +1450,9 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
 }
 
 /**
- * Test that block_get_prev_id returns NOT_FOUND if the block id is the begin
- * sentry.
+ * Test that a client can send several requests before reading the responses.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id_end)
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id_pipelined)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
@@ -1415,12 +1461,13 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id_end)
         0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
         0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
     };
-    const uint8_t EXPECTED_PREV_BLOCK_ID[16] = {
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
+        0xbd, 0xbc, 0xbd, 0x4a, 0x2d, 0x39, 0x4f, 0x23,
+        0xbc, 0xc6, 0xf7, 0xb8, 0x03, 0xa5, 0x7f, 0x6a
     };
+    const int REQUEST_COUNT = 3;
     vccrypt_buffer_t shared_secret;
-    uint8_t prev_id[16];
+    uint8_t next_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
@@ -1434,9 +1481,9 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id_end)
 
             int retval =
                 dataservice_encode_response_block_read(
-                    &payload, &payload_size, EXPECTED_BLOCK_ID,
-                    EXPECTED_PREV_BLOCK_ID, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
-                    10, false, EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
+                    &payload, &payload_size, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
+                    EXPECTED_NEXT_BLOCK_ID, EXPECTED_BLOCK_ID, 10, false,
+                    EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -1457,23 +1504,27 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id_end)
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
         do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the block get request. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_block_prev_id_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_BLOCK_ID));
-
-    /* get the response. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_block_prev_id_get(
-            protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, prev_id));
-
-    /* the status should indicate failure. */
-    ASSERT_EQ(
-        AGENTD_ERROR_DATASERVICE_NOT_FOUND, (int)status);
-    /* the offset should be zero. */
-    ASSERT_EQ(0U, offset);
+    /* send every block get request before reading any response. */
+    for (int i = 0; i < REQUEST_COUNT; ++i)
+    {
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_block_next_id_get(
+                protosock, &suite, &client_iv, &shared_secret,
+                EXPECTED_BLOCK_ID));
+    }
+
+    /* each request gets its response. */
+    for (int i = 0; i < REQUEST_COUNT; ++i)
+    {
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_recvresp_block_next_id_get(
+                protosock, &suite, &server_iv, &shared_secret, &offset,
+                &status, next_id));
+        ASSERT_EQ(
+            AGENTD_STATUS_SUCCESS, (int)status);
+        ASSERT_EQ(0U, offset);
+        ASSERT_EQ(0, memcmp(next_id, EXPECTED_NEXT_BLOCK_ID, 16));
+    }
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1507,37 +1558,42 @@ TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id_end)
 }
 
 /**
- * Test the happy path of transaction_get_by_id
+ * Test that a batch request is answered with a single batch response that
+ * holds a response for each sub-request.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, txn_get_by_id_happy_path)
+TEST_F(unauthorized_protocol_service_isolation_test, batch_happy_path)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
-    const uint8_t EXPECTED_TXN_ID[16] = {
-        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
-        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
+        0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
+    };
+    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
+        0xbd, 0xbc, 0xbd, 0x4a, 0x2d, 0x39, 0x4f, 0x23,
+        0xbc, 0xc6, 0xf7, 0xb8, 0x03, 0xa5, 0x7f, 0x6a
     };
+    const uint32_t BATCH_OFFSET = 17U;
     vccrypt_buffer_t shared_secret;
-    data_transaction_node_t data_txn_node;
-    uint8_t* txn_cert = nullptr;
-    size_t txn_cert_size = 0UL;
+    uint8_t* responses = nullptr;
+    size_t responses_size = 0U;
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
     /* mock the block get call. */
-    dataservice->register_callback_canonized_transaction_get(
-        [&](const dataservice_request_canonized_transaction_get_t&,
+    dataservice->register_callback_block_read(
+        [&](const dataservice_request_block_read_t&,
             std::ostream& payout) {
             void* payload = nullptr;
             size_t payload_size = 0U;
 
             int retval =
-                dataservice_encode_response_canonized_transaction_get(
-                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
-                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
-                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
+                dataservice_encode_response_block_read(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
+                    EXPECTED_NEXT_BLOCK_ID, EXPECTED_BLOCK_ID, 10, false,
+                    EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -1558,30 +1614,69 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_by_id_happy_path)
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
         do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the block get request. */
+    /* send two block next id requests and a status request in one batch. */
+    protocolservice_api_batch_request_t requests[3] = {
+        { UNAUTH_PROTOCOL_REQ_ID_BLOCK_ID_GET_NEXT, 1U, EXPECTED_BLOCK_ID,
+          sizeof(EXPECTED_BLOCK_ID) },
+        { UNAUTH_PROTOCOL_REQ_ID_BLOCK_ID_GET_NEXT, 2U, EXPECTED_BLOCK_ID,
+          sizeof(EXPECTED_BLOCK_ID) },
+        { UNAUTH_PROTOCOL_REQ_ID_STATUS_GET, 3U, nullptr, 0U },
+    };
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_transaction_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_TXN_ID));
+        protocolservice_api_sendreq_batch(
+            protosock, &suite, &client_iv, &shared_secret, BATCH_OFFSET,
+            requests, 3U));
 
-    /* get the response. */
+    /* all three responses come back in a single batch response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_transaction_get(
-            protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, &data_txn_node, &txn_cert, &txn_cert_size));
-
-    /* the status should indicate that the record wasn't found. */
-    ASSERT_EQ(
-        AGENTD_STATUS_SUCCESS, (int)status);
-    /* the offset should be zero. */
-    ASSERT_EQ(0U, offset);
-
-    /* in the mock above, we hack in the txn id as the certificate. */
-    ASSERT_EQ(0, memcmp(txn_cert, EXPECTED_TXN_ID, 16));
-    ASSERT_EQ(16U, txn_cert_size);
-
-    /* clean up memory. */
-    free(txn_cert);
+        protocolservice_api_recvresp_batch(
+            protosock, &suite, &server_iv, &shared_secret, &offset, &status,
+            &responses, &responses_size));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    ASSERT_EQ(BATCH_OFFSET, offset);
+
+    /* walk the sub-responses. */
+    int next_id_responses = 0;
+    int status_responses = 0;
+    size_t pos = 0U;
+    while (pos < responses_size)
+    {
+        uint32_t net_size, net_method, net_status, net_offset;
+        ASSERT_GE(responses_size - pos, sizeof(net_size));
+        memcpy(&net_size, responses + pos, sizeof(net_size));
+        pos += sizeof(net_size);
+
+        size_t sub_size = ntohl(net_size);
+        ASSERT_GE(sub_size, 3 * sizeof(uint32_t));
+        ASSERT_GE(responses_size - pos, sub_size);
+        memcpy(&net_method, responses + pos, 4);
+        memcpy(&net_status, responses + pos + 4, 4);
+        memcpy(&net_offset, responses + pos + 8, 4);
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)ntohl(net_status));
+
+        if (UNAUTH_PROTOCOL_REQ_ID_BLOCK_ID_GET_NEXT == ntohl(net_method))
+        {
+            ASSERT_EQ(3 * sizeof(uint32_t) + 16, sub_size);
+            EXPECT_TRUE(1U == ntohl(net_offset) || 2U == ntohl(net_offset));
+            EXPECT_EQ(0,
+                memcmp(responses + pos + 12, EXPECTED_NEXT_BLOCK_ID, 16));
+            ++next_id_responses;
+        }
+        else
+        {
+            ASSERT_EQ(
+                (uint32_t)UNAUTH_PROTOCOL_REQ_ID_STATUS_GET,
+                ntohl(net_method));
+            EXPECT_EQ(3U, ntohl(net_offset));
+            ++status_responses;
+        }
+
+        pos += sub_size;
+    }
+
+    EXPECT_EQ(2, next_id_responses);
+    EXPECT_EQ(1, status_responses);
+    free(responses);
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1604,8 +1699,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_by_id_happy_path)
 
     /* a block get call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_canonized_transaction_get(
-            EXPECTED_CHILD_INDEX, EXPECTED_TXN_ID));
+        dataservice->request_matches_block_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
 
     /* verify proper connection teardown. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
@@ -1615,70 +1710,1363 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_by_id_happy_path)
 }
 
 /**
- * Test the happy path of transaction_get_next_id.
+ * Test that back-to-back handshakes succeed whether their entropy comes from
+ * the local entropy pool or from the random service.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_happy_path)
+TEST_F(unauthorized_protocol_service_isolation_test, repeated_handshakes)
 {
     uint32_t offset, status;
-    uint64_t client_iv = 0;
-    uint64_t server_iv = 0;
-    const uint8_t EXPECTED_TXN_ID[16] = {
-        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
-        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
-    };
-    const uint8_t EXPECTED_NEXT_TXN_ID[16] = {
-        0xa8, 0x33, 0x7c, 0x29, 0x26, 0xfa, 0x48, 0x4e,
-        0x9f, 0x29, 0x6c, 0xe7, 0xb3, 0x3e, 0x4a, 0x65
-    };
-    vccrypt_buffer_t shared_secret;
-    uint8_t next_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the block get call. */
-    dataservice->register_callback_canonized_transaction_get(
-        [&](const dataservice_request_canonized_transaction_get_t&,
-            std::ostream& payout) {
-            void* payload = nullptr;
-            size_t payload_size = 0U;
+    /* start the mock. */
+    dataservice->start();
 
-            int retval =
-                dataservice_encode_response_canonized_transaction_get(
-                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
-                    EXPECTED_NEXT_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
-                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
-            if (AGENTD_STATUS_SUCCESS != retval)
-                return retval;
+    for (int i = 0; i < 4; ++i)
+    {
+        uint64_t client_iv = 0;
+        uint64_t server_iv = 0;
+        vccrypt_buffer_t shared_secret;
+
+        /* every connection after the first needs a new socket. */
+        if (i > 0)
+        {
+            int protosock_srv;
+            ASSERT_EQ(0,
+                ipc_socketpair(
+                    AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+            ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+            close(protosock_srv);
+        }
+
+        /* do the handshake, populating the shared secret on success. */
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            do_handshake(&shared_secret, &server_iv, &client_iv));
+
+        /* the session should work. */
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_status_get(
+                protosock, &suite, &client_iv, &shared_secret));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_recvresp_status_get(
+                protosock, &suite, &server_iv, &shared_secret, &offset,
+                &status, NULL));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+
+        /* close the connection. */
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_close(
+                protosock, &suite, &client_iv, &shared_secret));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_recvresp_close(
+                protosock, &suite, &server_iv, &shared_secret));
+
+        /* TearDown closes the last socket. */
+        if (i < 3)
+        {
+            close(protosock);
+        }
+
+        dispose((disposable_t*)&shared_secret);
+    }
 
-            /* make sure to clean up memory when we fall out of scope. */
-            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+    /* stop the mock. */
+    dataservice->stop();
 
-            /* write the payload. */
-            payout.write((const char*)payload, payload_size);
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+}
 
-            /* success. */
-            return AGENTD_STATUS_SUCCESS;
-        });
+/**
+ * Test that connections with the same capabilities share a pooled child
+ * context, so reconnecting does not create or close a child context.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, pooled_child_context_reused)
+{
+    uint32_t offset, status;
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
 
     /* start the mock. */
     dataservice->start();
 
-    /* do the handshake, populating the shared secret on success. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        do_handshake(&shared_secret, &server_iv, &client_iv));
+    for (int i = 0; i < 3; ++i)
+    {
+        uint64_t client_iv = 0;
+        uint64_t server_iv = 0;
+        vccrypt_buffer_t shared_secret;
+
+        /* every connection after the first needs a new socket. */
+        if (i > 0)
+        {
+            int protosock_srv;
+            ASSERT_EQ(0,
+                ipc_socketpair(
+                    AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+            ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+            close(protosock_srv);
+        }
+
+        /* do the handshake, populating the shared secret on success. */
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            do_handshake(&shared_secret, &server_iv, &client_iv));
+
+        /* the session should work. */
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_status_get(
+                protosock, &suite, &client_iv, &shared_secret));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_recvresp_status_get(
+                protosock, &suite, &server_iv, &shared_secret, &offset,
+                &status, NULL));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+
+        /* close the connection. */
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_close(
+                protosock, &suite, &client_iv, &shared_secret));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_recvresp_close(
+                protosock, &suite, &server_iv, &shared_secret));
+
+        /* TearDown closes the last socket. */
+        if (i < 2)
+        {
+            close(protosock);
+        }
+
+        dispose((disposable_t*)&shared_secret);
+    }
 
-    /* send the block get request. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_transaction_next_id_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_TXN_ID));
+    /* stop the mock. */
+    dataservice->stop();
 
-    /* get the response. */
-    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_transaction_next_id_get(
-            protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, next_id));
+    /* only the first connection should have created a child context. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* the later connections reuse it without creating or closing one. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+}
+
+/**
+ * Test that a session ticket can be redeemed once to resume a session on a new
+ * connection without a full handshake.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, session_resume_happy_path)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    vccrypt_buffer_t shared_secret;
+    vccrypt_buffer_t session_key;
+    vccrypt_buffer_t key_nonce;
+    vccrypt_buffer_t resumed_secret;
+    uint8_t ticket[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* ask for a session ticket. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_session_ticket_get(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_session_ticket_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset, &status,
+            ticket, &session_key));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    ASSERT_EQ(0U, offset);
+
+    /* close the first connection. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+    close(protosock);
+
+    /* open a second connection. */
+    int protosock_srv;
+    ASSERT_EQ(0,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+    ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+    close(protosock_srv);
+
+    /* resume the session with the ticket. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_handshake_resume_block(
+            protosock, &suite, authorized_entity_id, ticket, &session_key,
+            &key_nonce, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_handshake_resume_block(
+            protosock, &suite, &key_nonce, &resumed_secret, &offset,
+            &status));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+
+    /* the resumed session works like any other. */
+    client_iv = 0x0000000000000001UL;
+    server_iv = 0x8000000000000001UL;
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_status_get(
+            protosock, &suite, &client_iv, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_status_get(
+            protosock, &suite, &server_iv, &resumed_secret, &offset,
+            &status, NULL));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+
+    /* close the second connection. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &resumed_secret));
+    close(protosock);
+    dispose((disposable_t*)&resumed_secret);
+    dispose((disposable_t*)&key_nonce);
+
+    /* open a third connection. */
+    ASSERT_EQ(0,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+    ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+    close(protosock_srv);
+
+    /* the ticket has already been redeemed, so it can't be replayed. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_handshake_resume_block(
+            protosock, &suite, authorized_entity_id, ticket, &session_key,
+            &key_nonce, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_handshake_resume_block(
+            protosock, &suite, &key_nonce, &resumed_secret, &offset,
+            &status));
+    EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID, (int)status);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* clean up. */
+    dispose((disposable_t*)&resumed_secret);
+    dispose((disposable_t*)&key_nonce);
+    dispose((disposable_t*)&session_key);
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that a resume request that fails its signature check doesn't use up
+ * the ticket, and that a tampered ticket is rejected.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test,
+    session_resume_bad_signature_keeps_ticket)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    vccrypt_buffer_t shared_secret;
+    vccrypt_buffer_t session_key;
+    vccrypt_buffer_t wrong_key;
+    vccrypt_buffer_t key_nonce;
+    vccrypt_buffer_t resumed_secret;
+    uint8_t ticket[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+    uint8_t tampered[PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+    int protosock_srv;
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* ask for a session ticket. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_session_ticket_get(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_session_ticket_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset, &status,
+            ticket, &session_key));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+
+    /* close the first connection. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+    close(protosock);
+
+    /* a client without the session key signs with the wrong key. */
+    ASSERT_EQ(VCCRYPT_STATUS_SUCCESS,
+        vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+            &suite, &wrong_key));
+    memcpy(wrong_key.data, session_key.data, wrong_key.size);
+    ((uint8_t*)wrong_key.data)[0] ^= 0x01;
+
+    ASSERT_EQ(0,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+    ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+    close(protosock_srv);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_handshake_resume_block(
+            protosock, &suite, authorized_entity_id, ticket, &wrong_key,
+            &key_nonce, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_handshake_resume_block(
+            protosock, &suite, &key_nonce, &resumed_secret, &offset,
+            &status));
+    EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED, (int)status);
+    close(protosock);
+    dispose((disposable_t*)&resumed_secret);
+    dispose((disposable_t*)&key_nonce);
+
+    /* a tampered ticket is rejected. */
+    memcpy(tampered, ticket, sizeof(tampered));
+    tampered[PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE] ^= 0x01;
+
+    ASSERT_EQ(0,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+    ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+    close(protosock_srv);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_handshake_resume_block(
+            protosock, &suite, authorized_entity_id, tampered, &session_key,
+            &key_nonce, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_handshake_resume_block(
+            protosock, &suite, &key_nonce, &resumed_secret, &offset,
+            &status));
+    EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID, (int)status);
+    close(protosock);
+    dispose((disposable_t*)&resumed_secret);
+    dispose((disposable_t*)&key_nonce);
+
+    /* the holder of the session key can still redeem the ticket. */
+    ASSERT_EQ(0,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+    ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+    close(protosock_srv);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_handshake_resume_block(
+            protosock, &suite, authorized_entity_id, ticket, &session_key,
+            &key_nonce, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_handshake_resume_block(
+            protosock, &suite, &key_nonce, &resumed_secret, &offset,
+            &status));
+    EXPECT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+
+    /* close the resumed session. */
+    client_iv = 0x0000000000000001UL;
+    server_iv = 0x8000000000000001UL;
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &resumed_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &resumed_secret));
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* clean up. */
+    dispose((disposable_t*)&resumed_secret);
+    dispose((disposable_t*)&key_nonce);
+    dispose((disposable_t*)&wrong_key);
+    dispose((disposable_t*)&session_key);
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that two session tickets requested in one batch are distinct, and that
+ * each can be redeemed once with its own session key.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, session_ticket_batch)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint32_t BATCH_OFFSET = 23U;
+    vccrypt_buffer_t shared_secret;
+    vccrypt_buffer_t session_key[2];
+    vccrypt_buffer_t key_nonce;
+    vccrypt_buffer_t resumed_secret;
+    uint8_t ticket[2][PROTOCOLSERVICE_SESSION_TICKET_SIZE];
+    uint8_t* responses = nullptr;
+    size_t responses_size = 0U;
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* ask for two session tickets in one batch. */
+    protocolservice_api_batch_request_t requests[2] = {
+        { UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET, 0U, nullptr, 0U },
+        { UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET, 1U, nullptr, 0U },
+    };
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_batch(
+            protosock, &suite, &client_iv, &shared_secret, BATCH_OFFSET,
+            requests, 2U));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_batch(
+            protosock, &suite, &server_iv, &shared_secret, &offset, &status,
+            &responses, &responses_size));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    ASSERT_EQ(BATCH_OFFSET, offset);
+
+    /* pull the ticket out of each sub-response. */
+    const size_t sub_size =
+        3 * sizeof(uint32_t) + PROTOCOLSERVICE_SESSION_TICKET_SIZE;
+    ASSERT_EQ(2 * (sizeof(uint32_t) + sub_size), responses_size);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        const uint8_t* sub =
+            responses + i * (sizeof(uint32_t) + sub_size) + sizeof(uint32_t);
+        uint32_t net_method, net_status, net_offset;
+        memcpy(&net_method, sub, 4);
+        memcpy(&net_status, sub + 4, 4);
+        memcpy(&net_offset, sub + 8, 4);
+        ASSERT_EQ(
+            (uint32_t)UNAUTH_PROTOCOL_REQ_ID_SESSION_TICKET_GET,
+            ntohl(net_method));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)ntohl(net_status));
+
+        uint32_t index = ntohl(net_offset);
+        ASSERT_LT(index, 2U);
+        memcpy(ticket[index], sub + 12, PROTOCOLSERVICE_SESSION_TICKET_SIZE);
+    }
+    free(responses);
+
+    /* the two tickets are distinct. */
+    EXPECT_NE(0, memcmp(ticket[0], ticket[1], sizeof(ticket[0])));
+
+    /* derive the session key for each ticket, as the client would. */
+    for (size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(VCCRYPT_STATUS_SUCCESS,
+            vccrypt_suite_buffer_init_for_cipher_key_agreement_shared_secret(
+                &suite, &session_key[i]));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_session_key_derive(
+                &suite, &shared_secret, ticket[i],
+                PROTOCOLSERVICE_SESSION_TICKET_ID_SIZE, &session_key[i]));
+    }
+
+    /* the two session keys are distinct. */
+    EXPECT_NE(0,
+        memcmp(
+            session_key[0].data, session_key[1].data, session_key[0].size));
+
+    /* close the first connection. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+    close(protosock);
+
+    /* each ticket resumes a session once, then is used up. */
+    for (size_t i = 0; i < 2; ++i)
+    {
+        int expected[2] = {
+            AGENTD_STATUS_SUCCESS,
+            AGENTD_ERROR_PROTOCOLSERVICE_SESSION_TICKET_INVALID };
+
+        for (size_t attempt = 0; attempt < 2; ++attempt)
+        {
+            /* open a new connection. */
+            int protosock_srv;
+            ASSERT_EQ(0,
+                ipc_socketpair(
+                    AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+            ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+            close(protosock_srv);
+
+            /* resume the session with this ticket. */
+            ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+                protocolservice_api_sendreq_handshake_resume_block(
+                    protosock, &suite, authorized_entity_id, ticket[i],
+                    &session_key[i], &key_nonce, &resumed_secret));
+            ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+                protocolservice_api_recvresp_handshake_resume_block(
+                    protosock, &suite, &key_nonce, &resumed_secret, &offset,
+                    &status));
+            EXPECT_EQ(expected[attempt], (int)status);
+
+            /* close a resumed session cleanly. */
+            if (AGENTD_STATUS_SUCCESS == (int)status)
+            {
+                client_iv = 0x0000000000000001UL;
+                server_iv = 0x8000000000000001UL;
+                ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+                    protocolservice_api_sendreq_close(
+                        protosock, &suite, &client_iv, &resumed_secret));
+                ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+                    protocolservice_api_recvresp_close(
+                        protosock, &suite, &server_iv, &resumed_secret));
+            }
+
+            close(protosock);
+            dispose((disposable_t*)&resumed_secret);
+            dispose((disposable_t*)&key_nonce);
+        }
+    }
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* clean up. */
+    dispose((disposable_t*)&session_key[0]);
+    dispose((disposable_t*)&session_key[1]);
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that an entity from the authorized entities file can connect, and that
+ * its child context only gets the capabilities listed for it.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, file_entity_caps)
+{
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    vccrypt_buffer_t shared_secret;
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake as the read-only entity. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(
+            &shared_secret, &server_iv, &client_iv, reader_entity_id));
+
+    /* close the connection. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* the child context can only read blocks and transactions. */
+    BITCAP(testbits, DATASERVICE_API_CAP_BITS_MAX);
+    BITCAP_INIT_FALSE(testbits);
+    BITCAP_SET_TRUE(testbits, DATASERVICE_API_CAP_APP_BLOCK_ID_LATEST_READ);
+    BITCAP_SET_TRUE(testbits, DATASERVICE_API_CAP_APP_BLOCK_ID_BY_HEIGHT_READ);
+    BITCAP_SET_TRUE(testbits, DATASERVICE_API_CAP_APP_BLOCK_READ);
+    BITCAP_SET_TRUE(testbits, DATASERVICE_API_CAP_APP_TRANSACTION_READ);
+    BITCAP_SET_TRUE(testbits, DATASERVICE_API_CAP_LL_CHILD_CONTEXT_CLOSE);
+    EXPECT_TRUE(dataservice->request_matches_child_context_create(testbits));
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that the authorized entity table is reloaded on SIGUSR1, without
+ * restarting the service.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, entity_table_reload)
+{
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    vccrypt_buffer_t shared_secret;
+    int retval;
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* the new entity isn't known yet. */
+    ASSERT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED,
+        do_handshake(
+            &shared_secret, &server_iv, &client_iv, reloaded_entity_id));
+    close(protosock);
+
+    /* add the new entity, and tell the service to reload. */
+    ASSERT_EQ(0,
+        write_authorized_entities(
+            string(reloaded_entity_id_string) + " "
+                + authorized_entity_pubkey_string + "\n"));
+    ASSERT_EQ(0, kill(protopid, SIGUSR1));
+
+    /* the signal is handled asynchronously, so retry until it lands. */
+    for (int i = 0; i < 100; ++i)
+    {
+        int protosock_srv;
+        ASSERT_EQ(0,
+            ipc_socketpair(
+                AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+        ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+        close(protosock_srv);
+
+        retval =
+            do_handshake(
+                &shared_secret, &server_iv, &client_iv, reloaded_entity_id);
+        if (AGENTD_ERROR_PROTOCOLSERVICE_UNAUTHORIZED != retval)
+            break;
+
+        close(protosock);
+        usleep(10000);
+    }
+
+    /* the new entity can now connect. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, retval);
+
+    /* close the connection. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* an entity without a capability list gets the default capabilities. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that block_get_next_id returns NOT_FOUND if the block id is the end
+ * sentry.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_next_id_end)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
+        0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
+    };
+    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t next_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_block_read(
+        [&](const dataservice_request_block_read_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_block_read(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
+                    EXPECTED_NEXT_BLOCK_ID, EXPECTED_BLOCK_ID, 10, false,
+                    EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_block_next_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_BLOCK_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_block_next_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, next_id));
+
+    /* the status should indicate failure. */
+    ASSERT_EQ(
+        AGENTD_ERROR_DATASERVICE_NOT_FOUND, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_block_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test the happy path of block_get_prev_id.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
+        0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
+    };
+    const uint8_t EXPECTED_PREV_BLOCK_ID[16] = {
+        0x58, 0x73, 0x64, 0xa8, 0x4d, 0x75, 0x41, 0x40,
+        0x84, 0x76, 0x9f, 0x4e, 0x12, 0xa4, 0xdb, 0xb0
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t prev_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_block_read(
+        [&](const dataservice_request_block_read_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_block_read(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID,
+                    EXPECTED_PREV_BLOCK_ID, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
+                    10, false, EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_block_prev_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_BLOCK_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_block_prev_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, prev_id));
+
+    /* the status should indicate success. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* in the mock above, we hack in the prev block id. */
+    ASSERT_EQ(0, memcmp(prev_id, EXPECTED_PREV_BLOCK_ID, 16));
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_block_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that block_get_prev_id returns NOT_FOUND if the block id is the begin
+ * sentry.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, block_get_prev_id_end)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0xca, 0x47, 0xa5, 0xbb, 0x39, 0xaa, 0x44, 0xb2,
+        0xb1, 0x7b, 0xc0, 0x55, 0x1a, 0x24, 0x90, 0x9c
+    };
+    const uint8_t EXPECTED_PREV_BLOCK_ID[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t prev_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_block_read(
+        [&](const dataservice_request_block_read_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_block_read(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID,
+                    EXPECTED_PREV_BLOCK_ID, EXPECTED_BLOCK_ID, EXPECTED_BLOCK_ID,
+                    10, false, EXPECTED_BLOCK_ID, sizeof(EXPECTED_BLOCK_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_block_prev_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_BLOCK_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_block_prev_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, prev_id));
+
+    /* the status should indicate failure. */
+    ASSERT_EQ(
+        AGENTD_ERROR_DATASERVICE_NOT_FOUND, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_block_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_BLOCK_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test the happy path of transaction_get_by_id
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, txn_get_by_id_happy_path)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_TXN_ID[16] = {
+        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
+        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    };
+    vccrypt_buffer_t shared_secret;
+    data_transaction_node_t data_txn_node;
+    uint8_t* txn_cert = nullptr;
+    size_t txn_cert_size = 0UL;
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_canonized_transaction_get(
+        [&](const dataservice_request_canonized_transaction_get_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_canonized_transaction_get(
+                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
+                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
+                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_transaction_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_TXN_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_transaction_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, &data_txn_node, &txn_cert, &txn_cert_size));
+
+    /* the status should indicate that the record wasn't found. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* in the mock above, we hack in the txn id as the certificate. */
+    ASSERT_EQ(0, memcmp(txn_cert, EXPECTED_TXN_ID, 16));
+    ASSERT_EQ(16U, txn_cert_size);
+
+    /* clean up memory. */
+    free(txn_cert);
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_canonized_transaction_get(
+            EXPECTED_CHILD_INDEX, EXPECTED_TXN_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test the happy path of transaction_get_next_id.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_happy_path)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_TXN_ID[16] = {
+        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
+        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    };
+    const uint8_t EXPECTED_NEXT_TXN_ID[16] = {
+        0xa8, 0x33, 0x7c, 0x29, 0x26, 0xfa, 0x48, 0x4e,
+        0x9f, 0x29, 0x6c, 0xe7, 0xb3, 0x3e, 0x4a, 0x65
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t next_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_canonized_transaction_get(
+        [&](const dataservice_request_canonized_transaction_get_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_canonized_transaction_get(
+                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
+                    EXPECTED_NEXT_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
+                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_transaction_next_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_TXN_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_transaction_next_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, next_id));
+
+    /* the status should indicate that the record wasn't found. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* we should get the next txn id. */
+    ASSERT_EQ(0, memcmp(next_id, EXPECTED_NEXT_TXN_ID, 16));
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_canonized_transaction_get(
+            EXPECTED_CHILD_INDEX, EXPECTED_TXN_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test that transaction_get_next_id returns NOT_FOUND if the block id is the
+ * end sentry.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_end)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_TXN_ID[16] = {
+        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
+        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    };
+    const uint8_t EXPECTED_NEXT_TXN_ID[16] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t next_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_canonized_transaction_get(
+        [&](const dataservice_request_canonized_transaction_get_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_canonized_transaction_get(
+                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
+                    EXPECTED_NEXT_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
+                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_transaction_next_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_TXN_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_transaction_next_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, next_id));
+
+    /* the status should indicate failure. */
+    ASSERT_EQ(
+        AGENTD_ERROR_DATASERVICE_NOT_FOUND, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_canonized_transaction_get(
+            EXPECTED_CHILD_INDEX, EXPECTED_TXN_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test the happy path of transaction_get_prev_id.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_TXN_ID[16] = {
+        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
+        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    };
+    const uint8_t EXPECTED_PREV_TXN_ID[16] = {
+        0x3d, 0x36, 0x93, 0x5c, 0x9d, 0x8d, 0x49, 0xbe,
+        0xab, 0x76, 0xbf, 0xf2, 0x62, 0xe8, 0x53, 0x60
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t prev_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_canonized_transaction_get(
+        [&](const dataservice_request_canonized_transaction_get_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_canonized_transaction_get(
+                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_PREV_TXN_ID,
+                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
+                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_transaction_prev_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_TXN_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_transaction_prev_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, prev_id));
 
     /* the status should indicate that the record wasn't found. */
     ASSERT_EQ(
@@ -1686,8 +3074,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_happy_path)
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
 
-    /* we should get the next txn id. */
-    ASSERT_EQ(0, memcmp(next_id, EXPECTED_NEXT_TXN_ID, 16));
+    /* we should get the prev txn id. */
+    ASSERT_EQ(0, memcmp(prev_id, EXPECTED_PREV_TXN_ID, 16));
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1721,10 +3109,10 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_happy_path)
 }
 
 /**
- * Test that transaction_get_next_id returns NOT_FOUND if the block id is the
+ * Test that transaction_get_prev_id returns NOT_FOUND if the block id is the
  * end sentry.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_end)
+TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_end)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
@@ -1733,12 +3121,12 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_end)
         0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
         0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
     };
-    const uint8_t EXPECTED_NEXT_TXN_ID[16] = {
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+    const uint8_t EXPECTED_PREV_TXN_ID[16] = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
     };
     vccrypt_buffer_t shared_secret;
-    uint8_t next_id[16];
+    uint8_t prev_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
@@ -1752,8 +3140,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_end)
 
             int retval =
                 dataservice_encode_response_canonized_transaction_get(
-                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
-                    EXPECTED_NEXT_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
+                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_PREV_TXN_ID,
+                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
                     true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
@@ -1777,15 +3165,15 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_end)
 
     /* send the block get request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_transaction_next_id_get(
+        protocolservice_api_sendreq_transaction_prev_id_get(
             protosock, &suite, &client_iv, &shared_secret,
             EXPECTED_TXN_ID));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_transaction_next_id_get(
+        protocolservice_api_recvresp_transaction_prev_id_get(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, next_id));
+            &status, prev_id));
 
     /* the status should indicate failure. */
     ASSERT_EQ(
@@ -1825,9 +3213,9 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_next_id_end)
 }
 
 /**
- * Test the happy path of transaction_get_prev_id.
+ * Test the happy path of transaction_get_block_id.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
+TEST_F(unauthorized_protocol_service_isolation_test, txn_get_block_id_happy_path)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
@@ -1836,12 +3224,12 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
         0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
         0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
     };
-    const uint8_t EXPECTED_PREV_TXN_ID[16] = {
-        0x3d, 0x36, 0x93, 0x5c, 0x9d, 0x8d, 0x49, 0xbe,
-        0xab, 0x76, 0xbf, 0xf2, 0x62, 0xe8, 0x53, 0x60
+    const uint8_t EXPECTED_BLOCK_TXN_ID[16] = {
+        0x18, 0x70, 0xe6, 0x2a, 0xff, 0xf2, 0x44, 0x5c,
+        0x90, 0xe0, 0xbd, 0xb0, 0x3c, 0xee, 0xe7, 0x5a
     };
     vccrypt_buffer_t shared_secret;
-    uint8_t prev_id[16];
+    uint8_t block_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
@@ -1855,8 +3243,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
 
             int retval =
                 dataservice_encode_response_canonized_transaction_get(
-                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_PREV_TXN_ID,
-                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
+                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
+                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_BLOCK_TXN_ID, 10,
                     true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
@@ -1880,15 +3268,15 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
 
     /* send the block get request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_transaction_prev_id_get(
+        protocolservice_api_sendreq_transaction_block_id_get(
             protosock, &suite, &client_iv, &shared_secret,
             EXPECTED_TXN_ID));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_transaction_prev_id_get(
+        protocolservice_api_recvresp_transaction_block_id_get(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, prev_id));
+            &status, block_id));
 
     /* the status should indicate that the record wasn't found. */
     ASSERT_EQ(
@@ -1896,8 +3284,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
 
-    /* we should get the prev txn id. */
-    ASSERT_EQ(0, memcmp(prev_id, EXPECTED_PREV_TXN_ID, 16));
+    /* we should get the block txn id. */
+    ASSERT_EQ(0, memcmp(block_id, EXPECTED_BLOCK_TXN_ID, 16));
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -1931,40 +3319,38 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_happy_path)
 }
 
 /**
- * Test that transaction_get_prev_id returns NOT_FOUND if the block id is the
- * end sentry.
+ * Test the happy path of artifact_get_first_txn_id.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_end)
+TEST_F(unauthorized_protocol_service_isolation_test, artifact_first_txn_happy)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
-    const uint8_t EXPECTED_TXN_ID[16] = {
+    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
         0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
         0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
     };
-    const uint8_t EXPECTED_PREV_TXN_ID[16] = {
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+    const uint8_t EXPECTED_FIRST_TXN_ID[16] = {
+        0x18, 0x70, 0xe6, 0x2a, 0xff, 0xf2, 0x44, 0x5c,
+        0x90, 0xe0, 0xbd, 0xb0, 0x3c, 0xee, 0xe7, 0x5a
     };
     vccrypt_buffer_t shared_secret;
-    uint8_t prev_id[16];
+    uint8_t first_txn_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
     /* mock the block get call. */
-    dataservice->register_callback_canonized_transaction_get(
-        [&](const dataservice_request_canonized_transaction_get_t&,
+    dataservice->register_callback_payload_artifact_read(
+        [&](const dataservice_request_payload_artifact_read_t&,
             std::ostream& payout) {
             void* payload = nullptr;
             size_t payload_size = 0U;
 
             int retval =
-                dataservice_encode_response_canonized_transaction_get(
-                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_PREV_TXN_ID,
-                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_TXN_ID, 10,
-                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
+                dataservice_encode_response_payload_artifact_read(
+                    &payload, &payload_size, EXPECTED_ARTIFACT_ID,
+                    EXPECTED_FIRST_TXN_ID, zero_uuid, 10, 12, 77);
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -1987,22 +3373,130 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_end)
 
     /* send the block get request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_transaction_prev_id_get(
+        protocolservice_api_sendreq_artifact_first_txn_id_get(
             protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_TXN_ID));
+            EXPECTED_ARTIFACT_ID));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_transaction_prev_id_get(
+        protocolservice_api_recvresp_artifact_first_txn_id_get(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, prev_id));
+            &status, first_txn_id));
 
-    /* the status should indicate failure. */
+    /* the status should indicate that the record wasn't found. */
+    ASSERT_EQ(
+        AGENTD_STATUS_SUCCESS, (int)status);
+    /* the offset should be zero. */
+    ASSERT_EQ(0U, offset);
+
+    /* we should get the first txn id. */
+    ASSERT_EQ(0, memcmp(first_txn_id, EXPECTED_FIRST_TXN_ID, 16));
+
+    /* send the close request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
+
+    /* get the close response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
+    /* close the socket */
+    close(protosock);
+
+    /* stop the mock. */
+    dataservice->stop();
+
+    /* verify proper connection setup. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
+
+    /* a block get call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_payload_artifact_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_ARTIFACT_ID));
+
+    /* verify proper connection teardown. */
+    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+
+    /* clean up. */
+    dispose((disposable_t*)&shared_secret);
+}
+
+/**
+ * Test the happy path of artifact_get_last_txn_id.
+ */
+TEST_F(unauthorized_protocol_service_isolation_test, artifact_last_txn_happy)
+{
+    uint32_t offset, status;
+    uint64_t client_iv = 0;
+    uint64_t server_iv = 0;
+    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
+        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
+        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    };
+    const uint8_t EXPECTED_LAST_TXN_ID[16] = {
+        0x18, 0x70, 0xe6, 0x2a, 0xff, 0xf2, 0x44, 0x5c,
+        0x90, 0xe0, 0xbd, 0xb0, 0x3c, 0xee, 0xe7, 0x5a
+    };
+    vccrypt_buffer_t shared_secret;
+    uint8_t last_txn_id[16];
+
+    /* register dataservice helper mocks. */
+    ASSERT_EQ(0, dataservice_mock_register_helper());
+
+    /* mock the block get call. */
+    dataservice->register_callback_payload_artifact_read(
+        [&](const dataservice_request_payload_artifact_read_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            int retval =
+                dataservice_encode_response_payload_artifact_read(
+                    &payload, &payload_size, EXPECTED_ARTIFACT_ID,
+                    zero_uuid, EXPECTED_LAST_TXN_ID, 10, 12, 77);
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* start the mock. */
+    dataservice->start();
+
+    /* do the handshake, populating the shared secret on success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* send the block get request. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_artifact_last_txn_id_get(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_ARTIFACT_ID));
+
+    /* get the response. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_artifact_last_txn_id_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, last_txn_id));
+
+    /* the status should indicate that the record wasn't found. */
     ASSERT_EQ(
-        AGENTD_ERROR_DATASERVICE_NOT_FOUND, (int)status);
+        AGENTD_STATUS_SUCCESS, (int)status);
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
 
+    /* we should get the first txn id. */
+    ASSERT_EQ(0, memcmp(last_txn_id, EXPECTED_LAST_TXN_ID, 16));
+
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
         protocolservice_api_sendreq_close(
@@ -2024,8 +3518,8 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_end)
 
     /* a block get call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_canonized_transaction_get(
-            EXPECTED_CHILD_INDEX, EXPECTED_TXN_ID));
+        dataservice->request_matches_payload_artifact_read(
+            EXPECTED_CHILD_INDEX, EXPECTED_ARTIFACT_ID));
 
     /* verify proper connection teardown. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
@@ -2035,90 +3529,61 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_prev_id_end)
 }
 
 /**
- * Test the happy path of transaction_get_block_id.
+ * Test the status api method.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, txn_get_block_id_happy_path)
+TEST_F(unauthorized_protocol_service_isolation_test, status_happy)
 {
     uint32_t offset, status;
+    protocolservice_api_status_t stats;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
-    const uint8_t EXPECTED_TXN_ID[16] = {
-        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
-        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
-    };
-    const uint8_t EXPECTED_BLOCK_TXN_ID[16] = {
-        0x18, 0x70, 0xe6, 0x2a, 0xff, 0xf2, 0x44, 0x5c,
-        0x90, 0xe0, 0xbd, 0xb0, 0x3c, 0xee, 0xe7, 0x5a
-    };
     vccrypt_buffer_t shared_secret;
-    uint8_t block_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the block get call. */
-    dataservice->register_callback_canonized_transaction_get(
-        [&](const dataservice_request_canonized_transaction_get_t&,
-            std::ostream& payout) {
-            void* payload = nullptr;
-            size_t payload_size = 0U;
-
-            int retval =
-                dataservice_encode_response_canonized_transaction_get(
-                    &payload, &payload_size, EXPECTED_TXN_ID, EXPECTED_TXN_ID,
-                    EXPECTED_TXN_ID, EXPECTED_TXN_ID, EXPECTED_BLOCK_TXN_ID, 10,
-                    true, EXPECTED_TXN_ID, sizeof(EXPECTED_TXN_ID));
-            if (AGENTD_STATUS_SUCCESS != retval)
-                return retval;
-
-            /* make sure to clean up memory when we fall out of scope. */
-            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
-
-            /* write the payload. */
-            payout.write((const char*)payload, payload_size);
-
-            /* success. */
-            return AGENTD_STATUS_SUCCESS;
-        });
-
     /* start the mock. */
     dataservice->start();
 
     /* do the handshake, populating the shared secret on success. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        do_handshake(&shared_secret, &server_iv, &client_iv));
+              do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the block get request. */
+    /* send the status get request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_transaction_block_id_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_TXN_ID));
+              protocolservice_api_sendreq_status_get(
+                    protosock, &suite, &client_iv, &shared_secret));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_transaction_block_id_get(
-            protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, block_id));
+              protocolservice_api_recvresp_status_get(
+                    protosock, &suite, &server_iv, &shared_secret, &offset,
+                    &status, &stats));
 
-    /* the status should indicate that the record wasn't found. */
+    /* the status should indicate success. */
     ASSERT_EQ(
         AGENTD_STATUS_SUCCESS, (int)status);
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
-
-    /* we should get the block txn id. */
-    ASSERT_EQ(0, memcmp(block_id, EXPECTED_BLOCK_TXN_ID, 16));
+    /* nothing has been looked up in the response cache. */
+    EXPECT_EQ(0U, stats.response_cache_hits);
+    EXPECT_EQ(0U, stats.response_cache_misses);
+    /* only the status request itself has been scheduled. */
+    EXPECT_EQ(0U, stats.schedule_queue_depth);
+    EXPECT_EQ(0U, stats.dataservice_inflight);
+    EXPECT_EQ(1U, stats.schedule_dispatched);
+    EXPECT_GE(stats.schedule_wait_total_usec, stats.schedule_wait_max_usec);
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_close(
-            protosock, &suite, &client_iv, &shared_secret));
+              protocolservice_api_sendreq_close(
+                    protosock, &suite, &client_iv, &shared_secret));
 
     /* get the close response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_close(
-            protosock, &suite, &server_iv, &shared_secret));
-
+              protocolservice_api_recvresp_close(
+                    protosock, &suite, &server_iv, &shared_secret));
+ 
     /* close the socket */
     close(protosock);
 
@@ -2128,11 +3593,6 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_block_id_happy_path
     /* verify proper connection setup. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
 
-    /* a block get call should have been made. */
-    EXPECT_TRUE(
-        dataservice->request_matches_canonized_transaction_get(
-            EXPECTED_CHILD_INDEX, EXPECTED_TXN_ID));
-
     /* verify proper connection teardown. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
 
@@ -2141,38 +3601,42 @@ TEST_F(unauthorized_protocol_service_isolation_test, txn_get_block_id_happy_path
 }
 
 /**
- * Test the happy path of artifact_get_first_txn_id.
+ * Test that a connection subscribed to block notifications receives a
+ * notification when a block is committed.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, artifact_first_txn_happy)
+TEST_F(unauthorized_protocol_service_isolation_test, block_notify_happy_path)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
-    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
-        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
-        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0x37, 0x0e, 0x8c, 0x42, 0x5a, 0x16, 0x4e, 0x0b,
+        0x9d, 0x51, 0xd3, 0x2a, 0x0f, 0x6c, 0x71, 0x8e
     };
-    const uint8_t EXPECTED_FIRST_TXN_ID[16] = {
-        0x18, 0x70, 0xe6, 0x2a, 0xff, 0xf2, 0x44, 0x5c,
-        0x90, 0xe0, 0xbd, 0xb0, 0x3c, 0xee, 0xe7, 0x5a
+    const uint64_t EXPECTED_BLOCK_HEIGHT = 17;
+    const uint8_t EXPECTED_NOTIFY_BLOCK_ID[16] = {
+        0xc9, 0x64, 0x21, 0x7d, 0x03, 0xb8, 0x4f, 0x96,
+        0x8a, 0x2e, 0x55, 0xf0, 0x1b, 0x47, 0xe2, 0x3c
     };
+    const uint64_t EXPECTED_NOTIFY_BLOCK_HEIGHT = 18;
+    uint8_t block_id[16];
+    uint64_t block_height;
     vccrypt_buffer_t shared_secret;
-    uint8_t first_txn_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the block get call. */
-    dataservice->register_callback_payload_artifact_read(
-        [&](const dataservice_request_payload_artifact_read_t&,
+    /* mock the block notify subscribe api call. */
+    dataservice->register_callback_block_notify_subscribe(
+        [&](const dataservice_request_block_notify_subscribe_t&,
             std::ostream& payout) {
             void* payload = nullptr;
             size_t payload_size = 0U;
 
             int retval =
-                dataservice_encode_response_payload_artifact_read(
-                    &payload, &payload_size, EXPECTED_ARTIFACT_ID,
-                    EXPECTED_FIRST_TXN_ID, zero_uuid, 10, 12, 77);
+                dataservice_encode_response_block_notify(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID,
+                    EXPECTED_BLOCK_HEIGHT);
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -2186,6 +3650,10 @@ TEST_F(unauthorized_protocol_service_isolation_test, artifact_first_txn_happy)
             return AGENTD_STATUS_SUCCESS;
         });
 
+    /* a block is committed after the subscription. */
+    dataservice->add_block_notification(
+        EXPECTED_NOTIFY_BLOCK_ID, EXPECTED_NOTIFY_BLOCK_HEIGHT);
+
     /* start the mock. */
     dataservice->start();
 
@@ -2193,26 +3661,37 @@ TEST_F(unauthorized_protocol_service_isolation_test, artifact_first_txn_happy)
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
         do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the block get request. */
+    /* send the request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_artifact_first_txn_id_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_ARTIFACT_ID));
+        protocolservice_api_sendreq_block_notify_subscribe(
+            protosock, &suite, &client_iv, &shared_secret));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_artifact_first_txn_id_get(
+        protocolservice_api_recvresp_block_notify_subscribe(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, first_txn_id));
+            &status, block_id, &block_height));
 
-    /* the status should indicate that the record wasn't found. */
-    ASSERT_EQ(
-        AGENTD_STATUS_SUCCESS, (int)status);
+    /* the status should indicate success. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
+    /* the latest block should match. */
+    EXPECT_EQ(0, memcmp(block_id, EXPECTED_BLOCK_ID, sizeof(block_id)));
+    EXPECT_EQ(EXPECTED_BLOCK_HEIGHT, block_height);
 
-    /* we should get the first txn id. */
-    ASSERT_EQ(0, memcmp(first_txn_id, EXPECTED_FIRST_TXN_ID, 16));
+    /* get the notification. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_block_notification(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            block_id, &block_height));
+
+    /* the notification carries the offset of the subscription. */
+    ASSERT_EQ(0U, offset);
+    /* the committed block should match. */
+    EXPECT_EQ(
+        0, memcmp(block_id, EXPECTED_NOTIFY_BLOCK_ID, sizeof(block_id)));
+    EXPECT_EQ(EXPECTED_NOTIFY_BLOCK_HEIGHT, block_height);
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -2233,51 +3712,89 @@ TEST_F(unauthorized_protocol_service_isolation_test, artifact_first_txn_happy)
     /* verify proper connection setup. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
 
-    /* a block get call should have been made. */
+    /* a block notify subscribe call should have been made. */
     EXPECT_TRUE(
-        dataservice->request_matches_payload_artifact_read(
-            EXPECTED_CHILD_INDEX, EXPECTED_ARTIFACT_ID));
+        dataservice->request_matches_block_notify_subscribe(
+            EXPECTED_CHILD_INDEX));
 
-    /* verify proper connection teardown. */
-    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+    /* a subscribed child context is closed when its last connection
+     * leaves. */
+    EXPECT_TRUE(
+        dataservice->request_matches_child_context_close(
+            EXPECTED_CHILD_INDEX));
 
     /* clean up. */
     dispose((disposable_t*)&shared_secret);
 }
 
 /**
- * Test the happy path of artifact_get_last_txn_id.
+ * Test that the requests of a subscribed connection that disconnects with
+ * requests outstanding no longer count as in flight once they are answered.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, artifact_last_txn_happy)
+TEST_F(unauthorized_protocol_service_isolation_test,
+    block_notify_disconnect_with_requests_pending)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
-    const uint8_t EXPECTED_ARTIFACT_ID[16] = {
-        0x97, 0xd0, 0x56, 0x30, 0xbb, 0xad, 0x4c, 0xee,
-        0x8f, 0x97, 0x32, 0x98, 0x13, 0x0b, 0xbe, 0x3d
+    const uint8_t EXPECTED_BLOCK_ID[16] = {
+        0x37, 0x0e, 0x8c, 0x42, 0x5a, 0x16, 0x4e, 0x0b,
+        0x9d, 0x51, 0xd3, 0x2a, 0x0f, 0x6c, 0x71, 0x8e
     };
-    const uint8_t EXPECTED_LAST_TXN_ID[16] = {
-        0x18, 0x70, 0xe6, 0x2a, 0xff, 0xf2, 0x44, 0x5c,
-        0x90, 0xe0, 0xbd, 0xb0, 0x3c, 0xee, 0xe7, 0x5a
+    const uint8_t EXPECTED_NEXT_BLOCK_ID[16] = {
+        0xbd, 0xbc, 0xbd, 0x4a, 0x2d, 0x39, 0x4f, 0x23,
+        0xbc, 0xc6, 0xf7, 0xb8, 0x03, 0xa5, 0x7f, 0x6a
     };
+    const uint64_t EXPECTED_BLOCK_HEIGHT = 17;
+    const int REQUEST_COUNT = 4;
+    protocolservice_api_status_t stats;
+    uint8_t block_id[16];
+    uint64_t block_height;
     vccrypt_buffer_t shared_secret;
-    uint8_t last_txn_id[16];
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
-    /* mock the block get call. */
-    dataservice->register_callback_payload_artifact_read(
-        [&](const dataservice_request_payload_artifact_read_t&,
+    /* mock the block notify subscribe api call. */
+    dataservice->register_callback_block_notify_subscribe(
+        [&](const dataservice_request_block_notify_subscribe_t&,
             std::ostream& payout) {
             void* payload = nullptr;
             size_t payload_size = 0U;
 
             int retval =
-                dataservice_encode_response_payload_artifact_read(
-                    &payload, &payload_size, EXPECTED_ARTIFACT_ID,
-                    zero_uuid, EXPECTED_LAST_TXN_ID, 10, 12, 77);
+                dataservice_encode_response_block_notify(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID,
+                    EXPECTED_BLOCK_HEIGHT);
+            if (AGENTD_STATUS_SUCCESS != retval)
+                return retval;
+
+            /* make sure to clean up memory when we fall out of scope. */
+            unique_ptr<void, decltype(free)*> cleanup(payload, &free);
+
+            /* write the payload. */
+            payout.write((const char*)payload, payload_size);
+
+            /* success. */
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* mock the block get call, answering slowly so that the client has
+     * disconnected before the responses arrive. */
+    dataservice->register_callback_block_read(
+        [&](const dataservice_request_block_read_t&,
+            std::ostream& payout) {
+            void* payload = nullptr;
+            size_t payload_size = 0U;
+
+            usleep(50000);
+
+            int retval =
+                dataservice_encode_response_block_read(
+                    &payload, &payload_size, EXPECTED_BLOCK_ID,
+                    EXPECTED_BLOCK_ID, EXPECTED_NEXT_BLOCK_ID,
+                    EXPECTED_BLOCK_ID, 10, false, EXPECTED_BLOCK_ID,
+                    sizeof(EXPECTED_BLOCK_ID));
             if (AGENTD_STATUS_SUCCESS != retval)
                 return retval;
 
@@ -2298,26 +3815,53 @@ TEST_F(unauthorized_protocol_service_isolation_test, artifact_last_txn_happy)
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
         do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the block get request. */
+    /* subscribe to block notifications. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_sendreq_artifact_last_txn_id_get(
-            protosock, &suite, &client_iv, &shared_secret,
-            EXPECTED_ARTIFACT_ID));
-
-    /* get the response. */
+        protocolservice_api_sendreq_block_notify_subscribe(
+            protosock, &suite, &client_iv, &shared_secret));
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-        protocolservice_api_recvresp_artifact_last_txn_id_get(
+        protocolservice_api_recvresp_block_notify_subscribe(
             protosock, &suite, &server_iv, &shared_secret, &offset,
-            &status, last_txn_id));
+            &status, block_id, &block_height));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
 
-    /* the status should indicate that the record wasn't found. */
-    ASSERT_EQ(
-        AGENTD_STATUS_SUCCESS, (int)status);
-    /* the offset should be zero. */
-    ASSERT_EQ(0U, offset);
+    /* send several block get requests, then disconnect without reading the
+     * responses. */
+    for (int i = 0; i < REQUEST_COUNT; ++i)
+    {
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            protocolservice_api_sendreq_block_next_id_get(
+                protosock, &suite, &client_iv, &shared_secret,
+                EXPECTED_BLOCK_ID));
+    }
 
-    /* we should get the first txn id. */
-    ASSERT_EQ(0, memcmp(last_txn_id, EXPECTED_LAST_TXN_ID, 16));
+    close(protosock);
+    dispose((disposable_t*)&shared_secret);
+
+    /* connect again. */
+    int protosock_srv;
+    ASSERT_EQ(0,
+        ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &protosock, &protosock_srv));
+    ASSERT_EQ(0, ipc_sendsocket_block(acceptsock, protosock_srv));
+    close(protosock_srv);
+
+    /* the data service answers in order, so the new connection's child
+     * context is created after the abandoned requests are answered. */
+    client_iv = 0;
+    server_iv = 0;
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        do_handshake(&shared_secret, &server_iv, &client_iv));
+
+    /* no request is left in flight. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_sendreq_status_get(
+            protosock, &suite, &client_iv, &shared_secret));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_status_get(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status, &stats));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
+    EXPECT_EQ(0U, stats.dataservice_inflight);
 
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
@@ -2329,74 +3873,113 @@ TEST_F(unauthorized_protocol_service_isolation_test, artifact_last_txn_happy)
         protocolservice_api_recvresp_close(
             protosock, &suite, &server_iv, &shared_secret));
 
-    /* close the socket */
-    close(protosock);
-
     /* stop the mock. */
     dataservice->stop();
 
     /* verify proper connection setup. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
 
-    /* a block get call should have been made. */
+    /* the subscribed child context is closed once its responses are in. */
     EXPECT_TRUE(
-        dataservice->request_matches_payload_artifact_read(
-            EXPECTED_CHILD_INDEX, EXPECTED_ARTIFACT_ID));
-
-    /* verify proper connection teardown. */
-    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+        dataservice->request_matches_child_context_close(
+            EXPECTED_CHILD_INDEX));
 
     /* clean up. */
     dispose((disposable_t*)&shared_secret);
 }
 
 /**
- * Test the status api method.
+ * Test that an artifact watch request is passed to the dataservice, and that
+ * artifact updates are pushed to the connection afterward.
  */
-TEST_F(unauthorized_protocol_service_isolation_test, status_happy)
+TEST_F(unauthorized_protocol_service_isolation_test, artifact_watch_happy_path)
 {
     uint32_t offset, status;
     uint64_t client_iv = 0;
     uint64_t server_iv = 0;
+    const uint8_t EXPECTED_ARTIFACT_IDS[32] = {
+        0x5e, 0x21, 0x9a, 0x70, 0x0c, 0x8d, 0x43, 0x6f,
+        0xa2, 0x17, 0xe4, 0x3b, 0x90, 0x58, 0xcd, 0x06,
+        0x2b, 0xd6, 0x41, 0x0e, 0x97, 0x7a, 0x4c, 0x35,
+        0x86, 0xf1, 0x0d, 0x62, 0xbe, 0x13, 0x98, 0x4a
+    };
+    const uint8_t EXPECTED_TXN_LATEST[16] = {
+        0x73, 0xc0, 0x1e, 0x5b, 0xa8, 0x46, 0x4f, 0x12,
+        0x9c, 0x3d, 0x67, 0xe0, 0x04, 0xbb, 0x28, 0xf5
+    };
+    const uint64_t EXPECTED_HEIGHT_LATEST = 42;
+    const uint32_t EXPECTED_STATE_LATEST = 3;
+    uint8_t artifact_id[16];
+    uint8_t txn_latest[16];
+    uint64_t height_latest;
+    uint32_t state_latest;
     vccrypt_buffer_t shared_secret;
 
     /* register dataservice helper mocks. */
     ASSERT_EQ(0, dataservice_mock_register_helper());
 
+    /* mock the artifact watch api call. */
+    dataservice->register_callback_artifact_watch(
+        [&](const dataservice_request_artifact_watch_t&, std::ostream&) {
+            return AGENTD_STATUS_SUCCESS;
+        });
+
+    /* the second artifact is updated after the watch. */
+    dataservice->add_artifact_notification(
+        EXPECTED_ARTIFACT_IDS + 16, EXPECTED_TXN_LATEST,
+        EXPECTED_HEIGHT_LATEST, EXPECTED_STATE_LATEST);
+
     /* start the mock. */
     dataservice->start();
 
     /* do the handshake, populating the shared secret on success. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-              do_handshake(&shared_secret, &server_iv, &client_iv));
+        do_handshake(&shared_secret, &server_iv, &client_iv));
 
-    /* send the status get request. */
+    /* send the request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-              protocolservice_api_sendreq_status_get(
-                    protosock, &suite, &client_iv, &shared_secret));
+        protocolservice_api_sendreq_artifact_watch(
+            protosock, &suite, &client_iv, &shared_secret,
+            EXPECTED_ARTIFACT_IDS, 2));
 
     /* get the response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-              protocolservice_api_recvresp_status_get(
-                    protosock, &suite, &server_iv, &shared_secret, &offset,
-                    &status));
+        protocolservice_api_recvresp_artifact_watch(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            &status));
 
     /* the status should indicate success. */
-    ASSERT_EQ(
-        AGENTD_STATUS_SUCCESS, (int)status);
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS, (int)status);
     /* the offset should be zero. */
     ASSERT_EQ(0U, offset);
 
+    /* get the notification. */
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        protocolservice_api_recvresp_artifact_notification(
+            protosock, &suite, &server_iv, &shared_secret, &offset,
+            artifact_id, txn_latest, &height_latest, &state_latest));
+
+    /* the notification carries the offset of the watch. */
+    ASSERT_EQ(0U, offset);
+    /* the updated artifact should match. */
+    EXPECT_EQ(
+        0,
+        memcmp(artifact_id, EXPECTED_ARTIFACT_IDS + 16, sizeof(artifact_id)));
+    EXPECT_EQ(
+        0, memcmp(txn_latest, EXPECTED_TXN_LATEST, sizeof(txn_latest)));
+    EXPECT_EQ(EXPECTED_HEIGHT_LATEST, height_latest);
+    EXPECT_EQ(EXPECTED_STATE_LATEST, state_latest);
+
     /* send the close request. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-              protocolservice_api_sendreq_close(
-                    protosock, &suite, &client_iv, &shared_secret));
+        protocolservice_api_sendreq_close(
+            protosock, &suite, &client_iv, &shared_secret));
 
     /* get the close response. */
     ASSERT_EQ(AGENTD_STATUS_SUCCESS,
-              protocolservice_api_recvresp_close(
-                    protosock, &suite, &server_iv, &shared_secret));
- 
+        protocolservice_api_recvresp_close(
+            protosock, &suite, &server_iv, &shared_secret));
+
     /* close the socket */
     close(protosock);
 
@@ -2406,8 +3989,16 @@ TEST_F(unauthorized_protocol_service_isolation_test, status_happy)
     /* verify proper connection setup. */
     EXPECT_EQ(0, dataservice_mock_valid_connection_setup());
 
-    /* verify proper connection teardown. */
-    EXPECT_EQ(0, dataservice_mock_valid_connection_teardown());
+    /* an artifact watch call should have been made. */
+    EXPECT_TRUE(
+        dataservice->request_matches_artifact_watch(
+            EXPECTED_CHILD_INDEX, EXPECTED_ARTIFACT_IDS, 2));
+
+    /* a subscribed child context is closed when its last connection
+     * leaves. */
+    EXPECT_TRUE(
+        dataservice->request_matches_child_context_close(
+            EXPECTED_CHILD_INDEX));
 
     /* clean up. */
     dispose((disposable_t*)&shared_secret);
@@ -72,6 +72,11 @@ protected:
     static const uint8_t authorized_entity_pubkey[32];
     static const char* authorized_entity_pubkey_string;
     static const uint8_t authorized_entity_privkey[32];
+    static const uint8_t reader_entity_id[16];
+    static const char* reader_entity_id_string;
+    static const uint8_t reloaded_entity_id[16];
+    static const char* reloaded_entity_id_string;
+    static const char* authorized_entities_path;
     static const uint8_t agent_id[16];
     static const char* agent_id_string;
     static const uint8_t agent_pubkey[32];
@@ -84,7 +89,10 @@ protected:
     /** \brief Helper to perform handshake, returning the shared secret. */
     int do_handshake(
         vccrypt_buffer_t* shared_secret, uint64_t* server_iv,
-        uint64_t* client_iv);
+        uint64_t* client_iv, const uint8_t* entity_id = authorized_entity_id);
+
+    /** \brief Helper to write the authorized entities file. */
+    int write_authorized_entities(const std::string& entities);
 
     /** \brief Helper to register dataservice boilerplate methods. */
     int dataservice_mock_register_helper();
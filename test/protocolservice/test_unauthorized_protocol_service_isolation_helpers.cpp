@@ -9,6 +9,7 @@
 #include <agentd/protocolservice.h>
 #include <agentd/randomservice.h>
 #include <agentd/status_codes.h>
+#include <cstdio>
 #include <vpr/allocator/malloc_allocator.h>
 
 #include "test_unauthorized_protocol_service_isolation.h"
@@ -52,6 +53,30 @@ const char*
     unauthorized_protocol_service_isolation_test::authorized_entity_pubkey_string =
         "8520f0098930a754748b7ddcb43ef75a0dbf3a0d26381af4eba4a98eaa9b4e6a";
 
+const uint8_t
+    unauthorized_protocol_service_isolation_test::reader_entity_id[16] = {
+        0x1d, 0x5a, 0x0e, 0x63, 0x2f, 0x4c, 0x4b, 0x2e,
+        0x9a, 0x47, 0x53, 0x08, 0xc1, 0x6e, 0x77, 0x20
+    };
+
+const char*
+    unauthorized_protocol_service_isolation_test::reader_entity_id_string =
+        "1d5a0e63-2f4c-4b2e-9a47-5308c16e7720";
+
+const uint8_t
+    unauthorized_protocol_service_isolation_test::reloaded_entity_id[16] = {
+        0xa4, 0x0b, 0x76, 0x19, 0x5e, 0x3d, 0x4f, 0x81,
+        0xb6, 0x2c, 0x08, 0x9e, 0xd1, 0x45, 0x3a, 0x6f
+    };
+
+const char*
+    unauthorized_protocol_service_isolation_test::reloaded_entity_id_string =
+        "a40b7619-5e3d-4f81-b62c-089ed1453a6f";
+
+const char*
+    unauthorized_protocol_service_isolation_test::authorized_entities_path =
+        "build/test/isolation/authorized_entities";
+
 const uint8_t unauthorized_protocol_service_isolation_test::agent_id[16] = {
     0x3d, 0x96, 0x3f, 0x54, 0x83, 0xe2, 0x4b, 0x0d,
     0x86, 0xa1, 0x81, 0xb6, 0xaa, 0xaa, 0x5c, 0x1b
@@ -145,6 +170,13 @@ void unauthorized_protocol_service_isolation_test::SetUp()
     setenv("AGENTD_PUBLIC_KEY", agent_pubkey_string, 1);
     setenv("AGENTD_PRIVATE_KEY", agent_privkey_string, 1);
 
+    /* a read-only entity shares the client key under its own UUID. */
+    write_authorized_entities(
+        string(reader_entity_id_string) + " "
+            + authorized_entity_pubkey_string
+            + " block_read transaction_read\n");
+    setenv("AGENTD_AUTHORIZED_ENTITIES_FILE", authorized_entities_path, 1);
+
     /* log to standard error. */
     logsock = dup(STDERR_FILENO);
     rlogsock = dup(STDERR_FILENO);
@@ -173,7 +205,7 @@ void unauthorized_protocol_service_isolation_test::SetUp()
     proto_proc_status =
         unauthorized_protocol_proc(
             &bconf, &conf, rprotosock, logsock, acceptsock_srv, datasock_srv,
-            &protopid, false);
+            NULL, &protopid, false);
 
     /* create the mock dataservice. */
     dataservice = make_unique<mock_dataservice::mock_dataservice>(datasock);
@@ -241,7 +273,7 @@ void unauthorized_protocol_service_isolation_test::TearDown()
 /** \brief Helper to perform handshake, returning the shared secret. */
 int unauthorized_protocol_service_isolation_test::do_handshake(
     vccrypt_buffer_t* shared_secret, uint64_t* server_iv,
-    uint64_t* client_iv)
+    uint64_t* client_iv, const uint8_t* entity_id)
 {
     int retval = 0;
     uint32_t offset, status;
@@ -264,7 +296,7 @@ int unauthorized_protocol_service_isolation_test::do_handshake(
     /* attempt to send the handshake request. */
     retval =
         protocolservice_api_sendreq_handshake_request_block(
-            protosock, &suite, authorized_entity_id, &client_key_nonce,
+            protosock, &suite, entity_id, &client_key_nonce,
             &client_challenge_nonce);
     if (AGENTD_STATUS_SUCCESS != retval)
     {
@@ -326,6 +358,26 @@ done:
     return retval;
 }
 
+/** \brief Helper to write the authorized entities file. */
+int unauthorized_protocol_service_isolation_test::write_authorized_entities(
+    const string& entities)
+{
+    int retval = system("mkdir -p build/test/isolation");
+    if (0 != retval)
+        return retval;
+
+    FILE* file = fopen(authorized_entities_path, "w");
+    if (NULL == file)
+        return 1;
+
+    size_t written = fwrite(entities.data(), 1, entities.size(), file);
+    retval = fclose(file);
+    if (written != entities.size())
+        return 1;
+
+    return retval;
+}
+
 int unauthorized_protocol_service_isolation_test::dataservice_mock_register_helper()
 {
     /* mock the child context create call. */
@@ -384,8 +436,8 @@ int unauthorized_protocol_service_isolation_test::
 int unauthorized_protocol_service_isolation_test::
     dataservice_mock_valid_connection_teardown()
 {
-    /* the child index should have been closed. */
-    if (!dataservice->request_matches_child_context_close(EXPECTED_CHILD_INDEX))
+    /* the child context stays open in the pool for the next connection. */
+    if (dataservice->request_matches_child_context_close(EXPECTED_CHILD_INDEX))
         return 1;
 
     return 0;
@@ -0,0 +1,415 @@
+/**
+ * \file test_unauthorized_protocol_service_schedule.cpp
+ *
+ * Test the scheduling of client requests onto the data service.
+ *
+ * \copyright 2020 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/inet.h>
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+#include <vpr/disposable.h>
+
+#include "../../src/protocolservice/unauthorized_protocol_service_private.h"
+
+using namespace std;
+
+/**
+ * \brief A protocol service instance with two client connections sharing a
+ * child context.  Requests dispatched by the scheduler are written to a real
+ * data service socket.
+ */
+class unauthorized_protocol_service_schedule_test : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        svc = (unauthorized_protocol_service_instance_t*)
+            calloc(1, sizeof(unauthorized_protocol_service_instance_t));
+        ASSERT_NE(nullptr, svc);
+        memset(&child, 0, sizeof(child));
+        memset(&busy, 0, sizeof(busy));
+        memset(&light, 0, sizeof(light));
+
+        ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&svc->loop));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_make_noblock(lhs, &svc->data, svc));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            ipc_event_loop_add(&svc->loop, &svc->data));
+
+        init_connection(&busy);
+        init_connection(&light);
+    }
+
+    void TearDown() override
+    {
+        unauthorized_protocol_service_schedule_remove(&busy);
+        unauthorized_protocol_service_schedule_remove(&light);
+        free(busy.batch_buffer);
+        free(light.batch_buffer);
+        dispose((disposable_t*)&svc->data);
+        dispose((disposable_t*)&svc->loop);
+        close(lhs);
+        close(rhs);
+        free(svc);
+    }
+
+    void init_connection(unauthorized_protocol_connection_t* conn)
+    {
+        conn->svc = svc;
+        conn->state = APCS_READ_COMMAND_REQ_FROM_CLIENT;
+        conn->child_context = &child;
+        conn->schedule_weight = 1U;
+    }
+
+    /**
+     * \brief Build a request packet, laid out as read from the client.
+     */
+    static vector<uint8_t> request(
+        uint32_t request_id, uint32_t offset, const vector<uint8_t>& body)
+    {
+        vector<uint8_t> packet(2 * sizeof(uint32_t));
+        uint32_t net_id = htonl(request_id);
+        uint32_t net_offset = htonl(offset);
+        memcpy(packet.data(), &net_id, sizeof(net_id));
+        memcpy(packet.data() + 4, &net_offset, sizeof(net_offset));
+        packet.insert(packet.end(), body.begin(), body.end());
+
+        return packet;
+    }
+
+    /**
+     * \brief Queue a request packet on a connection, as command read does.
+     */
+    static void enqueue(
+        unauthorized_protocol_connection_t* conn,
+        const vector<uint8_t>& packet)
+    {
+        void* copy = malloc(packet.size());
+        ASSERT_NE(nullptr, copy);
+        memcpy(copy, packet.data(), packet.size());
+
+        uint32_t net_id, net_offset;
+        memcpy(&net_id, packet.data(), sizeof(net_id));
+        memcpy(&net_offset, packet.data() + 4, sizeof(net_offset));
+
+        unauthorized_protocol_connection_request_enqueue(
+            conn, copy, packet.size(), ntohl(net_id), ntohl(net_offset));
+    }
+
+    /**
+     * \brief Queue count requests that each make one data service request.
+     */
+    static void enqueue_next_id(
+        unauthorized_protocol_connection_t* conn, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            enqueue(
+                conn,
+                request(
+                    UNAUTH_PROTOCOL_REQ_ID_BLOCK_ID_GET_NEXT, i,
+                    vector<uint8_t>(16, (uint8_t)i)));
+        }
+    }
+
+    /**
+     * \brief Queue a batch of count requests that each make one data service
+     * request.
+     */
+    static void enqueue_batch(
+        unauthorized_protocol_connection_t* conn, size_t count)
+    {
+        vector<uint8_t> body;
+        for (size_t i = 0; i < count; ++i)
+        {
+            vector<uint8_t> sub =
+                request(
+                    UNAUTH_PROTOCOL_REQ_ID_BLOCK_ID_GET_NEXT, i,
+                    vector<uint8_t>(16, (uint8_t)i));
+            uint32_t net_size = htonl(sub.size());
+            const uint8_t* size_bytes = (const uint8_t*)&net_size;
+            body.insert(body.end(), size_bytes, size_bytes + 4);
+            body.insert(body.end(), sub.begin(), sub.end());
+        }
+
+        enqueue(conn, request(UNAUTH_PROTOCOL_REQ_ID_BATCH, 0U, body));
+    }
+
+    /**
+     * \brief Leave only the given number of in-flight slots free.
+     */
+    void free_slots(size_t slots)
+    {
+        svc->dataservice_inflight =
+            UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX - slots;
+    }
+
+    unauthorized_protocol_service_instance_t* svc;
+    unauthorized_protocol_child_context_t child;
+    unauthorized_protocol_connection_t busy;
+    unauthorized_protocol_connection_t light;
+    int lhs, rhs;
+};
+
+/**
+ * \brief When the data service is busy, a light connection gets its turn
+ * instead of waiting behind a busy one.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, busy_and_light_share)
+{
+    enqueue_next_id(&busy, 20);
+    enqueue_next_id(&light, 2);
+    EXPECT_EQ(22U, svc->schedule_queued);
+
+    /* only six requests can be dispatched. */
+    free_slots(6);
+    unauthorized_protocol_service_schedule(svc);
+
+    /* the busy connection used its quantum, and the light connection got the
+     * rest. */
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_QUANTUM,
+        busy.pending_count);
+    EXPECT_EQ(2U, light.pending_count);
+    EXPECT_EQ(0U, light.queue_count);
+    EXPECT_FALSE(light.schedule_active);
+
+    /* the light connection left the schedule, so the busy one is next. */
+    EXPECT_EQ(&busy, svc->schedule_head);
+    EXPECT_EQ(&busy, svc->schedule_tail);
+    EXPECT_EQ(16U, svc->schedule_queued);
+    EXPECT_EQ(UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX,
+        svc->dataservice_inflight);
+}
+
+/**
+ * \brief A connection's quantum is scaled by its weight.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, weight_scales_quantum)
+{
+    busy.schedule_weight = 3U;
+    enqueue_next_id(&busy, 20);
+    enqueue_next_id(&light, 20);
+
+    free_slots(16);
+    unauthorized_protocol_service_schedule(svc);
+
+    EXPECT_EQ((size_t)(3 * UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_QUANTUM),
+        busy.pending_count);
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_QUANTUM,
+        light.pending_count);
+}
+
+/**
+ * \brief Nothing is dispatched while the in-flight limit is reached, and
+ * dispatching resumes as responses come back.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, inflight_max)
+{
+    enqueue_next_id(&busy, 5);
+    enqueue_next_id(&light, 5);
+
+    free_slots(0);
+    unauthorized_protocol_service_schedule(svc);
+    EXPECT_EQ(0U, busy.pending_count);
+    EXPECT_EQ(0U, light.pending_count);
+    EXPECT_EQ(10U, svc->schedule_queued);
+    EXPECT_EQ(0U, svc->schedule_dispatched);
+
+    /* two responses come back, which frees two slots. */
+    svc->dataservice_inflight -= 2U;
+    unauthorized_protocol_service_schedule(svc);
+    EXPECT_EQ(2U, busy.pending_count + light.pending_count);
+    EXPECT_EQ(8U, svc->schedule_queued);
+    EXPECT_EQ(2U, svc->schedule_dispatched);
+    EXPECT_EQ(UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_INFLIGHT_MAX,
+        svc->dataservice_inflight);
+}
+
+/**
+ * \brief A batch can overdraw a connection's deficit, which it repays on later
+ * turns while other connections are served.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, overdraft_repaid)
+{
+    /* the batch costs ten data service requests, against a quantum of four. */
+    enqueue_batch(&busy, 10);
+    enqueue_next_id(&busy, 1);
+    enqueue_next_id(&light, 8);
+
+    /* room for the batch and the light connection's requests only. */
+    free_slots(18);
+    unauthorized_protocol_service_schedule(svc);
+
+    /* the light connection had two turns while the busy one repaid its
+     * overdraft. */
+    EXPECT_EQ(10U, busy.pending_count);
+    EXPECT_EQ(1U, busy.queue_count);
+    EXPECT_EQ(
+        2 * UNAUTHORIZED_PROTOCOL_SERVICE_SCHEDULE_QUANTUM - 10,
+        busy.schedule_deficit);
+    EXPECT_EQ(8U, light.pending_count);
+
+    /* once repaid, the busy connection's last request is dispatched. */
+    svc->dataservice_inflight -= 1U;
+    unauthorized_protocol_service_schedule(svc);
+    EXPECT_EQ(11U, busy.pending_count);
+    EXPECT_EQ(0U, busy.queue_count);
+    EXPECT_EQ(nullptr, svc->schedule_head);
+}
+
+/**
+ * \brief A connection that closes with queued requests drops them and leaves
+ * the schedule, without disturbing other connections.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, remove_with_queued)
+{
+    enqueue_next_id(&busy, 5);
+    enqueue_next_id(&light, 3);
+
+    free_slots(0);
+    unauthorized_protocol_service_schedule(svc);
+    ASSERT_EQ(&busy, svc->schedule_head);
+    ASSERT_EQ(&light, svc->schedule_tail);
+
+    /* the busy connection closes. */
+    unauthorized_protocol_service_schedule_remove(&busy);
+    EXPECT_EQ(0U, busy.queue_count);
+    EXPECT_FALSE(busy.schedule_active);
+    EXPECT_EQ(3U, svc->schedule_queued);
+    EXPECT_EQ(&light, svc->schedule_head);
+    EXPECT_EQ(&light, svc->schedule_tail);
+
+    /* only the light connection's requests are dispatched. */
+    free_slots(8);
+    unauthorized_protocol_service_schedule(svc);
+    EXPECT_EQ(0U, busy.pending_count);
+    EXPECT_EQ(3U, light.pending_count);
+    EXPECT_EQ(0U, svc->schedule_queued);
+    EXPECT_EQ(nullptr, svc->schedule_head);
+    EXPECT_EQ(nullptr, svc->schedule_tail);
+
+    /* removing the last connection in the schedule fixes up the tail. */
+    enqueue_next_id(&busy, 1);
+    enqueue_next_id(&light, 1);
+    free_slots(0);
+    unauthorized_protocol_service_schedule_remove(&light);
+    EXPECT_EQ(&busy, svc->schedule_head);
+    EXPECT_EQ(&busy, svc->schedule_tail);
+    EXPECT_EQ(1U, svc->schedule_queued);
+}
+
+/**
+ * \brief The queue depth, dispatch count, and queue wait counters follow the
+ * scheduler.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, counters)
+{
+    enqueue_next_id(&busy, 3);
+    EXPECT_EQ(3U, svc->schedule_queued);
+
+    /* let the requests wait a little. */
+    usleep(2000);
+
+    free_slots(2);
+    unauthorized_protocol_service_schedule(svc);
+    EXPECT_EQ(1U, svc->schedule_queued);
+    EXPECT_EQ(2U, svc->schedule_dispatched);
+    EXPECT_GE(svc->schedule_wait_max_usec, 2000U);
+    EXPECT_GE(svc->schedule_wait_total_usec, 2U * 2000U);
+    EXPECT_LE(svc->schedule_wait_max_usec, svc->schedule_wait_total_usec);
+
+    svc->dataservice_inflight -= 1U;
+    unauthorized_protocol_service_schedule(svc);
+    EXPECT_EQ(0U, svc->schedule_queued);
+    EXPECT_EQ(3U, svc->schedule_dispatched);
+}
+
+/**
+ * \brief The weight=N token in the entities file sets an entity's weight,
+ * which its connections are scheduled with.
+ */
+TEST_F(unauthorized_protocol_service_schedule_test, entity_weight)
+{
+    const char* HEAVY =
+        "aaaaaaaa-aaaa-aaaa-aaaa-aaaaaaaaaaaa "
+        "0101010101010101010101010101010101010101010101010101010101010101 "
+        "block_read weight=3\n";
+    const char* PLAIN =
+        "bbbbbbbb-bbbb-bbbb-bbbb-bbbbbbbbbbbb "
+        "0202020202020202020202020202020202020202020202020202020202020202\n";
+    uint8_t bootstrap_key[32];
+    uint8_t entity_key[32];
+    char path[] = "/tmp/agentd_entities_XXXXXX";
+
+    /* the bootstrap entity. */
+    memset(svc->authorized_entity_id, 0xcc, sizeof(svc->authorized_entity_id));
+    memset(bootstrap_key, 0x03, sizeof(bootstrap_key));
+    svc->authorized_entity_pubkey.data = bootstrap_key;
+    svc->authorized_entity_pubkey.size = sizeof(bootstrap_key);
+
+    /* write an entities file. */
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ((ssize_t)strlen(HEAVY), write(fd, HEAVY, strlen(HEAVY)));
+    ASSERT_EQ((ssize_t)strlen(PLAIN), write(fd, PLAIN, strlen(PLAIN)));
+    close(fd);
+    ASSERT_EQ(0, setenv("AGENTD_AUTHORIZED_ENTITIES_FILE", path, 1));
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_entity_table_load(svc));
+
+    /* the weight is read, and defaults to 1. */
+    uint8_t heavy_id[16], plain_id[16];
+    memset(heavy_id, 0xaa, sizeof(heavy_id));
+    memset(plain_id, 0xbb, sizeof(plain_id));
+    const unauthorized_protocol_entity_t* heavy =
+        unauthorized_protocol_entity_table_find(&svc->entities, heavy_id);
+    const unauthorized_protocol_entity_t* plain =
+        unauthorized_protocol_entity_table_find(&svc->entities, plain_id);
+    ASSERT_NE(nullptr, heavy);
+    ASSERT_NE(nullptr, plain);
+    EXPECT_EQ(3U, heavy->weight);
+    EXPECT_EQ(1U, plain->weight);
+
+    /* a connection for an entity takes its weight. */
+    memcpy(busy.entity_uuid, heavy_id, sizeof(heavy_id));
+    busy.entity_public_key.data = entity_key;
+    busy.entity_public_key.size = sizeof(entity_key);
+    busy.schedule_weight = 0U;
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_get_entity_key(&busy));
+    EXPECT_EQ(3U, busy.schedule_weight);
+
+    /* a weight out of range, or not a number, is rejected. */
+    const char* BAD[] = { "weight=0", "weight=65", "weight=x", "weight=2x" };
+    for (const char* bad : BAD)
+    {
+        string line =
+            string("dddddddd-dddd-dddd-dddd-dddddddddddd ")
+            + "0404040404040404040404040404040404040404040404040404040404040404 "
+            + bad + "\n";
+        FILE* file = fopen(path, "w");
+        ASSERT_NE(nullptr, file);
+        fputs(line.c_str(), file);
+        fclose(file);
+
+        EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_ENTITY_TABLE_LOAD_FAILURE,
+            unauthorized_protocol_service_entity_table_load(svc)) << bad;
+    }
+
+    /* the last good table is kept. */
+    EXPECT_NE(nullptr,
+        unauthorized_protocol_entity_table_find(&svc->entities, heavy_id));
+
+    /* clean up. */
+    unsetenv("AGENTD_AUTHORIZED_ENTITIES_FILE");
+    unlink(path);
+    dispose((disposable_t*)&svc->entities);
+}
@@ -0,0 +1,199 @@
+/**
+ * \file test_unauthorized_protocol_service_settings.cpp
+ *
+ * Test reading the protocol service settings from the environment.
+ *
+ * \copyright 2020 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/status_codes.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../src/protocolservice/unauthorized_protocol_service_private.h"
+
+using namespace std;
+
+/**
+ * \brief The names of the watermark settings.
+ */
+static const char* WATERMARK_SETTINGS[] = {
+    "AGENTD_PROTOCOLSERVICE_DATASERVICE_LOW_WATERMARK",
+    "AGENTD_PROTOCOLSERVICE_DATASERVICE_HIGH_WATERMARK",
+    "AGENTD_PROTOCOLSERVICE_CONNECTION_LOW_WATERMARK",
+    "AGENTD_PROTOCOLSERVICE_CONNECTION_HIGH_WATERMARK",
+};
+
+/**
+ * \brief A protocol service instance to read the settings into.
+ */
+class unauthorized_protocol_service_settings_test : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        memset(&inst, 0, sizeof(inst));
+        clear();
+    }
+
+    void TearDown() override
+    {
+        clear();
+    }
+
+    void clear()
+    {
+        for (const char* name : WATERMARK_SETTINGS)
+        {
+            unsetenv(name);
+        }
+
+        unsetenv("AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW");
+    }
+
+    unauthorized_protocol_service_instance_t inst;
+};
+
+/**
+ * \brief A setting that isn't set gets its default.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, setting_default)
+{
+    size_t value = 0U;
+
+    unsetenv("AGENTD_PROTOCOLSERVICE_TEST_SETTING");
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_TEST_SETTING", 7U, 1U, 10U, &value));
+    EXPECT_EQ(7U, value);
+}
+
+/**
+ * \brief A setting within range is used, and one out of range or malformed is
+ * rejected.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, setting_range)
+{
+    const char* BAD[] = { "", "0", "11", "-1", " 5", "5x" };
+    size_t value = 0U;
+
+    ASSERT_EQ(0, setenv("AGENTD_PROTOCOLSERVICE_TEST_SETTING", "10", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_setting_get(
+            "AGENTD_PROTOCOLSERVICE_TEST_SETTING", 7U, 1U, 10U, &value));
+    EXPECT_EQ(10U, value);
+
+    for (const char* bad : BAD)
+    {
+        ASSERT_EQ(0, setenv("AGENTD_PROTOCOLSERVICE_TEST_SETTING", bad, 1));
+        EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID,
+            unauthorized_protocol_service_setting_get(
+                "AGENTD_PROTOCOLSERVICE_TEST_SETTING", 7U, 1U, 10U, &value))
+            << bad;
+    }
+
+    unsetenv("AGENTD_PROTOCOLSERVICE_TEST_SETTING");
+}
+
+/**
+ * \brief The default watermarks are used when none are set.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, default_watermarks)
+{
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_settings_read(&inst));
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_LOW_WATERMARK,
+        inst.dataservice_low_watermark);
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_DATASERVICE_HIGH_WATERMARK,
+        inst.dataservice_high_watermark);
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_CONNECTION_LOW_WATERMARK,
+        inst.connection_low_watermark);
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_CONNECTION_HIGH_WATERMARK,
+        inst.connection_high_watermark);
+}
+
+/**
+ * \brief Configured watermarks are used.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, configured_watermarks)
+{
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[0], "8192", 1));
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[1], "16384", 1));
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[2], "32768", 1));
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[3], "65536", 1));
+
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_settings_read(&inst));
+    EXPECT_EQ(8192U, inst.dataservice_low_watermark);
+    EXPECT_EQ(16384U, inst.dataservice_high_watermark);
+    EXPECT_EQ(32768U, inst.connection_low_watermark);
+    EXPECT_EQ(65536U, inst.connection_high_watermark);
+}
+
+/**
+ * \brief Out of range watermarks, or a low watermark above its high watermark,
+ * are rejected.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, invalid_watermarks)
+{
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[3], "4095", 1));
+    EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID,
+        unauthorized_protocol_service_settings_read(&inst));
+    clear();
+
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[0], "8192", 1));
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[1], "4096", 1));
+    EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID,
+        unauthorized_protocol_service_settings_read(&inst));
+    clear();
+
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[2], "8192", 1));
+    ASSERT_EQ(0, setenv(WATERMARK_SETTINGS[3], "4096", 1));
+    EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID,
+        unauthorized_protocol_service_settings_read(&inst));
+}
+
+/**
+ * \brief The default pipeline window is used when none is set.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, default_pipeline_window)
+{
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_settings_read(&inst));
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_DEFAULT_PIPELINE_WINDOW,
+        inst.pipeline_window);
+}
+
+/**
+ * \brief A configured pipeline window is used, from 1, which disables
+ * pipelining, up to the most requests a connection can queue.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, configured_pipeline_window)
+{
+    ASSERT_EQ(0, setenv("AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW", "1", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_settings_read(&inst));
+    EXPECT_EQ(1U, inst.pipeline_window);
+
+    ASSERT_EQ(0, setenv("AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW", "32", 1));
+    ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+        unauthorized_protocol_service_settings_read(&inst));
+    EXPECT_EQ((size_t)UNAUTHORIZED_PROTOCOL_SERVICE_PIPELINE_MAX,
+        inst.pipeline_window);
+}
+
+/**
+ * \brief A pipeline window outside of 1 to the maximum is rejected rather than
+ * clamped.
+ */
+TEST_F(unauthorized_protocol_service_settings_test, invalid_pipeline_window)
+{
+    const char* BAD[] = { "0", "33", "", "eight" };
+
+    for (const char* bad : BAD)
+    {
+        ASSERT_EQ(0, setenv("AGENTD_PROTOCOLSERVICE_PIPELINE_WINDOW", bad, 1));
+        EXPECT_EQ(AGENTD_ERROR_PROTOCOLSERVICE_SETTING_INVALID,
+            unauthorized_protocol_service_settings_read(&inst)) << bad;
+    }
+}
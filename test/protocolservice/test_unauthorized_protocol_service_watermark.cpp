@@ -0,0 +1,208 @@
+/**
+ * \file test_unauthorized_protocol_service_watermark.cpp
+ *
+ * Test that dataservice and client backpressure pause client reads.
+ *
+ * \copyright 2020 Velo-Payments, Inc.  All rights reserved.
+ */
+
+#include <agentd/ipc.h>
+#include <agentd/status_codes.h>
+#include <gtest/gtest.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vpr/disposable.h>
+
+#include "../../src/ipc/ipc_internal.h"
+#include "../../src/protocolservice/unauthorized_protocol_service_private.h"
+
+using namespace std;
+
+/**
+ * \brief A protocol service instance with one client connection, just enough
+ * to drive the dataservice watermark callback.
+ */
+class unauthorized_protocol_service_watermark_test : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        svc = (unauthorized_protocol_service_instance_t*)
+            calloc(1, sizeof(unauthorized_protocol_service_instance_t));
+        ASSERT_NE(nullptr, svc);
+        memset(&conn, 0, sizeof(conn));
+        conn.svc = svc;
+
+        ASSERT_EQ(0, ipc_socketpair(AF_UNIX, SOCK_STREAM, 0, &lhs, &rhs));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_event_loop_init(&svc->loop));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS, ipc_make_noblock(lhs, &conn.ctx, &conn));
+        ASSERT_EQ(AGENTD_STATUS_SUCCESS,
+            ipc_event_loop_add(&svc->loop, &conn.ctx));
+    }
+
+    void TearDown() override
+    {
+        dispose((disposable_t*)&conn.ctx);
+        dispose((disposable_t*)&svc->loop);
+        close(lhs);
+        close(rhs);
+        free(svc);
+    }
+
+    /**
+     * \brief Set the client read callback, as the service does once a
+     * connection can read commands.
+     */
+    void read_commands()
+    {
+        ipc_set_readcb_noblock(
+            &conn.ctx, &unauthorized_protocol_service_connection_read,
+            &svc->loop);
+    }
+
+    /**
+     * \brief Move the connection between lists, as the child context request
+     * and response do.
+     */
+    void move(
+        unauthorized_protocol_connection_t** from,
+        unauthorized_protocol_connection_t** to)
+    {
+        unauthorized_protocol_connection_remove(from, &conn);
+        unauthorized_protocol_connection_push_front(to, &conn);
+    }
+
+    /**
+     * \brief Returns true if the connection's read event is in the loop.
+     */
+    bool reading()
+    {
+        ipc_socket_impl_t* impl = (ipc_socket_impl_t*)conn.ctx.impl;
+
+        return
+            !impl->read_paused && NULL != impl->read_ev
+         && event_pending(impl->read_ev, EV_READ, NULL);
+    }
+
+    void watermark(bool above)
+    {
+        unauthorized_protocol_service_dataservice_watermark(
+            &svc->data, above, svc);
+    }
+
+    void client_watermark(bool above)
+    {
+        unauthorized_protocol_service_connection_watermark(
+            &conn.ctx, above, &conn);
+    }
+
+    unauthorized_protocol_service_instance_t* svc;
+    unauthorized_protocol_connection_t conn;
+    int lhs, rhs;
+};
+
+/**
+ * \brief A connection paused while open, which then waits on a child context,
+ * is resumed when the backpressure clears.
+ */
+TEST_F(unauthorized_protocol_service_watermark_test, paused_then_waiting)
+{
+    /* the connection is open and reading. */
+    unauthorized_protocol_connection_push_front(
+        &svc->used_connection_head, &conn);
+    read_commands();
+    ASSERT_TRUE(reading());
+
+    /* the data service backs up. */
+    watermark(true);
+    EXPECT_FALSE(reading());
+
+    /* the connection starts waiting on a child context. */
+    move(&svc->used_connection_head, &svc->dataservice_context_create_head);
+
+    /* the data service catches up, so the waiting connection resumes. */
+    watermark(false);
+    EXPECT_TRUE(reading());
+
+    /* the child context is created. */
+    move(&svc->dataservice_context_create_head, &svc->used_connection_head);
+    read_commands();
+    EXPECT_TRUE(reading());
+}
+
+/**
+ * \brief A connection waiting on a child context when the backpressure rises
+ * is paused, and stays paused once its child context is created.
+ */
+TEST_F(unauthorized_protocol_service_watermark_test, waiting_then_paused)
+{
+    /* the connection is waiting on a child context. */
+    unauthorized_protocol_connection_push_front(
+        &svc->dataservice_context_create_head, &conn);
+    read_commands();
+    ASSERT_TRUE(reading());
+
+    /* the data service backs up, which pauses the waiting connection. */
+    watermark(true);
+    EXPECT_FALSE(reading());
+
+    /* the child context is created, but reads stay paused. */
+    move(&svc->dataservice_context_create_head, &svc->used_connection_head);
+    read_commands();
+    EXPECT_FALSE(reading());
+
+    /* the data service catches up. */
+    watermark(false);
+    EXPECT_TRUE(reading());
+}
+
+/**
+ * \brief A client that stops reading its responses is paused until it catches
+ * up.
+ */
+TEST_F(unauthorized_protocol_service_watermark_test, client_backpressure)
+{
+    unauthorized_protocol_connection_push_front(
+        &svc->used_connection_head, &conn);
+    read_commands();
+    ASSERT_TRUE(reading());
+
+    /* responses to the client back up. */
+    client_watermark(true);
+    EXPECT_TRUE(conn.client_backpressure);
+    EXPECT_FALSE(reading());
+
+    /* the client catches up. */
+    client_watermark(false);
+    EXPECT_FALSE(conn.client_backpressure);
+    EXPECT_TRUE(reading());
+}
+
+/**
+ * \brief A connection stays paused until both the data service and the client
+ * catch up, in either order.
+ */
+TEST_F(unauthorized_protocol_service_watermark_test, both_backpressures)
+{
+    unauthorized_protocol_connection_push_front(
+        &svc->used_connection_head, &conn);
+    read_commands();
+    ASSERT_TRUE(reading());
+
+    /* the data service catching up doesn't resume a backed up client. */
+    client_watermark(true);
+    watermark(true);
+    watermark(false);
+    EXPECT_FALSE(reading());
+    client_watermark(false);
+    EXPECT_TRUE(reading());
+
+    /* the client catching up doesn't resume while the data service is backed
+     * up. */
+    watermark(true);
+    client_watermark(true);
+    client_watermark(false);
+    EXPECT_FALSE(reading());
+    watermark(false);
+    EXPECT_TRUE(reading());
+}